@@ -44,6 +44,7 @@
 /* IMPORTS                                                                    */
 /* -------------------------------------------------------------------------- */
 #include "k_sal_com.h"
+#include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -293,6 +294,53 @@ K_SAL_API TKCommStatus salComWrite
   return xStatus;
 }
 
+/**
+ * @brief Send several buffers to the server (Baremetal implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, 1 to C_K_SAL_COM_IOVEC_MAX_COUNT.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount
+)
+{
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+  size_t        xIndex = 0U;
+
+  if ((NULL == xpComInfo) || (NULL == xpVec) || (0U == xVecCount) ||
+      (C_K_SAL_COM_IOVEC_MAX_COUNT < xVecCount) || (false == lIsValidComInfo(xpComInfo)))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else
+  {
+    /* TODO: Use the gather send of your stack if it has one
+     *
+     * Example:
+     * - bytes_sent = tcp_socket_writev(socket_id, iov, count);
+     * - Handle partial sends in loop
+     *
+     * Without it, the buffers are written one after the other.
+     */
+    xStatus = E_K_COMM_STATUS_OK;
+    for (xIndex = 0U; (xIndex < xVecCount) && (E_K_COMM_STATUS_OK == xStatus); xIndex++)
+    {
+      if (0U != xpVec[xIndex].len)
+      {
+        xStatus = salComWrite(xpComInfo, xpVec[xIndex].pData, xpVec[xIndex].len);
+      }
+    }
+  }
+
+  return xStatus;
+}
+
 /**
  * @brief Read data from the server (Baremetal implementation).
  *
@@ -343,6 +391,45 @@ K_SAL_API TKCommStatus salComRead
   return xStatus;
 }
 
+/**
+ * @brief Check an idle connection (Baremetal implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComCheck
+(
+  void* xpComInfo
+)
+{
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+
+  if ((NULL == xpComInfo) || (false == lIsValidComInfo(xpComInfo)))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else if (0U == (xpInfo->state & C_SAL_COM_STATE_CONNECTED))
+  {
+    xStatus = E_K_COMM_STATUS_ERROR;
+  }
+  else
+  {
+    /* TODO: Implement the idle connection check for your platform
+     * 
+     * Example:
+     * - Non-blocking peek of one byte, or the socket state of the TCP stack
+     * - Nothing pending: E_K_COMM_STATUS_OK
+     * - Connection closed or data pending: E_K_COMM_STATUS_NETWORK
+     */
+    
+    xStatus = E_K_COMM_STATUS_OK;
+  }
+
+  return xStatus;
+}
+
 /**
  * @brief Terminate COM and close connection (Baremetal implementation).
  *
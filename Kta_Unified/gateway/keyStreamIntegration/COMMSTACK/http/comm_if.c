@@ -38,6 +38,8 @@
  *  - Parameter validation with detailed error codes
  *  - Connection health monitoring API
  *  - Automatic statistics reset capability
+ *  - Idle connection kept by commTerm() and reused by the next commInit()
+ *  - Asynchronous connections run by commAsyncPoll() (Linux)
  ******************************************************************************/
 /**
  * @brief Communication Interface. Based on the compilation flag it will select the coap or http.
@@ -54,9 +56,34 @@
 /* -------------------------------------------------------------------------- */
 /* LOCAL CONSTANTS, TYPES, ENUM                                               */
 /* -------------------------------------------------------------------------- */
-/** @brief Maximum connection age before warning (5 minutes in seconds) */
+/** @brief Default maximum connection age (5 minutes in seconds) */
 #define C_COMM_IF_CONN_MAX_AGE_SEC      (300u)
 
+/** @brief Size of the server host kept to match the idle connection */
+#define C_COMM_IF_HOST_MAX_LEN          (256u)
+
+/** @brief Size of the server path kept to match the idle connection */
+#define C_COMM_IF_PATH_MAX_LEN          (64u)
+
+#if defined(__linux__)
+/** @brief Asynchronous connection */
+typedef struct
+{
+  void*                 pHttp;
+  /* Http connection. */
+  TCommIfAsyncCallback  pCallback;
+  void*                 pContext;
+  const uint8_t*        pMsgToSend;
+  size_t                sendSize;
+  /* Exchange in progress, kept to send it again. */
+  bool                  isUsed;
+  bool                  isReused;
+  /* The last exchange succeeded, the connection was kept open. */
+  bool                  isRetryAllowed;
+  /* The exchange runs on a reused connection and was not sent again yet. */
+} TCommIfAsyncInfo;
+#endif /* __linux__ */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
@@ -66,6 +93,27 @@ static bool gIsConnected = false;
 /** @brief Connection establishment timestamp */
 static time_t gConnectTime = 0;
 
+/** @brief Maximum connection age in seconds, 0 disables the reuse */
+static uint32_t gMaxConnAgeSec = C_COMM_IF_CONN_MAX_AGE_SEC;
+
+/** @brief Connection kept open by commTerm() for the next commInit() */
+static bool gIsIdle = false;
+
+/** @brief No exchange failed on the connection, it may be kept */
+static bool gIsReusable = false;
+
+/** @brief Session runs on a reused connection not exchanged on yet */
+static bool gIsReusePending = false;
+
+/** @brief Server host of the connection */
+static uint8_t gaHost[C_COMM_IF_HOST_MAX_LEN] = {0};
+
+/** @brief Server port of the connection */
+static uint16_t gPort = 0;
+
+/** @brief Server path of the connection */
+static uint8_t gaPath[C_COMM_IF_PATH_MAX_LEN] = {0};
+
 /** @brief Statistics - connection attempts */
 static uint32_t gStatsConnectAttempts = 0;
 
@@ -90,6 +138,17 @@ static uint32_t gStatsTermCalls = 0;
 /** @brief Statistics - last error code */
 static TCommIfStatus gStatsLastError = E_COMM_IF_STATUS_OK;
 
+/** @brief Statistics - connections reused */
+static uint32_t gStatsConnectReused = 0;
+
+/** @brief Statistics - idle connections found closed */
+static uint32_t gStatsReuseCheckFailures = 0;
+
+#if defined(__linux__)
+/** @brief Asynchronous connections, the handles point here */
+static TCommIfAsyncInfo gaAsyncInfo[C_K_COMM__ASYNC_MAX_CONNECTIONS];
+#endif /* __linux__ */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
@@ -103,6 +162,89 @@ static TCommIfStatus gStatsLastError = E_COMM_IF_STATUS_OK;
  */
 static bool lIsConnectionStale(void);
 
+/**
+ * @brief
+ *   Check if the connection goes to the given server.
+ *
+ * @param[in] xpHost
+ *   Server host; should not be NULL.
+ * @param[in] xPort
+ *   Server port.
+ * @param[in] xpPath
+ *   Server path; should not be NULL.
+ *
+ * @return
+ * - true if host, port and path match
+ * - false otherwise
+ */
+static bool lIsSameServer
+(
+  const uint8_t* xpHost,
+  const uint16_t xPort,
+  const uint8_t* xpPath
+);
+
+/**
+ * @brief
+ *   Open a new connection and update the connection state.
+ *
+ * @param[in] xpHost
+ *   Server host; should not be NULL.
+ * @param[in] xPort
+ *   Server port.
+ * @param[in] xpPath
+ *   Server path; should not be NULL.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK or the error status of httpInit().
+ */
+static TCommIfStatus lConnect
+(
+  const uint8_t* xpHost,
+  const uint16_t xPort,
+  const uint8_t* xpPath
+);
+
+#if defined(__linux__)
+/**
+ * @brief
+ *   Get the asynchronous connection of a handle.
+ *
+ * @param[in] xHandle
+ *   Handle from commAsyncOpen().
+ *
+ * @return
+ * - The connection, NULL if the handle is not valid.
+ */
+static TCommIfAsyncInfo* lAsyncGet
+(
+  TCommIfAsyncHandle xHandle
+);
+
+/**
+ * @brief
+ *   Receive the outcome of an asynchronous exchange, send it again once if
+ *   the server closed the reused connection, else update the statistics and
+ *   call the caller callback.
+ *
+ * @param[in] xpContext
+ *   Asynchronous connection.
+ * @param[in] xStatus
+ *   Exchange status.
+ * @param[in] xpRecvMsg
+ *   Response, NULL on error.
+ * @param[in] xRecvMsgSize
+ *   Size of the response, in bytes.
+ */
+static void lAsyncDone
+(
+  void*           xpContext,
+  TCommIfStatus   xStatus,
+  const uint8_t*  xpRecvMsg,
+  size_t          xRecvMsgSize
+);
+#endif /* __linux__ */
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
 /* -------------------------------------------------------------------------- */
@@ -135,6 +277,24 @@ TCommIfStatus commInit
     return E_COMM_IF_STATUS_PARAMETER;
   }
 
+  /* Reuse the connection kept by commTerm() if still healthy */
+  if (gIsConnected && gIsIdle)
+  {
+    gIsIdle = false;
+    if (lIsSameServer(xpHost, xPort, xpPath) && !lIsConnectionStale())
+    {
+      retStatus = httpReuse();
+      if (retStatus == E_COMM_IF_STATUS_OK)
+      {
+        gIsReusePending = true;
+        gStatsConnectSuccess++;
+        gStatsConnectReused++;
+        return E_COMM_IF_STATUS_OK;
+      }
+      gStatsReuseCheckFailures++;
+    }
+  }
+
   /* Warn if re-connecting without closing previous connection */
   if (gIsConnected)
   {
@@ -144,21 +304,15 @@ TCommIfStatus commInit
     gIsConnected = false;
   }
 
-  /* Attempt connection */
-  retStatus = httpInit(E_COMM_IF_IP_PROTOCOL_V4, xpPath, xpHost, xPort);
+  /* Remember the server to match the connection at the next commInit() */
+  (void)strncpy((char*)gaHost, (const char*)xpHost, sizeof(gaHost) - 1u);
+  gaHost[sizeof(gaHost) - 1u] = 0u;
+  gPort = xPort;
+  (void)strncpy((char*)gaPath, (const char*)xpPath, sizeof(gaPath) - 1u);
+  gaPath[sizeof(gaPath) - 1u] = 0u;
 
-  if (retStatus == E_COMM_IF_STATUS_OK)
-  {
-    gIsConnected = true;
-    gConnectTime = time(NULL);
-    gStatsConnectSuccess++;
-  }
-  else
-  {
-    gIsConnected = false;
-    gStatsConnectFailures++;
-    gStatsLastError = retStatus;
-  }
+  /* Attempt connection */
+  retStatus = lConnect(xpHost, xPort, xpPath);
 
   return retStatus;
 }
@@ -190,7 +344,7 @@ TCommIfStatus commMsgExchange
   }
 
   /* Check connection state */
-  if (!gIsConnected)
+  if (!gIsConnected || gIsIdle)
   {
     gStatsMsgExchangeFailures++;
     gStatsLastError = E_COMM_IF_STATUS_NO_CONNECTION;
@@ -206,6 +360,25 @@ TCommIfStatus commMsgExchange
   /* Perform message exchange */
   retStatus = httpMsgExchange(xpMsgToSend, xSendSize, xpRecvMsgBuffer, xpRecvMsgBufferSize);
 
+  /* The server may close a reused connection between the check and the
+   * request. E_COMM_IF_STATUS_NETWORK means the request was not sent or the
+   * connection was closed or reset before any response byte, so the server
+   * did not process it: reconnect and send it once more. A timeout or a cut
+   * response is not retried, the request may have been processed. */
+  if ((retStatus == E_COMM_IF_STATUS_NETWORK) && gIsReusePending)
+  {
+    gStatsReuseCheckFailures++;
+    (void)httpTerm();
+    gIsConnected = false;
+    gStatsConnectAttempts++;
+    retStatus = lConnect(gaHost, gPort, gaPath);
+    if (retStatus == E_COMM_IF_STATUS_OK)
+    {
+      retStatus = httpMsgExchange(xpMsgToSend, xSendSize, xpRecvMsgBuffer, xpRecvMsgBufferSize);
+    }
+  }
+  gIsReusePending = false;
+
   if (retStatus == E_COMM_IF_STATUS_OK)
   {
     gStatsMsgExchangeSuccess++;
@@ -215,8 +388,8 @@ TCommIfStatus commMsgExchange
     gStatsMsgExchangeFailures++;
     gStatsLastError = retStatus;
     
-    /* On exchange failure, mark connection as dead */
-    // gIsConnected = false;
+    /* On exchange failure, do not keep the connection after commTerm() */
+    gIsReusable = false;
   }
 
   return retStatus;
@@ -236,17 +409,59 @@ TCommIfStatus commTerm
   /* Update statistics */
   gStatsTermCalls++;
 
-  /* Only terminate if connected */
+  /* Keep a healthy connection for the next commInit(), else terminate */
+  if (gIsConnected)
+  {
+    if (gIsReusable && (gMaxConnAgeSec != 0u) && !lIsConnectionStale())
+    {
+      gIsIdle = true;
+      gIsReusePending = false;
+    }
+    else
+    {
+      retStatus = commClose();
+    }
+  }
+
+  return retStatus;
+}
+
+/**
+ * @brief  implement commClose
+ *
+ */
+TCommIfStatus commClose
+(
+  void
+)
+{
+  TCommIfStatus retStatus = E_COMM_IF_STATUS_OK;
+
   if (gIsConnected)
   {
     retStatus = httpTerm();
     gIsConnected = false;
     gConnectTime = 0;
   }
+  gIsIdle = false;
+  gIsReusable = false;
+  gIsReusePending = false;
 
   return retStatus;
 }
 
+/**
+ * @brief  implement commSetMaxConnectionAge
+ *
+ */
+void commSetMaxConnectionAge
+(
+  uint32_t xMaxAgeSeconds
+)
+{
+  gMaxConnAgeSec = xMaxAgeSeconds;
+}
+
 /**
  * @brief
  *   Get communication statistics.
@@ -276,8 +491,10 @@ TCommIfStatus commGetStatistics
   xpStats->msgExchangeFailures = gStatsMsgExchangeFailures;
   xpStats->termCalls = gStatsTermCalls;
   xpStats->lastError = gStatsLastError;
-  xpStats->isConnected = gIsConnected;
+  xpStats->isConnected = gIsConnected && !gIsIdle;
   xpStats->connectionAgeSeconds = gIsConnected ? (uint32_t)(time(NULL) - gConnectTime) : 0;
+  xpStats->connectReused = gStatsConnectReused;
+  xpStats->reuseCheckFailures = gStatsReuseCheckFailures;
 
   return E_COMM_IF_STATUS_OK;
 }
@@ -299,6 +516,8 @@ void commResetStatistics
   gStatsMsgExchangeFailures = 0;
   gStatsTermCalls = 0;
   gStatsLastError = E_COMM_IF_STATUS_OK;
+  gStatsConnectReused = 0;
+  gStatsReuseCheckFailures = 0;
   /* Note: Keep connection state unchanged */
 }
 
@@ -316,7 +535,7 @@ TCommIfStatus commCheckConnectionHealth
   void
 )
 {
-  if (!gIsConnected)
+  if (!gIsConnected || gIsIdle)
   {
     return E_COMM_IF_STATUS_NO_CONNECTION;
   }
@@ -329,6 +548,144 @@ TCommIfStatus commCheckConnectionHealth
   return E_COMM_IF_STATUS_OK;
 }
 
+#if defined(__linux__)
+/**
+ * @brief  implement commAsyncOpen
+ *
+ */
+TCommIfStatus commAsyncOpen
+(
+  const uint8_t*       xpHost,
+  const uint16_t       xPort,
+  const uint8_t*       xpPath,
+  TCommIfAsyncHandle*  xpHandle
+)
+{
+  TCommIfStatus     retStatus = E_COMM_IF_STATUS_RESOURCE;
+  TCommIfAsyncInfo* pInfo = NULL;
+  size_t            i;
+
+  /* Update statistics */
+  gStatsConnectAttempts++;
+
+  /* Parameter validation */
+  if ((xpHost == NULL) || (xpPath == NULL) || (xPort == 0) || (xpHandle == NULL))
+  {
+    gStatsConnectFailures++;
+    gStatsLastError = E_COMM_IF_STATUS_PARAMETER;
+    return E_COMM_IF_STATUS_PARAMETER;
+  }
+
+  for (i = 0; i < C_K_COMM__ASYNC_MAX_CONNECTIONS; i++)
+  {
+    if (!gaAsyncInfo[i].isUsed)
+    {
+      pInfo = &gaAsyncInfo[i];
+      break;
+    }
+  }
+
+  if (pInfo != NULL)
+  {
+    (void)memset(pInfo, 0, sizeof(*pInfo));
+    retStatus = httpAsyncOpen(E_COMM_IF_IP_PROTOCOL_ANY, xpPath, xpHost, xPort, &pInfo->pHttp);
+  }
+
+  if (retStatus == E_COMM_IF_STATUS_OK)
+  {
+    pInfo->isUsed = true;
+    *xpHandle = pInfo;
+    gStatsConnectSuccess++;
+  }
+  else
+  {
+    gStatsConnectFailures++;
+    gStatsLastError = retStatus;
+  }
+
+  return retStatus;
+}
+
+/**
+ * @brief  implement commMsgExchangeAsync
+ *
+ */
+TCommIfStatus commMsgExchangeAsync
+(
+  TCommIfAsyncHandle    xHandle,
+  const uint8_t*        xpMsgToSend,
+  const size_t          xSendSize,
+  TCommIfAsyncCallback  xpCallback,
+  void*                 xpContext
+)
+{
+  TCommIfStatus     retStatus = E_COMM_IF_STATUS_ERROR;
+  TCommIfAsyncInfo* pInfo = lAsyncGet(xHandle);
+
+  /* Update statistics */
+  gStatsMsgExchangeAttempts++;
+
+  /* Parameter validation */
+  if ((pInfo == NULL) || (xpMsgToSend == NULL) || (xSendSize == 0) || (xpCallback == NULL))
+  {
+    gStatsMsgExchangeFailures++;
+    gStatsLastError = E_COMM_IF_STATUS_PARAMETER;
+    return E_COMM_IF_STATUS_PARAMETER;
+  }
+
+  retStatus = httpAsyncPost(pInfo->pHttp, xpMsgToSend, xSendSize, lAsyncDone, pInfo);
+
+  if (retStatus == E_COMM_IF_STATUS_OK)
+  {
+    pInfo->pCallback = xpCallback;
+    pInfo->pContext = xpContext;
+    pInfo->pMsgToSend = xpMsgToSend;
+    pInfo->sendSize = xSendSize;
+    pInfo->isRetryAllowed = pInfo->isReused;
+  }
+  else
+  {
+    gStatsMsgExchangeFailures++;
+    gStatsLastError = retStatus;
+  }
+
+  return retStatus;
+}
+
+/**
+ * @brief  implement commAsyncPoll
+ *
+ */
+TCommIfStatus commAsyncPoll
+(
+  uint32_t xTimeoutMs
+)
+{
+  return httpAsyncPoll(xTimeoutMs);
+}
+
+/**
+ * @brief  implement commAsyncClose
+ *
+ */
+TCommIfStatus commAsyncClose
+(
+  TCommIfAsyncHandle xHandle
+)
+{
+  TCommIfStatus     retStatus = E_COMM_IF_STATUS_PARAMETER;
+  TCommIfAsyncInfo* pInfo = lAsyncGet(xHandle);
+
+  if (pInfo != NULL)
+  {
+    retStatus = httpAsyncClose(pInfo->pHttp);
+    (void)memset(pInfo, 0, sizeof(*pInfo));
+  }
+
+  return retStatus;
+}
+#endif /* __linux__ */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
 /* -------------------------------------------------------------------------- */
@@ -342,8 +699,136 @@ static bool lIsConnectionStale(void)
   time_t currentTime = time(NULL);
   time_t connectionAge = currentTime - gConnectTime;
 
-  return (connectionAge > C_COMM_IF_CONN_MAX_AGE_SEC);
+  return (connectionAge > (time_t)gMaxConnAgeSec);
+}
+
+/**
+ * @implements lIsSameServer
+ *
+ */
+static bool lIsSameServer
+(
+  const uint8_t* xpHost,
+  const uint16_t xPort,
+  const uint8_t* xpPath
+)
+{
+  return (xPort == gPort) &&
+         (strncmp((const char*)xpHost, (const char*)gaHost, sizeof(gaHost)) == 0) &&
+         (strncmp((const char*)xpPath, (const char*)gaPath, sizeof(gaPath)) == 0);
+}
+
+/**
+ * @implements lConnect
+ *
+ */
+static TCommIfStatus lConnect
+(
+  const uint8_t* xpHost,
+  const uint16_t xPort,
+  const uint8_t* xpPath
+)
+{
+  TCommIfStatus retStatus = httpInit(E_COMM_IF_IP_PROTOCOL_ANY, xpPath, xpHost, xPort);
+
+  gIsIdle = false;
+  gIsReusePending = false;
+  if (retStatus == E_COMM_IF_STATUS_OK)
+  {
+    gIsConnected = true;
+    gIsReusable = true;
+    gConnectTime = time(NULL);
+    gStatsConnectSuccess++;
+  }
+  else
+  {
+    gIsConnected = false;
+    gIsReusable = false;
+    gStatsConnectFailures++;
+    gStatsLastError = retStatus;
+  }
+
+  return retStatus;
+}
+
+#if defined(__linux__)
+/**
+ * @implements lAsyncGet
+ *
+ */
+static TCommIfAsyncInfo* lAsyncGet
+(
+  TCommIfAsyncHandle xHandle
+)
+{
+  TCommIfAsyncInfo* pInfo = NULL;
+  size_t            i;
+
+  for (i = 0; i < C_K_COMM__ASYNC_MAX_CONNECTIONS; i++)
+  {
+    if ((xHandle == (TCommIfAsyncHandle)&gaAsyncInfo[i]) && gaAsyncInfo[i].isUsed)
+    {
+      pInfo = &gaAsyncInfo[i];
+      break;
+    }
+  }
+
+  return pInfo;
+}
+
+/**
+ * @implements lAsyncDone
+ *
+ */
+static void lAsyncDone
+(
+  void*           xpContext,
+  TCommIfStatus   xStatus,
+  const uint8_t*  xpRecvMsg,
+  size_t          xRecvMsgSize
+)
+{
+  TCommIfAsyncInfo*    pInfo = (TCommIfAsyncInfo*)xpContext;
+  TCommIfAsyncCallback pCallback = pInfo->pCallback;
+  void*                pContext = pInfo->pContext;
+  TCommIfStatus        retStatus = xStatus;
+
+  /* As in commMsgExchange(), the server may close a reused connection
+   * before it reads the request: reconnect and send it once more */
+  if ((retStatus == E_COMM_IF_STATUS_NETWORK) && pInfo->isRetryAllowed)
+  {
+    pInfo->isRetryAllowed = false;
+    gStatsReuseCheckFailures++;
+    gStatsConnectAttempts++;
+    retStatus = httpAsyncPost(pInfo->pHttp, pInfo->pMsgToSend, pInfo->sendSize, lAsyncDone, pInfo);
+    if (retStatus == E_COMM_IF_STATUS_OK)
+    {
+      gStatsConnectSuccess++;
+      return;
+    }
+    gStatsConnectFailures++;
+  }
+
+  pInfo->isReused = (retStatus == E_COMM_IF_STATUS_OK);
+  pInfo->isRetryAllowed = false;
+  pInfo->pCallback = NULL;
+  pInfo->pContext = NULL;
+  pInfo->pMsgToSend = NULL;
+
+  if (retStatus == E_COMM_IF_STATUS_OK)
+  {
+    gStatsMsgExchangeSuccess++;
+  }
+  else
+  {
+    gStatsMsgExchangeFailures++;
+    gStatsLastError = retStatus;
+  }
+
+  /* The callback may start the next exchange or close the connection */
+  pCallback(pContext, retStatus, xpRecvMsg, xRecvMsgSize);
 }
+#endif /* __linux__ */
 
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
@@ -57,6 +57,8 @@
 #include "lwip/tcp.h"
 #endif
 
+#include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -120,6 +122,26 @@ static bool lIsValidComInfo
   const void* xpComInfo
 );
 
+#ifndef USE_FREERTOS_PLUS_TCP
+/**
+ * @brief Convert the buffers of a vectored write, without their first bytes.
+ *
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, at most C_K_SAL_COM_IOVEC_MAX_COUNT.
+ * @param[in] xSkipLen Number of bytes already sent.
+ * @param[out] xpIov Buffers left to send. Should not be NULL.
+ *
+ * @return Number of buffers in xpIov, 0 if all are sent.
+ */
+static int lIoVec
+(
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount,
+  size_t                xSkipLen,
+  struct iovec*         xpIov
+);
+#endif
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
 /* -------------------------------------------------------------------------- */
@@ -372,6 +394,79 @@ K_SAL_API TKCommStatus salComWrite
   return xStatus;
 }
 
+/**
+ * @brief Send several buffers to the server (FreeRTOS implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, 1 to C_K_SAL_COM_IOVEC_MAX_COUNT.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount
+)
+{
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+#ifdef USE_FREERTOS_PLUS_TCP
+  size_t        xIndex = 0U;
+#else
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  struct iovec  aIov[C_K_SAL_COM_IOVEC_MAX_COUNT];
+  int           xIovCount = 0;
+  int           xBytesSent = 0;
+  size_t        xTotalSent = 0U;
+#endif
+
+  if ((NULL == xpComInfo) || (NULL == xpVec) || (0U == xVecCount) ||
+      (C_K_SAL_COM_IOVEC_MAX_COUNT < xVecCount) || (false == lIsValidComInfo(xpComInfo)))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+#ifdef USE_FREERTOS_PLUS_TCP
+  else
+  {
+    /* FreeRTOS+TCP has no gather send, the buffers go one after the other */
+    xStatus = E_K_COMM_STATUS_OK;
+    for (xIndex = 0U; (xIndex < xVecCount) && (E_K_COMM_STATUS_OK == xStatus); xIndex++)
+    {
+      if (0U != xpVec[xIndex].len)
+      {
+        xStatus = salComWrite(xpComInfo, xpVec[xIndex].pData, xpVec[xIndex].len);
+      }
+    }
+  }
+#else
+  else if (0U == (xpInfo->state & C_SAL_COM_STATE_CONNECTED))
+  {
+    xStatus = E_K_COMM_STATUS_ERROR;
+  }
+  else
+  {
+    xStatus = E_K_COMM_STATUS_OK;
+
+    /* Send in loop until all buffers are sent */
+    while (0 != (xIovCount = lIoVec(xpVec, xVecCount, xTotalSent, aIov)))
+    {
+      xBytesSent = lwip_writev(xpInfo->socketId, aIov, xIovCount);
+
+      if (xBytesSent < 0)
+      {
+        xStatus = E_K_COMM_STATUS_NETWORK;
+        break;
+      }
+
+      xTotalSent += (size_t)xBytesSent;
+    }
+  }
+#endif
+
+  return xStatus;
+}
+
 /**
  * @brief Read data from the server (FreeRTOS implementation).
  *
@@ -429,6 +524,54 @@ K_SAL_API TKCommStatus salComRead
   return xStatus;
 }
 
+/**
+ * @brief Check an idle connection (FreeRTOS implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComCheck
+(
+  void* xpComInfo
+)
+{
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+  int           xBytesReceived = 0;
+  uint8_t       xByte = 0U;
+
+  if ((NULL == xpComInfo) || (false == lIsValidComInfo(xpComInfo)))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else if (0U == (xpInfo->state & C_SAL_COM_STATE_CONNECTED))
+  {
+    xStatus = E_K_COMM_STATUS_ERROR;
+  }
+  else
+  {
+#ifdef USE_FREERTOS_PLUS_TCP
+    /* 0 when nothing is pending, negative once the connection is closed */
+    xBytesReceived = FreeRTOS_recv(xpInfo->socketId, (void*)&xByte, 1U,
+                                   FREERTOS_MSG_PEEK | FREERTOS_MSG_DONTWAIT);
+    xStatus = (0 == xBytesReceived) ? E_K_COMM_STATUS_OK : E_K_COMM_STATUS_NETWORK;
+#else
+    xBytesReceived = lwip_recv(xpInfo->socketId, (void*)&xByte, 1U, MSG_PEEK | MSG_DONTWAIT);
+    if ((xBytesReceived < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno)))
+    {
+      xStatus = E_K_COMM_STATUS_OK;
+    }
+    else
+    {
+      xStatus = E_K_COMM_STATUS_NETWORK;
+    }
+#endif
+  }
+
+  return xStatus;
+}
+
 /**
  * @brief Terminate COM and close connection (FreeRTOS implementation).
  *
@@ -499,6 +642,48 @@ static bool lIsValidComInfo
   return xIsValid;
 }
 
+#ifndef USE_FREERTOS_PLUS_TCP
+/**
+ * @brief Convert the buffers of a vectored write, without their first bytes.
+ *
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, at most C_K_SAL_COM_IOVEC_MAX_COUNT.
+ * @param[in] xSkipLen Number of bytes already sent.
+ * @param[out] xpIov Buffers left to send. Should not be NULL.
+ *
+ * @return Number of buffers in xpIov, 0 if all are sent.
+ */
+static int lIoVec
+(
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount,
+  size_t                xSkipLen,
+  struct iovec*         xpIov
+)
+{
+  size_t xSkip = xSkipLen;
+  size_t xIndex = 0U;
+  int    xCount = 0;
+
+  for (xIndex = 0U; xIndex < xVecCount; xIndex++)
+  {
+    if (xpVec[xIndex].len <= xSkip)
+    {
+      xSkip -= xpVec[xIndex].len;
+    }
+    else
+    {
+      xpIov[xCount].iov_base = (void*)(xpVec[xIndex].pData + xSkip);
+      xpIov[xCount].iov_len = xpVec[xIndex].len - xSkip;
+      xSkip = 0U;
+      xCount++;
+    }
+  }
+
+  return xCount;
+}
+#endif
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
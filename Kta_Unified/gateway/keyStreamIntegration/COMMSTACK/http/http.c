@@ -62,6 +62,31 @@
 #define C_HTTP_SUCCESS_STATUS_CODE (200u)
 /** @brief HTTP token max len. */
 #define C_HTTP_TOKEN_MAX_LEN (256u)
+/** @brief httpPost error: the request could not be sent. */
+#define C_HTTP_POST_SEND_ERROR (-2)
+/** @brief httpPost error: the connection was closed or reset before any response byte. */
+#define C_HTTP_POST_NO_RESPONSE (-3)
+/** @brief httpPost error: the response did not come within the read timeout. */
+#define C_HTTP_POST_TIMEOUT (-4)
+
+#if defined(__linux__)
+/** @brief Asynchronous HTTP connection. */
+typedef struct
+{
+  TKHttpInfo            info;
+  TKSalComIoVec         aRequest[C_HTTP__REQUEST_VEC_COUNT];
+  size_t                requestLen;
+  size_t                sentLen;
+  /* Request being sent, the body is the caller buffer. */
+  uint8_t               aBody[C_HTTP_MAX_DATA_LEN];
+  /* Response body, received in place. */
+  TCommIfAsyncCallback  pCallback;
+  void*                 pContext;
+  BOOL                  isUsed;
+  BOOL                  isBusy;
+  /* A request is in progress, pCallback is not called yet. */
+} TKHttpAsync;
+#endif /* __linux__ */
 
 /******************************************************************************/
 /* LOCAL MACROS                                                               */
@@ -102,6 +127,14 @@
 
 static TKHttpInfo gHttpInfo = {0};
 
+#if defined(__linux__)
+/** @brief Asynchronous connections. */
+static TKHttpAsync gaHttpAsync[C_K_COMM__ASYNC_MAX_CONNECTIONS];
+
+/** @brief Header and chunk framing of the asynchronous responses, parsed on receipt. */
+static uint8_t gaHttpAsyncRecv[C_HTTP_MAX_DATA_LEN];
+#endif /* __linux__ */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
@@ -144,25 +177,125 @@ static int httpHeader(
 
 /**
  * @brief
- *   This API fetches the HTTP body and status code.
+ *   Process the status, header or trailer line collected in aLine.
  *
- * @param[in] xpHttpInfo
+ * @param[in,out] xpHttpInfo
+ *   Structure with HTTP information.
+ *
+ * @return
+ * - 0, in case of success.
+ * - -1, in case of error.
+ */
+static int httpLineEnd(
+    TKHttpInfo *xpHttpInfo);
+
+/**
+ * @brief
+ *   Account body bytes stored at body[bodyLen] and move to the next state
+ *   once the body or the current chunk is complete.
+ *
+ * @param[in,out] xpHttpInfo
+ *   Structure with HTTP information.
+ * @param[in] xLen
+ *   Number of bytes stored, at most length.
+ */
+static void httpBodyReceived(
+    TKHttpInfo *xpHttpInfo,
+    size_t xLen);
+
+/**
+ * @brief
+ *   Feed received bytes to the response parser. The bytes may end anywhere in
+ *   the response; the parser state is kept in xpHttpInfo between the calls.
+ *
+ * @param[in,out] xpHttpInfo
  *   Structure with HTTP information.
+ * @param[in] xpData
+ *   Received bytes. Should not be NULL.
+ * @param[in] xDataLen
+ *   Number of received bytes.
  *
  * @return
  * - 0, in case of success.
  * - -1, in case of error.
  */
 static int httpParse(
+    TKHttpInfo *xpHttpInfo,
+    const uint8_t *xpData,
+    size_t xDataLen);
+
+/**
+ * @brief
+ *   Build the HTTP post request: the header prefix of the connection, the
+ *   Content-Length value and Cookie formatted in aTail, then the body in place.
+ *
+ * @param[in,out] xpHttpInfo
+ *   Structure with HTTP information.
+ * @param[in] xpData
+ *   Request body.
+ * @param[in] xDataLen
+ *   Request body size.
+ * @param[out] xpVec
+ *   The C_HTTP__REQUEST_VEC_COUNT buffers of the request.
+ *
+ * @return
+ * - Size of the request, in case of success.
+ * - -1, in case of error.
+ */
+static long httpRequest(
+    TKHttpInfo *xpHttpInfo,
+    const uint8_t *xpData,
+    size_t xDataLen,
+    TKSalComIoVec *xpVec);
+
+/**
+ * @brief
+ *   Reset the response parser before receiving a response.
+ *
+ * @param[in,out] xpHttpInfo
+ *   Structure with HTTP information.
+ * @param[out] xpBody
+ *   Buffer receiving the response body.
+ * @param[in] xBodySize
+ *   Size of xpBody.
+ */
+static void httpParseStart(
+    TKHttpInfo *xpHttpInfo,
+    uint8_t *xpBody,
+    size_t xBodySize);
+
+/**
+ * @brief
+ *   Keep the session cookie of a complete response for the next request.
+ *
+ * @param[in,out] xpHttpInfo
+ *   Structure with HTTP information.
+ */
+static void httpParseEnd(
     TKHttpInfo *xpHttpInfo);
 
+/**
+ * @brief
+ *   Tell whether any byte of the response was received.
+ *   Until then, a request on a closed or reset connection was not processed
+ *   and can be sent again.
+ *
+ * @param[in] xpHttpInfo
+ *   Structure with HTTP information.
+ *
+ * @return
+ * - C_HTTP__TRUE if part of the response was received.
+ * - C_HTTP__FALSE otherwise.
+ */
+static BOOL httpIsResponseStarted(
+    const TKHttpInfo *xpHttpInfo);
+
 /**
  * @brief
  *   To send the HTTP post request.
  *
  * @param[in] xpHttpInfo
  *   Structure with HTTP information.
- * @param[in] xpDir
  * @param[in] xpData
  * @param[in] xDataLen
  * @param[in] xpResponse
@@ -171,17 +304,125 @@ static int httpParse(
  *   HTTP reponse body size.
  *
  * @return
- * - 0, in case of success.
- * - -1, in case of error.
+ * - HTTP status code of the response.
+ * - C_HTTP_POST_SEND_ERROR if the request could not be sent.
+ * - C_HTTP_POST_NO_RESPONSE if the connection was closed or reset before any
+ *   response byte.
+ * - C_HTTP_POST_TIMEOUT if the response did not come in time.
+ * - -1 for other errors.
  */
 static int httpPost(
     TKHttpInfo *xpHttpInfo,
-    const uint8_t *xpDir,
     const uint8_t *xpData,
     size_t xDataLen,
     uint8_t *xpResponse,
     size_t xSize);
 
+/**
+ * @brief
+ *   Set the server URL and the request header prefix.
+ *
+ * @param[out] xpHttpInfo
+ *   Structure with HTTP information.
+ * @param[in] xpUri
+ *   Server path.
+ * @param[in] xpHost
+ *   Server host, with or without "http://".
+ * @param[in] xPort
+ *   Server port.
+ *
+ * @return
+ * - 0, in case of success.
+ * - -1, in case of error.
+ */
+static int httpUrl(
+    TKHttpInfo *xpHttpInfo,
+    const uint8_t *xpUri,
+    const uint8_t *xpHost,
+    uint16_t xPort);
+
+#if defined(__linux__)
+/**
+ * @brief
+ *   Convert a SAL status.
+ *
+ * @param[in] xStatus
+ *   SAL status.
+ *
+ * @return
+ *   Communication Interface status.
+ */
+static TCommIfStatus httpAsyncStatus(
+    TKCommStatus xStatus);
+
+/**
+ * @brief
+ *   Get the asynchronous connection of a handle.
+ *
+ * @param[in] xpHttp
+ *   Handle from httpAsyncOpen().
+ *
+ * @return
+ *   The connection, NULL if the handle is not valid.
+ */
+static TKHttpAsync *httpAsyncGet(
+    void *xpHttp);
+
+/**
+ * @brief
+ *   Receive the SAL events of an asynchronous connection.
+ *
+ * @param[in] xpContext
+ *   Asynchronous connection.
+ * @param[in] xEvents
+ *   C_K_SAL_COM_EVENT_* flags.
+ */
+static void httpAsyncEvent(
+    void *xpContext,
+    uint32_t xEvents);
+
+/**
+ * @brief
+ *   Send the rest of the request, then wait for the response.
+ *
+ * @param[in,out] xpAsync
+ *   Asynchronous connection.
+ *
+ * @return
+ * - 0, in case of success.
+ * - -1, in case of error.
+ */
+static int httpAsyncSend(
+    TKHttpAsync *xpAsync);
+
+/**
+ * @brief
+ *   Receive and parse the available response bytes.
+ *
+ * @param[in,out] xpAsync
+ *   Asynchronous connection.
+ *
+ * @return
+ * - 0, in case of success.
+ * - -1, in case of error.
+ */
+static int httpAsyncReceive(
+    TKHttpAsync *xpAsync);
+
+/**
+ * @brief
+ *   End the request in progress and call its callback.
+ *
+ * @param[in,out] xpAsync
+ *   Asynchronous connection.
+ * @param[in] xStatus
+ *   E_COMM_IF_STATUS_OK if the response is complete, else the error status.
+ */
+static void httpAsyncDone(
+    TKHttpAsync *xpAsync,
+    TCommIfStatus xStatus);
+#endif /* __linux__ */
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
 /* -------------------------------------------------------------------------- */
@@ -205,8 +446,6 @@ TCommIfStatus httpInit(
     const uint16_t xPort)
 {
   TKCommStatus status = E_K_COMM_STATUS_ERROR;
-  const uint8_t *pHost = NULL;
-  int retVal;
 
   M_UNUSED(xIpProtocol);
   M_INTL_HTTP_DEBUG(("Start of %s", __func__));
@@ -218,31 +457,12 @@ TCommIfStatus httpInit(
   }
   else
   {
-    retVal = strncmp((const char *)xpHost, "http://", 7);
-    if (retVal == 0)
-    {
-      pHost = &xpHost[7];
-    }
-    else
-    {
-      pHost = &xpHost[0];
-    }
     (void)memset(&gHttpInfo, 0, sizeof(gHttpInfo));
-    (void)strncpy((char *)gHttpInfo.url.host, (const char *)pHost, sizeof(gHttpInfo.url.host) - 1UL);
-    {
-      /* Validate snprintf result: silent truncation would yield a wrong
-       * port string and a confusing connect failure deeper in the stack. */
-      int port_len = snprintf((char *)gHttpInfo.url.port,
-                              sizeof(gHttpInfo.url.port),
-                              "%u", (unsigned int)xPort);
-      if (port_len < 0 || (size_t)port_len >= sizeof(gHttpInfo.url.port))
-      {
-        M_INTL_HTTP_ERROR(("Port number out of range or truncated: %u", (unsigned int)xPort));
-        status = E_K_COMM_STATUS_PARAMETER;
-        goto httpinit_end;
-      }
+    if (httpUrl(&gHttpInfo, xpUri, xpHost, xPort) != 0)
+    {
+      status = E_K_COMM_STATUS_PARAMETER;
+      goto httpinit_end;
     }
-    (void)strncpy((char *)gHttpInfo.url.path, (const char *)xpUri, sizeof(gHttpInfo.url.path) - 1UL);
 
     status = salComInit(C_HTTP_CONNECT_TIMEOUT_IN_MS,
                         C_HTTP_READ_TIMEOUT_IN_MS,
@@ -291,7 +511,6 @@ TCommIfStatus httpMsgExchange(
   else
   {
     ret = httpPost(&gHttpInfo,
-                   gHttpInfo.url.path,
                    xpMsgToSend,
                    xSendSize,
                    xpRecvMsgBuffer,
@@ -303,6 +522,24 @@ TCommIfStatus httpMsgExchange(
       M_INTL_HTTP_DEBUG(("Received Data %ld", gHttpInfo.bodyLen));
       *xpRecvMsgBufferSize = (size_t)gHttpInfo.bodyLen;
     }
+    else if ((ret == C_HTTP_POST_SEND_ERROR) || (ret == C_HTTP_POST_NO_RESPONSE))
+    {
+      /* The server did not process the request, it can be sent again. */
+      status = E_COMM_IF_STATUS_NETWORK;
+    }
+    else if (ret == C_HTTP_POST_TIMEOUT)
+    {
+      status = E_COMM_IF_STATUS_TIMEOUT;
+    }
+    else if (ret < 0)
+    {
+      /* The response was cut or is broken. */
+      status = E_COMM_IF_STATUS_DATA;
+    }
+    else
+    {
+      /* HTTP error status from the server. */
+    }
   }
 
   M_INTL_HTTP_DEBUG(("End of %s", __func__));
@@ -324,6 +561,217 @@ TCommIfStatus httpTerm(void)
   return (TCommIfStatus)status;
 }
 
+/**
+ * @brief  implement httpReuse
+ *
+ */
+TCommIfStatus httpReuse(void)
+{
+  TCommIfStatus status = E_COMM_IF_STATUS_NO_CONNECTION;
+
+  M_INTL_HTTP_DEBUG(("Start of %s", __func__));
+  if (NULL != gHttpInfo.pTls)
+  {
+    if (E_K_COMM_STATUS_OK == salComCheck(gHttpInfo.pTls))
+    {
+      /* The new session starts without the cookie of the previous one. */
+      (void)memset(&gHttpInfo.request, 0, sizeof(gHttpInfo.request));
+      (void)memset(&gHttpInfo.response, 0, sizeof(gHttpInfo.response));
+      status = E_COMM_IF_STATUS_OK;
+    }
+    else
+    {
+      M_INTL_HTTP_ERROR(("Idle connection closed by the server"));
+      status = E_COMM_IF_STATUS_NETWORK;
+    }
+  }
+  M_INTL_HTTP_DEBUG(("End of %s", __func__));
+  return status;
+}
+
+#if defined(__linux__)
+/**
+ * @brief  implement httpAsyncOpen
+ *
+ */
+TCommIfStatus httpAsyncOpen(
+    const TCommIfIpProtocol xIpProtocol,
+    const uint8_t *xpUri,
+    const uint8_t *xpHost,
+    const uint16_t xPort,
+    void **xppHttp)
+{
+  TCommIfStatus status = E_COMM_IF_STATUS_RESOURCE;
+  TKHttpAsync *pAsync = NULL;
+  size_t i;
+
+  M_UNUSED(xIpProtocol);
+  M_INTL_HTTP_DEBUG(("Start of %s", __func__));
+
+  if ((NULL == xpUri) || (NULL == xpHost) || (0U == xPort) || (NULL == xppHttp))
+  {
+    M_INTL_HTTP_ERROR(("Invalid Parameter"));
+    status = E_COMM_IF_STATUS_PARAMETER;
+  }
+  else
+  {
+    for (i = 0; i < C_K_COMM__ASYNC_MAX_CONNECTIONS; i++)
+    {
+      if (gaHttpAsync[i].isUsed == C_HTTP__FALSE)
+      {
+        pAsync = &gaHttpAsync[i];
+        break;
+      }
+    }
+
+    if (NULL != pAsync)
+    {
+      (void)memset(pAsync, 0, sizeof(*pAsync));
+      if (httpUrl(&pAsync->info, xpUri, xpHost, xPort) != 0)
+      {
+        status = E_COMM_IF_STATUS_PARAMETER;
+      }
+      else
+      {
+        status = httpAsyncStatus(salComAsyncConnect(C_HTTP_CONNECT_TIMEOUT_IN_MS,
+                                                    C_HTTP_READ_TIMEOUT_IN_MS,
+                                                    pAsync->info.url.host,
+                                                    pAsync->info.url.port,
+                                                    httpAsyncEvent,
+                                                    pAsync,
+                                                    &pAsync->info.pTls));
+      }
+      if (status == E_COMM_IF_STATUS_OK)
+      {
+        pAsync->isUsed = C_HTTP__TRUE;
+        *xppHttp = pAsync;
+      }
+      else
+      {
+        M_INTL_HTTP_ERROR(("salComAsyncConnect Failed"));
+        pAsync->info.pTls = NULL;
+      }
+    }
+  }
+
+  M_INTL_HTTP_DEBUG(("End of %s", __func__));
+  return status;
+}
+
+/**
+ * @brief  implement httpAsyncPost
+ *
+ */
+TCommIfStatus httpAsyncPost(
+    void *xpHttp,
+    const uint8_t *xpMsgToSend,
+    const size_t xSendSize,
+    TCommIfAsyncCallback xpCallback,
+    void *xpContext)
+{
+  TCommIfStatus status = E_COMM_IF_STATUS_OK;
+  TKHttpAsync *pAsync = httpAsyncGet(xpHttp);
+  long len;
+
+  M_INTL_HTTP_DEBUG(("Start of %s", __func__));
+
+  if ((NULL == pAsync) || (NULL == xpMsgToSend) || (0UL == xSendSize) || (NULL == xpCallback))
+  {
+    M_INTL_HTTP_ERROR(("Invalid Parameter"));
+    status = E_COMM_IF_STATUS_PARAMETER;
+  }
+  else if (pAsync->isBusy == C_HTTP__TRUE)
+  {
+    status = E_COMM_IF_STATUS_RESOURCE;
+  }
+  else
+  {
+    len = httpRequest(&pAsync->info, xpMsgToSend, xSendSize, pAsync->aRequest);
+    if (len < 0)
+    {
+      M_INTL_HTTP_ERROR(("Invalid request"));
+      status = E_COMM_IF_STATUS_PARAMETER;
+    }
+    else if (NULL == pAsync->info.pTls)
+    {
+      /* The previous exchange closed the connection, the cookie is kept. */
+      status = httpAsyncStatus(salComAsyncConnect(C_HTTP_CONNECT_TIMEOUT_IN_MS,
+                                                  C_HTTP_READ_TIMEOUT_IN_MS,
+                                                  pAsync->info.url.host,
+                                                  pAsync->info.url.port,
+                                                  httpAsyncEvent,
+                                                  pAsync,
+                                                  &pAsync->info.pTls));
+      if (status != E_COMM_IF_STATUS_OK)
+      {
+        M_INTL_HTTP_ERROR(("salComAsyncConnect Failed"));
+        pAsync->info.pTls = NULL;
+      }
+    }
+    else
+    {
+      /* Connected and idle. */
+    }
+
+    if (status == E_COMM_IF_STATUS_OK)
+    {
+      pAsync->requestLen = (size_t)len;
+      pAsync->sentLen = 0;
+      httpParseStart(&pAsync->info, pAsync->aBody, sizeof(pAsync->aBody));
+      /* Sent from the reactor, once the connection is writable. */
+      status = httpAsyncStatus(salComAsyncWatch(pAsync->info.pTls, C_K_SAL_COM_EVENT_WRITE));
+    }
+    if (status == E_COMM_IF_STATUS_OK)
+    {
+      pAsync->pCallback = xpCallback;
+      pAsync->pContext = xpContext;
+      pAsync->isBusy = C_HTTP__TRUE;
+    }
+  }
+
+  M_INTL_HTTP_DEBUG(("End of %s", __func__));
+  return status;
+}
+
+/**
+ * @brief  implement httpAsyncPoll
+ *
+ */
+TCommIfStatus httpAsyncPoll(
+    uint32_t xTimeoutMs)
+{
+  TKCommStatus status = salComAsyncWait(xTimeoutMs);
+
+  return (status == E_K_COMM_STATUS_STATE) ? E_COMM_IF_STATUS_NO_CONNECTION : httpAsyncStatus(status);
+}
+
+/**
+ * @brief  implement httpAsyncClose
+ *
+ */
+TCommIfStatus httpAsyncClose(
+    void *xpHttp)
+{
+  TCommIfStatus status = E_COMM_IF_STATUS_PARAMETER;
+  TKHttpAsync *pAsync = httpAsyncGet(xpHttp);
+
+  M_INTL_HTTP_DEBUG(("Start of %s", __func__));
+  if (NULL != pAsync)
+  {
+    status = E_COMM_IF_STATUS_OK;
+    if (NULL != pAsync->info.pTls)
+    {
+      status = httpAsyncStatus(salComAsyncTerm(pAsync->info.pTls));
+    }
+    pAsync->info.pTls = NULL;
+    pAsync->isBusy = C_HTTP__FALSE;
+    pAsync->isUsed = C_HTTP__FALSE;
+  }
+  M_INTL_HTTP_DEBUG(("End of %s", __func__));
+  return status;
+}
+#endif /* __linux__ */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
 /* -------------------------------------------------------------------------- */
@@ -442,21 +890,19 @@ static int httpHeader(
   char *pToken;
   char aT1[C_HTTP_TOKEN_MAX_LEN] = {0};
   char aT2[C_HTTP_TOKEN_MAX_LEN] = {0};
-  int len;
   int retVal = 0;
 
   pToken = xpParam;
 
+  /* A header without value is skipped, the caller checks the status line. */
   pToken = pStrToken(pToken, aT1, (int)C_HTTP_TOKEN_MAX_LEN);
   if (pToken == NULL)
   {
-    retVal = -1;
     goto end;
   }
   pToken = pStrToken(pToken, aT2, (int)C_HTTP_TOKEN_MAX_LEN);
   if (pToken == NULL)
   {
-    retVal = -1;
     goto end;
   }
 
@@ -488,9 +934,8 @@ static int httpHeader(
   }
   else if (lstrncasecmp(aT1, "location:", 9) == 0)
   {
-    len = (int)strlen(aT2);
-    (void)strncpy(xpHttpInfo->response.location, aT2, (unsigned int)len);
-    xpHttpInfo->response.location[len] = '\0';
+    (void)snprintf(xpHttpInfo->response.location, C_HTTP__HEADER_FIELD_SIZE, "%.*s",
+                   (int)(C_HTTP__HEADER_FIELD_SIZE - 1), aT2);
   }
   else if (lstrncasecmp(aT1, "content-length:", 15) == 0)
   {
@@ -531,286 +976,334 @@ end:
 }
 
 /**
- * @implements httpParse
+ * @implements httpLineEnd
  *
  **/
-/**
- * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
- * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
- * Using goto for breaking during the error and return cases.
- **/
-static int httpParse(
+static int httpLineEnd(
     TKHttpInfo *xpHttpInfo)
 {
-  char *pPtr1;
-  char *pPtr2;
-  long len;
-  int retVal = -1;
-  ptrdiff_t offset = 0;
-  size_t ptrOffset;
+  int retVal = 0;
 
-  if (xpHttpInfo->recvLen == 0U)
+  xpHttpInfo->aLine[xpHttpInfo->lineLen] = '\0';
+
+  if (xpHttpInfo->parseState == E_HTTP_PARSE_STATUS_LINE)
   {
-    retVal = -1;
+    if (xpHttpInfo->lineLen != 0U)
+    {
+      M_INTL_HTTP_DEBUG(("status: %s", xpHttpInfo->aLine));
+      if ((httpHeader(xpHttpInfo, xpHttpInfo->aLine) != 0) ||
+          (xpHttpInfo->response.status == 0))
+      {
+        M_INTL_HTTP_ERROR(("Invalid status line"));
+        retVal = -1;
+      }
+      xpHttpInfo->parseState = E_HTTP_PARSE_HEADER_LINE;
+    }
+  }
+  else if (xpHttpInfo->parseState == E_HTTP_PARSE_TRAILER)
+  {
+    if (xpHttpInfo->lineLen == 0U)
+    {
+      xpHttpInfo->parseState = E_HTTP_PARSE_DONE;
+    }
+  }
+  else if (xpHttpInfo->lineLen != 0U)
+  {
+    M_INTL_HTTP_DEBUG(("header: %s(%u)..", xpHttpInfo->aLine, (unsigned int)xpHttpInfo->lineLen));
+    if (httpHeader(xpHttpInfo, xpHttpInfo->aLine) != 0)
+    {
+      M_INTL_HTTP_ERROR(("httpHeader returned Error"));
+      retVal = -1;
+    }
   }
   else
   {
-    pPtr1 = (char *)xpHttpInfo->pRecvBuf;
+    M_INTL_HTTP_DEBUG(("header_end ...."));
+    if (xpHttpInfo->response.chunked == C_HTTP__TRUE)
+    {
+      xpHttpInfo->parseState = E_HTTP_PARSE_CHUNK_SIZE;
+      xpHttpInfo->length = 0;
+      xpHttpInfo->hasChunkSize = C_HTTP__FALSE;
+    }
+    else if (xpHttpInfo->response.contentLength > xpHttpInfo->bodySize)
+    {
+      M_INTL_HTTP_ERROR(("Body of %ld bytes exceeds the buffer", xpHttpInfo->response.contentLength));
+      retVal = -1;
+    }
+    else if (xpHttpInfo->response.contentLength > 0)
+    {
+      xpHttpInfo->parseState = E_HTTP_PARSE_BODY;
+      xpHttpInfo->length = xpHttpInfo->response.contentLength;
+    }
+    else
+    {
+      xpHttpInfo->parseState = E_HTTP_PARSE_DONE;
+    }
+  }
 
-    /* Using the variable while(C_HTTP_TRUE) instead of while(1), to resolve the misra warning
-     * Warning: 1 is not a boolean type
-     */
-    while (C_HTTP__TRUE)
+  xpHttpInfo->lineLen = 0;
+  return retVal;
+}
+
+/**
+ * @implements httpBodyReceived
+ *
+ **/
+static void httpBodyReceived(
+    TKHttpInfo *xpHttpInfo,
+    size_t xLen)
+{
+  xpHttpInfo->bodyLen += (long)xLen;
+  xpHttpInfo->length -= (long)xLen;
+
+  if (xpHttpInfo->length == 0)
+  {
+    if (xpHttpInfo->parseState == E_HTTP_PARSE_CHUNK_DATA)
     {
-      if (xpHttpInfo->headerEnd == C_HTTP__FALSE) /* Header parser. */
+      xpHttpInfo->parseState = E_HTTP_PARSE_CHUNK_DATA_END;
+    }
+    else
+    {
+      xpHttpInfo->parseState = E_HTTP_PARSE_DONE;
+    }
+  }
+}
+
+/**
+ * @implements httpParse
+ *
+ **/
+static int httpParse(
+    TKHttpInfo *xpHttpInfo,
+    const uint8_t *xpData,
+    size_t xDataLen)
+{
+  const uint8_t *pEol;
+  size_t offset = 0;
+  size_t len;
+  size_t copyLen;
+  int digit;
+  uint8_t byte;
+  int retVal = 0;
+
+  while ((offset < xDataLen) &&
+         (retVal == 0) &&
+         (xpHttpInfo->parseState != E_HTTP_PARSE_DONE))
+  {
+    switch (xpHttpInfo->parseState)
+    {
+      case E_HTTP_PARSE_BODY:
+      case E_HTTP_PARSE_CHUNK_DATA:
       {
-        pPtr2 = strstr(pPtr1, "\r\n");
-        if (pPtr2 != NULL)
+        /* Body bytes that arrived with the header or the chunk framing. */
+        len = xDataLen - offset;
+        if (len > (size_t)xpHttpInfo->length)
         {
-          len = (long)(pPtr2 - pPtr1);
-          *pPtr2 = '\0';
+          len = (size_t)xpHttpInfo->length;
+        }
+        (void)memcpy(&xpHttpInfo->body[xpHttpInfo->bodyLen], &xpData[offset], len);
+        httpBodyReceived(xpHttpInfo, len);
+        offset += len;
+        break;
+      }
 
-          if (len > 0)
-          {
-            M_INTL_HTTP_DEBUG(("header: %s(%ld)..", pPtr1, len));
-            if (httpHeader(xpHttpInfo, pPtr1) != 0)
-            {
-              M_INTL_HTTP_ERROR(("httpHeader returned Error"));
-              retVal = -1;
-              goto end;
-            }
-            pPtr1 = &pPtr2[2]; /* Skip CR+LF. */
-          }
-          else
+      case E_HTTP_PARSE_CHUNK_SIZE:
+      {
+        byte = xpData[offset];
+        if (isxdigit((int)byte) != 0)
+        {
+          digit = (isdigit((int)byte) != 0) ? ((int)byte - '0') : (tolower((int)byte) - 'a' + 10);
+          xpHttpInfo->length = (xpHttpInfo->length * 16) + digit;
+          xpHttpInfo->hasChunkSize = C_HTTP__TRUE;
+          if (xpHttpInfo->length > (xpHttpInfo->bodySize - xpHttpInfo->bodyLen))
           {
-
-            xpHttpInfo->headerEnd = C_HTTP__TRUE; /* Reach the header-end. */
-
-            M_INTL_HTTP_DEBUG(("header_end ...."));
-
-            pPtr1 = &pPtr2[2]; /* Skip CR+LF. */
-
-            if (xpHttpInfo->response.chunked == C_HTTP__TRUE)
-            {
-              offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-              len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-              if (len > 0)
-              {
-                pPtr2 = strstr(pPtr1, "\r\n");
-                if (pPtr2 != NULL)
-                {
-                  *pPtr2 = '\0';
-                  errno = 0;
-                  xpHttpInfo->length = strtol(pPtr1, NULL, 16);
-                  if (0 != errno)
-                  {
-                    M_INTL_HTTP_ERROR(("Error Occured %d", errno));
-                  }
-                  if (xpHttpInfo->length == 0)
-                  {
-                    xpHttpInfo->response.chunked = C_HTTP__FALSE;
-                  }
-                  else
-                  {
-                    xpHttpInfo->response.contentLength += xpHttpInfo->length;
-                  }
-                  pPtr1 = &pPtr2[2]; /* Skip CR+LF. */
-                }
-                else
-                {
-                  /* Copy the data as chunked size. */
-                  (void)strncpy((char *)xpHttpInfo->pRecvBuf, pPtr1, (unsigned int)len);
-                  xpHttpInfo->pRecvBuf[len] = '\0';
-                  xpHttpInfo->recvLen = (size_t)len;
-                  xpHttpInfo->length = -1;
-                  retVal = 0;
-                  goto end;
-                }
-              }
-              else
-              {
-                xpHttpInfo->recvLen = 0;
-                xpHttpInfo->length = -1;
-                retVal = 0;
-                goto end;
-              }
-            }
-            else
-            {
-              xpHttpInfo->length = xpHttpInfo->response.contentLength;
-            }
+            M_INTL_HTTP_ERROR(("Chunk exceeds the buffer"));
+            retVal = -1;
           }
+          offset++;
         }
         else
         {
-          offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-          len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-          if (len > 0)
-          {
-            /* Keep the partial header data. */
-            (void)strncpy((char *)xpHttpInfo->pRecvBuf, pPtr1, (unsigned int)len);
-            xpHttpInfo->pRecvBuf[len] = '\0';
-            xpHttpInfo->recvLen = (size_t)len;
-          }
-          else
-          {
-            xpHttpInfo->recvLen = 0;
-          }
-          retVal = 0;
-          goto end;
+          /* End of the size, the rest of the line is skipped. */
+          xpHttpInfo->parseState = E_HTTP_PARSE_CHUNK_EXT;
         }
+        break;
       }
-      else /* Body parser. */
-      {
 
-        if ((xpHttpInfo->response.chunked == C_HTTP__TRUE) && (xpHttpInfo->length == -1))
+      case E_HTTP_PARSE_CHUNK_EXT:
+      {
+        byte = xpData[offset];
+        offset++;
+        if (byte == (uint8_t)'\n')
         {
-          offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-          len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-          if (len > 0)
+          if (xpHttpInfo->hasChunkSize == C_HTTP__FALSE)
           {
-            pPtr2 = strstr(pPtr1, "\r\n");
-            if (pPtr2 != NULL)
-            {
-              *pPtr2 = '\0';
-              errno = 0;
-              xpHttpInfo->length = strtol(pPtr1, NULL, 16);
-              if (0 != errno)
-              {
-                M_INTL_HTTP_ERROR(("Error Occured %d", errno));
-              }
-              if (xpHttpInfo->length == 0)
-              {
-                xpHttpInfo->response.chunked = C_HTTP__FALSE;
-              }
-              else
-              {
-                xpHttpInfo->response.contentLength += xpHttpInfo->length;
-              }
-
-              pPtr1 = &pPtr2[2]; /* Skip CR+LF */
-            }
-            else
-            {
-              /* Copy the remain data as chunked size. */
-              (void)strncpy((char *)xpHttpInfo->pRecvBuf, pPtr1, (unsigned int)len);
-              xpHttpInfo->pRecvBuf[len] = '\0';
-              xpHttpInfo->recvLen = (size_t)len;
-              xpHttpInfo->length = -1;
-              retVal = 0;
-              goto end;
-            }
+            M_INTL_HTTP_ERROR(("Missing chunk size"));
+            retVal = -1;
+          }
+          else if (xpHttpInfo->length == 0)
+          {
+            xpHttpInfo->parseState = E_HTTP_PARSE_TRAILER;
           }
           else
           {
-            xpHttpInfo->recvLen = 0;
-            retVal = 0;
-            goto end;
+            xpHttpInfo->response.contentLength += xpHttpInfo->length;
+            xpHttpInfo->parseState = E_HTTP_PARSE_CHUNK_DATA;
           }
         }
+        break;
+      }
+
+      case E_HTTP_PARSE_CHUNK_DATA_END:
+      {
+        byte = xpData[offset];
+        offset++;
+        if (byte == (uint8_t)'\n')
+        {
+          xpHttpInfo->parseState = E_HTTP_PARSE_CHUNK_SIZE;
+          xpHttpInfo->length = 0;
+          xpHttpInfo->hasChunkSize = C_HTTP__FALSE;
+        }
+        else if (byte != (uint8_t)'\r')
+        {
+          M_INTL_HTTP_ERROR(("Missing CR+LF after chunk"));
+          retVal = -1;
+        }
         else
         {
-          if (xpHttpInfo->length > 0)
-          {
-            offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-            len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-
-            if (len > xpHttpInfo->length)
-            {
-              /* Copy the data for response. */
-              if (xpHttpInfo->bodyLen < xpHttpInfo->bodySize)
-              {
-                if (xpHttpInfo->bodySize > (xpHttpInfo->bodyLen + xpHttpInfo->length))
-                {
-                  (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]),
-                               (const void *)pPtr1,
-                               (unsigned int)xpHttpInfo->length);
-                  xpHttpInfo->bodyLen += xpHttpInfo->length;
-                }
-                else
-                {
-                  (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]),
-                               (const void *)pPtr1,
-                               (unsigned int)(xpHttpInfo->bodySize - xpHttpInfo->bodyLen));
-                  xpHttpInfo->bodyLen = xpHttpInfo->bodySize;
-                }
-              }
-
-              ptrOffset = xpHttpInfo->length;
-              pPtr1 = &pPtr1[ptrOffset];
-              len -= xpHttpInfo->length;
-
-              if ((xpHttpInfo->response.chunked == C_HTTP__TRUE) && (len >= 2))
-              {
-                pPtr1 = &pPtr1[2]; /* Skip CR+LF. */
-                xpHttpInfo->length = -1;
-              }
-              else
-              {
-                retVal = -1;
-                goto end;
-              }
-            }
-            else
-            {
-              /* Copy the data for response. */
-              if (xpHttpInfo->bodyLen < xpHttpInfo->bodySize)
-              {
-                if (xpHttpInfo->bodySize > (xpHttpInfo->bodyLen + len))
-                {
-                  (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]), (const void *)pPtr1, (unsigned int)len);
-                  xpHttpInfo->bodyLen += len;
-                }
-                else
-                {
-                  (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]),
-                               (const void *)pPtr1,
-                               (unsigned int)(xpHttpInfo->bodySize - xpHttpInfo->bodyLen));
-                  xpHttpInfo->bodyLen = xpHttpInfo->bodySize;
-                }
-              }
-
-              xpHttpInfo->length -= len;
-              xpHttpInfo->recvLen = 0;
-
-              if ((xpHttpInfo->response.chunked == C_HTTP__FALSE) && (xpHttpInfo->length <= 0))
-              {
-                retVal = 1;
-                goto end;
-              }
-              retVal = 0;
-              goto end;
-            }
-          }
-          else
+          /* CR of the CR+LF. */
+        }
+        break;
+      }
+
+      default:
+      {
+        /* Status, header and trailer lines, the part beyond aLine is dropped. */
+        pEol = (const uint8_t *)memchr(&xpData[offset], (int)'\n', xDataLen - offset);
+        len = (pEol != NULL) ? (size_t)(pEol - &xpData[offset]) : (xDataLen - offset);
+        copyLen = (C_HTTP__LINE_SIZE - 1u) - xpHttpInfo->lineLen;
+        if (copyLen > len)
+        {
+          copyLen = len;
+        }
+        (void)memcpy(&xpHttpInfo->aLine[xpHttpInfo->lineLen], &xpData[offset], copyLen);
+        xpHttpInfo->lineLen += copyLen;
+        offset += len;
+        if (pEol != NULL)
+        {
+          offset++;
+          if ((xpHttpInfo->lineLen != 0U) &&
+              (xpHttpInfo->aLine[xpHttpInfo->lineLen - 1U] == '\r'))
           {
-            if (xpHttpInfo->response.chunked == C_HTTP__FALSE)
-            {
-              retVal = 1;
-              goto end;
-            }
-
-            /* Chunked size check. */
-            if ((xpHttpInfo->recvLen > 2u) && (strncmp(pPtr1, "\r\n", 2) == 0))
-            {
-              pPtr1 = &pPtr1[2];
-              xpHttpInfo->length = -1;
-            }
-            else
-            {
-              xpHttpInfo->length = -1;
-              xpHttpInfo->recvLen = 0;
-            }
+            xpHttpInfo->lineLen--;
           }
+          retVal = httpLineEnd(xpHttpInfo);
         }
+        break;
       }
     }
-  end:
-    retVal = 0;
   }
+
   return retVal;
 }
 
+/**
+ * @implements httpRequest
+ *
+ **/
+static long httpRequest(
+    TKHttpInfo *xpHttpInfo,
+    const uint8_t *xpData,
+    size_t xDataLen,
+    TKSalComIoVec *xpVec)
+{
+  int len;
+  long retVal = -1;
+
+  /* Only the Content-Length value and the Cookie change between requests. */
+  len = snprintf(xpHttpInfo->aTail, sizeof(xpHttpInfo->aTail),
+                 "%lu\r\n"
+                 "Cookie: %s\r\n"
+                 "\r\n",
+                 (unsigned long)xDataLen,
+                 xpHttpInfo->request.cookie);
+
+  M_INTL_HTTP_DEBUG(("Post Header len %u", (unsigned int)(xpHttpInfo->prefixLen + (size_t)len)));
+  if ((xpHttpInfo->prefixLen != 0U) && (len > 0) && ((size_t)len < sizeof(xpHttpInfo->aTail)))
+  {
+    xpHttpInfo->tailLen = (size_t)len;
+    xpVec[0].pData = (const uint8_t *)xpHttpInfo->aPrefix;
+    xpVec[0].len = xpHttpInfo->prefixLen;
+    xpVec[1].pData = (const uint8_t *)xpHttpInfo->aTail;
+    xpVec[1].len = xpHttpInfo->tailLen;
+    xpVec[2].pData = xpData;
+    xpVec[2].len = xDataLen;
+    retVal = (long)(xpHttpInfo->prefixLen + xpHttpInfo->tailLen + xDataLen);
+  }
+
+  return retVal;
+}
+
+/**
+ * @implements httpParseStart
+ *
+ **/
+static void httpParseStart(
+    TKHttpInfo *xpHttpInfo,
+    uint8_t *xpBody,
+    size_t xBodySize)
+{
+  xpHttpInfo->response.status = 0;
+  xpHttpInfo->response.contentLength = 0;
+  xpHttpInfo->response.chunked = C_HTTP__FALSE;
+  xpHttpInfo->response.close = C_HTTP__FALSE;
+
+  xpHttpInfo->parseState = E_HTTP_PARSE_STATUS_LINE;
+  xpHttpInfo->length = 0;
+  xpHttpInfo->lineLen = 0;
+
+  xpHttpInfo->body = xpBody;
+  xpHttpInfo->bodySize = (long)xBodySize;
+  xpHttpInfo->bodyLen = 0;
+}
+
+/**
+ * @implements httpParseEnd
+ *
+ **/
+static void httpParseEnd(
+    TKHttpInfo *xpHttpInfo)
+{
+  M_INTL_HTTP_DEBUG(("status  : %d", xpHttpInfo->response.status));
+  M_INTL_HTTP_DEBUG(("cookie  : %s", xpHttpInfo->response.cookie));
+  M_INTL_HTTP_DEBUG(("location: %s", xpHttpInfo->response.location));
+  M_INTL_HTTP_DEBUG(("length  : %ld", xpHttpInfo->response.contentLength));
+  M_INTL_HTTP_DEBUG(("body    : %ld", xpHttpInfo->bodyLen));
+  /* Propagate session cookie from server response to next request.
+   * The server may issue Set-Cookie on the first exchange and expect
+   * that cookie to be echoed back on subsequent POSTs. */
+  if (xpHttpInfo->response.cookie[0] != '\0')
+  {
+    (void)strncpy(xpHttpInfo->request.cookie,
+                  xpHttpInfo->response.cookie,
+                  C_HTTP__HEADER_FIELD_SIZE - 1U);
+    xpHttpInfo->request.cookie[C_HTTP__HEADER_FIELD_SIZE - 1U] = '\0';
+    M_INTL_HTTP_DEBUG(("cookie propagated to next request: %s",
+                       xpHttpInfo->request.cookie));
+  }
+}
+
+/**
+ * @implements httpIsResponseStarted
+ *
+ **/
+static BOOL httpIsResponseStarted(
+    const TKHttpInfo *xpHttpInfo)
+{
+  return ((xpHttpInfo->parseState == E_HTTP_PARSE_STATUS_LINE) &&
+          (xpHttpInfo->lineLen == 0U)) ? C_HTTP__FALSE : C_HTTP__TRUE;
+}
+
 /**
  * @implements httpPost
  *
@@ -822,15 +1315,17 @@ static int httpParse(
  **/
 static int httpPost(
     TKHttpInfo *xpHttpInfo,
-    const uint8_t *xpDir,
     const uint8_t *xpData,
     size_t xDataLen,
     uint8_t *xpResponse,
     size_t xSize)
 {
   TKCommStatus status = E_K_COMM_STATUS_ERROR;
-  uint8_t aBuffer[C_HTTP_MAX_DATA_LEN] = {0};
-  unsigned int len;
+  uint8_t aBuffer[C_HTTP_MAX_DATA_LEN];
+  TKSalComIoVec aRequest[C_HTTP__REQUEST_VEC_COUNT];
+  uint8_t *pRecv;
+  size_t recvSize;
+  size_t recvLen;
   int retVal = -1;
 
   M_INTL_HTTP_DEBUG(("Start of %s", __func__));
@@ -841,99 +1336,405 @@ static int httpPost(
   }
   else
   {
-    /* Send HTTP buffer. */
-    len = (unsigned int)snprintf((char *)aBuffer, C_HTTP_MAX_DATA_LEN,
-                                 "POST %s HTTP/1.1\r\n"
-                                 "Host: %s:%s\r\n"
-                                 "Connection: Keep-Alive\r\n"
-                                 "Content-Type: application/octet-stream\r\n"
-                                 "Content-Length: %d\r\n"
-                                 "Cookie: %s\r\n"
-                                 "\r\n",
-                                 (const char *)xpDir,
-                                 xpHttpInfo->url.host,
-                                 xpHttpInfo->url.port,
-                                 (int)xDataLen,
-                                 xpHttpInfo->request.cookie);
-
-    M_INTL_HTTP_DEBUG(("Post Header len %d", len));
-    (void)memcpy(&aBuffer[len], xpData, xDataLen);
-    len = len + xDataLen;
-    if (len > C_HTTP_MAX_DATA_LEN)
-    {
-      M_INTL_HTTP_ERROR(("Buffer Overflow"));
+    /* Send the header and the body as they are, without gathering them. */
+    if (httpRequest(xpHttpInfo, xpData, xDataLen, aRequest) < 0)
+    {
+      M_INTL_HTTP_ERROR(("Invalid request"));
       (void)salComTerm(xpHttpInfo->pTls);
       retVal = -1;
       goto end;
     }
-    status = salComWrite(xpHttpInfo->pTls, aBuffer, len);
+    status = salComWritev(xpHttpInfo->pTls, aRequest, C_HTTP__REQUEST_VEC_COUNT);
     if (E_K_COMM_STATUS_OK != status)
     {
-      M_INTL_HTTP_ERROR(("salComWrite Failed"));
+      M_INTL_HTTP_ERROR(("salComWritev Failed"));
       (void)salComTerm(xpHttpInfo->pTls);
-      retVal = -1;
+      retVal = C_HTTP_POST_SEND_ERROR;
       goto end;
     }
 
-    xpHttpInfo->response.status = 0;
-    xpHttpInfo->response.contentLength = 0;
-    xpHttpInfo->response.close = C_HTTP__FALSE;
+    httpParseStart(xpHttpInfo, xpResponse, xSize);
+
+    /* Read until the response is complete. The header and the chunk framing
+     * go through aBuffer, the body is received in place in xpResponse. */
+    while (xpHttpInfo->parseState != E_HTTP_PARSE_DONE)
+    {
+      if ((xpHttpInfo->parseState == E_HTTP_PARSE_BODY) ||
+          (xpHttpInfo->parseState == E_HTTP_PARSE_CHUNK_DATA))
+      {
+        pRecv = &xpHttpInfo->body[xpHttpInfo->bodyLen];
+        recvSize = (size_t)xpHttpInfo->length;
+      }
+      else
+      {
+        pRecv = aBuffer;
+        recvSize = sizeof(aBuffer);
+      }
+      recvLen = recvSize;
 
-    xpHttpInfo->recvLen = 0;
-    xpHttpInfo->headerEnd = C_HTTP__FALSE;
+      status = salComRead(xpHttpInfo->pTls, pRecv, &recvLen);
+      if ((E_K_COMM_STATUS_OK != status) || (0U == recvLen) || (recvLen > recvSize))
+      {
+        M_INTL_HTTP_ERROR(("salComRead Failed"));
+        (void)salComTerm(xpHttpInfo->pTls);
+        if (E_K_COMM_STATUS_TIMEOUT == status)
+        {
+          retVal = C_HTTP_POST_TIMEOUT;
+        }
+        else if ((E_K_COMM_STATUS_NETWORK == status) && (httpIsResponseStarted(xpHttpInfo) == C_HTTP__FALSE))
+        {
+          retVal = C_HTTP_POST_NO_RESPONSE;
+        }
+        else
+        {
+          retVal = -1;
+        }
+        goto end;
+      }
 
-    xpHttpInfo->body = xpResponse;
-    xpHttpInfo->bodySize = (long)xSize;
-    xpHttpInfo->bodyLen = 0;
-    xpHttpInfo->body[0] = 0;
-    xpHttpInfo->recvLen = sizeof(aBuffer);
-    xpHttpInfo->pRecvBuf = (char *)aBuffer;
+      if (pRecv != aBuffer)
+      {
+        httpBodyReceived(xpHttpInfo, recvLen);
+      }
+      else if (httpParse(xpHttpInfo, aBuffer, recvLen) != 0)
+      {
+        M_INTL_HTTP_ERROR(("httpParse returned Error"));
+        (void)salComTerm(xpHttpInfo->pTls);
+        retVal = -1;
+        goto end;
+      }
+      else
+      {
+        /* Parsed, continue with the next read. */
+      }
+    }
 
-    status = salComRead(xpHttpInfo->pTls, aBuffer, &xpHttpInfo->recvLen);
-    if (E_K_COMM_STATUS_OK != status)
+    if ((int)xpHttpInfo->response.close == 1)
     {
-      M_INTL_HTTP_ERROR(("salComRead Failed"));
       (void)salComTerm(xpHttpInfo->pTls);
+    }
+
+    httpParseEnd(xpHttpInfo);
+    retVal = xpHttpInfo->response.status;
+    goto end;
+  }
+
+end:
+  return retVal;
+}
+
+/**
+ * @implements httpUrl
+ *
+ **/
+static int httpUrl(
+    TKHttpInfo *xpHttpInfo,
+    const uint8_t *xpUri,
+    const uint8_t *xpHost,
+    uint16_t xPort)
+{
+  const uint8_t *pHost = NULL;
+  int len;
+  int retVal = 0;
+
+  if (strncmp((const char *)xpHost, "http://", 7) == 0)
+  {
+    pHost = &xpHost[7];
+  }
+  else
+  {
+    pHost = &xpHost[0];
+  }
+  (void)strncpy((char *)xpHttpInfo->url.host, (const char *)pHost, sizeof(xpHttpInfo->url.host) - 1UL);
+  {
+    /* Validate snprintf result: silent truncation would yield a wrong
+     * port string and a confusing connect failure deeper in the stack. */
+    int port_len = snprintf((char *)xpHttpInfo->url.port,
+                            sizeof(xpHttpInfo->url.port),
+                            "%u", (unsigned int)xPort);
+    if (port_len < 0 || (size_t)port_len >= sizeof(xpHttpInfo->url.port))
+    {
+      M_INTL_HTTP_ERROR(("Port number out of range or truncated: %u", (unsigned int)xPort));
       retVal = -1;
-      goto end;
     }
-    if (httpParse(xpHttpInfo) != 0)
+  }
+  (void)strncpy((char *)xpHttpInfo->url.path, (const char *)xpUri, sizeof(xpHttpInfo->url.path) - 1UL);
+
+  if (retVal == 0)
+  {
+    /* Header lines that stay the same for all the requests of the connection. */
+    len = snprintf(xpHttpInfo->aPrefix, sizeof(xpHttpInfo->aPrefix),
+                   "POST %s HTTP/1.1\r\n"
+                   "Host: %s:%s\r\n"
+                   "Connection: Keep-Alive\r\n"
+                   "Content-Type: application/octet-stream\r\n"
+                   "Content-Length: ",
+                   (const char *)xpHttpInfo->url.path,
+                   xpHttpInfo->url.host,
+                   xpHttpInfo->url.port);
+    if ((len < 0) || ((size_t)len >= sizeof(xpHttpInfo->aPrefix)))
     {
-      M_INTL_HTTP_ERROR(("httpHeader returned Error"));
+      M_INTL_HTTP_ERROR(("Request header too long"));
       retVal = -1;
-      goto end;
     }
+    else
+    {
+      xpHttpInfo->prefixLen = (size_t)len;
+    }
+  }
 
-    if ((int)xpHttpInfo->response.close == 1)
+  return retVal;
+}
+
+#if defined(__linux__)
+/**
+ * @implements httpAsyncStatus
+ *
+ **/
+static TCommIfStatus httpAsyncStatus(
+    TKCommStatus xStatus)
+{
+  TCommIfStatus status;
+
+  switch (xStatus)
+  {
+    case E_K_COMM_STATUS_OK:
+      status = E_COMM_IF_STATUS_OK;
+      break;
+    case E_K_COMM_STATUS_PARAMETER:
+      status = E_COMM_IF_STATUS_PARAMETER;
+      break;
+    case E_K_COMM_STATUS_TIMEOUT:
+      status = E_COMM_IF_STATUS_TIMEOUT;
+      break;
+    case E_K_COMM_STATUS_RESOURCE:
+      status = E_COMM_IF_STATUS_RESOURCE;
+      break;
+    case E_K_COMM_STATUS_NETWORK:
+      status = E_COMM_IF_STATUS_NETWORK;
+      break;
+    default:
+      status = E_COMM_IF_STATUS_ERROR;
+      break;
+  }
+
+  return status;
+}
+
+/**
+ * @implements httpAsyncGet
+ *
+ **/
+static TKHttpAsync *httpAsyncGet(
+    void *xpHttp)
+{
+  TKHttpAsync *pAsync = NULL;
+  size_t i;
+
+  for (i = 0; i < C_K_COMM__ASYNC_MAX_CONNECTIONS; i++)
+  {
+    if ((xpHttp == (void *)&gaHttpAsync[i]) && (gaHttpAsync[i].isUsed == C_HTTP__TRUE))
     {
-      (void)salComTerm(xpHttpInfo->pTls);
+      pAsync = &gaHttpAsync[i];
+      break;
     }
+  }
+
+  return pAsync;
+}
+
+/**
+ * @implements httpAsyncEvent
+ *
+ **/
+static void httpAsyncEvent(
+    void *xpContext,
+    uint32_t xEvents)
+{
+  TKHttpAsync *pAsync = (TKHttpAsync *)xpContext;
 
-    M_INTL_HTTP_DEBUG(("status  : %d", xpHttpInfo->response.status));
-    M_INTL_HTTP_DEBUG(("cookie  : %s", xpHttpInfo->response.cookie));
-    M_INTL_HTTP_DEBUG(("location: %s", xpHttpInfo->response.location));
-    M_INTL_HTTP_DEBUG(("length  : %ld", xpHttpInfo->response.contentLength));
-    M_INTL_HTTP_DEBUG(("body    : %ld", xpHttpInfo->bodyLen));
-    /* Propagate session cookie from server response to next request.
-     * The server may issue Set-Cookie on the first exchange and expect
-     * that cookie to be echoed back on subsequent POSTs. */
-    if (xpHttpInfo->response.cookie[0] != '\0')
+  if (pAsync->isBusy == C_HTTP__FALSE)
+  {
+    if ((xEvents & (C_K_SAL_COM_EVENT_ERROR | C_K_SAL_COM_EVENT_TIMEOUT)) != 0U)
     {
-      (void)strncpy(xpHttpInfo->request.cookie,
-                    xpHttpInfo->response.cookie,
-                    C_HTTP__HEADER_FIELD_SIZE - 1U);
-      xpHttpInfo->request.cookie[C_HTTP__HEADER_FIELD_SIZE - 1U] = '\0';
-      M_INTL_HTTP_DEBUG(("cookie propagated to next request: %s",
-                         xpHttpInfo->request.cookie));
+      /* Idle connection reset or not established, the next request reconnects. */
+      (void)salComAsyncTerm(pAsync->info.pTls);
+      pAsync->info.pTls = NULL;
+    }
+  }
+  else if (((xEvents & C_K_SAL_COM_EVENT_WRITE) != 0U) && (httpAsyncSend(pAsync) != 0))
+  {
+    httpAsyncDone(pAsync, E_COMM_IF_STATUS_NETWORK);
+  }
+  else if (((xEvents & C_K_SAL_COM_EVENT_READ) != 0U) && (httpAsyncReceive(pAsync) != 0))
+  {
+    /* Nothing received means the server dropped the request, else the
+     * response is broken. */
+    httpAsyncDone(pAsync, (httpIsResponseStarted(&pAsync->info) == C_HTTP__TRUE) ?
+                          E_COMM_IF_STATUS_DATA : E_COMM_IF_STATUS_NETWORK);
+  }
+  else if (pAsync->info.parseState == E_HTTP_PARSE_DONE)
+  {
+    httpAsyncDone(pAsync, (pAsync->info.response.status == (int)C_HTTP_SUCCESS_STATUS_CODE) ?
+                          E_COMM_IF_STATUS_OK : E_COMM_IF_STATUS_ERROR);
+  }
+  else if ((xEvents & C_K_SAL_COM_EVENT_ERROR) != 0U)
+  {
+    httpAsyncDone(pAsync, (httpIsResponseStarted(&pAsync->info) == C_HTTP__TRUE) ?
+                          E_COMM_IF_STATUS_DATA : E_COMM_IF_STATUS_NETWORK);
+  }
+  else if ((xEvents & C_K_SAL_COM_EVENT_TIMEOUT) != 0U)
+  {
+    httpAsyncDone(pAsync, E_COMM_IF_STATUS_TIMEOUT);
+  }
+  else
+  {
+    /* Wait for the next event. */
+  }
+}
+
+/**
+ * @implements httpAsyncSend
+ *
+ **/
+static int httpAsyncSend(
+    TKHttpAsync *xpAsync)
+{
+  TKSalComIoVec aVec[C_HTTP__REQUEST_VEC_COUNT];
+  size_t skip = xpAsync->sentLen;
+  size_t count = 0;
+  size_t len = 0;
+  size_t i;
+  int retVal = 0;
+
+  /* Buffers left after a partial send. */
+  for (i = 0; i < C_HTTP__REQUEST_VEC_COUNT; i++)
+  {
+    if (xpAsync->aRequest[i].len <= skip)
+    {
+      skip -= xpAsync->aRequest[i].len;
+    }
+    else
+    {
+      aVec[count].pData = &xpAsync->aRequest[i].pData[skip];
+      aVec[count].len = xpAsync->aRequest[i].len - skip;
+      skip = 0;
+      count++;
+    }
+  }
+
+  if (count != 0U)
+  {
+    if (salComAsyncWritev(xpAsync->info.pTls, aVec, count, &len) != E_K_COMM_STATUS_OK)
+    {
+      M_INTL_HTTP_ERROR(("salComAsyncWritev Failed"));
+      retVal = -1;
+    }
+    else
+    {
+      xpAsync->sentLen += len;
+      if ((xpAsync->sentLen == xpAsync->requestLen) &&
+          (salComAsyncWatch(xpAsync->info.pTls, C_K_SAL_COM_EVENT_READ) != E_K_COMM_STATUS_OK))
+      {
+        retVal = -1;
+      }
     }
-    retVal = xpHttpInfo->response.status;
-    goto end;
   }
 
-end:
   return retVal;
 }
 
+/**
+ * @implements httpAsyncReceive
+ *
+ **/
+static int httpAsyncReceive(
+    TKHttpAsync *xpAsync)
+{
+  TKHttpInfo *pInfo = &xpAsync->info;
+  uint8_t *pRecv;
+  size_t recvSize;
+  size_t recvLen;
+  int retVal = 0;
+
+  /* The body is received in place, the rest goes through the shared buffer. */
+  if ((pInfo->parseState == E_HTTP_PARSE_BODY) ||
+      (pInfo->parseState == E_HTTP_PARSE_CHUNK_DATA))
+  {
+    pRecv = &pInfo->body[pInfo->bodyLen];
+    recvSize = (size_t)pInfo->length;
+  }
+  else
+  {
+    pRecv = gaHttpAsyncRecv;
+    recvSize = sizeof(gaHttpAsyncRecv);
+  }
+  recvLen = recvSize;
+
+  if ((salComAsyncRead(pInfo->pTls, pRecv, &recvLen) != E_K_COMM_STATUS_OK) || (recvLen > recvSize))
+  {
+    M_INTL_HTTP_ERROR(("salComAsyncRead Failed"));
+    retVal = -1;
+  }
+  else if (recvLen == 0U)
+  {
+    /* Nothing yet. */
+  }
+  else if (pRecv != gaHttpAsyncRecv)
+  {
+    httpBodyReceived(pInfo, recvLen);
+  }
+  else if (httpParse(pInfo, gaHttpAsyncRecv, recvLen) != 0)
+  {
+    M_INTL_HTTP_ERROR(("httpParse returned Error"));
+    retVal = -1;
+  }
+  else
+  {
+    /* Parsed, wait for the next bytes. */
+  }
+
+  return retVal;
+}
+
+/**
+ * @implements httpAsyncDone
+ *
+ **/
+static void httpAsyncDone(
+    TKHttpAsync *xpAsync,
+    TCommIfStatus xStatus)
+{
+  TCommIfAsyncCallback pCallback = xpAsync->pCallback;
+  void *pContext = xpAsync->pContext;
+
+  if ((xStatus != E_COMM_IF_STATUS_OK) || ((int)xpAsync->info.response.close == 1))
+  {
+    (void)salComAsyncTerm(xpAsync->info.pTls);
+    xpAsync->info.pTls = NULL;
+  }
+  else
+  {
+    /* Keep the connection idle for the next request. */
+    (void)salComAsyncWatch(xpAsync->info.pTls, 0U);
+  }
+
+  if (xStatus == E_COMM_IF_STATUS_OK)
+  {
+    httpParseEnd(&xpAsync->info);
+  }
+
+  /* The callback may post the next request on this connection. */
+  xpAsync->isBusy = C_HTTP__FALSE;
+  xpAsync->pCallback = NULL;
+  xpAsync->pContext = NULL;
+  pCallback(pContext,
+            xStatus,
+            (xStatus == E_COMM_IF_STATUS_OK) ? xpAsync->aBody : NULL,
+            (xStatus == E_COMM_IF_STATUS_OK) ? (size_t)xpAsync->info.bodyLen : 0U);
+}
+#endif /* __linux__ */
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
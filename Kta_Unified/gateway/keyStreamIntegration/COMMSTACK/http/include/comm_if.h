@@ -70,6 +70,9 @@ extern "C" {
 /** @brief Server mount path. */
 #define C_K_COMM__SERVER_URI "/lp1"
 
+/** @brief Maximum number of asynchronous connections open at the same time. */
+#define C_K_COMM__ASYNC_MAX_CONNECTIONS (16u)
+
 /** @brief Communication Interface return status codes. */
 typedef enum
 {
@@ -104,6 +107,8 @@ typedef enum
   /* IP V4. */
   E_COMM_IF_IP_PROTOCOL_V6,
   /* IP V6. */
+  E_COMM_IF_IP_PROTOCOL_ANY,
+  /* IP V6 or V4, whichever connects first. [NEW] */
   E_COMM_IF_IP_NUM_PROTOCOLS
   /* Number of supported IP protocols. */
 } TCommIfIpProtocol;
@@ -131,8 +136,39 @@ typedef struct
   /* Current connection state. */
   uint32_t      connectionAgeSeconds;
   /* Age of current connection in seconds (0 if not connected). */
+  uint32_t      connectReused;
+  /* Number of commInit() calls served by the idle connection. */
+  uint32_t      reuseCheckFailures;
+  /* Number of idle connections found closed when reused. */
 } TCommIfStatistics;
 
+#if defined(__linux__)
+/** @brief Asynchronous connection, from commAsyncOpen(). */
+typedef void* TCommIfAsyncHandle;
+
+/**
+ * @brief
+ *   Receives the outcome of an asynchronous message exchange.
+ *
+ * @param[in] xpContext
+ *   Context given to commMsgExchangeAsync().
+ * @param[in] xStatus
+ *   E_COMM_IF_STATUS_OK or the error status, as for commMsgExchange().
+ * @param[in] xpRecvMsg
+ *   Response received from server, NULL on error. Valid until the callback
+ *   returns, the next exchange on the connection may reuse the buffer.
+ * @param[in] xRecvMsgSize
+ *   Size of the response, in bytes.
+ */
+typedef void (*TCommIfAsyncCallback)
+(
+  void*           xpContext,
+  TCommIfStatus   xStatus,
+  const uint8_t*  xpRecvMsg,
+  size_t          xRecvMsgSize
+);
+#endif /* __linux__ */
+
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
 /* -------------------------------------------------------------------------- */
@@ -183,8 +219,15 @@ TCommIfStatus commInit
  * - E_COMM_IF_STATUS_OK or the error status, in particular:
  * - E_COMM_IF_STATUS_PARAMETER if wrong parameters received.
  * - E_COMM_IF_STATUS_NO_CONNECTION if not connected (call commInit first).
- * - E_COMM_IF_STATUS_NETWORK if any network issue.
- * - E_COMM_IF_STATUS_TIMEOUT if operation timed out.
+ * - E_COMM_IF_STATUS_NETWORK if the request could not be sent, or if the
+ *   connection was closed or reset before any response byte.
+ * - E_COMM_IF_STATUS_TIMEOUT if the response did not come in time.
+ * - E_COMM_IF_STATUS_DATA if the response was cut or is broken.
+ *
+ * @note
+ *   On a connection reused from commTerm(), the request is sent once more on a
+ *   new connection only after E_COMM_IF_STATUS_NETWORK. It is never sent
+ *   twice once part of the response was received or the read timed out.
  */
 TCommIfStatus commMsgExchange
 (
@@ -197,6 +240,11 @@ TCommIfStatus commMsgExchange
 /**
  * @brief
  *   Terminate communication stack.
+ *   A healthy connection younger than the maximum connection age is kept
+ *   idle instead, and the next commInit() to the same server reuses it.
+ *   The socket then stays open: call commClose() when the connection must
+ *   really be closed, e.g. before a network change or a power down, or set
+ *   the maximum connection age to 0.
  *
  * @return
  * - E_COMM_IF_STATUS_OK or the error status, in particular.
@@ -207,6 +255,30 @@ TCommIfStatus commTerm
   void
 );
 
+/**
+ * @brief
+ *   Close the connection, including the one kept idle by commTerm().
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK or the error status.
+ */
+TCommIfStatus commClose
+(
+  void
+);
+
+/**
+ * @brief
+ *   Set the maximum connection age. Older connections are not reused.
+ *
+ * @param[in] xMaxAgeSeconds
+ *   Maximum age in seconds; 0 closes the connection at every commTerm().
+ */
+void commSetMaxConnectionAge
+(
+  uint32_t xMaxAgeSeconds
+);
+
 /**
  * @brief
  *   Get communication statistics. [NEW]
@@ -240,13 +312,109 @@ void commResetStatistics
  * @return
  * - E_COMM_IF_STATUS_OK if connection is healthy.
  * - E_COMM_IF_STATUS_NO_CONNECTION if not connected.
- * - E_COMM_IF_STATUS_STALE if connection is too old (>5 minutes).
+ * - E_COMM_IF_STATUS_STALE if connection is older than the maximum age.
  */
 TCommIfStatus commCheckConnectionHealth
 (
   void
 );
 
+#if defined(__linux__)
+/**
+ * @brief
+ *   Open an asynchronous connection, independent of the commInit() one.
+ *   Each device session uses its own connection and session cookie.
+ *
+ * @param[in] xpHost
+ *   IP address of server; should not be NULL. It must have '\0' character at the end.
+ * @param[in] xPort
+ *   Port of the server listening to client requests.
+ * @param[in] xpPath
+ *   Server path; should not be NULL. It must have '\0' character at the end.
+ * @param[out] xpHandle
+ *   Handle of the connection; should not be NULL.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK or the error status, in particular:
+ * - E_COMM_IF_STATUS_PARAMETER if wrong parameters received.
+ * - E_COMM_IF_STATUS_RESOURCE if C_K_COMM__ASYNC_MAX_CONNECTIONS are open.
+ * - E_COMM_IF_STATUS_NETWORK if any network issue.
+ */
+TCommIfStatus commAsyncOpen
+(
+  const uint8_t*       xpHost,
+  const uint16_t       xPort,
+  const uint8_t*       xpPath,
+  TCommIfAsyncHandle*  xpHandle
+);
+
+/**
+ * @brief
+ *   Start sending a message to server without waiting for the response.
+ *   commAsyncPoll() runs the exchange and calls xpCallback once it is over.
+ *
+ * @param[in] xHandle
+ *   Connection from commAsyncOpen() with no exchange in progress.
+ * @param[in] xpMsgToSend
+ *   Message to send to server; should not be NULL. Must stay valid until
+ *   xpCallback is called.
+ * @param[in] xSendSize
+ *   size of the message, in bytes.
+ * @param[in] xpCallback
+ *   Receives the response; should not be NULL. It may start the next
+ *   exchange or close the connection.
+ * @param[in] xpContext
+ *   Passed back to xpCallback.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK if the exchange is started, xpCallback is called later.
+ * - E_COMM_IF_STATUS_PARAMETER if wrong parameters received.
+ * - E_COMM_IF_STATUS_RESOURCE if an exchange is in progress on the connection.
+ * - E_COMM_IF_STATUS_NETWORK if any network issue.
+ */
+TCommIfStatus commMsgExchangeAsync
+(
+  TCommIfAsyncHandle    xHandle,
+  const uint8_t*        xpMsgToSend,
+  const size_t          xSendSize,
+  TCommIfAsyncCallback  xpCallback,
+  void*                 xpContext
+);
+
+/**
+ * @brief
+ *   Run the asynchronous exchanges: wait for network events on all the
+ *   connections and call the callbacks of the completed exchanges.
+ *
+ * @param[in] xTimeoutMs
+ *   Longest time to wait for a first event, in milliseconds.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK or the error status.
+ * - E_COMM_IF_STATUS_NO_CONNECTION if no asynchronous connection was opened.
+ */
+TCommIfStatus commAsyncPoll
+(
+  uint32_t xTimeoutMs
+);
+
+/**
+ * @brief
+ *   Close an asynchronous connection. The callback of an exchange in
+ *   progress is not called.
+ *
+ * @param[in] xHandle
+ *   Connection from commAsyncOpen().
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK or the error status.
+ */
+TCommIfStatus commAsyncClose
+(
+  TCommIfAsyncHandle xHandle
+);
+#endif /* __linux__ */
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
@@ -100,7 +100,11 @@ TCommIfStatus httpInit
  * @return
  * - E_COMM_IF_STATUS_OK or the error status, in particular.
  * - E_COMM_IF_STATUS_PARAMETER if wrong parameters received.
- * - E_COMM_IF_STATUS_NETWORK if any network issue.
+ * - E_COMM_IF_STATUS_NETWORK if the request could not be sent, or if the
+ *   connection was closed or reset before any response byte. Only then was
+ *   the request not processed by the server.
+ * - E_COMM_IF_STATUS_TIMEOUT if the response did not come in time.
+ * - E_COMM_IF_STATUS_DATA if the response was cut or is broken.
  */
 TCommIfStatus httpMsgExchange
 (
@@ -122,6 +126,114 @@ TCommIfStatus httpTerm
   void
 );
 
+/**
+ * @brief
+ *   Start a new session on the connection left open by the previous one.
+ *   The connection is checked first and the session cookie is cleared.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK if the connection can be used.
+ * - E_COMM_IF_STATUS_NO_CONNECTION if no connection is open.
+ * - E_COMM_IF_STATUS_NETWORK if the server closed the connection.
+ */
+TCommIfStatus httpReuse
+(
+  void
+);
+
+#if defined(__linux__)
+/**
+ * @brief
+ *   Open an asynchronous Http connection, with its own session cookie.
+ *
+ * @param[in] xpUri
+ *   Server uri; should not be NULL. It must have '\0' character at the end.
+ * @param[in] xpHost
+ *   IP address of server; should not be NULL. It must have '\0' character at the end.
+ * @param[in] xPort
+ *   Port of the server listening to client requests.
+ * @param[out] xppHttp
+ *   Http connection; should not be NULL.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK or the error status, in particular.
+ * - E_COMM_IF_STATUS_RESOURCE if all the connections are used.
+ * - E_COMM_IF_STATUS_NETWORK if any network issue.
+ */
+TCommIfStatus httpAsyncOpen
+(
+  const TCommIfIpProtocol  xIpProtocol,
+  const uint8_t*           xpUri,
+  const uint8_t*           xpHost,
+  const uint16_t           xPort,
+  void**                   xppHttp
+);
+
+/**
+ * @brief
+ *   Start a post request on an asynchronous connection, reconnecting first
+ *   if the previous exchange closed it. The response is given to xpCallback.
+ *   A failure before any response byte is reported as E_COMM_IF_STATUS_NETWORK.
+ *
+ * @param[in] xpHttp
+ *   Http connection from httpAsyncOpen(); should not be NULL.
+ * @param[in] xpMsgToSend
+ *   Message to send to server; should not be NULL.
+ * @param[in] xSendSize
+ *   Size of the message, in bytes.
+ * @param[in] xpCallback
+ *   Receives the response; should not be NULL.
+ * @param[in] xpContext
+ *   Passed back to xpCallback.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK if the request is started.
+ * - E_COMM_IF_STATUS_PARAMETER if wrong parameters received.
+ * - E_COMM_IF_STATUS_RESOURCE if a request is in progress.
+ * - E_COMM_IF_STATUS_NETWORK if any network issue.
+ */
+TCommIfStatus httpAsyncPost
+(
+  void*                 xpHttp,
+  const uint8_t*        xpMsgToSend,
+  const size_t          xSendSize,
+  TCommIfAsyncCallback  xpCallback,
+  void*                 xpContext
+);
+
+/**
+ * @brief
+ *   Wait for network events and run the asynchronous requests.
+ *
+ * @param[in] xTimeoutMs
+ *   Longest time to wait for a first event, in milliseconds.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK or the error status.
+ * - E_COMM_IF_STATUS_NO_CONNECTION if no asynchronous connection was opened.
+ */
+TCommIfStatus httpAsyncPoll
+(
+  uint32_t xTimeoutMs
+);
+
+/**
+ * @brief
+ *   Close an asynchronous Http connection, without calling the callback of
+ *   a request in progress.
+ *
+ * @param[in] xpHttp
+ *   Http connection from httpAsyncOpen().
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK or the error status.
+ */
+TCommIfStatus httpAsyncClose
+(
+  void* xpHttp
+);
+#endif /* __linux__ */
+
 #endif // HTTP_IF_H
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
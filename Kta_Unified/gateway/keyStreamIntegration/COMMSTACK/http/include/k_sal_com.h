@@ -66,6 +66,44 @@ extern "C" {
 /* -------------------------------------------------------------------------- */
 /* CONSTANTS, TYPES, ENUM                                                     */
 /* -------------------------------------------------------------------------- */
+/** @brief Maximum number of buffers of a vectored write. */
+#define C_K_SAL_COM_IOVEC_MAX_COUNT   (4u)
+
+/** @brief One buffer of a vectored write. */
+typedef struct
+{
+  const uint8_t*  pData;
+  /* Data to send. */
+  size_t          len;
+  /* Size of the data, in bytes. */
+} TKSalComIoVec;
+
+#if defined(__linux__)
+/** @brief Asynchronous connection events, see salComAsyncWatch(). */
+#define C_K_SAL_COM_EVENT_READ        (0x01u)
+/* Data or end of stream can be read without blocking. */
+#define C_K_SAL_COM_EVENT_WRITE       (0x02u)
+/* Data can be sent without blocking, the connection is established. */
+#define C_K_SAL_COM_EVENT_ERROR       (0x04u)
+/* The connection failed or was reset. */
+#define C_K_SAL_COM_EVENT_TIMEOUT     (0x08u)
+/* No event during the connect or read timeout. */
+
+/**
+ * @brief
+ *   Receives the events of an asynchronous connection, from salComAsyncWait().
+ *
+ * @param[in] xpContext
+ *   Context given to salComAsyncConnect().
+ * @param[in] xEvents
+ *   C_K_SAL_COM_EVENT_* flags.
+ */
+typedef void (*TKSalComEventCallback)
+(
+  void*     xpContext,
+  uint32_t  xEvents
+);
+#endif /* __linux__ */
 
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
@@ -153,6 +191,34 @@ K_SAL_API TKCommStatus salComWrite
   size_t          xBufferLen
 );
 
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Send several buffers to the server as one stream, without gathering them
+ *   in an intermediate buffer.
+ *
+ * @pre
+ *   salComConnect should be successfully executed prior to this function.
+ *
+ * @param[in] xpComInfo
+ *   Com Info data; Should not be NULL.
+ * @param[in] xpVec
+ *   Buffers to send, in order; Should not be NULL. Empty buffers are skipped.
+ * @param[in] xVecCount
+ *   Number of buffers, 1 to C_K_SAL_COM_IOVEC_MAX_COUNT.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount
+);
+
 /**
  * @ingroup
  *   g_sal_com
@@ -181,6 +247,30 @@ K_SAL_API TKCommStatus salComRead
   size_t*   xpBufferLen
 );
 
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Check, without blocking, that an idle connection is still usable: the
+ *   server did not close or reset it and sent no unexpected data.
+ *
+ * @pre
+ *   salComConnect should be successfully executed prior to this function.
+ *
+ * @param[in] xpComInfo
+ *   Com Info data; Should not be NULL.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK if the connection can be reused.
+ * - E_K_COMM_STATUS_NETWORK if the connection was closed by the server.
+ * - E_K_COMM_STATUS_ERROR or E_K_COMM_STATUS_PARAMETER if not connected.
+ */
+K_SAL_API TKCommStatus salComCheck
+(
+  void*  xpComInfo
+);
+
 /**
  * @ingroup
  *   g_sal_com
@@ -199,6 +289,161 @@ K_SAL_API TKCommStatus salComTerm
   void*  xpComInfo
 );
 
+#if defined(__linux__)
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Start a non-blocking connection to the server. Unlike salComInit(), each
+ *   call opens a new connection; its events are reported by salComAsyncWait()
+ *   and C_K_SAL_COM_EVENT_WRITE signals that the connection is established.
+ *
+ * @param[in] xConnectTimeoutInMs
+ *   Connection timeout in milliseconds.
+ * @param[in] xReadTimeoutInMs
+ *   Longest time without event while events are watched, in milliseconds.
+ * @param[in] xpHost
+ *   Server Host name; Should not be NULL. It must have '\0' at the end.
+ * @param[in] xpPort
+ *   Server Port; Should not be NULL. It must have '\0' at the end.
+ * @param[in] xpCallback
+ *   Receives the events of the connection; Should not be NULL.
+ * @param[in] xpContext
+ *   Passed back to xpCallback.
+ * @param[out] xppComInfo
+ *   Com Info data of the connection; Should not be NULL.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK or the error status.
+ * - E_K_COMM_STATUS_RESOURCE if the host is not resolved or all connections are used.
+ */
+K_SAL_API TKCommStatus salComAsyncConnect
+(
+  uint32_t               xConnectTimeoutInMs,
+  uint32_t               xReadTimeoutInMs,
+  const uint8_t*         xpHost,
+  const uint8_t*         xpPort,
+  TKSalComEventCallback  xpCallback,
+  void*                  xpContext,
+  void**                 xppComInfo
+);
+
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Select the events reported for an established connection. The read
+ *   timeout runs while events are watched; 0 makes the connection idle.
+ *
+ * @param[in] xpComInfo
+ *   Com Info data from salComAsyncConnect(); Should not be NULL.
+ * @param[in] xEvents
+ *   C_K_SAL_COM_EVENT_READ and/or C_K_SAL_COM_EVENT_WRITE, or 0.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComAsyncWatch
+(
+  void*     xpComInfo,
+  uint32_t  xEvents
+);
+
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Send, without blocking, as much of several buffers as the connection accepts.
+ *
+ * @param[in] xpComInfo
+ *   Com Info data from salComAsyncConnect(); Should not be NULL.
+ * @param[in] xpVec
+ *   Buffers to send, in order; Should not be NULL.
+ * @param[in] xVecCount
+ *   Number of buffers, 1 to C_K_SAL_COM_IOVEC_MAX_COUNT.
+ * @param[out] xpSentLen
+ *   Number of bytes sent; 0 if the connection accepts none yet. Should not be NULL.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK or the error status.
+ * - E_K_COMM_STATUS_NETWORK if the connection was closed or reset.
+ */
+K_SAL_API TKCommStatus salComAsyncWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount,
+  size_t*               xpSentLen
+);
+
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Receive, without blocking, the data available on the connection.
+ *
+ * @param[in] xpComInfo
+ *   Com Info data from salComAsyncConnect(); Should not be NULL.
+ * @param[out] xpBuffer
+ *   Data buffer to fill; must point to *xpBufferLen bytes.
+ * @param[in,out] xpBufferLen
+ *   [in] Size of the data buffer, in bytes.
+ *   [out] Size of the received data, in bytes; 0 if no data is available yet.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK or the error status.
+ * - E_K_COMM_STATUS_NETWORK if the server closed or reset the connection.
+ */
+K_SAL_API TKCommStatus salComAsyncRead
+(
+  void*     xpComInfo,
+  uint8_t*  xpBuffer,
+  size_t*   xpBufferLen
+);
+
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Wait for the events of all the asynchronous connections and report them
+ *   to their callbacks, together with the expired timeouts. The callbacks may
+ *   use and terminate any asynchronous connection.
+ *
+ * @param[in] xTimeoutInMs
+ *   Longest time to wait for a first event, in milliseconds.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComAsyncWait
+(
+  uint32_t  xTimeoutInMs
+);
+
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Close an asynchronous connection. No event is reported for it afterwards.
+ *
+ * @param[in] xpComInfo
+ *   Com Info data from salComAsyncConnect(); Should not be NULL.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComAsyncTerm
+(
+  void*  xpComInfo
+);
+#endif /* __linux__ */
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
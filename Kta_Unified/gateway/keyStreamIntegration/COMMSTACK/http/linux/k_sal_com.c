@@ -39,14 +39,28 @@
 /* -------------------------------------------------------------------------- */
 /* IMPORTS                                                                    */
 /* -------------------------------------------------------------------------- */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE                         /* getaddrinfo_a() */
+#endif
 #include "k_sal_com.h"
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/epoll.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 #include <netdb.h>
+#include <resolv.h>
+#include <arpa/nameser.h>
+#include <poll.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
+#include <time.h>
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL CONSTANTS, TYPES, ENUM                                               */
@@ -61,6 +75,39 @@
 /** @brief Connection state flags */
 #define C_SAL_COM_STATE_INITIALIZED         (0x01U)
 #define C_SAL_COM_STATE_CONNECTED           (0x02U)
+#define C_SAL_COM_STATE_CONNECTING          (0x04U)
+
+/** @brief Magic number to validate asynchronous connection pointer */
+#define C_SAL_COM_ASYNC_MAGIC_NUMBER        (0x53414C41U)  /* "SALA" */
+
+/** @brief Maximum number of asynchronous connections */
+#define C_SAL_COM_ASYNC_MAX_CONNECTIONS     (64U)
+
+/** @brief Maximum number of epoll events handled per wait */
+#define C_SAL_COM_ASYNC_MAX_EVENTS          (16)
+
+/** @brief Number of host names kept by the resolver cache */
+#define C_SAL_COM_DNS_CACHE_SIZE            (4U)
+
+/** @brief Maximum number of addresses kept per host name */
+#define C_SAL_COM_DNS_MAX_ADDRESSES         (8U)
+
+/**
+ * @brief Cache lifetime of a host name without DNS record TTL, e.g. found in
+ *        /etc/hosts or when the TTL query fails. Can be set at build time.
+ */
+#ifndef C_SAL_COM_DNS_FALLBACK_TTL_IN_S
+#define C_SAL_COM_DNS_FALLBACK_TTL_IN_S     (60U)
+#endif
+
+/** @brief Longest cache lifetime, also used for numeric hosts which never change */
+#define C_SAL_COM_DNS_MAX_TTL_IN_S          (3600U)
+
+/** @brief Size of the buffer receiving the answer of the TTL query */
+#define C_SAL_COM_DNS_ANSWER_SIZE           (1024U)
+
+/** @brief Delay before the next address is tried while the previous ones are still connecting */
+#define C_SAL_COM_CONNECT_STAGGER_IN_MS     (250U)
 
 /* -------------------------------------------------------------------------- */
 /* TYPES & STRUCTURES                                                         */
@@ -76,14 +123,47 @@ typedef struct
   uint32_t      readTimeOut;        /**< Read timeout in ms */
   uint32_t      state;              /**< Connection state flags */
   uint32_t      magicNumber;        /**< Validation magic number */
+  TKSalComEventCallback pCallback;  /**< Asynchronous events receiver */
+  void*         pContext;           /**< Passed back to pCallback */
+  uint32_t      events;             /**< Watched C_K_SAL_COM_EVENT_* flags */
+  uint32_t      sequence;           /**< Tells connections of a slot apart */
+  uint64_t      deadline;           /**< Connect or read timeout in ms, 0 if none */
 } TKComInfo;
 
+/**
+ * @brief Resolved addresses of a host name.
+ */
+typedef struct
+{
+  char          host[256];          /**< Host name, empty if the entry is free */
+  char          port[8];            /**< Port */
+  struct sockaddr_storage aAddress[C_SAL_COM_DNS_MAX_ADDRESSES]; /**< IPv6 and IPv4 interleaved */
+  socklen_t     aAddressLen[C_SAL_COM_DNS_MAX_ADDRESSES];        /**< Size of each address */
+  size_t        count;              /**< Number of addresses */
+  uint64_t      expiry;             /**< End of the cache lifetime in ms */
+} TKDnsEntry;
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
 
 /** @brief Global communication info structure */
-static TKComInfo g_comInfo = {C_SAL_COM_SOCKET_INVALID, 0U, 0U, 0U, 0U};
+static TKComInfo g_comInfo = {C_SAL_COM_SOCKET_INVALID, 0U, 0U, 0U, 0U, NULL, NULL, 0U, 0U, 0U};
+
+/** @brief Asynchronous connections, a slot is free when its magic number is 0 */
+static TKComInfo g_asyncComInfo[C_SAL_COM_ASYNC_MAX_CONNECTIONS];
+
+/** @brief epoll instance watching the asynchronous connections */
+static int g_epollId = C_SAL_COM_SOCKET_INVALID;
+
+/** @brief Last connection sequence number */
+static uint32_t g_asyncSequence = 0U;
+
+/** @brief Resolver cache shared by the blocking and asynchronous connections */
+static TKDnsEntry g_dnsCache[C_SAL_COM_DNS_CACHE_SIZE];
+
+/** @brief Guards g_dnsCache, connections may be opened from several threads */
+static pthread_mutex_t g_dnsCacheLock = PTHREAD_MUTEX_INITIALIZER;
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
@@ -101,6 +181,131 @@ static bool lIsValidComInfo
   const void* xpComInfo
 );
 
+/**
+ * @brief Validate asynchronous com info pointer.
+ *
+ * @param[in] xpComInfo Pointer to validate. Should not be NULL.
+ *
+ * @return true if valid, false otherwise.
+ */
+static bool lIsValidAsyncComInfo
+(
+  const void* xpComInfo
+);
+
+/**
+ * @brief Get the monotonic time.
+ *
+ * @return Time in milliseconds.
+ */
+static uint64_t lGetTimeMs
+(
+  void
+);
+
+/**
+ * @brief Convert the buffers of a vectored write, without their first bytes.
+ *
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, at most C_K_SAL_COM_IOVEC_MAX_COUNT.
+ * @param[in] xSkipLen Number of bytes already sent.
+ * @param[out] xpIov Buffers left to send. Should not be NULL.
+ *
+ * @return Number of buffers in xpIov, 0 if all are sent.
+ */
+static size_t lIoVec
+(
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount,
+  size_t                xSkipLen,
+  struct iovec*         xpIov
+);
+
+/**
+ * @brief Update the epoll registration from the connection state.
+ *
+ * @param[in] xpInfo Asynchronous connection. Should not be NULL.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+static TKCommStatus lAsyncUpdate
+(
+  TKComInfo* xpInfo
+);
+
+/**
+ * @brief Turn the epoll events of a connection into C_K_SAL_COM_EVENT_* flags.
+ *
+ * @param[in] xpInfo Asynchronous connection. Should not be NULL.
+ * @param[in] xEpollEvents Events returned by epoll_wait().
+ *
+ * @return Events to report, 0 if none.
+ */
+static uint32_t lAsyncEvents
+(
+  TKComInfo* xpInfo,
+  uint32_t   xEpollEvents
+);
+
+/**
+ * @brief Get the addresses of a host, from the cache while its lifetime runs.
+ *
+ * @param[in] xpHost Server Host name. Should not be NULL. Must have '\0' at the end.
+ * @param[in] xpPort Server Port. Should not be NULL. Must have '\0' at the end.
+ * @param[out] xpEntry Addresses, in connection order. Should not be NULL.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+static TKCommStatus lDnsResolve
+(
+  const char*  xpHost,
+  const char*  xpPort,
+  TKDnsEntry*  xpEntry
+);
+
+/**
+ * @brief Get the cache lifetime of a host name: the shortest TTL of the
+ *        records answering its A query, or its AAAA query if it has no IPv4
+ *        address, CNAMEs included.
+ *
+ * @param[in] xpHost Server Host name. Should not be NULL. Must have '\0' at the end.
+ *
+ * @return Lifetime in seconds, at most C_SAL_COM_DNS_MAX_TTL_IN_S,
+ *         C_SAL_COM_DNS_FALLBACK_TTL_IN_S if the host has no DNS record.
+ */
+static uint32_t lDnsTtl
+(
+  const char*  xpHost
+);
+
+/**
+ * @brief Drop a host from the cache, so that the next connection resolves it again.
+ *
+ * @param[in] xpHost Server Host name. Should not be NULL. Must have '\0' at the end.
+ * @param[in] xpPort Server Port. Should not be NULL. Must have '\0' at the end.
+ */
+static void lDnsInvalidate
+(
+  const char*  xpHost,
+  const char*  xpPort
+);
+
+/**
+ * @brief Connect to the first address that answers, starting a new attempt
+ *        every C_SAL_COM_CONNECT_STAGGER_IN_MS while the previous ones are
+ *        still in progress (RFC 8305).
+ *
+ * @param[in] xpEntry Addresses, in connection order. Should not be NULL.
+ * @param[in] xTimeoutInMs Overall connection timeout in milliseconds, 0 if none.
+ *
+ * @return Connected non-blocking socket, C_SAL_COM_SOCKET_INVALID on failure.
+ */
+static int lConnectRace
+(
+  const TKDnsEntry*  xpEntry,
+  uint32_t           xTimeoutInMs
+);
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
 /* -------------------------------------------------------------------------- */
@@ -165,11 +370,9 @@ K_SAL_API TKCommStatus salComConnect
 {
   TKComInfo*          xpInfo = (TKComInfo*)xpComInfo;
   TKCommStatus        xStatus = E_K_COMM_STATUS_ERROR;
-  struct addrinfo     hints;
-  struct addrinfo*    xpResult = NULL;
-  struct addrinfo*    xpPtr = NULL;
+  TKDnsEntry          xEntry;
   struct timeval      xTimeout;
-  int                 xResult = 0;
+  int                 xFlags = 0;
 
   if ((NULL == xpComInfo) || (NULL == xpHost) || (NULL == xpPort) ||
       (false == lIsValidComInfo(xpComInfo)))
@@ -181,74 +384,51 @@ K_SAL_API TKCommStatus salComConnect
     /* Already connected */
     xStatus = E_K_COMM_STATUS_ERROR;
   }
+  else if (E_K_COMM_STATUS_OK != lDnsResolve((const char*)xpHost, (const char*)xpPort, &xEntry))
+  {
+    xStatus = E_K_COMM_STATUS_RESOURCE;
+  }
   else
   {
-    /* Setup hints for getaddrinfo */
-    (void)memset(&hints, 0, sizeof(hints));
-    hints.ai_family = AF_UNSPEC;      /* Allow IPv4 or IPv6 */
-    hints.ai_socktype = SOCK_STREAM;  /* TCP socket */
-    hints.ai_protocol = IPPROTO_TCP;
+    /* Race the addresses, connectTimeOut bounds the whole race */
+    xpInfo->socketId = lConnectRace(&xEntry, xpInfo->connectTimeOut);
 
-    /* Resolve server address */
-    xResult = getaddrinfo((const char*)xpHost, (const char*)xpPort, &hints, &xpResult);
-    
-    if (0 != xResult)
+    if (C_SAL_COM_SOCKET_INVALID == xpInfo->socketId)
     {
-      xStatus = E_K_COMM_STATUS_RESOURCE;
+      /* The cached addresses may be stale */
+      lDnsInvalidate((const char*)xpHost, (const char*)xpPort);
+      xStatus = E_K_COMM_STATUS_NETWORK;
     }
     else
     {
-      /* Attempt to connect to server */
-      for (xpPtr = xpResult; NULL != xpPtr; xpPtr = xpPtr->ai_next)
+      /* Back to blocking mode for salComWrite() and salComRead() */
+      xFlags = fcntl(xpInfo->socketId, F_GETFL, 0);
+      if (xFlags >= 0)
       {
-        /* Create socket */
-        xpInfo->socketId = socket(xpPtr->ai_family, xpPtr->ai_socktype, xpPtr->ai_protocol);
-        
-        if (C_SAL_COM_SOCKET_INVALID == xpInfo->socketId)
-        {
-          continue;
-        }
-
-        /* Set connect timeout */
-        if (0U != xpInfo->connectTimeOut)
-        {
-          xTimeout.tv_sec = (time_t)(xpInfo->connectTimeOut / 1000U);
-          xTimeout.tv_usec = (suseconds_t)((xpInfo->connectTimeOut % 1000U) * 1000U);
-          (void)setsockopt(xpInfo->socketId, SOL_SOCKET, SO_SNDTIMEO,
-                          &xTimeout, sizeof(xTimeout));
-        }
-
-        /* Set read timeout */
-        if (0U != xpInfo->readTimeOut)
-        {
-          xTimeout.tv_sec = (time_t)(xpInfo->readTimeOut / 1000U);
-          xTimeout.tv_usec = (suseconds_t)((xpInfo->readTimeOut % 1000U) * 1000U);
-          (void)setsockopt(xpInfo->socketId, SOL_SOCKET, SO_RCVTIMEO,
-                          &xTimeout, sizeof(xTimeout));
-        }
-
-        /* Connect to server */
-        xResult = connect(xpInfo->socketId, xpPtr->ai_addr, xpPtr->ai_addrlen);
-        
-        if (0 != xResult)
-        {
-          (void)close(xpInfo->socketId);
-          xpInfo->socketId = C_SAL_COM_SOCKET_INVALID;
-          continue;
-        }
+        (void)fcntl(xpInfo->socketId, F_SETFL, xFlags & ~O_NONBLOCK);
+      }
 
-        /* Connection successful */
-        xpInfo->state |= C_SAL_COM_STATE_CONNECTED;
-        xStatus = E_K_COMM_STATUS_OK;
-        break;
+      /* Set send timeout */
+      if (0U != xpInfo->connectTimeOut)
+      {
+        xTimeout.tv_sec = (time_t)(xpInfo->connectTimeOut / 1000U);
+        xTimeout.tv_usec = (suseconds_t)((xpInfo->connectTimeOut % 1000U) * 1000U);
+        (void)setsockopt(xpInfo->socketId, SOL_SOCKET, SO_SNDTIMEO,
+                        &xTimeout, sizeof(xTimeout));
       }
 
-      freeaddrinfo(xpResult);
-      
-      if (E_K_COMM_STATUS_OK != xStatus)
+      /* Set read timeout */
+      if (0U != xpInfo->readTimeOut)
       {
-        xStatus = E_K_COMM_STATUS_NETWORK;
+        xTimeout.tv_sec = (time_t)(xpInfo->readTimeOut / 1000U);
+        xTimeout.tv_usec = (suseconds_t)((xpInfo->readTimeOut % 1000U) * 1000U);
+        (void)setsockopt(xpInfo->socketId, SOL_SOCKET, SO_RCVTIMEO,
+                        &xTimeout, sizeof(xTimeout));
       }
+
+      /* Connection successful */
+      xpInfo->state |= C_SAL_COM_STATE_CONNECTED;
+      xStatus = E_K_COMM_STATUS_OK;
     }
   }
 
@@ -309,6 +489,62 @@ K_SAL_API TKCommStatus salComWrite
   return xStatus;
 }
 
+/**
+ * @brief Send several buffers to the server (Linux implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, 1 to C_K_SAL_COM_IOVEC_MAX_COUNT.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount
+)
+{
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+  struct iovec  aIov[C_K_SAL_COM_IOVEC_MAX_COUNT];
+  struct msghdr xMsg;
+  ssize_t       xBytesSent = 0;
+  size_t        xTotalSent = 0U;
+
+  if ((NULL == xpComInfo) || (NULL == xpVec) || (0U == xVecCount) ||
+      (C_K_SAL_COM_IOVEC_MAX_COUNT < xVecCount) || (false == lIsValidComInfo(xpComInfo)))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else if (0U == (xpInfo->state & C_SAL_COM_STATE_CONNECTED))
+  {
+    xStatus = E_K_COMM_STATUS_ERROR;
+  }
+  else
+  {
+    xStatus = E_K_COMM_STATUS_OK;
+    (void)memset(&xMsg, 0, sizeof(xMsg));
+    xMsg.msg_iov = aIov;
+
+    /* Send in loop until all buffers are sent */
+    while (0U != (xMsg.msg_iovlen = lIoVec(xpVec, xVecCount, xTotalSent, aIov)))
+    {
+      xBytesSent = sendmsg(xpInfo->socketId, &xMsg, MSG_NOSIGNAL);
+
+      if (xBytesSent < 0)
+      {
+        xStatus = E_K_COMM_STATUS_NETWORK;
+        break;
+      }
+
+      xTotalSent += (size_t)xBytesSent;
+    }
+  }
+
+  return xStatus;
+}
+
 /**
  * @brief Read data from the server (Linux implementation).
  *
@@ -371,6 +607,49 @@ K_SAL_API TKCommStatus salComRead
   return xStatus;
 }
 
+/**
+ * @brief Check an idle connection (Linux implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComCheck
+(
+  void* xpComInfo
+)
+{
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+  ssize_t       xBytesReceived = 0;
+  uint8_t       xByte = 0U;
+
+  if ((NULL == xpComInfo) || (false == lIsValidComInfo(xpComInfo)))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else if (0U == (xpInfo->state & C_SAL_COM_STATE_CONNECTED))
+  {
+    xStatus = E_K_COMM_STATUS_ERROR;
+  }
+  else
+  {
+    /* Nothing to read is the healthy case; EOF or pending data is not */
+    xBytesReceived = recv(xpInfo->socketId, (void*)&xByte, 1U, MSG_PEEK | MSG_DONTWAIT);
+
+    if ((xBytesReceived < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno)))
+    {
+      xStatus = E_K_COMM_STATUS_OK;
+    }
+    else
+    {
+      xStatus = E_K_COMM_STATUS_NETWORK;
+    }
+  }
+
+  return xStatus;
+}
+
 /**
  * @brief Terminate COM and close connection (Linux implementation).
  *
@@ -410,31 +689,994 @@ K_SAL_API TKCommStatus salComTerm
   return xStatus;
 }
 
-/* -------------------------------------------------------------------------- */
-/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
-/* -------------------------------------------------------------------------- */
-
 /**
- * @brief Validate com info pointer.
+ * @brief Start a non-blocking connection (Linux epoll implementation).
  *
- * @param[in] xpComInfo Pointer to validate. Should not be NULL.
+ * @param[in] xConnectTimeoutInMs Connection timeout in milliseconds.
+ * @param[in] xReadTimeoutInMs Timeout of the watched events in milliseconds.
+ * @param[in] xpHost Server Host name. Should not be NULL. Must have '\0' at the end.
+ * @param[in] xpPort Server Port. Should not be NULL. Must have '\0' at the end.
+ * @param[in] xpCallback Events receiver. Should not be NULL.
+ * @param[in] xpContext Passed back to xpCallback.
+ * @param[out] xppComInfo Com info data of the connection. Should not be NULL.
  *
- * @return true if valid, false otherwise.
+ * @return E_K_COMM_STATUS_OK or the error status.
  */
-static bool lIsValidComInfo
+K_SAL_API TKCommStatus salComAsyncConnect
 (
-  const void* xpComInfo
+  uint32_t               xConnectTimeoutInMs,
+  uint32_t               xReadTimeoutInMs,
+  const uint8_t*         xpHost,
+  const uint8_t*         xpPort,
+  TKSalComEventCallback  xpCallback,
+  void*                  xpContext,
+  void**                 xppComInfo
 )
 {
-  const TKComInfo* xpInfo = (const TKComInfo*)xpComInfo;
-  bool xIsValid = false;
+  TKComInfo*          xpInfo = NULL;
+  TKCommStatus        xStatus = E_K_COMM_STATUS_ERROR;
+  TKDnsEntry          xEntry;
+  struct epoll_event  xEvent;
+  uint32_t            xIndex = 0U;
+  size_t              xAddress = 0U;
+  int                 xSocketId = C_SAL_COM_SOCKET_INVALID;
+  int                 xResult = 0;
 
-  if ((NULL != xpComInfo) && (C_SAL_COM_MAGIC_NUMBER == xpInfo->magicNumber))
+  if ((NULL == xpHost) || (NULL == xpPort) || (NULL == xpCallback) || (NULL == xppComInfo))
   {
-    xIsValid = true;
+    return E_K_COMM_STATUS_PARAMETER;
   }
 
-  return xIsValid;
+  for (xIndex = 0U; xIndex < C_SAL_COM_ASYNC_MAX_CONNECTIONS; xIndex++)
+  {
+    if (C_SAL_COM_ASYNC_MAGIC_NUMBER != g_asyncComInfo[xIndex].magicNumber)
+    {
+      xpInfo = &g_asyncComInfo[xIndex];
+      break;
+    }
+  }
+
+  if (NULL == xpInfo)
+  {
+    xStatus = E_K_COMM_STATUS_RESOURCE;
+  }
+  else if ((C_SAL_COM_SOCKET_INVALID == g_epollId) &&
+           (C_SAL_COM_SOCKET_INVALID == (g_epollId = epoll_create1(EPOLL_CLOEXEC))))
+  {
+    xStatus = E_K_COMM_STATUS_RESOURCE;
+  }
+  else
+  {
+    /* Name resolution blocks on a cache miss only */
+    xStatus = lDnsResolve((const char*)xpHost, (const char*)xpPort, &xEntry);
+
+    if (E_K_COMM_STATUS_OK != xStatus)
+    {
+      xStatus = E_K_COMM_STATUS_RESOURCE;
+    }
+    else
+    {
+      /* Start the connection on the first address that accepts it, the
+       * outcome is reported by epoll once the handshake is over */
+      xStatus = E_K_COMM_STATUS_NETWORK;
+      for (xAddress = 0U; xAddress < xEntry.count; xAddress++)
+      {
+        xSocketId = socket(xEntry.aAddress[xAddress].ss_family,
+                           SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                           IPPROTO_TCP);
+        if (C_SAL_COM_SOCKET_INVALID == xSocketId)
+        {
+          continue;
+        }
+
+        xResult = connect(xSocketId, (const struct sockaddr*)&xEntry.aAddress[xAddress],
+                          xEntry.aAddressLen[xAddress]);
+        if ((0 == xResult) || (EINPROGRESS == errno))
+        {
+          xStatus = E_K_COMM_STATUS_OK;
+          break;
+        }
+
+        (void)close(xSocketId);
+        xSocketId = C_SAL_COM_SOCKET_INVALID;
+      }
+
+      if (E_K_COMM_STATUS_OK != xStatus)
+      {
+        lDnsInvalidate((const char*)xpHost, (const char*)xpPort);
+      }
+    }
+
+    if (E_K_COMM_STATUS_OK == xStatus)
+    {
+      g_asyncSequence++;
+      xpInfo->socketId = xSocketId;
+      xpInfo->connectTimeOut = xConnectTimeoutInMs;
+      xpInfo->readTimeOut = xReadTimeoutInMs;
+      xpInfo->state = C_SAL_COM_STATE_INITIALIZED | C_SAL_COM_STATE_CONNECTING;
+      xpInfo->pCallback = xpCallback;
+      xpInfo->pContext = xpContext;
+      xpInfo->events = 0U;
+      xpInfo->sequence = g_asyncSequence;
+      xpInfo->deadline = (0U != xConnectTimeoutInMs) ? (lGetTimeMs() + xConnectTimeoutInMs) : 0U;
+
+      /* The connection becomes writable once established */
+      (void)memset(&xEvent, 0, sizeof(xEvent));
+      xEvent.events = EPOLLOUT;
+      xEvent.data.u64 = ((uint64_t)xpInfo->sequence << 32) | xIndex;
+      if (0 != epoll_ctl(g_epollId, EPOLL_CTL_ADD, xSocketId, &xEvent))
+      {
+        (void)close(xSocketId);
+        xpInfo->socketId = C_SAL_COM_SOCKET_INVALID;
+        xpInfo->state = 0U;
+        xStatus = E_K_COMM_STATUS_RESOURCE;
+      }
+      else
+      {
+        xpInfo->magicNumber = C_SAL_COM_ASYNC_MAGIC_NUMBER;
+        *xppComInfo = xpInfo;
+      }
+    }
+  }
+
+  return xStatus;
+}
+
+/**
+ * @brief Select the watched events of a connection (Linux epoll implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ * @param[in] xEvents C_K_SAL_COM_EVENT_READ and/or C_K_SAL_COM_EVENT_WRITE, or 0.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComAsyncWatch
+(
+  void*     xpComInfo,
+  uint32_t  xEvents
+)
+{
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+
+  if (false == lIsValidAsyncComInfo(xpComInfo))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else if (0U != (xpInfo->state & C_SAL_COM_STATE_CONNECTING))
+  {
+    /* Applied when the connection is established */
+    xpInfo->events = xEvents & (C_K_SAL_COM_EVENT_READ | C_K_SAL_COM_EVENT_WRITE);
+    xStatus = E_K_COMM_STATUS_OK;
+  }
+  else
+  {
+    xpInfo->events = xEvents & (C_K_SAL_COM_EVENT_READ | C_K_SAL_COM_EVENT_WRITE);
+    xpInfo->deadline = ((0U != xpInfo->events) && (0U != xpInfo->readTimeOut)) ?
+                       (lGetTimeMs() + xpInfo->readTimeOut) : 0U;
+    xStatus = lAsyncUpdate(xpInfo);
+  }
+
+  return xStatus;
+}
+
+/**
+ * @brief Send several buffers without blocking (Linux implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, 1 to C_K_SAL_COM_IOVEC_MAX_COUNT.
+ * @param[out] xpSentLen Bytes sent. Should not be NULL.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComAsyncWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount,
+  size_t*               xpSentLen
+)
+{
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+  struct iovec  aIov[C_K_SAL_COM_IOVEC_MAX_COUNT];
+  struct msghdr xMsg;
+  ssize_t       xBytesSent = 0;
+
+  if ((NULL == xpVec) || (0U == xVecCount) || (C_K_SAL_COM_IOVEC_MAX_COUNT < xVecCount) ||
+      (NULL == xpSentLen) || (false == lIsValidAsyncComInfo(xpComInfo)))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else if (0U != (xpInfo->state & C_SAL_COM_STATE_CONNECTING))
+  {
+    *xpSentLen = 0U;
+    xStatus = E_K_COMM_STATUS_OK;
+  }
+  else
+  {
+    (void)memset(&xMsg, 0, sizeof(xMsg));
+    xMsg.msg_iov = aIov;
+    xMsg.msg_iovlen = lIoVec(xpVec, xVecCount, 0U, aIov);
+    xBytesSent = sendmsg(xpInfo->socketId, &xMsg, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+    if (xBytesSent >= 0)
+    {
+      *xpSentLen = (size_t)xBytesSent;
+      xStatus = E_K_COMM_STATUS_OK;
+    }
+    else if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+    {
+      *xpSentLen = 0U;
+      xStatus = E_K_COMM_STATUS_OK;
+    }
+    else
+    {
+      *xpSentLen = 0U;
+      xStatus = E_K_COMM_STATUS_NETWORK;
+    }
+  }
+
+  return xStatus;
+}
+
+/**
+ * @brief Read available data without blocking (Linux implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ * @param[out] xpBuffer Buffer to store received data. Should not be NULL.
+ * @param[in,out] xpBufferLen In: Buffer size, Out: Bytes received.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComAsyncRead
+(
+  void*     xpComInfo,
+  uint8_t*  xpBuffer,
+  size_t*   xpBufferLen
+)
+{
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+  ssize_t       xBytesReceived = 0;
+
+  if ((NULL == xpBuffer) || (NULL == xpBufferLen) || (0U == *xpBufferLen) ||
+      (false == lIsValidAsyncComInfo(xpComInfo)))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else if (0U != (xpInfo->state & C_SAL_COM_STATE_CONNECTING))
+  {
+    *xpBufferLen = 0U;
+    xStatus = E_K_COMM_STATUS_OK;
+  }
+  else
+  {
+    xBytesReceived = recv(xpInfo->socketId, (void*)xpBuffer, *xpBufferLen, 0);
+
+    if (xBytesReceived > 0)
+    {
+      *xpBufferLen = (size_t)xBytesReceived;
+      xStatus = E_K_COMM_STATUS_OK;
+    }
+    else if ((xBytesReceived < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno)))
+    {
+      *xpBufferLen = 0U;
+      xStatus = E_K_COMM_STATUS_OK;
+    }
+    else
+    {
+      /* Connection closed or reset */
+      *xpBufferLen = 0U;
+      xStatus = E_K_COMM_STATUS_NETWORK;
+    }
+  }
+
+  return xStatus;
+}
+
+/**
+ * @brief Wait for and report the asynchronous events (Linux epoll implementation).
+ *
+ * @param[in] xTimeoutInMs Longest time to wait for a first event, in milliseconds.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComAsyncWait
+(
+  uint32_t  xTimeoutInMs
+)
+{
+  struct epoll_event  aEvents[C_SAL_COM_ASYNC_MAX_EVENTS];
+  TKComInfo*          xpInfo = NULL;
+  TKCommStatus        xStatus = E_K_COMM_STATUS_OK;
+  uint64_t            xNow = lGetTimeMs();
+  uint64_t            xWaitEnd = xNow + xTimeoutInMs;
+  uint32_t            xIndex = 0U;
+  uint32_t            xEvents = 0U;
+  int                 xCount = 0;
+  int                 xEvent = 0;
+
+  if (C_SAL_COM_SOCKET_INVALID == g_epollId)
+  {
+    return E_K_COMM_STATUS_STATE;
+  }
+
+  /* Wake up for the nearest timeout */
+  for (xIndex = 0U; xIndex < C_SAL_COM_ASYNC_MAX_CONNECTIONS; xIndex++)
+  {
+    xpInfo = &g_asyncComInfo[xIndex];
+    if ((C_SAL_COM_ASYNC_MAGIC_NUMBER == xpInfo->magicNumber) &&
+        (0U != xpInfo->deadline) && (xpInfo->deadline < xWaitEnd))
+    {
+      xWaitEnd = (xpInfo->deadline > xNow) ? xpInfo->deadline : xNow;
+    }
+  }
+
+  xCount = epoll_wait(g_epollId, aEvents, C_SAL_COM_ASYNC_MAX_EVENTS, (int)(xWaitEnd - xNow));
+  if ((xCount < 0) && (EINTR != errno))
+  {
+    xStatus = E_K_COMM_STATUS_ERROR;
+  }
+
+  for (xEvent = 0; xEvent < xCount; xEvent++)
+  {
+    /* A callback may have terminated the connection, or reused its slot */
+    xIndex = (uint32_t)(aEvents[xEvent].data.u64 & 0xFFFFFFFFU);
+    xpInfo = &g_asyncComInfo[xIndex];
+    if ((C_SAL_COM_ASYNC_MAGIC_NUMBER != xpInfo->magicNumber) ||
+        (xpInfo->sequence != (uint32_t)(aEvents[xEvent].data.u64 >> 32)))
+    {
+      continue;
+    }
+
+    xEvents = lAsyncEvents(xpInfo, aEvents[xEvent].events);
+    if (0U != xEvents)
+    {
+      xpInfo->pCallback(xpInfo->pContext, xEvents);
+    }
+  }
+
+  /* Report the timeouts */
+  xNow = lGetTimeMs();
+  for (xIndex = 0U; xIndex < C_SAL_COM_ASYNC_MAX_CONNECTIONS; xIndex++)
+  {
+    xpInfo = &g_asyncComInfo[xIndex];
+    if ((C_SAL_COM_ASYNC_MAGIC_NUMBER == xpInfo->magicNumber) &&
+        (0U != xpInfo->deadline) && (xpInfo->deadline <= xNow))
+    {
+      xpInfo->deadline = 0U;
+      xpInfo->pCallback(xpInfo->pContext, C_K_SAL_COM_EVENT_TIMEOUT);
+    }
+  }
+
+  return xStatus;
+}
+
+/**
+ * @brief Close an asynchronous connection (Linux epoll implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComAsyncTerm
+(
+  void* xpComInfo
+)
+{
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+
+  if (false == lIsValidAsyncComInfo(xpComInfo))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else
+  {
+    /* Closing the socket also removes it from the epoll instance */
+    (void)close(xpInfo->socketId);
+
+    xpInfo->socketId = C_SAL_COM_SOCKET_INVALID;
+    xpInfo->state = 0U;
+    xpInfo->magicNumber = 0U;
+    xpInfo->pCallback = NULL;
+    xpInfo->pContext = NULL;
+    xpInfo->events = 0U;
+    xpInfo->deadline = 0U;
+
+    xStatus = E_K_COMM_STATUS_OK;
+  }
+
+  return xStatus;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Validate com info pointer.
+ *
+ * @param[in] xpComInfo Pointer to validate. Should not be NULL.
+ *
+ * @return true if valid, false otherwise.
+ */
+static bool lIsValidComInfo
+(
+  const void* xpComInfo
+)
+{
+  const TKComInfo* xpInfo = (const TKComInfo*)xpComInfo;
+  bool xIsValid = false;
+
+  if ((NULL != xpComInfo) && (C_SAL_COM_MAGIC_NUMBER == xpInfo->magicNumber))
+  {
+    xIsValid = true;
+  }
+
+  return xIsValid;
+}
+
+/**
+ * @brief Validate asynchronous com info pointer.
+ *
+ * @param[in] xpComInfo Pointer to validate. Should not be NULL.
+ *
+ * @return true if valid, false otherwise.
+ */
+static bool lIsValidAsyncComInfo
+(
+  const void* xpComInfo
+)
+{
+  const TKComInfo* xpInfo = (const TKComInfo*)xpComInfo;
+  bool xIsValid = false;
+
+  if ((NULL != xpComInfo) && (C_SAL_COM_ASYNC_MAGIC_NUMBER == xpInfo->magicNumber))
+  {
+    xIsValid = true;
+  }
+
+  return xIsValid;
+}
+
+/**
+ * @brief Get the monotonic time.
+ *
+ * @return Time in milliseconds.
+ */
+static uint64_t lGetTimeMs
+(
+  void
+)
+{
+  struct timespec xNow;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &xNow);
+
+  return ((uint64_t)xNow.tv_sec * 1000U) + ((uint64_t)xNow.tv_nsec / 1000000U);
+}
+
+/**
+ * @brief Convert the buffers of a vectored write, without their first bytes.
+ *
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, at most C_K_SAL_COM_IOVEC_MAX_COUNT.
+ * @param[in] xSkipLen Number of bytes already sent.
+ * @param[out] xpIov Buffers left to send. Should not be NULL.
+ *
+ * @return Number of buffers in xpIov, 0 if all are sent.
+ */
+static size_t lIoVec
+(
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount,
+  size_t                xSkipLen,
+  struct iovec*         xpIov
+)
+{
+  size_t xSkip = xSkipLen;
+  size_t xIndex = 0U;
+  size_t xCount = 0U;
+
+  for (xIndex = 0U; xIndex < xVecCount; xIndex++)
+  {
+    if (xpVec[xIndex].len <= xSkip)
+    {
+      xSkip -= xpVec[xIndex].len;
+    }
+    else
+    {
+      xpIov[xCount].iov_base = (void*)(xpVec[xIndex].pData + xSkip);
+      xpIov[xCount].iov_len = xpVec[xIndex].len - xSkip;
+      xSkip = 0U;
+      xCount++;
+    }
+  }
+
+  return xCount;
+}
+
+/**
+ * @brief Update the epoll registration from the connection state.
+ *
+ * @param[in] xpInfo Asynchronous connection. Should not be NULL.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+static TKCommStatus lAsyncUpdate
+(
+  TKComInfo* xpInfo
+)
+{
+  struct epoll_event  xEvent;
+  TKCommStatus        xStatus = E_K_COMM_STATUS_OK;
+
+  (void)memset(&xEvent, 0, sizeof(xEvent));
+  if (0U != (xpInfo->events & C_K_SAL_COM_EVENT_READ))
+  {
+    xEvent.events |= EPOLLIN | EPOLLRDHUP;
+  }
+  if (0U != (xpInfo->events & C_K_SAL_COM_EVENT_WRITE))
+  {
+    xEvent.events |= EPOLLOUT;
+  }
+  xEvent.data.u64 = ((uint64_t)xpInfo->sequence << 32) |
+                    (uint64_t)(xpInfo - &g_asyncComInfo[0]);
+
+  if (0 != epoll_ctl(g_epollId, EPOLL_CTL_MOD, xpInfo->socketId, &xEvent))
+  {
+    xStatus = E_K_COMM_STATUS_ERROR;
+  }
+
+  return xStatus;
+}
+
+/**
+ * @brief Turn the epoll events of a connection into C_K_SAL_COM_EVENT_* flags.
+ *
+ * @param[in] xpInfo Asynchronous connection. Should not be NULL.
+ * @param[in] xEpollEvents Events returned by epoll_wait().
+ *
+ * @return Events to report, 0 if none.
+ */
+static uint32_t lAsyncEvents
+(
+  TKComInfo* xpInfo,
+  uint32_t   xEpollEvents
+)
+{
+  uint32_t   xEvents = 0U;
+  int        xError = 0;
+  socklen_t  xErrorLen = sizeof(xError);
+  struct sockaddr_storage xPeer;
+  socklen_t  xPeerLen = sizeof(xPeer);
+
+  if (0U != (xpInfo->state & C_SAL_COM_STATE_CONNECTING))
+  {
+    (void)getsockopt(xpInfo->socketId, SOL_SOCKET, SO_ERROR, &xError, &xErrorLen);
+    if ((0 != xError) || (0U != (xEpollEvents & (uint32_t)EPOLLERR)))
+    {
+      xEvents = C_K_SAL_COM_EVENT_ERROR;
+    }
+    else if (0 == getpeername(xpInfo->socketId, (struct sockaddr*)&xPeer, &xPeerLen))
+    {
+      /* Established: switch to the events selected by the caller */
+      xpInfo->state = (xpInfo->state & ~C_SAL_COM_STATE_CONNECTING) | C_SAL_COM_STATE_CONNECTED;
+      xpInfo->deadline = ((0U != xpInfo->events) && (0U != xpInfo->readTimeOut)) ?
+                         (lGetTimeMs() + xpInfo->readTimeOut) : 0U;
+      xEvents = (lAsyncUpdate(xpInfo) == E_K_COMM_STATUS_OK) ?
+                C_K_SAL_COM_EVENT_WRITE : C_K_SAL_COM_EVENT_ERROR;
+    }
+    else
+    {
+      /* Still in progress */
+    }
+  }
+  else
+  {
+    if (0U != (xEpollEvents & (uint32_t)(EPOLLIN | EPOLLRDHUP)))
+    {
+      xEvents |= C_K_SAL_COM_EVENT_READ;
+    }
+    if (0U != (xEpollEvents & (uint32_t)EPOLLOUT))
+    {
+      xEvents |= C_K_SAL_COM_EVENT_WRITE;
+    }
+    if (0U != (xEpollEvents & (uint32_t)(EPOLLERR | EPOLLHUP)))
+    {
+      xEvents |= C_K_SAL_COM_EVENT_ERROR;
+    }
+    xEvents &= xpInfo->events | C_K_SAL_COM_EVENT_ERROR;
+
+    /* The read timeout restarts on every event */
+    if ((0U != xEvents) && (0U != xpInfo->events) && (0U != xpInfo->readTimeOut))
+    {
+      xpInfo->deadline = lGetTimeMs() + xpInfo->readTimeOut;
+    }
+  }
+
+  return xEvents;
+}
+
+/**
+ * @brief Get the addresses of a host, from the cache while its lifetime runs.
+ *
+ * @param[in] xpHost Server Host name. Should not be NULL. Must have '\0' at the end.
+ * @param[in] xpPort Server Port. Should not be NULL. Must have '\0' at the end.
+ * @param[out] xpEntry Addresses, in connection order. Should not be NULL.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+static TKCommStatus lDnsResolve
+(
+  const char*  xpHost,
+  const char*  xpPort,
+  TKDnsEntry*  xpEntry
+)
+{
+  TKCommStatus        xStatus = E_K_COMM_STATUS_ERROR;
+  TKDnsEntry*         xpCached = NULL;
+  struct addrinfo     hints;
+  struct addrinfo*    xpResult = NULL;
+  struct addrinfo*    xpPtr = NULL;
+  struct addrinfo*    aFamily[2][C_SAL_COM_DNS_MAX_ADDRESSES];
+  size_t              aFamilyCount[2] = {0U, 0U};
+  struct gaicb        xRequest;
+  struct gaicb*       aRequest[1] = {&xRequest};
+  struct in6_addr     xNumeric;
+  uint64_t            xNow = lGetTimeMs();
+  uint32_t            xTtl = C_SAL_COM_DNS_MAX_TTL_IN_S;
+  int                 xError = 0;
+  size_t              xIndex = 0U;
+  size_t              xRank = 0U;
+  size_t              xSide = 0U;
+  bool                xIsCached = false;
+
+  (void)pthread_mutex_lock(&g_dnsCacheLock);
+  for (xIndex = 0U; xIndex < C_SAL_COM_DNS_CACHE_SIZE; xIndex++)
+  {
+    if ((0 == strncmp(g_dnsCache[xIndex].host, xpHost, sizeof(g_dnsCache[xIndex].host))) &&
+        (0 == strncmp(g_dnsCache[xIndex].port, xpPort, sizeof(g_dnsCache[xIndex].port))) &&
+        (xNow < g_dnsCache[xIndex].expiry))
+    {
+      (void)memcpy(xpEntry, &g_dnsCache[xIndex], sizeof(*xpEntry));
+      xIsCached = true;
+      break;
+    }
+  }
+  (void)pthread_mutex_unlock(&g_dnsCacheLock);
+
+  if (xIsCached)
+  {
+    return E_K_COMM_STATUS_OK;
+  }
+
+  (void)memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;      /* Allow IPv4 or IPv6 */
+  hints.ai_socktype = SOCK_STREAM;  /* TCP socket */
+  hints.ai_protocol = IPPROTO_TCP;
+
+  if ((1 == inet_pton(AF_INET, xpHost, &xNumeric)) ||
+      (1 == inet_pton(AF_INET6, xpHost, &xNumeric)))
+  {
+    hints.ai_flags = AI_NUMERICHOST;
+    xError = getaddrinfo(xpHost, xpPort, &hints, &xpResult);
+  }
+  else
+  {
+    /* getaddrinfo() does not report the record TTL: query it while the
+     * addresses are resolved in the background, so that both round trips
+     * overlap */
+    (void)memset(&xRequest, 0, sizeof(xRequest));
+    xRequest.ar_name = xpHost;
+    xRequest.ar_service = xpPort;
+    xRequest.ar_request = &hints;
+    if (0 != getaddrinfo_a(GAI_NOWAIT, aRequest, 1, NULL))
+    {
+      xError = getaddrinfo(xpHost, xpPort, &hints, &xpResult);
+      xTtl = lDnsTtl(xpHost);
+    }
+    else
+    {
+      xTtl = lDnsTtl(xpHost);
+      while (EAI_INPROGRESS == (xError = gai_error(&xRequest)))
+      {
+        (void)gai_suspend((const struct gaicb* const*)aRequest, 1, NULL);
+      }
+      xpResult = xRequest.ar_result;
+    }
+  }
+
+  if ((0 != xError) || (NULL == xpResult))
+  {
+    if (NULL != xpResult)
+    {
+      freeaddrinfo(xpResult);
+    }
+    xStatus = E_K_COMM_STATUS_RESOURCE;
+  }
+  else
+  {
+    /* Keep the preference order of getaddrinfo() within each family, but
+     * alternate the families so that a broken one delays the other by one
+     * connection attempt at most (RFC 8305 section 4) */
+    (void)memset(xpEntry, 0, sizeof(*xpEntry));
+    for (xpPtr = xpResult; NULL != xpPtr; xpPtr = xpPtr->ai_next)
+    {
+      xSide = (xpPtr->ai_family == xpResult->ai_family) ? 0U : 1U;
+      if ((xpPtr->ai_addrlen <= sizeof(xpEntry->aAddress[0])) &&
+          (aFamilyCount[xSide] < C_SAL_COM_DNS_MAX_ADDRESSES))
+      {
+        aFamily[xSide][aFamilyCount[xSide]] = xpPtr;
+        aFamilyCount[xSide]++;
+      }
+    }
+    for (xIndex = 0U; xpEntry->count < C_SAL_COM_DNS_MAX_ADDRESSES; xIndex++)
+    {
+      xSide = xIndex % 2U;
+      xRank = xIndex / 2U;
+      if ((xRank >= aFamilyCount[0]) && (xRank >= aFamilyCount[1]))
+      {
+        break;
+      }
+      if (xRank < aFamilyCount[xSide])
+      {
+        xpPtr = aFamily[xSide][xRank];
+        (void)memcpy(&xpEntry->aAddress[xpEntry->count], xpPtr->ai_addr, xpPtr->ai_addrlen);
+        xpEntry->aAddressLen[xpEntry->count] = (socklen_t)xpPtr->ai_addrlen;
+        xpEntry->count++;
+      }
+    }
+    freeaddrinfo(xpResult);
+
+    if (0U == xpEntry->count)
+    {
+      xStatus = E_K_COMM_STATUS_RESOURCE;
+    }
+    else
+    {
+      xStatus = E_K_COMM_STATUS_OK;
+
+      /* Host names too long for the cache are resolved every time */
+      if ((strlen(xpHost) < sizeof(xpEntry->host)) && (strlen(xpPort) < sizeof(xpEntry->port)))
+      {
+        (void)strcpy(xpEntry->host, xpHost);
+        (void)strcpy(xpEntry->port, xpPort);
+        xpEntry->expiry = xNow + ((uint64_t)xTtl * 1000U);
+
+        /* Replace the same host, else the entry expiring first; free entries have expired */
+        (void)pthread_mutex_lock(&g_dnsCacheLock);
+        xpCached = &g_dnsCache[0];
+        for (xIndex = 0U; xIndex < C_SAL_COM_DNS_CACHE_SIZE; xIndex++)
+        {
+          if ((0 == strncmp(g_dnsCache[xIndex].host, xpHost, sizeof(g_dnsCache[xIndex].host))) &&
+              (0 == strncmp(g_dnsCache[xIndex].port, xpPort, sizeof(g_dnsCache[xIndex].port))))
+          {
+            xpCached = &g_dnsCache[xIndex];
+            break;
+          }
+          if (g_dnsCache[xIndex].expiry < xpCached->expiry)
+          {
+            xpCached = &g_dnsCache[xIndex];
+          }
+        }
+        (void)memcpy(xpCached, xpEntry, sizeof(*xpCached));
+        (void)pthread_mutex_unlock(&g_dnsCacheLock);
+      }
+    }
+  }
+
+  return xStatus;
+}
+
+/**
+ * @brief Get the cache lifetime of a host name: the shortest TTL of the
+ *        records answering its A query, or its AAAA query if it has no IPv4
+ *        address, CNAMEs included.
+ *
+ * @param[in] xpHost Server Host name. Should not be NULL. Must have '\0' at the end.
+ *
+ * @return Lifetime in seconds, at most C_SAL_COM_DNS_MAX_TTL_IN_S,
+ *         C_SAL_COM_DNS_FALLBACK_TTL_IN_S if the host has no DNS record.
+ */
+static uint32_t lDnsTtl
+(
+  const char*  xpHost
+)
+{
+  static const int  aType[2] = {ns_t_a, ns_t_aaaa};
+  unsigned char     aAnswer[C_SAL_COM_DNS_ANSWER_SIZE];
+  ns_msg            xMessage;
+  ns_rr             xRecord;
+  uint32_t          xTtl = C_SAL_COM_DNS_MAX_TTL_IN_S;
+  bool              xIsFound = false;
+  bool              xIsNoData = true;
+  size_t            xType = 0U;
+  int               xLength = 0;
+  int               xIndex = 0;
+
+  /* The AAAA query is only sent when the name exists without IPv4 address */
+  for (xType = 0U; (xType < 2U) && (!xIsFound) && xIsNoData; xType++)
+  {
+    /* res_query() works on the resolver state of the calling thread */
+    xLength = res_query(xpHost, ns_c_in, aType[xType], aAnswer, (int)sizeof(aAnswer));
+    xIsNoData = (xLength < 0) && (NO_DATA == h_errno);
+    if ((xLength > 0) && (0 == ns_initparse(aAnswer, xLength, &xMessage)))
+    {
+      for (xIndex = 0; xIndex < ns_msg_count(xMessage, ns_s_an); xIndex++)
+      {
+        if (0 == ns_parserr(&xMessage, ns_s_an, xIndex, &xRecord))
+        {
+          xIsFound = true;
+          if (ns_rr_ttl(xRecord) < xTtl)
+          {
+            xTtl = (uint32_t)ns_rr_ttl(xRecord);
+          }
+        }
+      }
+    }
+  }
+
+  return xIsFound ? xTtl : C_SAL_COM_DNS_FALLBACK_TTL_IN_S;
+}
+
+/**
+ * @brief Drop a host from the cache, so that the next connection resolves it again.
+ *
+ * @param[in] xpHost Server Host name. Should not be NULL. Must have '\0' at the end.
+ * @param[in] xpPort Server Port. Should not be NULL. Must have '\0' at the end.
+ */
+static void lDnsInvalidate
+(
+  const char*  xpHost,
+  const char*  xpPort
+)
+{
+  size_t xIndex = 0U;
+
+  (void)pthread_mutex_lock(&g_dnsCacheLock);
+  for (xIndex = 0U; xIndex < C_SAL_COM_DNS_CACHE_SIZE; xIndex++)
+  {
+    if ((0 == strncmp(g_dnsCache[xIndex].host, xpHost, sizeof(g_dnsCache[xIndex].host))) &&
+        (0 == strncmp(g_dnsCache[xIndex].port, xpPort, sizeof(g_dnsCache[xIndex].port))))
+    {
+      g_dnsCache[xIndex].expiry = 0U;
+    }
+  }
+  (void)pthread_mutex_unlock(&g_dnsCacheLock);
+}
+
+/**
+ * @brief Connect to the first address that answers, starting a new attempt
+ *        every C_SAL_COM_CONNECT_STAGGER_IN_MS while the previous ones are
+ *        still in progress (RFC 8305).
+ *
+ * @param[in] xpEntry Addresses, in connection order. Should not be NULL.
+ * @param[in] xTimeoutInMs Overall connection timeout in milliseconds, 0 if none.
+ *
+ * @return Connected non-blocking socket, C_SAL_COM_SOCKET_INVALID on failure.
+ */
+static int lConnectRace
+(
+  const TKDnsEntry*  xpEntry,
+  uint32_t           xTimeoutInMs
+)
+{
+  struct pollfd  aPoll[C_SAL_COM_DNS_MAX_ADDRESSES];
+  uint64_t       xNow = lGetTimeMs();
+  uint64_t       xDeadline = (0U != xTimeoutInMs) ? (xNow + xTimeoutInMs) : 0U;
+  uint64_t       xNextStart = xNow;
+  size_t         xStarted = 0U;
+  size_t         xPending = 0U;
+  size_t         xIndex = 0U;
+  int            xSocketId = C_SAL_COM_SOCKET_INVALID;
+  int            xWinner = C_SAL_COM_SOCKET_INVALID;
+  int            xWait = 0;
+  int            xError = 0;
+  socklen_t      xErrorLen = sizeof(xError);
+
+  while (C_SAL_COM_SOCKET_INVALID == xWinner)
+  {
+    xNow = lGetTimeMs();
+    if ((0U != xDeadline) && (xNow >= xDeadline))
+    {
+      break;
+    }
+
+    /* Start the next address when the stagger delay is over or when all the
+     * previous attempts have already failed */
+    if ((xStarted < xpEntry->count) && ((xNow >= xNextStart) || (0U == xPending)))
+    {
+      aPoll[xStarted].fd = C_SAL_COM_SOCKET_INVALID;
+      aPoll[xStarted].events = POLLOUT;
+      aPoll[xStarted].revents = 0;
+      xSocketId = socket(xpEntry->aAddress[xStarted].ss_family,
+                         SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+      if (C_SAL_COM_SOCKET_INVALID != xSocketId)
+      {
+        if (0 == connect(xSocketId, (const struct sockaddr*)&xpEntry->aAddress[xStarted],
+                         xpEntry->aAddressLen[xStarted]))
+        {
+          xWinner = xSocketId;
+        }
+        else if (EINPROGRESS == errno)
+        {
+          aPoll[xStarted].fd = xSocketId;
+          xPending++;
+        }
+        else
+        {
+          (void)close(xSocketId);
+        }
+      }
+      xStarted++;
+      xNextStart = xNow + C_SAL_COM_CONNECT_STAGGER_IN_MS;
+      continue;
+    }
+
+    if (0U == xPending)
+    {
+      /* All the addresses failed */
+      break;
+    }
+
+    /* Wait for an attempt to complete, the next start or the deadline */
+    xWait = -1;
+    if (xStarted < xpEntry->count)
+    {
+      xWait = (int)(xNextStart - xNow);
+    }
+    if ((0U != xDeadline) && ((xWait < 0) || ((xDeadline - xNow) < (uint64_t)xWait)))
+    {
+      xWait = (int)(xDeadline - xNow);
+    }
+    if ((poll(aPoll, (nfds_t)xStarted, xWait) < 0) && (EINTR != errno))
+    {
+      break;
+    }
+
+    for (xIndex = 0U; xIndex < xStarted; xIndex++)
+    {
+      if ((C_SAL_COM_SOCKET_INVALID == aPoll[xIndex].fd) || (0 == aPoll[xIndex].revents))
+      {
+        continue;
+      }
+      xError = 0;
+      xErrorLen = sizeof(xError);
+      (void)getsockopt(aPoll[xIndex].fd, SOL_SOCKET, SO_ERROR, &xError, &xErrorLen);
+      if ((0 == xError) && (C_SAL_COM_SOCKET_INVALID == xWinner))
+      {
+        xWinner = aPoll[xIndex].fd;
+      }
+      else if (0 != xError)
+      {
+        /* Failed: the next address does not need to wait for the stagger */
+        (void)close(aPoll[xIndex].fd);
+        xNextStart = xNow;
+      }
+      else
+      {
+        /* Connected too, but later in the list than the winner */
+        continue;
+      }
+      aPoll[xIndex].fd = C_SAL_COM_SOCKET_INVALID;
+      xPending--;
+    }
+  }
+
+  /* Drop the attempts that lost the race */
+  for (xIndex = 0U; xIndex < xStarted; xIndex++)
+  {
+    if (C_SAL_COM_SOCKET_INVALID != aPoll[xIndex].fd)
+    {
+      (void)close(aPoll[xIndex].fd);
+    }
+  }
+
+  return xWinner;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -368,6 +368,43 @@ end:
   return status;
 }
 
+/**
+ * @brief  implement salComWritev
+ *
+ */
+K_SAL_API TKCommStatus salComWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount
+)
+{
+  TKCommStatus  status = E_K_COMM_STATUS_OK;
+  size_t        i;
+
+  K_SAL_COM_DEBUG("Start of %s", __func__);
+
+  if ((NULL == xpVec) || (0U == xVecCount) || (C_K_SAL_COM_IOVEC_MAX_COUNT < xVecCount))
+  {
+    K_SAL_COM_DEBUG_ERROR("Invalid parameter");
+    status = E_K_COMM_STATUS_PARAMETER;
+  }
+  else
+  {
+    /* The WINC socket has no gather send, each buffer is written in turn. */
+    for (i = 0; (i < xVecCount) && (E_K_COMM_STATUS_OK == status); i++)
+    {
+      if (0U != xpVec[i].len)
+      {
+        status = salComWrite(xpComInfo, xpVec[i].pData, xpVec[i].len);
+      }
+    }
+  }
+
+  K_SAL_COM_DEBUG("End of %s", __func__);
+  return status;
+}
+
 /**
  * @brief  implement salComRead
  *
@@ -447,6 +484,44 @@ end:
   return status;
 }
 
+/**
+ * @brief  implement salComCheck
+ *
+ */
+K_SAL_API TKCommStatus salComCheck
+(
+  void*  xpComInfo
+)
+{
+  TKComInfo* pComInfo = (TKComInfo *)xpComInfo;
+  TKCommStatus status = E_K_COMM_STATUS_OK;
+
+  if ((NULL == xpComInfo) || (pComInfo->ptrId != 2u))
+  {
+    K_SAL_COM_DEBUG_ERROR("Invalid parameter");
+    return E_K_COMM_STATUS_PARAMETER;
+  }
+
+  // Let the socket callback report a disconnection or unexpected data
+  (void)salCommHandleWINCTasks(&socketReadEvent, 0u);
+
+  if (0 == pComInfo->isConnected)
+  {
+    K_SAL_COM_DEBUG_ERROR("Socket Not Connected");
+    status = E_K_COMM_STATUS_NETWORK;
+  }
+  else if (socketReadEvent)
+  {
+    K_SAL_COM_DEBUG_ERROR("Unexpected data on idle socket");
+    status = E_K_COMM_STATUS_NETWORK;
+  }
+  else
+  {
+    // Idle and connected
+  }
+
+  return status;
+}
 
 /**
  * @brief  implement salComTerm
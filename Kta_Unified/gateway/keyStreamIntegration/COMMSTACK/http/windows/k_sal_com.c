@@ -42,6 +42,7 @@
 #include "k_sal_com.h"
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -115,6 +116,24 @@ static bool lIsValidComInfo
   const void* xpComInfo
 );
 
+/**
+ * @brief Convert the buffers of a vectored write, without their first bytes.
+ *
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, at most C_K_SAL_COM_IOVEC_MAX_COUNT.
+ * @param[in] xSkipLen Number of bytes already sent.
+ * @param[out] xpWsaBuf Buffers left to send. Should not be NULL.
+ *
+ * @return Number of buffers in xpWsaBuf, 0 if all are sent.
+ */
+static DWORD lWsaBuf
+(
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount,
+  size_t                xSkipLen,
+  WSABUF*               xpWsaBuf
+);
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
 /* -------------------------------------------------------------------------- */
@@ -326,6 +345,59 @@ K_SAL_API TKCommStatus salComWrite
   return xStatus;
 }
 
+/**
+ * @brief Send several buffers to the server (Windows implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, 1 to C_K_SAL_COM_IOVEC_MAX_COUNT.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount
+)
+{
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+  WSABUF        aWsaBuf[C_K_SAL_COM_IOVEC_MAX_COUNT];
+  DWORD         xWsaBufCount = 0U;
+  DWORD         xBytesSent = 0U;
+  size_t        xTotalSent = 0U;
+
+  if ((NULL == xpComInfo) || (NULL == xpVec) || (0U == xVecCount) ||
+      (C_K_SAL_COM_IOVEC_MAX_COUNT < xVecCount) || (false == lIsValidComInfo(xpComInfo)))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else if (0U == (xpInfo->state & C_SAL_COM_STATE_CONNECTED))
+  {
+    xStatus = E_K_COMM_STATUS_ERROR;
+  }
+  else
+  {
+    xStatus = E_K_COMM_STATUS_OK;
+
+    /* Send in loop until all buffers are sent */
+    while (0U != (xWsaBufCount = lWsaBuf(xpVec, xVecCount, xTotalSent, aWsaBuf)))
+    {
+      if (SOCKET_ERROR == WSASend(xpInfo->socketId, aWsaBuf, xWsaBufCount, &xBytesSent,
+                                  0, NULL, NULL))
+      {
+        xStatus = E_K_COMM_STATUS_NETWORK;
+        break;
+      }
+
+      xTotalSent += (size_t)xBytesSent;
+    }
+  }
+
+  return xStatus;
+}
+
 /**
  * @brief Read data from the server (Windows implementation).
  *
@@ -390,6 +462,52 @@ K_SAL_API TKCommStatus salComRead
   return xStatus;
 }
 
+/**
+ * @brief Check an idle connection (Windows implementation).
+ *
+ * @param[in] xpComInfo Com info data. Should not be NULL.
+ *
+ * @return E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComCheck
+(
+  void* xpComInfo
+)
+{
+  TKComInfo*    xpInfo = (TKComInfo*)xpComInfo;
+  TKCommStatus  xStatus = E_K_COMM_STATUS_ERROR;
+  fd_set        xReadSet;
+  struct timeval xTimeout = {0, 0};
+  int           xResult = 0;
+
+  if ((NULL == xpComInfo) || (false == lIsValidComInfo(xpComInfo)))
+  {
+    xStatus = E_K_COMM_STATUS_PARAMETER;
+  }
+  else if (0U == (xpInfo->state & C_SAL_COM_STATE_CONNECTED))
+  {
+    xStatus = E_K_COMM_STATUS_ERROR;
+  }
+  else
+  {
+    /* An idle connection becomes readable only on EOF, reset or unexpected data */
+    FD_ZERO(&xReadSet);
+    FD_SET(xpInfo->socketId, &xReadSet);
+    xResult = select(0, &xReadSet, NULL, NULL, &xTimeout);
+
+    if (0 == xResult)
+    {
+      xStatus = E_K_COMM_STATUS_OK;
+    }
+    else
+    {
+      xStatus = E_K_COMM_STATUS_NETWORK;
+    }
+  }
+
+  return xStatus;
+}
+
 /**
  * @brief Terminate COM and close connection (Windows implementation).
  *
@@ -504,6 +622,46 @@ static bool lIsValidComInfo
   return xIsValid;
 }
 
+/**
+ * @brief Convert the buffers of a vectored write, without their first bytes.
+ *
+ * @param[in] xpVec Buffers to send. Should not be NULL.
+ * @param[in] xVecCount Number of buffers, at most C_K_SAL_COM_IOVEC_MAX_COUNT.
+ * @param[in] xSkipLen Number of bytes already sent.
+ * @param[out] xpWsaBuf Buffers left to send. Should not be NULL.
+ *
+ * @return Number of buffers in xpWsaBuf, 0 if all are sent.
+ */
+static DWORD lWsaBuf
+(
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount,
+  size_t                xSkipLen,
+  WSABUF*               xpWsaBuf
+)
+{
+  size_t xSkip = xSkipLen;
+  size_t xIndex = 0U;
+  DWORD  xCount = 0U;
+
+  for (xIndex = 0U; xIndex < xVecCount; xIndex++)
+  {
+    if (xpVec[xIndex].len <= xSkip)
+    {
+      xSkip -= xpVec[xIndex].len;
+    }
+    else
+    {
+      xpWsaBuf[xCount].buf = (CHAR*)(xpVec[xIndex].pData + xSkip);
+      xpWsaBuf[xCount].len = (ULONG)(xpVec[xIndex].len - xSkip);
+      xSkip = 0U;
+      xCount++;
+    }
+  }
+
+  return xCount;
+}
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
@@ -757,7 +757,9 @@ static TKStatus lPollKeyStream(void)
 
   /* Open ONE TCP connection for the whole provisioning session.
    * The HTTP layer propagates the server's Set-Cookie into the next
-   * request cookie automatically, so we must reuse the same connection. */
+   * request cookie automatically, so we must reuse the same connection.
+   * commInit reuses the connection kept idle by the previous session's
+   * commTerm while it is healthy and younger than the maximum age. */
   TCommIfStatus commStatus = commInit(
       C_K_COMM__SERVER_HOST,
       C_K_COMM__SERVER_PORT,
@@ -128,6 +128,6 @@ def instantiateComponent(ktaComponent):
     ktaSymbol = ktaComponent.createSettingSymbol("KTA_XC32_INCLUDE_DIRS", None)
     ktaSymbol.setCategory("C32")
     ktaSymbol.setKey("extra-include-directories")
-    ktaSymbol.setValue( '{0};{0}/../cryptoauthlib/atcacert;{0};{0}/COMMON/logmodule/include;{0}/COMMSTACK/http;{0}/COMMSTACK/http/include;{0}/SOURCE/include;{0}/SOURCE/kta/common/crypto/include;{0}/SOURCE/kta/common/general/include;{0}/SOURCE/kta/common/icpp_parser/include;{0}/SOURCE/kta/common/version/include;{0}/SOURCE/kta/modules/acthandler/include;{0}/SOURCE/kta/modules/cmdhandler/include;{0}/SOURCE/kta/modules/config/include;{0}/SOURCE/kta/modules/reghandler/include;{0}/SOURCE/salapi/include;{0}/SOURCE/kta/modules/fotaservice/include;'.format(includePath))
+    ktaSymbol.setValue( '{0};{0}/../cryptoauthlib/atcacert;{0};{0}/COMMON/logmodule/include;{0}/COMMSTACK/http;{0}/COMMSTACK/http/include;{0}/SOURCE/include;{0}/SOURCE/kta/common/crc/include;{0}/SOURCE/kta/common/crypto/include;{0}/SOURCE/kta/common/general/include;{0}/SOURCE/kta/common/icpp_parser/include;{0}/SOURCE/kta/common/version/include;{0}/SOURCE/kta/modules/acthandler/include;{0}/SOURCE/kta/modules/cmdhandler/include;{0}/SOURCE/kta/modules/config/include;{0}/SOURCE/kta/modules/reghandler/include;{0}/SOURCE/salapi/include;{0}/SOURCE/kta/modules/fotaservice/include;'.format(includePath))
     ktaSymbol.setAppend(True, ';')
 
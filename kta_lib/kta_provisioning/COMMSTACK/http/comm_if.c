@@ -222,6 +222,19 @@ TCommIfStatus commMsgExchange
   return retStatus;
 }
 
+/**
+ * @brief  implement commSetRecvHandler
+ *
+ */
+void commSetRecvHandler
+(
+  TCommIfRecvHandler  xpHandler,
+  void*               xpContext
+)
+{
+  httpSetRecvHandler(xpHandler, xpContext);
+}
+
 /**
  * @brief  implement commTerm
  *
@@ -90,7 +90,9 @@
  * Using printf for logging.
  * Not checking the return status of printf, since not required.
  **/
+#ifndef K_HTTP__LOG
 #define K_HTTP__LOG                      printf
+#endif /* K_HTTP__LOG */
 
 
 /**
@@ -107,6 +109,15 @@
 
 static TKHttpInfo gHttpInfo = {0};
 
+/** @brief Handler of the response body, NULL if none. */
+static TCommIfRecvHandler gpHttpRecvHandler = NULL;
+
+/** @brief Context given back to gpHttpRecvHandler. */
+static void* gpHttpRecvContext = NULL;
+
+/** @brief Status of the handler for the last response, not OK if it rejected it. */
+static TCommIfStatus gHttpRecvStatus = E_COMM_IF_STATUS_OK;
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
@@ -153,27 +164,70 @@ static int httpHeader
 
 /**
  * @brief
- *   This API fetches the HTTP body and status code.
+ *   Process the status, header or trailer line collected in aLine.
  *
- * @param[in] xpHttpInfo
+ * @param[in,out] xpHttpInfo
  *   Structure with HTTP information.
  *
  * @return
  * - 0, in case of success.
  * - -1, in case of error.
  */
-static int httpParse
+static int httpLineEnd
 (
   TKHttpInfo*  xpHttpInfo
 );
 
+/**
+ * @brief
+ *   Account body bytes stored at body[bodyLen] and move to the next state
+ *   once the body or the current chunk is complete. The bytes of a success
+ *   response are handed over to the receive handler first.
+ *
+ * @param[in,out] xpHttpInfo
+ *   Structure with HTTP information.
+ * @param[in] xLen
+ *   Number of bytes stored, at most length.
+ *
+ * @return
+ * - 0, in case of success.
+ * - -1, if the receive handler rejected the bytes.
+ */
+static int httpBodyReceived
+(
+  TKHttpInfo*  xpHttpInfo,
+  size_t       xLen
+);
+
+/**
+ * @brief
+ *   Feed received bytes to the response parser. The bytes may end anywhere in
+ *   the response; the parser state is kept in xpHttpInfo between the calls.
+ *
+ * @param[in,out] xpHttpInfo
+ *   Structure with HTTP information.
+ * @param[in] xpData
+ *   Received bytes. Should not be NULL.
+ * @param[in] xDataLen
+ *   Number of received bytes.
+ *
+ * @return
+ * - 0, in case of success.
+ * - -1, in case of error.
+ */
+static int httpParse
+(
+  TKHttpInfo*     xpHttpInfo,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+);
+
 /**
  * @brief
  *   To send the HTTP post request.
  *
  * @param[in] xpHttpInfo
  *   Structure with HTTP information.
- * @param[in] xpDir
  * @param[in] xpData
  * @param[in] xDataLen
  * @param[in] xpResponse
@@ -188,7 +242,6 @@ static int httpParse
 static int httpPost
 (
   TKHttpInfo*     xpHttpInfo,
-  const uint8_t*  xpDir,
   const uint8_t*  xpData,
   size_t          xDataLen,
   uint8_t*        xpResponse,
@@ -247,9 +300,28 @@ TCommIfStatus httpInit
     (void)snprintf((char*)gHttpInfo.url.port, sizeof(gHttpInfo.url.port), "%d", xPort);
     (void)strncpy((char*)gHttpInfo.url.path, (const char*)xpUri, sizeof(gHttpInfo.url.path)-1UL);
 
-    status = salComInit(C_HTTP_CONNECT_TIMEOUT_IN_MS,
-                        C_HTTP_READ_TIMEOUT_IN_MS,
-                        &gHttpInfo.pTls);
+    /* Header lines that stay the same for all the requests. */
+    retVal = snprintf(gHttpInfo.aPrefix, sizeof(gHttpInfo.aPrefix),
+                      "POST %s HTTP/1.1\r\n"
+                      "Host: %s:%s\r\n"
+                      "Connection: Keep-Alive\r\n"
+                      "Content-Type: application/octet-stream\r\n"
+                      "Content-Length: ",
+                      (const char*)gHttpInfo.url.path,
+                      gHttpInfo.url.host,
+                      gHttpInfo.url.port);
+    if ((retVal < 0) || ((size_t)retVal >= sizeof(gHttpInfo.aPrefix)))
+    {
+      M_INTL_HTTP_ERROR(("Request header too long"));
+      status = E_K_COMM_STATUS_PARAMETER;
+    }
+    else
+    {
+      gHttpInfo.prefixLen = (size_t)retVal;
+      status = salComInit(C_HTTP_CONNECT_TIMEOUT_IN_MS,
+                          C_HTTP_READ_TIMEOUT_IN_MS,
+                          &gHttpInfo.pTls);
+    }
     if (status == E_K_COMM_STATUS_OK)
     {
       status = salComConnect(gHttpInfo.pTls, gHttpInfo.url.host, gHttpInfo.url.port);
@@ -293,8 +365,8 @@ TCommIfStatus httpMsgExchange
   }
   else
   {
+    gHttpRecvStatus = E_COMM_IF_STATUS_OK;
     ret = httpPost(&gHttpInfo,
-                    gHttpInfo.url.path,
                     xpMsgToSend,
                     xSendSize,
                     xpRecvMsgBuffer,
@@ -306,6 +378,12 @@ TCommIfStatus httpMsgExchange
       M_INTL_HTTP_DEBUG(("Received Data %ld", gHttpInfo.bodyLen));
       *xpRecvMsgBufferSize = (size_t)gHttpInfo.bodyLen;
     }
+    else if (E_COMM_IF_STATUS_OK != gHttpRecvStatus)
+    {
+      K_HTTP__LOG("[ERROR] HTTP response rejected while received (status %d)\r\n",
+                  (int)gHttpRecvStatus);
+      status = gHttpRecvStatus;
+    }
     else
     {
       /* Log HTTP response code for debugging network/server failures */
@@ -358,6 +436,20 @@ TCommIfStatus httpMsgExchange
   return status;
 }
 
+/**
+ * @brief  implement httpSetRecvHandler
+ *
+ */
+void httpSetRecvHandler
+(
+  TCommIfRecvHandler  xpHandler,
+  void*               xpContext
+)
+{
+  gpHttpRecvHandler = xpHandler;
+  gpHttpRecvContext = xpContext;
+}
+
 /**
  * @brief  implement httpTerm
  *
@@ -497,21 +589,19 @@ static int httpHeader
   char* pToken;
   char  aT1[C_HTTP_TOKEN_MAX_LEN] = {0};
   char  aT2[C_HTTP_TOKEN_MAX_LEN] = {0};
-  int   len;
   int   retVal = 0;
 
   pToken = xpParam;
 
+  /* A header without value is skipped, the caller checks the status line. */
   pToken = pStrToken(pToken, aT1, (int)C_HTTP_TOKEN_MAX_LEN);
   if (pToken == NULL)
   {
-    retVal = -1;
     goto end;
   }
   pToken = pStrToken(pToken, aT2, (int)C_HTTP_TOKEN_MAX_LEN);
   if (pToken == NULL)
   {
-    retVal = -1;
     goto end;
   }
 
@@ -538,15 +628,14 @@ static int httpHeader
   }
   else if (lstrncasecmp(aT1, "location:", 9) == 0)
   {
-    len = (int)strlen(aT2);
-    (void)strncpy(xpHttpInfo->response.location, aT2, (unsigned int)len);
-    xpHttpInfo->response.location[len] = '\0';
+    (void)snprintf(xpHttpInfo->response.location, C_HTTP__HEADER_FIELD_SIZE, "%.*s",
+                   (int)(C_HTTP__HEADER_FIELD_SIZE - 1), aT2);
   }
   else if (lstrncasecmp(aT1, "content-length:", 15) == 0)
   {
     errno = 0;
     xpHttpInfo->response.contentLength = strtol(aT2, NULL, 10);
-    if (0 != errno)
+    if ((0 != errno) || (xpHttpInfo->response.contentLength < 0))
     {
       M_INTL_HTTP_ERROR(("Error Occured %d", errno));
       retVal = -1;
@@ -578,285 +667,261 @@ end:
 }
 
 /**
- * @implements httpParse
+ * @implements httpLineEnd
  *
  **/
-/**
- * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
- * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
- * Using goto for breaking during the error and return cases.
- **/
-static int httpParse
+static int httpLineEnd
 (
   TKHttpInfo*  xpHttpInfo
 )
 {
-  char *pPtr1;
-  char *pPtr2;
-  long len;
-  int  retVal = -1;
-  ptrdiff_t offset = 0;
-  size_t ptrOffset;
-
-  if (xpHttpInfo->recvLen == 0U)
+  int retVal = 0;
+
+  xpHttpInfo->aLine[xpHttpInfo->lineLen] = '\0';
+
+  if (xpHttpInfo->parseState == E_HTTP_PARSE_STATUS_LINE)
   {
-    retVal = -1;
+    if (xpHttpInfo->lineLen != 0U)
+    {
+      M_INTL_HTTP_DEBUG(("status: %s", xpHttpInfo->aLine));
+      if ((httpHeader(xpHttpInfo, xpHttpInfo->aLine) != 0) ||
+          (xpHttpInfo->response.status == 0))
+      {
+        M_INTL_HTTP_ERROR(("Invalid status line"));
+        retVal = -1;
+      }
+      xpHttpInfo->parseState = E_HTTP_PARSE_HEADER_LINE;
+    }
+  }
+  else if (xpHttpInfo->parseState == E_HTTP_PARSE_TRAILER)
+  {
+    if (xpHttpInfo->lineLen == 0U)
+    {
+      xpHttpInfo->parseState = E_HTTP_PARSE_DONE;
+    }
+  }
+  else if (xpHttpInfo->lineLen != 0U)
+  {
+    M_INTL_HTTP_DEBUG(("header: %s(%u)..", xpHttpInfo->aLine, (unsigned int)xpHttpInfo->lineLen));
+    if (httpHeader(xpHttpInfo, xpHttpInfo->aLine) != 0)
+    {
+      M_INTL_HTTP_ERROR(("httpHeader returned Error"));
+      retVal = -1;
+    }
   }
   else
   {
-    pPtr1 = (char *)xpHttpInfo->pRecvBuf;
+    M_INTL_HTTP_DEBUG(("header_end ...."));
+    if (xpHttpInfo->response.chunked == C_HTTP__TRUE)
+    {
+      xpHttpInfo->parseState = E_HTTP_PARSE_CHUNK_SIZE;
+      xpHttpInfo->length = 0;
+      xpHttpInfo->hasChunkSize = C_HTTP__FALSE;
+    }
+    else if (xpHttpInfo->response.contentLength > xpHttpInfo->bodySize)
+    {
+      M_INTL_HTTP_ERROR(("Body of %ld bytes exceeds the buffer", xpHttpInfo->response.contentLength));
+      retVal = -1;
+    }
+    else if (xpHttpInfo->response.contentLength > 0)
+    {
+      xpHttpInfo->parseState = E_HTTP_PARSE_BODY;
+      xpHttpInfo->length = xpHttpInfo->response.contentLength;
+    }
+    else
+    {
+      xpHttpInfo->parseState = E_HTTP_PARSE_DONE;
+    }
+  }
+
+  xpHttpInfo->lineLen = 0;
+  return retVal;
+}
+
+/**
+ * @implements httpBodyReceived
+ *
+ **/
+static int httpBodyReceived
+(
+  TKHttpInfo*  xpHttpInfo,
+  size_t       xLen
+)
+{
+  int retVal = 0;
+
+  /* Only a success response carries a message for the handler. */
+  if ((NULL != gpHttpRecvHandler) &&
+      (xpHttpInfo->response.status == (int)C_HTTP_SUCCESS_STATUS_CODE))
+  {
+    gHttpRecvStatus = gpHttpRecvHandler(gpHttpRecvContext,
+                                        &xpHttpInfo->body[xpHttpInfo->bodyLen],
+                                        xLen);
+    if (E_COMM_IF_STATUS_OK != gHttpRecvStatus)
+    {
+      M_INTL_HTTP_ERROR(("Body rejected by the receive handler"));
+      retVal = -1;
+    }
+  }
+
+  if (retVal == 0)
+  {
+    xpHttpInfo->bodyLen += (long)xLen;
+    xpHttpInfo->length -= (long)xLen;
 
-    /* Using the variable while(C_HTTP_TRUE) instead of while(1), to resolve the misra warning
-    * Warning: 1 is not a boolean type
-    */
-    while (C_HTTP__TRUE)
+    if (xpHttpInfo->length == 0)
     {
-      if (xpHttpInfo->headerEnd == C_HTTP__FALSE)     /* Header parser. */
+      if (xpHttpInfo->parseState == E_HTTP_PARSE_CHUNK_DATA)
+      {
+        xpHttpInfo->parseState = E_HTTP_PARSE_CHUNK_DATA_END;
+      }
+      else
       {
-        pPtr2 = strstr(pPtr1, "\r\n");
-        if (pPtr2 != NULL)
+        xpHttpInfo->parseState = E_HTTP_PARSE_DONE;
+      }
+    }
+  }
+
+  return retVal;
+}
+
+/**
+ * @implements httpParse
+ *
+ **/
+static int httpParse
+(
+  TKHttpInfo*     xpHttpInfo,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+)
+{
+  const uint8_t* pEol;
+  size_t  offset = 0;
+  size_t  len;
+  size_t  copyLen;
+  int     digit;
+  uint8_t byte;
+  int     retVal = 0;
+
+  while ((offset < xDataLen) &&
+         (retVal == 0) &&
+         (xpHttpInfo->parseState != E_HTTP_PARSE_DONE))
+  {
+    switch (xpHttpInfo->parseState)
+    {
+      case E_HTTP_PARSE_BODY:
+      case E_HTTP_PARSE_CHUNK_DATA:
+      {
+        /* Body bytes that arrived with the header or the chunk framing. */
+        len = xDataLen - offset;
+        if (len > (size_t)xpHttpInfo->length)
         {
-          len = (long)(pPtr2 - pPtr1);
-          *pPtr2 = '\0';
+          len = (size_t)xpHttpInfo->length;
+        }
+        (void)memcpy(&xpHttpInfo->body[xpHttpInfo->bodyLen], &xpData[offset], len);
+        retVal = httpBodyReceived(xpHttpInfo, len);
+        offset += len;
+        break;
+      }
 
-          if (len > 0)
-          {
-            M_INTL_HTTP_DEBUG(("header: %s(%ld)..", pPtr1, len));
-            if (httpHeader(xpHttpInfo, pPtr1) != 0)
-            {
-              M_INTL_HTTP_ERROR(("httpHeader returned Error"));
-              retVal = -1;
-              goto end;
-            }
-            pPtr1 = &pPtr2[2];    /* Skip CR+LF. */
-          }
-          else
+      case E_HTTP_PARSE_CHUNK_SIZE:
+      {
+        byte = xpData[offset];
+        if (isxdigit((int)byte) != 0)
+        {
+          digit = (isdigit((int)byte) != 0) ? ((int)byte - '0') : (tolower((int)byte) - 'a' + 10);
+          xpHttpInfo->length = (xpHttpInfo->length * 16) + digit;
+          xpHttpInfo->hasChunkSize = C_HTTP__TRUE;
+          if (xpHttpInfo->length > (xpHttpInfo->bodySize - xpHttpInfo->bodyLen))
           {
-
-            xpHttpInfo->headerEnd = C_HTTP__TRUE; /* Reach the header-end. */
-
-            M_INTL_HTTP_DEBUG(("header_end ...."));
-
-            pPtr1 = &pPtr2[2];    /* Skip CR+LF. */
-
-            if (xpHttpInfo->response.chunked == C_HTTP__TRUE)
-            {
-              offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-              len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-              if (len > 0)
-              {
-                pPtr2 = strstr(pPtr1, "\r\n");
-                if (pPtr2 != NULL)
-                {
-                  *pPtr2 = '\0';
-                  errno = 0;
-                  xpHttpInfo->length = strtol(pPtr1, NULL, 16);
-                  if (0 != errno)
-                  {
-                    M_INTL_HTTP_ERROR(("Error Occured %d", errno));
-                  }
-                  if (xpHttpInfo->length == 0)
-                  {
-                      xpHttpInfo->response.chunked = C_HTTP__FALSE;
-                  }
-                  else
-                  {
-                      xpHttpInfo->response.contentLength += xpHttpInfo->length;
-                  }
-                  pPtr1 = &pPtr2[2];    /* Skip CR+LF. */
-                }
-                else
-                {
-                  /* Copy the data as chunked size. */
-                  (void)strncpy((char *)xpHttpInfo->pRecvBuf, pPtr1, (unsigned int)len);
-                  xpHttpInfo->pRecvBuf[len] = '\0';
-                  xpHttpInfo->recvLen = (size_t)len;
-                  xpHttpInfo->length = -1;
-                  retVal = 0;
-                  goto end;
-                }
-              }
-              else
-              {
-                xpHttpInfo->recvLen = 0;
-                xpHttpInfo->length = -1;
-                retVal = 0;
-                goto end;
-              }
-            }
-            else
-            {
-              xpHttpInfo->length = xpHttpInfo->response.contentLength;
-            }
+            M_INTL_HTTP_ERROR(("Chunk exceeds the buffer"));
+            retVal = -1;
           }
+          offset++;
         }
         else
         {
-          offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-          len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-          if (len  > 0)
-          {
-            /* Keep the partial header data. */
-            (void)strncpy((char*)xpHttpInfo->pRecvBuf, pPtr1, (unsigned int)len);
-            xpHttpInfo->pRecvBuf[len] = '\0';
-            xpHttpInfo->recvLen = (size_t)len;
-          }
-          else
-          {
-            xpHttpInfo->recvLen = 0;
-          }
-          retVal = 0;
-          goto end;
+          /* End of the size, the rest of the line is skipped. */
+          xpHttpInfo->parseState = E_HTTP_PARSE_CHUNK_EXT;
         }
+        break;
       }
-      else    /* Body parser. */
-      {
 
-        if ((xpHttpInfo->response.chunked == C_HTTP__TRUE) && (xpHttpInfo->length == -1))
+      case E_HTTP_PARSE_CHUNK_EXT:
+      {
+        byte = xpData[offset];
+        offset++;
+        if (byte == (uint8_t)'\n')
         {
-          offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-          len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-          if (len > 0)
+          if (xpHttpInfo->hasChunkSize == C_HTTP__FALSE)
           {
-            pPtr2 = strstr(pPtr1, "\r\n");
-            if (pPtr2 != NULL)
-            {
-              *pPtr2 = '\0';
-              errno = 0;
-              xpHttpInfo->length = strtol(pPtr1, NULL, 16);
-              if (0 != errno)
-              {
-                M_INTL_HTTP_ERROR(("Error Occured %d", errno));
-              }
-              if (xpHttpInfo->length == 0)
-              {
-                  xpHttpInfo->response.chunked = C_HTTP__FALSE;
-              }
-              else
-              {
-                  xpHttpInfo->response.contentLength += xpHttpInfo->length;
-              }
-
-              pPtr1 = &pPtr2[2];    /* Skip CR+LF */
-            }
-            else
-            {
-              /* Copy the remain data as chunked size. */
-              (void)strncpy((char*)xpHttpInfo->pRecvBuf, pPtr1, (unsigned int)len);
-              xpHttpInfo->pRecvBuf[len] = '\0';
-              xpHttpInfo->recvLen = (size_t)len;
-              xpHttpInfo->length = -1;
-              retVal = 0;
-              goto end;
-            }
+            M_INTL_HTTP_ERROR(("Missing chunk size"));
+            retVal = -1;
+          }
+          else if (xpHttpInfo->length == 0)
+          {
+            xpHttpInfo->parseState = E_HTTP_PARSE_TRAILER;
           }
           else
           {
-            xpHttpInfo->recvLen = 0;
-            retVal = 0;
-            goto end;
+            xpHttpInfo->response.contentLength += xpHttpInfo->length;
+            xpHttpInfo->parseState = E_HTTP_PARSE_CHUNK_DATA;
           }
         }
+        break;
+      }
+
+      case E_HTTP_PARSE_CHUNK_DATA_END:
+      {
+        byte = xpData[offset];
+        offset++;
+        if (byte == (uint8_t)'\n')
+        {
+          xpHttpInfo->parseState = E_HTTP_PARSE_CHUNK_SIZE;
+          xpHttpInfo->length = 0;
+          xpHttpInfo->hasChunkSize = C_HTTP__FALSE;
+        }
+        else if (byte != (uint8_t)'\r')
+        {
+          M_INTL_HTTP_ERROR(("Missing CR+LF after chunk"));
+          retVal = -1;
+        }
         else
         {
-            if (xpHttpInfo->length > 0)
-            {
-              offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-              len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-
-              if (len > xpHttpInfo->length)
-              {
-                /* Copy the data for response. */
-                if (xpHttpInfo->bodyLen < xpHttpInfo->bodySize)
-                {
-                  if (xpHttpInfo->bodySize > (xpHttpInfo->bodyLen + xpHttpInfo->length))
-                  {
-                    (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]),
-                            (const void *)pPtr1,
-                            (unsigned int)xpHttpInfo->length);
-                    xpHttpInfo->bodyLen += xpHttpInfo->length;
-                  }
-                  else
-                  {
-                    (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]),
-                            (const void *)pPtr1,
-                            (unsigned int)(xpHttpInfo->bodySize - xpHttpInfo->bodyLen));
-                    xpHttpInfo->bodyLen = xpHttpInfo->bodySize;
-                  }
-                }
-
-                ptrOffset = xpHttpInfo->length;
-                pPtr1 = &pPtr1[ptrOffset];
-                len -= xpHttpInfo->length;
-
-                if ((xpHttpInfo->response.chunked == C_HTTP__TRUE) && (len >= 2))
-                {
-                  pPtr1 = &pPtr1[2];    /* Skip CR+LF. */
-                  xpHttpInfo->length = -1;
-                }
-                else
-                {
-                  retVal = -1;
-                  goto end;
-                }
-              }
-              else
-              {
-                /* Copy the data for response. */
-                if (xpHttpInfo->bodyLen < xpHttpInfo->bodySize)
-                {
-                  if (xpHttpInfo->bodySize > (xpHttpInfo->bodyLen + len))
-                  {
-                    (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]), (const void *)pPtr1, (unsigned int)len);
-                    xpHttpInfo->bodyLen += len;
-                  }
-                  else
-                  {
-                    (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]),
-                              (const void *)pPtr1,
-                              (unsigned int)(xpHttpInfo->bodySize - xpHttpInfo->bodyLen));
-                    xpHttpInfo->bodyLen = xpHttpInfo->bodySize;
-                  }
-                }
-
-                xpHttpInfo->length -= len;
-                xpHttpInfo->recvLen = 0;
-
-                if ((xpHttpInfo->response.chunked == C_HTTP__FALSE) && (xpHttpInfo->length <= 0))
-                {
-                  retVal = 1;
-                  goto end;
-                }
-                retVal = 0;
-                goto end;
-              }
-            }
-            else
-            {
-              if (xpHttpInfo->response.chunked == C_HTTP__FALSE)
-              {
-                retVal = 1;
-                goto end;
-              }
-
-              /* Chunked size check. */
-              if ((xpHttpInfo->recvLen > 2u) && (strncmp(pPtr1, "\r\n", 2) == 0))
-              {
-                pPtr1 = &pPtr1[2];
-                xpHttpInfo->length = -1;
-              }
-              else
-              {
-                xpHttpInfo->length = -1;
-                xpHttpInfo->recvLen = 0;
-              }
-            }
+          /* CR of the CR+LF. */
+        }
+        break;
+      }
+
+      default:
+      {
+        /* Status, header and trailer lines, the part beyond aLine is dropped. */
+        pEol = (const uint8_t*)memchr(&xpData[offset], (int)'\n', xDataLen - offset);
+        len = (pEol != NULL) ? (size_t)(pEol - &xpData[offset]) : (xDataLen - offset);
+        copyLen = (C_HTTP__LINE_SIZE - 1u) - xpHttpInfo->lineLen;
+        if (copyLen > len)
+        {
+          copyLen = len;
+        }
+        (void)memcpy(&xpHttpInfo->aLine[xpHttpInfo->lineLen], &xpData[offset], copyLen);
+        xpHttpInfo->lineLen += copyLen;
+        offset += len;
+        if (pEol != NULL)
+        {
+          offset++;
+          if ((xpHttpInfo->lineLen != 0U) &&
+              (xpHttpInfo->aLine[xpHttpInfo->lineLen - 1U] == '\r'))
+          {
+            xpHttpInfo->lineLen--;
+          }
+          retVal = httpLineEnd(xpHttpInfo);
         }
+        break;
       }
     }
-end:
-    retVal = 0;
   }
+
   return retVal;
 }
 
@@ -872,7 +937,6 @@ end:
 static int httpPost
 (
   TKHttpInfo*     xpHttpInfo,
-  const uint8_t*  xpDir,
   const uint8_t*  xpData,
   size_t          xDataLen,
   uint8_t*        xpResponse,
@@ -880,8 +944,12 @@ static int httpPost
 )
 {
   TKCommStatus status = E_K_COMM_STATUS_ERROR;
-  uint8_t aBuffer[C_HTTP_MAX_DATA_LEN] = {0};
-  unsigned int len;
+  uint8_t aBuffer[C_HTTP_MAX_DATA_LEN];
+  TKSalComIoVec aRequest[C_HTTP__REQUEST_VEC_COUNT];
+  uint8_t* pRecv;
+  size_t recvSize;
+  size_t recvLen;
+  int len;
   int retVal = -1;
 
   M_INTL_HTTP_DEBUG(("Start of %s", __func__));
@@ -892,35 +960,34 @@ static int httpPost
   }
   else
   {
-    /* Send HTTP buffer. */
-    len = (unsigned int)snprintf((char *)aBuffer, C_HTTP_MAX_DATA_LEN,
-                    "POST %s HTTP/1.1\r\n"
-                    "Host: %s:%s\r\n"
-                    "Connection: Keep-Alive\r\n"
-                    "Content-Type: application/octet-stream\r\n"
-                    "Content-Length: %d\r\n"
+    /* Only the Content-Length value and the Cookie change between requests,
+     * the header prefix and the body are sent as they are. */
+    len = snprintf(xpHttpInfo->aTail, sizeof(xpHttpInfo->aTail),
+                    "%lu\r\n"
                     "Cookie: %s\r\n"
                     "\r\n",
-                    (const char *)xpDir,
-                    xpHttpInfo->url.host,
-                    xpHttpInfo->url.port,
-                    (int)xDataLen,
+                    (unsigned long)xDataLen,
                     xpHttpInfo->request.cookie);
 
-    M_INTL_HTTP_DEBUG(("Post Header len %d", len));
-    (void)memcpy(&aBuffer[len], xpData, xDataLen);
-    len = len + xDataLen;
-    if (len > C_HTTP_MAX_DATA_LEN)
+    M_INTL_HTTP_DEBUG(("Post Header len %u", (unsigned int)(xpHttpInfo->prefixLen + (size_t)len)));
+    if ((xpHttpInfo->prefixLen == 0U) || (len <= 0) || ((size_t)len >= sizeof(xpHttpInfo->aTail)))
     {
-      M_INTL_HTTP_ERROR(("Buffer Overflow"));
+      M_INTL_HTTP_ERROR(("Invalid request"));
       (void)salComTerm(xpHttpInfo->pTls);
       retVal = -1;
       goto end;
     }
-    status = salComWrite(xpHttpInfo->pTls, aBuffer, len);
+    xpHttpInfo->tailLen = (size_t)len;
+    aRequest[0].pData = (const uint8_t*)xpHttpInfo->aPrefix;
+    aRequest[0].len = xpHttpInfo->prefixLen;
+    aRequest[1].pData = (const uint8_t*)xpHttpInfo->aTail;
+    aRequest[1].len = xpHttpInfo->tailLen;
+    aRequest[2].pData = xpData;
+    aRequest[2].len = xDataLen;
+    status = salComWritev(xpHttpInfo->pTls, aRequest, C_HTTP__REQUEST_VEC_COUNT);
     if (E_K_COMM_STATUS_OK != status)
     {
-      M_INTL_HTTP_ERROR(("salComWrite Failed"));
+      M_INTL_HTTP_ERROR(("salComWritev Failed"));
       (void)salComTerm(xpHttpInfo->pTls);
       retVal = -1;
       goto end;
@@ -928,31 +995,63 @@ static int httpPost
 
     xpHttpInfo->response.status = 0;
     xpHttpInfo->response.contentLength = 0;
+    xpHttpInfo->response.chunked = C_HTTP__FALSE;
     xpHttpInfo->response.close = C_HTTP__FALSE;
 
-    xpHttpInfo->recvLen = 0;
-    xpHttpInfo->headerEnd = C_HTTP__FALSE;
+    xpHttpInfo->parseState = E_HTTP_PARSE_STATUS_LINE;
+    xpHttpInfo->length = 0;
+    xpHttpInfo->lineLen = 0;
 
     xpHttpInfo->body = xpResponse;
     xpHttpInfo->bodySize = (long)xSize;
     xpHttpInfo->bodyLen = 0;
-    xpHttpInfo->body[0] = 0;
-    xpHttpInfo->recvLen = sizeof(aBuffer);
-    xpHttpInfo->pRecvBuf = (char *)aBuffer;
 
-    status = salComRead(xpHttpInfo->pTls, aBuffer, &xpHttpInfo->recvLen);
-    if (E_K_COMM_STATUS_OK != status)
-    {
-      M_INTL_HTTP_ERROR(("salComRead Failed"));
-      (void)salComTerm(xpHttpInfo->pTls);
-      retVal = -1;
-      goto end;
-    }
-    if (httpParse(xpHttpInfo) != 0)
+    /* Read until the response is complete. The header and the chunk framing
+     * go through aBuffer, the body is received in place in xpResponse. */
+    while (xpHttpInfo->parseState != E_HTTP_PARSE_DONE)
     {
-      M_INTL_HTTP_ERROR(("httpHeader returned Error"));
-      retVal = -1;
-      goto end;
+      if ((xpHttpInfo->parseState == E_HTTP_PARSE_BODY) ||
+          (xpHttpInfo->parseState == E_HTTP_PARSE_CHUNK_DATA))
+      {
+        pRecv = &xpHttpInfo->body[xpHttpInfo->bodyLen];
+        recvSize = (size_t)xpHttpInfo->length;
+      }
+      else
+      {
+        pRecv = aBuffer;
+        recvSize = sizeof(aBuffer);
+      }
+      recvLen = recvSize;
+
+      status = salComRead(xpHttpInfo->pTls, pRecv, &recvLen);
+      if ((E_K_COMM_STATUS_OK != status) || (0U == recvLen) || (recvLen > recvSize))
+      {
+        M_INTL_HTTP_ERROR(("salComRead Failed"));
+        (void)salComTerm(xpHttpInfo->pTls);
+        retVal = -1;
+        goto end;
+      }
+
+      if (pRecv != aBuffer)
+      {
+        if (httpBodyReceived(xpHttpInfo, recvLen) != 0)
+        {
+          (void)salComTerm(xpHttpInfo->pTls);
+          retVal = -1;
+          goto end;
+        }
+      }
+      else if (httpParse(xpHttpInfo, aBuffer, recvLen) != 0)
+      {
+        M_INTL_HTTP_ERROR(("httpParse returned Error"));
+        (void)salComTerm(xpHttpInfo->pTls);
+        retVal = -1;
+        goto end;
+      }
+      else
+      {
+        /* Parsed, continue with the next read. */
+      }
     }
 
     if ((int)xpHttpInfo->response.close == 1)
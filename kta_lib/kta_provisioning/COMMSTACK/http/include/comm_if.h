@@ -133,6 +133,28 @@ typedef struct
   /* Age of current connection in seconds (0 if not connected). */
 } TCommIfStatistics;
 
+/**
+ * @brief
+ *   Handler of the response body, called with each part as it is received.
+ *
+ * @param[in] xpContext
+ *   Context given to commSetRecvHandler().
+ * @param[in] xpData
+ *   Next part of the body, already stored in the receive buffer.
+ * @param[in] xDataLen
+ *   Size of xpData in bytes.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK to continue receiving.
+ * - Any other status to abort the exchange, commMsgExchange() returns it.
+ */
+typedef TCommIfStatus (*TCommIfRecvHandler)
+(
+  void*           xpContext,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+);
+
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
 /* -------------------------------------------------------------------------- */
@@ -185,6 +207,7 @@ TCommIfStatus commInit
  * - E_COMM_IF_STATUS_NO_CONNECTION if not connected (call commInit first).
  * - E_COMM_IF_STATUS_NETWORK if any network issue.
  * - E_COMM_IF_STATUS_TIMEOUT if operation timed out.
+ * - Status returned by the receive handler if it rejected the response.
  */
 TCommIfStatus commMsgExchange
 (
@@ -194,6 +217,22 @@ TCommIfStatus commMsgExchange
   size_t*         xpRecvMsgBufferSize
 );
 
+/**
+ * @brief
+ *   Set the handler called with the response body of the next exchanges while
+ *   it is received, so that a wrong response can be rejected early.
+ *
+ * @param[in] xpHandler
+ *   Handler, NULL to receive the body without handler.
+ * @param[in] xpContext
+ *   Context given back to xpHandler.
+ */
+void commSetRecvHandler
+(
+  TCommIfRecvHandler  xpHandler,
+  void*               xpContext
+);
+
 /**
  * @brief
  *   Terminate communication stack.
@@ -55,8 +55,43 @@
 /** @brief HTTP header field size. */
 #define C_HTTP__HEADER_FIELD_SIZE     (64u)
 
+/** @brief Longest response header line kept by the parser, longer lines are truncated. */
+#define C_HTTP__LINE_SIZE             (256u)
+
+/** @brief Size of the request header part that is the same for all the requests. */
+#define C_HTTP__PREFIX_SIZE           (512u)
+
+/** @brief Size of the request header part set per request: Content-Length value and Cookie. */
+#define C_HTTP__TAIL_SIZE             (96u)
+
+/** @brief Number of buffers of a request: header prefix, header tail and body. */
+#define C_HTTP__REQUEST_VEC_COUNT     (3u)
+
 typedef uint8_t BOOL;
 
+/** @brief HTTP response parser states. */
+typedef enum
+{
+  E_HTTP_PARSE_STATUS_LINE,
+  /* Receiving the status line. */
+  E_HTTP_PARSE_HEADER_LINE,
+  /* Receiving a header line, an empty one ends the header. */
+  E_HTTP_PARSE_BODY,
+  /* Receiving a Content-Length body. */
+  E_HTTP_PARSE_CHUNK_SIZE,
+  /* Receiving the hexadecimal size of a chunk. */
+  E_HTTP_PARSE_CHUNK_EXT,
+  /* Skipping a chunk extension up to the end of the size line. */
+  E_HTTP_PARSE_CHUNK_DATA,
+  /* Receiving the data of a chunk. */
+  E_HTTP_PARSE_CHUNK_DATA_END,
+  /* Expecting the CR+LF closing the data of a chunk. */
+  E_HTTP_PARSE_TRAILER,
+  /* Skipping the trailer lines after the last chunk. */
+  E_HTTP_PARSE_DONE
+  /* Response complete. */
+} TKHttpParseState;
+
 /** @brief Structure to store HTTP header data. */
 typedef struct
 {
@@ -81,17 +116,27 @@ typedef struct
 /** @brief Structure to store HTTP information. */
 typedef struct
 {
-  TKHttpUrl     url;
-  TKHttpHeader  request;
-  TKHttpHeader  response;
-  void*         pTls;
-  long          length;
-  char*         pRecvBuf;
-  size_t        recvLen;
-  BOOL          headerEnd;
-  uint8_t*      body;
-  long          bodySize;
-  long          bodyLen;
+  TKHttpUrl         url;
+  TKHttpHeader      request;
+  TKHttpHeader      response;
+  void*             pTls;
+  char              aPrefix[C_HTTP__PREFIX_SIZE];
+  size_t            prefixLen;
+  /* Request header up to the Content-Length value, built with the URL. */
+  char              aTail[C_HTTP__TAIL_SIZE];
+  size_t            tailLen;
+  /* Rest of the request header, built per request. */
+  TKHttpParseState  parseState;
+  long              length;
+  /* Bytes left in the Content-Length body or in the current chunk. */
+  char              aLine[C_HTTP__LINE_SIZE];
+  size_t            lineLen;
+  /* Header line received so far, NUL terminated. */
+  BOOL              hasChunkSize;
+  /* At least one digit of the chunk size was received. */
+  uint8_t*          body;
+  long              bodySize;
+  long              bodyLen;
 } TKHttpInfo;
 
 /* --------------------------------------------------------------------------------------------- */
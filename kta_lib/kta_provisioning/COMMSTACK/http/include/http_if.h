@@ -101,6 +101,7 @@ TCommIfStatus httpInit
  * - E_COMM_IF_STATUS_OK or the error status, in particular.
  * - E_COMM_IF_STATUS_PARAMETER if wrong parameters received.
  * - E_COMM_IF_STATUS_NETWORK if any network issue.
+ * - Status returned by the receive handler if it rejected the response.
  */
 TCommIfStatus httpMsgExchange
 (
@@ -110,6 +111,22 @@ TCommIfStatus httpMsgExchange
   size_t*          xpRecvMsgBufferSize
 );
 
+/**
+ * @brief
+ *   Set the handler called with each part of the response body as it is
+ *   received. It is kept across httpInit() and httpTerm().
+ *
+ * @param[in] xpHandler
+ *   Handler, NULL to receive the body without handler.
+ * @param[in] xpContext
+ *   Context given back to xpHandler.
+ */
+void httpSetRecvHandler
+(
+  TCommIfRecvHandler  xpHandler,
+  void*               xpContext
+);
+
 /**
  * @brief
  *   Terminate Http Module.
@@ -66,6 +66,17 @@ extern "C" {
 /* -------------------------------------------------------------------------- */
 /* CONSTANTS, TYPES, ENUM                                                     */
 /* -------------------------------------------------------------------------- */
+/** @brief Maximum number of buffers of a vectored write. */
+#define C_K_SAL_COM_IOVEC_MAX_COUNT   (4u)
+
+/** @brief One buffer of a vectored write. */
+typedef struct
+{
+  const uint8_t*  pData;
+  /* Data to send. */
+  size_t          len;
+  /* Size of the data, in bytes. */
+} TKSalComIoVec;
 
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
@@ -153,6 +164,34 @@ K_SAL_API TKCommStatus salComWrite
   size_t          xBufferLen
 );
 
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Send several buffers to the server as one stream, without gathering them
+ *   in an intermediate buffer.
+ *
+ * @pre
+ *   salComConnect should be successfully executed prior to this function.
+ *
+ * @param[in] xpComInfo
+ *   Com info data; Should not be NULL.
+ * @param[in] xpVec
+ *   Buffers to send, in order; Should not be NULL. Empty buffers are skipped.
+ * @param[in] xVecCount
+ *   Number of buffers, 1 to C_K_SAL_COM_IOVEC_MAX_COUNT.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount
+);
+
 /**
  * @ingroup
  *   g_sal_com
@@ -266,6 +266,39 @@ K_SAL_API TKCommStatus salComWrite
   return E_K_COMM_STATUS_OK;
 }
 
+/**
+ * @brief  implement salComWritev
+ *
+ */
+K_SAL_API TKCommStatus salComWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount
+)
+{
+  TKCommStatus status = E_K_COMM_STATUS_OK;
+  size_t i;
+
+  if ((NULL == xpVec) || (0U == xVecCount) || (C_K_SAL_COM_IOVEC_MAX_COUNT < xVecCount))
+  {
+    status = E_K_COMM_STATUS_PARAMETER;
+  }
+  else
+  {
+    /* Replace by the gather send of the platform when it has one. */
+    for (i = 0; (i < xVecCount) && (E_K_COMM_STATUS_OK == status); i++)
+    {
+      if (0U != xpVec[i].len)
+      {
+        status = salComWrite(xpComInfo, xpVec[i].pData, xpVec[i].len);
+      }
+    }
+  }
+
+  return status;
+}
+
 /**
  * @brief  implement salComRead
  *
@@ -48,6 +48,15 @@ extern "C" {
 #define K_SAL_API
 #endif /* K_SAL_API */
 
+/*
+ * Storage class of the bindings made per calling thread (the KTA instance and
+ * SAL context served), e.g. _Thread_local when several threads run instances.
+ * Empty by default: one binding for the whole program.
+ */
+#ifndef K_THREAD_LOCAL
+#define K_THREAD_LOCAL
+#endif /* K_THREAD_LOCAL */
+
 /** @defgroup g_kta_api keySTREAM Trusted Agent Interface */
 
 /** @addtogroup g_kta_api
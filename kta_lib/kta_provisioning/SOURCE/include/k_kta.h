@@ -49,6 +49,7 @@ extern "C" {
 /* --------------------------------------------------------------------------------------------- */
 #include "k_defs.h"
 #include "ktaConfig.h"
+#include "cryptoConfig.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -112,6 +113,33 @@ typedef enum
   E_K_KTA_KS_STATUS_REFURBISH,
 } TKktaKeyStreamStatus;
 
+/**
+ * @brief
+ *   Scratch workspace provided by the application to ktaExchangeMessageEx().
+ *   All the message buffers of an exchange are carved from it, none are on the stack.
+ */
+typedef struct
+{
+  /** Workspace storage, 8-byte aligned. */
+  uint64_t  aArena[(C_K__KTA_WORKSPACE_SIZE + 7u) / 8u];
+} TKtaWorkspace;
+
+/** @brief Storage reserved for the state of one keySTREAM Trusted Agent instance, in bytes. */
+#define C_K__KTA_CONTEXT_SIZE                         (1664u)
+
+/**
+ * @brief
+ *   Storage of one keySTREAM Trusted Agent instance and its secure element, provided by
+ *   the application to the ...Ctx() functions. Its content is private to the KTA.
+ */
+typedef struct
+{
+  /** Instance state, 8-byte aligned. */
+  uint64_t       aOpaque[(C_K__KTA_CONTEXT_SIZE + 7u) / 8u];
+  /** Workspace of ktaExchangeMessageCtx(). */
+  TKtaWorkspace  workspace;
+} TKtaContext;
+
 /* --------------------------------------------------------------------------------------------- */
 /* VARIABLES                                                                                     */
 /* --------------------------------------------------------------------------------------------- */
@@ -274,6 +302,11 @@ TKStatus ktaSetDeviceInformation
  *   xKs2ktaMsgLen will be filled with actual size received from the keySTREAM.
  *   If it is 0, It indicates that no furhter operation to be performed.
  *   Should be provided by the caller
+ * @remark
+ *   The intermediate message buffers come from a single workspace in static memory,
+ *   C_K__KTA_WORKSPACE_SIZE bytes of RAM (5632, or 10240 with FOTA), only linked when
+ *   this function is used. The call is not reentrant. Use ktaExchangeMessageEx() to
+ *   choose where that memory lives, ktaExchangeMessageCtx() to serve several instances.
  *
  * @return
  * - E_K_STATUS_OK in case of success.
@@ -288,6 +321,275 @@ TKStatus ktaExchangeMessage
   size_t*         xpKta2ksMsgLen
 );
 
+/**
+ * @brief
+ *   Same as ktaExchangeMessage(), with the intermediate message buffers carved from
+ *   a workspace provided by the application instead of the static one.
+ *   Its stack use stays small: the workspace can be static, pooled or on the stack.
+ *
+ * @pre
+ *   Network stack is ready to communicate with the keySTREAM.
+ *   The function ktaStartup() has been called.
+ *
+ * @param[in,out] xpWorkspace
+ *   Scratch workspace, only used for the duration of the call.
+ *   Should not be NULL.
+ * @param[in] xpKs2ktaMsg
+ *   See ktaExchangeMessage().
+ * @param[in] xKs2ktaMsgLen
+ *   See ktaExchangeMessage().
+ * @param[in,out] xpKta2ksMsg
+ *   See ktaExchangeMessage().
+ * @param[in,out] xpKta2ksMsgLen
+ *   See ktaExchangeMessage().
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaExchangeMessageEx
+(
+  TKtaWorkspace*  xpWorkspace,
+  const uint8_t*  xpKs2ktaMsg,
+  size_t          xKs2ktaMsgLen,
+  uint8_t*        xpKta2ksMsg,
+  size_t*         xpKta2ksMsgLen
+);
+
+/**
+ * @brief
+ *   Get the highest workspace usage reached by the exchanges done so far.
+ *
+ * @param[out] xpPeakSize
+ *   Peak usage in bytes, at most C_K__KTA_WORKSPACE_SIZE.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ */
+TKStatus ktaGetWorkspacePeak
+(
+  size_t*  xpPeakSize
+);
+
+/**
+ * @brief
+ *   Idle hook: prepare the activation request of a sealed device ahead of the
+ *   first ktaExchangeMessage() call, which then skips the ephemeral key
+ *   generation and the chip certificate build. Does nothing once activated.
+ *   Optional, to be called after ktaStartup() while the application is idle.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaPrecompute
+(
+  void
+);
+
+/**
+ * @brief
+ *   Reset a keySTREAM Trusted Agent instance to its power-on state.
+ *   ktaInitializeCtx() must be called again before the other ...Ctx() calls.
+ *
+ *   Each ...Ctx() function does the same as the function without the suffix, for the
+ *   instance stored in xpContext instead of the built-in one. Instances are
+ *   independent: different threads may serve different instances at the same time,
+ *   provided the library is built with K_THREAD_LOCAL defined (e.g. _Thread_local)
+ *   and the SAL platform allows concurrent secure element sessions. An instance is
+ *   served by one thread at a time.
+ *
+ * @param[out] xpContext
+ *   Instance storage. Should not be NULL.
+ * @param[in] xpSalDevice
+ *   Secure element of the instance, an ATCADevice for the CryptoAuthLib SAL.
+ *   NULL uses the device initialized by the application.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ */
+TKStatus ktaContextInit
+(
+  TKtaContext*  xpContext,
+  void*         xpSalDevice
+);
+
+/**
+ * @brief
+ *   ktaInitialize() for an instance.
+ *
+ * @param[in,out] xpContext
+ *   Instance initialized with ktaContextInit(), NULL for the built-in one.
+ *
+ * @return
+ *   See ktaInitialize().
+ */
+TKStatus ktaInitializeCtx
+(
+  TKtaContext*  xpContext
+);
+
+/**
+ * @brief
+ *   ktaStartup() for an instance.
+ *
+ * @param[in,out] xpContext
+ *   Instance initialized with ktaContextInit(), NULL for the built-in one.
+ * @param[in] xpL1SegSeed
+ *   See ktaStartup().
+ * @param[in] xpKtaContextProfileUid
+ *   See ktaStartup().
+ * @param[in] xKtaContextProfileUidLen
+ *   See ktaStartup().
+ * @param[in] xpKtaContexSerialNumber
+ *   See ktaStartup().
+ * @param[in] xKtaContexSerialNumberLen
+ *   See ktaStartup().
+ * @param[in] xpKtaContextVersion
+ *   See ktaStartup().
+ * @param[in] xKtaContextVersionLen
+ *   See ktaStartup().
+ *
+ * @return
+ *   See ktaStartup().
+ */
+TKStatus ktaStartupCtx
+(
+  TKtaContext*    xpContext,
+  const uint8_t*  xpL1SegSeed,
+  const uint8_t*  xpKtaContextProfileUid,
+  size_t          xKtaContextProfileUidLen,
+  const uint8_t*  xpKtaContexSerialNumber,
+  size_t          xKtaContexSerialNumberLen,
+  const uint8_t*  xpKtaContextVersion,
+  size_t          xKtaContextVersionLen
+);
+
+/**
+ * @brief
+ *   ktaSetDeviceInformation() for an instance.
+ *
+ * @param[in,out] xpContext
+ *   Instance initialized with ktaContextInit(), NULL for the built-in one.
+ * @param[in] xpDeviceProfilePublicUid
+ *   See ktaSetDeviceInformation().
+ * @param[in] xDeviceProfilePublicUidSize
+ *   See ktaSetDeviceInformation().
+ * @param[in] xpDeviceSerialNum
+ *   See ktaSetDeviceInformation().
+ * @param[in] xDeviceSerialNumSize
+ *   See ktaSetDeviceInformation().
+ * @param[in,out] xpConnectionRequest
+ *   See ktaSetDeviceInformation().
+ *
+ * @return
+ *   See ktaSetDeviceInformation().
+ */
+TKStatus ktaSetDeviceInformationCtx
+(
+  TKtaContext*    xpContext,
+  const uint8_t*  xpDeviceProfilePublicUid,
+  size_t          xDeviceProfilePublicUidSize,
+  const uint8_t*  xpDeviceSerialNum,
+  size_t          xDeviceSerialNumSize,
+  uint8_t*        xpConnectionRequest
+);
+
+/**
+ * @brief
+ *   ktaExchangeMessage() for an instance, with the intermediate message buffers
+ *   carved from the workspace of its context.
+ *
+ * @param[in,out] xpContext
+ *   Instance initialized with ktaContextInit(). Should not be NULL.
+ * @param[in] xpKs2ktaMsg
+ *   See ktaExchangeMessage().
+ * @param[in] xKs2ktaMsgLen
+ *   See ktaExchangeMessage().
+ * @param[in,out] xpKta2ksMsg
+ *   See ktaExchangeMessage().
+ * @param[in,out] xpKta2ksMsgLen
+ *   See ktaExchangeMessage().
+ *
+ * @return
+ *   See ktaExchangeMessage().
+ */
+TKStatus ktaExchangeMessageCtx
+(
+  TKtaContext*    xpContext,
+  const uint8_t*  xpKs2ktaMsg,
+  size_t          xKs2ktaMsgLen,
+  uint8_t*        xpKta2ksMsg,
+  size_t*         xpKta2ksMsgLen
+);
+
+/**
+ * @brief
+ *   ktaGetWorkspacePeak() for an instance.
+ *
+ * @param[in] xpContext
+ *   Instance initialized with ktaContextInit(), NULL for the built-in one.
+ * @param[out] xpPeakSize
+ *   See ktaGetWorkspacePeak().
+ *
+ * @return
+ *   See ktaGetWorkspacePeak().
+ */
+TKStatus ktaGetWorkspacePeakCtx
+(
+  TKtaContext*  xpContext,
+  size_t*       xpPeakSize
+);
+
+/**
+ * @brief
+ *   ktaPrecompute() for an instance.
+ *
+ * @param[in,out] xpContext
+ *   Instance initialized with ktaContextInit(), NULL for the built-in one.
+ *
+ * @return
+ *   See ktaPrecompute().
+ */
+TKStatus ktaPrecomputeCtx
+(
+  TKtaContext*  xpContext
+);
+
+/**
+ * @brief
+ *   ktaKeyStreamStatus() for an instance.
+ *
+ * @param[in,out] xpContext
+ *   Instance initialized with ktaContextInit(), NULL for the built-in one.
+ * @param[in,out] xpKtaKSCmdStatus
+ *   See ktaKeyStreamStatus().
+ *
+ * @return
+ *   See ktaKeyStreamStatus().
+ */
+TKStatus ktaKeyStreamStatusCtx
+(
+  TKtaContext*           xpContext,
+  TKktaKeyStreamStatus*  xpKtaKSCmdStatus
+);
+
+/**
+ * @brief
+ *   ktaRevalidateLifeCycleState() for an instance.
+ *
+ * @param[in,out] xpContext
+ *   Instance initialized with ktaContextInit(), NULL for the built-in one.
+ */
+void ktaRevalidateLifeCycleStateCtx
+(
+  TKtaContext*  xpContext
+);
+
 #ifdef OBJECT_MANAGEMENT_FEATURE
 /**
  * @brief
@@ -416,6 +718,90 @@ TKStatus ktaSignHash
   uint32_t  xSignedHashOutBuffLen,
   size_t*   xpActualSignedHashOutLen
 );
+
+/**
+ * @brief
+ *   ktaGetObjectWithAssociation() for an instance.
+ *
+ * @param[in] xpContext
+ *   Instance initialized with ktaContextInit(), NULL for the built-in one.
+ * @param[in] xObjWithAssociationId
+ *   See ktaGetObjectWithAssociation().
+ * @param[in,out] xpAssociatedKeyId
+ *   See ktaGetObjectWithAssociation().
+ * @param[in,out] xpAssociatedObjId
+ *   See ktaGetObjectWithAssociation().
+ * @param[out] xpOutData
+ *   See ktaGetObjectWithAssociation().
+ * @param[in,out] xpOutDataLen
+ *   See ktaGetObjectWithAssociation().
+ *
+ * @return
+ *   See ktaGetObjectWithAssociation().
+ */
+TKStatus ktaGetObjectWithAssociationCtx
+(
+  TKtaContext*  xpContext,
+  uint32_t      xObjWithAssociationId,
+  uint32_t*     xpAssociatedKeyId,
+  uint32_t*     xpAssociatedObjId,
+  uint8_t*      xpOutData,
+  size_t*       xpOutDataLen
+);
+
+/**
+ * @brief
+ *   ktaGetObject() for an instance.
+ *
+ * @param[in] xpContext
+ *   Instance initialized with ktaContextInit(), NULL for the built-in one.
+ * @param[in] xIdentifier
+ *   See ktaGetObject().
+ * @param[in,out] xpObject
+ *   See ktaGetObject().
+ *
+ * @return
+ *   See ktaGetObject().
+ */
+TKStatus ktaGetObjectCtx
+(
+  TKtaContext*      xpContext,
+  uint32_t          xIdentifier,
+  TKktaDataObject * xpObject
+);
+
+/**
+ * @brief
+ *   ktaSignHash() for an instance.
+ *
+ * @param[in] xpContext
+ *   Instance initialized with ktaContextInit(), NULL for the built-in one.
+ * @param[in] xKeyId
+ *   See ktaSignHash().
+ * @param[in] xpHash
+ *   See ktaSignHash().
+ * @param[in] xHashLen
+ *   See ktaSignHash().
+ * @param[in,out] xpSignedHashOutBuff
+ *   See ktaSignHash().
+ * @param[in] xSignedHashOutBuffLen
+ *   See ktaSignHash().
+ * @param[out] xpActualSignedHashOutLen
+ *   See ktaSignHash().
+ *
+ * @return
+ *   See ktaSignHash().
+ */
+TKStatus ktaSignHashCtx
+(
+  TKtaContext*  xpContext,
+  uint32_t      xKeyId,
+  uint8_t*      xpHash,
+  size_t        xHashLen,
+  uint8_t*      xpSignedHashOutBuff,
+  uint32_t      xSignedHashOutBuffLen,
+  size_t*       xpActualSignedHashOutLen
+);
 #endif
 
 /**
@@ -445,6 +831,17 @@ TKStatus ktaKeyStreamStatus
   TKktaKeyStreamStatus*  xpKtaKSCmdStatus
 );
 
+/**
+ * @brief
+ *   Drop the RAM copies of the lifecycle state and of the storage records.
+ *   The next ktaExchangeMessage() call re-reads the lifecycle state from NVM
+ *   and handles a mismatch as a refurbish, e.g. after a tamper check.
+ */
+void ktaRevalidateLifeCycleState
+(
+  void
+);
+
 #ifdef TEST_COVERAGE
 void ktaReset
 (
@@ -0,0 +1,154 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief keySTREAM Trusted Agent - CRC32 checksum.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file k_crc32.h
+ ******************************************************************************/
+
+/**
+ * @brief keySTREAM Trusted Agent - CRC32 checksum.
+ *
+ * CRC-32 of IEEE 802.3 (reflected polynomial 0xEDB88320), as used by the FOTA
+ * records and the gateway backend frames. The kernel is selected at build
+ * time:
+ * - ARMv8 CRC32 instructions when __ARM_FEATURE_CRC32 is defined
+ *   (e.g. -march=armv8-a+crc),
+ * - x86 carry-less multiplication when __PCLMUL__ and __SSE4_1__ are defined
+ *   (e.g. -mpclmul -msse4.1), for buffers of 64 bytes and more,
+ * - slice-by-8 tables (8 KiB of constants) otherwise, or a single 1 KiB table
+ *   when KTA_CRC32_SMALL_TABLE is defined.
+ * KTA_CRC32_NO_HW disables the instruction based kernels.
+ */
+
+#ifndef K_CRC32_H
+#define K_CRC32_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include <stdint.h>
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                     */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Running CRC32 computation. */
+typedef struct
+{
+  uint32_t  value;
+  /* CRC register, pre-conditioned with all ones by ktaCrc32Init(). */
+} TKCrc32;
+
+/* -------------------------------------------------------------------------- */
+/* VARIABLES                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief
+ *   Start a CRC32 computation.
+ *
+ * @param[out] xpCrc
+ *   Running computation. Should not be NULL.
+ */
+void ktaCrc32Init
+(
+  TKCrc32*  xpCrc
+);
+
+/**
+ * @brief
+ *   Add data to a CRC32 computation; data can be fed in chunks of any size.
+ *
+ * @param[in,out] xpCrc
+ *   Running computation. Should not be NULL.
+ * @param[in] xpData
+ *   Data to add. Can be NULL if xDataLen is 0.
+ * @param[in] xDataLen
+ *   Length of xpData in bytes.
+ */
+void ktaCrc32Update
+(
+  TKCrc32*        xpCrc,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+);
+
+/**
+ * @brief
+ *   Get the CRC32 of the data added so far.
+ *
+ * @param[in] xpCrc
+ *   Running computation. Should not be NULL.
+ *
+ * @return
+ *   CRC32 value.
+ */
+uint32_t ktaCrc32Final
+(
+  const TKCrc32*  xpCrc
+);
+
+/**
+ * @brief
+ *   Compute the CRC32 of a buffer in one call.
+ *
+ * @param[in] xpData
+ *   Data. Can be NULL if xDataLen is 0.
+ * @param[in] xDataLen
+ *   Length of xpData in bytes.
+ *
+ * @return
+ *   CRC32 value.
+ */
+uint32_t ktaCrc32Compute
+(
+  const uint8_t*  xpData,
+  size_t          xDataLen
+);
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+#endif // K_CRC32_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
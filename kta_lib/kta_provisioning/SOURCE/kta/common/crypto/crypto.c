@@ -112,6 +112,45 @@ TKStatus ktacipherEncrypt
   return status;
 }
 
+/**
+ * @brief implement ktacipherEncryptAndSign
+ *
+ */
+TKStatus ktacipherEncryptAndSign
+(
+  uint8_t*       xpMsg,
+  size_t         xHeaderLen,
+  size_t         xClearMsgLen,
+  uint8_t*       xpComputedMac
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
+
+  M_KTALOG__START("Start");
+
+  if ((NULL == xpMsg) || (0u == xClearMsgLen) || (NULL == xpComputedMac))
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("Invalid parameter passed");
+  }
+  else
+  {
+    status = salCryptoAesEncHmac(C_K_KTA__VOLATILE_3_ID,
+                                 C_K_KTA__VOLATILE_2_ID,
+                                 xpMsg,
+                                 xHeaderLen,
+                                 xClearMsgLen,
+                                 xpComputedMac);
+    if (E_K_STATUS_OK != status)
+    {
+      M_KTALOG__ERR("AES Encryption and signing failed with status : %d", status);
+    }
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
 /**
  * @brief implement ktacipherSignMsg
  *
@@ -175,8 +214,11 @@ TKStatus ktacipherAddPadding
     }
     else
     {
-      /* Copying the original data for further padding. */
-      (void)memmove(xpPaddedData, xpData, xDataLength);
+      /* Copying the original data for further padding, nothing to copy when padding in place. */
+      if (xpPaddedData != xpData)
+      {
+        (void)memmove(xpPaddedData, xpData, xDataLength);
+      }
       /* Adding start of padding byte. */
       xpPaddedData[xDataLength] = C_K_CRYPTO__PAD_START_BYTE;
       for (size_t index = 1; index < paddingBytesAmount; index++)
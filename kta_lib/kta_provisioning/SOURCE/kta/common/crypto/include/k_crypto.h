@@ -97,6 +97,35 @@ TKStatus ktacipherEncrypt
   size_t*        xpEncryptedMsgLen
 );
 
+/**
+ * @brief
+ *   Encrypt the given message in place and sign its header and encrypted data in one pass.
+ *
+ * @param[in,out] xpMsg
+ *   [in] Header followed by the padded clear message.
+ *   [out] Header followed by the encrypted message.
+ * @param[in] xHeaderLen
+ *   Header length, signed but not encrypted.
+ * @param[in] xClearMsgLen
+ *   Padded clear message length, multiple of C_K_CRYPTO__AES_BLOCK_SIZE.
+ * @param[in,out] xpComputedMac
+ *   [in] Pointer to buffer to carry computed MAC.
+ *   [out] Actual MAC message.
+ *   Data must be at least C_K_KTA__HMAC_MAX_SIZE
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktacipherEncryptAndSign
+(
+  uint8_t*       xpMsg,
+  size_t         xHeaderLen,
+  size_t         xClearMsgLen,
+  uint8_t*       xpComputedMac
+);
+
 /**
  * @brief
  *   Decrypt the given encrypted message.
@@ -179,7 +208,7 @@ TKStatus ktacipherVerifySignedMsg
  *   Add padding to data buffer.
  *
  * @param[in] xpData
- *   Non padded buffer.
+ *   Non padded buffer, may be xpPaddedData to pad in place.
  * @param[in] xDataLength
  *   Non padded buffer length.
  * @param[inout] xpPaddedData
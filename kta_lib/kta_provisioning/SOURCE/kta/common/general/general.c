@@ -97,7 +97,6 @@ TKStatus ktaGenerateResponse
 {
   TKStatus status = E_K_STATUS_ERROR;
   uint8_t  totSteps;
-  uint8_t  aComputedMac[C_K_KTA__HMAC_MAX_SIZE] = {0};
   /* Not initialised these variable to 0 as bitmap step is coherent */
   size_t   serializedMsgLen = C_K__ICPP_MSG_MAX_SIZE;
   size_t   serializedPaddedMsgLen = C_K__ICPP_MSG_MAX_SIZE;
@@ -162,6 +161,7 @@ TKStatus ktaGenerateResponse
       goto end;
     }
 
+    /* Padding is written in place, right after the serialized message. */
     status = ktacipherAddPadding(&xpMessageToSend[C_K_ICPP_PARSER__HEADER_SIZE],
                                 serializedMsgLen - C_K_ICPP_PARSER__HEADER_SIZE,
                                 &xpMessageToSend[C_K_ICPP_PARSER__HEADER_SIZE],
@@ -174,11 +174,11 @@ TKStatus ktaGenerateResponse
     }
   }
 
-  totSteps = xTotalCodedSteps & C_GEN__ENCRYPT;
+  totSteps = xTotalCodedSteps & (C_GEN__ENCRYPT | C_GEN__SIGNING);
 
-  if (C_GEN__ENCRYPT == totSteps)
+  if ((C_GEN__ENCRYPT | C_GEN__SIGNING) == totSteps)
   {
-    /* Encrypt data. */
+    /* Encrypt data and calculate signature of the header and encrypted data in one pass. */
     // REQ RQ_M-KTA-REGT-FN-0050(1) : Encrypt the padded registeration info message
     // REQ RQ_M-KTA-OBJM-FN-0130(1) : Encrypt the padded Generate key pair message
     // REQ RQ_M-KTA-OBJM-FN-0330(1) : Encrypt the padded set object message
@@ -186,16 +186,16 @@ TKStatus ktaGenerateResponse
     // REQ RQ_M-KTA-OBJM-FN-0830(1) : Encrypt the padded set object with association message
     // REQ RQ_M-KTA-OBJM-FN-1030(2) : Encrypt the padded delete key object message
     // REQ RQ_M-KTA-TRDP-FN-0140(1) : Encrypt the padded Third party response message
-    status = ktacipherEncrypt(&xpMessageToSend[C_K_ICPP_PARSER__HEADER_SIZE],
-                              serializedPaddedMsgLen,
-                              &xpMessageToSend[C_K_ICPP_PARSER__HEADER_SIZE],
-                              &encMsgLen);
+    // REQ RQ_M-KTA-REGT-FN-0060(1) : Sign the encrypted registeration info message
+    // REQ RQ_M-KTA-OBJM-FN-0140(1) : Sign the encrypted Generate key pair message
+    // REQ RQ_M-KTA-OBJM-FN-0340(1) : Sign the encrypted set object message
+    // REQ RQ_M-KTA-OBJM-FN-0640(1) : Sign the encrypted delete object message
+    // REQ RQ_M-KTA-OBJM-FN-0840(1) : Sign the encrypted set object with association message
+    // REQ RQ_M-KTA-OBJM-FN-1040(2) : Sign the encrypted delete key object message
+    // REQ RQ_M-KTA-TRDP-FN-0150(1) : Sign the encrypted Third party response message
 
-    if (E_K_STATUS_OK != status)
-    {
-      M_KTALOG__ERR("Kta cipher encryption of message failed, status = [%d]", status);
-      goto end;
-    }
+    /* AES-CBC keeps the padded length, the header is final before the first block is signed. */
+    encMsgLen = serializedPaddedMsgLen;
 
     if (E_K_ICPP_PARSER_STATUS_OK !=
         ktaIcppParserSetHeaderLength(xpMessageToSend, encMsgLen + C_K_KTA__HMAC_MAX_SIZE))
@@ -204,33 +204,18 @@ TKStatus ktaGenerateResponse
       status = E_K_STATUS_ERROR;
       goto end;
     }
-  }
 
-  totSteps = xTotalCodedSteps & C_GEN__SIGNING;
-
-  if (C_GEN__SIGNING == totSteps)
-  {
-    /* Calculate signature of data. */
-    // REQ RQ_M-KTA-REGT-FN-0060(1) : Sign the encrypted registeration info message
-    // REQ RQ_M-KTA-OBJM-FN-0140(1) : Sign the encrypted Generate key pair message
-    // REQ RQ_M-KTA-OBJM-FN-0340(1) : Sign the encrypted set object message
-    // REQ RQ_M-KTA-OBJM-FN-0640(1) : Sign the encrypted delete object message
-    // REQ RQ_M-KTA-OBJM-FN-0840(1) : Sign the encrypted set object with association message
-    // REQ RQ_M-KTA-OBJM-FN-1040(2) : Sign the encrypted delete key object message
-    // REQ RQ_M-KTA-TRDP-FN-0150(1) : Sign the encrypted Third party response message
-    status = ktacipherSignMsg(xpMessageToSend,
-                              encMsgLen + C_K_ICPP_PARSER__HEADER_SIZE,
-                              aComputedMac);
+    status = ktacipherEncryptAndSign(xpMessageToSend,
+                                     C_K_ICPP_PARSER__HEADER_SIZE,
+                                     serializedPaddedMsgLen,
+                                     &xpMessageToSend[encMsgLen + C_K_ICPP_PARSER__HEADER_SIZE]);
 
     if (E_K_STATUS_OK != status)
     {
-      M_KTALOG__ERR("Kta cipher signing of message failed, status = [%d]", status);
+      M_KTALOG__ERR("Kta cipher encryption and signing of message failed, status = [%d]", status);
       goto end;
     }
 
-    (void)memcpy(&xpMessageToSend[encMsgLen + C_K_ICPP_PARSER__HEADER_SIZE],
-                aComputedMac,
-                C_K_KTA__HMAC_MAX_SIZE);
     *xpMessageToSendSize = encMsgLen + C_K_ICPP_PARSER__HEADER_SIZE + C_K_KTA__HMAC_MAX_SIZE;
   }
 
@@ -241,6 +226,75 @@ end:
   return status;
 }
 
+/**
+ * @brief implement ktaArenaInit
+ *
+ */
+void ktaArenaInit
+(
+  TKtaArena*  xpArena,
+  void*       xpBuffer,
+  size_t      xSize
+)
+{
+  xpArena->pBuffer = (uint8_t*)xpBuffer;
+  xpArena->size = (NULL == xpBuffer) ? 0u : xSize;
+  xpArena->used = 0u;
+  xpArena->peak = 0u;
+}
+
+/**
+ * @brief implement ktaArenaAlloc
+ *
+ */
+void* ktaArenaAlloc
+(
+  TKtaArena*  xpArena,
+  size_t      xSize
+)
+{
+  size_t   blockSize = M_GEN__ARENA_BLOCK_SIZE(xSize);
+  uint8_t* pBlock = NULL;
+
+  if ((NULL == xpArena) || (0u == xSize) || (blockSize > (xpArena->size - xpArena->used)))
+  {
+    M_KTALOG__ERR("Workspace exhausted, %u bytes requested", (unsigned int)xSize);
+  }
+  else
+  {
+    pBlock = &xpArena->pBuffer[xpArena->used];
+    xpArena->used += blockSize;
+
+    if (xpArena->used > xpArena->peak)
+    {
+      xpArena->peak = xpArena->used;
+    }
+
+    (void)memset(pBlock, 0, xSize);
+  }
+
+  return pBlock;
+}
+
+/**
+ * @brief implement ktaArenaRelease
+ *
+ */
+void ktaArenaRelease
+(
+  TKtaArena*   xpArena,
+  const void*  xpBlock
+)
+{
+  const uint8_t* pBlock = (const uint8_t*)xpBlock;
+
+  if ((NULL != xpArena) && (NULL != pBlock) &&
+      (pBlock >= xpArena->pBuffer) && (pBlock < &xpArena->pBuffer[xpArena->size]))
+  {
+    xpArena->used = (size_t)(pBlock - xpArena->pBuffer);
+  }
+}
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
 /* -------------------------------------------------------------------------- */
@@ -68,6 +68,26 @@ extern "C" {
 /** @brief Sign the data. */
 #define C_GEN__SIGNING   (8u)
 
+/** @brief Alignment of the blocks carved from a workspace arena, in bytes. */
+#define C_GEN__ARENA_ALIGNMENT  (8u)
+
+/** @brief Size of an arena block once rounded up to C_GEN__ARENA_ALIGNMENT. */
+#define M_GEN__ARENA_BLOCK_SIZE(x_size) \
+  ((((size_t)(x_size)) + (C_GEN__ARENA_ALIGNMENT - 1u)) & ~((size_t)C_GEN__ARENA_ALIGNMENT - 1u))
+
+/** @brief Scratch arena carved from the workspace given to ktaExchangeMessageEx(). */
+typedef struct
+{
+  /** Workspace base, aligned on C_GEN__ARENA_ALIGNMENT. */
+  uint8_t*  pBuffer;
+  /** Workspace size in bytes. */
+  size_t    size;
+  /** Bytes currently carved. */
+  size_t    used;
+  /** Highest value reached by used since ktaArenaInit(). */
+  size_t    peak;
+} TKtaArena;
+
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
 /* -------------------------------------------------------------------------- */
@@ -107,6 +127,59 @@ TKStatus ktaGenerateResponse
   size_t*                      xpMessageToSendSize
 );
 
+/**
+ * @brief
+ *   Attach an arena to a caller provided workspace.
+ *
+ * @param[out] xpArena
+ *   Arena to initialize. Should not be NULL.
+ * @param[in] xpBuffer
+ *   Workspace, aligned on C_GEN__ARENA_ALIGNMENT.
+ * @param[in] xSize
+ *   Workspace size in bytes.
+ */
+void ktaArenaInit
+(
+  TKtaArena*  xpArena,
+  void*       xpBuffer,
+  size_t      xSize
+);
+
+/**
+ * @brief
+ *   Carve a zeroed block from the arena.
+ *   Blocks are released in reverse order of allocation with ktaArenaRelease().
+ *
+ * @param[in,out] xpArena
+ *   Arena to carve from.
+ * @param[in] xSize
+ *   Block size in bytes.
+ *
+ * @return
+ * - Block aligned on C_GEN__ARENA_ALIGNMENT.
+ * - NULL if the arena is missing or exhausted.
+ */
+void* ktaArenaAlloc
+(
+  TKtaArena*  xpArena,
+  size_t      xSize
+);
+
+/**
+ * @brief
+ *   Give back a block and every block carved after it.
+ *
+ * @param[in,out] xpArena
+ *   Arena the block was carved from.
+ * @param[in] xpBlock
+ *   Block returned by ktaArenaAlloc(), NULL is ignored.
+ */
+void ktaArenaRelease
+(
+  TKtaArena*   xpArena,
+  const void*  xpBlock
+);
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
@@ -158,24 +158,42 @@ static const char* gpModuleName = "KTAICPPPARSER";
  *
  */
 #define M_K_ICPP_PARSER_GET_COMMAND_LENGTH(x_cmdTag)   \
-  (((x_cmdTag) >= C_K_ICPP__1BYTE_START_WITH_FILED_RANGE_CMD_TAG) && \
-   ((x_cmdTag) <= C_K_ICPP__1BYTE_END_WITHOUT_FILED_RANGE_CMD_TAG) ? 1u : 2u)
+  (((gaIcppParserTagInfo[(uint8_t)(x_cmdTag)] & C_K_ICPP_PARSER__TAG_INFO_CMD_LEN_2BYTE) != 0u) ? \
+   2u : 1u)
 
 /**
- * @brief Get the field length for one 1 byte.
+ * @brief Get the field length in bytes.
  *
  * @param[in] x_fieldTag Field tag.
  *
  */
-#define M_K_ICPP_PARSER_GET_1_BYTE_FIELD_LENGTH(x_fieldTag)   (1u)
+#define M_K_ICPP_PARSER_GET_FIELD_LENGTH(x_fieldTag)   \
+  (((gaIcppParserTagInfo[(uint8_t)(x_fieldTag)] & C_K_ICPP_PARSER__TAG_INFO_FIELD_LEN_2BYTE) != 0u) ? \
+   2u : 1u)
 
 /**
- * @brief Get the field length for two bytes.
+ * @brief Tag information of a command tag, derived from the tag ranges.
  *
- * @param[in] x_fieldTag Field tag.
+ * @param[in] x_cmdTag Command tag.
  *
  */
-#define M_K_ICPP_PARSER_GET_2_BYTE_FIELD_LENGTH(x_fieldTag)   (2u)
+#define M_K_ICPP_PARSER_COMMAND_TAG_INFO(x_cmdTag)   \
+  (C_K_ICPP_PARSER__TAG_INFO_COMMAND | \
+   ((((x_cmdTag) >= C_K_ICPP__2BYTE_START_WITH_FILED_RANGE_CMD_TAG) && \
+     ((x_cmdTag) <= C_K_ICPP__2BYTE_END_WITHOUT_FILED_RANGE_CMD_TAG)) ? \
+    C_K_ICPP_PARSER__TAG_INFO_CMD_LEN_2BYTE : 0u) | \
+   (((((x_cmdTag) >= C_K_ICPP__1BYTE_START_WITH_FILED_RANGE_CMD_TAG) && \
+      ((x_cmdTag) <= C_K_ICPP__1BYTE_END_WITH_FILED_RANGE_CMD_TAG)) || \
+     (((x_cmdTag) >= C_K_ICPP__2BYTE_START_WITH_FILED_RANGE_CMD_TAG) && \
+      ((x_cmdTag) <= C_K_ICPP__2BYTE_END_WITH_FILED_RANGE_CMD_TAG))) ? \
+    C_K_ICPP_PARSER__TAG_INFO_CMD_HAS_FIELDS : 0u))
+
+/** @brief Tag information of a field tag with 1 byte length. */
+#define C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO   (C_K_ICPP_PARSER__TAG_INFO_FIELD)
+
+/** @brief Tag information of a field tag with 2 bytes length. */
+#define C_K_ICPP_PARSER_FIELD_2BYTE_TAG_INFO   \
+  (C_K_ICPP_PARSER__TAG_INFO_FIELD | C_K_ICPP_PARSER__TAG_INFO_FIELD_LEN_2BYTE)
 
 /** @brief ICPP Tag related enum. */
 typedef enum
@@ -198,76 +216,6 @@ typedef enum
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
 
-/* Compact lookup table for valid command tags - saves .rodata vs switch */
-static const uint8_t gCommandTags[] = {
-  E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT,
-  E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT,
-  E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE,
-  E_K_ICPP_PARSER_COMMAND_TAG_PROCESSING_STATUS,
-  E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR,
-  E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION,
-  E_K_ICPP_PARSER_COMMAND_TAG_REGISTERATION_INFO,
-  E_K_ICPP_PARSER_COMMAND_TAG_DEVICE_INFO,
-  E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR,
-  E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT,
-  E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION,
-#ifdef FOTA_ENABLE
-  E_K_ICPP_PARSER_CMD_TAG_INSTALL_FOTA,
-  E_K_ICPP_PARSER_CMD_TAG_GET_FOTA_STATUS,
-#endif
-  E_K_ICPP_PARSER_COMMAND_TAG_THIRD_PARTY
-};
-
-#define C_COMMAND_TAGS_COUNT (sizeof(gCommandTags) / sizeof(gCommandTags[0]))
-
-/* Compact lookup table for 1-byte field tags */
-static const uint8_t gField1ByteTags[] = {
-  E_K_ICPP_PARSER_FIELD_TAG_ACK_SEQ_CNT,
-  E_K_ICPP_PARSER_FIELD_TAG_DEVPROFUID,
-  E_K_ICPP_PARSER_FIELD_TAG_MUTABLE_DEVPROFUID,
-  E_K_ICPP_PARSER_FIELD_TAG_KTA_VER,
-  E_K_ICPP_PARSER_FIELD_TAG_DEV_SERIAL_NO,
-  E_K_ICPP_PRSR_FLD_TAG_KTA_CTX_VER,
-  E_K_ICPP_PARSER_FLD_TAG_KTA_CTX_SERIAL_NO,
-  E_K_ICPP_PARSER_FIELD_TAG_KTA_CTX_PRO_UID,
-  E_K_ICPP_PRSR_FLD_TAG_CMD_OBJECT_OWNER,
-  E_K_ICPP_PARSER_FIELD_TAG_ROT_SOL_ID,
-  E_K_ICPP_PARSER_FIELD_TAG_CHIP_UID,
-  E_K_ICPP_PARSER_FLD_TAG_KTA_CAPABILITY,
-  E_K_ICPP_PARSER_FLD_TAG_KTA_NONCE,
-  E_K_ICPP_PARSER_FLD_TAG_CMD_IDENTIFIER,
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_ATTRIBUTES,
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_TYPE,
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_ASSOCIATION_INFO,
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_UID,
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_CUSTOMER_METADATA,
-  E_K_ICPP_PARSER_FIELD_TAG_CHALLENGE,
-#ifdef FOTA_ENABLE
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA,
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_METADATA,
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET,
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION,
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CODE,
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CAUSE,
-#endif
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS,
-  E_K_ICPP_PARSER_FIELD_TAG_ROT_PUBLIC_UID
-};
-
-/* Compact lookup table for 2-byte field tags */
-static const uint8_t gField2ByteTags[] = {
-  E_K_ICPP_PARSER_FLD_TAG_CHIP_CERT,
-  E_K_ICPP_PARSER_FIELD_TAG_ROT_E_PK,
-  E_K_ICPP_PARSER_FIELD_TAG_KS_E_PK,
-  E_K_ICPP_PARSER_FIELD_TAG_SIGNED_PUB_KEY,
-  E_K_ICPP_PARSER_FLD_TAG_CMD_PUBLIC_KEY,
-  E_K_ICPP_PARSER_FLD_TAG_CMD_DATA,
-  E_K_ICPP_PARSER_FLD_TAG_CHIP_ATTEST_CERT,
-#ifdef FOTA_ENABLE
-  E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_URL
-#endif
-};
-
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
@@ -432,7 +380,7 @@ static TKParserStatus lIcppParserSerializeCommands
   *   ICPP message buffer.
   * @param[in] xReceivedMessageSize
   *   Length of ICPP message buffer.
-  * @param[in,out] xpIcppMessage
+  * @param[in,out] xpView
   *   [in] Pointer to structure carrying header
   *   [out] Actual strcuture carrying deserialized header.
   *
@@ -445,12 +393,284 @@ static TKParserStatus lIcppParserDeserializeHeader
 (
   const uint8_t*          xpReceivedMessage,
   const size_t            xReceivedMessageSize,
-  TKIcppProtocolMessage*  xpIcppMessage
+  TKIcppMessageView*      xpView
+);
+
+/**
+  * @brief Copy the deserialized header of a view to a message structure.
+  *
+  * @param[in] xpView
+  *   View carrying the header.
+  * @param[out] xpIcppMessage
+  *   Message structure to fill.
+  */
+static void lIcppParserCopyHeader
+(
+  const TKIcppMessageView*  xpView,
+  TKIcppProtocolMessage*    xpIcppMessage
+);
+
+/**
+  * @brief Check one command or field and get the size of its parts.
+  *
+  * @param[in] xpData
+  *   Buffer starting with the tag.
+  * @param[in] xDataSize
+  *   Bytes available in the buffer.
+  * @param[in] xTagType
+  *   Tag type.
+  * @param[out] xpHeaderSize
+  *   Size of the tag and length.
+  * @param[out] xpValueSize
+  *   Size of the value.
+  *
+  * @return
+  * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+  * - E_K_ICPP_PARSER_STATUS_ERROR for invalid tag or length.
+  */
+static TKParserStatus lIcppParserGetItem
+(
+  const uint8_t*       xpData,
+  size_t               xDataSize,
+  const TKIcppTagType  xTagType,
+  size_t*              xpHeaderSize,
+  size_t*              xpValueSize
+);
+
+/**
+  * @brief Check the fields of a command and count them.
+  *
+  * @param[in] xpFields
+  *   Command value.
+  * @param[in] xFieldsSize
+  *   Command value length.
+  * @param[out] xpFieldsCount
+  *   Number of fields.
+  * @param[out] xpCommand
+  *   Command whose field presence and offsets are filled, NULL to only count.
+  *
+  * @return
+  * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+  * - E_K_ICPP_PARSER_STATUS_ERROR for invalid fields.
+  */
+static TKParserStatus lIcppParserCountFields
+(
+  const uint8_t*      xpFields,
+  size_t              xFieldsSize,
+  size_t*             xpFieldsCount,
+  TKIcppCommandView*  xpCommand
+);
+
+/**
+  * @brief Check the protocol version, message type and encryption mode of a header.
+  *
+  * @param[in] xpHeader
+  *   ICPP header, C_K_ICPP_PARSER__HEADER_SIZE bytes.
+  *
+  * @return
+  * - E_K_ICPP_PARSER_STATUS_OK for a supported header.
+  * - E_K_ICPP_PARSER_STATUS_PARAMETER otherwise.
+  */
+static TKParserStatus lIcppParserCheckHeader
+(
+  const uint8_t*  xpHeader
+);
+
+/**
+  * @brief Report an event to the streaming deserializer handler.
+  *
+  * @param[in,out] xpStream
+  *   Deserializer context.
+  * @param[in] xEventType
+  *   Type of event.
+  * @param[in] xTag
+  *   Command or field tag.
+  * @param[in] xLength
+  *   Length of the item or value part.
+  * @param[in] xpValue
+  *   Value part or raw header.
+  *
+  * @return
+  * - Status returned by the handler.
+  */
+static TKParserStatus lIcppParserStreamEmit
+(
+  TKIcppParserStream*    xpStream,
+  TKIcppParserEventType  xEventType,
+  uint32_t               xTag,
+  size_t                 xLength,
+  const uint8_t*         xpValue
+);
+
+/**
+  * @brief Process one byte of a command or field tag or length.
+  *
+  * @param[in,out] xpStream
+  *   Deserializer context.
+  * @param[in] xByte
+  *   Received byte.
+  *
+  * @return
+  * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+  * - E_K_ICPP_PARSER_STATUS_NO_OPERATION, E_K_ICPP_PARSER_STATUS_NOTIFICATION_CPERROR
+  *   when the message ends.
+  * - E_K_ICPP_PARSER_STATUS_ERROR for invalid message.
+  */
+static TKParserStatus lIcppParserStreamByte
+(
+  TKIcppParserStream*  xpStream,
+  uint8_t              xByte
+);
+
+/**
+  * @brief Move to the next item once a value, or an empty one, is complete.
+  *
+  * @param[in,out] xpStream
+  *   Deserializer context.
+  *
+  * @return
+  * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+  * - E_K_ICPP_PARSER_STATUS_NOTIFICATION_CPERROR after a command processing error command.
+  * - Status returned by the handler.
+  */
+static TKParserStatus lIcppParserStreamValueEnd
+(
+  TKIcppParserStream*  xpStream
 );
 
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
 /* -------------------------------------------------------------------------- */
+/**
+ * Tag information table: one lookup classifies any tag byte. Tags 0x92 and
+ * 0xB0 are both a command and a field tag.
+ */
+const uint8_t gaIcppParserTagInfo[C_K_ICPP_PARSER__TAG_INFO_COUNT] =
+{
+  /* Command tags. */
+  [E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT),
+  [E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT),
+  [E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE),
+  [E_K_ICPP_PARSER_COMMAND_TAG_PROCESSING_STATUS] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_COMMAND_TAG_PROCESSING_STATUS),
+  [E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR),
+  [E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION),
+  [E_K_ICPP_PARSER_COMMAND_TAG_REGISTERATION_INFO] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_COMMAND_TAG_REGISTERATION_INFO),
+  [E_K_ICPP_PARSER_COMMAND_TAG_DEVICE_INFO] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_COMMAND_TAG_DEVICE_INFO),
+  [E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR),
+  [E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT),
+#ifdef FOTA_ENABLE
+  [E_K_ICPP_PARSER_CMD_TAG_INSTALL_FOTA] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_CMD_TAG_INSTALL_FOTA),
+  [E_K_ICPP_PARSER_CMD_TAG_GET_FOTA_STATUS] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_CMD_TAG_GET_FOTA_STATUS),
+#endif
+
+  /* Command and field tags. */
+  [E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION) |
+    C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_COMMAND_TAG_THIRD_PARTY] =
+    M_K_ICPP_PARSER_COMMAND_TAG_INFO(E_K_ICPP_PARSER_COMMAND_TAG_THIRD_PARTY) |
+    C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+
+  /* Field tags with 1 byte length. */
+  [E_K_ICPP_PARSER_FIELD_TAG_DEVPROFUID] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_MUTABLE_DEVPROFUID] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_KTA_VER] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_DEV_SERIAL_NO] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PRSR_FLD_TAG_KTA_CTX_VER] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FLD_TAG_KTA_CTX_SERIAL_NO] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_KTA_CTX_PRO_UID] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PRSR_FLD_TAG_CMD_OBJECT_OWNER] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_ROT_SOL_ID] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CHIP_UID] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FLD_TAG_KTA_CAPABILITY] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FLD_TAG_KTA_NONCE] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_ATTRIBUTES] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_TYPE] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_ASSOCIATION_INFO] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_UID] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_CUSTOMER_METADATA] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CHALLENGE] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+#ifdef FOTA_ENABLE
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_METADATA] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CODE] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CAUSE] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+#endif
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_ROT_PUBLIC_UID] = C_K_ICPP_PARSER_FIELD_1BYTE_TAG_INFO,
+
+  /* Field tags with 2 bytes length. */
+  [E_K_ICPP_PARSER_FLD_TAG_CHIP_CERT] = C_K_ICPP_PARSER_FIELD_2BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_ROT_E_PK] = C_K_ICPP_PARSER_FIELD_2BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_KS_E_PK] = C_K_ICPP_PARSER_FIELD_2BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FIELD_TAG_SIGNED_PUB_KEY] = C_K_ICPP_PARSER_FIELD_2BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FLD_TAG_CMD_PUBLIC_KEY] = C_K_ICPP_PARSER_FIELD_2BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FLD_TAG_CMD_DATA] = C_K_ICPP_PARSER_FIELD_2BYTE_TAG_INFO,
+  [E_K_ICPP_PARSER_FLD_TAG_CHIP_ATTEST_CERT] = C_K_ICPP_PARSER_FIELD_2BYTE_TAG_INFO,
+#ifdef FOTA_ENABLE
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_URL] = C_K_ICPP_PARSER_FIELD_2BYTE_TAG_INFO,
+#endif
+};
+
+/**
+ * Field slot table: maps a field tag to its slot in the presence bitmap and
+ * field offsets of a command view.
+ */
+const uint8_t gaIcppParserFieldSlot[C_K_ICPP_PARSER__TAG_INFO_COUNT] =
+{
+  [E_K_ICPP_PARSER_FIELD_TAG_DEVPROFUID] = E_K_ICPP_PARSER_FIELD_SLOT_DEVPROFUID,
+  [E_K_ICPP_PARSER_FIELD_TAG_MUTABLE_DEVPROFUID] = E_K_ICPP_PARSER_FIELD_SLOT_MUTABLE_DEVPROFUID,
+  [E_K_ICPP_PARSER_FIELD_TAG_ROT_SOL_ID] = E_K_ICPP_PARSER_FIELD_SLOT_ROT_SOL_ID,
+  [E_K_ICPP_PARSER_FIELD_TAG_CHIP_UID] = E_K_ICPP_PARSER_FIELD_SLOT_CHIP_UID,
+  [E_K_ICPP_PARSER_FIELD_TAG_ROT_PUBLIC_UID] = E_K_ICPP_PARSER_FIELD_SLOT_ROT_PUBLIC_UID,
+  [E_K_ICPP_PARSER_FLD_TAG_CHIP_CERT] = E_K_ICPP_PARSER_FIELD_SLOT_CHIP_CERT,
+  [E_K_ICPP_PARSER_FIELD_TAG_ROT_E_PK] = E_K_ICPP_PARSER_FIELD_SLOT_ROT_E_PK,
+  [E_K_ICPP_PARSER_FIELD_TAG_SIGNED_PUB_KEY] = E_K_ICPP_PARSER_FIELD_SLOT_SIGNED_PUB_KEY,
+  [E_K_ICPP_PARSER_FLD_TAG_CHIP_ATTEST_CERT] = E_K_ICPP_PARSER_FIELD_SLOT_CHIP_ATTEST_CERT,
+  [E_K_ICPP_PARSER_FIELD_TAG_ACK_SEQ_CNT] = E_K_ICPP_PARSER_FIELD_SLOT_ACK_SEQ_CNT,
+  [E_K_ICPP_PARSER_FLD_TAG_KTA_CAPABILITY] = E_K_ICPP_PARSER_FIELD_SLOT_KTA_CAPABILITY,
+  [E_K_ICPP_PARSER_FLD_TAG_KTA_NONCE] = E_K_ICPP_PARSER_FIELD_SLOT_KTA_NONCE,
+  [E_K_ICPP_PARSER_FIELD_TAG_KTA_CTX_PRO_UID] = E_K_ICPP_PARSER_FIELD_SLOT_KTA_CTX_PRO_UID,
+  [E_K_ICPP_PARSER_FLD_TAG_KTA_CTX_SERIAL_NO] = E_K_ICPP_PARSER_FIELD_SLOT_KTA_CTX_SERIAL_NO,
+  [E_K_ICPP_PRSR_FLD_TAG_KTA_CTX_VER] = E_K_ICPP_PARSER_FIELD_SLOT_KTA_CTX_VER,
+  [E_K_ICPP_PARSER_FIELD_TAG_KTA_VER] = E_K_ICPP_PARSER_FIELD_SLOT_KTA_VER,
+  [E_K_ICPP_PARSER_FIELD_TAG_DEV_SERIAL_NO] = E_K_ICPP_PARSER_FIELD_SLOT_DEV_SERIAL_NO,
+  [E_K_ICPP_PARSER_FIELD_TAG_KS_E_PK] = E_K_ICPP_PARSER_FIELD_SLOT_KS_E_PK,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_TYPE] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_TYPE,
+  [E_K_ICPP_PARSER_FLD_TAG_CMD_IDENTIFIER] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_IDENTIFIER,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_ATTRIBUTES] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_ATTRIBUTES,
+  [E_K_ICPP_PARSER_FLD_TAG_CMD_DATA] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_DATA,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_ASSOCIATION_INFO] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_ASSOCIATION_INFO,
+  [E_K_ICPP_PRSR_FLD_TAG_CMD_OBJECT_OWNER] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_OWNER,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_UID] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_UID,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_CUSTOMER_METADATA] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_CUSTOMER_METADATA,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_PROCESSING_STATUS,
+  [E_K_ICPP_PARSER_FIELD_TAG_CHALLENGE] = E_K_ICPP_PARSER_FIELD_SLOT_CHALLENGE,
+  [E_K_ICPP_PARSER_FLD_TAG_CMD_PUBLIC_KEY] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_PUBLIC_KEY,
+#ifdef FOTA_ENABLE
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_METADATA] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_METADATA,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_COMPONENT_TARGET,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_COMPONENT_VERSION,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_URL] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_COMPONENT_URL,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CODE] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_ERROR_CODE,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CAUSE] = E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_ERROR_CAUSE,
+#endif
+};
 
 /* -------------------------------------------------------------------------- */
 /* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
@@ -555,8 +775,9 @@ TKParserStatus ktaIcppParserDeserializeMessage
   TKIcppProtocolMessage*  xpIcppMessage
 )
 {
-  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_ERROR;
-  uint32_t        curPosition = C_K_ICPP_PARSER__HEADER_SIZE;
+  TKParserStatus     status = E_K_ICPP_PARSER_STATUS_ERROR;
+  uint32_t           curPosition = C_K_ICPP_PARSER__HEADER_SIZE;
+  TKIcppMessageView  view;
 
   M_KTALOG__START("Start");
 
@@ -569,7 +790,11 @@ TKParserStatus ktaIcppParserDeserializeMessage
   else
   {
     // REQ RQ_M-KTA-NOOP-FN-0030(1) : Deserialize the decrypted No operation message data
-    status = lIcppParserDeserializeHeader(xpReceivedMessage, xReceivedMessageSize, xpIcppMessage);
+    status = lIcppParserDeserializeHeader(xpReceivedMessage, xReceivedMessageSize, &view);
+    if (E_K_ICPP_PARSER_STATUS_PARAMETER != status)
+    {
+      lIcppParserCopyHeader(&view, xpIcppMessage);
+    }
 
     if (E_K_ICPP_PARSER_STATUS_NO_OPERATION == status)
     {
@@ -608,7 +833,8 @@ TKParserStatus ktaIcppParserDeserializeHeader
   TKIcppProtocolMessage*  xpIcppMessage
 )
 {
-  TKParserStatus  status  = E_K_ICPP_PARSER_STATUS_ERROR;
+  TKParserStatus     status  = E_K_ICPP_PARSER_STATUS_ERROR;
+  TKIcppMessageView  view;
 
   M_KTALOG__START("Start");
 
@@ -621,7 +847,11 @@ TKParserStatus ktaIcppParserDeserializeHeader
   {
     M_KTALOG__DEBUG("[ktaIcppParserDeserializeHeader] Start");
     // REQ RQ_M-KTA-ICPP-FN-0170(1) : Deserialize ICPP Header
-    status = lIcppParserDeserializeHeader(xpReceivedMessage, xReceivedMessageSize, xpIcppMessage);
+    status = lIcppParserDeserializeHeader(xpReceivedMessage, xReceivedMessageSize, &view);
+    if (E_K_ICPP_PARSER_STATUS_PARAMETER != status)
+    {
+      lIcppParserCopyHeader(&view, xpIcppMessage);
+    }
   }
 
   M_KTALOG__END("End, status : %d", status);
@@ -701,74 +931,443 @@ TKParserStatus ktaIcppParserSetHeaderLength
   return status;
 }
 
-/* -------------------------------------------------------------------------- */
-/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
-/* -------------------------------------------------------------------------- */
-
 /**
- * @brief Check if tag exists in command tag table
+ * @brief implement ktaIcppParserDeserializeView
+ *
  */
-static TKParserStatus lCheckCommandTag
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+TKParserStatus ktaIcppParserDeserializeView
 (
-  const uint32_t  xTag,
-  uint32_t*       xpTagLen
+  const uint8_t*      xpReceivedMessage,
+  const size_t        xReceivedMessageSize,
+  TKIcppMessageView*  xpView
 )
 {
-  /* Linear search through command tag table - much smaller than switch lookup table */
-  for (uint32_t i = 0; i < C_COMMAND_TAGS_COUNT; i++)
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_ERROR;
+  const uint8_t*  pCommands = NULL;
+  size_t          commandsSize = 0;
+  size_t          curPosition = 0;
+  size_t          headerSize = 0;
+  size_t          commandLength = 0;
+  size_t          fieldsCount = 0;
+  TKIcppCommandTag commandTag;
+
+  M_KTALOG__START("Start");
+
+  if ((NULL == xpReceivedMessage) || (NULL == xpView) || (0u == xReceivedMessageSize))
+  {
+    M_KTALOG__ERR("Invalid parameters");
+    status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+    goto end;
+  }
+
+  (void)memset(xpView, 0, sizeof(TKIcppMessageView));
+
+  // REQ RQ_M-KTA-NOOP-FN-0030(1) : Deserialize the decrypted No operation message data
+  status = lIcppParserDeserializeHeader(xpReceivedMessage, xReceivedMessageSize, xpView);
+  if (E_K_ICPP_PARSER_STATUS_OK != status)
+  {
+    M_KTALOG__DEBUG("Header status %d", status);
+    goto end;
+  }
+
+  pCommands = &xpReceivedMessage[C_K_ICPP_PARSER__HEADER_SIZE];
+  commandsSize = xReceivedMessageSize - C_K_ICPP_PARSER__HEADER_SIZE;
+  xpView->pCommands = pCommands;
+  xpView->commandsSize = commandsSize;
+
+  /* Same checks as the structure deserializer, nothing is copied. */
+  // REQ RQ_M-KTA-ICPP-FN-0150(1) : Deserialize Commands in message
+  while (curPosition < commandsSize)
   {
-    if (gCommandTags[i] == (uint8_t)xTag)
+    // REQ RQ_M-KTA-ICPP-CF-0020(1) : Max command Count
+    if (xpView->commandsCount >= C_K_ICPP_PARSER__MAX_COMMANDS_COUNT)
+    {
+      M_KTALOG__ERR("Exceeded the max no of commands %u", (uint32_t)xpView->commandsCount);
+      status = E_K_ICPP_PARSER_STATUS_ERROR;
+      goto end;
+    }
+
+    commandTag = (TKIcppCommandTag)pCommands[curPosition];
+    status = lIcppParserGetItem(&pCommands[curPosition], commandsSize - curPosition,
+                                E_ICPP_PARSER_TAG_TYPE_COMMAND, &headerSize, &commandLength);
+    if (E_K_ICPP_PARSER_STATUS_OK != status)
+    {
+      goto end;
+    }
+
+    if ((0U == commandLength) && (E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE != commandTag))
     {
-      if (xpTagLen != NULL)
+      M_KTALOG__ERR("Invalid command len %d", 0);
+      status = E_K_ICPP_PARSER_STATUS_ERROR;
+      goto end;
+    }
+
+    curPosition += headerSize;
+
+    if ((int)M_K_ICPP_PARSER__COMMAND_TAG_HAS_FIELDS(commandTag) != 0)
+    {
+      // REQ RQ_M-KTA-ICPP-FN-0160(1) : Deserialize Fileds in Commands
+      status = lIcppParserCountFields(&pCommands[curPosition], commandLength, &fieldsCount, NULL);
+      if (E_K_ICPP_PARSER_STATUS_OK != status)
       {
-        *xpTagLen = (uint32_t)(M_K_ICPP_PARSER_GET_COMMAND_LENGTH(xTag));
+        goto end;
       }
-      return E_K_ICPP_PARSER_STATUS_OK;
     }
+
+    // REQ RQ_M-KTA-ICPP-FN-0190(1) : Command processing error
+    if (E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR == commandTag)
+    {
+      M_KTALOG__WARN("Received E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR");
+      status = E_K_ICPP_PARSER_STATUS_NOTIFICATION_CPERROR;
+      goto end;
+    }
+
+    curPosition += commandLength;
+    xpView->commandsCount++;
   }
-  M_KTALOG__ERR("Unknown command xTag %u", xTag);
-  return E_K_ICPP_PARSER_STATUS_PARAMETER;
+
+end:
+  M_KTALOG__END("End, status : %d", status);
+  return status;
 }
 
 /**
- * @brief Check if tag exists in field tag tables
+ * @brief implement ktaIcppParserViewGetCommand
+ *
  */
-static TKParserStatus lCheckFieldTag
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+TKParserStatus ktaIcppParserViewGetCommand
 (
-  const uint32_t  xTag,
-  uint32_t*       xpTagLen
+  const TKIcppMessageView*  xpView,
+  size_t                    xIndex,
+  TKIcppCommandView*        xpCommand
 )
 {
-  /* Check 1-byte field tags */
-  for (uint32_t i = 0; i < sizeof(gField1ByteTags); i++)
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+  size_t          curPosition = 0;
+  size_t          headerSize = 0;
+  size_t          commandLength = 0;
+  size_t          commandIndex = 0;
+
+  if ((NULL == xpView) || (NULL == xpCommand) || (xIndex >= xpView->commandsCount))
+  {
+    M_KTALOG__ERR("Invalid parameters");
+    goto end;
+  }
+
+  /* Commands are variable length, skip the ones before xIndex. */
+  for (;;)
   {
-    if (gField1ByteTags[i] == (uint8_t)xTag)
+    status = lIcppParserGetItem(&xpView->pCommands[curPosition],
+                                xpView->commandsSize - curPosition,
+                                E_ICPP_PARSER_TAG_TYPE_COMMAND, &headerSize, &commandLength);
+    if ((E_K_ICPP_PARSER_STATUS_OK != status) || (commandIndex == xIndex))
     {
-      if (xpTagLen != NULL)
-      {
-        *xpTagLen = M_K_ICPP_PARSER_GET_1_BYTE_FIELD_LENGTH(xTag);
-      }
-      return E_K_ICPP_PARSER_STATUS_OK;
+      break;
     }
+    curPosition += headerSize + commandLength;
+    commandIndex++;
   }
 
-  /* Check 2-byte field tags */
-  for (uint32_t i = 0; i < sizeof(gField2ByteTags); i++)
+  if (E_K_ICPP_PARSER_STATUS_OK != status)
   {
-    if (gField2ByteTags[i] == (uint8_t)xTag)
+    goto end;
+  }
+
+  xpCommand->commandTag = (TKIcppCommandTag)xpView->pCommands[curPosition];
+  xpCommand->cmdLen = commandLength;
+  /* Storing the received data pointer to the command value. */
+  xpCommand->cmdValue = (uint8_t*)&xpView->pCommands[curPosition + headerSize];
+  xpCommand->fieldsCount = 0;
+  xpCommand->fieldsPresence = 0;
+
+  if ((int)M_K_ICPP_PARSER__COMMAND_TAG_HAS_FIELDS(xpCommand->commandTag) != 0)
+  {
+    status = lIcppParserCountFields(xpCommand->cmdValue, commandLength,
+                                    &xpCommand->fieldsCount, xpCommand);
+  }
+
+end:
+  return status;
+}
+
+/**
+ * @brief implement ktaIcppParserCommandGetNextField
+ *
+ */
+TKParserStatus ktaIcppParserCommandGetNextField
+(
+  const TKIcppCommandView*  xpCommand,
+  size_t*                   xpOffset,
+  TKIcppField*              xpField
+)
+{
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+  size_t          headerSize = 0;
+  size_t          fieldLength = 0;
+
+  if ((NULL == xpCommand) || (NULL == xpOffset) || (NULL == xpField) ||
+      (*xpOffset > xpCommand->cmdLen))
+  {
+    M_KTALOG__ERR("Invalid parameters");
+  }
+  else if ((0u == xpCommand->fieldsCount) || (*xpOffset == xpCommand->cmdLen))
+  {
+    status = E_K_ICPP_PARSER_STATUS_NO_OPERATION;
+  }
+  else
+  {
+    status = lIcppParserGetItem(&xpCommand->cmdValue[*xpOffset], xpCommand->cmdLen - *xpOffset,
+                                E_ICPP_PARSER_TAG_TYPE_FIELD, &headerSize, &fieldLength);
+    if (E_K_ICPP_PARSER_STATUS_OK == status)
     {
-      if (xpTagLen != NULL)
-      {
-        *xpTagLen = M_K_ICPP_PARSER_GET_2_BYTE_FIELD_LENGTH(xTag);
-      }
-      return E_K_ICPP_PARSER_STATUS_OK;
+      xpField->fieldTag = (TKIcppFieldTag)xpCommand->cmdValue[*xpOffset];
+      xpField->fieldLen = fieldLength;
+      xpField->fieldValue = &xpCommand->cmdValue[*xpOffset + headerSize];
+      *xpOffset += headerSize + fieldLength;
     }
   }
 
-  M_KTALOG__ERR("Unknown field xTag %u", xTag);
-  return E_K_ICPP_PARSER_STATUS_PARAMETER;
+  return status;
+}
+
+/**
+ * @brief implement ktaIcppParserCommandGetField
+ *
+ */
+TKParserStatus ktaIcppParserCommandGetField
+(
+  const TKIcppCommandView*  xpCommand,
+  TKIcppFieldTag            xFieldTag,
+  TKIcppField*              xpField
+)
+{
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+  TKIcppFieldSlot slot = M_K_ICPP_PARSER__FIELD_SLOT(xFieldTag);
+  size_t          offset = 0;
+
+  if ((NULL == xpCommand) || (NULL == xpField))
+  {
+    M_KTALOG__ERR("Invalid parameters");
+  }
+  else if ((E_K_ICPP_PARSER_FIELD_SLOT_NONE == slot) ||
+           (0u == (xpCommand->fieldsPresence & M_K_ICPP_PARSER__FIELD_BIT(slot))))
+  {
+    status = E_K_ICPP_PARSER_STATUS_NO_OPERATION;
+  }
+  else
+  {
+    offset = xpCommand->fieldsOffset[slot];
+    status = ktaIcppParserCommandGetNextField(xpCommand, &offset, xpField);
+  }
+
+  return status;
+}
+
+/**
+ * @brief implement ktaIcppParserStreamInit
+ *
+ */
+TKParserStatus ktaIcppParserStreamInit
+(
+  TKIcppParserStream*       xpStream,
+  TKIcppParserEventHandler  xpHandler,
+  void*                     xpContext
+)
+{
+  TKParserStatus status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+
+  if ((NULL == xpStream) || (NULL == xpHandler))
+  {
+    M_KTALOG__ERR("Invalid parameters");
+  }
+  else
+  {
+    (void)memset(xpStream, 0, sizeof(TKIcppParserStream));
+    xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_HEADER;
+    xpStream->pHandler = xpHandler;
+    xpStream->pContext = xpContext;
+    status = E_K_ICPP_PARSER_STATUS_OK;
+  }
+
+  return status;
 }
 
+/**
+ * @brief implement ktaIcppParserStreamFeed
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+TKParserStatus ktaIcppParserStreamFeed
+(
+  TKIcppParserStream*  xpStream,
+  const uint8_t*       xpChunk,
+  size_t               xChunkSize
+)
+{
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_OK;
+  size_t          curPosition = 0;
+  size_t          partSize = 0;
+
+  if ((NULL == xpStream) || ((NULL == xpChunk) && (0u != xChunkSize)))
+  {
+    M_KTALOG__ERR("Invalid parameters");
+    status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+    goto end;
+  }
+
+  while ((E_K_ICPP_PARSER_STATUS_OK == status) && (curPosition < xChunkSize))
+  {
+    switch (xpStream->state)
+    {
+      case E_K_ICPP_PARSER_STREAM_STATE_HEADER:
+        partSize = C_K_ICPP_PARSER__HEADER_SIZE - xpStream->headerSize;
+        if (partSize > (xChunkSize - curPosition))
+        {
+          partSize = xChunkSize - curPosition;
+        }
+        (void)memcpy(&xpStream->aHeader[xpStream->headerSize], &xpChunk[curPosition], partSize);
+        xpStream->headerSize += partSize;
+        curPosition += partSize;
+
+        if (C_K_ICPP_PARSER__HEADER_SIZE == xpStream->headerSize)
+        {
+          /* Reject the message as soon as the header is known. */
+          if (E_K_ICPP_PARSER_STATUS_OK != lIcppParserCheckHeader(xpStream->aHeader))
+          {
+            M_KTALOG__ERR("Invalid header");
+            status = E_K_ICPP_PARSER_STATUS_ERROR;
+            break;
+          }
+
+          lIcppParserGetTagLength(&xpStream->aHeader[C_K_ICPP_PARSER_LENGTH_INDEX],
+                                  C_K_ICPP_PARSER_LENGTH_SIZE_IN_HEADER,
+                                  &xpStream->lengthReceived);
+          xpStream->messageRemaining = xpStream->lengthReceived;
+          xpStream->lengthReceived = 0;
+
+          status = lIcppParserStreamEmit(xpStream, E_K_ICPP_PARSER_EVENT_HEADER, 0,
+                                         xpStream->messageRemaining, xpStream->aHeader);
+          if (E_K_ICPP_PARSER_STATUS_OK != status)
+          {
+            break;
+          }
+
+          if (C_K_ICPP_PARSER_HEADER_LENGTH_FOR_NOOP == xpStream->messageRemaining)
+          {
+            xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_DONE;
+            status = lIcppParserStreamEmit(xpStream, E_K_ICPP_PARSER_EVENT_MESSAGE_END, 0, 0, NULL);
+            if (E_K_ICPP_PARSER_STATUS_OK == status)
+            {
+              status = E_K_ICPP_PARSER_STATUS_NO_OPERATION;
+            }
+          }
+          else
+          {
+            xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_COMMAND_TAG;
+          }
+        }
+        break;
+
+      case E_K_ICPP_PARSER_STREAM_STATE_VALUE:
+        partSize = xpStream->valueRemaining;
+        if (partSize > (xChunkSize - curPosition))
+        {
+          partSize = xChunkSize - curPosition;
+        }
+
+        /* Hand over the value part in place, nothing is buffered. */
+        status = lIcppParserStreamEmit(xpStream, E_K_ICPP_PARSER_EVENT_VALUE,
+                                       (0u != xpStream->fieldTag) ?
+                                       xpStream->fieldTag : xpStream->commandTag,
+                                       partSize, &xpChunk[curPosition]);
+        xpStream->valueOffset += partSize;
+        xpStream->valueRemaining -= partSize;
+        curPosition += partSize;
+
+        if ((E_K_ICPP_PARSER_STATUS_OK == status) && (0u == xpStream->valueRemaining))
+        {
+          status = lIcppParserStreamValueEnd(xpStream);
+        }
+        break;
+
+      case E_K_ICPP_PARSER_STREAM_STATE_COMMAND_TAG:
+      case E_K_ICPP_PARSER_STREAM_STATE_COMMAND_LENGTH:
+      case E_K_ICPP_PARSER_STREAM_STATE_FIELD_TAG:
+      case E_K_ICPP_PARSER_STREAM_STATE_FIELD_LENGTH:
+        status = lIcppParserStreamByte(xpStream, xpChunk[curPosition]);
+        curPosition++;
+        break;
+
+      default:
+        M_KTALOG__ERR("Data after end of message, state %d", xpStream->state);
+        status = E_K_ICPP_PARSER_STATUS_ERROR;
+        break;
+    }
+  }
+
+  if ((E_K_ICPP_PARSER_STATUS_OK == status) && (curPosition < xChunkSize))
+  {
+    M_KTALOG__ERR("Data after end of message");
+    status = E_K_ICPP_PARSER_STATUS_ERROR;
+  }
+
+  if ((E_K_ICPP_PARSER_STATUS_OK != status) &&
+      (E_K_ICPP_PARSER_STATUS_NO_OPERATION != status) &&
+      (E_K_ICPP_PARSER_STATUS_NOTIFICATION_CPERROR != status))
+  {
+    xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_ERROR;
+  }
+
+end:
+  return status;
+}
+
+/**
+ * @brief implement ktaIcppParserStreamEnd
+ *
+ */
+TKParserStatus ktaIcppParserStreamEnd
+(
+  const TKIcppParserStream*  xpStream
+)
+{
+  TKParserStatus status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+
+  if (NULL == xpStream)
+  {
+    M_KTALOG__ERR("Invalid parameters");
+  }
+  else if (E_K_ICPP_PARSER_STREAM_STATE_DONE != xpStream->state)
+  {
+    M_KTALOG__ERR("Incomplete message, state %d", xpStream->state);
+    status = E_K_ICPP_PARSER_STATUS_ERROR;
+  }
+  else
+  {
+    status = E_K_ICPP_PARSER_STATUS_OK;
+  }
+
+  return status;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
 /**
  * @implements lIcppParserIsValidTag
  *
@@ -780,21 +1379,39 @@ static TKParserStatus lIcppParserIsValidTag
   uint32_t*             xpTagLen
 )
 {
-  /* Handle command tag type */
-  if (E_ICPP_PARSER_TAG_TYPE_COMMAND == xTagType)
-  {
-    return lCheckCommandTag(xTag, xpTagLen);
-  }
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+  uint8_t         tagInfo = 0;
 
-  /* Handle field tag type */
-  if (E_ICPP_PARSER_TAG_TYPE_FIELD == xTagType)
+  /* Single table lookup, callers report unknown tags. */
+  if (xTag < C_K_ICPP_PARSER__TAG_INFO_COUNT)
   {
-    return lCheckFieldTag(xTag, xpTagLen);
+    tagInfo = gaIcppParserTagInfo[xTag];
+
+    if ((E_ICPP_PARSER_TAG_TYPE_COMMAND == xTagType) &&
+        (0u != (tagInfo & C_K_ICPP_PARSER__TAG_INFO_COMMAND)))
+    {
+      if (NULL != xpTagLen)
+      {
+        *xpTagLen = (uint32_t)M_K_ICPP_PARSER_GET_COMMAND_LENGTH(xTag);
+      }
+      status = E_K_ICPP_PARSER_STATUS_OK;
+    }
+    else if ((E_ICPP_PARSER_TAG_TYPE_FIELD == xTagType) &&
+             (0u != (tagInfo & C_K_ICPP_PARSER__TAG_INFO_FIELD)))
+    {
+      if (NULL != xpTagLen)
+      {
+        *xpTagLen = (uint32_t)M_K_ICPP_PARSER_GET_FIELD_LENGTH(xTag);
+      }
+      status = E_K_ICPP_PARSER_STATUS_OK;
+    }
+    else
+    {
+      /* Unknown tag for this tag type. */
+    }
   }
 
-  /* Unknown tag type */
-  M_KTALOG__ERR("Unknown  xTagType %u", xTagType);
-  return E_K_ICPP_PARSER_STATUS_PARAMETER;
+  return status;
 }
 
 /**
@@ -1330,7 +1947,7 @@ static TKParserStatus lIcppParserDeserializeHeader
 (
   const uint8_t*          xpReceivedMessage,
   const size_t            xReceivedMessageSize,
-  TKIcppProtocolMessage*  xpIcppMessage
+  TKIcppMessageView*      xpView
 )
 {
   TKParserStatus status    = E_K_ICPP_PARSER_STATUS_ERROR;
@@ -1339,9 +1956,7 @@ static TKParserStatus lIcppParserDeserializeHeader
   uint32_t headerLength    = 0;
 
   if ((C_K_ICPP_PARSER__HEADER_SIZE > xReceivedMessageSize) ||
-      (C_K_ICPP_PARSER_PROTOCOL_VERSION != M_ICPP_PARSER_GET_PROTOCOL_VERSION(xpReceivedMessage)) ||
-      (E_K_ICPP_PARSER_MSG_TYPE_RESERVED <= M_ICPP_PARSER_GET_MESSAGE_TYPE(xpReceivedMessage)) ||
-      (E_K_ICPP_PARSER_FULL_ENC_MODE != M_ICPP_PARSER_GET_ENC_MODE(xpReceivedMessage)))
+      (E_K_ICPP_PARSER_STATUS_OK != lIcppParserCheckHeader(xpReceivedMessage)))
   {
     M_KTALOG__ERR("Invalid parameters");
     status = E_K_ICPP_PARSER_STATUS_PARAMETER;
@@ -1350,22 +1965,22 @@ static TKParserStatus lIcppParserDeserializeHeader
   {
     /* Setting the crypto version, encryption mode and message type. */
     // REQ RQ_M-KTA-NOOP-FN-0040(1) : Crypto version from keySTEREAM in NoOP message.
-    xpIcppMessage->cryptoVersion = M_ICPP_PARSER_GET_CRYPTO_VERSION(xpReceivedMessage);
-    xpIcppMessage->encMode = M_ICPP_PARSER_GET_ENC_MODE(xpReceivedMessage);
-    xpIcppMessage->msgType = (TKIcppMessageType)M_ICPP_PARSER_GET_MESSAGE_TYPE(xpReceivedMessage);
+    xpView->cryptoVersion = M_ICPP_PARSER_GET_CRYPTO_VERSION(xpReceivedMessage);
+    xpView->encMode = M_ICPP_PARSER_GET_ENC_MODE(xpReceivedMessage);
+    xpView->msgType = (TKIcppMessageType)M_ICPP_PARSER_GET_MESSAGE_TYPE(xpReceivedMessage);
 
     curPosition = C_K_ICPP_PARSER_TRANSACTION_ID_INDEX;
 
     /* Setting the Transaction ID. */
     // REQ RQ_M-KTA-ICPP-CF-0080(1) : Transaction Id Size
-    (void)memcpy(xpIcppMessage->transactionId,
+    (void)memcpy(xpView->transactionId,
                   &xpReceivedMessage[curPosition],
                   C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES);
     curPosition += C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES;
 
     /* Setting the Rot public UID. */
     // REQ RQ_M-KTA-ICPP-CF-0090(1) : Rot Public Uid Size
-    (void)memcpy(xpIcppMessage->rotPublicUID,
+    (void)memcpy(xpView->rotPublicUID,
                   &xpReceivedMessage[curPosition],
                   C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES);
     curPosition += C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES;
@@ -1373,7 +1988,7 @@ static TKParserStatus lIcppParserDeserializeHeader
     /* Store received rotpublicuid here. */
     // REQ RQ_M-KTA-ICPP-FN-0200(1) : Store the rot public uid
     eStatus = salStorageSetAndLockValue(C_K_KTA__ROT_PUBLIC_UID_STORAGE_ID,
-                                        xpIcppMessage->rotPublicUID,
+                                        xpView->rotPublicUID,
                                         C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES);
 
     if (eStatus != E_K_STATUS_OK)
@@ -1383,7 +1998,7 @@ static TKParserStatus lIcppParserDeserializeHeader
     }
 
     /* Setting the Rot KeySet id. */
-    xpIcppMessage->rotKeySetId = xpReceivedMessage[curPosition];
+    xpView->rotKeySetId = xpReceivedMessage[curPosition];
 
     curPosition += C_K_ICPP_PARSER__ROT_KEYSET_ID_SIZE_IN_BYTES;
 
@@ -1420,6 +2035,381 @@ end:
   return status;
 }
 
+/**
+ * @implements lIcppParserCopyHeader
+ *
+ */
+static void lIcppParserCopyHeader
+(
+  const TKIcppMessageView*  xpView,
+  TKIcppProtocolMessage*    xpIcppMessage
+)
+{
+  xpIcppMessage->cryptoVersion = xpView->cryptoVersion;
+  xpIcppMessage->encMode = xpView->encMode;
+  xpIcppMessage->msgType = xpView->msgType;
+  (void)memcpy(xpIcppMessage->transactionId, xpView->transactionId,
+               C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES);
+  (void)memcpy(xpIcppMessage->rotPublicUID, xpView->rotPublicUID,
+               C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES);
+  xpIcppMessage->rotKeySetId = xpView->rotKeySetId;
+}
+
+/**
+ * @implements lIcppParserGetItem
+ *
+ */
+static TKParserStatus lIcppParserGetItem
+(
+  const uint8_t*       xpData,
+  size_t               xDataSize,
+  const TKIcppTagType  xTagType,
+  size_t*              xpHeaderSize,
+  size_t*              xpValueSize
+)
+{
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_ERROR;
+  uint32_t        tagLen = 0;
+  uint32_t        valueLength = 0;
+
+  if ((0u == xDataSize) ||
+      (E_K_ICPP_PARSER_STATUS_OK != lIcppParserIsValidTag(xTagType, (uint32_t)xpData[0], &tagLen)))
+  {
+    M_KTALOG__ERR("Invalid tag type %d", xTagType);
+  }
+  else if ((xDataSize - C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES) < tagLen)
+  {
+    M_KTALOG__ERR("Error while parsing taglen");
+  }
+  else
+  {
+    lIcppParserGetTagLength(&xpData[C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES], tagLen, &valueLength);
+    *xpHeaderSize = C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES + tagLen;
+
+    if ((xDataSize - *xpHeaderSize) < valueLength)
+    {
+      M_KTALOG__ERR("Error while parsing length");
+    }
+    else
+    {
+      *xpValueSize = valueLength;
+      status = E_K_ICPP_PARSER_STATUS_OK;
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @implements lIcppParserCountFields
+ *
+ */
+static TKParserStatus lIcppParserCountFields
+(
+  const uint8_t*      xpFields,
+  size_t              xFieldsSize,
+  size_t*             xpFieldsCount,
+  TKIcppCommandView*  xpCommand
+)
+{
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_OK;
+  size_t          curPosition = 0;
+  size_t          headerSize = 0;
+  size_t          fieldLength = 0;
+  size_t          fieldsCount = 0;
+  TKIcppFieldSlot slot = E_K_ICPP_PARSER_FIELD_SLOT_NONE;
+
+  while ((E_K_ICPP_PARSER_STATUS_OK == status) && (curPosition < xFieldsSize))
+  {
+    // REQ RQ_M-KTA-ICPP-CF-0050(1) : Max field Count
+    if (fieldsCount >= C_K_ICPP_PARSER__MAX_FIELDS_COUNT)
+    {
+      M_KTALOG__ERR("Exceeded the max no of fields[%u] in command", (uint32_t)fieldsCount);
+      status = E_K_ICPP_PARSER_STATUS_ERROR;
+    }
+    else
+    {
+      status = lIcppParserGetItem(&xpFields[curPosition], xFieldsSize - curPosition,
+                                  E_ICPP_PARSER_TAG_TYPE_FIELD, &headerSize, &fieldLength);
+      slot = M_K_ICPP_PARSER__FIELD_SLOT(xpFields[curPosition]);
+
+      /* Repeated fields are indexed by their first occurrence. */
+      if ((E_K_ICPP_PARSER_STATUS_OK == status) && (NULL != xpCommand) &&
+          (0u == (xpCommand->fieldsPresence & M_K_ICPP_PARSER__FIELD_BIT(slot))))
+      {
+        xpCommand->fieldsPresence |= M_K_ICPP_PARSER__FIELD_BIT(slot);
+        xpCommand->fieldsOffset[slot] = (uint16_t)curPosition;
+      }
+      curPosition += headerSize + fieldLength;
+      fieldsCount++;
+    }
+  }
+
+  *xpFieldsCount = fieldsCount;
+  return status;
+}
+
+/**
+ * @implements lIcppParserCheckHeader
+ *
+ */
+static TKParserStatus lIcppParserCheckHeader
+(
+  const uint8_t*  xpHeader
+)
+{
+  TKParserStatus status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+
+  if ((C_K_ICPP_PARSER_PROTOCOL_VERSION == M_ICPP_PARSER_GET_PROTOCOL_VERSION(xpHeader)) &&
+      (E_K_ICPP_PARSER_MSG_TYPE_RESERVED > M_ICPP_PARSER_GET_MESSAGE_TYPE(xpHeader)) &&
+      (E_K_ICPP_PARSER_FULL_ENC_MODE == M_ICPP_PARSER_GET_ENC_MODE(xpHeader)))
+  {
+    status = E_K_ICPP_PARSER_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @implements lIcppParserStreamEmit
+ *
+ */
+static TKParserStatus lIcppParserStreamEmit
+(
+  TKIcppParserStream*    xpStream,
+  TKIcppParserEventType  xEventType,
+  uint32_t               xTag,
+  size_t                 xLength,
+  const uint8_t*         xpValue
+)
+{
+  TKIcppParserEvent event;
+
+  event.eventType = xEventType;
+  event.tag = xTag;
+  event.length = xLength;
+  event.offset = (E_K_ICPP_PARSER_EVENT_VALUE == xEventType) ? xpStream->valueOffset : 0u;
+  event.pValue = xpValue;
+
+  return xpStream->pHandler(xpStream->pContext, &event);
+}
+
+/**
+ * @implements lIcppParserStreamByte
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+static TKParserStatus lIcppParserStreamByte
+(
+  TKIcppParserStream*  xpStream,
+  uint8_t              xByte
+)
+{
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_ERROR;
+  uint32_t        lengthSize = 0;
+
+  switch (xpStream->state)
+  {
+    case E_K_ICPP_PARSER_STREAM_STATE_COMMAND_TAG:
+      // REQ RQ_M-KTA-ICPP-CF-0020(1) : Max command Count
+      if (xpStream->commandsCount >= C_K_ICPP_PARSER__MAX_COMMANDS_COUNT)
+      {
+        M_KTALOG__ERR("Exceeded the max no of commands %u", xpStream->commandsCount);
+        goto end;
+      }
+
+      if (E_K_ICPP_PARSER_STATUS_OK != lIcppParserIsValidTag(E_ICPP_PARSER_TAG_TYPE_COMMAND,
+                                                             (uint32_t)xByte,
+                                                             &lengthSize))
+      {
+        M_KTALOG__ERR("Invalid command tag %d", xByte);
+        goto end;
+      }
+
+      xpStream->commandTag = xByte;
+      xpStream->messageRemaining -= C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES;
+      xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_COMMAND_LENGTH;
+      break;
+
+    case E_K_ICPP_PARSER_STREAM_STATE_FIELD_TAG:
+      // REQ RQ_M-KTA-ICPP-CF-0050(1) : Max field Count
+      if (xpStream->fieldsCount >= C_K_ICPP_PARSER__MAX_FIELDS_COUNT)
+      {
+        M_KTALOG__ERR("Exceeded the max no of fields[%u] in command", xpStream->fieldsCount);
+        goto end;
+      }
+
+      if (E_K_ICPP_PARSER_STATUS_OK != lIcppParserIsValidTag(E_ICPP_PARSER_TAG_TYPE_FIELD,
+                                                             (uint32_t)xByte,
+                                                             &lengthSize))
+      {
+        M_KTALOG__ERR("Invalid Field Tag %d", xByte);
+        goto end;
+      }
+
+      xpStream->fieldTag = xByte;
+      xpStream->commandRemaining -= C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES;
+      xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_FIELD_LENGTH;
+      break;
+
+    case E_K_ICPP_PARSER_STREAM_STATE_COMMAND_LENGTH:
+      xpStream->length = (xpStream->length << C_K_ICPP_PARSER_NO_OF_BITS_IN_BYTE) | xByte;
+      xpStream->lengthReceived++;
+      xpStream->messageRemaining--;
+
+      if (xpStream->lengthReceived == xpStream->lengthSize)
+      {
+        if (xpStream->length > xpStream->messageRemaining)
+        {
+          M_KTALOG__ERR("Command length %u exceeds message", (uint32_t)xpStream->length);
+          goto end;
+        }
+
+        if ((0u == xpStream->length) &&
+            (E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE != xpStream->commandTag))
+        {
+          M_KTALOG__ERR("Invalid command len %d", 0);
+          goto end;
+        }
+
+        xpStream->messageRemaining -= xpStream->length;
+        xpStream->commandRemaining = xpStream->length;
+        xpStream->fieldsCount = 0;
+        xpStream->commandsCount++;
+
+        status = lIcppParserStreamEmit(xpStream, E_K_ICPP_PARSER_EVENT_COMMAND,
+                                       xpStream->commandTag, xpStream->length, NULL);
+        if (E_K_ICPP_PARSER_STATUS_OK != status)
+        {
+          goto end;
+        }
+
+        if ((int)M_K_ICPP_PARSER__COMMAND_TAG_HAS_FIELDS(xpStream->commandTag) != 0)
+        {
+          xpStream->valueRemaining = 0;
+          status = lIcppParserStreamValueEnd(xpStream);
+        }
+        else
+        {
+          /* Command value without fields, the whole command is one value. */
+          xpStream->fieldTag = 0;
+          xpStream->valueRemaining = xpStream->commandRemaining;
+          xpStream->commandRemaining = 0;
+          xpStream->valueOffset = 0;
+          xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_VALUE;
+          if (0u == xpStream->valueRemaining)
+          {
+            status = lIcppParserStreamValueEnd(xpStream);
+          }
+        }
+        goto end;
+      }
+      break;
+
+    case E_K_ICPP_PARSER_STREAM_STATE_FIELD_LENGTH:
+      xpStream->length = (xpStream->length << C_K_ICPP_PARSER_NO_OF_BITS_IN_BYTE) | xByte;
+      xpStream->lengthReceived++;
+      xpStream->commandRemaining--;
+
+      if (xpStream->lengthReceived == xpStream->lengthSize)
+      {
+        if (xpStream->length > xpStream->commandRemaining)
+        {
+          M_KTALOG__ERR("Error while parsing field length");
+          goto end;
+        }
+
+        xpStream->commandRemaining -= xpStream->length;
+        xpStream->fieldsCount++;
+
+        status = lIcppParserStreamEmit(xpStream, E_K_ICPP_PARSER_EVENT_FIELD,
+                                       xpStream->fieldTag, xpStream->length, NULL);
+        if (E_K_ICPP_PARSER_STATUS_OK != status)
+        {
+          goto end;
+        }
+
+        xpStream->valueRemaining = xpStream->length;
+        xpStream->valueOffset = 0;
+        xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_VALUE;
+        if (0u == xpStream->valueRemaining)
+        {
+          status = lIcppParserStreamValueEnd(xpStream);
+        }
+        goto end;
+      }
+      break;
+
+    default:
+      M_KTALOG__ERR("Invalid state %d", xpStream->state);
+      goto end;
+  }
+
+  if (0u != lengthSize)
+  {
+    /* Tag accepted, its length must fit in what is left. */
+    if (lengthSize > ((E_K_ICPP_PARSER_STREAM_STATE_COMMAND_LENGTH == xpStream->state) ?
+                      xpStream->messageRemaining : xpStream->commandRemaining))
+    {
+      M_KTALOG__ERR("Error while parsing taglen");
+      goto end;
+    }
+    xpStream->lengthSize = lengthSize;
+    xpStream->lengthReceived = 0;
+    xpStream->length = 0;
+  }
+  status = E_K_ICPP_PARSER_STATUS_OK;
+
+end:
+  return status;
+}
+
+/**
+ * @implements lIcppParserStreamValueEnd
+ *
+ */
+static TKParserStatus lIcppParserStreamValueEnd
+(
+  TKIcppParserStream*  xpStream
+)
+{
+  TKParserStatus status = E_K_ICPP_PARSER_STATUS_OK;
+
+  if (0u != xpStream->commandRemaining)
+  {
+    xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_FIELD_TAG;
+  }
+  else
+  {
+    status = lIcppParserStreamEmit(xpStream, E_K_ICPP_PARSER_EVENT_COMMAND_END,
+                                   xpStream->commandTag, 0, NULL);
+
+    // REQ RQ_M-KTA-ICPP-FN-0190(1) : Command processing error
+    if ((E_K_ICPP_PARSER_STATUS_OK == status) &&
+        (E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR == xpStream->commandTag))
+    {
+      M_KTALOG__WARN("Received E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR");
+      xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_DONE;
+      status = E_K_ICPP_PARSER_STATUS_NOTIFICATION_CPERROR;
+    }
+    else if ((E_K_ICPP_PARSER_STATUS_OK == status) && (0u == xpStream->messageRemaining))
+    {
+      xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_DONE;
+      status = lIcppParserStreamEmit(xpStream, E_K_ICPP_PARSER_EVENT_MESSAGE_END, 0, 0, NULL);
+    }
+    else
+    {
+      xpStream->state = E_K_ICPP_PARSER_STREAM_STATE_COMMAND_TAG;
+    }
+  }
+
+  return status;
+}
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
@@ -118,12 +118,35 @@ extern "C" {
 #define C_K_ICPP__2BYTE_END_WITHOUT_FILED_RANGE_CMD_TAG   (0XBFu)
 
 
+/** @brief Number of entries of the tag information table, one per tag byte. */
+#define C_K_ICPP_PARSER__TAG_INFO_COUNT                   (256u)
+
+/** @brief Tag information: byte is a supported command tag. */
+#define C_K_ICPP_PARSER__TAG_INFO_COMMAND                 (0x01u)
+
+/** @brief Tag information: command value is a list of fields. */
+#define C_K_ICPP_PARSER__TAG_INFO_CMD_HAS_FIELDS          (0x02u)
+
+/** @brief Tag information: command length is coded on 2 bytes. */
+#define C_K_ICPP_PARSER__TAG_INFO_CMD_LEN_2BYTE           (0x04u)
+
+/** @brief Tag information: byte is a supported field tag. */
+#define C_K_ICPP_PARSER__TAG_INFO_FIELD                   (0x10u)
+
+/** @brief Tag information: field length is coded on 2 bytes. */
+#define C_K_ICPP_PARSER__TAG_INFO_FIELD_LEN_2BYTE         (0x20u)
+
+/** @brief Presence bitmap bit of a field slot. */
+#define M_K_ICPP_PARSER__FIELD_BIT(x_slot)   \
+  ((uint64_t)1u << (uint32_t)(x_slot))
+
+/** @brief Field slot of a field tag, E_K_ICPP_PARSER_FIELD_SLOT_NONE for unsupported tags. */
+#define M_K_ICPP_PARSER__FIELD_SLOT(x_fieldTag)   \
+  ((TKIcppFieldSlot)gaIcppParserFieldSlot[(uint8_t)(x_fieldTag)])
+
 /** @brief ICPP command tag has fields. */
 #define M_K_ICPP_PARSER__COMMAND_TAG_HAS_FIELDS(x_cmdTag)   \
-  ((((uint32_t)(x_cmdTag) >= C_K_ICPP__1BYTE_START_WITH_FILED_RANGE_CMD_TAG) && \
-    ((uint32_t)(x_cmdTag) <= C_K_ICPP__1BYTE_END_WITH_FILED_RANGE_CMD_TAG)) || \
-   (((uint32_t)(x_cmdTag) >= C_K_ICPP__2BYTE_START_WITH_FILED_RANGE_CMD_TAG) && \
-    ((uint32_t)(x_cmdTag) <= C_K_ICPP__2BYTE_END_WITH_FILED_RANGE_CMD_TAG)))
+  ((gaIcppParserTagInfo[(uint8_t)(x_cmdTag)] & C_K_ICPP_PARSER__TAG_INFO_CMD_HAS_FIELDS) != 0u)
 
 /** @brief Supported status. */
 typedef enum
@@ -416,6 +439,59 @@ typedef enum
   E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CAUSE            = 0xBD
 } TKIcppFieldTag;
 
+/**
+ * @brief ICPP field slot, dense index of a supported field tag.
+ *
+ * Slots index the presence bitmap and field offsets of a command view.
+ */
+typedef enum
+{
+  /**
+   * Not a supported field tag
+   */
+  E_K_ICPP_PARSER_FIELD_SLOT_NONE = 0,
+  E_K_ICPP_PARSER_FIELD_SLOT_DEVPROFUID,
+  E_K_ICPP_PARSER_FIELD_SLOT_MUTABLE_DEVPROFUID,
+  E_K_ICPP_PARSER_FIELD_SLOT_ROT_SOL_ID,
+  E_K_ICPP_PARSER_FIELD_SLOT_CHIP_UID,
+  E_K_ICPP_PARSER_FIELD_SLOT_ROT_PUBLIC_UID,
+  E_K_ICPP_PARSER_FIELD_SLOT_CHIP_CERT,
+  E_K_ICPP_PARSER_FIELD_SLOT_ROT_E_PK,
+  E_K_ICPP_PARSER_FIELD_SLOT_SIGNED_PUB_KEY,
+  E_K_ICPP_PARSER_FIELD_SLOT_CHIP_ATTEST_CERT,
+  E_K_ICPP_PARSER_FIELD_SLOT_ACK_SEQ_CNT,
+  E_K_ICPP_PARSER_FIELD_SLOT_KTA_CAPABILITY,
+  E_K_ICPP_PARSER_FIELD_SLOT_KTA_NONCE,
+  E_K_ICPP_PARSER_FIELD_SLOT_KTA_CTX_PRO_UID,
+  E_K_ICPP_PARSER_FIELD_SLOT_KTA_CTX_SERIAL_NO,
+  E_K_ICPP_PARSER_FIELD_SLOT_KTA_CTX_VER,
+  E_K_ICPP_PARSER_FIELD_SLOT_KTA_VER,
+  E_K_ICPP_PARSER_FIELD_SLOT_DEV_SERIAL_NO,
+  E_K_ICPP_PARSER_FIELD_SLOT_KS_E_PK,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_TYPE,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_IDENTIFIER,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_ATTRIBUTES,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_DATA,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_ASSOCIATION_INFO,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_OWNER,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_UID,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_CUSTOMER_METADATA,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_PROCESSING_STATUS,
+  E_K_ICPP_PARSER_FIELD_SLOT_CHALLENGE,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_PUBLIC_KEY,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_METADATA,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_COMPONENT_TARGET,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_COMPONENT_VERSION,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_COMPONENT_URL,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_ERROR_CODE,
+  E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_ERROR_CAUSE,
+  /**
+   * Number of field slots
+   */
+  E_K_ICPP_PARSER_FIELD_SLOT_COUNT
+} TKIcppFieldSlot;
+
 /** @brief ICPP field structure. */
 typedef struct
 {
@@ -484,10 +560,185 @@ typedef struct
 #endif
 } TKIcppProtocolMessage;
 
+/**
+ * @brief ICPP message view.
+ *
+ * Header of a received message and the location of its commands. Commands and fields are
+ * decoded on demand from the received buffer, which must stay valid while the view is used.
+ */
+typedef struct
+{
+  uint8_t           cryptoVersion;
+  /* Crypto version. */
+  uint8_t           encMode;
+  /* Encryption mode. */
+  TKIcppMessageType msgType;
+  /* ICPP Message type. */
+  uint8_t           transactionId[C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES];
+  /* Transaction ID to be used communicating with keySTREAM. */
+  uint8_t           rotPublicUID[C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES];
+  /* Device specific rot public UID. */
+  uint8_t           rotKeySetId;
+  /* Rot KeySet ID. */
+  size_t            commandsCount;
+  /* ICPP no of valid commands. */
+  const uint8_t*    pCommands;
+  /* First command in the received message. */
+  size_t            commandsSize;
+  /* Size of the commands in the received message. */
+} TKIcppMessageView;
+
+/** @brief ICPP command view. */
+typedef struct
+{
+  TKIcppCommandTag  commandTag;
+  /* ICPP command tag. */
+  size_t            cmdLen;
+  /* ICPP Length of the command value. */
+  uint8_t*          cmdValue;
+  /* ICPP command value, serialized fields for a command with fields. */
+  size_t            fieldsCount;
+  /* ICPP no of fields, 0 for a command without fields. */
+  uint64_t          fieldsPresence;
+  /* Bit M_K_ICPP_PARSER__FIELD_BIT(slot) set for each field slot present in the command. */
+  uint16_t          fieldsOffset[E_K_ICPP_PARSER_FIELD_SLOT_COUNT];
+  /* Offset in cmdValue of the first field of each present slot. */
+} TKIcppCommandView;
+
+/** @brief Events reported by the streaming deserializer. */
+typedef enum
+{
+  /**
+   * Header received and checked. pValue is the raw header, length the payload length.
+   */
+  E_K_ICPP_PARSER_EVENT_HEADER = 0x00u,
+  /**
+   * Command tag and length received. tag and length describe the command.
+   */
+  E_K_ICPP_PARSER_EVENT_COMMAND,
+  /**
+   * Field tag and length received. tag and length describe the field.
+   */
+  E_K_ICPP_PARSER_EVENT_FIELD,
+  /**
+   * Part of the current field value, or command value for commands without fields.
+   * pValue points into the chunk given to ktaIcppParserStreamFeed(), offset is the
+   * position of the part in the whole value.
+   */
+  E_K_ICPP_PARSER_EVENT_VALUE,
+  /**
+   * Current command fully received. tag is the command tag.
+   */
+  E_K_ICPP_PARSER_EVENT_COMMAND_END,
+  /**
+   * Message fully received.
+   */
+  E_K_ICPP_PARSER_EVENT_MESSAGE_END
+} TKIcppParserEventType;
+
+/** @brief Event reported by the streaming deserializer. */
+typedef struct
+{
+  TKIcppParserEventType  eventType;
+  /* Type of event. */
+  uint32_t               tag;
+  /* Command or field tag, 0 if not applicable. */
+  size_t                 length;
+  /* Length of the item, or of the value part for E_K_ICPP_PARSER_EVENT_VALUE. */
+  size_t                 offset;
+  /* Offset of the value part in the value. */
+  const uint8_t*         pValue;
+  /* Value part or raw header, NULL if not applicable. Valid during the callback only. */
+} TKIcppParserEvent;
+
+/**
+ * @brief
+ *   Streaming deserializer event handler.
+ *
+ * @param[in] xpContext
+ *   Context given to ktaIcppParserStreamInit().
+ * @param[in] xpEvent
+ *   Event to process.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK to continue.
+ * - Any other status to abort, it is returned by ktaIcppParserStreamFeed().
+ */
+typedef TKParserStatus (*TKIcppParserEventHandler)
+(
+  void*                     xpContext,
+  const TKIcppParserEvent*  xpEvent
+);
+
+/** @brief Streaming deserializer states. */
+typedef enum
+{
+  E_K_ICPP_PARSER_STREAM_STATE_HEADER = 0x00u,
+  E_K_ICPP_PARSER_STREAM_STATE_COMMAND_TAG,
+  E_K_ICPP_PARSER_STREAM_STATE_COMMAND_LENGTH,
+  E_K_ICPP_PARSER_STREAM_STATE_FIELD_TAG,
+  E_K_ICPP_PARSER_STREAM_STATE_FIELD_LENGTH,
+  E_K_ICPP_PARSER_STREAM_STATE_VALUE,
+  E_K_ICPP_PARSER_STREAM_STATE_DONE,
+  E_K_ICPP_PARSER_STREAM_STATE_ERROR
+} TKIcppParserStreamState;
+
+/**
+ * @brief Streaming deserializer context. Fixed size whatever the message length,
+ *        fields are handed over to the event handler and never buffered.
+ */
+typedef struct
+{
+  TKIcppParserStreamState   state;
+  /* Current state. */
+  TKIcppParserEventHandler  pHandler;
+  /* Event handler. */
+  void*                     pContext;
+  /* Event handler context. */
+  uint8_t                   aHeader[C_K_ICPP_PARSER__HEADER_SIZE];
+  /* Header being received. */
+  size_t                    headerSize;
+  /* Number of header bytes received. */
+  uint32_t                  commandTag;
+  /* Current command tag. */
+  uint32_t                  fieldTag;
+  /* Current field tag. */
+  uint32_t                  lengthSize;
+  /* Size of the length being received. */
+  uint32_t                  lengthReceived;
+  /* Number of length bytes received. */
+  size_t                    length;
+  /* Length being received. */
+  size_t                    messageRemaining;
+  /* Bytes left in the message after the current command. */
+  size_t                    commandRemaining;
+  /* Bytes left in the current command after the current field. */
+  size_t                    valueRemaining;
+  /* Bytes left in the current value. */
+  size_t                    valueOffset;
+  /* Bytes of the current value already reported. */
+  uint32_t                  commandsCount;
+  /* Number of commands received. */
+  uint32_t                  fieldsCount;
+  /* Number of fields received in the current command. */
+} TKIcppParserStream;
+
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
 /* -------------------------------------------------------------------------- */
 
+/**
+ * @brief Tag information table indexed by tag byte, combination of
+ *        C_K_ICPP_PARSER__TAG_INFO_* flags. 0 for unsupported tags.
+ */
+extern const uint8_t gaIcppParserTagInfo[C_K_ICPP_PARSER__TAG_INFO_COUNT];
+
+/**
+ * @brief Field slot table indexed by tag byte, TKIcppFieldSlot of the field tag.
+ *        E_K_ICPP_PARSER_FIELD_SLOT_NONE for unsupported tags.
+ */
+extern const uint8_t gaIcppParserFieldSlot[C_K_ICPP_PARSER__TAG_INFO_COUNT];
+
 /* -------------------------------------------------------------------------- */
 /* FUNCTIONS                                                                  */
 /* -------------------------------------------------------------------------- */
@@ -605,6 +856,176 @@ TKParserStatus ktaIcppParserSetHeaderLength
   size_t   xLength
 );
 
+/**
+ * @brief
+ *   Deserialize the ICPP message into a view, without copying commands and fields.
+ *
+ * @param[in] xpReceivedMessage
+ *   Buffer contains ICPP message received from keySTREAM.
+ *   Must stay valid while the view is used.
+ * @param[in] xReceivedMessageSize
+ *   Length of ICPP message received from keySTREAM.
+ * @param[in,out] xpView
+ *   [in] Pointer to the view to fill.
+ *   [out] Header and location of the commands.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+ * - E_K_ICPP_PARSER_STATUS_NO_OPERATION for a message without payload.
+ * - E_K_ICPP_PARSER_STATUS_NOTIFICATION_CPERROR for a command processing error command.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for other errors.
+ */
+TKParserStatus ktaIcppParserDeserializeView
+(
+  const uint8_t*      xpReceivedMessage,
+  const size_t        xReceivedMessageSize,
+  TKIcppMessageView*  xpView
+);
+
+/**
+ * @brief
+ *   Get a command of a message view.
+ *
+ * @param[in] xpView
+ *   View filled by ktaIcppParserDeserializeView.
+ * @param[in] xIndex
+ *   Index of the command, lower than xpView->commandsCount.
+ * @param[out] xpCommand
+ *   Command tag, value, number of fields and field index.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for other errors.
+ */
+TKParserStatus ktaIcppParserViewGetCommand
+(
+  const TKIcppMessageView*  xpView,
+  size_t                    xIndex,
+  TKIcppCommandView*        xpCommand
+);
+
+/**
+ * @brief
+ *   Get the next field of a command view.
+ *
+ * @param[in] xpCommand
+ *   Command returned by ktaIcppParserViewGetCommand.
+ * @param[in,out] xpOffset
+ *   [in] Offset of the field in the command value, 0 for the first field.
+ *   [out] Offset of the following field.
+ * @param[out] xpField
+ *   Field tag, length and value.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+ * - E_K_ICPP_PARSER_STATUS_NO_OPERATION when there are no more fields.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for other errors.
+ */
+TKParserStatus ktaIcppParserCommandGetNextField
+(
+  const TKIcppCommandView*  xpCommand,
+  size_t*                   xpOffset,
+  TKIcppField*              xpField
+);
+
+/**
+ * @brief
+ *   Get a field of a command view by tag, using the field index of the command.
+ *
+ * @param[in] xpCommand
+ *   Command returned by ktaIcppParserViewGetCommand.
+ * @param[in] xFieldTag
+ *   Tag of the field.
+ * @param[out] xpField
+ *   First field of the command with this tag.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+ * - E_K_ICPP_PARSER_STATUS_NO_OPERATION when the command has no such field.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for other errors.
+ */
+TKParserStatus ktaIcppParserCommandGetField
+(
+  const TKIcppCommandView*  xpCommand,
+  TKIcppFieldTag            xFieldTag,
+  TKIcppField*              xpField
+);
+
+/**
+ * @brief
+ *   Initialize a streaming deserializer for a new message.
+ *
+ * @param[in,out] xpStream
+ *   [in] Pointer to the deserializer context.
+ *   [out] Context ready to receive the first chunk.
+ * @param[in] xpHandler
+ *   Handler called for each event.
+ * @param[in] xpContext
+ *   Context given back to xpHandler.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
+ */
+TKParserStatus ktaIcppParserStreamInit
+(
+  TKIcppParserStream*       xpStream,
+  TKIcppParserEventHandler  xpHandler,
+  void*                     xpContext
+);
+
+/**
+ * @brief
+ *   Deserialize the next chunk of an ICPP message.
+ *
+ *   Chunks may have any size and split the message anywhere. The same checks
+ *   as ktaIcppParserDeserializeMessage() are done as soon as the data is
+ *   available, so an invalid message is rejected before it is fully received.
+ *   The RoT public UID is not stored, this stays with the full deserializer.
+ *
+ * @param[in,out] xpStream
+ *   Deserializer context.
+ * @param[in] xpChunk
+ *   Next part of the message.
+ * @param[in] xChunkSize
+ *   Size of xpChunk in bytes.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK when the chunk is processed.
+ * - E_K_ICPP_PARSER_STATUS_NO_OPERATION for a message without payload.
+ * - E_K_ICPP_PARSER_STATUS_NOTIFICATION_CPERROR after a command processing error command.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for invalid message, data after the end of message,
+ *   or the status returned by the event handler.
+ */
+TKParserStatus ktaIcppParserStreamFeed
+(
+  TKIcppParserStream*  xpStream,
+  const uint8_t*       xpChunk,
+  size_t               xChunkSize
+);
+
+/**
+ * @brief
+ *   Check that the message is complete once the transport has no more data.
+ *
+ * @param[in] xpStream
+ *   Deserializer context.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK if the whole message was deserialized.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for truncated or invalid message.
+ */
+TKParserStatus ktaIcppParserStreamEnd
+(
+  const TKIcppParserStream*  xpStream
+);
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
@@ -52,11 +52,14 @@
 #include "k_sal_storage.h"
 #include "k_sal_object.h"
 #include "k_sal_crypto.h"
+#include "k_sal_rot.h"
+#include "k_sal_context.h"
 #include "cryptoConfig.h"
 #include "KTALog.h"
 
 #ifdef FOTA_ENABLE
 #include "k_sal_fota.h"
+#include "fotaprocess.h"
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -72,6 +75,19 @@
 /** @brief Message format Error. */
 #define C_MSG_FORMAT_ERROR                          (0X02u)
 
+/**
+ * @brief Workspace needed by the deepest exchange path: the clear message and its view,
+ * plus a protocol message and a serialization buffer to build the answer.
+ */
+#define C_KTA_WORKSPACE_REQUIRED_SIZE                                  \
+  ((2u * M_GEN__ARENA_BLOCK_SIZE(C_K__ICPP_MSG_MAX_SIZE)) +            \
+   M_GEN__ARENA_BLOCK_SIZE(sizeof(TKIcppMessageView)) +                \
+   M_GEN__ARENA_BLOCK_SIZE(sizeof(TKIcppProtocolMessage)))
+
+/** @brief Does not compile if C_K__KTA_WORKSPACE_SIZE cannot hold an exchange. */
+typedef uint8_t TKtaWorkspaceSizeCheck
+[(C_K__KTA_WORKSPACE_SIZE >= C_KTA_WORKSPACE_REQUIRED_SIZE) ? 1 : -1];
+
 /** @brief keySTREAM Trusted Agent State. */
 typedef enum
 {
@@ -97,6 +113,59 @@ typedef enum
   E_KTA_STATE_INVALID     = 0xFFu
 } TKtaState;
 
+/** @brief API state of one keySTREAM Trusted Agent instance. */
+typedef struct
+{
+  TKtaState             ktaState;
+  /* API call sequence state. */
+  TKtaLifeCycleState    lifeCycleState;
+  /* Life cycle state, mirrors NVM when isLifeCycleStateValid is set. */
+  uint8_t               isPreActivated;
+  /* Set once the registration request has been sent. */
+  uint8_t               isLifeCycleStateValid;
+  /* Set when lifeCycleState mirrors the life cycle state stored in NVM. */
+  TKktaKeyStreamStatus  commandStatus;
+  /* Last keySTREAM command status. */
+  size_t                workspacePeak;
+  /* Highest workspace usage of all the exchanges. */
+  TKtaArena             arena;
+  /* Arena over the workspace of the ongoing exchange. */
+} TKtaInstance;
+
+/**
+ * @brief
+ *   State of an instance stored in a TKtaContext: its API state plus the
+ *   module and SAL states bound to the calling thread while it is served.
+ *   The built-in instance uses the built-in module and SAL states instead.
+ */
+typedef struct
+{
+  TKtaInstance          instance;
+  /* API state. */
+  TKSalContext          sal;
+  /* Secure element, storage records and identity of the device. */
+  TKtaConfigState       config;
+  /* Device and context configuration. */
+  TKtaActState          act;
+  /* Activation request material prepared by ktaPrecomputeCtx(). */
+#ifdef FOTA_ENABLE
+  TFotaProcessState     fota;
+  /* FOTA processing state. */
+#endif
+} TKtaContextState;
+
+/** @brief Power-on state of an instance. */
+#define M_KTA_INSTANCE_INIT                                            \
+  {                                                                    \
+    .ktaState = E_KTA_STATE_INITIAL,                                   \
+    .lifeCycleState = E_LIFE_CYCLE_STATE_INIT,                         \
+    .commandStatus = E_K_KTA_KS_STATUS_NONE                            \
+  }
+
+/** @brief Does not compile if C_K__KTA_CONTEXT_SIZE cannot hold an instance. */
+typedef uint8_t TKtaContextSizeCheck
+[(C_K__KTA_CONTEXT_SIZE >= sizeof(TKtaContextState)) ? 1 : -1];
+
 /** @brief keySTREAM Trusted Agent Life Cycle NVM Data. */
 static const uint8_t gaKtaLifeCycleNVMVData[C_KTA_CONFIG__LIFE_CYCLE_MAX_STATE]
 [C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE] =
@@ -127,10 +196,8 @@ static const uint8_t gaKtaLifeCycleNVMVData[C_KTA_CONFIG__LIFE_CYCLE_MAX_STATE]
 static const char* gpModuleName = "KTAMGR";
 #endif
 
-static TKtaState gKtaState                              = E_KTA_STATE_INITIAL;
-static TKtaLifeCycleState gKtaLifeCycleState            = E_LIFE_CYCLE_STATE_INIT;
-static uint8_t  gKtaIsPreActivated                      = 0u;
-static TKktaKeyStreamStatus gCommandStatus              = E_K_KTA_KS_STATUS_NONE;
+/* Built-in instance, served by the API calls without a context. */
+static TKtaInstance gKtaInstance                        = M_KTA_INSTANCE_INIT;
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
@@ -139,6 +206,8 @@ static TKktaKeyStreamStatus gCommandStatus              = E_K_KTA_KS_STATUS_NONE
  * @brief
  *   Get lifecycle state from NVM.
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param[in,out] xpLifeCycleStateLen
  *   [in] State len which need to to be passed to SAL api
  *   [out] Filled lifecycle length from sal api
@@ -150,9 +219,29 @@ static TKktaKeyStreamStatus gCommandStatus              = E_K_KTA_KS_STATUS_NONE
  */
 static TKStatus lgetNVMLifeCycleState
 (
+  TKtaInstance*  xpInstance,
   size_t*  xpLifeCycleStateLen
 );
 
+/**
+ * @brief
+ *   Store lifecycle state in NVM and update its RAM copy.
+ *
+ * @param[in,out] xpInstance
+ *   Instance served.
+ * @param[in] xLifeCycleState
+ *   Lifecycle state to store.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lsetNVMLifeCycleState
+(
+  TKtaInstance*       xpInstance,
+  TKtaLifeCycleState  xLifeCycleState
+);
+
 /**
  * @brief
  *   Prepare processing status message.
@@ -184,6 +273,8 @@ static TKStatus lPrepareProcessingStatus
  * @brief
  *   Prepare processing status response message.
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param [in] xpReceivedMsg
  *   Message received from the server.
  *   Should not be NULL.
@@ -209,6 +300,7 @@ static TKStatus lPrepareProcessingStatus
  */
 static TKStatus lBuildProcessingStatusRespMsg
 (
+  TKtaInstance*   xpInstance,
   const uint8_t*  xpReceivedMsg,
   size_t          xReceivedMsgSize,
   uint32_t        xErrorCode,
@@ -220,6 +312,8 @@ static TKStatus lBuildProcessingStatusRespMsg
  * @brief
  *   Prepare no operation notification message.
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param[in,out] xpMessageToSend
  *   [in] Pointer to buffer to carry NoOp message to send to keySTREAM.
  *   [out] Actual message to provide to keySTREAM.
@@ -238,6 +332,7 @@ static TKStatus lBuildProcessingStatusRespMsg
  */
 static TKStatus lPrepareNoOpNotificationRequest
 (
+  TKtaInstance*  xpInstance,
   uint8_t*  xpMessageToSend,
   size_t*   xpMessageToSendSize
 
@@ -247,6 +342,8 @@ static TKStatus lPrepareNoOpNotificationRequest
  * @brief
  *   Does sanity check for message received from keySTREAM.
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param[in] xpKs2ktaMsg
  *   Message received from the server.
  *   Should not be NULL
@@ -278,13 +375,14 @@ static TKStatus lPrepareNoOpNotificationRequest
  */
 static TKStatus lCheckKs2KtaMessage
 (
+  TKtaInstance*           xpInstance,
   const uint8_t*          xpKs2ktaMsg,
   size_t                  xKs2ktaMsgLen,
   uint8_t*                xpKta2ksMsg,
   size_t*                 xpKta2ksMsgLen,
   uint8_t*                xpClearMsg,
   size_t                  xClearMsgLen,
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   TKParserStatus*         xpParserStatus
 );
 
@@ -292,6 +390,8 @@ static TKStatus lCheckKs2KtaMessage
  * @brief
  *   Handle INIT lifecycle state for device information setup.
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param[in] xpDeviceProfilePublicUid
  *   Device profile public UID
  * @param[in] xDeviceProfilePublicUidSize
@@ -309,6 +409,7 @@ static TKStatus lCheckKs2KtaMessage
  */
 static TKStatus lHandleInitLifeCycleState
 (
+  TKtaInstance*   xpInstance,
   const uint8_t*  xpDeviceProfilePublicUid,
   size_t          xDeviceProfilePublicUidSize,
   const uint8_t*  xpDeviceSerialNum,
@@ -320,6 +421,8 @@ static TKStatus lHandleInitLifeCycleState
  * @brief
  *   Process NoOp lifecycle state transitions.
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param[in] xpRecvdProtoMessage
  *   Received protocol message
  * @param[in,out] xpKta2ksMsgLen
@@ -332,7 +435,8 @@ static TKStatus lHandleInitLifeCycleState
  */
 static TKStatus lProcessNoOpLifecycleTransition
 (
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKtaInstance*           xpInstance,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   size_t*                 xpKta2ksMsgLen
 );
 
@@ -340,6 +444,8 @@ static TKStatus lProcessNoOpLifecycleTransition
  * @brief
  *   Process activation request for sealed state with no incoming message.
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param[in,out] xpKta2ksMsg
  *   [in] Buffer to store activation request
  *   [out] Filled activation request message
@@ -353,6 +459,7 @@ static TKStatus lProcessNoOpLifecycleTransition
  */
 static TKStatus lProcessSealedStateActivationRequest
 (
+  TKtaInstance*  xpInstance,
   uint8_t*  xpKta2ksMsg,
   size_t*   xpKta2ksMsgLen
 );
@@ -361,6 +468,8 @@ static TKStatus lProcessSealedStateActivationRequest
  * @brief
  *   Process pre-activated state handling.
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param[in] xpRecvdProtoMessage
  *   Received protocol message
  * @param[in,out] xpKta2ksMsg
@@ -376,7 +485,8 @@ static TKStatus lProcessSealedStateActivationRequest
  */
 static TKStatus lProcessPreActivatedState
 (
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKtaInstance*           xpInstance,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   uint8_t*                xpKta2ksMsg,
   size_t*                 xpKta2ksMsgLen
 );
@@ -385,6 +495,8 @@ static TKStatus lProcessPreActivatedState
  * @brief
  *   Process first activation (not pre-activated).
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param[in] xpRecvdProtoMessage
  *   Received protocol message
  * @param[in,out] xpKta2ksMsg
@@ -400,7 +512,8 @@ static TKStatus lProcessPreActivatedState
  */
 static TKStatus lProcessFirstActivation
 (
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKtaInstance*           xpInstance,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   uint8_t*                xpKta2ksMsg,
   size_t*                 xpKta2ksMsgLen
 );
@@ -409,6 +522,8 @@ static TKStatus lProcessFirstActivation
  * @brief
  *   Process sealed state with incoming message.
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param[in] xpKs2ktaMsg
  *   Message from server
  * @param[in] xKs2ktaMsgLen
@@ -435,13 +550,14 @@ static TKStatus lProcessFirstActivation
  */
 static TKStatus lProcessSealedStateMessage
 (
+  TKtaInstance*           xpInstance,
   const uint8_t*          xpKs2ktaMsg,
   size_t                  xKs2ktaMsgLen,
   uint8_t*                xpKta2ksMsg,
   size_t*                 xpKta2ksMsgLen,
   uint8_t*                xpClearMsg,
   size_t                  xClearMsgLen,
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   TKParserStatus*         xpParserStatus
 );
 
@@ -449,6 +565,8 @@ static TKStatus lProcessSealedStateMessage
  * @brief
  *   Process activated/provisioned state handling.
  *
+ * @param[in,out] xpInstance
+ *   Instance served.
  * @param[in] xpKs2ktaMsg
  *   Message from server
  * @param[in] xKs2ktaMsgLen
@@ -475,16 +593,102 @@ static TKStatus lProcessSealedStateMessage
  */
 static TKStatus lProcessActivatedState
 (
+  TKtaInstance*           xpInstance,
   const uint8_t*          xpKs2ktaMsg,
   size_t                  xKs2ktaMsgLen,
   uint8_t*                xpKta2ksMsg,
   size_t*                 xpKta2ksMsgLen,
   uint8_t*                xpClearMsg,
   size_t                  xClearMsgLen,
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   TKParserStatus*         xpParserStatus
 );
 
+/**
+ * @brief
+ *   Commit point of a public call: close its storage transaction, which
+ *   writes the storage records it updated.
+ *
+ * @param[in] xStatus
+ *   Status of the call.
+ *
+ * @return
+ * - xStatus once the records are written.
+ * - E_K_STATUS_ERROR otherwise.
+ */
+static TKStatus lCommitStorage
+(
+  TKStatus  xStatus
+);
+
+/**
+ * @brief
+ *   Open the secure element session of a public call. Without a session on
+ *   the device, the commands of the call run as outside a session.
+ */
+static void lRotSessionBegin
+(
+  void
+);
+
+/**
+ * @brief
+ *   Close the secure element session opened by lRotSessionBegin().
+ */
+static void lRotSessionEnd
+(
+  void
+);
+
+/**
+ * @brief
+ *   Entry of a public call: bind the module and SAL states of the instance
+ *   to the calling thread.
+ *
+ * @param[in] xpContext
+ *   Instance storage, NULL for the built-in instance.
+ *
+ * @return
+ *   API state of the instance.
+ */
+static TKtaInstance* lInstanceEnter
+(
+  TKtaContext*  xpContext
+);
+
+/**
+ * @brief
+ *   Exchange a message on behalf of an instance, see ktaExchangeMessageEx().
+ *
+ * @param[in,out] xpInstance
+ *   Instance served, entered by the caller.
+ * @param[in,out] xpWorkspace
+ *   Scratch workspace of the exchange.
+ * @param[in] xpKs2ktaMsg
+ *   Message received from keySTREAM.
+ * @param[in] xKs2ktaMsgLen
+ *   Size of xpKs2ktaMsg, 0 if none.
+ * @param[in,out] xpKta2ksMsg
+ *   Message to send to keySTREAM.
+ * @param[in,out] xpKta2ksMsgLen
+ *   [in] Size of xpKta2ksMsg.
+ *   [out] Size of the message to send.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lExchangeMessage
+(
+  TKtaInstance*   xpInstance,
+  TKtaWorkspace*  xpWorkspace,
+  const uint8_t*  xpKs2ktaMsg,
+  size_t          xKs2ktaMsgLen,
+  uint8_t*        xpKta2ksMsg,
+  size_t*         xpKta2ksMsgLen
+);
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
 /* -------------------------------------------------------------------------- */
@@ -501,13 +705,26 @@ TKStatus ktaInitialize
   void
 )
 {
+  return ktaInitializeCtx(NULL);
+}
+
+/**
+ * @brief implement ktaInitializeCtx
+ *
+ */
+TKStatus ktaInitializeCtx
+(
+  TKtaContext*  xpContext
+)
+{
+  TKtaInstance* pInstance = lInstanceEnter(xpContext);
   TKStatus status = E_K_STATUS_ERROR;
 
   M_KTALOG__START("Start");
 
-  if (E_KTA_STATE_INITIAL == gKtaState)
+  if (E_KTA_STATE_INITIAL == pInstance->ktaState)
   {
-    gKtaState = E_KTA_STATE_INITIALIZED;
+    pInstance->ktaState = E_KTA_STATE_INITIALIZED;
     M_KTALOG__DEBUG("KTA initialization SUCCESS!!!");
     status = E_K_STATUS_OK;
   }
@@ -520,13 +737,34 @@ TKStatus ktaInitialize
  * @brief implement ktaStartup
  *
  */
+TKStatus ktaStartup
+(
+  const uint8_t*  xpL1SegSeed,
+  const uint8_t*  xpKtaContextProfileUid,
+  size_t          xKtaContextProfileUidLen,
+  const uint8_t*  xpKtaContexSerialNumber,
+  size_t          xKtaContexSerialNumberLen,
+  const uint8_t*  xpKtaContextVersion,
+  size_t          xKtaContextVersionLen
+)
+{
+  return ktaStartupCtx(NULL, xpL1SegSeed, xpKtaContextProfileUid, xKtaContextProfileUidLen,
+                       xpKtaContexSerialNumber, xKtaContexSerialNumberLen, xpKtaContextVersion,
+                       xKtaContextVersionLen);
+}
+
+/**
+ * @brief implement ktaStartupCtx
+ *
+ */
 /**
  * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
  * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
  * Using goto for breaking during the error and return cases.
  **/
-TKStatus ktaStartup
+TKStatus ktaStartupCtx
 (
+  TKtaContext*    xpContext,
   const uint8_t*  xpL1SegSeed,
   const uint8_t*  xpKtaContextProfileUid,
   size_t          xKtaContextProfileUidLen,
@@ -536,6 +774,7 @@ TKStatus ktaStartup
   size_t          xKtaContextVersionLen
 )
 {
+  TKtaInstance* pInstance = lInstanceEnter(xpContext);
   TKStatus status = E_K_STATUS_ERROR;
   // REQ RQ_M-KTA-LCST-FN-0010(1) : Life Cycle State Size
   size_t  lifeCycleStateLen = C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE;
@@ -562,16 +801,20 @@ TKStatus ktaStartup
   }
 
   // REQ RQ_M-KTA-STRT-FN-0002(1) : Check KTA State
-  if (E_KTA_STATE_INITIALIZED != gKtaState)
+  if (E_KTA_STATE_INITIALIZED != pInstance->ktaState)
   {
     M_KTALOG__END("End, status : %d", status);
     return status;
   }
 
+  /* One secure element session for the whole startup, storage commit included. */
+  lRotSessionBegin();
+  (void)salStorageBegin();
+
   M_KTALOG__DEBUG("Reading life cycle state from NVM...");
   // REQ RQ_M-KTA-LCST-FN-0020(1) : Power off in INIT|INITIALIZED state
   // REQ RQ_M-KTA-LCST-FN-0025(1) : Power off in INIT|STARTED state
-  status = lgetNVMLifeCycleState(&lifeCycleStateLen);
+  status = lgetNVMLifeCycleState(pInstance, &lifeCycleStateLen);
   if ((E_K_STATUS_OK != status) || (0U == lifeCycleStateLen))
   {
     M_KTALOG__ERR("Reading life cycle state from NVM failed, status = [%d]", status);
@@ -584,7 +827,7 @@ TKStatus ktaStartup
   status = ktaSetContextInfoConfig(xpL1SegSeed, xpKtaContextProfileUid,
                                     xKtaContextProfileUidLen, xpKtaContexSerialNumber,
                                     xKtaContexSerialNumberLen, xpKtaContextVersion,
-                                    xKtaContextVersionLen, gKtaLifeCycleState);
+                                    xKtaContextVersionLen, pInstance->lifeCycleState);
 
   if (E_K_STATUS_OK != status)
   {
@@ -594,11 +837,11 @@ TKStatus ktaStartup
 
   // REQ RQ_M-KTA-LCST-FN-0050(1) : Power off in ACTIVATED|INITIALIZED state
   // REQ RQ_M-KTA-LCST-FN-0065(1) : Power off in PROVISIONED|INITIALIZED state
-  if ((gKtaLifeCycleState == E_LIFE_CYCLE_STATE_ACTIVATED) ||
-      (gKtaLifeCycleState == E_LIFE_CYCLE_STATE_PROVISIONED) ||
-      (gKtaLifeCycleState == E_LIFE_CYCLE_STATE_CON_REQ))
+  if ((pInstance->lifeCycleState == E_LIFE_CYCLE_STATE_ACTIVATED) ||
+      (pInstance->lifeCycleState == E_LIFE_CYCLE_STATE_PROVISIONED) ||
+      (pInstance->lifeCycleState == E_LIFE_CYCLE_STATE_CON_REQ))
   {
-    M_KTALOG__DEBUG("gKtaLifeCycleState = [%d], deriving L2Keys", gKtaLifeCycleState);
+    M_KTALOG__DEBUG("gKtaLifeCycleState = [%d], deriving L2Keys", pInstance->lifeCycleState);
     // REQ RQ_M-KTA-STRT-FN-0070(1) : Derive L2 Keys
     status = ktaActDeriveL2Keys();
 
@@ -610,10 +853,12 @@ TKStatus ktaStartup
   }
 
   // REQ RQ_M-KTA-STRT-FN-0003(1) : Set KTA State
-  gKtaState = E_KTA_STATE_STARTED;
+  pInstance->ktaState = E_KTA_STATE_STARTED;
   M_KTALOG__DEBUG("KTA reached to STARTED state");
 
 end:
+  status = lCommitStorage(status);
+  lRotSessionEnd();
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -622,13 +867,32 @@ end:
  * @brief implement ktaSetDeviceInformation
  *
  */
+TKStatus ktaSetDeviceInformation
+(
+  const uint8_t*  xpDeviceProfilePublicUid,
+  size_t          xDeviceProfilePublicUidSize,
+  const uint8_t*  xpDeviceSerialNum,
+  size_t          xDeviceSerialNumSize,
+  uint8_t*        xpConnectionRequest
+)
+{
+  return ktaSetDeviceInformationCtx(NULL, xpDeviceProfilePublicUid, xDeviceProfilePublicUidSize,
+                                    xpDeviceSerialNum, xDeviceSerialNumSize,
+                                    xpConnectionRequest);
+}
+
+/**
+ * @brief implement ktaSetDeviceInformationCtx
+ *
+ */
 /**
  * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
  * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
  * Using goto for breaking during the error and return cases.
  **/
-TKStatus ktaSetDeviceInformation
+TKStatus ktaSetDeviceInformationCtx
 (
+  TKtaContext*    xpContext,
   const uint8_t*  xpDeviceProfilePublicUid,
   size_t          xDeviceProfilePublicUidSize,
   const uint8_t*  xpDeviceSerialNum,
@@ -636,6 +900,7 @@ TKStatus ktaSetDeviceInformation
   uint8_t*        xpConnectionRequest
 )
 {
+  TKtaInstance* pInstance = lInstanceEnter(xpContext);
   TKStatus status = E_K_STATUS_ERROR;
 
   M_KTALOG__START("Start");
@@ -657,17 +922,19 @@ TKStatus ktaSetDeviceInformation
 
   // REQ RQ_M-KTA-STRT-FN-0040(1) : Invalid KTA State
   // REQ RQ_M-KTA-STRT-FN-0120(1) : Invalid KTA State
-  if (E_KTA_STATE_STARTED != gKtaState)
+  if (E_KTA_STATE_STARTED != pInstance->ktaState)
   {
-    M_KTALOG__ERR("Device in a bad state, gKtaState = [%d]", gKtaState);
+    M_KTALOG__ERR("Device in a bad state, gKtaState = [%d]", pInstance->ktaState);
     M_KTALOG__END("End, status : %d", status);
     return status;
   }
 
-  switch (gKtaLifeCycleState)
+  (void)salStorageBegin();
+
+  switch (pInstance->lifeCycleState)
   {
     case E_LIFE_CYCLE_STATE_INIT:
-      status = lHandleInitLifeCycleState(xpDeviceProfilePublicUid,
+      status = lHandleInitLifeCycleState(pInstance, xpDeviceProfilePublicUid,
                                          xDeviceProfilePublicUidSize,
                                          xpDeviceSerialNum,
                                          xDeviceSerialNumSize,
@@ -682,7 +949,7 @@ TKStatus ktaSetDeviceInformation
                                       xDeviceProfilePublicUidSize,
                                       xpDeviceSerialNum,
                                       xDeviceSerialNumSize,
-                                      gKtaLifeCycleState);
+                                      pInstance->lifeCycleState);
       /* fall through */
     case E_LIFE_CYCLE_STATE_ACTIVATED:
     case E_LIFE_CYCLE_STATE_CON_REQ:
@@ -699,7 +966,7 @@ TKStatus ktaSetDeviceInformation
 
     default:
       M_KTALOG__ERR("Invalid state, gKtaLifeCycleState = [%d]",
-                    gKtaLifeCycleState);
+                    pInstance->lifeCycleState);
       *xpConnectionRequest = 0;
       break;
   }
@@ -708,10 +975,11 @@ TKStatus ktaSetDeviceInformation
   // REQ RQ_M-KTA-STRT-FN-0140(1) : Set KTA State
   if (status == E_K_STATUS_OK)
   {
-    gKtaState = E_KTA_STATE_RUNNING;
+    pInstance->ktaState = E_KTA_STATE_RUNNING;
     M_KTALOG__DEBUG("KTA reached to RUNNING state");
   }
 
+  status = lCommitStorage(status);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -726,6 +994,7 @@ TKStatus ktaSetDeviceInformation
  */
 static TKStatus lHandleInitLifeCycleState
 (
+  TKtaInstance*   xpInstance,
   const uint8_t*  xpDeviceProfilePublicUid,
   size_t          xDeviceProfilePublicUidSize,
   const uint8_t*  xpDeviceSerialNum,
@@ -741,7 +1010,7 @@ static TKStatus lHandleInitLifeCycleState
                                   xDeviceProfilePublicUidSize,
                                   xpDeviceSerialNum,
                                   xDeviceSerialNumSize,
-                                  gKtaLifeCycleState);
+                                  xpInstance->lifeCycleState);
 
   if (E_K_STATUS_OK != status)
   {
@@ -754,9 +1023,7 @@ static TKStatus lHandleInitLifeCycleState
   // REQ RQ_M-KTA-LCST-FN-0035(1) : Power off in SEALED|INITIALIZED state
   // REQ RQ_M-KTA-LCST-FN-0085(1) : Power off in CON_REQ|STARTED state
   // REQ RQ_M-KTA-LCST-FN-0080(1) : Power off in CON_REQ|INITIALIZED state
-  status = salStorageSetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
-                              gaKtaLifeCycleNVMVData[E_LIFE_CYCLE_STATE_SEALED],
-                              C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE);
+  status = lsetNVMLifeCycleState(xpInstance, E_LIFE_CYCLE_STATE_SEALED);
 
   if (E_K_STATUS_OK != status)
   {
@@ -764,9 +1031,8 @@ static TKStatus lHandleInitLifeCycleState
     return status;
   }
 
-  gKtaLifeCycleState = E_LIFE_CYCLE_STATE_SEALED;
   M_KTALOG__INFO("Setting life cycle state to SEALED state, gKtaLifeCycleState = [%d]",
-                  gKtaLifeCycleState);
+                  xpInstance->lifeCycleState);
   *xpConnectionRequest = 1;
   M_KTALOG__DEBUG("Connection Request set to TRUE");
 
@@ -784,6 +1050,7 @@ static TKStatus lHandleInitLifeCycleState
  */
 static TKStatus lProcessSealedStateActivationRequest
 (
+  TKtaInstance*  xpInstance,
   uint8_t*  xpKta2ksMsg,
   size_t*   xpKta2ksMsgLen
 )
@@ -794,8 +1061,8 @@ static TKStatus lProcessSealedStateActivationRequest
   // REQ RQ_M-KTA-ACTV-FN-0005(1) :
   // Build Activation Request
   // REQ RQ_M-KTA-STRT-FN-0200(1) : Prepare the activation msg
-  gKtaIsPreActivated = 0u;
-  status = ktaActBuildActivationRequest(xpKta2ksMsg, xpKta2ksMsgLen);
+  xpInstance->isPreActivated = 0u;
+  status = ktaActBuildActivationRequest(&xpInstance->arena, xpKta2ksMsg, xpKta2ksMsgLen);
 
   if (E_K_STATUS_OK != status)
   {
@@ -816,7 +1083,8 @@ static TKStatus lProcessSealedStateActivationRequest
  */
 static TKStatus lProcessPreActivatedState
 (
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKtaInstance*           xpInstance,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   uint8_t*                xpKta2ksMsg,
   size_t*                 xpKta2ksMsgLen
 )
@@ -861,9 +1129,7 @@ static TKStatus lProcessPreActivatedState
   // REQ RQ_M-KTA-LCST-FN-0050(1) : Power off in ACTIVATED|INITIALIZED state
   // REQ RQ_M-KTA-LCST-FN-0055(1) : Power off in ACTIVATED|STARTED state
   // REQ RQ_M-KTA-LCST-FN-0045(1) : Power off in ACTIVATED|RUNNING state
-  status = salStorageSetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
-                              gaKtaLifeCycleNVMVData[E_LIFE_CYCLE_STATE_ACTIVATED],
-                              C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE);
+  status = lsetNVMLifeCycleState(xpInstance, E_LIFE_CYCLE_STATE_ACTIVATED);
 
   if (E_K_STATUS_OK != status)
   {
@@ -872,17 +1138,18 @@ static TKStatus lProcessPreActivatedState
     return status;
   }
 
-  gKtaLifeCycleState = E_LIFE_CYCLE_STATE_ACTIVATED;
   M_KTALOG__INFO("Setting KTA Lifecycle state to Activated, state = [%d]",
-                 gKtaLifeCycleState);
-  gKtaIsPreActivated = 0u;
+                 xpInstance->lifeCycleState);
+  xpInstance->isPreActivated = 0u;
 
   M_KTALOG__DEBUG("Processing 3rd party commands...");
   // REQ RQ_M-KTA-STRT-FN-0290(1) :
   /** Process the received commands.
    */
   // REQ RQ_M-KTA-OBJM-FN-0800(1) : Set Object With Association ICPP Message
-  status = ktaCmdProcess(xpRecvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
+  /* Commands may reset the life cycle slot through the SAL (refurbish). */
+  xpInstance->isLifeCycleStateValid = 0u;
+  status = ktaCmdProcess(&xpInstance->arena, xpRecvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
 
   if (E_K_STATUS_OK != status)
   {
@@ -899,7 +1166,8 @@ static TKStatus lProcessPreActivatedState
  */
 static TKStatus lProcessFirstActivation
 (
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKtaInstance*           xpInstance,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   uint8_t*                xpKta2ksMsg,
   size_t*                 xpKta2ksMsgLen
 )
@@ -931,7 +1199,7 @@ static TKStatus lProcessFirstActivation
   // REQ RQ_M-KTA-REGT-FN-0011(1) : Build Registeration Info Request
   // REQ RQ_M-KTA-STRT-FN-0220(1) :
   /* Prepare Reg Info msg after processing activation response msg. */
-  status = ktaregBuildRegistrationRequest(xpRecvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
+  status = ktaregBuildRegistrationRequest(&xpInstance->arena, xpRecvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
 
   if (E_K_STATUS_OK != status)
   {
@@ -941,7 +1209,7 @@ static TKStatus lProcessFirstActivation
   }
 
   M_KTALOG__INFO("Sending Registration Request");
-  gKtaIsPreActivated = 1u;
+  xpInstance->isPreActivated = 1u;
 
   return status;
 }
@@ -952,20 +1220,21 @@ static TKStatus lProcessFirstActivation
  */
 static TKStatus lProcessSealedStateMessage
 (
+  TKtaInstance*           xpInstance,
   const uint8_t*          xpKs2ktaMsg,
   size_t                  xKs2ktaMsgLen,
   uint8_t*                xpKta2ksMsg,
   size_t*                 xpKta2ksMsgLen,
   uint8_t*                xpClearMsg,
   size_t                  xClearMsgLen,
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   TKParserStatus*         xpParserStatus
 )
 {
   TKStatus status = E_K_STATUS_ERROR;
 
   M_KTALOG__DEBUG("Validating the msg received from the server...");
-  status = lCheckKs2KtaMessage(xpKs2ktaMsg, xKs2ktaMsgLen,
+  status = lCheckKs2KtaMessage(xpInstance, xpKs2ktaMsg, xKs2ktaMsgLen,
                                 xpKta2ksMsg, xpKta2ksMsgLen,
                                 xpClearMsg, xClearMsgLen,
                                 xpRecvdProtoMessage, xpParserStatus);
@@ -977,13 +1246,13 @@ static TKStatus lProcessSealedStateMessage
     return status;
   }
 
-  if (gKtaIsPreActivated != (uint8_t)0)
+  if (xpInstance->isPreActivated != (uint8_t)0)
   {
-    status = lProcessPreActivatedState(xpRecvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
+    status = lProcessPreActivatedState(xpInstance, xpRecvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
   }
   else
   {
-    status = lProcessFirstActivation(xpRecvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
+    status = lProcessFirstActivation(xpInstance, xpRecvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
   }
 
   return status;
@@ -995,13 +1264,14 @@ static TKStatus lProcessSealedStateMessage
  */
 static TKStatus lProcessActivatedState
 (
+  TKtaInstance*           xpInstance,
   const uint8_t*          xpKs2ktaMsg,
   size_t                  xKs2ktaMsgLen,
   uint8_t*                xpKta2ksMsg,
   size_t*                 xpKta2ksMsgLen,
   uint8_t*                xpClearMsg,
   size_t                  xClearMsgLen,
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   TKParserStatus*         xpParserStatus
 )
 {
@@ -1015,7 +1285,7 @@ static TKStatus lProcessActivatedState
     // REQ RQ_M-KTA-RENW-FN-0010(1) : NoOP Message
     // REQ RQ_M-KTA-RFSH-FN-0010(1) : NoOP Message from KTA
     // REQ RQ_M-KTA-STRT-FN-0280(1) : Prepare NoOP Message
-    status = lPrepareNoOpNotificationRequest(xpKta2ksMsg, xpKta2ksMsgLen);
+    status = lPrepareNoOpNotificationRequest(xpInstance, xpKta2ksMsg, xpKta2ksMsgLen);
 
     if (E_K_STATUS_OK != status)
     {
@@ -1028,12 +1298,10 @@ static TKStatus lProcessActivatedState
   }
 
   /* Handle lifecycle state transition from PROVISIONED to CON_REQ */
-  if (E_LIFE_CYCLE_STATE_PROVISIONED == gKtaLifeCycleState)
+  if (E_LIFE_CYCLE_STATE_PROVISIONED == xpInstance->lifeCycleState)
   {
     M_KTALOG__DEBUG("Life cycle state reached to CON_REQ state, storing in persistent memory");
-    status = salStorageSetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
-                                gaKtaLifeCycleNVMVData[E_LIFE_CYCLE_STATE_CON_REQ],
-                                C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE);
+    status = lsetNVMLifeCycleState(xpInstance, E_LIFE_CYCLE_STATE_CON_REQ);
 
     if (E_K_STATUS_OK != status)
     {
@@ -1041,13 +1309,11 @@ static TKStatus lProcessActivatedState
       *xpKta2ksMsgLen = 0;
       return status;
     }
-
-    gKtaLifeCycleState = E_LIFE_CYCLE_STATE_CON_REQ;
   }
 
   /* Validate incoming message */
   M_KTALOG__DEBUG("Validating the msg received from the server...");
-  status = lCheckKs2KtaMessage(xpKs2ktaMsg, xKs2ktaMsgLen,
+  status = lCheckKs2KtaMessage(xpInstance, xpKs2ktaMsg, xKs2ktaMsgLen,
                                 xpKta2ksMsg, xpKta2ksMsgLen,
                                 xpClearMsg, xClearMsgLen,
                                 xpRecvdProtoMessage, xpParserStatus);
@@ -1089,7 +1355,9 @@ static TKStatus lProcessActivatedState
   /* Process third party command */
   M_KTALOG__DEBUG("Processing 3rd party command...");
   // REQ RQ_M-KTA-STRT-FN-0260(1) : Process the ThirdParty/Object Commands.
-  status = ktaCmdProcess(xpRecvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
+  /* Commands may reset the life cycle slot through the SAL (refurbish). */
+  xpInstance->isLifeCycleStateValid = 0u;
+  status = ktaCmdProcess(&xpInstance->arena, xpRecvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
 
   if (E_K_STATUS_OK != status)
   {
@@ -1112,32 +1380,78 @@ static TKStatus lProcessActivatedState
 }
 
 /**
- * @brief implement ktaExchangeMessage
+ * @brief implement ktaExchangeMessageEx
  *
  */
-TKStatus ktaExchangeMessage
+TKStatus ktaExchangeMessageEx
 (
+  TKtaWorkspace*  xpWorkspace,
   const uint8_t*  xpKs2ktaMsg,
   size_t          xKs2ktaMsgLen,
   uint8_t*        xpKta2ksMsg,
   size_t*         xpKta2ksMsgLen
 )
 {
-  TKIcppProtocolMessage recvdProtoMessage = {0};
+  return lExchangeMessage(lInstanceEnter(NULL), xpWorkspace, xpKs2ktaMsg, xKs2ktaMsgLen,
+                          xpKta2ksMsg, xpKta2ksMsgLen);
+}
+
+/**
+ * @brief implement ktaExchangeMessageCtx
+ *
+ */
+TKStatus ktaExchangeMessageCtx
+(
+  TKtaContext*    xpContext,
+  const uint8_t*  xpKs2ktaMsg,
+  size_t          xKs2ktaMsgLen,
+  uint8_t*        xpKta2ksMsg,
+  size_t*         xpKta2ksMsgLen
+)
+{
+  TKtaWorkspace* pWorkspace = (NULL == xpContext) ? NULL : &xpContext->workspace;
+
+  return lExchangeMessage(lInstanceEnter(xpContext), pWorkspace, xpKs2ktaMsg, xKs2ktaMsgLen,
+                          xpKta2ksMsg, xpKta2ksMsgLen);
+}
+
+/**
+ * @implements lExchangeMessage
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+static TKStatus lExchangeMessage
+(
+  TKtaInstance*   xpInstance,
+  TKtaWorkspace*  xpWorkspace,
+  const uint8_t*  xpKs2ktaMsg,
+  size_t          xKs2ktaMsgLen,
+  uint8_t*        xpKta2ksMsg,
+  size_t*         xpKta2ksMsgLen
+)
+{
+  TKIcppMessageView* pRecvdProtoMessage = NULL;
   TKStatus status = E_K_STATUS_ERROR;
   TKParserStatus parserStatus = E_K_ICPP_PARSER_STATUS_ERROR;
-  uint8_t aClearMsg[C_K__ICPP_MSG_MAX_SIZE] = {0};
+  uint8_t* pClearMsg = NULL;
   uint8_t aLifeCycleState[C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE] = {0x41, 0x43, 0x54, 0x49};
   size_t  xpLifeCycleStateLen = sizeof(aLifeCycleState);
   uint8_t stateIndex = 0;
   TKtaLifeCycleState lKtaLifeCycleState = E_LIFE_CYCLE_STATE_INIT;
 
   M_KTALOG__START("Start");
+  lRotSessionBegin();
+  (void)salStorageBegin();
 
   // REQ RQ_M-KTA-STRT-FN-0150(1) : Input Parameters Check
   // REQ RQ_M-KTA-STRT-CF-0160(1) : ICPP Message Max Size
-  if ((NULL == xpKs2ktaMsg) || (NULL == xpKta2ksMsg) || (NULL == xpKta2ksMsgLen) ||
-      (0u == *xpKta2ksMsgLen) || (C_K__ICPP_MSG_MAX_SIZE < xKs2ktaMsgLen))
+  if ((NULL == xpWorkspace) || (NULL == xpKs2ktaMsg) || (NULL == xpKta2ksMsg) ||
+      (NULL == xpKta2ksMsgLen) || (0u == *xpKta2ksMsgLen) ||
+      (C_K__ICPP_MSG_MAX_SIZE < xKs2ktaMsgLen))
   {
     M_KTALOG__ERR("Invalid parameter passed");
     status = E_K_STATUS_PARAMETER;
@@ -1145,73 +1459,187 @@ TKStatus ktaExchangeMessage
   }
 
   // REQ RQ_M-KTA-STRT-FN-0170(1) : Invalid KTA State
-  if (E_KTA_STATE_RUNNING != gKtaState)
+  if (E_KTA_STATE_RUNNING != xpInstance->ktaState)
   {
     M_KTALOG__ERR("Invalid KTA State");
     goto end;
   }
 
-  switch (gKtaLifeCycleState)
+  ktaArenaInit(&xpInstance->arena, xpWorkspace->aArena, sizeof(xpWorkspace->aArena));
+  pClearMsg = (uint8_t*)ktaArenaAlloc(&xpInstance->arena, C_K__ICPP_MSG_MAX_SIZE);
+  pRecvdProtoMessage = (TKIcppMessageView*)ktaArenaAlloc(&xpInstance->arena, sizeof(TKIcppMessageView));
+
+  if ((NULL == pClearMsg) || (NULL == pRecvdProtoMessage))
+  {
+    M_KTALOG__ERR("Not enough workspace for the exchange");
+    goto end;
+  }
+
+  switch (xpInstance->lifeCycleState)
   {
     case E_LIFE_CYCLE_STATE_SEALED:
       // REQ RQ_M-KTA-LCST-FN-0030(1) : Power off in SEALED|RUNNING state
       status = (xKs2ktaMsgLen == 0u) ?
-               lProcessSealedStateActivationRequest(xpKta2ksMsg, xpKta2ksMsgLen) :
-               lProcessSealedStateMessage(xpKs2ktaMsg, xKs2ktaMsgLen, xpKta2ksMsg, xpKta2ksMsgLen,
-                                          aClearMsg, sizeof(aClearMsg), &recvdProtoMessage, &parserStatus);
+               lProcessSealedStateActivationRequest(xpInstance, xpKta2ksMsg, xpKta2ksMsgLen) :
+               lProcessSealedStateMessage(xpInstance, xpKs2ktaMsg, xKs2ktaMsgLen, xpKta2ksMsg, xpKta2ksMsgLen,
+                                          pClearMsg, C_K__ICPP_MSG_MAX_SIZE, pRecvdProtoMessage, &parserStatus);
       break;
 
     case E_LIFE_CYCLE_STATE_ACTIVATED:
     case E_LIFE_CYCLE_STATE_PROVISIONED:
     case E_LIFE_CYCLE_STATE_CON_REQ:
-      M_KTALOG__DEBUG("Reading life cycle state from NVM...");
-
-      status = salStorageGetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
-                                  aLifeCycleState, &xpLifeCycleStateLen);
-      if ((E_K_STATUS_OK != status) || (0U == xpLifeCycleStateLen))
+      if (0u != xpInstance->isLifeCycleStateValid)
       {
-        M_KTALOG__ERR("Reading life cycle state from NVM failed, status = [%d]", status);
-        goto end;
+        lKtaLifeCycleState = xpInstance->lifeCycleState;
       }
-
-      for (; stateIndex < C_KTA_CONFIG__LIFE_CYCLE_MAX_STATE; stateIndex++)
+      else
       {
-        if (0 == memcmp(gaKtaLifeCycleNVMVData[stateIndex],
-                        aLifeCycleState, C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE))
+        M_KTALOG__DEBUG("Reading life cycle state from NVM...");
+
+        status = salStorageGetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
+                                    aLifeCycleState, &xpLifeCycleStateLen);
+        if ((E_K_STATUS_OK != status) || (0U == xpLifeCycleStateLen))
+        {
+          M_KTALOG__ERR("Reading life cycle state from NVM failed, status = [%d]", status);
+          goto end;
+        }
+
+        for (; stateIndex < C_KTA_CONFIG__LIFE_CYCLE_MAX_STATE; stateIndex++)
+        {
+          if (0 == memcmp(gaKtaLifeCycleNVMVData[stateIndex],
+                          aLifeCycleState, C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE))
+          {
+            lKtaLifeCycleState = (TKtaLifeCycleState)stateIndex;
+            M_KTALOG__ERR("Life cycle state found in storage, state = [%d]", lKtaLifeCycleState);
+            break;
+          }
+        }
+
+        if (lKtaLifeCycleState == xpInstance->lifeCycleState)
         {
-          lKtaLifeCycleState = (TKtaLifeCycleState)stateIndex;
-          M_KTALOG__ERR("Life cycle state found in storage, state = [%d]", lKtaLifeCycleState);
-          break;
+          xpInstance->isLifeCycleStateValid = 1u;
         }
       }
 
       // check stored lifecycle state and current lifecycle state
       if ((0 == xKs2ktaMsgLen) &&
-         (lKtaLifeCycleState != gKtaLifeCycleState))
+         (lKtaLifeCycleState != xpInstance->lifeCycleState))
       {
         M_KTALOG__DEBUG("KTA lifecycle state is invalid, device is in refurbish state...");
-        gKtaLifeCycleState = E_LIFE_CYCLE_STATE_SEALED;
+        xpInstance->lifeCycleState = E_LIFE_CYCLE_STATE_SEALED;
         *xpKta2ksMsgLen = 0;
-        gCommandStatus = E_K_KTA_KS_STATUS_REFURBISH;
+        xpInstance->commandStatus = E_K_KTA_KS_STATUS_REFURBISH;
         /* Reset the globals to inital value after refurbish. */
-        gKtaState = E_KTA_STATE_INITIAL;
-        gKtaIsPreActivated = 0;
-        status = E_K_STATUS_OK;
+        xpInstance->ktaState = E_KTA_STATE_INITIAL;
+        xpInstance->isPreActivated = 0;
+        /* Storage records read before the refurbish are stale. */
+        status = salStorageInvalidate();
+        (void)salRotInvalidateIdentity();
       }
       else
       {
-        status = lProcessActivatedState(xpKs2ktaMsg, xKs2ktaMsgLen, xpKta2ksMsg, xpKta2ksMsgLen,
-                                        aClearMsg, sizeof(aClearMsg), &recvdProtoMessage, &parserStatus);
+        status = lProcessActivatedState(xpInstance, xpKs2ktaMsg, xKs2ktaMsgLen, xpKta2ksMsg, xpKta2ksMsgLen,
+                                        pClearMsg, C_K__ICPP_MSG_MAX_SIZE, pRecvdProtoMessage, &parserStatus);
       }
       break;
 
     default:
       *xpKta2ksMsgLen = 0;
-      M_KTALOG__ERR("Invalid life cycle state, [%d]", gKtaLifeCycleState);
+      M_KTALOG__ERR("Invalid life cycle state, [%d]", xpInstance->lifeCycleState);
       break;
   }
 
 end:
+  if (xpInstance->arena.peak > xpInstance->workspacePeak)
+  {
+    xpInstance->workspacePeak = xpInstance->arena.peak;
+  }
+
+  /* The workspace belongs to the caller once the exchange is over. */
+  ktaArenaInit(&xpInstance->arena, NULL, 0u);
+  status = lCommitStorage(status);
+  lRotSessionEnd();
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktaGetWorkspacePeak
+ *
+ */
+TKStatus ktaGetWorkspacePeak
+(
+  size_t*  xpPeakSize
+)
+{
+  return ktaGetWorkspacePeakCtx(NULL, xpPeakSize);
+}
+
+/**
+ * @brief implement ktaGetWorkspacePeakCtx
+ *
+ */
+TKStatus ktaGetWorkspacePeakCtx
+(
+  TKtaContext*  xpContext,
+  size_t*  xpPeakSize
+)
+{
+  TKtaInstance* pInstance = lInstanceEnter(xpContext);
+  TKStatus status = E_K_STATUS_PARAMETER;
+
+  if (NULL != xpPeakSize)
+  {
+    *xpPeakSize = pInstance->workspacePeak;
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @brief implement ktaPrecompute
+ *
+ */
+TKStatus ktaPrecompute
+(
+  void
+)
+{
+  return ktaPrecomputeCtx(NULL);
+}
+
+/**
+ * @brief implement ktaPrecomputeCtx
+ *
+ */
+TKStatus ktaPrecomputeCtx
+(
+  TKtaContext*  xpContext
+)
+{
+  TKtaInstance* pInstance = lInstanceEnter(xpContext);
+  TKStatus status = E_K_STATUS_ERROR;
+
+  M_KTALOG__START("Start");
+
+  if ((E_KTA_STATE_STARTED != pInstance->ktaState) &&
+      (E_KTA_STATE_RUNNING != pInstance->ktaState))
+  {
+    M_KTALOG__ERR("Invalid KTA State");
+  }
+  else if (E_LIFE_CYCLE_STATE_SEALED != pInstance->lifeCycleState)
+  {
+    /* Nothing to prepare once activated. */
+    status = E_K_STATUS_OK;
+  }
+  else
+  {
+    lRotSessionBegin();
+    status = ktaActPrecompute();
+    lRotSessionEnd();
+  }
+
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -1221,11 +1649,6 @@ end:
  * @brief implement ktaGetObjectWithAssociation
  *
  */
-/**
- * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
- * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
- * Using goto for breaking during the error and return cases.
- **/
 TKStatus ktaGetObjectWithAssociation
 (
   uint32_t   xObjWithAssociationId,
@@ -1234,6 +1657,29 @@ TKStatus ktaGetObjectWithAssociation
   uint8_t*   xpOutData,
   size_t*    xpOutDataLen
 )
+{
+  return ktaGetObjectWithAssociationCtx(NULL, xObjWithAssociationId, xpAssociatedKeyId,
+                                        xpAssociatedObjId, xpOutData, xpOutDataLen);
+}
+
+/**
+ * @brief implement ktaGetObjectWithAssociationCtx
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+TKStatus ktaGetObjectWithAssociationCtx
+(
+  TKtaContext*  xpContext,
+  uint32_t      xObjWithAssociationId,
+  uint32_t*     xpAssociatedKeyId,
+  uint32_t*     xpAssociatedObjId,
+  uint8_t*      xpOutData,
+  size_t*       xpOutDataLen
+)
 {
   uint8_t                 aPsaStatus[4] = {0};
   TKSalObjAssociationInfo associationInfoOut = {0};
@@ -1254,6 +1700,7 @@ TKStatus ktaGetObjectWithAssociation
     goto end;
   }
 
+  (void)lInstanceEnter(xpContext);
   // REQ RQ_M-KTA-STRT-FN-0420(1) : Get Object with Association
   status = salObjectGetWithAssociation(xObjWithAssociationId,
                                         xpOutData,
@@ -1330,13 +1777,27 @@ end:
  * @brief implement ktaGetObject
  *
  */
+TKStatus ktaGetObject
+(
+  uint32_t          xIdentifier,
+  TKktaDataObject * xpObject
+)
+{
+  return ktaGetObjectCtx(NULL, xIdentifier, xpObject);
+}
+
+/**
+ * @brief implement ktaGetObjectCtx
+ *
+ */
 /**
  * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
  * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
  * Using goto for breaking during the error and return cases.
  **/
-TKStatus ktaGetObject
+TKStatus ktaGetObjectCtx
 (
+  TKtaContext*      xpContext,
   uint32_t          xIdentifier,
   TKktaDataObject * xpObject
 )
@@ -1356,6 +1817,7 @@ TKStatus ktaGetObject
     goto end;
   }
 
+  (void)lInstanceEnter(xpContext);
   // REQ RQ_M-KTA-STRT-FN-0310(1) : Get Object
   status = salObjectGet(objType,
                         xIdentifier,
@@ -1379,11 +1841,6 @@ end:
  * @brief implement ktaSignHash
  *
  */
-/**
- * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
- * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
- * Using goto for breaking during the error and return cases.
- **/
 TKStatus ktaSignHash
 (
   uint32_t  xKeyId,
@@ -1393,6 +1850,30 @@ TKStatus ktaSignHash
   uint32_t  xSignedHashOutBuffLen,
   size_t*   xpActualSignedHashOutLen
 )
+{
+  return ktaSignHashCtx(NULL, xKeyId, xpHash, xHashLen, xpSignedHashOutBuff,
+                        xSignedHashOutBuffLen, xpActualSignedHashOutLen);
+}
+
+/**
+ * @brief implement ktaSignHashCtx
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+TKStatus ktaSignHashCtx
+(
+  TKtaContext*  xpContext,
+  uint32_t      xKeyId,
+  uint8_t*      xpHash,
+  size_t        xHashLen,
+  uint8_t*      xpSignedHashOutBuff,
+  uint32_t      xSignedHashOutBuffLen,
+  size_t*       xpActualSignedHashOutLen
+)
 {
   TKStatus status = E_K_STATUS_ERROR;
 
@@ -1415,9 +1896,12 @@ TKStatus ktaSignHash
   }
 
   // REQ RQ_M-KTA-STRT-FN-0610(1) : Sign hash data
+  (void)lInstanceEnter(xpContext);
+  lRotSessionBegin();
   status = salSignHash(xKeyId, xpHash, xHashLen,
                         xpSignedHashOutBuff, xSignedHashOutBuffLen,
                         xpActualSignedHashOutLen);
+  lRotSessionEnd();
 
   if (E_K_STATUS_OK != status)
   {
@@ -1442,6 +1926,20 @@ TKStatus ktaKeyStreamStatus
   TKktaKeyStreamStatus*  xpKtaKSCmdStatus
 )
 {
+  return ktaKeyStreamStatusCtx(NULL, xpKtaKSCmdStatus);
+}
+
+/**
+ * @brief implement ktaKeyStreamStatusCtx
+ *
+ */
+TKStatus ktaKeyStreamStatusCtx
+(
+  TKtaContext*           xpContext,
+  TKktaKeyStreamStatus*  xpKtaKSCmdStatus
+)
+{
+  TKtaInstance*         pInstance = lInstanceEnter(xpContext);
   TKktaKeyStreamStatus  cmdStatus = E_K_KTA_KS_STATUS_NO_OPERATION;
   TKStatus              status = E_K_STATUS_ERROR;
 
@@ -1455,13 +1953,13 @@ TKStatus ktaKeyStreamStatus
   }
   else
   {
-    cmdStatus = gCommandStatus;
+    cmdStatus = pInstance->commandStatus;
     // REQ RQ_M-KTA-STRT-FN-0510(1) : Get Key Stream Status
     *xpKtaKSCmdStatus = cmdStatus;
 
-    if (gCommandStatus != E_K_KTA_KS_STATUS_REFURBISH)
+    if (pInstance->commandStatus != E_K_KTA_KS_STATUS_REFURBISH)
     {
-      gCommandStatus = E_K_KTA_KS_STATUS_NO_OPERATION;
+      pInstance->commandStatus = E_K_KTA_KS_STATUS_NO_OPERATION;
     }
 
     status = E_K_STATUS_OK;
@@ -1471,15 +1969,67 @@ TKStatus ktaKeyStreamStatus
   return status;
 }
 
+/**
+ * @brief implement ktaRevalidateLifeCycleState
+ *
+ */
+void ktaRevalidateLifeCycleState
+(
+  void
+)
+{
+  ktaRevalidateLifeCycleStateCtx(NULL);
+}
+
+/**
+ * @brief implement ktaRevalidateLifeCycleStateCtx
+ *
+ */
+void ktaRevalidateLifeCycleStateCtx
+(
+  TKtaContext*  xpContext
+)
+{
+  TKtaInstance* pInstance = lInstanceEnter(xpContext);
+
+  pInstance->isLifeCycleStateValid = 0u;
+  (void)salStorageInvalidate();
+}
+
+/**
+ * @brief implement ktaContextInit
+ *
+ */
+TKStatus ktaContextInit
+(
+  TKtaContext*  xpContext,
+  void*         xpSalDevice
+)
+{
+  TKStatus status = E_K_STATUS_PARAMETER;
+  TKtaContextState* pState = NULL;
+  const TKtaInstance initInstance = M_KTA_INSTANCE_INIT;
+
+  if (NULL != xpContext)
+  {
+    pState = (TKtaContextState*)(void*)xpContext->aOpaque;
+    (void)memset(pState, 0, sizeof(TKtaContextState));
+    pState->instance = initInstance;
+    status = salContextInit(&pState->sal, xpSalDevice);
+  }
+
+  return status;
+}
+
 #ifdef TEST_COVERAGE
 void ktaReset
 (
   void
 )
 {
-  gKtaState = E_KTA_STATE_INITIAL;
-  gKtaLifeCycleState = E_LIFE_CYCLE_STATE_INIT;
-  gKtaIsPreActivated = 0u;
+  const TKtaInstance initInstance = M_KTA_INSTANCE_INIT;
+
+  gKtaInstance = initInstance;
   ktaResetConfig();
 }
 #endif
@@ -1498,12 +2048,28 @@ void ktaReset
  **/
 static TKStatus lgetNVMLifeCycleState
 (
+  TKtaInstance*  xpInstance,
   size_t*  xpLifeCycleStateLen
 )
 {
   TKStatus  status = E_K_STATUS_ERROR;
   uint8_t   stateIndex = 0;
   uint8_t   aLifeCycleState[C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE] = {0x00, 0x00, 0x00, 0x00};
+  uint8_t   isCommitComplete = 1u;
+
+  xpInstance->isLifeCycleStateValid = 0u;
+
+  /* One block read checks the last commit and fills the RAM copy of the state. */
+  if (E_K_STATUS_OK != salStorageCheck(&isCommitComplete))
+  {
+    M_KTALOG__WARN("Storage commit not checked");
+  }
+
+  /* The state read below is the one of the last complete commit. */
+  if (0u == isCommitComplete)
+  {
+    M_KTALOG__WARN("Interrupted storage commit rolled back");
+  }
 
   status = salStorageGetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
                               aLifeCycleState, xpLifeCycleStateLen);
@@ -1530,7 +2096,7 @@ static TKStatus lgetNVMLifeCycleState
     if (0 == memcmp(gaKtaLifeCycleNVMVData[stateIndex],
                     aLifeCycleState, C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE))
     {
-      gKtaLifeCycleState = (TKtaLifeCycleState)stateIndex;
+      xpInstance->lifeCycleState = (TKtaLifeCycleState)stateIndex;
       break;
     }
   }
@@ -1538,10 +2104,7 @@ static TKStatus lgetNVMLifeCycleState
   if (stateIndex >= (C_KTA_CONFIG__LIFE_CYCLE_MAX_STATE - 1U))
   {
     M_KTALOG__WARN("Wrong life cycle state found in storage!! Setting to Init state");
-    (void)memset(aLifeCycleState, 0, C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE);
-    status = salStorageSetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
-                                aLifeCycleState,
-                                C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE);
+    status = lsetNVMLifeCycleState(xpInstance, E_LIFE_CYCLE_STATE_INIT);
 
     if (E_K_STATUS_OK != status)
     {
@@ -1550,18 +2113,43 @@ static TKStatus lgetNVMLifeCycleState
         status);
       goto end;
     }
-
-    gKtaLifeCycleState = E_LIFE_CYCLE_STATE_INIT;
   }
   else
   {
-    gKtaLifeCycleState = (TKtaLifeCycleState)stateIndex;
+    xpInstance->lifeCycleState = (TKtaLifeCycleState)stateIndex;
+    xpInstance->isLifeCycleStateValid = 1u;
   }
 
 end:
   return status;
 }
 
+/**
+ * @implements lsetNVMLifeCycleState
+ *
+ */
+static TKStatus lsetNVMLifeCycleState
+(
+  TKtaInstance*       xpInstance,
+  TKtaLifeCycleState  xLifeCycleState
+)
+{
+  TKStatus  status = E_K_STATUS_ERROR;
+
+  xpInstance->isLifeCycleStateValid = 0u;
+  status = salStorageSetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
+                              gaKtaLifeCycleNVMVData[xLifeCycleState],
+                              C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE);
+
+  if (E_K_STATUS_OK == status)
+  {
+    xpInstance->lifeCycleState = xLifeCycleState;
+    xpInstance->isLifeCycleStateValid = 1u;
+  }
+
+  return status;
+}
+
 /**
  * @implements lPrepareProcessingStatus
  *
@@ -1620,6 +2208,7 @@ static TKStatus lPrepareProcessingStatus
  **/
 static TKStatus lBuildProcessingStatusRespMsg
 (
+  TKtaInstance*   xpInstance,
   const uint8_t*  xpReceivedMsg,
   size_t          xReceivedMsgSize,
   uint32_t        xErrorCode,
@@ -1627,15 +2216,23 @@ static TKStatus lBuildProcessingStatusRespMsg
   size_t*         xpMessageToSendSize
 )
 {
-  TKIcppProtocolMessage sendProtoMessage = {0};
+  TKIcppProtocolMessage* pSendProtoMessage = NULL;
   TKStatus              status = E_K_STATUS_ERROR;
   uint8_t               aErrorCode[C_PROCESSING_ERROR_CODE_SIZE] = {0};
 
   aErrorCode[1] = (uint8_t)(xErrorCode & (uint32_t)0xFF);
 
+  pSendProtoMessage = (TKIcppProtocolMessage*)ktaArenaAlloc(&xpInstance->arena,
+                                                            sizeof(TKIcppProtocolMessage));
+  if (NULL == pSendProtoMessage)
+  {
+    M_KTALOG__ERR("Not enough workspace for the processing status");
+    goto end;
+  }
+
   if (E_K_ICPP_PARSER_STATUS_OK != ktaIcppParserDeserializeHeader(xpReceivedMsg,
       xReceivedMsgSize,
-      &sendProtoMessage))
+      pSendProtoMessage))
   {
     M_KTALOG__ERR("ICCP parser de-serialization of header failed");
     goto end;
@@ -1645,14 +2242,14 @@ static TKStatus lBuildProcessingStatusRespMsg
    * Fill the messgae type with "E_K_ICCP_PARSER_MESSAGE_TYPE_RESPONSE" to indicate it is
    * registration notification message type (client -> server).
    */
-  sendProtoMessage.msgType  = E_K_ICPP_PARSER_MESSAGE_TYPE_RESPONSE;
+  pSendProtoMessage->msgType  = E_K_ICPP_PARSER_MESSAGE_TYPE_RESPONSE;
 
   /* In case of parser error prepare data for processing command. */
   // REQ RQ_M-KTA-OBJM-FN-0261(1) : Check Command Processing Error
   // REQ RQ_M-KTA-OBJM-FN-0561(1) : Check Command Processing Error
   // REQ RQ_M-KTA-OBJM-FN-0761(1) : Check Command Processing Error
   // REQ RQ_M-KTA-OBJM-FN-0961(2) : Check Command Processing Error
-  status = lPrepareProcessingStatus(&sendProtoMessage,
+  status = lPrepareProcessingStatus(pSendProtoMessage,
                                     E_K_ICPP_PARSER_STATUS_ERROR,
                                     aErrorCode,
                                     (uint8_t)sizeof(aErrorCode));
@@ -1664,11 +2261,12 @@ static TKStatus lBuildProcessingStatusRespMsg
   }
 
   status = ktaGenerateResponse((C_GEN__SERIALIZE | C_GEN__PADDING |
-                                C_GEN__ENCRYPT | C_GEN__SIGNING), &sendProtoMessage,
+                                C_GEN__ENCRYPT | C_GEN__SIGNING), pSendProtoMessage,
                                 xpMessageToSend,
                                 xpMessageToSendSize);
 
 end:
+  ktaArenaRelease(&xpInstance->arena, pSendProtoMessage);
   return status;
 }
 
@@ -1683,16 +2281,17 @@ end:
  **/
 static TKStatus lPrepareNoOpNotificationRequest
 (
+  TKtaInstance*  xpInstance,
   uint8_t*  xpMessageToSend,
   size_t*   xpMessageToSendSize
 )
 {
   TKStatus              status                                     =  E_K_STATUS_ERROR;
   size_t                transactionIDLen                           =  C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES;
-  TKIcppProtocolMessage sendProtoMessage                           =  {0};
+  TKIcppProtocolMessage* pSendProtoMessage                         =  NULL;
   size_t                rotPublicUidLen                            =  C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES;
 #ifndef FOTA_ENABLE
-  uint8_t               aSerializeBuffer[C_K__ICPP_MSG_MAX_SIZE]   = {0};
+  uint8_t*              pSerializeBuffer                           = NULL;
   size_t                aSerializeBufferLen = C_K__ICPP_MSG_MAX_SIZE;
   TKParserStatus        parserStatus = E_K_ICPP_PARSER_STATUS_ERROR;
   uint8_t               aComputedMac[C_KTA_ACT__HMACSHA256_SIZE]   = {0};
@@ -1701,15 +2300,32 @@ static TKStatus lPrepareNoOpNotificationRequest
   uint32_t              fieldIndex                                 = 0;
 #endif // FOTA_ENABLE
 
+  pSendProtoMessage = (TKIcppProtocolMessage*)ktaArenaAlloc(&xpInstance->arena,
+                                                            sizeof(TKIcppProtocolMessage));
+  if (NULL == pSendProtoMessage)
+  {
+    M_KTALOG__ERR("Not enough workspace for the NoOp notification");
+    goto end;
+  }
+
+#ifndef FOTA_ENABLE
+  pSerializeBuffer = (uint8_t*)ktaArenaAlloc(&xpInstance->arena, C_K__ICPP_MSG_MAX_SIZE);
+  if (NULL == pSerializeBuffer)
+  {
+    M_KTALOG__ERR("Not enough workspace for the NoOp notification");
+    goto end;
+  }
+#endif // FOTA_ENABLE
+
   /**
    * Fill the messgae type with "E_K_ICPP_PARSER_MESSAGE_TYPE_NOTIFICATION" to indicate it is
    * device start scenario  (client -> server).
    */
   // REQ RQ_M-KTA-NOOP-FN-0050_03(1) : message type
-  sendProtoMessage.msgType  = E_K_ICPP_PARSER_MESSAGE_TYPE_NOTIFICATION;
+  pSendProtoMessage->msgType  = E_K_ICPP_PARSER_MESSAGE_TYPE_NOTIFICATION;
   /* Retrive rot key set ID from NVM. */
   // REQ RQ_M-KTA-NOOP-FN-0050_05(1) : rot key set id
-  status = ktaGetRotKeySetId(&(sendProtoMessage.rotKeySetId));
+  status = ktaGetRotKeySetId(&(pSendProtoMessage->rotKeySetId));
   if (E_K_STATUS_OK != status)
   {
     M_KTALOG__ERR("Retrieval of rot key set ID from NVM failed, status = [%d]", status);
@@ -1718,13 +2334,13 @@ static TKStatus lPrepareNoOpNotificationRequest
 
   /* Fill the crypto version to use (for activation request dos based encryption is used). */
   // REQ RQ_M-KTA-NOOP-FN-0050_01(1) : crypto version
-  sendProtoMessage.cryptoVersion  = E_K_ICPP_PARSER_CRYPTO_TYPE_L2_BASED;
+  pSendProtoMessage->cryptoVersion  = E_K_ICPP_PARSER_CRYPTO_TYPE_L2_BASED;
   /* Fill the mode of encryption (for no ops full encryption is used). */
   // REQ RQ_M-KTA-NOOP-FN-0050_02(1) : partial encryption mode
-  sendProtoMessage.encMode  = E_K_ICPP_PARSER_FULL_ENC_MODE;
+  pSendProtoMessage->encMode  = E_K_ICPP_PARSER_FULL_ENC_MODE;
   /* Fill the random transaction ID. */
   // REQ RQ_M-KTA-NOOP-FN-0050_04(1) : transaction id
-  status = salCryptoGetRandom(sendProtoMessage.transactionId,
+  status = salCryptoGetRandom(pSendProtoMessage->transactionId,
                               &transactionIDLen);
 
   if (E_K_STATUS_OK != status)
@@ -1735,20 +2351,20 @@ static TKStatus lPrepareNoOpNotificationRequest
 
   // REQ RQ_M-KTA-NOOP-FN-0050_06(1) : rot public uid
   status = salStorageGetValue(C_K_KTA__ROT_PUBLIC_UID_STORAGE_ID,
-                              sendProtoMessage.rotPublicUID,
+                              pSendProtoMessage->rotPublicUID,
                               &rotPublicUidLen);
 
   if ((E_K_STATUS_OK != status) && (0u == rotPublicUidLen))
   {
     M_KTALOG__ERR("rotPubUID reading failed, status = [%d], rotPubUidLen = [%d]",
                   status, rotPublicUidLen);
-    (void)memset(sendProtoMessage.rotPublicUID,
+    (void)memset(pSendProtoMessage->rotPublicUID,
                   0x00,
                   C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES);
   }
 
 #ifdef FOTA_ENABLE
-  status = salDeviceGetInfo(sendProtoMessage.xComponents);
+  status = salDeviceGetInfo(pSendProtoMessage->xComponents);
 
   // Check if the device info was successfully retrieved
   if (E_K_STATUS_OK != status)
@@ -1760,54 +2376,54 @@ static TKStatus lPrepareNoOpNotificationRequest
   // Fill the xComponents array
   for (; startIndex < COMPONENTS_MAX; startIndex++)
   {
-    sendProtoMessage.xComponents[startIndex] = sendProtoMessage.xComponents[startIndex];
+    pSendProtoMessage->xComponents[startIndex] = pSendProtoMessage->xComponents[startIndex];
   }
 
   // Fill the component information.
-  sendProtoMessage.commandsCount = 1;
-  sendProtoMessage.commands[0].commandTag = E_K_ICPP_PARSER_COMMAND_TAG_DEVICE_INFO;
+  pSendProtoMessage->commandsCount = 1;
+  pSendProtoMessage->commands[0].commandTag = E_K_ICPP_PARSER_COMMAND_TAG_DEVICE_INFO;
 
   const char* ktaVersion = (const char*)ktaGetVersion();
-  sendProtoMessage.commands[0].data.fieldList.fields[fieldIndex].fieldTag  =
+  pSendProtoMessage->commands[0].data.fieldList.fields[fieldIndex].fieldTag  =
   E_K_ICPP_PARSER_FIELD_TAG_KTA_VER;
-  sendProtoMessage.commands[0].data.fieldList.fields[fieldIndex].fieldLen  =
+  pSendProtoMessage->commands[0].data.fieldList.fields[fieldIndex].fieldLen  =
   strlen(ktaVersion);
-  sendProtoMessage.commands[0].data.fieldList.fields[fieldIndex].fieldValue =
+  pSendProtoMessage->commands[0].data.fieldList.fields[fieldIndex].fieldValue =
   (uint8_t*)ktaVersion;
   fieldIndex++;
 
   // Fill the FOTA component target and version fields in a loop.
   for (uint32_t i = 0; i < COMPONENTS_MAX; i++)
   {
-    if ((sendProtoMessage.xComponents[i].componentNameLen > 0) && (sendProtoMessage.xComponents[i].componentVersionLen > 0))
+    if ((pSendProtoMessage->xComponents[i].componentNameLen > 0) && (pSendProtoMessage->xComponents[i].componentVersionLen > 0))
     {
       // Fill the FOTA component target field.
-      sendProtoMessage.commands[0].data.fieldList.fields[fieldIndex].fieldTag =
+      pSendProtoMessage->commands[0].data.fieldList.fields[fieldIndex].fieldTag =
       E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET;
-      sendProtoMessage.commands[0].data.fieldList.fields[fieldIndex].fieldLen =
-      sendProtoMessage.xComponents[i].componentNameLen;
-      sendProtoMessage.commands[0].data.fieldList.fields[fieldIndex].fieldValue =
-      sendProtoMessage.xComponents[i].componentName;
+      pSendProtoMessage->commands[0].data.fieldList.fields[fieldIndex].fieldLen =
+      pSendProtoMessage->xComponents[i].componentNameLen;
+      pSendProtoMessage->commands[0].data.fieldList.fields[fieldIndex].fieldValue =
+      pSendProtoMessage->xComponents[i].componentName;
       fieldIndex++;
 
       // Fill the FOTA component version field.
-      sendProtoMessage.commands[0].data.fieldList.fields[fieldIndex].fieldTag =
+      pSendProtoMessage->commands[0].data.fieldList.fields[fieldIndex].fieldTag =
       E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION;
-      sendProtoMessage.commands[0].data.fieldList.fields[fieldIndex].fieldLen =
-      sendProtoMessage.xComponents[i].componentVersionLen;
-      sendProtoMessage.commands[0].data.fieldList.fields[fieldIndex].fieldValue =
-      sendProtoMessage.xComponents[i].componentVersion;
+      pSendProtoMessage->commands[0].data.fieldList.fields[fieldIndex].fieldLen =
+      pSendProtoMessage->xComponents[i].componentVersionLen;
+      pSendProtoMessage->commands[0].data.fieldList.fields[fieldIndex].fieldValue =
+      pSendProtoMessage->xComponents[i].componentVersion;
       fieldIndex++;
     }
   }
 
   // Update the fields count
-  sendProtoMessage.commands[0].data.fieldList.fieldsCount = fieldIndex;
+  pSendProtoMessage->commands[0].data.fieldList.fieldsCount = fieldIndex;
 
   // Call ktaGenerateResponse after filling all the tags and data
   status = ktaGenerateResponse((C_GEN__SERIALIZE | C_GEN__PADDING |
                                 C_GEN__ENCRYPT | C_GEN__SIGNING),
-                                &sendProtoMessage,
+                                pSendProtoMessage,
                                 xpMessageToSend,
                                 xpMessageToSendSize);
 
@@ -1817,12 +2433,12 @@ static TKStatus lPrepareNoOpNotificationRequest
     goto end;
   }
 #else
-  sendProtoMessage.commandsCount = 0;
+  pSendProtoMessage->commandsCount = 0;
 
   M_KTALOG__DEBUG("ICCP parser serializing the message...");
   // REQ RQ_M-KTA-NOOP-FN-0060(1) : Serialize NoOP Message
-  parserStatus = ktaIcppParserSerializeMessage(&sendProtoMessage,
-                                               aSerializeBuffer,
+  parserStatus = ktaIcppParserSerializeMessage(pSendProtoMessage,
+                                               pSerializeBuffer,
                                                &aSerializeBufferLen);
 
   if (E_K_ICPP_PARSER_STATUS_OK != parserStatus)
@@ -1834,7 +2450,7 @@ static TKStatus lPrepareNoOpNotificationRequest
 
   M_KTALOG__DEBUG("KTA cipher signing the message...");
   // REQ RQ_M-KTA-NOOP-FN-0070(1) : Sign the encrypted NoOP response message
-  status = ktacipherSignMsg(aSerializeBuffer, aSerializeBufferLen, aComputedMac);
+  status = ktacipherSignMsg(pSerializeBuffer, aSerializeBufferLen, aComputedMac);
 
   if (E_K_STATUS_OK != status)
   {
@@ -1842,7 +2458,7 @@ static TKStatus lPrepareNoOpNotificationRequest
     goto end;
   }
 
-  (void)memcpy(xpMessageToSend, aSerializeBuffer, aSerializeBufferLen);
+  (void)memcpy(xpMessageToSend, pSerializeBuffer, aSerializeBufferLen);
   (void)memcpy(&xpMessageToSend[aSerializeBufferLen], aComputedMac, C_KTA_ACT__HMACSHA256_SIZE);
   *xpMessageToSendSize =  aSerializeBufferLen + C_KTA_ACT__HMACSHA256_SIZE;
 #endif // FOTA_ENABLE
@@ -1850,6 +2466,7 @@ static TKStatus lPrepareNoOpNotificationRequest
   status = E_K_STATUS_OK;
 
 end:
+  ktaArenaRelease(&xpInstance->arena, pSendProtoMessage);
   return status;
 }
 
@@ -1859,7 +2476,8 @@ end:
  */
 static TKStatus lProcessNoOpLifecycleTransition
 (
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKtaInstance*           xpInstance,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   size_t*                 xpKta2ksMsgLen
 )
 {
@@ -1874,7 +2492,7 @@ static TKStatus lProcessNoOpLifecycleTransition
   }
 
   M_KTALOG__DEBUG("Received NoOp, reading life cycle state from NVM...");
-  status = lgetNVMLifeCycleState(&lifeCycleStateLen);
+  status = lgetNVMLifeCycleState(xpInstance, &lifeCycleStateLen);
 
   if ((E_K_STATUS_OK != status) || (0U == lifeCycleStateLen))
   {
@@ -1882,18 +2500,18 @@ static TKStatus lProcessNoOpLifecycleTransition
     return status;
   }
 
-  if (E_LIFE_CYCLE_STATE_SEALED == gKtaLifeCycleState)
+  if (E_LIFE_CYCLE_STATE_SEALED == xpInstance->lifeCycleState)
   {
     M_KTALOG__ERR("Device received refurbish command");
-    gCommandStatus = E_K_KTA_KS_STATUS_REFURBISH;
+    xpInstance->commandStatus = E_K_KTA_KS_STATUS_REFURBISH;
     /* Reset the globals to inital value after refurbish. */
-    gKtaState = E_KTA_STATE_INITIAL;
-    gKtaIsPreActivated = 0;
+    xpInstance->ktaState = E_KTA_STATE_INITIAL;
+    xpInstance->isPreActivated = 0;
     *xpKta2ksMsgLen = 0;
     return E_K_STATUS_OK;
   }
 
-  if (E_LIFE_CYCLE_STATE_CON_REQ == gKtaLifeCycleState)
+  if (E_LIFE_CYCLE_STATE_CON_REQ == xpInstance->lifeCycleState)
   {
     /* Setting the state to connection request. */
     M_KTALOG__DEBUG("Life cycle state reached to PROVISIONED state, "
@@ -1902,9 +2520,7 @@ static TKStatus lProcessNoOpLifecycleTransition
     // REQ RQ_M-KTA-LCST-FN-0040(1) : Power off in SEALED|STARTED state
     // REQ RQ_M-KTA-LCST-FN-0030(1) : Power off in SEALED|RUNNING state
     // REQ RQ_M-KTA-LCST-FN-0075(1) : Power off in CON_REQ|RUNNING state
-    status = salStorageSetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
-                                gaKtaLifeCycleNVMVData[E_LIFE_CYCLE_STATE_PROVISIONED],
-                                C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE);
+    status = lsetNVMLifeCycleState(xpInstance, E_LIFE_CYCLE_STATE_PROVISIONED);
 
     if (E_K_STATUS_OK != status)
     {
@@ -1913,22 +2529,19 @@ static TKStatus lProcessNoOpLifecycleTransition
       return status;
     }
 
-    gKtaLifeCycleState = E_LIFE_CYCLE_STATE_PROVISIONED;
-    M_KTALOG__INFO("Setting KTA Lifecycle state to PROVISIONED, state = [%d]", gKtaLifeCycleState);
+    M_KTALOG__INFO("Setting KTA Lifecycle state to PROVISIONED, state = [%d]", xpInstance->lifeCycleState);
     return E_K_STATUS_OK;
   }
 
   /* Break the chain no communication is needed. */
-  if (gKtaLifeCycleState == E_LIFE_CYCLE_STATE_ACTIVATED)
+  if (xpInstance->lifeCycleState == E_LIFE_CYCLE_STATE_ACTIVATED)
   {
     M_KTALOG__DEBUG("Life cycle state reached to PROVISIONED state, "
                     "storing in persist memory");
     // REQ RQ_M-KTA-LCST-FN-0065(1) : Power off in PROVISIONED|INITIALIZED state
     // REQ RQ_M-KTA-LCST-FN-0070(1) : Power off in PROVISIONED|STARTED state
     // REQ RQ_M-KTA-LCST-FN-0060(1) : Power off in PROVISIONED|RUNNING state
-    status = salStorageSetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
-                                gaKtaLifeCycleNVMVData[E_LIFE_CYCLE_STATE_PROVISIONED],
-                                C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE);
+    status = lsetNVMLifeCycleState(xpInstance, E_LIFE_CYCLE_STATE_PROVISIONED);
 
     if (E_K_STATUS_OK != status)
     {
@@ -1936,8 +2549,7 @@ static TKStatus lProcessNoOpLifecycleTransition
       return status;
     }
 
-    gKtaLifeCycleState = E_LIFE_CYCLE_STATE_PROVISIONED;
-    gCommandStatus = E_K_KTA_KS_STATUS_NO_OPERATION;
+    xpInstance->commandStatus = E_K_KTA_KS_STATUS_NO_OPERATION;
     M_KTALOG__DEBUG("Lifecycle provised and E_K_KTA_KS_STATUS_NO_OPERATION");
   }
 
@@ -1955,13 +2567,14 @@ static TKStatus lProcessNoOpLifecycleTransition
  **/
 static TKStatus lCheckKs2KtaMessage
 (
+  TKtaInstance*           xpInstance,
   const uint8_t*          xpKs2ktaMsg,
   size_t                  xKs2ktaMsgLen,
   uint8_t*                xpKta2ksMsg,
   size_t*                 xpKta2ksMsgLen,
   uint8_t*                xpClearMsg,
   size_t                  xClearMsgLen,
-  TKIcppProtocolMessage*  xpRecvdProtoMessage,
+  TKIcppMessageView*      xpRecvdProtoMessage,
   TKParserStatus*         xpParserStatus
 )
 {
@@ -2017,7 +2630,7 @@ static TKStatus lCheckKs2KtaMessage
       /* Prepare error in case of decryption or remove padding error. */
       // REQ RQ_M-KTA-TRDP-FN-0040(1) :
       /* Prepare error in case of decryption or remove padding error. */
-      (void)lBuildProcessingStatusRespMsg(xpKs2ktaMsg,
+      (void)lBuildProcessingStatusRespMsg(xpInstance, xpKs2ktaMsg,
                                               xKs2ktaMsgLen,
                                               C_MSG_AUTH_DEC_ERROR,
                                               xpKta2ksMsg,
@@ -2053,7 +2666,7 @@ static TKStatus lCheckKs2KtaMessage
       // error.
       // REQ RQ_M-KTA-TRDP-FN-0040(1) : Prepare error in case of decryption or remove padding
       // error.
-      (void)lBuildProcessingStatusRespMsg(xpKs2ktaMsg,
+      (void)lBuildProcessingStatusRespMsg(xpInstance, xpKs2ktaMsg,
                                               xKs2ktaMsgLen,
                                               C_MSG_AUTH_DEC_ERROR,
                                               xpKta2ksMsg,
@@ -2085,13 +2698,13 @@ static TKStatus lCheckKs2KtaMessage
   // REQ RQ_M-KTA-OBJM-FN-0950(2) : Deserialize the decrypted key object data
   // REQ RQ_M-KTA-TRDP-FN-0050(1) : Deserialize the decrypted Third party data.
   // REQ RQ_M-KTA-OBJM-FN-0870(1): Desrialize the Get Challenge command.
-  *xpParserStatus = ktaIcppParserDeserializeMessage(xpClearMsg, clearMsgLength, xpRecvdProtoMessage);
+  *xpParserStatus = ktaIcppParserDeserializeView(xpClearMsg, clearMsgLength, xpRecvdProtoMessage);
 
   switch (*xpParserStatus)
   {
     case E_K_ICPP_PARSER_STATUS_NO_OPERATION:
       // REQ RQ_M-KTA-STRT-FN-0270(1) : Process the NoOP Message received after ThirdParty/Object Commands.
-      status = lProcessNoOpLifecycleTransition(xpRecvdProtoMessage, xpKta2ksMsgLen);
+      status = lProcessNoOpLifecycleTransition(xpInstance, xpRecvdProtoMessage, xpKta2ksMsgLen);
       break;
 
     case E_K_ICPP_PARSER_STATUS_ERROR:
@@ -2103,7 +2716,7 @@ static TKStatus lCheckKs2KtaMessage
       // REQ RQ_M-KTA-OBJM-FN-0760(1) : Error in Deserialization.
       // REQ RQ_M-KTA-OBJM-FN-0960(2) : Error in Deserialization
       // REQ RQ_M-KTA-TRDP-FN-0060(1) : Error in Deserialization.
-      status = lBuildProcessingStatusRespMsg(xpKs2ktaMsg, xKs2ktaMsgLen, C_MSG_FORMAT_ERROR,
+      status = lBuildProcessingStatusRespMsg(xpInstance, xpKs2ktaMsg, xKs2ktaMsgLen, C_MSG_FORMAT_ERROR,
                                               xpKta2ksMsg, xpKta2ksMsgLen);
       break;
 
@@ -2114,9 +2727,9 @@ static TKStatus lCheckKs2KtaMessage
 
     case E_K_ICPP_PARSER_STATUS_OK:
       M_KTALOG__DEBUG("Received E_K_ICPP_PARSER_STATUS_OK");
-      if (E_LIFE_CYCLE_STATE_CON_REQ == gKtaLifeCycleState)
+      if (E_LIFE_CYCLE_STATE_CON_REQ == xpInstance->lifeCycleState)
       {
-        gCommandStatus = E_K_KTA_KS_STATUS_RENEW;
+        xpInstance->commandStatus = E_K_KTA_KS_STATUS_RENEW;
       }
       status = E_K_STATUS_OK;
       break;
@@ -2130,6 +2743,97 @@ end:
   return status;
 }
 
+/**
+ * @implements lCommitStorage
+ *
+ */
+static TKStatus lCommitStorage
+(
+  TKStatus  xStatus
+)
+{
+  TKStatus status = xStatus;
+
+  if (E_K_STATUS_OK != salStorageCommit())
+  {
+    M_KTALOG__ERR("Storage records not written");
+    status = E_K_STATUS_ERROR;
+  }
+
+  return status;
+}
+
+/**
+ * @implements lRotSessionBegin
+ *
+ */
+static void lRotSessionBegin
+(
+  void
+)
+{
+  TKStatus status = salRotSessionBegin();
+
+  if (E_K_STATUS_NOT_SUPPORTED == status)
+  {
+    M_KTALOG__DEBUG("No secure element session on the device");
+  }
+  else if (E_K_STATUS_OK != status)
+  {
+    M_KTALOG__WARN("Secure element session not opened, status = [%d]", status);
+  }
+  else
+  {
+    /* Session open. */
+  }
+}
+
+/**
+ * @implements lRotSessionEnd
+ *
+ */
+static void lRotSessionEnd
+(
+  void
+)
+{
+  TKStatus status = salRotSessionEnd();
+
+  if ((E_K_STATUS_OK != status) && (E_K_STATUS_NOT_SUPPORTED != status))
+  {
+    M_KTALOG__ERR("Secure element session not closed, status = [%d]", status);
+  }
+}
+
+/**
+ * @implements lInstanceEnter
+ *
+ */
+static TKtaInstance* lInstanceEnter
+(
+  TKtaContext*  xpContext
+)
+{
+  TKtaContextState* pState = NULL;
+  TKtaInstance* pInstance = &gKtaInstance;
+
+  if (NULL != xpContext)
+  {
+    pState = (TKtaContextState*)(void*)xpContext->aOpaque;
+    pInstance = &pState->instance;
+  }
+
+  /* The built-in instance runs on the built-in module and SAL states. */
+  ktaConfigBindState((NULL == pState) ? NULL : &pState->config);
+  ktaActBindState((NULL == pState) ? NULL : &pState->act);
+#ifdef FOTA_ENABLE
+  fotaProcessBindState((NULL == pState) ? NULL : &pState->fota);
+#endif
+  salContextBind((NULL == pState) ? NULL : &pState->sal);
+
+  return pInstance;
+}
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
@@ -0,0 +1,91 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief keySTREAM Trusted Agent manager - static workspace entry point.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file ktamgr_legacy.c
+ ******************************************************************************/
+
+/**
+ * @brief keySTREAM Trusted Agent manager - static workspace entry point.
+ *
+ * Kept apart from ktamgr.c so that an application calling only
+ * ktaExchangeMessageEx() does not link the static workspace.
+ */
+#include "k_kta.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+/* Workspace of ktaExchangeMessage(), too large for the stack of small targets. */
+static TKtaWorkspace gKtaWorkspace;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief implement ktaExchangeMessage
+ *
+ */
+TKStatus ktaExchangeMessage
+(
+  const uint8_t*  xpKs2ktaMsg,
+  size_t          xKs2ktaMsgLen,
+  uint8_t*        xpKta2ksMsg,
+  size_t*         xpKta2ksMsgLen
+)
+{
+  return ktaExchangeMessageEx(&gKtaWorkspace, xpKs2ktaMsg, xKs2ktaMsgLen,
+                              xpKta2ksMsg, xpKta2ksMsgLen);
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -108,6 +108,10 @@ typedef struct
 #if LOG_KTA_ENABLE != C_KTA_LOG_LEVEL_NONE
 static const char *gpModuleName = "KTAACTHANDLER";
 #endif
+/* Activation state of the built-in instance. */
+static TKtaActState gKtaActState = {0};
+/* Activation state of the instance served by the calling thread. */
+static K_THREAD_LOCAL TKtaActState* gpKtaActState = &gKtaActState;
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
@@ -266,7 +270,7 @@ static TKStatus lPrepareActivationRequest
  */
 static TKStatus lActRespValidateAndGetPayload
 (
-  TKIcppProtocolMessage *xpRecvMsg,
+  TKIcppMessageView *xpRecvMsg,
   TKactRespPayload *xpActRespPayload
 );
 
@@ -293,6 +297,56 @@ static TKStatus lActRespDeriveL1Key
 /* -------------------------------------------------------------------------- */
 /* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
 /* -------------------------------------------------------------------------- */
+/**
+ * @brief implement ktaActPrecompute
+ *
+ */
+TKStatus ktaActPrecompute
+(
+  void
+)
+{
+  TKactreqPayload actPayload = {0};
+  TKStatus status = E_K_STATUS_OK;
+
+  M_KTALOG__START("Start");
+
+  if (0u == gpKtaActState->isRotEpkReady)
+  {
+    status = salRotKeyPairGeneration(gpKtaActState->aRotEpk);
+
+    if (E_K_STATUS_OK != status)
+    {
+      M_KTALOG__ERR("SAL API while generation key pair failed, status = [%d]", status);
+    }
+    else
+    {
+      gpKtaActState->isRotEpkReady = 1u;
+    }
+  }
+
+  if (E_K_STATUS_OK == status)
+  {
+    /* The SAL keeps the chip UID and certificate once read. */
+    status = lFetchActivationReqData(&actPayload);
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktaActBindState
+ *
+ */
+void ktaActBindState
+(
+  TKtaActState* xpState
+)
+{
+  gpKtaActState = (NULL == xpState) ? &gKtaActState : xpState;
+}
+
 /**
  * @brief implement ktaActDeriveL2Keys
  *
@@ -329,16 +383,17 @@ TKStatus ktaActDeriveL2Keys
  **/
 TKStatus ktaActBuildActivationRequest
 (
+  TKtaArena* xpArena,
   uint8_t *xpMessageToSend,
   size_t *xpMessageToSendSize
 )
 {
-  TKIcppProtocolMessage protoMessage = {0};
+  TKIcppProtocolMessage* pProtoMessage = NULL;
   TKactreqPayload actPayload = {0};
   size_t paddedMsgLen = C_DEV_PROF_PAD_MAX_LEN;
   uint8_t aEncMsg[C_K__MAX_DEVICE_PROFILES][C_DEV_PROF_PAD_MAX_LEN] = {0};
   size_t aEncMsgLen[C_K__MAX_DEVICE_PROFILES] = {C_DEV_PROF_PAD_MAX_LEN, C_DEV_PROF_PAD_MAX_LEN};
-  uint8_t aSerializeBuffer[C_K__ICPP_MSG_MAX_SIZE] = {0};
+  uint8_t* pSerializeBuffer = NULL;
   size_t serializeBufferLen = C_K__ICPP_MSG_MAX_SIZE;
   uint8_t aComputedMac[C_KTA_ACT__HMACSHA256_SIZE] = {0};
   size_t transactionIDLen = C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES;
@@ -348,7 +403,7 @@ TKStatus ktaActBuildActivationRequest
   const uint8_t aRotSolID[C_KTA__ROT_SOL_ID_SIZE] = C_KTA__ROT_SOL_ID;
   size_t rotPublicUidLen = C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES;
   uint8_t maxDevProfiles = C_K__MAX_DEVICE_PROFILES;
-  uint8_t* aPaddedMsg = aSerializeBuffer;
+  uint8_t* aPaddedMsg = NULL;
 
   M_KTALOG__START("Start");
 
@@ -359,8 +414,29 @@ TKStatus ktaActBuildActivationRequest
     return E_K_STATUS_PARAMETER;
   }
 
+  pProtoMessage = (TKIcppProtocolMessage*)ktaArenaAlloc(xpArena, sizeof(TKIcppProtocolMessage));
+  pSerializeBuffer = (uint8_t*)ktaArenaAlloc(xpArena, C_K__ICPP_MSG_MAX_SIZE);
+  if ((NULL == pProtoMessage) || (NULL == pSerializeBuffer))
+  {
+    M_KTALOG__ERR("Not enough workspace for the activation request");
+    goto end;
+  }
+
+  aPaddedMsg = pSerializeBuffer;
+
   // REQ RQ_M-KTA-ACTV-FN-0005_02(1) : Rot Ephemeral Public Key
-  status = salRotKeyPairGeneration(actPayload.aRotEpk);
+  if (0u != gpKtaActState->isRotEpkReady)
+  {
+    /* Single use: the next request generates a new key pair. */
+    (void)memcpy(actPayload.aRotEpk, gpKtaActState->aRotEpk, C_K_KTA__PUBLIC_KEY_MAX_SIZE);
+    gpKtaActState->isRotEpkReady = 0u;
+    status = E_K_STATUS_OK;
+  }
+  else
+  {
+    status = salRotKeyPairGeneration(actPayload.aRotEpk);
+  }
+
   if (E_K_STATUS_OK != status)
   {
     M_KTALOG__ERR("SAL API while generation key pair failed, status = [%d]", status);
@@ -430,14 +506,14 @@ TKStatus ktaActBuildActivationRequest
   }
 
   // REQ RQ_M-KTA-ACTV-FN-0020_01(1) : Activation crypto version
-  protoMessage.cryptoVersion = E_K_ICPP_PARSER_CRYPTO_TYPE_DOS_BASED;
+  pProtoMessage->cryptoVersion = E_K_ICPP_PARSER_CRYPTO_TYPE_DOS_BASED;
   // REQ RQ_M-KTA-ACTV-FN-0020_02(1) : Activation partial encryption mode
-  protoMessage.encMode = E_K_ICPP_PARSER_PARTIAL_ENC_MODE;
+  pProtoMessage->encMode = E_K_ICPP_PARSER_PARTIAL_ENC_MODE;
   // REQ RQ_M-KTA-ACTV-FN-0020_03(1) : Activation message type
-  protoMessage.msgType = E_K_ICPP_PARSER_MESSAGE_TYPE_NOTIFICATION;
+  pProtoMessage->msgType = E_K_ICPP_PARSER_MESSAGE_TYPE_NOTIFICATION;
 
   // REQ RQ_M-KTA-ACTV-FN-0020_04(1) : Activation transaction id
-  status = salCryptoGetRandom(protoMessage.transactionId, &transactionIDLen);
+  status = salCryptoGetRandom(pProtoMessage->transactionId, &transactionIDLen);
   if (E_K_STATUS_OK != status)
   {
     M_KTALOG__ERR("salCryptoGetRandom failed to get transaction ID, status = [%d]", status);
@@ -445,24 +521,24 @@ TKStatus ktaActBuildActivationRequest
   }
 
   // REQ RQ_M-KTA-ACTV-FN-0020_05(1) : Activation rot key set id
-  protoMessage.rotKeySetId = 0x00;
+  pProtoMessage->rotKeySetId = 0x00;
 
   // REQ RQ_M-KTA-ACTV-FN-0020_06(1) : Activation rot public uid
-  status = salStorageGetValue(C_K_KTA__ROT_PUBLIC_UID_STORAGE_ID, protoMessage.rotPublicUID, &rotPublicUidLen);
+  status = salStorageGetValue(C_K_KTA__ROT_PUBLIC_UID_STORAGE_ID, pProtoMessage->rotPublicUID, &rotPublicUidLen);
   if ((E_K_STATUS_OK != status) && (0u == rotPublicUidLen))
   {
     M_KTALOG__ERR("SAL API failed while reading rotPublicUID, status = [%d]", status);
     goto end;
   }
 
-  if (memcmp(protoMessage.rotPublicUID, aRotSolID, C_KTA__ROT_SOL_ID_SIZE) != 0)
+  if (memcmp(pProtoMessage->rotPublicUID, aRotSolID, C_KTA__ROT_SOL_ID_SIZE) != 0)
   {
-    memset(protoMessage.rotPublicUID, 0, rotPublicUidLen);
-    memcpy(protoMessage.rotPublicUID, aRotSolID, C_KTA__ROT_SOL_ID_SIZE);
+    memset(pProtoMessage->rotPublicUID, 0, rotPublicUidLen);
+    memcpy(pProtoMessage->rotPublicUID, aRotSolID, C_KTA__ROT_SOL_ID_SIZE);
   }
 
   // REQ RQ_M-KTA-ACTV-FN-0020(1) : Activation ICPP Message
-  status = lPrepareActivationRequest(&actPayload, aEncMsg, aEncMsgLen, &protoMessage);
+  status = lPrepareActivationRequest(&actPayload, aEncMsg, aEncMsgLen, pProtoMessage);
   if (E_K_STATUS_OK != status)
   {
     M_KTALOG__ERR("Prepare actRequest got failed, status = [%d]", status);
@@ -470,9 +546,9 @@ TKStatus ktaActBuildActivationRequest
   }
 
   // REQ RQ_M-KTA-ICPP-FN-0100(1) : Serialize the message
-  memset(aSerializeBuffer, 0, C_K__ICPP_MSG_MAX_SIZE);
+  memset(pSerializeBuffer, 0, C_K__ICPP_MSG_MAX_SIZE);
   serializeBufferLen = C_K__ICPP_MSG_MAX_SIZE;
-  parserStatus = ktaIcppParserSerializeMessage(&protoMessage, aSerializeBuffer, &serializeBufferLen);
+  parserStatus = ktaIcppParserSerializeMessage(pProtoMessage, pSerializeBuffer, &serializeBufferLen);
   if (E_K_ICPP_PARSER_STATUS_OK != parserStatus)
   {
     M_KTALOG__ERR("Serialization of message failed, parserStatus = [%d]", parserStatus);
@@ -481,18 +557,19 @@ TKStatus ktaActBuildActivationRequest
   }
 
   // REQ RQ_M-KTA-ACTV-FN-0050(1) : Sign the ICPP format raw buffer
-  status = ktacipherSignMsg(aSerializeBuffer, serializeBufferLen, aComputedMac);
+  status = ktacipherSignMsg(pSerializeBuffer, serializeBufferLen, aComputedMac);
   if (E_K_STATUS_OK != status)
   {
     M_KTALOG__ERR("Signing of message failed, status = [%d]", status);
     goto end;
   }
 
-  memcpy(xpMessageToSend, aSerializeBuffer, serializeBufferLen);
+  memcpy(xpMessageToSend, pSerializeBuffer, serializeBufferLen);
   memcpy(&xpMessageToSend[serializeBufferLen], aComputedMac, C_KTA_ACT__HMACSHA256_SIZE);
   *xpMessageToSendSize = serializeBufferLen + C_KTA_ACT__HMACSHA256_SIZE;
 
 end:
+  ktaArenaRelease(xpArena, pProtoMessage);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -508,7 +585,7 @@ end:
  **/
 TKStatus ktaActResponseBuildL1Keys
 (
-  TKIcppProtocolMessage *xpRecvMsg
+  TKIcppMessageView *xpRecvMsg
 )
 {
   TKStatus status = E_K_STATUS_ERROR;
@@ -881,12 +958,14 @@ static TKStatus lProcessActivationField
  */
 static TKStatus lActRespValidateAndGetPayload
 (
-  TKIcppProtocolMessage*  xpRecvMsg,
+  TKIcppMessageView*      xpRecvMsg,
   TKactRespPayload*       xpActRespPayload
 )
 {
-  TKStatus        status = E_K_STATUS_ERROR;
-  TKIcppFieldList* pFieldList = NULL;
+  TKStatus          status = E_K_STATUS_ERROR;
+  TKIcppCommandView command;
+  TKIcppField       field;
+  size_t            fieldOffset = 0;
 
   /* Early return for invalid command count */
   if (0u == xpRecvMsg->commandsCount)
@@ -898,35 +977,40 @@ static TKStatus lActRespValidateAndGetPayload
   /* Process commands */
   for (size_t commandsLoop = 0; commandsLoop < xpRecvMsg->commandsCount; commandsLoop++)
   {
-    /* Validate command tag */
-    if (E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION != xpRecvMsg->commands[commandsLoop].commandTag)
+    if (E_K_ICPP_PARSER_STATUS_OK != ktaIcppParserViewGetCommand(xpRecvMsg, commandsLoop, &command))
     {
-      M_KTALOG__ERR("Invalid command Tag 0x%02x", xpRecvMsg->commands[commandsLoop].commandTag);
+      M_KTALOG__ERR("Getting command %u failed", (uint32_t)commandsLoop);
       return E_K_STATUS_ERROR;
     }
 
-    pFieldList = &xpRecvMsg->commands[commandsLoop].data.fieldList;
+    /* Validate command tag */
+    if (E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION != command.commandTag)
+    {
+      M_KTALOG__ERR("Invalid command Tag 0x%02x", command.commandTag);
+      return E_K_STATUS_ERROR;
+    }
 
     /* Validate field count */
-    if (0u == pFieldList->fieldsCount)
+    if (0u == command.fieldsCount)
     {
       M_KTALOG__ERR("Field Count is 0");
       return E_K_STATUS_ERROR;
     }
 
     /* Process fields */
-    for (size_t fieldsLoop = 0; fieldsLoop < pFieldList->fieldsCount; fieldsLoop++)
+    fieldOffset = 0;
+    while (E_K_ICPP_PARSER_STATUS_OK == ktaIcppParserCommandGetNextField(&command, &fieldOffset, &field))
     {
       /* Validate field data */
-      if ((0u == pFieldList->fields[fieldsLoop].fieldLen) ||
-          (NULL == pFieldList->fields[fieldsLoop].fieldValue))
+      if ((0u == field.fieldLen) ||
+          (NULL == field.fieldValue))
       {
         M_KTALOG__ERR("Invalid Field Data");
         return E_K_STATUS_ERROR;
       }
 
       /* Process field using helper function */
-      status = lProcessActivationField(&pFieldList->fields[fieldsLoop], xpActRespPayload);
+      status = lProcessActivationField(&field, xpActRespPayload);
       if (E_K_STATUS_OK != status)
       {
         return status;
@@ -49,6 +49,8 @@ extern "C" {
 /* --------------------------------------------------------------------------------------------- */
 #include "k_defs.h"
 #include "icpp_parser.h"
+#include "general.h"
+#include "k_sal.h"
 
 #include <string.h>
 #include <stdio.h>
@@ -60,6 +62,15 @@ extern "C" {
 /** @brief HMAC SHA256 size in bytes. */
 #define C_KTA_ACT__HMACSHA256_SIZE (16u)
 
+/** @brief Activation request material prepared ahead of the exchange. */
+typedef struct
+{
+  uint8_t aRotEpk[C_K_KTA__PUBLIC_KEY_MAX_SIZE];
+  /* Public part of the ephemeral key pair generated in advance. */
+  uint8_t isRotEpkReady;
+  /* Set while aRotEpk matches the ephemeral key slot and was not sent yet. */
+} TKtaActState;
+
 /* --------------------------------------------------------------------------------------------- */
 /* VARIABLES                                                                                     */
 /* --------------------------------------------------------------------------------------------- */
@@ -81,10 +92,40 @@ TKStatus ktaActDeriveL2Keys
   void
 );
 
+/**
+ * @brief
+ *   Generate the ephemeral key pair and read the chip UID and certificate
+ *   ahead of ktaActBuildActivationRequest(), which then skips these steps.
+ *   The key pair is used by one activation request only.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaActPrecompute
+(
+  void
+);
+
+/**
+ * @brief
+ *   Select the activation state used by the next calls of this module from
+ *   the calling thread.
+ *
+ * @param[in] xpState
+ *   Activation state of the served instance, NULL for the built-in one.
+ */
+void ktaActBindState
+(
+  TKtaActState* xpState
+);
+
 /**
  * @brief
  *   Build activation request.
  *
+ * @param[in,out] xpArena
+ *   Workspace arena the message buffers are carved from.
  * @param[out] xpMessageToSend
  *   Should not be NULL.
  *   [in] Pointer to the buffer carrying activation request message.
@@ -101,6 +142,7 @@ TKStatus ktaActDeriveL2Keys
  */
 TKStatus ktaActBuildActivationRequest
 (
+  TKtaArena* xpArena,
   uint8_t* xpMessageToSend,
   size_t*  xpMessageToSendSize
 );
@@ -120,7 +162,7 @@ TKStatus ktaActBuildActivationRequest
  */
 TKStatus ktaActResponseBuildL1Keys
 (
-  TKIcppProtocolMessage* xpRecvMsg
+  TKIcppMessageView* xpRecvMsg
 );
 
 #ifdef __cplusplus
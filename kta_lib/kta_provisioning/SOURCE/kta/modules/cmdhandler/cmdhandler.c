@@ -109,51 +109,87 @@
 #endif
 
 #if defined(OBJECT_MANAGEMENT_FEATURE) || defined(PLATFORM_PROCESS_FEATURE)
+/** @brief Object type field presence bit. */
+#define C_K_CMD_FIELD_OBJECT_TYPE \
+  M_K_ICPP_PARSER__FIELD_BIT(E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_TYPE)
+
+/** @brief Object id field presence bit. */
+#define C_K_CMD_FIELD_IDENTIFIER \
+  M_K_ICPP_PARSER__FIELD_BIT(E_K_ICPP_PARSER_FIELD_SLOT_CMD_IDENTIFIER)
+
+/** @brief Data attributes field presence bit. */
+#define C_K_CMD_FIELD_ATTRIBUTES \
+  M_K_ICPP_PARSER__FIELD_BIT(E_K_ICPP_PARSER_FIELD_SLOT_CMD_ATTRIBUTES)
+
+/** @brief Data field presence bit. */
+#define C_K_CMD_FIELD_DATA \
+  M_K_ICPP_PARSER__FIELD_BIT(E_K_ICPP_PARSER_FIELD_SLOT_CMD_DATA)
+
+/** @brief Object uid field presence bit. */
+#define C_K_CMD_FIELD_OBJECT_UID \
+  M_K_ICPP_PARSER__FIELD_BIT(E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_UID)
+
+/** @brief Customer metadata field presence bit. */
+#define C_K_CMD_FIELD_CUSTOMER_METADATA \
+  M_K_ICPP_PARSER__FIELD_BIT(E_K_ICPP_PARSER_FIELD_SLOT_CMD_CUSTOMER_METADATA)
+
+/** @brief Association info field presence bit. */
+#define C_K_CMD_FIELD_ASSOCIATION_INFO \
+  M_K_ICPP_PARSER__FIELD_BIT(E_K_ICPP_PARSER_FIELD_SLOT_CMD_ASSOCIATION_INFO)
+
+/** @brief Object owner field presence bit. */
+#define C_K_CMD_FIELD_OBJECT_OWNER \
+  M_K_ICPP_PARSER__FIELD_BIT(E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_OWNER)
+
+/** @brief Nonce field presence bit. */
+#define C_K_CMD_FIELD_NONCE \
+  M_K_ICPP_PARSER__FIELD_BIT(E_K_ICPP_PARSER_FIELD_SLOT_KTA_NONCE)
+
 /** @brief Mandatory generate key pair fields. */
 #define C_K_CMD_GENKEYPAIR_FIELDS_MANDATORY \
-  (E_K_CMD_FIELD_IDENTIFIER)
+  (C_K_CMD_FIELD_IDENTIFIER)
 
 /** @brief Optional generate key pair fields. */
 #define C_K_CMD_GENKEYPAIR_FIELDS_OPTIONAL \
-  ((E_K_CMD_FIELD_IDENTIFIER | E_K_CMD_FIELD_ATTRIBUTES \
-   | E_K_CMD_FIELD_OBJECT_OWNER | E_K_CMD_FIELD_NONCE))
+  ((C_K_CMD_FIELD_IDENTIFIER | C_K_CMD_FIELD_ATTRIBUTES \
+   | C_K_CMD_FIELD_OBJECT_OWNER | C_K_CMD_FIELD_NONCE))
 
 /** @brief Mandatory set object fields. */
 #define C_K_CMD_SETOBJ_FIELDS_MANDATORY \
-  ((E_K_CMD_FIELD_OBJECT_TYPE | E_K_CMD_FIELD_IDENTIFIER \
-   | E_K_CMD_FIELD_DATA))
+  ((C_K_CMD_FIELD_OBJECT_TYPE | C_K_CMD_FIELD_IDENTIFIER \
+   | C_K_CMD_FIELD_DATA))
 
 /** @brief Optional set object fields. */
 #define C_K_CMD_SETOBJ_FIELDS_OPTIONAL \
-  ((E_K_CMD_FIELD_OBJECT_TYPE | E_K_CMD_FIELD_IDENTIFIER \
-   | E_K_CMD_FIELD_DATA | E_K_CMD_FIELD_ATTRIBUTES \
-   | E_K_CMD_FIELD_OBJECT_OWNER))
+  ((C_K_CMD_FIELD_OBJECT_TYPE | C_K_CMD_FIELD_IDENTIFIER \
+   | C_K_CMD_FIELD_DATA | C_K_CMD_FIELD_ATTRIBUTES \
+   | C_K_CMD_FIELD_OBJECT_OWNER))
 
 /** @brief Mandatory set object association fields. */
 #define C_K_CMD_SETOBJASSOCIATION_FIELDS_MANDATORY \
-  ((E_K_CMD_FIELD_OBJECT_TYPE | E_K_CMD_FIELD_IDENTIFIER \
-   | E_K_CMD_FIELD_DATA | E_K_CMD_FIELD_ASSOCIATION_INFO))
+  ((C_K_CMD_FIELD_OBJECT_TYPE | C_K_CMD_FIELD_IDENTIFIER \
+   | C_K_CMD_FIELD_DATA | C_K_CMD_FIELD_ASSOCIATION_INFO))
 
 /** @brief Mandatory delete object fields. */
 #define C_K_CMD_DELETEOBJ_FIELDS_MANDATORY \
-  ((E_K_CMD_FIELD_IDENTIFIER | E_K_CMD_FIELD_OBJECT_TYPE))
+  ((C_K_CMD_FIELD_IDENTIFIER | C_K_CMD_FIELD_OBJECT_TYPE))
 
 /** @brief Optional delete object fields. */
 #define C_K_CMD_DELETEOBJ_FIELDS_OPTIONAL \
-  ((E_K_CMD_FIELD_IDENTIFIER | E_K_CMD_FIELD_OBJECT_TYPE \
-   | E_K_CMD_FIELD_OBJECT_OWNER))
+  ((C_K_CMD_FIELD_IDENTIFIER | C_K_CMD_FIELD_OBJECT_TYPE \
+   | C_K_CMD_FIELD_OBJECT_OWNER))
 
 /** @brief Mandatory delete key object fields. */
 #define C_K_CMD_DELETEKEYOBJ_FIELDS_MANDATORY \
-  (E_K_CMD_FIELD_IDENTIFIER)
+  (C_K_CMD_FIELD_IDENTIFIER)
 
 /** @brief Optional delete key object fields. */
 #define C_K_CMD_DELETEKEYOBJ_FIELDS_OPTIONAL \
-  ((E_K_CMD_FIELD_IDENTIFIER | E_K_CMD_FIELD_OBJECT_TYPE))
+  ((C_K_CMD_FIELD_IDENTIFIER | C_K_CMD_FIELD_OBJECT_TYPE))
 
 /** @brief Mandatory get challenge fields. */
 #define C_K_CMD_GETCHALLENGE_FIELDS_MANDATORY \
-  (E_K_CMD_FIELD_OBJECT_ID)
+  (C_K_CMD_FIELD_OBJECT_ID)
 
 /** @brief  Command response fields structure. */
 typedef struct
@@ -193,48 +229,6 @@ typedef struct
 #endif
 } TKcmdRespPayload;
 
-/** @brief  Different commands for field tag. */
-typedef enum
-{
-  /**
-   * Object type field mask
-   */
-  E_K_CMD_FIELD_OBJECT_TYPE = 0x01u,
-  /**
-   * Object id field mask
-   */
-  E_K_CMD_FIELD_IDENTIFIER = 0x02u,
-  /**
-   * Data Attribute field mask
-   */
-  E_K_CMD_FIELD_ATTRIBUTES = 0x04u,
-  /**
-   * Data field mask
-   */
-  E_K_CMD_FIELD_DATA = 0x08u,
-  /**
-   * Association info field mask
-   */
-  E_K_CMD_FIELD_OBJECT_UID = 0x10u,
-  /**
-   * Object uid field mask
-   */
-  E_K_CMD_FIELD_CUSTOMER_METADATA = 0x20u,
-  /**
-   * Customer Metadata field mask
-   */
-  E_K_CMD_FIELD_ASSOCIATION_INFO = 0x40u,
-  /**
-   * Object owner field mask
-   */
-  E_K_CMD_FIELD_OBJECT_OWNER = 0x80u,
-  /**
-   * Object owner field mask
-   */
-  E_K_CMD_FIELD_NONCE = 0x0100u
-
-} TKcmdFieldTag;
-
 /**
  * @brief Handler function signature for field processing
  */
@@ -250,16 +244,6 @@ typedef uint32_t (*FieldHandler)
 #endif
 );
 
-/**
- * @brief Field tag lookup table entry
- */
-typedef struct
-{
-  uint32_t tag;
-  FieldHandler handler;
-  uint32_t maskBit;
-} FieldTagEntry;
-
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -690,27 +674,27 @@ static uint32_t lHandleFotaComponentUrl
 #endif
 
 /**
- * @brief Field tag lookup table
+ * @brief Field handler table indexed by field slot, NULL for fields without handler
  */
-static const FieldTagEntry kFieldTagTable[] =
+static const FieldHandler kFieldTagTable[E_K_ICPP_PARSER_FIELD_SLOT_COUNT] =
 {
 #ifdef OBJECT_MANAGEMENT_FEATURE
-  { E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_TYPE,                 lHandleObjectType,            E_K_CMD_FIELD_OBJECT_TYPE },
-  { E_K_ICPP_PARSER_FLD_TAG_CMD_IDENTIFIER,                    lHandleIdentifier,            E_K_CMD_FIELD_IDENTIFIER },
-  { E_K_ICPP_PARSER_FIELD_TAG_CMD_ATTRIBUTES,                  lHandleAttributes,            E_K_CMD_FIELD_ATTRIBUTES },
-  { E_K_ICPP_PARSER_FLD_TAG_KTA_NONCE,                         lHandleNonce,                 E_K_CMD_FIELD_NONCE },
-  { E_K_ICPP_PARSER_FLD_TAG_CMD_DATA,                          lHandleData,                  E_K_CMD_FIELD_DATA },
-  { E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_UID,                  lHandleObjectUid,             E_K_CMD_FIELD_OBJECT_UID },
-  { E_K_ICPP_PARSER_FIELD_TAG_CMD_CUSTOMER_METADATA,           lHandleCustomerMetadata,      E_K_CMD_FIELD_CUSTOMER_METADATA },
-  { E_K_ICPP_PARSER_FIELD_TAG_CMD_ASSOCIATION_INFO,            lHandleAssociationInfo,       E_K_CMD_FIELD_ASSOCIATION_INFO },
-  { E_K_ICPP_PRSR_FLD_TAG_CMD_OBJECT_OWNER,                    lHandleObjectOwner,           E_K_CMD_FIELD_OBJECT_OWNER },
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_TYPE]            = lHandleObjectType,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_IDENTIFIER]             = lHandleIdentifier,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_ATTRIBUTES]             = lHandleAttributes,
+  [E_K_ICPP_PARSER_FIELD_SLOT_KTA_NONCE]                  = lHandleNonce,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_DATA]                   = lHandleData,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_UID]             = lHandleObjectUid,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_CUSTOMER_METADATA]      = lHandleCustomerMetadata,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_ASSOCIATION_INFO]       = lHandleAssociationInfo,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_OBJECT_OWNER]           = lHandleObjectOwner,
 #endif
 #ifdef FOTA_ENABLE
-  { E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA,                         lHandleFota,                 E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA },
-  { E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_METADATA,                lHandleFotaMetadata,         E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_METADATA },
-  { E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET,        lHandleFotaComponentTarget,  E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET },
-  { E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION,       lHandleFotaComponentVersion, E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION },
-  { E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_URL,           lHandleFotaComponentUrl,     E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_URL },
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA]                   = lHandleFota,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_METADATA]          = lHandleFotaMetadata,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_COMPONENT_TARGET]  = lHandleFotaComponentTarget,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_COMPONENT_VERSION] = lHandleFotaComponentVersion,
+  [E_K_ICPP_PARSER_FIELD_SLOT_CMD_FOTA_COMPONENT_URL]     = lHandleFotaComponentUrl,
 #endif
 };
 
@@ -723,9 +707,8 @@ static const FieldTagEntry kFieldTagTable[] =
  * @param[in] xCmdTag
  *   Should not be NULL.
  *   Command tag received.
- * @param[in] xFieldTagMask
- *   Should not be NULL.
- *   Field tag received.
+ * @param[in] xFieldsPresence
+ *   Field presence bitmap of the command, built by the ICPP parser.
  *
  * @return
  * - E_K_STATUS_OK in case of success.
@@ -734,7 +717,7 @@ static const FieldTagEntry kFieldTagTable[] =
 static TKStatus lKtaCmdCheckFieldTag
 (
   TKIcppCommandTag xCmdTag,
-  uint32_t         xFieldTagMask
+  uint64_t         xFieldsPresence
 );
 
 /**
@@ -756,7 +739,7 @@ static TKStatus lKtaCmdCheckFieldTag
  */
 static TKStatus lKtaCmdValidateAndGetPayload
 (
-  TKIcppProtocolMessage*   xpRecvMsg,
+  TKIcppMessageView*       xpRecvMsg,
   TKcmdRespPayload*        xpCmdRespPayload,
   uint32_t                 xCmdCount
 );
@@ -769,8 +752,6 @@ static TKStatus lKtaCmdValidateAndGetPayload
  *   Field to process.
  * @param[out] xpCmdRespPayload
  *   Response payload to fill.
- * @param[in,out] xpFieldTagMask
- *   Field tag mask to update.
  * @param[in,out] xpTargetNameIndex
  *   Target name index (FOTA only).
  * @param[in,out] xpTargetVersionIndex
@@ -785,8 +766,7 @@ static TKStatus lKtaCmdValidateAndGetPayload
 static uint32_t lProcessFieldTag
 (
   TKIcppField*       xpField,
-  TKcmdRespPayload*  xpCmdRespPayload,
-  uint32_t*          xpFieldTagMask
+  TKcmdRespPayload*  xpCmdRespPayload
 #ifdef FOTA_ENABLE
   ,
   uint32_t*          xpTargetNameIndex,
@@ -820,7 +800,7 @@ static uint32_t lProcessFieldTag
  */
 static TKStatus lKtaGenerateKeyPair
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               xpOutData,
   size_t*                xpDataSize,
   uint8_t*               xpPlatformStatus,
@@ -845,7 +825,7 @@ static TKStatus lKtaGenerateKeyPair
  */
 static TKStatus lKtaSetObject
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               xpPlatformStatus
 );
 
@@ -867,7 +847,7 @@ static TKStatus lKtaSetObject
  */
 static TKStatus lKtaSetObjWithAssociation
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               xpPlatformStatus
 );
 
@@ -891,7 +871,7 @@ static TKStatus lKtaSetObjWithAssociation
  */
 static TKStatus lKtaDeleteObject
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               xpPlatformStatus,
   uint32_t               xCmdCount
 );
@@ -916,7 +896,7 @@ static TKStatus lKtaDeleteObject
  */
 static TKStatus lKtaDeleteKeyObject
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               xpPlatformStatus,
   uint32_t               xCmdCount
 );
@@ -999,7 +979,7 @@ static TKStatus lKtaSetThirdPartyData
  */
 static TKStatus lProcessCmdPrepareResponse
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   TKIcppProtocolMessage* xpSendProtoMessage,
   uint8_t*               xpCmdResponse,
   uint32_t               xCmdItemSize
@@ -1014,7 +994,7 @@ static TKStatus lProcessCmdPrepareResponse
  */
 static inline void lInitSendProtoMessage
 (
-  const TKIcppProtocolMessage* xpRecvd,
+  const TKIcppMessageView*     xpRecvd,
   TKIcppProtocolMessage*       xpSend
 )
 {
@@ -1047,12 +1027,13 @@ static inline void lInitSendProtoMessage
  **/
 TKStatus ktaCmdProcess
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKtaArena*             xpArena,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   uint8_t*               xpMessageToSend,
   size_t*                xpMessageToSendSize
 )
 {
-  TKIcppProtocolMessage sendProtoMessage;
+  TKIcppProtocolMessage* pSendProtoMessage = NULL;
   TKStatus status = E_K_STATUS_ERROR;
   TKStatus cmdProcessStatus;
   TKStatus genRespStatus;
@@ -1081,6 +1062,13 @@ TKStatus ktaCmdProcess
     goto end;
   }
 
+  pSendProtoMessage = (TKIcppProtocolMessage*)ktaArenaAlloc(xpArena, sizeof(TKIcppProtocolMessage));
+  if (NULL == pSendProtoMessage)
+  {
+    M_KTALOG__ERR("Not enough workspace for the command response");
+    goto end;
+  }
+
   // REQ RQ_M-KTA-OBJM-FN-0100_03(1) : message type
   // REQ RQ_M-KTA-TRDP-FN-0110_03(1) : Third Party Response message type
   // REQ RQ_M-KTA-OBJM-FN-0100_01(1) : crypto version
@@ -1099,9 +1087,9 @@ TKStatus ktaCmdProcess
   // REQ RQ_M-KTA-TRDP-FN-0110_04(1) : Third Party Response transaction id
   // REQ RQ_M-KTA-OBJM-FN-0100_05(1) : rot key set id
   // REQ RQ_M-KTA-TRDP-FN-0110_05(1) : Third Party Response rot key set id
-  lInitSendProtoMessage(xpRecvdProtoMessage, &sendProtoMessage);
+  lInitSendProtoMessage(xpRecvdProtoMessage, pSendProtoMessage);
 
-  status = lProcessCmdPrepareResponse(xpRecvdProtoMessage, &sendProtoMessage, aCmdResponse, cmdResponseSize
+  status = lProcessCmdPrepareResponse(xpRecvdProtoMessage, pSendProtoMessage, aCmdResponse, cmdResponseSize
 #ifdef OBJECT_MANAGEMENT_FEATURE
                                       , (uint8_t*)&aPlatformStatus
 #endif
@@ -1114,10 +1102,10 @@ TKStatus ktaCmdProcess
       // Don't goto end - still need to generate error response
   }
 
-  M_KTALOG__INFO("Calling ktaGenerateResponse with %zu commands", sendProtoMessage.commandsCount);
+  M_KTALOG__INFO("Calling ktaGenerateResponse with %zu commands", pSendProtoMessage->commandsCount);
   cmdProcessStatus = status;  // Preserve the command processing status
   genRespStatus = ktaGenerateResponse((C_GEN__SERIALIZE | C_GEN__PADDING | C_GEN__ENCRYPT | C_GEN__SIGNING),
-                                      &sendProtoMessage, xpMessageToSend, xpMessageToSendSize);
+                                      pSendProtoMessage, xpMessageToSend, xpMessageToSendSize);
   if (E_K_STATUS_OK != genRespStatus)
   {
     M_KTALOG__ERR("ktaGenerateResponse failed, status = [%d]", genRespStatus);
@@ -1134,6 +1122,7 @@ TKStatus ktaCmdProcess
   }
 
 end:
+  ktaArenaRelease(xpArena, pSendProtoMessage);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -1485,8 +1474,7 @@ static uint32_t lHandleFotaComponentUrl
 static uint32_t lProcessFieldTag
 (
   TKIcppField*       xpField,
-  TKcmdRespPayload*  xpCmdRespPayload,
-  uint32_t*          xpFieldTagMask
+  TKcmdRespPayload*  xpCmdRespPayload
 #ifdef FOTA_ENABLE
   ,
   uint32_t*          xpTargetNameIndex,
@@ -1495,30 +1483,21 @@ static uint32_t lProcessFieldTag
 #endif
 )
 {
-  size_t i;
-  uint32_t tableSize = sizeof(kFieldTagTable) / sizeof(kFieldTagTable[0]);
+  FieldHandler handler = kFieldTagTable[M_K_ICPP_PARSER__FIELD_SLOT(xpField->fieldTag)];
 
-  for (i = 0; i < tableSize; ++i)
+  if (NULL == handler)
   {
-    if (kFieldTagTable[i].tag == xpField->fieldTag)
-    {
-      uint32_t err = kFieldTagTable[i].handler(xpField, xpCmdRespPayload
-#ifdef FOTA_ENABLE
-                                                , xpTargetNameIndex,
-                                                xpTargetVersionIndex,
-                                                xpTargetUrlIndex
-#endif
-                                                );
-      if (0u == err)
-      {
-        *xpFieldTagMask |= kFieldTagTable[i].maskBit;
-      }
-      return err;
-    }
+    M_KTALOG__ERR("Unknown Field Tag %d", xpField->fieldTag);
+    return 1u;
   }
 
-  M_KTALOG__ERR("Unknown Field Tag %d", xpField->fieldTag);
-  return 1u;
+  return handler(xpField, xpCmdRespPayload
+#ifdef FOTA_ENABLE
+                 , xpTargetNameIndex,
+                 xpTargetVersionIndex,
+                 xpTargetUrlIndex
+#endif
+                 );
 }
 
 /**
@@ -1528,19 +1507,19 @@ static uint32_t lProcessFieldTag
 static TKStatus lKtaCmdCheckFieldTag
 (
   TKIcppCommandTag xCmdTag,
-  uint32_t         xFieldTagMask
+  uint64_t         xFieldsPresence
 )
 {
   TKStatus  status = E_K_STATUS_ERROR;
-  uint32_t  mandatorymask = 0;
-  uint32_t  optionalmask = 0;
+  uint64_t  mandatorymask = 0;
+  uint64_t  optionalmask = 0;
 
   switch (xCmdTag)
   {
     case E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR:
     {
-      mandatorymask = xFieldTagMask & C_K_CMD_GENKEYPAIR_FIELDS_MANDATORY;
-      optionalmask = xFieldTagMask & C_K_CMD_GENKEYPAIR_FIELDS_OPTIONAL;
+      mandatorymask = xFieldsPresence & C_K_CMD_GENKEYPAIR_FIELDS_MANDATORY;
+      optionalmask = xFieldsPresence & C_K_CMD_GENKEYPAIR_FIELDS_OPTIONAL;
       if ((mandatorymask == C_K_CMD_GENKEYPAIR_FIELDS_MANDATORY)
           || (optionalmask == C_K_CMD_GENKEYPAIR_FIELDS_OPTIONAL))
       {
@@ -1551,8 +1530,8 @@ static TKStatus lKtaCmdCheckFieldTag
 
     case E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT:
     {
-      mandatorymask = xFieldTagMask & C_K_CMD_SETOBJ_FIELDS_MANDATORY;
-      optionalmask = xFieldTagMask & C_K_CMD_SETOBJ_FIELDS_OPTIONAL;
+      mandatorymask = xFieldsPresence & C_K_CMD_SETOBJ_FIELDS_MANDATORY;
+      optionalmask = xFieldsPresence & C_K_CMD_SETOBJ_FIELDS_OPTIONAL;
       if ((mandatorymask == C_K_CMD_SETOBJ_FIELDS_MANDATORY)
           || (optionalmask == C_K_CMD_SETOBJ_FIELDS_OPTIONAL))
       {
@@ -1563,7 +1542,7 @@ static TKStatus lKtaCmdCheckFieldTag
 
     case E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION:
     {
-      mandatorymask = xFieldTagMask & C_K_CMD_SETOBJASSOCIATION_FIELDS_MANDATORY;
+      mandatorymask = xFieldsPresence & C_K_CMD_SETOBJASSOCIATION_FIELDS_MANDATORY;
       if (mandatorymask == C_K_CMD_SETOBJASSOCIATION_FIELDS_MANDATORY)
       {
         status = E_K_STATUS_OK;
@@ -1573,8 +1552,8 @@ static TKStatus lKtaCmdCheckFieldTag
 
     case E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT:
     {
-      mandatorymask = xFieldTagMask & C_K_CMD_DELETEOBJ_FIELDS_MANDATORY;
-      optionalmask = xFieldTagMask & C_K_CMD_DELETEOBJ_FIELDS_OPTIONAL;
+      mandatorymask = xFieldsPresence & C_K_CMD_DELETEOBJ_FIELDS_MANDATORY;
+      optionalmask = xFieldsPresence & C_K_CMD_DELETEOBJ_FIELDS_OPTIONAL;
       if ((mandatorymask == C_K_CMD_DELETEOBJ_FIELDS_MANDATORY)
           || (optionalmask == C_K_CMD_DELETEOBJ_FIELDS_OPTIONAL))
       {
@@ -1585,8 +1564,8 @@ static TKStatus lKtaCmdCheckFieldTag
 
     case E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT:
     {
-      mandatorymask = xFieldTagMask & C_K_CMD_DELETEKEYOBJ_FIELDS_MANDATORY;
-      optionalmask = xFieldTagMask & C_K_CMD_DELETEKEYOBJ_FIELDS_OPTIONAL;
+      mandatorymask = xFieldsPresence & C_K_CMD_DELETEKEYOBJ_FIELDS_MANDATORY;
+      optionalmask = xFieldsPresence & C_K_CMD_DELETEKEYOBJ_FIELDS_OPTIONAL;
       if ((mandatorymask == C_K_CMD_DELETEKEYOBJ_FIELDS_MANDATORY)
           || (optionalmask == C_K_CMD_DELETEKEYOBJ_FIELDS_OPTIONAL))
       {
@@ -1623,16 +1602,16 @@ static TKStatus lKtaCmdCheckFieldTag
  */
 static TKStatus   lKtaCmdValidateAndGetPayload
 (
-  TKIcppProtocolMessage* xpRecvMsg,
+  TKIcppMessageView*     xpRecvMsg,
   TKcmdRespPayload*      xpCmdRespPayload,
   uint32_t               xCmdCount
 )
 {
   uint32_t  commandsLoop        = 0;
-  uint32_t  fieldsLoop          = 0;
   uint32_t  isErrorOccured      = 0;
-  uint32_t  fieldTagMask        = 0;
-  TKIcppFieldList* pFieldList   = NULL;
+  size_t    fieldOffset         = 0;
+  TKIcppCommandView command;
+  TKIcppField       field;
 #ifdef FOTA_ENABLE
   uint32_t  targetNameIndex     = 0;
   uint32_t  targetVersionIndex  = 0;
@@ -1649,8 +1628,14 @@ static TKStatus   lKtaCmdValidateAndGetPayload
 
   for (; ((commandsLoop < xpRecvMsg->commandsCount) && (isErrorOccured == 0U)); commandsLoop++)
   {
-    TKIcppCommandTag tag = xpRecvMsg->commands[commandsLoop].commandTag;
-    
+    if (E_K_ICPP_PARSER_STATUS_OK != ktaIcppParserViewGetCommand(xpRecvMsg, commandsLoop, &command))
+    {
+      M_KTALOG__ERR("Getting command %u failed", commandsLoop);
+      return E_K_STATUS_ERROR;
+    }
+
+    TKIcppCommandTag tag = command.commandTag;
+
     if ((tag != E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR) &&
         (tag != E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT) &&
         (tag != E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION) &&
@@ -1663,19 +1648,24 @@ static TKStatus   lKtaCmdValidateAndGetPayload
       return E_K_STATUS_ERROR;
     }
 
-    pFieldList = &xpRecvMsg->commands[commandsLoop].data.fieldList;
+    if (0u == command.fieldsCount)
+    {
+      M_KTALOG__ERR("Invalid fieldsCount : %d", command.fieldsCount);
+      return E_K_STATUS_ERROR;
+    }
 
-    if (0u == pFieldList->fieldsCount)
+    /* Reject a command with missing fields before any field is processed. */
+    if (E_K_STATUS_OK != lKtaCmdCheckFieldTag(tag, command.fieldsPresence))
     {
-      M_KTALOG__ERR("Invalid fieldsCount : %d", pFieldList->fieldsCount);
+      M_KTALOG__ERR("Command does not have all mandatory fields");
       return E_K_STATUS_ERROR;
     }
 
-    for (; (fieldsLoop < pFieldList->fieldsCount) && (isErrorOccured == 0u); fieldsLoop++)
+    while ((isErrorOccured == 0u) &&
+           (E_K_ICPP_PARSER_STATUS_OK == ktaIcppParserCommandGetNextField(&command, &fieldOffset, &field)))
     {
-      isErrorOccured = lProcessFieldTag(&pFieldList->fields[fieldsLoop],
-                                        xpCmdRespPayload,
-                                        &fieldTagMask
+      isErrorOccured = lProcessFieldTag(&field,
+                                        xpCmdRespPayload
 #ifdef FOTA_ENABLE
                                         , &targetNameIndex,
                                         &targetVersionIndex,
@@ -1684,12 +1674,6 @@ static TKStatus   lKtaCmdValidateAndGetPayload
                                         );
     }
 
-    if (E_K_STATUS_OK != lKtaCmdCheckFieldTag(tag, fieldTagMask))
-    {
-      M_KTALOG__ERR("Command does not have all mandatory fields");
-      return E_K_STATUS_ERROR;
-    }
-
     if (isErrorOccured != 0u)
     {
       M_KTALOG__ERR("Type %x Id %x", xpCmdRespPayload->objectType, xpCmdRespPayload->identifier);
@@ -1750,7 +1734,7 @@ static TKStatus lKtaSetThirdPartyData
  **/
 static TKStatus lKtaGenerateKeyPair
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               xpOutData,
   size_t*                xpDataSize,
   uint8_t*               xpPlatformStatus,
@@ -1794,7 +1778,7 @@ end:
  **/
 static TKStatus lKtaSetObject
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               xpPlatformStatus
 )
 {
@@ -1831,7 +1815,7 @@ end:
  */
 static TKStatus lktaInstallFota
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               fotaName,
   uint8_t*               fotaNameLen,
   TComponent             xComponents[COMPONENTS_MAX],
@@ -1873,7 +1857,7 @@ end:
  */
 static TKStatus lktasalfotagetstatus
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               fotaName,
   uint8_t*               fotaNameLen,
   TFotaError*            xpFotaError,
@@ -1919,7 +1903,7 @@ end:
  **/
 static TKStatus lKtaSetObjWithAssociation
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               xpPlatformStatus
 )
 {
@@ -1960,7 +1944,7 @@ end:
  **/
 static TKStatus lKtaDeleteObject
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               xpPlatformStatus,
   uint32_t               xCmdCount
 )
@@ -1997,7 +1981,7 @@ end:
  **/
 static TKStatus lKtaDeleteKeyObject
 (
-  TKIcppProtocolMessage* xpData,
+  TKIcppMessageView*     xpData,
   uint8_t*               xpPlatformStatus,
   uint32_t               xCmdCount
 )
@@ -2148,7 +2132,7 @@ static void lHandleFotaErrorResponse
  */
 static TKStatus lProcessInstallFotaCmd
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   TKIcppCommand* xpSendCommand,
   uint8_t* xpFotaName,
   uint8_t* xpFotaNameLen,
@@ -2196,7 +2180,7 @@ static TKStatus lProcessInstallFotaCmd
  */
 static TKStatus lProcessGetFotaStatusCmd
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   TKIcppCommand* xpSendCommand,
   uint8_t* xpFotaName,
   uint8_t* xpFotaNameLen,
@@ -2246,9 +2230,8 @@ static TKStatus lProcessGetFotaStatusCmd
  */
 static TKStatus lProcessThirdPartyCmd
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  const TKIcppCommandView* xpRecvdCommand,
   TKIcppCommand* xpSendCommand,
-  size_t xCommandIndex,
   uint8_t* xpCmdResponse,
   uint32_t xCmdItemSize,
   uint8_t** xppCmdResponse
@@ -2258,8 +2241,8 @@ static TKStatus lProcessThirdPartyCmd
   size_t dataSize = xCmdItemSize;
 
   status = lKtaSetThirdPartyData(
-             xpRecvdProtoMessage->commands[xCommandIndex].data.cmdInfo.cmdValue,
-             xpRecvdProtoMessage->commands[xCommandIndex].data.cmdInfo.cmdLen,
+             xpRecvdCommand->cmdValue,
+             xpRecvdCommand->cmdLen,
              xpCmdResponse, &dataSize);
 
   if (E_K_STATUS_OK != status)
@@ -2283,7 +2266,7 @@ static TKStatus lProcessThirdPartyCmd
  */
 static TKStatus lProcessGenerateKeyPairCmd
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   TKIcppCommand* xpSendCommand,
   size_t xCommandIndex,
   uint8_t* xpCmdResponse,
@@ -2322,7 +2305,7 @@ static TKStatus lProcessGenerateKeyPairCmd
  */
 static TKStatus lProcessSetObjectCmd
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   TKIcppCommand* xpSendCommand,
   uint8_t* xpPlatformStatus
 )
@@ -2356,7 +2339,7 @@ static TKStatus lProcessSetObjectCmd
  */
 static TKStatus lProcessDeleteObjectCmd
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   TKIcppCommand* xpSendCommand,
   size_t xCommandIndex,
   uint8_t* xpPlatformStatus
@@ -2389,7 +2372,7 @@ static TKStatus lProcessDeleteObjectCmd
  */
 static TKStatus lProcessDeleteKeyObjectCmd
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   TKIcppCommand* xpSendCommand,
   size_t xCommandIndex,
   uint8_t* xpPlatformStatus
@@ -2422,7 +2405,7 @@ static TKStatus lProcessDeleteKeyObjectCmd
  */
 static TKStatus lProcessSetObjWithAssociationCmd
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   TKIcppCommand* xpSendCommand,
   uint8_t* xpPlatformStatus
 )
@@ -2492,7 +2475,7 @@ static TKStatus lProcessGetChallengeCmd
  */
 static TKStatus lProcessCmdPrepareResponse
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   TKIcppProtocolMessage* xpSendProtoMessage,
   uint8_t*               xpCmdResponse,
   uint32_t               xCmdItemSize
@@ -2503,6 +2486,7 @@ static TKStatus lProcessCmdPrepareResponse
 {
   TKStatus status = E_K_STATUS_ERROR;
   size_t commandCount = 0;
+  TKIcppCommandView command;
   uint8_t challenge[C_K_ICPP_PARSER_KTA_CHALLENGE_SIZE] = {0};
 #ifdef FOTA_ENABLE
   uint8_t errorCode = 0;
@@ -2538,12 +2522,19 @@ static TKStatus lProcessCmdPrepareResponse
   {
     status = E_K_STATUS_OK;
 
+    if (E_K_ICPP_PARSER_STATUS_OK != ktaIcppParserViewGetCommand(xpRecvdProtoMessage, commandCount, &command))
+    {
+      M_KTALOG__ERR("Getting command %zu failed", commandCount);
+      status = E_K_STATUS_ERROR;
+      continue;
+    }
+
     M_KTALOG__INFO("Processing command %zu: tag=0x%x (decimal %d)",
                    commandCount,
-                   xpRecvdProtoMessage->commands[commandCount].commandTag,
-                   xpRecvdProtoMessage->commands[commandCount].commandTag);
+                   command.commandTag,
+                   command.commandTag);
 
-    switch (xpRecvdProtoMessage->commands[commandCount].commandTag)
+    switch (command.commandTag)
     {
 #ifdef PLATFORM_PROCESS_FEATURE
       /* REQ RQ_M-KTA-TRDP-FN-0010(1) : Verify Third party Signature */
@@ -2552,9 +2543,9 @@ static TKStatus lProcessCmdPrepareResponse
         /* REQ RQ_M-KTA-TRDP-FN-0070(1) : Check third party data */
         /* REQ RQ_M-KTA-TRDP-FN-0090(1) : Build Third party response */
         /* REQ RQ_M-KTA-TRDP-FN-0100(1) : Third party response data order */
-        status = lProcessThirdPartyCmd(xpRecvdProtoMessage,
+        status = lProcessThirdPartyCmd(&command,
                                        &xpSendProtoMessage->commands[commandCount],
-                                       commandCount, xpCmdResponse, xCmdItemSize, &xpCmdResponse);
+                                       xpCmdResponse, xCmdItemSize, &xpCmdResponse);
         break;
 #endif /* PLATFORM_PROCESS_FEATURE */
 
@@ -2640,8 +2631,8 @@ static TKStatus lProcessCmdPrepareResponse
 
       default:
         M_KTALOG__ERR("Received invalid command tag, cmdTag = 0x%x (decimal %d)",
-                      xpRecvdProtoMessage->commands[commandCount].commandTag,
-                      xpRecvdProtoMessage->commands[commandCount].commandTag);
+                      command.commandTag,
+                      command.commandTag);
         M_KTALOG__ERR("Expected SET_OBJECT = 0x%x but feature may not be enabled", E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT);
         status = E_K_STATUS_ERROR;
         break;
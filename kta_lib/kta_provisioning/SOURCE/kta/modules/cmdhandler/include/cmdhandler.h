@@ -49,6 +49,7 @@ extern "C" {
 /* -------------------------------------------------------------------------- */
 #include "k_kta.h"
 #include "icpp_parser.h"
+#include "general.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -71,6 +72,8 @@ extern "C" {
  *   KTA-RoT will decrypt and process the message.
  *   Response message is generated and sent by the Application to keySTREAM.
  *
+ * @param[in,out] xpArena
+ *   Workspace arena the response message is carved from.
  * @param[in] xpRecvdProtoMessage
  *   Should not be NULL.
  *   Icpp message received from server.
@@ -95,7 +98,8 @@ extern "C" {
  */
 TKStatus ktaCmdProcess
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKtaArena*             xpArena,
+  TKIcppMessageView*     xpRecvdProtoMessage,
   uint8_t*               xpMessageToSend,
   size_t*                xpMessageToSendSize
 );
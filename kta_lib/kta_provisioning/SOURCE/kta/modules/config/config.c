@@ -64,9 +64,10 @@
 #if LOG_KTA_ENABLE != C_KTA_LOG_LEVEL_NONE
 static const char* gpModuleName = "KTACONFIG";
 #endif
-/* Static variable to hold configuration info. */
-static TKtaDeviceInfoConfig gKtaDeviceInfoConfig = {0};
-static TKtaContextInfoConfig gKtaContextInfoConfig = {0};
+/* Configuration info of the built-in instance. */
+static TKtaConfigState gKtaConfigState = {0};
+/* Configuration info of the instance served by the calling thread. */
+static K_THREAD_LOCAL TKtaConfigState* gpKtaConfigState = &gKtaConfigState;
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
@@ -136,17 +137,17 @@ TKStatus ktaSetDeviceInfoConfig
   {
     M_KTALOG__DEBUG("Device is in init state, keeping KTA info into NVM...");
 
-    memcpy(aKtaInfo, gKtaContextInfoConfig.ktaContextProfileUid, C_K__CONTEXT_PROFILE_UID_MAX_SIZE);
+    memcpy(aKtaInfo, gpKtaConfigState->contextInfo.ktaContextProfileUid, C_K__CONTEXT_PROFILE_UID_MAX_SIZE);
     ktaInfoLen = C_K__CONTEXT_PROFILE_UID_MAX_SIZE;
-    aKtaInfo[ktaInfoLen++] = gKtaContextInfoConfig.ktaContextProfileUidLength;
+    aKtaInfo[ktaInfoLen++] = gpKtaConfigState->contextInfo.ktaContextProfileUidLength;
 
-    memcpy(&aKtaInfo[ktaInfoLen], gKtaContextInfoConfig.ktaContexSerialNumber, C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE);
+    memcpy(&aKtaInfo[ktaInfoLen], gpKtaConfigState->contextInfo.ktaContexSerialNumber, C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE);
     ktaInfoLen += C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE;
-    aKtaInfo[ktaInfoLen++] = gKtaContextInfoConfig.ktaContexSerialNumberLength;
+    aKtaInfo[ktaInfoLen++] = gpKtaConfigState->contextInfo.ktaContexSerialNumberLength;
 
-    memcpy(&aKtaInfo[ktaInfoLen], gKtaContextInfoConfig.ktaContextVersion, C_K__CONTEXT_VERSION_MAX_SIZE);
+    memcpy(&aKtaInfo[ktaInfoLen], gpKtaConfigState->contextInfo.ktaContextVersion, C_K__CONTEXT_VERSION_MAX_SIZE);
     ktaInfoLen += C_K__CONTEXT_VERSION_MAX_SIZE;
-    aKtaInfo[ktaInfoLen++] = gKtaContextInfoConfig.ktaContextVersionLength;
+    aKtaInfo[ktaInfoLen++] = gpKtaConfigState->contextInfo.ktaContextVersionLength;
 
     memcpy(&aKtaInfo[ktaInfoLen], ktaGetVersion(), C_KTA__VERSION_MAX_SIZE);
     ktaInfoLen += C_KTA__VERSION_MAX_SIZE;
@@ -167,10 +168,10 @@ TKStatus ktaSetDeviceInfoConfig
       goto end;
     }
 
-    memcpy(gKtaDeviceInfoConfig.deviceProfilePubUID[0], xpDeviceProfilePublicUid, xDeviceProfilePublicUidSize);
-    gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0] = (uint8_t)xDeviceProfilePublicUidSize;
-    memcpy(gKtaDeviceInfoConfig.deviceSerailNo, xpDeviceSerialNum, xDeviceSerialNumSize);
-    gKtaDeviceInfoConfig.deviceSerailNoLength = (uint8_t)xDeviceSerialNumSize;
+    memcpy(gpKtaConfigState->deviceInfo.deviceProfilePubUID[0], xpDeviceProfilePublicUid, xDeviceProfilePublicUidSize);
+    gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[0] = (uint8_t)xDeviceProfilePublicUidSize;
+    memcpy(gpKtaConfigState->deviceInfo.deviceSerailNo, xpDeviceSerialNum, xDeviceSerialNumSize);
+    gpKtaConfigState->deviceInfo.deviceSerailNoLength = (uint8_t)xDeviceSerialNumSize;
   }
   else if (xState > E_LIFE_CYCLE_STATE_INIT)
   {
@@ -182,13 +183,13 @@ TKStatus ktaSetDeviceInfoConfig
       goto end;
     }
 
-    uint8_t maxDevProfSize = (gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1] > gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0]) ?
-                             gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1] : gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0];
+    uint8_t maxDevProfSize = (gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[1] > gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[0]) ?
+                             gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[1] : gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[0];
 
-    if (0 != memcmp(xpDeviceProfilePublicUid, gKtaDeviceInfoConfig.deviceProfilePubUID[0], maxDevProfSize))
+    if (0 != memcmp(xpDeviceProfilePublicUid, gpKtaConfigState->deviceInfo.deviceProfilePubUID[0], maxDevProfSize))
     {
-      memcpy(gKtaDeviceInfoConfig.deviceProfilePubUID[1], xpDeviceProfilePublicUid, xDeviceProfilePublicUidSize);
-      gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1] = (uint8_t)xDeviceProfilePublicUidSize;
+      memcpy(gpKtaConfigState->deviceInfo.deviceProfilePubUID[1], xpDeviceProfilePublicUid, xDeviceProfilePublicUidSize);
+      gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[1] = (uint8_t)xDeviceProfilePublicUidSize;
     }
   }
   else
@@ -223,24 +224,24 @@ TKStatus ktaGetDeviceInfoConfig
   {
     /* Fill device specific info. */
     (void)memcpy(xpDeviceInfoConfig->deviceProfilePubUID[0],
-                 gKtaDeviceInfoConfig.deviceProfilePubUID[0],
-                 gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0]);
+                 gpKtaConfigState->deviceInfo.deviceProfilePubUID[0],
+                 gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[0]);
     xpDeviceInfoConfig->deviceProfilePubUIDLength[0] =
-        gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0];
+        gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[0];
 
-    if (gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1] != 0u)
+    if (gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[1] != 0u)
     {
       (void)memcpy(xpDeviceInfoConfig->deviceProfilePubUID[1],
-                   gKtaDeviceInfoConfig.deviceProfilePubUID[1],
-                   gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1]);
+                   gpKtaConfigState->deviceInfo.deviceProfilePubUID[1],
+                   gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[1]);
       xpDeviceInfoConfig->deviceProfilePubUIDLength[1] =
-          gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1];
+          gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[1];
     }
 
     (void)memcpy(xpDeviceInfoConfig->deviceSerailNo,
-                 gKtaDeviceInfoConfig.deviceSerailNo,
-                 gKtaDeviceInfoConfig.deviceSerailNoLength);
-    xpDeviceInfoConfig->deviceSerailNoLength = gKtaDeviceInfoConfig.deviceSerailNoLength;
+                 gpKtaConfigState->deviceInfo.deviceSerailNo,
+                 gpKtaConfigState->deviceInfo.deviceSerailNoLength);
+    xpDeviceInfoConfig->deviceSerailNoLength = gpKtaConfigState->deviceInfo.deviceSerailNoLength;
     status = E_K_STATUS_OK;
   }
 
@@ -277,36 +278,36 @@ TKStatus ktaSetContextInfoConfig
   if (xState == E_LIFE_CYCLE_STATE_INIT)
   {
     M_KTALOG__DEBUG("Setting kta context configuration data to the platform");
-    (void)memset(gKtaContextInfoConfig.ktaContextProfileUid,
+    (void)memset(gpKtaConfigState->contextInfo.ktaContextProfileUid,
                   0x00,
                   C_K__CONTEXT_PROFILE_UID_MAX_SIZE);
-    (void)memcpy(gKtaContextInfoConfig.ktaContextProfileUid, xpKtaContextProfileUid,
+    (void)memcpy(gpKtaConfigState->contextInfo.ktaContextProfileUid, xpKtaContextProfileUid,
                   xKtaContextProfileUidLen);
-    gKtaContextInfoConfig.ktaContextProfileUidLength = (uint8_t)xKtaContextProfileUidLen;
+    gpKtaConfigState->contextInfo.ktaContextProfileUidLength = (uint8_t)xKtaContextProfileUidLen;
 
-    (void)memset(gKtaContextInfoConfig.ktaContexSerialNumber,
+    (void)memset(gpKtaConfigState->contextInfo.ktaContexSerialNumber,
                   0x00,
                   C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE);
-    (void)memcpy(gKtaContextInfoConfig.ktaContexSerialNumber, xpKtaContexSerialNumber,
+    (void)memcpy(gpKtaConfigState->contextInfo.ktaContexSerialNumber, xpKtaContexSerialNumber,
                   xKtaContexSerialNumberLen);
-    gKtaContextInfoConfig.ktaContexSerialNumberLength = (uint8_t)xKtaContexSerialNumberLen;
+    gpKtaConfigState->contextInfo.ktaContexSerialNumberLength = (uint8_t)xKtaContexSerialNumberLen;
 
-    (void)memset(gKtaContextInfoConfig.ktaContextVersion,
+    (void)memset(gpKtaConfigState->contextInfo.ktaContextVersion,
                   0x00,
                   C_K__CONTEXT_VERSION_MAX_SIZE);
-    (void)memcpy(gKtaContextInfoConfig.ktaContextVersion,
+    (void)memcpy(gpKtaConfigState->contextInfo.ktaContextVersion,
                   xpKtaContextVersion,
                   xKtaContextVersionLen);
-    gKtaContextInfoConfig.ktaContextVersionLength = (uint8_t)xKtaContextVersionLen;
+    gpKtaConfigState->contextInfo.ktaContextVersionLength = (uint8_t)xKtaContextVersionLen;
 
     /* Loading kta version. */
-    (void)memset(gKtaContextInfoConfig.ktaVersion, 0, C_KTA__VERSION_MAX_SIZE);
-    (void)memcpy(gKtaContextInfoConfig.ktaVersion,
+    (void)memset(gpKtaConfigState->contextInfo.ktaVersion, 0, C_KTA__VERSION_MAX_SIZE);
+    (void)memcpy(gpKtaConfigState->contextInfo.ktaVersion,
                   ktaGetVersion(),
                   strnlen((const char*)ktaGetVersion(), C_KTA__VERSION_MAX_SIZE));
 
-    (void)memcpy(gKtaContextInfoConfig.l1SegSeed, xpL1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
-    gKtaContextInfoConfig.rotKeySetId = 0;
+    (void)memcpy(gpKtaConfigState->contextInfo.l1SegSeed, xpL1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
+    gpKtaConfigState->contextInfo.rotKeySetId = 0;
     status = E_K_STATUS_OK;
   }
   else
@@ -316,7 +317,7 @@ TKStatus ktaSetContextInfoConfig
     handles the error scenario. */
     if (xState == E_LIFE_CYCLE_STATE_SEALED)
     {
-      (void)memcpy(gKtaContextInfoConfig.l1SegSeed,
+      (void)memcpy(gpKtaConfigState->contextInfo.l1SegSeed,
                     xpL1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
     }
   }
@@ -348,26 +349,26 @@ TKStatus ktaGetContextInfoConfig
     /* Fill context specific platform data. */
     M_KTALOG__DEBUG("Getting kta context specific data");
     (void)memcpy(xpContextInfoConfig->l1SegSeed,
-                 gKtaContextInfoConfig.l1SegSeed,
-                 sizeof(gKtaContextInfoConfig.l1SegSeed));
+                 gpKtaConfigState->contextInfo.l1SegSeed,
+                 sizeof(gpKtaConfigState->contextInfo.l1SegSeed));
 
     (void)memcpy(xpContextInfoConfig->ktaContextProfileUid,
-                 gKtaContextInfoConfig.ktaContextProfileUid,
-                 sizeof(gKtaContextInfoConfig.ktaContextProfileUid));
+                 gpKtaConfigState->contextInfo.ktaContextProfileUid,
+                 sizeof(gpKtaConfigState->contextInfo.ktaContextProfileUid));
 
     (void)memcpy(xpContextInfoConfig->ktaContexSerialNumber,
-                 gKtaContextInfoConfig.ktaContexSerialNumber,
-                 sizeof(gKtaContextInfoConfig.ktaContexSerialNumber));
+                 gpKtaConfigState->contextInfo.ktaContexSerialNumber,
+                 sizeof(gpKtaConfigState->contextInfo.ktaContexSerialNumber));
 
     (void)memcpy(xpContextInfoConfig->ktaContextVersion,
-                 gKtaContextInfoConfig.ktaContextVersion,
-                 sizeof(gKtaContextInfoConfig.ktaContextVersion));
+                 gpKtaConfigState->contextInfo.ktaContextVersion,
+                 sizeof(gpKtaConfigState->contextInfo.ktaContextVersion));
 
     (void)memcpy(xpContextInfoConfig->ktaVersion,
-                 gKtaContextInfoConfig.ktaVersion,
-                 sizeof(gKtaContextInfoConfig.ktaVersion));
+                 gpKtaConfigState->contextInfo.ktaVersion,
+                 sizeof(gpKtaConfigState->contextInfo.ktaVersion));
 
-    xpContextInfoConfig->rotKeySetId = gKtaContextInfoConfig.rotKeySetId;
+    xpContextInfoConfig->rotKeySetId = gpKtaConfigState->contextInfo.rotKeySetId;
 
     status = E_K_STATUS_OK;
   }
@@ -396,7 +397,7 @@ TKStatus ktaGetL1SegSeed
   }
   else
   {
-    (void)memcpy(xpL1SegSeed, gKtaContextInfoConfig.l1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
+    (void)memcpy(xpL1SegSeed, gpKtaConfigState->contextInfo.l1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
     status = E_K_STATUS_OK;
   }
 
@@ -424,7 +425,7 @@ TKStatus ktaGetRotKeySetId
   }
   else
   {
-    *xpRotKeySetId = gKtaContextInfoConfig.rotKeySetId;
+    *xpRotKeySetId = gpKtaConfigState->contextInfo.rotKeySetId;
     status = E_K_STATUS_OK;
   }
 
@@ -452,7 +453,7 @@ TKStatus ktaSetRotKeySetId
   }
   else
   {
-    gKtaContextInfoConfig.rotKeySetId = xRotKeySetId;
+    gpKtaConfigState->contextInfo.rotKeySetId = xRotKeySetId;
     status = E_K_STATUS_OK;
   }
 
@@ -460,11 +461,23 @@ TKStatus ktaSetRotKeySetId
   return status;
 }
 
+/**
+ * @brief implement ktaConfigBindState
+ *
+ */
+void ktaConfigBindState
+(
+  TKtaConfigState* xpState
+)
+{
+  gpKtaConfigState = (NULL == xpState) ? &gKtaConfigState : xpState;
+}
+
 #ifdef TEST_COVERAGE
 void ktaResetConfig(void)
 {
-  memset(&gKtaDeviceInfoConfig, 0, sizeof(TKtaDeviceInfoConfig));
-  memset(&gKtaContextInfoConfig, 0, sizeof(TKtaContextInfoConfig));
+  memset(&gpKtaConfigState->deviceInfo, 0, sizeof(TKtaDeviceInfoConfig));
+  memset(&gpKtaConfigState->contextInfo, 0, sizeof(TKtaContextInfoConfig));
 }
 #endif
 /* -------------------------------------------------------------------------- */
@@ -499,31 +512,31 @@ static TKStatus lReadDeviceAndContextInfo
       goto end;
     }
 
-    memcpy(gKtaContextInfoConfig.ktaContextProfileUid, aKtaInfo, C_K__CONTEXT_PROFILE_UID_MAX_SIZE);
+    memcpy(gpKtaConfigState->contextInfo.ktaContextProfileUid, aKtaInfo, C_K__CONTEXT_PROFILE_UID_MAX_SIZE);
     offset = C_K__CONTEXT_PROFILE_UID_MAX_SIZE;
-    gKtaContextInfoConfig.ktaContextProfileUidLength = aKtaInfo[offset++];
+    gpKtaConfigState->contextInfo.ktaContextProfileUidLength = aKtaInfo[offset++];
 
-    memcpy(gKtaContextInfoConfig.ktaContexSerialNumber, &aKtaInfo[offset], C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE);
+    memcpy(gpKtaConfigState->contextInfo.ktaContexSerialNumber, &aKtaInfo[offset], C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE);
     offset += C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE;
-    gKtaContextInfoConfig.ktaContexSerialNumberLength = aKtaInfo[offset++];
+    gpKtaConfigState->contextInfo.ktaContexSerialNumberLength = aKtaInfo[offset++];
 
-    memcpy(gKtaContextInfoConfig.ktaContextVersion, &aKtaInfo[offset], C_K__CONTEXT_VERSION_MAX_SIZE);
+    memcpy(gpKtaConfigState->contextInfo.ktaContextVersion, &aKtaInfo[offset], C_K__CONTEXT_VERSION_MAX_SIZE);
     offset += C_K__CONTEXT_VERSION_MAX_SIZE;
-    gKtaContextInfoConfig.ktaContextVersionLength = aKtaInfo[offset++];
+    gpKtaConfigState->contextInfo.ktaContextVersionLength = aKtaInfo[offset++];
 
     // REQ RQ_M-KTA-REGT-CF-0070(1) : KTA Version
-    memset(gKtaContextInfoConfig.ktaVersion, 0, C_KTA__VERSION_MAX_SIZE);
-    memcpy(gKtaContextInfoConfig.ktaVersion, ktaGetVersion(),
+    memset(gpKtaConfigState->contextInfo.ktaVersion, 0, C_KTA__VERSION_MAX_SIZE);
+    memcpy(gpKtaConfigState->contextInfo.ktaVersion, ktaGetVersion(),
            strnlen((const char*)ktaGetVersion(), C_KTA__VERSION_MAX_SIZE));
     offset += C_KTA__VERSION_MAX_SIZE;
 
-    memcpy(gKtaDeviceInfoConfig.deviceProfilePubUID[0], &aKtaInfo[offset], C_K__DEVICE_PROFILE_PUBLIC_UID_MAX_SIZE);
+    memcpy(gpKtaConfigState->deviceInfo.deviceProfilePubUID[0], &aKtaInfo[offset], C_K__DEVICE_PROFILE_PUBLIC_UID_MAX_SIZE);
     offset += C_K__DEVICE_PROFILE_PUBLIC_UID_MAX_SIZE;
-    gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0] = aKtaInfo[offset++];
+    gpKtaConfigState->deviceInfo.deviceProfilePubUIDLength[0] = aKtaInfo[offset++];
 
-    memcpy(gKtaDeviceInfoConfig.deviceSerailNo, &aKtaInfo[offset], C_K__DEVICE_SERIAL_NUM_MAX_SIZE);
+    memcpy(gpKtaConfigState->deviceInfo.deviceSerailNo, &aKtaInfo[offset], C_K__DEVICE_SERIAL_NUM_MAX_SIZE);
     offset += C_K__DEVICE_SERIAL_NUM_MAX_SIZE;
-    gKtaDeviceInfoConfig.deviceSerailNoLength = aKtaInfo[offset];
+    gpKtaConfigState->deviceInfo.deviceSerailNoLength = aKtaInfo[offset];
   }
 
   if ((xState == E_LIFE_CYCLE_STATE_ACTIVATED) ||
@@ -540,8 +553,8 @@ static TKStatus lReadDeviceAndContextInfo
       goto end;
     }
 
-    memcpy(gKtaContextInfoConfig.l1SegSeed, aL1KeyMaterial, C_K__L1_SEGMENTATION_SEED_SIZE);
-    gKtaContextInfoConfig.rotKeySetId = aL1KeyMaterial[C_K__L1_SEGMENTATION_SEED_SIZE];
+    memcpy(gpKtaConfigState->contextInfo.l1SegSeed, aL1KeyMaterial, C_K__L1_SEGMENTATION_SEED_SIZE);
+    gpKtaConfigState->contextInfo.rotKeySetId = aL1KeyMaterial[C_K__L1_SEGMENTATION_SEED_SIZE];
   }
 
 end:
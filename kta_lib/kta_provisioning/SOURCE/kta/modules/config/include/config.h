@@ -108,6 +108,15 @@ typedef struct
   /* keySTREAM Trusted Agent rot key set id. */
 } TKtaContextInfoConfig;
 
+/** @brief Configuration of one keySTREAM Trusted Agent instance. */
+typedef struct
+{
+  TKtaDeviceInfoConfig   deviceInfo;
+  /* Device information. */
+  TKtaContextInfoConfig  contextInfo;
+  /* Context information. */
+} TKtaConfigState;
+
 /** @brief keySTREAM Trusted Agent life cycle state. */
 typedef enum
 {
@@ -314,6 +323,19 @@ TKStatus ktaSetRotKeySetId
   uint8_t xRotKeySetId
 );
 
+/**
+ * @brief
+ *   Select the configuration used by the next calls of this module from the
+ *   calling thread.
+ *
+ * @param[in] xpState
+ *   Configuration of the served instance, NULL for the built-in one.
+ */
+void ktaConfigBindState
+(
+  TKtaConfigState* xpState
+);
+
 #ifdef TEST_COVERAGE
 void ktaResetConfig(void);
 #endif
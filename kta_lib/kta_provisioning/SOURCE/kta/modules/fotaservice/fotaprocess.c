@@ -43,6 +43,7 @@
 #include "fotaplatform.h"
 #include "k_sal_storage.h"
 #include "k_sal_fotastorage.h"
+#include "k_crc32.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -87,47 +88,26 @@ static const uint8_t aFotaErrorCauses[FOTA_ERROR_COUNT][ERROR_CAUSE_MAX_LEN] =
   {0x4E, 0x4F, 0x20, 0x43, 0x4F, 0x4D, 0x50, 0x4F, 0x4E, 0x45, 0x4E, 0x54, 0x53, 0x00, 0x00, 0x00}  // "NO COMPONENTS"
 };
 
+#if (COMPONENTS_MAX > 8u)
+#error "The FOTA journal masks the components of a campaign on 8 bits"
+#endif
+
+#if ((COMPONENTS_MAX + 2u) >= FOTA_JOURNAL_ENTRY_COUNT)
+#error "The FOTA journal ring must hold the live entries of a campaign and a free slot"
+#endif
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
-/* Global buffer to store FOTA metadata */
-static uint8_t gFotaMetadata[MAX_FOTA_META_DATA] = {0};
-
-/* Global variable to store FOTA metadata length */
-static size_t gFotaMetadataLen = 0;
-
-/* Structure to maintain status of each components */
-TFotaComponentStatus gFotaComponentStatus = {0};
-
-/* To fix the misra-c2012-9.2 & misra-c2012-9.4-An element of an object shall not be initialized more than once */
-TComponent installedComponents[COMPONENTS_MAX] = {
-  { { }, 0, { }, 0 }
-};
+/* FOTA state of the built-in instance */
+static TFotaProcessState gFotaState = {0};
 
-static bool fotaInialized = false;
+/* FOTA state of the instance served by the calling thread */
+static K_THREAD_LOCAL TFotaProcessState *gpFotaState = &gFotaState;
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
 
-/**
- * @brief Calculate CRC32 checksum for data buffer.
- *
- * Uses standard CRC32 polynomial (0xEDB88320).
- *
- * @param[in] data
- *   Pointer to data buffer.
- * @param[in] length
- *   Length of data in bytes.
- *
- * @return
- * - uint32_t CRC32 checksum value.
- */
-static uint32_t calculateCRC32
-(
-  const uint8_t *data,
-  size_t         length
-);
-
 /**
  * @brief Validate CRC32 checksum of FOTA component record.
  *
@@ -205,14 +185,139 @@ static bool validateCommitRecord
 );
 
 /**
- * @brief Set CRC32 checksum for FOTA commit record.
+ * @brief Validate CRC32 checksum of FOTA journal entry.
  *
- * @param[in,out] record
- *   Pointer to commit record to calculate and set CRC.
+ * @param[in] entry
+ *   Pointer to journal entry to validate.
+ *
+ * @return
+ * - bool true if CRC and sequence are valid, false if torn or erased.
+ */
+static bool validateJournalEntry
+(
+  const TFotaJournalEntry *entry
+);
+
+/**
+ * @brief Calculate and set CRC32 for FOTA journal entry.
+ *
+ * @param[in,out] entry
+ *   Pointer to journal entry to update.
+ */
+static void setJournalEntryCRC
+(
+  TFotaJournalEntry *entry
+);
+
+/**
+ * @brief Add the fields of a component record that stay fixed during a campaign
+ *        (index, name and URL) to the campaign CRC.
+ *
+ * @param[in,out] crc
+ *   Running campaign CRC.
+ * @param[in] index
+ *   Component index.
+ * @param[in] record
+ *   Pointer to component record.
+ */
+static void addComponentToBaseCrc
+(
+  TKCrc32                    *crc,
+  size_t                      index,
+  const TFotaComponentRecord *record
+);
+
+/**
+ * @brief Read a component record and load its name, version and state in RAM.
+ *
+ * @param[in] index
+ *   Component index.
+ * @param[out] record
+ *   Pointer to component record read.
+ *
+ * @return
+ * - bool true if the record was read and is valid.
+ */
+static bool loadComponentRecord
+(
+  size_t                index,
+  TFotaComponentRecord *record
+);
+
+/**
+ * @brief Load a campaign recorded before the journal, from the commit record
+ *        and the component records.
+ */
+static void loadLegacyCampaign
+(
+  void
+);
+
+/**
+ * @brief Rebuild the campaign state with a single scan of the journal.
+ *
+ * The newest campaign is the one of the highest BASE sequence found. Its
+ * component records are checked against the CRC of the BASE entry, then the
+ * latest entry of each component is applied over them.
+ *
+ * @return
+ * - bool true if the journal holds entries, false if it is empty.
+ */
+static bool journalLoad
+(
+  void
+);
+
+/**
+ * @brief Append an entry to the journal.
+ *
+ * A BASE entry starts a new campaign. Other entries are appended to the
+ * running campaign, compacted first so that they cannot overwrite one of its
+ * live entries.
+ *
+ * @param[in,out] entry
+ *   Pointer to entry; type, index, state and version are set by the caller,
+ *   and baseCrc for a BASE entry.
+ *
+ * @return
+ * - bool true on success, false if the write failed.
+ */
+static bool journalAppend
+(
+  TFotaJournalEntry *entry
+);
+
+/**
+ * @brief Write an entry at the head of the journal and track it in RAM.
+ *
+ * @param[in,out] entry
+ *   Pointer to entry; the sequence and CRC are set here, and the campaign
+ *   for a BASE entry whose campaign is 0.
+ *
+ * @return
+ * - bool true on success, false if the write failed.
+ */
+static bool journalWrite
+(
+  TFotaJournalEntry *entry
+);
+
+/**
+ * @brief Make room for the next entry of the campaign.
+ *
+ * A campaign recorded before the journal gets its BASE entry. Then the
+ * oldest live entries of the campaign are copied to the head of the journal,
+ * one at a time, until the next append cannot overwrite one of them. The
+ * component records are never rewritten, and each write only overwrites a
+ * dead slot: a power cut at any point leaves the campaign intact.
+ *
+ * @return
+ * - bool true on success, false if a record could not be read or an entry
+ *   could not be written.
  */
-static void setCommitRecord
+static bool journalCompact
 (
-  TFotaCommitRecord *record
+  void
 );
 
 /**
@@ -311,43 +416,6 @@ void initializefotaState
 
   M_KTALOG__START("Start");
 
-  // CRITICAL: Check commit flag FIRST before processing any FOTA data
-  // If commit flag is not valid (0xAA), entire FOTA campaign is incomplete/corrupted
-  TFotaCommitRecord commitRecord = {0};
-  size_t commitRecordLen = sizeof(TFotaCommitRecord);
-  bool readCommit = salFotaStorageRead(FOTA_STORAGE_COMMIT_ID, (uint8_t*)&commitRecord, &commitRecordLen);
-  
-  bool campaignValid = false;
-  if (readCommit && validateCommitRecord(&commitRecord))
-  {
-    if (commitRecord.commitFlag == FOTA_COMMIT_VALID)
-    {
-      M_KTALOG__INFO("Commit flag VALID (0xAA) - resuming FOTA campaign with %u components (state=%u)\r\n",
-                     (unsigned int)commitRecord.numComponents,
-                     (unsigned int)commitRecord.campaignState);
-      campaignValid = true;
-    }
-    else if (commitRecord.commitFlag == FOTA_COMMIT_INVALID && 
-             commitRecord.campaignState == FOTA_CAMPAIGN_IN_PROGRESS)
-    {
-      // CRITICAL: Allow resume of campaigns that were updating when power lost
-      // This preserves component progress (SUCCESS/ERROR states) after power cycles
-      M_KTALOG__INFO("Resuming FOTA campaign in IN_PROGRESS state after power cycle (numComponents=%u)\r\n",
-                     (unsigned int)commitRecord.numComponents);
-      campaignValid = true;
-    }
-    else
-    {
-      M_KTALOG__WARN("Commit flag INVALID (0x%02X) with state=%u - FOTA campaign incomplete, resetting to IDLE\r\n",
-                     (unsigned int)commitRecord.commitFlag,
-                     (unsigned int)commitRecord.campaignState);
-    }
-  }
-  else
-  {
-    M_KTALOG__WARN("Commit record not found or invalid - no active FOTA campaign\r\n");
-  }
-
   // Get installed component information from platform
   retStatus = fotaPlatformGetComponents(components);
   if (E_K_FOTA_SUCCESS != retStatus)
@@ -362,95 +430,51 @@ void initializefotaState
     if ((0 < components[i].componentNameLen) ||
         (0 < components[i].componentVersionLen))
     {
-      memcpy(installedComponents[i].componentName,
+      memcpy(gpFotaState->installedComponents[i].componentName,
             components[i].componentName,
             components[i].componentNameLen);
-      installedComponents[i].componentNameLen = components[i].componentNameLen;
-      memcpy(installedComponents[i].componentVersion,
+      gpFotaState->installedComponents[i].componentNameLen = components[i].componentNameLen;
+      memcpy(gpFotaState->installedComponents[i].componentVersion,
         components[i].componentVersion,
         components[i].componentVersionLen);
-      installedComponents[i].componentVersionLen = components[i].componentVersionLen;
+      gpFotaState->installedComponents[i].componentVersionLen = components[i].componentVersionLen;
     }
   }
 
-  // Initialize global state of fota target components list
+  // Every target component is IDLE until the journal or the commit record proves a campaign
   for (size_t i = 0; i < COMPONENTS_MAX; i++)
   {
-    // If commit flag is invalid, reset all components to IDLE without reading EEPROM
-    if (!campaignValid)
-    {
-      gFotaComponentStatus.state[i] = E_FOTA_STATE_IDLE;
-      gFotaComponentStatus.components[i].componentNameLen = 0;
-      gFotaComponentStatus.components[i].componentVersionLen = 0;
-      continue;
-    }
-    
-    // Read combined component record (name, version, state together)
-    TFotaComponentRecord compRecord = {0};
-    size_t compRecordLen = sizeof(TFotaComponentRecord);
-    bool readComp = salFotaStorageRead(FOTA_STORAGE_COMPONENT_ID(i), (uint8_t*)&compRecord, &compRecordLen);
-
-    if (true != readComp)
-    {
-      M_KTALOG__ERR("ERROR: Failed to read component record from storage.\r\n");
-      // Initialize with default values instead of exiting
-      gFotaComponentStatus.state[i] = E_FOTA_STATE_IDLE;
-      gFotaComponentStatus.components[i].componentNameLen = 0;
-      gFotaComponentStatus.components[i].componentVersionLen = 0;
-      continue;  // Skip to next component
-    }
-
-    // Validate CRC32 checksum for power-cycle corruption detection
-    if (!validateComponentRecordCRC(&compRecord))
-    {
-      M_KTALOG__ERR("[ERR] Component record %u failed CRC validation during init - treating as IDLE\r\n", (unsigned int)i);
-      gFotaComponentStatus.state[i] = E_FOTA_STATE_IDLE;
-      gFotaComponentStatus.components[i].componentNameLen = 0;
-      gFotaComponentStatus.components[i].componentVersionLen = 0;
-      continue;
-    }
-
-    // Validate lengths to prevent buffer overflow
-    if (compRecord.componentNameLen > 16)
-    {
-      M_KTALOG__ERR("ERROR: Invalid componentNameLen (%u) for component %u\r\n", 
-                     (unsigned int)compRecord.componentNameLen, (unsigned int)i);
-      compRecord.componentNameLen = 0;
-    }
-
-    if (compRecord.componentVersionLen > 16)
-    {
-      M_KTALOG__ERR("ERROR: Invalid componentVersionLen (%u) for component %u\r\n", 
-                     (unsigned int)compRecord.componentVersionLen, (unsigned int)i);
-      compRecord.componentVersionLen = 0;
-    }
-
-    gFotaComponentStatus.state[i] = compRecord.state;
-
-    if (compRecord.componentNameLen > 0)
-    {
-      memcpy(gFotaComponentStatus.components[i].componentName,
-         compRecord.componentName,
-         compRecord.componentNameLen);
-
-      gFotaComponentStatus.components[i].componentNameLen = compRecord.componentNameLen;
-      if (compRecord.componentVersionLen > 0)
-      {
-        memcpy(gFotaComponentStatus.components[i].componentVersion,
-             compRecord.componentVersion,
-             compRecord.componentVersionLen);
-      }
-    }
-    gFotaComponentStatus.components[i].componentVersionLen = compRecord.componentVersionLen;
+    gpFotaState->componentStatus.state[i] = E_FOTA_STATE_IDLE;
+    gpFotaState->componentStatus.components[i].componentNameLen = 0;
+    gpFotaState->componentStatus.components[i].componentVersionLen = 0;
+  }
+  memset(&gpFotaState->journal, 0, sizeof(TFotaJournal));
 
+  // Rebuild the campaign state from one scan of the journal; an empty journal
+  // means the campaign, if any, was recorded before the journal existed
+  if (!journalLoad())
+  {
+    loadLegacyCampaign();
   }
 
-  fotaInialized = true;
+  gpFotaState->isInitialized = true;
 end:
   M_KTALOG__END("End, status : 0\r\n");
   return;
 }
 
+/**
+ * @brief implement fotaProcessBindState
+ *
+ */
+void fotaProcessBindState
+(
+  TFotaProcessState *xpState
+)
+{
+  gpFotaState = (NULL == xpState) ? &gFotaState : xpState;
+}
+
 /**
  * @brief implement fotaGetInstalledComponents
  *
@@ -468,7 +492,7 @@ TKFotaStatus fotaGetInstalledComponents
   {
     goto end;
   }
-  if (!fotaInialized)
+  if (!gpFotaState->isInitialized)
   {
     initializefotaState();
   }
@@ -476,13 +500,13 @@ TKFotaStatus fotaGetInstalledComponents
   for (size_t i = 0; i < COMPONENTS_MAX; i++)
   {
     memcpy(xpComponents[i].componentName,
-          installedComponents[i].componentName,
-          installedComponents[i].componentNameLen);
-    xpComponents[i].componentNameLen = installedComponents[i].componentNameLen;
+          gpFotaState->installedComponents[i].componentName,
+          gpFotaState->installedComponents[i].componentNameLen);
+    xpComponents[i].componentNameLen = gpFotaState->installedComponents[i].componentNameLen;
     memcpy(xpComponents[i].componentVersion,
-      installedComponents[i].componentVersion,
-      installedComponents[i].componentVersionLen);
-    xpComponents[i].componentVersionLen = installedComponents[i].componentVersionLen;
+      gpFotaState->installedComponents[i].componentVersion,
+      gpFotaState->installedComponents[i].componentVersionLen);
+    xpComponents[i].componentVersionLen = gpFotaState->installedComponents[i].componentVersionLen;
   }
   retStatus = E_K_FOTA_SUCCESS;
 end:
@@ -648,8 +672,8 @@ TKFotaStatus storeMetadata
   }
 
   // Store metadata
-  memcpy(gFotaMetadata, xFotaMetadata, xFotaMetadataLen);
-  gFotaMetadataLen = xFotaMetadataLen;
+  memcpy(gpFotaState->metadata, xFotaMetadata, xFotaMetadataLen);
+  gpFotaState->metadataLen = xFotaMetadataLen;
   retStatus = E_K_FOTA_SUCCESS;
 end:
   M_KTALOG__END("End, status : %d", retStatus);
@@ -684,7 +708,7 @@ TKFotaStatus fotaGetTargetComponents
     goto end;
   }
 
-  if (!fotaInialized)
+  if (!gpFotaState->isInitialized)
   {
     initializefotaState();
   }
@@ -693,9 +717,15 @@ TKFotaStatus fotaGetTargetComponents
   *xpNumComponents = 0;
   memset(xpTargetComponents, 0, sizeof(TFotaComponentRecord) * COMPONENTS_MAX);
 
-  // Read all component records from storage
+  // Read the component records of the campaign, the journal holds their current state
   for (size_t i = 0; i < COMPONENTS_MAX; i++)
   {
+    if ((E_FOTA_STATE_IDLE == gpFotaState->componentStatus.state[i]) ||
+        (0 == gpFotaState->componentStatus.components[i].componentNameLen))
+    {
+      continue;  // Not part of the campaign
+    }
+
     size_t recordLen = sizeof(TFotaComponentRecord);
     bool readStatus = salFotaStorageRead(FOTA_STORAGE_COMPONENT_ID(i), (uint8_t*)&xpTargetComponents[i], &recordLen);
 
@@ -713,6 +743,15 @@ TKFotaStatus fotaGetTargetComponents
       continue;  // Skip this component
     }
 
+    // Apply the state and version of the journal over the record
+    xpTargetComponents[i].state = (uint8_t)gpFotaState->componentStatus.state[i];
+    xpTargetComponents[i].componentVersionLen =
+      (uint8_t)gpFotaState->componentStatus.components[i].componentVersionLen;
+    memcpy(xpTargetComponents[i].componentVersion,
+           gpFotaState->componentStatus.components[i].componentVersion,
+           xpTargetComponents[i].componentVersionLen);
+    setComponentRecordCRC(&xpTargetComponents[i]);
+
     // Check if this component has valid data
     if (xpTargetComponents[i].componentNameLen > 0)
     {
@@ -765,6 +804,11 @@ TKFotaStatus fotaGetComponentsStatus
 
   M_KTALOG__START("Start");
 
+  if (!gpFotaState->isInitialized)
+  {
+    initializefotaState();
+  }
+
   // Read and validate FOTA name record with CRC
   if (!salFotaStorageRead(FOTA_STORAGE_NAME_ID, (uint8_t*)&nameRecord, &nameRecordLen) ||
       !validateNameRecordCRC(&nameRecord))
@@ -790,29 +834,11 @@ TKFotaStatus fotaGetComponentsStatus
   }
 
   // Iterate through all components to check their status
-  // CRITICAL: Read state from EEPROM instead of RAM to ensure power-cycle consistency
+  // RAM state is rebuilt from the journal at init and only changes after a successful append
   for (size_t i = 0; i < COMPONENTS_MAX; i++)
   {
-    // Read component record from EEPROM to get current state
-    TFotaComponentRecord compRecord = {0};
-    size_t compRecordLen = sizeof(TFotaComponentRecord);
-    bool readSuccess = salFotaStorageRead(FOTA_STORAGE_COMPONENT_ID(i), (uint8_t*)&compRecord, &compRecordLen);
-    
-    if (readSuccess && validateComponentRecordCRC(&compRecord))
-    {
-      // Use EEPROM state (source of truth after power cycle)
-      compState = compRecord.state;
-      
-      // Sync RAM state with EEPROM state
-      gFotaComponentStatus.state[i] = compState;
-    }
-    else
-    {
-      // If EEPROM read fails or CRC invalid, component is not active
-      compState = E_FOTA_STATE_IDLE;
-      gFotaComponentStatus.state[i] = E_FOTA_STATE_IDLE;
-    }
-    
+    compState = gpFotaState->componentStatus.state[i];
+
     if (E_FOTA_STATE_IN_PROGRESS == compState)
     {
       retStatus = E_K_FOTA_IN_PROGRESS;
@@ -868,6 +894,8 @@ TKFotaStatus fotaDownloadAndInstall
   TKFotaStatus retStatus = E_K_FOTA_ERROR; // Initial status
   uint8_t writeStatus          =     false;
   uint8_t numComponents        =     0;  // Count of components in this campaign
+  uint8_t componentMask        =     0;  // Components of this campaign, one bit per index
+  TKCrc32 baseCrc;                       // CRC of the fixed part of the campaign records
 
   M_KTALOG__START("Start");
 
@@ -876,8 +904,8 @@ TKFotaStatus fotaDownloadAndInstall
     M_KTALOG__ERR("ERROR: xpFotaName is NULL\r\n");
     goto end;
   }
-  memcpy(gFotaComponentStatus.xpFotaName, xpFotaName, xFotaNameLen);
-  gFotaComponentStatus.xFotaNameLen = xFotaNameLen;
+  memcpy(gpFotaState->componentStatus.xpFotaName, xpFotaName, xFotaNameLen);
+  gpFotaState->componentStatus.xFotaNameLen = xFotaNameLen;
 
   // Store xpFotaName with CRC protection
   TFotaNameRecord nameRecord = {0};
@@ -892,6 +920,8 @@ TKFotaStatus fotaDownloadAndInstall
     retStatus = E_K_FOTA_ERROR;
     goto end;
   }
+  ktaCrc32Init(&baseCrc);
+  ktaCrc32Update(&baseCrc, nameRecord.name, nameRecord.nameLen);
 
   // Store xpFotaMetadata with CRC protection
   if ((NULL != xpFotaMetadata) && (0 < xFotaMetadataLen))
@@ -947,38 +977,47 @@ TKFotaStatus fotaDownloadAndInstall
       }
 
       // Update global state after successful write
-      gFotaComponentStatus.state[i] = E_FOTA_STATE_IN_PROGRESS;
-      memcpy(gFotaComponentStatus.components[i].componentName,
+      gpFotaState->componentStatus.state[i] = E_FOTA_STATE_IN_PROGRESS;
+      memcpy(gpFotaState->componentStatus.components[i].componentName,
             xpTargetComponents[i].componentTargetName,
             xpTargetComponents[i].componentTargetNameLen);
-      gFotaComponentStatus.components[i].componentNameLen = xpTargetComponents[i].componentTargetNameLen;
-      memcpy(gFotaComponentStatus.components[i].componentVersion,
+      gpFotaState->componentStatus.components[i].componentNameLen = xpTargetComponents[i].componentTargetNameLen;
+      memcpy(gpFotaState->componentStatus.components[i].componentVersion,
             xpTargetComponents[i].componentTargetVersion,
             xpTargetComponents[i].componentTargetVersionLen);
-      gFotaComponentStatus.components[i].componentVersionLen = xpTargetComponents[i].componentTargetVersionLen;
+      gpFotaState->componentStatus.components[i].componentVersionLen = xpTargetComponents[i].componentTargetVersionLen;
       
-      // Count this component for commit record
+      // Count this component for the BASE journal entry
+      addComponentToBaseCrc(&baseCrc, i, &compRecord);
+      componentMask |= (uint8_t)(1u << i);
       numComponents++;
     }
+    else
+    {
+      // Not part of this campaign
+      gpFotaState->componentStatus.state[i] = E_FOTA_STATE_IDLE;
+      gpFotaState->componentStatus.components[i].componentNameLen = 0;
+      gpFotaState->componentStatus.components[i].componentVersionLen = 0;
+    }
   }
 
-  // CRITICAL: Write commit flag as LAST operation to indicate campaign completion
-  // This must be the final write - if power is lost before this, entire campaign is invalid
-  TFotaCommitRecord commitRecord = {0};
-  commitRecord.commitFlag = FOTA_COMMIT_VALID;  // 0xAA = valid/complete
-  commitRecord.numComponents = numComponents;
-  commitRecord.campaignState = FOTA_CAMPAIGN_INIT;  // Campaign initialized, components IN_PROGRESS
-  setCommitRecord(&commitRecord);
-  
-  writeStatus = salFotaStorageWrite(FOTA_STORAGE_COMMIT_ID, (const uint8_t*)&commitRecord, sizeof(TFotaCommitRecord));
+  // CRITICAL: Append the BASE journal entry as LAST operation to indicate campaign initialization
+  // If power is lost before this, the records do not match the journal and the campaign is dropped
+  TFotaJournalEntry baseEntry = {0};
+  baseEntry.type = FOTA_JOURNAL_BASE;
+  baseEntry.index = componentMask;
+  baseEntry.state = FOTA_CAMPAIGN_INIT;  // Campaign initialized, components IN_PROGRESS
+  baseEntry.baseCrc = ktaCrc32Final(&baseCrc);
+
+  writeStatus = journalAppend(&baseEntry);
   if (true != writeStatus)
   {
-    M_KTALOG__ERR("ERROR: Failed to write commit flag - FOTA campaign incomplete\r\n");
+    M_KTALOG__ERR("ERROR: Failed to write journal base entry - FOTA campaign incomplete\r\n");
     retStatus = E_K_FOTA_ERROR;
     goto end;
   }
   
-  M_KTALOG__INFO("SUCCESS: Commit flag written - FOTA campaign initialization complete (numComponents=%u)\r\n", 
+  M_KTALOG__INFO("SUCCESS: Journal base entry written - FOTA campaign initialization complete (numComponents=%u)\r\n", 
                  (unsigned int)numComponents);
 
   // Start FOTA installation
@@ -1029,125 +1068,68 @@ TKFotaStatus fotaUpdateComponent
   // Find the component index and update
   for (size_t i = 0; i < COMPONENTS_MAX; i++)
   {
-    if ((componentNameLen == gFotaComponentStatus.components[i].componentNameLen) &&
-        (0 == memcmp(componentName, gFotaComponentStatus.components[i].componentName, componentNameLen)))
+    if ((componentNameLen == gpFotaState->componentStatus.components[i].componentNameLen) &&
+        (0 == memcmp(componentName, gpFotaState->componentStatus.components[i].componentName, componentNameLen)))
     {
-      // CRITICAL: Invalidate commit flag BEFORE updating component state
-      // This protects against power loss during the update sequence
-      TFotaCommitRecord commitRecord = {0};
-      size_t commitRecordLen = sizeof(TFotaCommitRecord);
-      
-      // Read current commit record
-      if (salFotaStorageRead(FOTA_STORAGE_COMMIT_ID, (uint8_t*)&commitRecord, &commitRecordLen) &&
-          validateCommitRecord(&commitRecord))
-      {
-        // Only invalidate if not already in IN_PROGRESS state (optimization)
-        if (commitRecord.campaignState != FOTA_CAMPAIGN_IN_PROGRESS)
-        {
-          // Mark campaign as IN_PROGRESS (updates happening)
-          commitRecord.commitFlag = FOTA_COMMIT_INVALID;  // 0xFF = invalid during updates
-          commitRecord.campaignState = FOTA_CAMPAIGN_IN_PROGRESS;
-          setCommitRecord(&commitRecord);
-          
-          writeStatus = salFotaStorageWrite(FOTA_STORAGE_COMMIT_ID, (const uint8_t*)&commitRecord, sizeof(TFotaCommitRecord));
-          if (!writeStatus)
-          {
-            M_KTALOG__ERR("ERROR: Failed to invalidate commit flag before component update\n");
-            retStatus = E_K_FOTA_ERROR;
-            goto end;
-          }
-          M_KTALOG__INFO("Commit flag invalidated for component update (transition to IN_PROGRESS)\n");
-        }
-        else
-        {
-          M_KTALOG__INFO("Commit already in IN_PROGRESS state, skipping invalidation\n");
-        }
-      }
-      
-      // Prepare combined component record
-      // CRITICAL: Read existing record first to preserve URL field
-      TFotaComponentRecord compRecord = {0};
-      size_t compRecordLen = sizeof(TFotaComponentRecord);
-      bool readExisting = salFotaStorageRead(FOTA_STORAGE_COMPONENT_ID(i), (uint8_t*)&compRecord, &compRecordLen);
-      
-      if (!readExisting || !validateComponentRecordCRC(&compRecord))
-      {
-        M_KTALOG__WARN("WARN: Could not read existing component record, creating new one\n");
-        memset(&compRecord, 0, sizeof(TFotaComponentRecord));
-        compRecord.componentNameLen = componentNameLen;
-        memcpy(compRecord.componentName, componentName, componentNameLen);
-      }
-      
-      // Update state and version (preserving URL from existing record)
-      compRecord.componentVersionLen = componentVersionLen;
-      memcpy(compRecord.componentVersion, componentVersion, componentVersionLen);
-      compRecord.state = state;
-      // Note: componentUrl and componentUrlLen preserved from existing record
-
-      // Calculate and set CRC32 checksum for power-cycle protection
-      setComponentRecordCRC(&compRecord);
-
-      // Write entire component record with single operation
-      writeStatus = salFotaStorageWrite(FOTA_STORAGE_COMPONENT_ID(i),
-                                        (uint8_t*)&compRecord,
-                                        sizeof(TFotaComponentRecord));
+      // Append the state change to the journal; the component record and its URL are not rewritten
+      TFotaJournalEntry compEntry = {0};
+      compEntry.type = FOTA_JOURNAL_COMPONENT;
+      compEntry.index = (uint8_t)i;
+      compEntry.state = (uint8_t)state;
+      compEntry.componentVersionLen = (uint8_t)((componentVersionLen < 16) ? componentVersionLen : 16);
+      memcpy(compEntry.componentVersion, componentVersion, compEntry.componentVersionLen);
+
+      writeStatus = journalAppend(&compEntry);
       if (true != writeStatus)
       {
-        M_KTALOG__ERR("ERROR: Failed to write component record to fota storage\n");
+        M_KTALOG__ERR("ERROR: Failed to append component state to fota journal\n");
         retStatus = E_K_FOTA_ERROR;
         goto end;
       }
 
-      // Update state in global status
-      gFotaComponentStatus.state[i] = state;
+      // Update state and version in global status, as journaled
+      gpFotaState->componentStatus.state[i] = state;
+      memcpy(gpFotaState->componentStatus.components[i].componentVersion,
+             compEntry.componentVersion, compEntry.componentVersionLen);
+      gpFotaState->componentStatus.components[i].componentVersionLen = compEntry.componentVersionLen;
 
       // Check if ALL components have reached final state (SUCCESS or ERROR)
-      // CRITICAL: Read from EEPROM to ensure we have accurate state (not stale RAM)
       bool allComponentsDone = true;
       uint8_t numComponentsComplete = 0;
       
       for (size_t j = 0; j < COMPONENTS_MAX; j++)
       {
-        // Read component state from EEPROM (source of truth)
-        TFotaComponentRecord checkRecord = {0};
-        size_t checkRecordLen = sizeof(TFotaComponentRecord);
-        bool readSuccess = salFotaStorageRead(FOTA_STORAGE_COMPONENT_ID(j), (uint8_t*)&checkRecord, &checkRecordLen);
-        
-        if (readSuccess && validateComponentRecordCRC(&checkRecord) && checkRecord.componentNameLen > 0)
+        if ((E_FOTA_STATE_IDLE != gpFotaState->componentStatus.state[j]) &&
+            (0 < gpFotaState->componentStatus.components[j].componentNameLen))
         {
           numComponentsComplete++;
           
-          // Sync RAM with EEPROM state
-          gFotaComponentStatus.state[j] = checkRecord.state;
-          
-          if (checkRecord.state == E_FOTA_STATE_IN_PROGRESS)
+          if (gpFotaState->componentStatus.state[j] == E_FOTA_STATE_IN_PROGRESS)
           {
             allComponentsDone = false;
-            // Don't break - continue to sync all component states
           }
         }
       }
       
-      // If all components are done, re-validate commit flag with COMPLETE state
-      if (allComponentsDone && numComponentsComplete > 0)
+      // If all components are done, journal the COMPLETE campaign state
+      // Not yet journaled COMPLETE states are retried by the next component update
+      if (allComponentsDone && numComponentsComplete > 0 &&
+          (FOTA_CAMPAIGN_COMPLETE != gpFotaState->journal.campaignState))
       {
-        TFotaCommitRecord finalCommitRecord = {0};
-        finalCommitRecord.commitFlag = FOTA_COMMIT_VALID;  // 0xAA = valid
-        finalCommitRecord.numComponents = numComponentsComplete;
-        finalCommitRecord.campaignState = FOTA_CAMPAIGN_COMPLETE;  // All components finished
-        setCommitRecord(&finalCommitRecord);
+        TFotaJournalEntry campaignEntry = {0};
+        campaignEntry.type = FOTA_JOURNAL_CAMPAIGN;
+        campaignEntry.state = FOTA_CAMPAIGN_COMPLETE;  // All components finished
         
-        // Try to write final commit with retry on failure
+        // Try to write final campaign state with retry on failure
         uint8_t retryCount = 0;
         const uint8_t maxRetries = 3;
         
         do {
-          writeStatus = salFotaStorageWrite(FOTA_STORAGE_COMMIT_ID, 
-                                            (const uint8_t*)&finalCommitRecord, 
-                                            sizeof(TFotaCommitRecord));
+          writeStatus = journalAppend(&campaignEntry);
           if (writeStatus)
           {
-            M_KTALOG__INFO("SUCCESS: All components complete - commit flag validated (COMPLETE state)\n");
+            M_KTALOG__INFO("SUCCESS: All %u components complete - campaign journaled COMPLETE\n",
+                           (unsigned int)numComponentsComplete);
             break;
           }
           else
@@ -1155,14 +1137,13 @@ TKFotaStatus fotaUpdateComponent
             retryCount++;
             if (retryCount < maxRetries)
             {
-              M_KTALOG__WARN("WARN: Final commit write failed (attempt %u/%u), retrying...\n", 
+              M_KTALOG__WARN("WARN: Final journal write failed (attempt %u/%u), retrying...\n", 
                             (unsigned int)retryCount, (unsigned int)maxRetries);
             }
             else
             {
-              M_KTALOG__ERR("CRITICAL: Final commit write failed after %u attempts - components done but flag not set\n",
+              M_KTALOG__ERR("CRITICAL: Final journal write failed after %u attempts - components done but campaign not COMPLETE\n",
                            (unsigned int)maxRetries);
-              M_KTALOG__ERR("CRITICAL: Campaign will need manual completion or will retry on next component query\n");
             }
           }
         } while (!writeStatus && retryCount < maxRetries);
@@ -1171,18 +1152,14 @@ TKFotaStatus fotaUpdateComponent
       // Update installed components if success
       if (E_FOTA_STATE_SUCCESS == state)
       {
-        // Update version in global status
-        memcpy(gFotaComponentStatus.components[i].componentVersion, componentVersion, componentVersionLen);
-        gFotaComponentStatus.components[i].componentVersionLen = componentVersionLen;
-
         // Update installed components array
         for (size_t j = 0; j < COMPONENTS_MAX; j++)
         {
-          if ((componentNameLen == installedComponents[j].componentNameLen) &&
-          (0 == memcmp(componentName, installedComponents[j].componentName, componentNameLen)))
+          if ((componentNameLen == gpFotaState->installedComponents[j].componentNameLen) &&
+          (0 == memcmp(componentName, gpFotaState->installedComponents[j].componentName, componentNameLen)))
           {
-            memcpy(installedComponents[j].componentVersion, componentVersion, componentVersionLen);
-            installedComponents[j].componentVersionLen = componentVersionLen;
+            memcpy(gpFotaState->installedComponents[j].componentVersion, componentVersion, componentVersionLen);
+            gpFotaState->installedComponents[j].componentVersionLen = componentVersionLen;
             break;
           }
         }
@@ -1215,37 +1192,6 @@ end:
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
 /* -------------------------------------------------------------------------- */
-/**
- * @implements calculateCRC32
- *
- */
-static uint32_t calculateCRC32
-(
-  const uint8_t *data,
-  size_t         length
-)
-{
-  uint32_t crc = 0xFFFFFFFFUL;
-
-  for (size_t i = 0; i < length; i++)
-  {
-    crc ^= data[i];
-    for (uint8_t bit = 0; bit < 8; bit++)
-    {
-      if (crc & 1)
-      {
-        crc = (crc >> 1) ^ 0xEDB88320UL;
-      }
-      else
-      {
-        crc = crc >> 1;
-      }
-    }
-  }
-
-  return ~crc;
-}
-
 /**
  * @implements validateComponentRecordCRC
  *
@@ -1270,7 +1216,7 @@ static bool validateComponentRecordCRC
 
   // Calculate CRC over entire record except the CRC field itself
   size_t crcDataLen = sizeof(TFotaComponentRecord) - sizeof(uint32_t);
-  uint32_t calculatedCRC = calculateCRC32((const uint8_t*)record, crcDataLen);
+  uint32_t calculatedCRC = ktaCrc32Compute((const uint8_t*)record, crcDataLen);
 
   if (calculatedCRC != record->crc32)
   {
@@ -1301,7 +1247,7 @@ static void setComponentRecordCRC
 
   // Calculate CRC over entire record except the CRC field itself
   size_t crcDataLen = sizeof(TFotaComponentRecord) - sizeof(uint32_t);
-  record->crc32 = calculateCRC32((const uint8_t*)record, crcDataLen);
+  record->crc32 = ktaCrc32Compute((const uint8_t*)record, crcDataLen);
 }
 
 /**
@@ -1328,7 +1274,7 @@ static bool validateNameRecordCRC
 
   // Calculate CRC over entire record except the CRC field itself
   size_t crcDataLen = sizeof(TFotaNameRecord) - sizeof(uint32_t);
-  uint32_t calculatedCRC = calculateCRC32((const uint8_t*)record, crcDataLen);
+  uint32_t calculatedCRC = ktaCrc32Compute((const uint8_t*)record, crcDataLen);
 
   if (calculatedCRC != record->crc32)
   {
@@ -1359,7 +1305,7 @@ static void setNameRecordCRC
 
   // Calculate CRC over entire record except the CRC field itself
   size_t crcDataLen = sizeof(TFotaNameRecord) - sizeof(uint32_t);
-  record->crc32 = calculateCRC32((const uint8_t*)record, crcDataLen);
+  record->crc32 = ktaCrc32Compute((const uint8_t*)record, crcDataLen);
 }
 
 /**
@@ -1381,7 +1327,7 @@ static void setMetadataRecordCRC
 
   // Calculate CRC over entire record except the CRC field itself
   size_t crcDataLen = sizeof(TFotaMetadataRecord) - sizeof(uint32_t);
-  record->crc32 = calculateCRC32((const uint8_t*)record, crcDataLen);
+  record->crc32 = ktaCrc32Compute((const uint8_t*)record, crcDataLen);
 }
 
 /**
@@ -1409,7 +1355,7 @@ static bool validateCommitRecord
 
   // Calculate expected CRC over record (excluding crc32 field)
   size_t crcDataLen = sizeof(TFotaCommitRecord) - sizeof(uint32_t);
-  uint32_t expectedCrc = calculateCRC32((const uint8_t*)record, crcDataLen);
+  uint32_t expectedCrc = ktaCrc32Compute((const uint8_t*)record, crcDataLen);
 
   if (record->crc32 != expectedCrc)
   {
@@ -1422,23 +1368,554 @@ static bool validateCommitRecord
 }
 
 /**
- * @implements setCommitRecord
+ * @implements validateJournalEntry
  *
  */
-static void setCommitRecord
+static bool validateJournalEntry
 (
-  TFotaCommitRecord *record
+  const TFotaJournalEntry *entry
 )
 {
-  if (record == NULL)
+  if (entry == NULL)
+  {
+    return false;
+  }
+
+  // Sequence 0 is never written, the campaign starts at or before the entry
+  if ((0u == entry->sequence) || (0u == entry->campaign) || (entry->campaign > entry->sequence))
+  {
+    return false;
+  }
+
+  // Calculate CRC over entire entry except the CRC field itself
+  size_t crcDataLen = sizeof(TFotaJournalEntry) - sizeof(uint32_t);
+
+  return (ktaCrc32Compute((const uint8_t*)entry, crcDataLen) == entry->crc32);
+}
+
+/**
+ * @implements setJournalEntryCRC
+ *
+ */
+static void setJournalEntryCRC
+(
+  TFotaJournalEntry *entry
+)
+{
+  if (entry == NULL)
   {
     return;
   }
 
-  record->magic = FOTA_COMMIT_MAGIC;
-  // Calculate CRC over entire record except the crc32 field itself
-  size_t crcDataLen = sizeof(TFotaCommitRecord) - sizeof(uint32_t);
-  record->crc32 = calculateCRC32((const uint8_t*)record, crcDataLen);
+  // Calculate CRC over entire entry except the CRC field itself
+  size_t crcDataLen = sizeof(TFotaJournalEntry) - sizeof(uint32_t);
+  entry->crc32 = ktaCrc32Compute((const uint8_t*)entry, crcDataLen);
+}
+
+/**
+ * @implements addComponentToBaseCrc
+ *
+ */
+static void addComponentToBaseCrc
+(
+  TKCrc32                    *crc,
+  size_t                      index,
+  const TFotaComponentRecord *record
+)
+{
+  size_t nameLen = record->componentNameLen;
+  size_t urlLen = record->componentUrlLen;
+  uint8_t header[4] = {0};
+
+  if (nameLen > sizeof(record->componentName))
+  {
+    nameLen = sizeof(record->componentName);
+  }
+  if (urlLen > sizeof(record->componentUrl))
+  {
+    urlLen = sizeof(record->componentUrl);
+  }
+
+  // State and version are left out: they change through the journal
+  header[0] = (uint8_t)index;
+  header[1] = (uint8_t)nameLen;
+  header[2] = (uint8_t)(urlLen & 0xFFu);
+  header[3] = (uint8_t)(urlLen >> 8);
+  ktaCrc32Update(crc, header, sizeof(header));
+  ktaCrc32Update(crc, record->componentName, nameLen);
+  ktaCrc32Update(crc, record->componentUrl, urlLen);
+}
+
+/**
+ * @implements loadComponentRecord
+ *
+ */
+static bool loadComponentRecord
+(
+  size_t                index,
+  TFotaComponentRecord *record
+)
+{
+  // Read combined component record (name, version, state together)
+  size_t compRecordLen = sizeof(TFotaComponentRecord);
+
+  memset(record, 0, sizeof(TFotaComponentRecord));
+  bool readComp = salFotaStorageRead(FOTA_STORAGE_COMPONENT_ID(index), (uint8_t*)record, &compRecordLen);
+
+  if (true != readComp)
+  {
+    M_KTALOG__ERR("ERROR: Failed to read component record from storage.\r\n");
+    return false;
+  }
+
+  // Validate CRC32 checksum for power-cycle corruption detection
+  if (!validateComponentRecordCRC(record))
+  {
+    M_KTALOG__ERR("[ERR] Component record %u failed CRC validation during init - treating as IDLE\r\n", (unsigned int)index);
+    return false;
+  }
+
+  // Validate lengths to prevent buffer overflow
+  if (record->componentNameLen > 16)
+  {
+    M_KTALOG__ERR("ERROR: Invalid componentNameLen (%u) for component %u\r\n", 
+                   (unsigned int)record->componentNameLen, (unsigned int)index);
+    record->componentNameLen = 0;
+  }
+
+  if (record->componentVersionLen > 16)
+  {
+    M_KTALOG__ERR("ERROR: Invalid componentVersionLen (%u) for component %u\r\n", 
+                   (unsigned int)record->componentVersionLen, (unsigned int)index);
+    record->componentVersionLen = 0;
+  }
+
+  gpFotaState->componentStatus.state[index] = record->state;
+
+  if (record->componentNameLen > 0)
+  {
+    memcpy(gpFotaState->componentStatus.components[index].componentName,
+       record->componentName,
+       record->componentNameLen);
+
+    gpFotaState->componentStatus.components[index].componentNameLen = record->componentNameLen;
+    if (record->componentVersionLen > 0)
+    {
+      memcpy(gpFotaState->componentStatus.components[index].componentVersion,
+           record->componentVersion,
+           record->componentVersionLen);
+    }
+  }
+  gpFotaState->componentStatus.components[index].componentVersionLen = record->componentVersionLen;
+
+  return true;
+}
+
+/**
+ * @implements loadLegacyCampaign
+ *
+ */
+static void loadLegacyCampaign
+(
+  void
+)
+{
+  // CRITICAL: Check commit flag FIRST before processing any FOTA data
+  // If commit flag is not valid (0xAA), entire FOTA campaign is incomplete/corrupted
+  TFotaCommitRecord commitRecord = {0};
+  size_t commitRecordLen = sizeof(TFotaCommitRecord);
+  bool readCommit = salFotaStorageRead(FOTA_STORAGE_COMMIT_ID, (uint8_t*)&commitRecord, &commitRecordLen);
+  
+  bool campaignValid = false;
+  if (readCommit && validateCommitRecord(&commitRecord))
+  {
+    if (commitRecord.commitFlag == FOTA_COMMIT_VALID)
+    {
+      M_KTALOG__INFO("Commit flag VALID (0xAA) - resuming FOTA campaign with %u components (state=%u)\r\n",
+                     (unsigned int)commitRecord.numComponents,
+                     (unsigned int)commitRecord.campaignState);
+      campaignValid = true;
+    }
+    else if (commitRecord.commitFlag == FOTA_COMMIT_INVALID && 
+             commitRecord.campaignState == FOTA_CAMPAIGN_IN_PROGRESS)
+    {
+      // CRITICAL: Allow resume of campaigns that were updating when power lost
+      // This preserves component progress (SUCCESS/ERROR states) after power cycles
+      M_KTALOG__INFO("Resuming FOTA campaign in IN_PROGRESS state after power cycle (numComponents=%u)\r\n",
+                     (unsigned int)commitRecord.numComponents);
+      campaignValid = true;
+    }
+    else
+    {
+      M_KTALOG__WARN("Commit flag INVALID (0x%02X) with state=%u - FOTA campaign incomplete, resetting to IDLE\r\n",
+                     (unsigned int)commitRecord.commitFlag,
+                     (unsigned int)commitRecord.campaignState);
+    }
+  }
+  else
+  {
+    M_KTALOG__WARN("Commit record not found or invalid - no active FOTA campaign\r\n");
+  }
+
+  if (!campaignValid)
+  {
+    return;
+  }
+
+  // The first journal append turns this campaign into a journaled one
+  gpFotaState->journal.campaignState = commitRecord.campaignState;
+  for (size_t i = 0; i < COMPONENTS_MAX; i++)
+  {
+    TFotaComponentRecord compRecord;
+
+    if (!loadComponentRecord(i, &compRecord))
+    {
+      gpFotaState->componentStatus.state[i] = E_FOTA_STATE_IDLE;
+      gpFotaState->componentStatus.components[i].componentNameLen = 0;
+      gpFotaState->componentStatus.components[i].componentVersionLen = 0;
+    }
+  }
+}
+
+/**
+ * @implements journalLoad
+ *
+ */
+static bool journalLoad
+(
+  void
+)
+{
+  TFotaJournal *journal = &gpFotaState->journal;
+  TFotaJournalEntry entry;
+  TFotaJournalEntry campaignEntry;                   // Latest BASE or CAMPAIGN entry of the newest campaign
+  TFotaJournalEntry aComponentEntry[COMPONENTS_MAX]; // Latest COMPONENT entry of each component
+  uint32_t campaign = 0;
+  size_t entryLen = 0;
+
+  memset(&campaignEntry, 0, sizeof(TFotaJournalEntry));
+  memset(aComponentEntry, 0, sizeof(aComponentEntry));
+
+  // Single scan: each slot is read once, entries of older campaigns are dead
+  for (size_t slot = 0; slot < FOTA_JOURNAL_ENTRY_COUNT; slot++)
+  {
+    entryLen = sizeof(TFotaJournalEntry);
+    memset(&entry, 0, sizeof(TFotaJournalEntry));
+    if (!salFotaStorageRead(FOTA_STORAGE_JOURNAL_ID(slot), (uint8_t*)&entry, &entryLen) ||
+        !validateJournalEntry(&entry) ||
+        ((entry.sequence % FOTA_JOURNAL_ENTRY_COUNT) != slot))
+    {
+      continue;  // Erased, torn or misplaced
+    }
+
+    if (entry.sequence > journal->headSequence)
+    {
+      journal->headSequence = entry.sequence;
+    }
+
+    if (entry.campaign > campaign)
+    {
+      campaign = entry.campaign;
+      memset(&campaignEntry, 0, sizeof(TFotaJournalEntry));
+      memset(aComponentEntry, 0, sizeof(aComponentEntry));
+    }
+    if (entry.campaign != campaign)
+    {
+      continue;
+    }
+
+    if (FOTA_JOURNAL_COMPONENT == entry.type)
+    {
+      if ((entry.index < COMPONENTS_MAX) && (entry.sequence > aComponentEntry[entry.index].sequence))
+      {
+        aComponentEntry[entry.index] = entry;
+      }
+    }
+    else if (entry.sequence > campaignEntry.sequence)
+    {
+      campaignEntry = entry;
+    }
+    else
+    {
+      // Older campaign state
+    }
+  }
+
+  if (0u == journal->headSequence)
+  {
+    M_KTALOG__INFO("FOTA journal empty\r\n");
+    return false;
+  }
+
+  // The records must be the ones the BASE entry was written for
+  TFotaNameRecord nameRecord = {0};
+  size_t nameRecordLen = sizeof(TFotaNameRecord);
+  TKCrc32 baseCrc;
+  bool campaignValid = (0u != campaignEntry.sequence) &&
+                       salFotaStorageRead(FOTA_STORAGE_NAME_ID, (uint8_t*)&nameRecord, &nameRecordLen) &&
+                       validateNameRecordCRC(&nameRecord) &&
+                       (nameRecord.nameLen <= sizeof(nameRecord.name));
+
+  ktaCrc32Init(&baseCrc);
+  if (campaignValid)
+  {
+    ktaCrc32Update(&baseCrc, nameRecord.name, nameRecord.nameLen);
+  }
+  for (size_t i = 0; (i < COMPONENTS_MAX) && campaignValid; i++)
+  {
+    TFotaComponentRecord compRecord;
+
+    if (0u == (campaignEntry.index & (1u << i)))
+    {
+      continue;
+    }
+    campaignValid = loadComponentRecord(i, &compRecord);
+    if (campaignValid)
+    {
+      addComponentToBaseCrc(&baseCrc, i, &compRecord);
+    }
+  }
+  if (campaignValid && (ktaCrc32Final(&baseCrc) != campaignEntry.baseCrc))
+  {
+    campaignValid = false;
+  }
+
+  if (!campaignValid)
+  {
+    M_KTALOG__WARN("FOTA journal campaign %u does not match the records - no active FOTA campaign\r\n",
+                   (unsigned int)campaign);
+    for (size_t i = 0; i < COMPONENTS_MAX; i++)
+    {
+      gpFotaState->componentStatus.state[i] = E_FOTA_STATE_IDLE;
+      gpFotaState->componentStatus.components[i].componentNameLen = 0;
+      gpFotaState->componentStatus.components[i].componentVersionLen = 0;
+    }
+    return true;
+  }
+
+  // Apply the latest state change of each component over its record
+  for (size_t i = 0; i < COMPONENTS_MAX; i++)
+  {
+    if ((0u == (campaignEntry.index & (1u << i))) || (0u == aComponentEntry[i].sequence))
+    {
+      continue;
+    }
+    journal->aComponentSequence[i] = aComponentEntry[i].sequence;
+    gpFotaState->componentStatus.state[i] = aComponentEntry[i].state;
+    if (aComponentEntry[i].componentVersionLen <= sizeof(aComponentEntry[i].componentVersion))
+    {
+      memcpy(gpFotaState->componentStatus.components[i].componentVersion,
+             aComponentEntry[i].componentVersion,
+             aComponentEntry[i].componentVersionLen);
+      gpFotaState->componentStatus.components[i].componentVersionLen = aComponentEntry[i].componentVersionLen;
+    }
+  }
+
+  journal->campaign = campaign;
+  journal->campaignSequence = campaignEntry.sequence;
+  journal->baseCrc = campaignEntry.baseCrc;
+  journal->componentMask = campaignEntry.index;
+  journal->campaignState = campaignEntry.state;
+  M_KTALOG__INFO("FOTA journal head %u, resuming campaign %u (state=%u)\r\n",
+                 (unsigned int)journal->headSequence, (unsigned int)campaign,
+                 (unsigned int)journal->campaignState);
+  return true;
+}
+
+/**
+ * @implements journalAppend
+ *
+ */
+static bool journalAppend
+(
+  TFotaJournalEntry *entry
+)
+{
+  TFotaJournal *journal = &gpFotaState->journal;
+
+  if (FOTA_JOURNAL_BASE == entry->type)
+  {
+    entry->campaign = 0u;
+  }
+  else
+  {
+    if (!journalCompact())
+    {
+      M_KTALOG__ERR("ERROR: FOTA journal compaction failed\r\n");
+      return false;
+    }
+    entry->campaign = journal->campaign;
+    entry->baseCrc = journal->baseCrc;
+  }
+  if (FOTA_JOURNAL_CAMPAIGN == entry->type)
+  {
+    entry->index = journal->componentMask;
+  }
+
+  return journalWrite(entry);
+}
+
+/**
+ * @implements journalWrite
+ *
+ */
+static bool journalWrite
+(
+  TFotaJournalEntry *entry
+)
+{
+  TFotaJournal *journal = &gpFotaState->journal;
+  uint32_t sequence = journal->headSequence + 1u;
+  bool writeStatus = false;
+
+  entry->sequence = sequence;
+  if (0u == entry->campaign)
+  {
+    entry->campaign = sequence;
+  }
+  setJournalEntryCRC(entry);
+
+  writeStatus = salFotaStorageWrite(FOTA_STORAGE_JOURNAL_ID(sequence % FOTA_JOURNAL_ENTRY_COUNT),
+                                    (const uint8_t*)entry, sizeof(TFotaJournalEntry));
+  if (!writeStatus)
+  {
+    // A torn entry fails its CRC, the next append reuses the sequence
+    return false;
+  }
+
+  journal->headSequence = sequence;
+  if (FOTA_JOURNAL_COMPONENT == entry->type)
+  {
+    journal->aComponentSequence[entry->index] = sequence;
+  }
+  else
+  {
+    if (entry->campaign != journal->campaign)
+    {
+      // A new campaign: its components restart from their records
+      journal->campaign = entry->campaign;
+      journal->baseCrc = entry->baseCrc;
+      journal->componentMask = entry->index;
+      memset(journal->aComponentSequence, 0, sizeof(journal->aComponentSequence));
+    }
+    journal->campaignSequence = sequence;
+    journal->campaignState = entry->state;
+  }
+
+  return true;
+}
+
+/**
+ * @implements journalCompact
+ *
+ */
+static bool journalCompact
+(
+  void
+)
+{
+  TFotaJournal *journal = &gpFotaState->journal;
+
+  // A campaign recorded before the journal starts it with a BASE entry over its records
+  if (0u == journal->campaign)
+  {
+    TFotaJournalEntry baseEntry = {0};
+    TFotaNameRecord nameRecord = {0};
+    size_t nameRecordLen = sizeof(TFotaNameRecord);
+    uint8_t componentMask = 0;
+    TKCrc32 baseCrc;
+
+    if (!salFotaStorageRead(FOTA_STORAGE_NAME_ID, (uint8_t*)&nameRecord, &nameRecordLen) ||
+        !validateNameRecordCRC(&nameRecord) ||
+        (nameRecord.nameLen > sizeof(nameRecord.name)))
+    {
+      return false;
+    }
+    ktaCrc32Init(&baseCrc);
+    ktaCrc32Update(&baseCrc, nameRecord.name, nameRecord.nameLen);
+
+    for (size_t i = 0; i < COMPONENTS_MAX; i++)
+    {
+      TFotaComponentRecord compRecord = {0};
+      size_t compRecordLen = sizeof(TFotaComponentRecord);
+
+      // The RAM state of these components was read from their records
+      if ((E_FOTA_STATE_IDLE == gpFotaState->componentStatus.state[i]) ||
+          (0 == gpFotaState->componentStatus.components[i].componentNameLen))
+      {
+        continue;
+      }
+      if (!salFotaStorageRead(FOTA_STORAGE_COMPONENT_ID(i), (uint8_t*)&compRecord, &compRecordLen) ||
+          !validateComponentRecordCRC(&compRecord))
+      {
+        return false;
+      }
+      addComponentToBaseCrc(&baseCrc, i, &compRecord);
+      componentMask |= (uint8_t)(1u << i);
+    }
+
+    baseEntry.type = FOTA_JOURNAL_BASE;
+    baseEntry.index = componentMask;
+    baseEntry.state = journal->campaignState;
+    baseEntry.baseCrc = ktaCrc32Final(&baseCrc);
+    M_KTALOG__INFO("Moving the FOTA campaign into the journal\r\n");
+    if (!journalWrite(&baseEntry))
+    {
+      return false;
+    }
+  }
+
+  // Copy the oldest live entry to the head while the next append could overwrite it
+  // The copy goes to a dead slot and the original stays valid until it is superseded
+  for (size_t move = 0; move <= (COMPONENTS_MAX + 1u); move++)
+  {
+    TFotaJournalEntry liveEntry = {0};
+    uint32_t oldestSequence = journal->campaignSequence;
+    size_t oldestIndex = COMPONENTS_MAX;  // COMPONENTS_MAX stands for the BASE or CAMPAIGN entry
+
+    for (size_t i = 0; i < COMPONENTS_MAX; i++)
+    {
+      if ((0u != (journal->componentMask & (1u << i))) &&
+          (0u != journal->aComponentSequence[i]) &&
+          (journal->aComponentSequence[i] < oldestSequence))
+      {
+        oldestSequence = journal->aComponentSequence[i];
+        oldestIndex = i;
+      }
+    }
+
+    if ((journal->headSequence + 1u - oldestSequence) < (FOTA_JOURNAL_ENTRY_COUNT - 1u))
+    {
+      return true;
+    }
+
+    liveEntry.campaign = journal->campaign;
+    liveEntry.baseCrc = journal->baseCrc;
+    if (COMPONENTS_MAX == oldestIndex)
+    {
+      liveEntry.type = FOTA_JOURNAL_BASE;
+      liveEntry.index = journal->componentMask;
+      liveEntry.state = journal->campaignState;
+    }
+    else
+    {
+      const TComponent *component = &gpFotaState->componentStatus.components[oldestIndex];
+
+      liveEntry.type = FOTA_JOURNAL_COMPONENT;
+      liveEntry.index = (uint8_t)oldestIndex;
+      liveEntry.state = (uint8_t)gpFotaState->componentStatus.state[oldestIndex];
+      liveEntry.componentVersionLen = (uint8_t)component->componentVersionLen;
+      memcpy(liveEntry.componentVersion, component->componentVersion, component->componentVersionLen);
+    }
+    M_KTALOG__INFO("Compacting FOTA journal: entry %u moved to %u\r\n",
+                   (unsigned int)oldestSequence, (unsigned int)(journal->headSequence + 1u));
+    if (!journalWrite(&liveEntry))
+    {
+      return false;
+    }
+  }
+
+  return false;
 }
 
 /**
@@ -1497,10 +1974,10 @@ static TKFotaStatus getVersion
     // Get version of currently installed target component
     for (size_t i = 0; i < COMPONENTS_MAX; i++)
     {
-      if (0 == memcmp(componentName, installedComponents[i].componentName, installedComponents[i].componentNameLen))
+      if (0 == memcmp(componentName, gpFotaState->installedComponents[i].componentName, gpFotaState->installedComponents[i].componentNameLen))
       {
-        memcpy(currentVersion, installedComponents[i].componentVersion,  installedComponents[i].componentVersionLen);
-        *currentVersionLength = installedComponents[i].componentVersionLen;
+        memcpy(currentVersion, gpFotaState->installedComponents[i].componentVersion,  gpFotaState->installedComponents[i].componentVersionLen);
+        *currentVersionLength = gpFotaState->installedComponents[i].componentVersionLen;
         status = E_K_FOTA_SUCCESS;
         break;
       }
@@ -1570,8 +2047,8 @@ static void fotaFillComponents
   // Iterate through the provided components
   for (size_t i = 0; i < COMPONENTS_MAX; i++)
   {
-    if ((compState == gFotaComponentStatus.state[i]) &&
-        (0 < gFotaComponentStatus.components[i].componentNameLen))
+    if ((compState == gpFotaState->componentStatus.state[i]) &&
+        (0 < gpFotaState->componentStatus.components[i].componentNameLen))
     {
       // Bounds check to prevent buffer overflow
       if (compIndex >= COMPONENTS_MAX)
@@ -1581,7 +2058,7 @@ static void fotaFillComponents
       }
 
       // Bounds check for component name length
-      size_t copyNameLen = gFotaComponentStatus.components[i].componentNameLen;
+      size_t copyNameLen = gpFotaState->componentStatus.components[i].componentNameLen;
       if (copyNameLen > CURRENT_MAX_LENGTH)
       {
         M_KTALOG__ERR("ERROR: Component name length %zu exceeds max %u\n", 
@@ -1590,14 +2067,14 @@ static void fotaFillComponents
       }
 
       memcpy(components[compIndex].componentName,
-             gFotaComponentStatus.components[i].componentName,
+             gpFotaState->componentStatus.components[i].componentName,
              copyNameLen);
       components[compIndex].componentNameLen = copyNameLen;
 
-      if (0 < gFotaComponentStatus.components[i].componentVersionLen)
+      if (0 < gpFotaState->componentStatus.components[i].componentVersionLen)
       {
         // Bounds check for component version length
-        size_t copyVersionLen = gFotaComponentStatus.components[i].componentVersionLen;
+        size_t copyVersionLen = gpFotaState->componentStatus.components[i].componentVersionLen;
         if (copyVersionLen > CURRENT_MAX_LENGTH)
         {
           M_KTALOG__ERR("ERROR: Component version length %zu exceeds max %u\n", 
@@ -1606,7 +2083,7 @@ static void fotaFillComponents
         }
 
         memcpy(components[compIndex].componentVersion,
-               gFotaComponentStatus.components[i].componentVersion,
+               gpFotaState->componentStatus.components[i].componentVersion,
                copyVersionLen);
         components[compIndex].componentVersionLen = copyVersionLen;
       }
@@ -81,16 +81,78 @@ typedef struct {
   /**< Array of state values for each component. */
 } TFotaComponentStatus;
 
+/** @brief Position of the FOTA journal, rebuilt by initializefotaState().
+ */
+typedef struct {
+  uint32_t headSequence;
+  /**< Sequence of the last journal entry, 0 if the journal is empty. */
+
+  uint32_t campaign;
+  /**< Sequence of the BASE entry that started the campaign, 0 if none is journaled. */
+
+  uint32_t campaignSequence;
+  /**< Sequence of the latest BASE or CAMPAIGN entry of the campaign. */
+
+  uint32_t aComponentSequence[COMPONENTS_MAX];
+  /**< Sequence of the latest COMPONENT entry of each component, 0 if none. */
+
+  uint32_t baseCrc;
+  /**< CRC32 of the campaign name, component names and URLs. */
+
+  uint8_t componentMask;
+  /**< Components of the campaign, one bit per index. */
+
+  uint8_t campaignState;
+  /**< FOTA_CAMPAIGN_xxx state of the campaign. */
+} TFotaJournal;
+
+/** @brief FOTA processing state of one keySTREAM Trusted Agent instance.
+ */
+typedef struct {
+  uint8_t metadata[MAX_FOTA_META_DATA];
+  /**< FOTA metadata. */
+
+  size_t metadataLen;
+  /**< Length of the FOTA metadata. */
+
+  TFotaComponentStatus componentStatus;
+  /**< Status of each target component. */
+
+  TComponent installedComponents[COMPONENTS_MAX];
+  /**< Components installed on the platform. */
+
+  TFotaJournal journal;
+  /**< Position of the FOTA journal. */
+
+  bool isInitialized;
+  /**< True once initializefotaState() has run. */
+} TFotaProcessState;
+
 
 
 /* -------------------------------------------------------------------------- */
 /* FUNCTIONS                                                                  */
 /* -------------------------------------------------------------------------- */
 
+/**
+ * @brief Select the FOTA state used by the next calls of this module from the
+ *        calling thread.
+ *
+ * @param [in] xpState FOTA state of the served instance, NULL for the built-in one.
+ *
+ * @return None
+ */
+void fotaProcessBindState
+(
+  TFotaProcessState *xpState
+);
+
 /**
  * @brief Set the global FOTA state.
  *
- * This function sets the global FOTA state to the provided state.
+ * This function loads the installed components from the platform, then
+ * rebuilds the campaign state from the component records and a single scan
+ * of the FOTA journal.
  *
  * @return None
  */
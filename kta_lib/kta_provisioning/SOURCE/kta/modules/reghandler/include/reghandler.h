@@ -49,6 +49,7 @@ extern "C" {
 /* --------------------------------------------------------------------------------------------- */
 #include "k_defs.h"
 #include "icpp_parser.h"
+#include "general.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -68,6 +69,8 @@ extern "C" {
  * @brief
  *   Build registration request.
  *
+ * @param[in,out] xpArena
+ *   Workspace arena the message buffers are carved from.
  * @param[in]  xpRecvdProtoMessage
  *   Should not be NULL.
  *   Message received from application.
@@ -87,7 +90,8 @@ extern "C" {
  */
 TKStatus ktaregBuildRegistrationRequest
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKtaArena* xpArena,
+  TKIcppMessageView* xpRecvdProtoMessage,
   uint8_t* xpMessageToSend,
   size_t*  xpMessageToSendSize
 );
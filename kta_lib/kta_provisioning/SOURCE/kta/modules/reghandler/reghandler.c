@@ -167,12 +167,13 @@ static TKStatus lPrepareNotificationMsg
  **/
 TKStatus ktaregBuildRegistrationRequest
 (
-  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKtaArena* xpArena,
+  TKIcppMessageView* xpRecvdProtoMessage,
   uint8_t* xpMessageToSend,
   size_t*  xpMessageToSendSize
 )
 {
-  TKIcppProtocolMessage protoMessage = {0};
+  TKIcppProtocolMessage* pProtoMessage = NULL;
   TKStatus status = E_K_STATUS_ERROR;
   size_t rotPublicUidLen = C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES;
   TKRegInfoPayload xpRegInfo = {0};
@@ -194,21 +195,28 @@ TKStatus ktaregBuildRegistrationRequest
     goto end;
   }
 
+  pProtoMessage = (TKIcppProtocolMessage*)ktaArenaAlloc(xpArena, sizeof(TKIcppProtocolMessage));
+  if (NULL == pProtoMessage)
+  {
+    M_KTALOG__ERR("Not enough workspace for the registration request");
+    goto end;
+  }
+
   // REQ RQ_M-KTA-REGT-FN-0010(1) : Check crypto version
   // REQ RQ_M-KTA-REGT-FN-0020_01(1) : Registeration Info crypto version
-  protoMessage.cryptoVersion = E_K_ICPP_PARSER_CRYPTO_TYPE_L2_BASED;
+  pProtoMessage->cryptoVersion = E_K_ICPP_PARSER_CRYPTO_TYPE_L2_BASED;
   // REQ RQ_M-KTA-REGT-FN-0020_02(1) : Registeration Info partial encryption mode
-  protoMessage.encMode = E_K_ICPP_PARSER_FULL_ENC_MODE;
+  pProtoMessage->encMode = E_K_ICPP_PARSER_FULL_ENC_MODE;
   // REQ RQ_M-KTA-REGT-FN-0020_03(1) : Registeration Info message type
-  protoMessage.msgType = E_K_ICPP_PARSER_MESSAGE_TYPE_RESPONSE;
+  pProtoMessage->msgType = E_K_ICPP_PARSER_MESSAGE_TYPE_RESPONSE;
   // REQ RQ_M-KTA-REGT-FN-0020_04(1) : Registeration Info transaction id
-  memcpy(protoMessage.transactionId, xpRecvdProtoMessage->transactionId,
+  memcpy(pProtoMessage->transactionId, xpRecvdProtoMessage->transactionId,
          C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES);
   // REQ RQ_M-KTA-REGT-FN-0020_05(1) : Registeration Info rot key set id
-  protoMessage.rotKeySetId = xpRecvdProtoMessage->rotKeySetId;
+  pProtoMessage->rotKeySetId = xpRecvdProtoMessage->rotKeySetId;
 
   // REQ RQ_M-KTA-REGT-FN-0020_06(1) : Registeration Info rot public uid
-  status = salStorageGetValue(C_K_KTA__ROT_PUBLIC_UID_STORAGE_ID, protoMessage.rotPublicUID, &rotPublicUidLen);
+  status = salStorageGetValue(C_K_KTA__ROT_PUBLIC_UID_STORAGE_ID, pProtoMessage->rotPublicUID, &rotPublicUidLen);
   if ((E_K_STATUS_OK != status) || (0u == rotPublicUidLen))
   {
     M_KTALOG__ERR("SAL API failed while reading rotPublicUID, status = [%d]", status);
@@ -223,7 +231,7 @@ TKStatus ktaregBuildRegistrationRequest
   }
 
   // REQ RQ_M-KTA-REGT-FN-0020(1) : Registeration Info ICPP Message
-  status = lPrepareNotificationMsg(&protoMessage, &xpRegInfo);
+  status = lPrepareNotificationMsg(pProtoMessage, &xpRegInfo);
   if (E_K_STATUS_OK != status)
   {
     M_KTALOG__ERR("Preparing registration response message failed, status = [%d]", status);
@@ -231,13 +239,14 @@ TKStatus ktaregBuildRegistrationRequest
   }
 
   status = ktaGenerateResponse((C_GEN__SERIALIZE | C_GEN__PADDING | C_GEN__ENCRYPT | C_GEN__SIGNING),
-                               &protoMessage, xpMessageToSend, xpMessageToSendSize);
+                               pProtoMessage, xpMessageToSend, xpMessageToSendSize);
   if (E_K_STATUS_OK != status)
   {
     M_KTALOG__ERR("ktaGenerateResponse failed, status = [%d]", status);
   }
 
 end:
+  ktaArenaRelease(xpArena, pProtoMessage);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
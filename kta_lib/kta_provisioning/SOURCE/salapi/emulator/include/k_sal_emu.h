@@ -0,0 +1,307 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  Software emulated ATECC608 secure element for host builds.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file k_sal_emu.h
+ ******************************************************************************/
+
+/**
+ * @brief Software emulated ATECC608 secure element for host builds.
+ *
+ * The emulator plugs into cryptoauthlib as a custom HAL (ATCA_HAL_CUSTOM):
+ * command packets sent by calib are decoded and executed in software, so the
+ * SAL (k_sal_crypto.c, k_sal_storage.c, k_sal_object.c) runs unchanged on top
+ * of it. Usage:
+ *
+ *   salEmuInit(&config);
+ *   atcab_init(salEmuGetIfaceCfg());
+ *   ktaInitialize(); ...
+ *
+ * Several devices, e.g. one per thread, each get their own instance:
+ *
+ *   pInstance = salEmuCreate();
+ *   salEmuSelect(pInstance);
+ *   salEmuInit(&config);
+ *   ktaContextInit(&context, newATCADevice(salEmuGetIfaceCfg()));
+ *
+ * Config, OTP, data zone and private keys are persisted to a file so a
+ * device identity survives process restarts. The file is either rewritten
+ * after every command modifying them or memory mapped and updated in place
+ * (isMappedStorage). salEmuSetPowerCut() tears one of these commands to
+ * exercise the recovery paths. Every command is accounted in a
+ * latency model (per opcode execution time plus bus transfer time) and in
+ * statistics counters used for capacity planning (sessions per second,
+ * commands per session, wake cycles).
+ *
+ * The functions below act on the instance selected by the calling thread,
+ * the built-in one by default. The HAL calls of a device select the instance
+ * its interface was created from.
+ *
+ * Slot access policies (SlotConfig/KeyConfig) are not enforced.
+ */
+
+#ifndef K_SAL_EMU_H
+#define K_SAL_EMU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+
+#include "k_defs.h"
+#include "cryptoauthlib.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* -------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                     */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Size of the per opcode tables (opcode is one byte). */
+#define C_SAL_EMU_OPCODE_COUNT                     (256u)
+
+/** @brief Nominal latency scale, execution times as per data sheet. */
+#define C_SAL_EMU_LATENCY_SCALE_NOMINAL            (100u)
+
+/** @brief Default bus time per byte, I2C at 400 kHz (9 bits per byte). */
+#define C_SAL_EMU_BUS_BYTE_TIME_US_DEFAULT         (23u)
+
+/** @brief Number of data zone slots. */
+#define C_SAL_EMU_SLOT_COUNT                       (16u)
+
+/** @brief Number of 32 byte blocks of the largest slot (slot 8). */
+#define C_SAL_EMU_SLOT_BLOCK_MAX                   (13u)
+
+/** @brief Emulator configuration. */
+typedef struct
+{
+  /* File backing the persistent zones, NULL to keep the device in RAM only. */
+  const char*  pStoragePath;
+  /* Percentage applied to every execution time, 0 disables the model. */
+  uint32_t     latencyScale;
+  /* Bus transfer time per byte in microseconds. */
+  uint32_t     busByteTimeUs;
+  /* When true, the modeled time is also spent with atca_delay_us(). */
+  bool         isRealTimeDelay;
+  /* When true, pStoragePath is memory mapped instead of rewritten per write. */
+  bool         isMappedStorage;
+} TKSalEmuConfig;
+
+/** @brief Emulator statistics. */
+typedef struct
+{
+  /* Number of executed commands. */
+  uint32_t  commandCount;
+  /* Number of commands answered with an error status. */
+  uint32_t  errorCount;
+  /* Number of executed commands per opcode. */
+  uint32_t  aOpcodeCount[C_SAL_EMU_OPCODE_COUNT];
+  /* Number of sleep or idle to active transitions. */
+  uint32_t  wakeCount;
+  /* Number of idle requests. */
+  uint32_t  idleCount;
+  /* Number of sleep requests. */
+  uint32_t  sleepCount;
+  /* Number of bus transfers, sends and receives. */
+  uint32_t  busTransferCount;
+  /* Bytes sent to the device. */
+  uint32_t  txBytes;
+  /* Bytes received from the device. */
+  uint32_t  rxBytes;
+  /* Number of commands that modified persistent zones. */
+  uint32_t  nvmWriteCount;
+  /* Writes per data zone slot and block, key generations count on block 0. */
+  uint32_t  aBlockWriteCount[C_SAL_EMU_SLOT_COUNT][C_SAL_EMU_SLOT_BLOCK_MAX];
+  /* Number of injected power cuts. */
+  uint32_t  powerCutCount;
+  /* Modeled device time (execution, bus and wake) in microseconds. */
+  uint64_t  emulatedTimeUs;
+} TKSalEmuStats;
+
+/** @brief Emulator instance: one emulated device, private to the emulator. */
+typedef struct SKSalEmuInstance TKSalEmuInstance;
+
+/* -------------------------------------------------------------------------- */
+/* VARIABLES                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief
+ *   Initialize the emulator, load or create the persistent device image.
+ *
+ * @param[in] xpConfig
+ *   Emulator configuration, NULL for a RAM only device without latency.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_DATA if the storage file exists but is not a valid image.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salEmuInit
+(
+  const TKSalEmuConfig*  xpConfig
+);
+
+/**
+ * @brief
+ *   Allocate an emulator instance, to be selected then initialized.
+ *
+ * @return
+ *   New instance, NULL if out of memory.
+ */
+K_SAL_API TKSalEmuInstance* salEmuCreate
+(
+  void
+);
+
+/**
+ * @brief
+ *   Select the instance the calling thread acts on.
+ *
+ * @param[in] xpInstance
+ *   Instance from salEmuCreate(), NULL for the built-in one.
+ */
+K_SAL_API void salEmuSelect
+(
+  TKSalEmuInstance*  xpInstance
+);
+
+/**
+ * @brief
+ *   Release an instance from salEmuCreate(), once terminated with salEmuTerm()
+ *   and no longer used by a device.
+ *
+ * @param[in] xpInstance
+ *   Instance to release.
+ */
+K_SAL_API void salEmuDestroy
+(
+  TKSalEmuInstance*  xpInstance
+);
+
+/**
+ * @brief
+ *   Interface configuration to pass to atcab_init().
+ *
+ * @return
+ *   Custom interface configuration routed to the emulator.
+ */
+K_SAL_API ATCAIfaceCfg* salEmuGetIfaceCfg
+(
+  void
+);
+
+/**
+ * @brief
+ *   Override the execution time of one command.
+ *
+ * @param[in] xOpcode
+ *   Command opcode (ATCA_xxx).
+ * @param[in] xExecutionTimeMs
+ *   Execution time in milliseconds, before latency scaling.
+ */
+K_SAL_API void salEmuSetLatency
+(
+  uint8_t   xOpcode,
+  uint32_t  xExecutionTimeMs
+);
+
+/**
+ * @brief
+ *   Arm a power cut: the xNvmWriteCount-th next command modifying the
+ *   persistent zones only stores the first half of the bytes it changed, then
+ *   the device stops answering. salEmuTerm() followed by salEmuInit() with the
+ *   same storage file emulates the reboot.
+ *
+ * @param[in] xNvmWriteCount
+ *   Rank of the torn command, 1 for the next one, 0 to disarm.
+ */
+K_SAL_API void salEmuSetPowerCut
+(
+  uint32_t  xNvmWriteCount
+);
+
+/**
+ * @brief
+ *   Get the emulator statistics.
+ *
+ * @param[out] xpStats
+ *   Statistics snapshot. Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ */
+K_SAL_API TKStatus salEmuGetStats
+(
+  TKSalEmuStats*  xpStats
+);
+
+/**
+ * @brief
+ *   Reset the emulator statistics.
+ */
+K_SAL_API void salEmuResetStats
+(
+  void
+);
+
+/**
+ * @brief
+ *   Flush the persistent zones and release the emulator.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR if the storage file cannot be written.
+ */
+K_SAL_API TKStatus salEmuTerm
+(
+  void
+);
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+#endif // K_SAL_EMU_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,191 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  Software crypto primitives for the ATECC608 emulator.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file k_sal_emu_crypto.h
+ ******************************************************************************/
+
+/**
+ * @brief Software crypto primitives for the ATECC608 emulator.
+ */
+
+#ifndef K_SAL_EMU_CRYPTO_H
+#define K_SAL_EMU_CRYPTO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+
+#include "k_defs.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                     */
+/* -------------------------------------------------------------------------- */
+
+/** @brief P-256 scalar (private key, nonce) size in bytes. */
+#define C_SAL_EMU_ECC_SCALAR_SIZE                  (32u)
+
+/** @brief P-256 public key size in bytes (X||Y). */
+#define C_SAL_EMU_ECC_PUBLIC_KEY_SIZE              (64u)
+
+/** @brief P-256 signature size in bytes (R||S). */
+#define C_SAL_EMU_ECC_SIGNATURE_SIZE               (64u)
+
+/** @brief AES-128 key and block size in bytes. */
+#define C_SAL_EMU_AES_BLOCK_SIZE                   (16u)
+
+/* -------------------------------------------------------------------------- */
+/* VARIABLES                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief
+ *   Compute the P-256 public key of a private scalar.
+ *
+ * @param[in] xpPrivateKey
+ *   Big endian private scalar, C_SAL_EMU_ECC_SCALAR_SIZE bytes.
+ * @param[out] xpPublicKey
+ *   Public key X||Y, C_SAL_EMU_ECC_PUBLIC_KEY_SIZE bytes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER if the scalar is not in [1, n-1].
+ */
+TKStatus salEmuEccPublicKey
+(
+  const uint8_t*  xpPrivateKey,
+  uint8_t*        xpPublicKey
+);
+
+/**
+ * @brief
+ *   ECDSA P-256 signature of a 32 byte digest.
+ *
+ * @param[in] xpPrivateKey
+ *   Big endian private scalar, C_SAL_EMU_ECC_SCALAR_SIZE bytes.
+ * @param[in] xpDigest
+ *   Message digest, 32 bytes.
+ * @param[in] xpNonce
+ *   Per signature random scalar k, C_SAL_EMU_ECC_SCALAR_SIZE bytes.
+ * @param[out] xpSignature
+ *   Signature R||S, C_SAL_EMU_ECC_SIGNATURE_SIZE bytes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER if the key or the nonce is not usable; the caller
+ *   shall retry with a fresh nonce.
+ */
+TKStatus salEmuEccSign
+(
+  const uint8_t*  xpPrivateKey,
+  const uint8_t*  xpDigest,
+  const uint8_t*  xpNonce,
+  uint8_t*        xpSignature
+);
+
+/**
+ * @brief
+ *   ECDH P-256 shared secret (X coordinate of d.Q).
+ *
+ * @param[in] xpPrivateKey
+ *   Big endian private scalar, C_SAL_EMU_ECC_SCALAR_SIZE bytes.
+ * @param[in] xpPeerPublicKey
+ *   Peer public key X||Y, C_SAL_EMU_ECC_PUBLIC_KEY_SIZE bytes.
+ * @param[out] xpSecret
+ *   Shared secret, 32 bytes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER if the peer key is not on the curve.
+ */
+TKStatus salEmuEccSharedSecret
+(
+  const uint8_t*  xpPrivateKey,
+  const uint8_t*  xpPeerPublicKey,
+  uint8_t*        xpSecret
+);
+
+/**
+ * @brief
+ *   AES-128 single block encryption.
+ *
+ * @param[in] xpKey
+ *   Key, C_SAL_EMU_AES_BLOCK_SIZE bytes.
+ * @param[in] xpInput
+ *   Plain text block.
+ * @param[out] xpOutput
+ *   Cipher text block. May alias xpInput.
+ */
+void salEmuAesEncrypt
+(
+  const uint8_t*  xpKey,
+  const uint8_t*  xpInput,
+  uint8_t*        xpOutput
+);
+
+/**
+ * @brief
+ *   AES-128 single block decryption.
+ *
+ * @param[in] xpKey
+ *   Key, C_SAL_EMU_AES_BLOCK_SIZE bytes.
+ * @param[in] xpInput
+ *   Cipher text block.
+ * @param[out] xpOutput
+ *   Plain text block. May alias xpInput.
+ */
+void salEmuAesDecrypt
+(
+  const uint8_t*  xpKey,
+  const uint8_t*  xpInput,
+  uint8_t*        xpOutput
+);
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+#endif // K_SAL_EMU_CRYPTO_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,226 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  Emulated FOTA store for host builds.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file k_sal_emu_fotastorage.h
+ ******************************************************************************/
+
+/**
+ * @brief Emulated FOTA store for host builds.
+ *
+ * Implements salFotaStorageWrite() and salFotaStorageRead() on top of a page
+ * organized flash image, in place of the platform stubs of
+ * k_sal_fotastorage.c. Usage:
+ *
+ *   salEmuFotaInit(&config);
+ *   ktaStartup(); ...
+ *   salEmuFotaGetStats(&stats);
+ *
+ * Every FOTA record has a fixed area: a 4 byte length header followed by the
+ * record. Areas start on a page boundary or are packed back to back
+ * (isPageAligned), so that storage layouts can be compared. A record write
+ * erases and programs every page it touches, neighbours included.
+ *
+ * The image is kept in a memory mapped file, or in RAM only. Page reads and
+ * writes are accounted in a latency model and in a per page write histogram
+ * (wear). salEmuFotaSetPowerCut() tears one page write to exercise the
+ * recovery of the FOTA campaign state.
+ */
+
+#ifndef K_SAL_EMU_FOTASTORAGE_H
+#define K_SAL_EMU_FOTASTORAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+
+#include "k_defs.h"
+#include "k_sal_fotastorage.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* -------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                     */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Largest number of pages of the store. */
+#define C_SAL_EMU_FOTA_PAGE_MAX                    (256u)
+
+/** @brief Largest store size in bytes. */
+#define C_SAL_EMU_FOTA_STORE_MAX_SIZE              (131072u)
+
+/** @brief Largest page size in bytes. */
+#define C_SAL_EMU_FOTA_PAGE_SIZE_MAX               (4096u)
+
+/** @brief Default page size, one NVM row of the SAMD21. */
+#define C_SAL_EMU_FOTA_PAGE_SIZE_DEFAULT           (256u)
+
+/** @brief Default page read time in microseconds. */
+#define C_SAL_EMU_FOTA_READ_TIME_US_DEFAULT        (20u)
+
+/** @brief Default page erase and program time in microseconds. */
+#define C_SAL_EMU_FOTA_WRITE_TIME_US_DEFAULT       (16000u)
+
+/** @brief Emulated FOTA store configuration. */
+typedef struct
+{
+  /* File backing the store, NULL to keep the store in RAM only. */
+  const char*  pStoragePath;
+  /* Erase and program unit in bytes, 0 for the default. */
+  uint32_t     pageSize;
+  /* When true, every record area starts on a page boundary. */
+  bool         isPageAligned;
+  /* Page read time in microseconds, 0 disables. */
+  uint32_t     pageReadTimeUs;
+  /* Page erase and program time in microseconds, 0 disables. */
+  uint32_t     pageWriteTimeUs;
+  /* When true, the modeled time is also spent for real. */
+  bool         isRealTimeDelay;
+} TKSalEmuFotaConfig;
+
+/** @brief Emulated FOTA store statistics. */
+typedef struct
+{
+  /* Number of pages of the store with the configured layout. */
+  uint32_t  pageCount;
+  /* Number of salFotaStorageRead() calls. */
+  uint32_t  readCount;
+  /* Number of salFotaStorageWrite() calls. */
+  uint32_t  writeCount;
+  /* Number of calls that failed. */
+  uint32_t  errorCount;
+  /* Number of page reads. */
+  uint32_t  pageReadCount;
+  /* Number of page erase and program cycles. */
+  uint32_t  pageWriteCount;
+  /* Erase and program cycles per page (wear histogram). */
+  uint32_t  aPageWriteCount[C_SAL_EMU_FOTA_PAGE_MAX];
+  /* Number of injected power cuts. */
+  uint32_t  powerCutCount;
+  /* Modeled store time in microseconds. */
+  uint64_t  emulatedTimeUs;
+} TKSalEmuFotaStats;
+
+/* -------------------------------------------------------------------------- */
+/* VARIABLES                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief
+ *   Initialize the emulated store, map or create the flash image. A new image
+ *   is erased (all bytes 0xFF).
+ *
+ * @param[in] xpConfig
+ *   Store configuration, NULL for a RAM only store without latency.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER if the layout does not fit the page size.
+ * - E_K_STATUS_DATA if the file exists with another size than the layout.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salEmuFotaInit
+(
+  const TKSalEmuFotaConfig*  xpConfig
+);
+
+/**
+ * @brief
+ *   Arm a power cut: the xPageWriteCount-th next page write stops half way
+ *   through the record bytes of the page, the rest of the page stays erased.
+ *   All accesses then fail until salEmuFotaTerm() followed by salEmuFotaInit()
+ *   emulate the reboot.
+ *
+ * @param[in] xPageWriteCount
+ *   Rank of the torn page write, 1 for the next one, 0 to disarm.
+ */
+K_SAL_API void salEmuFotaSetPowerCut
+(
+  uint32_t  xPageWriteCount
+);
+
+/**
+ * @brief
+ *   Get the emulated store statistics.
+ *
+ * @param[out] xpStats
+ *   Statistics snapshot. Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ */
+K_SAL_API TKStatus salEmuFotaGetStats
+(
+  TKSalEmuFotaStats*  xpStats
+);
+
+/**
+ * @brief
+ *   Reset the emulated store statistics, the page count excepted.
+ */
+K_SAL_API void salEmuFotaResetStats
+(
+  void
+);
+
+/**
+ * @brief
+ *   Write back and release the flash image.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR if the image cannot be written back.
+ */
+K_SAL_API TKStatus salEmuFotaTerm
+(
+  void
+);
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+#endif // K_SAL_EMU_FOTASTORAGE_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
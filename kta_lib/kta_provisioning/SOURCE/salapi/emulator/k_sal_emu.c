@@ -0,0 +1,2244 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  Software emulated ATECC608 secure element for host builds.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file k_sal_emu.c
+ ******************************************************************************/
+
+/**
+ * @brief Software emulated ATECC608 secure element for host builds.
+ */
+
+#include "k_sal_emu.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "k_sal_emu_crypto.h"
+#include "host/atca_host.h"
+#include "crypto/atca_crypto_sw.h"
+#include "KTALog.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Configuration zone size. */
+#define C_EMU_CONFIG_SIZE                          (128u)
+
+/** @brief OTP zone size. */
+#define C_EMU_OTP_SIZE                             (64u)
+
+/** @brief Number of data slots. */
+#define C_EMU_SLOT_COUNT                           (16u)
+
+/** @brief Data zone size: 8 x 36 + 416 + 7 x 72 bytes. */
+#define C_EMU_DATA_SIZE                            (1208u)
+
+/** @brief Symmetric key / digest size. */
+#define C_EMU_KEY_SIZE                             (32u)
+
+/** @brief Word size of 4 byte accesses. */
+#define C_EMU_WORD_SIZE                            (4u)
+
+/** @brief Block size of 32 byte accesses. */
+#define C_EMU_BLOCK_SIZE                           (32u)
+
+/** @brief Largest response payload (GenKey, Sign). */
+#define C_EMU_RESPONSE_DATA_MAX                    (64u)
+
+/** @brief Largest response packet: count, payload and CRC. */
+#define C_EMU_RESPONSE_MAX                         (C_EMU_RESPONSE_DATA_MAX + 3u)
+
+/** @brief Smallest command packet: count, opcode, param1, param2, CRC. */
+#define C_EMU_COMMAND_MIN                          (7u)
+
+/** @brief Offset of the command payload in the packet. */
+#define C_EMU_COMMAND_DATA_OFFSET                  (5u)
+
+/** @brief Wake up time (tWLO + tWHI) in microseconds. */
+#define C_EMU_WAKE_TIME_US                         (1560u)
+
+/** @brief Attempts to draw a usable ECC scalar. */
+#define C_EMU_ECC_RETRIES                          (8u)
+
+/** @brief Word addresses of the I2C protocol. */
+#define C_EMU_WORD_ADDRESS_RESET                   (0x00u)
+#define C_EMU_WORD_ADDRESS_SLEEP                   (0x01u)
+#define C_EMU_WORD_ADDRESS_IDLE                    (0x02u)
+#define C_EMU_WORD_ADDRESS_COMMAND                 (0x03u)
+
+/** @brief Status byte values of single byte responses. */
+#define C_EMU_STATUS_SUCCESS                       (0x00u)
+#define C_EMU_STATUS_MISCOMPARE                    (0x01u)
+#define C_EMU_STATUS_PARSE_ERROR                   (0x03u)
+#define C_EMU_STATUS_ECC_FAULT                     (0x05u)
+#define C_EMU_STATUS_EXECUTION_ERROR               (0x0Fu)
+#define C_EMU_STATUS_CRC_ERROR                     (0xFFu)
+
+/** @brief Configuration zone layout. */
+#define C_EMU_CFG_REVISION                         (4u)
+#define C_EMU_CFG_SN_HIGH                          (8u)
+#define C_EMU_CFG_AES_ENABLE                       (13u)
+#define C_EMU_CFG_I2C_ENABLE                       (14u)
+#define C_EMU_CFG_I2C_ADDRESS                      (16u)
+#define C_EMU_CFG_READ_ONLY_SIZE                   (16u)
+#define C_EMU_CFG_SLOT_CONFIG                      (20u)
+#define C_EMU_CFG_LOCK_VALUE                       (86u)
+#define C_EMU_CFG_LOCK_CONFIG                      (87u)
+#define C_EMU_CFG_SLOT_LOCKED                      (88u)
+#define C_EMU_CFG_KEY_CONFIG                       (96u)
+
+/** @brief SlotConfig.NoMac bit. */
+#define C_EMU_SLOT_CONFIG_NO_MAC                   (0x0010u)
+
+/** @brief KeyConfig value of a P-256 private key slot. */
+#define C_EMU_KEY_CONFIG_P256_PRIVATE              (0x0033u)
+
+/** @brief KeyConfig value of a data / symmetric key slot. */
+#define C_EMU_KEY_CONFIG_DATA                      (0x003Cu)
+
+/** @brief KeyConfig.Private bit. */
+#define C_EMU_KEY_CONFIG_PRIVATE                   (0x0001u)
+
+/** @brief SHA command digest targets. */
+#define C_EMU_SHA_TARGET_TEMPKEY                   (0x00u)
+#define C_EMU_SHA_TARGET_MSGDIGBUF                 (0x40u)
+
+/** @brief Storage file header. */
+#define C_EMU_FILE_MAGIC                           "KEMU"
+#define C_EMU_FILE_MAGIC_SIZE                      (4u)
+#define C_EMU_FILE_VERSION                         (1u)
+#define C_EMU_FILE_HEADER_SIZE                     (C_EMU_FILE_MAGIC_SIZE + 1u)
+#define C_EMU_FILE_SIZE                            (C_EMU_FILE_HEADER_SIZE + sizeof(TEmuNvm))
+
+/** @brief Persistent part of the device. */
+typedef struct
+{
+  uint8_t  aConfig[C_EMU_CONFIG_SIZE];
+  uint8_t  aOtp[C_EMU_OTP_SIZE];
+  uint8_t  aData[C_EMU_DATA_SIZE];
+  /* Private keys are kept outside of the readable data zone. */
+  uint8_t  aPrivateKey[C_EMU_SLOT_COUNT][C_EMU_KEY_SIZE];
+  uint8_t  aKeyValid[C_EMU_SLOT_COUNT];
+} TEmuNvm;
+
+/** @brief Power state. */
+typedef enum
+{
+  E_EMU_POWER_SLEEP,
+  E_EMU_POWER_IDLE,
+  E_EMU_POWER_ACTIVE,
+  /* Power cut injected, no answer until the next salEmuInit(). */
+  E_EMU_POWER_OFF
+} TEmuPowerState;
+
+/** @brief SHA engine state. */
+typedef enum
+{
+  E_EMU_SHA_NONE,
+  E_EMU_SHA_PLAIN,
+  E_EMU_SHA_HMAC
+} TEmuShaState;
+
+/** @brief Emulated device. */
+typedef struct
+{
+  TEmuNvm               nvm;
+  /* Last stored image: in the file mapping or in RAM. */
+  TEmuNvm*              pImage;
+  bool                  isNvmDirty;
+  uint32_t              powerCutCountdown;
+  atca_temp_key_t       tempKey;
+  uint8_t               aMsgDigestBuffer[C_EMU_KEY_SIZE * 2u];
+  uint8_t               aAltKeyBuffer[C_EMU_KEY_SIZE];
+  TEmuShaState          shaState;
+  atcac_sha2_256_ctx_t  shaCtx;
+  atcac_hmac_ctx_t      hmacCtx;
+  TEmuPowerState        powerState;
+  uint8_t               aResponse[C_EMU_RESPONSE_MAX];
+  size_t                responseLength;
+  size_t                responseOffset;
+  uint8_t               aDrbgState[C_EMU_KEY_SIZE];
+  uint32_t              drbgCounter;
+} TEmuDevice;
+
+/** @brief Command handler, returns the status byte. */
+typedef uint8_t (*TEmuCommandHandler)
+(
+  uint8_t         xParam1,
+  uint16_t        xParam2,
+  const uint8_t*  xpData,
+  size_t          xDataLen,
+  uint8_t*        xpOut,
+  size_t*         xpOutLen
+);
+
+/** @brief Command table entry. */
+typedef struct
+{
+  uint8_t             opcode;
+  /* ATECC608 (clock divider M0) execution time in ms. */
+  uint32_t            executionTimeMs;
+  TEmuCommandHandler  handler;
+} TEmuCommand;
+
+/** @brief Emulator instance: one emulated device and its host side state. */
+struct SKSalEmuInstance
+{
+  TEmuDevice      device;
+  /* Emulated device. */
+  TKSalEmuConfig  config;
+  /* Emulator configuration. */
+  TKSalEmuStats   stats;
+  /* Emulator statistics. */
+  uint32_t        aLatencyMs[C_SAL_EMU_OPCODE_COUNT];
+  /* Execution time per opcode in ms. */
+  ATCAIfaceCfg    ifaceCfg;
+  /* Custom interface routed to the instance. */
+  TEmuNvm         image;
+  /* Stored image when the storage file is not mapped. */
+  uint8_t*        pMap;
+  /* Mapping of the storage file, NULL if not mapped. */
+};
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_009 : misra_c2012_rule_5.9_violation
+ * The identifier gpModuleName is intentionally defined as a common global for logging purposes
+ */
+#if LOG_KTA_ENABLE != C_KTA_LOG_LEVEL_NONE
+static const char* gpModuleName = "SALEMU";
+#endif
+
+/** @brief Built-in emulator instance. */
+static TKSalEmuInstance gEmuInstance;
+
+/** @brief Instance served by the calling thread: selected or addressed by the HAL. */
+static K_THREAD_LOCAL TKSalEmuInstance* gpEmu = &gEmuInstance;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+
+static uint8_t lCmdAes(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                       size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdEcdh(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                        size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdGenDig(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                          size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdGenKey(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                          size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdInfo(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                        size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdKdf(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                       size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdLock(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                        size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdNonce(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                         size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdRandom(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                          size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdRead(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                        size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdSha(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                       size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdSign(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                        size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+static uint8_t lCmdWrite(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                         size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen);
+
+/** @brief Custom HAL entry points. */
+static ATCA_STATUS lHalInit(void* xpHal, void* xpCfg);
+static ATCA_STATUS lHalPostInit(void* xpIface);
+static ATCA_STATUS lHalSend(void* xpIface, uint8_t xWordAddress, uint8_t* xpTxData, int xTxLength);
+static ATCA_STATUS lHalReceive(void* xpIface, uint8_t xWordAddress, uint8_t* xpRxData, uint16_t* xpRxLength);
+static ATCA_STATUS lHalWake(void* xpIface);
+static ATCA_STATUS lHalIdle(void* xpIface);
+static ATCA_STATUS lHalSleep(void* xpIface);
+static ATCA_STATUS lHalRelease(void* xpHalData);
+
+/**
+ * @brief
+ *   Serve the instance of an interface on the calling thread.
+ *
+ * @param[in] xpCfg
+ *   Interface configuration of the HAL call.
+ */
+static void lHalEnter(ATCAIfaceCfg* xpCfg);
+
+/**
+ * @brief
+ *   Decode, execute and answer one command packet.
+ * @param[in] xpPacket
+ *   Command packet: count, opcode, param1, param2, data, CRC.
+ * @param[in] xLength
+ *   Number of bytes received.
+ */
+static void lExecute(const uint8_t* xpPacket, size_t xLength);
+
+/**
+ * @brief
+ *   Account modeled time, optionally spending it for real.
+ * @param[in] xTimeUs
+ *   Time in microseconds, before scaling for execution times.
+ */
+static void lSpendTime(uint64_t xTimeUs);
+
+/** @brief Fill xpOut with DRBG output. */
+static void lRandom(uint8_t* xpOut, size_t xLength);
+
+/** @brief Set the factory image: serial number, config, keys. */
+static void lFactoryReset(void);
+
+/** @brief Load the persistent image, E_K_STATUS_MISSING if there is none. */
+static TKStatus lLoad(void);
+
+/** @brief Store the persistent image. */
+static TKStatus lSave(void);
+
+/** @brief Map the storage file, create it when missing. */
+static TKStatus lMap(void);
+
+/** @brief Release the storage file mapping. */
+static void lUnmap(void);
+
+/** @brief Store half of the bytes changed by the last command and power off. */
+static void lPowerCut(void);
+
+/** @brief Account a write of a data zone block in the wear histogram. */
+static void lCountBlockWrite(uint32_t xSlot, size_t xBlock);
+
+/** @brief Offset of a slot in the data zone. */
+static size_t lSlotOffset(uint32_t xSlot);
+
+/** @brief Size of a slot. */
+static size_t lSlotSize(uint32_t xSlot);
+
+/** @brief SlotConfig of a slot. */
+static uint16_t lSlotConfig(uint32_t xSlot);
+
+/** @brief KeyConfig of a slot. */
+static uint16_t lKeyConfig(uint32_t xSlot);
+
+/** @brief Return true if the slot is individually locked. */
+static bool lIsSlotLocked(uint32_t xSlot);
+
+/** @brief Serial number SN[0:8]. */
+static void lSerialNumber(uint8_t* xpSn);
+
+/**
+ * @brief
+ *   Resolve a zone address as encoded by calib_get_addr().
+ * @return
+ *   Pointer to xLength bytes of zone memory, NULL when out of range.
+ */
+static uint8_t* lZoneAddress(uint8_t xZone, uint16_t xAddress, size_t xLength);
+
+/** @brief Key used by slot or TempKey (0xFFFF) based commands. */
+static const uint8_t* lKeyAddress(uint16_t xKeyId, size_t xOffset, size_t xLength);
+
+/** @brief Reset TempKey to a value not derived from a slot. */
+static void lSetTempKey(const uint8_t* xpValue);
+
+/** @brief HMAC-SHA256 with a 32 byte key. */
+static void lHmac(const uint8_t* xpKey, const uint8_t* xpMsg, size_t xMsgLen, uint8_t* xpMac);
+
+/** @brief Command table, ATECC608 M0 execution times. */
+static const TEmuCommand gaEmuCommand[] =
+{
+  { ATCA_AES,     27u,  lCmdAes    },
+  { ATCA_ECDH,    75u,  lCmdEcdh   },
+  { ATCA_GENDIG,  25u,  lCmdGenDig },
+  { ATCA_GENKEY,  115u, lCmdGenKey },
+  { ATCA_INFO,    5u,   lCmdInfo   },
+  { ATCA_KDF,     165u, lCmdKdf    },
+  { ATCA_LOCK,    35u,  lCmdLock   },
+  { ATCA_NONCE,   20u,  lCmdNonce  },
+  { ATCA_RANDOM,  23u,  lCmdRandom },
+  { ATCA_READ,    5u,   lCmdRead   },
+  { ATCA_SHA,     36u,  lCmdSha    },
+  { ATCA_SIGN,    115u, lCmdSign   },
+  { ATCA_WRITE,   45u,  lCmdWrite  }
+};
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  implement salEmuInit
+ *
+ */
+K_SAL_API TKStatus salEmuInit
+(
+  const TKSalEmuConfig*  xpConfig
+)
+{
+  TKStatus  status = E_K_STATUS_ERROR;
+  uint8_t   aSeed[C_EMU_KEY_SIZE * 2u] = {0};
+  time_t    now = time(NULL);
+  clock_t   ticks = clock();
+  FILE*     pEntropy = NULL;
+  size_t    i = 0;
+
+  M_KTALOG__START("Start");
+
+  (void)memset(&gpEmu->device, 0, sizeof(gpEmu->device));
+  (void)memset(&gpEmu->config, 0, sizeof(gpEmu->config));
+  (void)memset(&gpEmu->stats, 0, sizeof(gpEmu->stats));
+  (void)memset(gpEmu->aLatencyMs, 0, sizeof(gpEmu->aLatencyMs));
+  lUnmap();
+  gpEmu->device.pImage = &gpEmu->image;
+
+  if (NULL != xpConfig)
+  {
+    gpEmu->config = *xpConfig;
+  }
+
+  for (i = 0; i < (sizeof(gaEmuCommand) / sizeof(gaEmuCommand[0])); i++)
+  {
+    gpEmu->aLatencyMs[gaEmuCommand[i].opcode] = gaEmuCommand[i].executionTimeMs;
+  }
+
+  /* Seed the DRBG from the host entropy source when there is one. */
+  (void)memcpy(aSeed, &now, (sizeof(now) < C_EMU_KEY_SIZE) ? sizeof(now) : C_EMU_KEY_SIZE);
+  (void)memcpy(&aSeed[sizeof(aSeed) - sizeof(ticks)], &ticks, sizeof(ticks));
+  pEntropy = fopen("/dev/urandom", "rb");
+  if (NULL != pEntropy)
+  {
+    (void)fread(&aSeed[C_EMU_KEY_SIZE / 2u], 1, C_EMU_KEY_SIZE, pEntropy);
+    (void)fclose(pEntropy);
+  }
+  (void)atcac_sw_sha2_256(aSeed, sizeof(aSeed), gpEmu->device.aDrbgState);
+
+  gpEmu->device.powerState = E_EMU_POWER_SLEEP;
+
+  status = lLoad();
+  if (E_K_STATUS_MISSING == status)
+  {
+    M_KTALOG__INFO("No device image, creating a new one");
+    lFactoryReset();
+    status = lSave();
+  }
+
+  (void)memset(&gpEmu->ifaceCfg, 0, sizeof(gpEmu->ifaceCfg));
+  gpEmu->ifaceCfg.iface_type = ATCA_CUSTOM_IFACE;
+  gpEmu->ifaceCfg.devtype = ATECC608;
+  gpEmu->ifaceCfg.rx_retries = 1;
+  ATCA_IFACECFG_VALUE(&gpEmu->ifaceCfg, atcacustom.halinit) = lHalInit;
+  ATCA_IFACECFG_VALUE(&gpEmu->ifaceCfg, atcacustom.halpostinit) = lHalPostInit;
+  ATCA_IFACECFG_VALUE(&gpEmu->ifaceCfg, atcacustom.halsend) = lHalSend;
+  ATCA_IFACECFG_VALUE(&gpEmu->ifaceCfg, atcacustom.halreceive) = lHalReceive;
+  ATCA_IFACECFG_VALUE(&gpEmu->ifaceCfg, atcacustom.halwake) = lHalWake;
+  ATCA_IFACECFG_VALUE(&gpEmu->ifaceCfg, atcacustom.halidle) = lHalIdle;
+  ATCA_IFACECFG_VALUE(&gpEmu->ifaceCfg, atcacustom.halsleep) = lHalSleep;
+  ATCA_IFACECFG_VALUE(&gpEmu->ifaceCfg, atcacustom.halrelease) = lHalRelease;
+  /* Routes the HAL calls of a device made on this interface to the instance. */
+  gpEmu->ifaceCfg.cfg_data = gpEmu;
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief  implement salEmuCreate
+ *
+ */
+K_SAL_API TKSalEmuInstance* salEmuCreate
+(
+  void
+)
+{
+  return (TKSalEmuInstance*)calloc(1u, sizeof(TKSalEmuInstance));
+}
+
+/**
+ * @brief  implement salEmuSelect
+ *
+ */
+K_SAL_API void salEmuSelect
+(
+  TKSalEmuInstance*  xpInstance
+)
+{
+  gpEmu = (NULL == xpInstance) ? &gEmuInstance : xpInstance;
+}
+
+/**
+ * @brief  implement salEmuDestroy
+ *
+ */
+K_SAL_API void salEmuDestroy
+(
+  TKSalEmuInstance*  xpInstance
+)
+{
+  TKSalEmuInstance* pCurrent = gpEmu;
+
+  if ((NULL != xpInstance) && (&gEmuInstance != xpInstance))
+  {
+    gpEmu = xpInstance;
+    lUnmap();
+    gpEmu = (pCurrent == xpInstance) ? &gEmuInstance : pCurrent;
+    free(xpInstance);
+  }
+}
+
+/**
+ * @brief  implement salEmuGetIfaceCfg
+ *
+ */
+K_SAL_API ATCAIfaceCfg* salEmuGetIfaceCfg
+(
+  void
+)
+{
+  return &gpEmu->ifaceCfg;
+}
+
+/**
+ * @brief  implement salEmuSetLatency
+ *
+ */
+K_SAL_API void salEmuSetLatency
+(
+  uint8_t   xOpcode,
+  uint32_t  xExecutionTimeMs
+)
+{
+  gpEmu->aLatencyMs[xOpcode] = xExecutionTimeMs;
+}
+
+/**
+ * @brief  implement salEmuSetPowerCut
+ *
+ */
+K_SAL_API void salEmuSetPowerCut
+(
+  uint32_t  xNvmWriteCount
+)
+{
+  gpEmu->device.powerCutCountdown = xNvmWriteCount;
+}
+
+/**
+ * @brief  implement salEmuGetStats
+ *
+ */
+K_SAL_API TKStatus salEmuGetStats
+(
+  TKSalEmuStats*  xpStats
+)
+{
+  TKStatus status = E_K_STATUS_PARAMETER;
+
+  if (NULL != xpStats)
+  {
+    *xpStats = gpEmu->stats;
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement salEmuResetStats
+ *
+ */
+K_SAL_API void salEmuResetStats
+(
+  void
+)
+{
+  (void)memset(&gpEmu->stats, 0, sizeof(gpEmu->stats));
+}
+
+/**
+ * @brief  implement salEmuTerm
+ *
+ */
+K_SAL_API TKStatus salEmuTerm
+(
+  void
+)
+{
+  TKStatus status = lSave();
+
+  lUnmap();
+  gpEmu->device.pImage = &gpEmu->image;
+  (void)memset(&gpEmu->device.tempKey, 0, sizeof(gpEmu->device.tempKey));
+  gpEmu->device.powerState = E_EMU_POWER_SLEEP;
+
+  return status;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @implements lHalInit
+ *
+ **/
+static ATCA_STATUS lHalInit(void* xpHal, void* xpCfg)
+{
+  M_UNUSED(xpHal);
+  lHalEnter((ATCAIfaceCfg*)xpCfg);
+  return ATCA_SUCCESS;
+}
+
+/**
+ * @implements lHalPostInit
+ *
+ **/
+static ATCA_STATUS lHalPostInit(void* xpIface)
+{
+  lHalEnter(atgetifacecfg((ATCAIface)xpIface));
+  return ATCA_SUCCESS;
+}
+
+/**
+ * @implements lHalSend
+ *
+ **/
+static ATCA_STATUS lHalSend(void* xpIface, uint8_t xWordAddress, uint8_t* xpTxData, int xTxLength)
+{
+  ATCA_STATUS status = ATCA_SUCCESS;
+  size_t      length = (xTxLength > 0) ? (size_t)xTxLength : 0u;
+
+  lHalEnter(atgetifacecfg((ATCAIface)xpIface));
+
+  if (E_EMU_POWER_OFF == gpEmu->device.powerState)
+  {
+    return ATCA_COMM_FAIL;
+  }
+
+  gpEmu->stats.busTransferCount++;
+  gpEmu->stats.txBytes += (uint32_t)(length + 1u);
+  lSpendTime((uint64_t)(length + 1u) * gpEmu->config.busByteTimeUs);
+
+  switch (xWordAddress)
+  {
+    case C_EMU_WORD_ADDRESS_RESET:
+      gpEmu->device.responseOffset = 0;
+      break;
+
+    case C_EMU_WORD_ADDRESS_SLEEP:
+      (void)lHalSleep(xpIface);
+      break;
+
+    case C_EMU_WORD_ADDRESS_IDLE:
+      (void)lHalIdle(xpIface);
+      break;
+
+    case C_EMU_WORD_ADDRESS_COMMAND:
+      if (E_EMU_POWER_ACTIVE != gpEmu->device.powerState)
+      {
+        /* I2C devices wake on the start condition of the transfer. */
+        (void)lHalWake(xpIface);
+      }
+      gpEmu->device.powerState = E_EMU_POWER_ACTIVE;
+      if (NULL == xpTxData)
+      {
+        status = ATCA_BAD_PARAM;
+      }
+      else
+      {
+        lExecute(xpTxData, length);
+      }
+      break;
+
+    default:
+      status = ATCA_BAD_PARAM;
+      break;
+  }
+
+  return status;
+}
+
+/**
+ * @implements lHalReceive
+ *
+ **/
+static ATCA_STATUS lHalReceive(void* xpIface, uint8_t xWordAddress, uint8_t* xpRxData, uint16_t* xpRxLength)
+{
+  ATCA_STATUS status = ATCA_RX_NO_RESPONSE;
+  size_t      length = 0;
+
+  lHalEnter(atgetifacecfg((ATCAIface)xpIface));
+  M_UNUSED(xWordAddress);
+
+  if ((NULL == xpRxData) || (NULL == xpRxLength))
+  {
+    return ATCA_BAD_PARAM;
+  }
+
+  if (gpEmu->device.responseOffset < gpEmu->device.responseLength)
+  {
+    length = gpEmu->device.responseLength - gpEmu->device.responseOffset;
+    if (length > *xpRxLength)
+    {
+      length = *xpRxLength;
+    }
+
+    (void)memcpy(xpRxData, &gpEmu->device.aResponse[gpEmu->device.responseOffset], length);
+    gpEmu->device.responseOffset += length;
+    gpEmu->stats.busTransferCount++;
+    gpEmu->stats.rxBytes += (uint32_t)length;
+    lSpendTime((uint64_t)length * gpEmu->config.busByteTimeUs);
+    status = ATCA_SUCCESS;
+  }
+
+  *xpRxLength = (uint16_t)length;
+  return status;
+}
+
+/**
+ * @implements lHalWake
+ *
+ **/
+static ATCA_STATUS lHalWake(void* xpIface)
+{
+  lHalEnter(atgetifacecfg((ATCAIface)xpIface));
+
+  if (E_EMU_POWER_OFF == gpEmu->device.powerState)
+  {
+    return ATCA_COMM_FAIL;
+  }
+
+  /* Idle and sleep both need a wake token, only sleep loses TempKey. */
+  if (E_EMU_POWER_ACTIVE != gpEmu->device.powerState)
+  {
+    gpEmu->stats.wakeCount++;
+    lSpendTime(C_EMU_WAKE_TIME_US);
+  }
+  gpEmu->device.powerState = E_EMU_POWER_ACTIVE;
+
+  return ATCA_SUCCESS;
+}
+
+/**
+ * @implements lHalIdle
+ *
+ **/
+static ATCA_STATUS lHalIdle(void* xpIface)
+{
+  lHalEnter(atgetifacecfg((ATCAIface)xpIface));
+
+  if (E_EMU_POWER_OFF == gpEmu->device.powerState)
+  {
+    return ATCA_COMM_FAIL;
+  }
+
+  /* Idle keeps TempKey and the SHA context. */
+  gpEmu->stats.idleCount++;
+  gpEmu->device.powerState = E_EMU_POWER_IDLE;
+
+  return ATCA_SUCCESS;
+}
+
+/**
+ * @implements lHalSleep
+ *
+ **/
+static ATCA_STATUS lHalSleep(void* xpIface)
+{
+  lHalEnter(atgetifacecfg((ATCAIface)xpIface));
+
+  if (E_EMU_POWER_OFF == gpEmu->device.powerState)
+  {
+    return ATCA_COMM_FAIL;
+  }
+
+  /* Sleep clears every volatile register. */
+  gpEmu->stats.sleepCount++;
+  (void)memset(&gpEmu->device.tempKey, 0, sizeof(gpEmu->device.tempKey));
+  (void)memset(gpEmu->device.aMsgDigestBuffer, 0, sizeof(gpEmu->device.aMsgDigestBuffer));
+  (void)memset(gpEmu->device.aAltKeyBuffer, 0, sizeof(gpEmu->device.aAltKeyBuffer));
+  gpEmu->device.shaState = E_EMU_SHA_NONE;
+  gpEmu->device.powerState = E_EMU_POWER_SLEEP;
+
+  return ATCA_SUCCESS;
+}
+
+/**
+ * @implements lHalRelease
+ *
+ **/
+static ATCA_STATUS lHalRelease(void* xpHalData)
+{
+  M_UNUSED(xpHalData);
+  return (E_K_STATUS_OK == lSave()) ? ATCA_SUCCESS : ATCA_GEN_FAIL;
+}
+
+/**
+ * @implements lHalEnter
+ *
+ **/
+static void lHalEnter(ATCAIfaceCfg* xpCfg)
+{
+  if ((NULL != xpCfg) && (NULL != xpCfg->cfg_data))
+  {
+    gpEmu = (TKSalEmuInstance*)xpCfg->cfg_data;
+  }
+}
+
+/**
+ * @implements lExecute
+ *
+ **/
+static void lExecute(const uint8_t* xpPacket, size_t xLength)
+{
+  uint8_t             aOut[C_EMU_RESPONSE_DATA_MAX] = {0};
+  size_t              outLen = 0;
+  uint8_t             aCrc[2] = {0};
+  uint8_t             statusByte = C_EMU_STATUS_PARSE_ERROR;
+  uint8_t             opcode = 0;
+  uint16_t            param2 = 0;
+  size_t              count = 0;
+  TEmuCommandHandler  handler = NULL;
+  size_t              i = 0;
+
+  gpEmu->device.responseLength = 0;
+  gpEmu->device.responseOffset = 0;
+  gpEmu->device.isNvmDirty = false;
+
+  count = (xLength > 0u) ? xpPacket[0] : 0u;
+  if ((count < C_EMU_COMMAND_MIN) || (count > xLength))
+  {
+    statusByte = C_EMU_STATUS_PARSE_ERROR;
+  }
+  else
+  {
+    atCRC(count - 2u, xpPacket, aCrc);
+    if ((aCrc[0] != xpPacket[count - 2u]) || (aCrc[1] != xpPacket[count - 1u]))
+    {
+      statusByte = C_EMU_STATUS_CRC_ERROR;
+    }
+    else
+    {
+      opcode = xpPacket[1];
+      param2 = (uint16_t)((uint16_t)xpPacket[3] | ((uint16_t)xpPacket[4] << 8));
+
+      for (i = 0; i < (sizeof(gaEmuCommand) / sizeof(gaEmuCommand[0])); i++)
+      {
+        if (gaEmuCommand[i].opcode == opcode)
+        {
+          handler = gaEmuCommand[i].handler;
+          break;
+        }
+      }
+
+      if (NULL != handler)
+      {
+        statusByte = handler(xpPacket[2], param2,
+                             &xpPacket[C_EMU_COMMAND_DATA_OFFSET],
+                             count - C_EMU_COMMAND_MIN, aOut, &outLen);
+      }
+      else
+      {
+        M_KTALOG__ERR("Unsupported opcode 0x%02X", opcode);
+      }
+
+      gpEmu->stats.commandCount++;
+      gpEmu->stats.aOpcodeCount[opcode]++;
+      lSpendTime(((uint64_t)gpEmu->aLatencyMs[opcode] * 1000u * gpEmu->config.latencyScale) /
+                 C_SAL_EMU_LATENCY_SCALE_NOMINAL);
+    }
+  }
+
+  if (C_EMU_STATUS_SUCCESS != statusByte)
+  {
+    gpEmu->stats.errorCount++;
+    outLen = 0;
+  }
+
+  if (0u == outLen)
+  {
+    gpEmu->device.aResponse[0] = 4u;
+    gpEmu->device.aResponse[1] = statusByte;
+    gpEmu->device.responseLength = 4u;
+  }
+  else
+  {
+    gpEmu->device.aResponse[0] = (uint8_t)(outLen + 3u);
+    (void)memcpy(&gpEmu->device.aResponse[1], aOut, outLen);
+    gpEmu->device.responseLength = outLen + 3u;
+  }
+  atCRC(gpEmu->device.responseLength - 2u, gpEmu->device.aResponse, &gpEmu->device.aResponse[gpEmu->device.responseLength - 2u]);
+
+  if (gpEmu->device.isNvmDirty)
+  {
+    gpEmu->stats.nvmWriteCount++;
+    if (0u != gpEmu->device.powerCutCountdown)
+    {
+      gpEmu->device.powerCutCountdown--;
+      if (0u == gpEmu->device.powerCutCountdown)
+      {
+        lPowerCut();
+        return;
+      }
+    }
+
+    if (E_K_STATUS_OK != lSave())
+    {
+      M_KTALOG__ERR("Device image not saved");
+    }
+  }
+}
+
+/**
+ * @implements lSpendTime
+ *
+ **/
+static void lSpendTime(uint64_t xTimeUs)
+{
+  gpEmu->stats.emulatedTimeUs += xTimeUs;
+
+  if (gpEmu->config.isRealTimeDelay && (0u != xTimeUs))
+  {
+    atca_delay_us((uint32_t)xTimeUs);
+  }
+}
+
+/**
+ * @implements lRandom
+ *
+ **/
+static void lRandom(uint8_t* xpOut, size_t xLength)
+{
+  uint8_t  aBlock[C_EMU_KEY_SIZE + sizeof(uint32_t)];
+  uint8_t  aDigest[C_EMU_KEY_SIZE];
+  size_t   chunk = 0;
+  size_t   done = 0;
+
+  while (done < xLength)
+  {
+    (void)memcpy(aBlock, gpEmu->device.aDrbgState, C_EMU_KEY_SIZE);
+    (void)memcpy(&aBlock[C_EMU_KEY_SIZE], &gpEmu->device.drbgCounter, sizeof(uint32_t));
+    gpEmu->device.drbgCounter++;
+    (void)atcac_sw_sha2_256(aBlock, sizeof(aBlock), aDigest);
+
+    chunk = ((xLength - done) < C_EMU_KEY_SIZE) ? (xLength - done) : C_EMU_KEY_SIZE;
+    (void)memcpy(&xpOut[done], aDigest, chunk);
+    done += chunk;
+  }
+}
+
+/**
+ * @implements lFactoryReset
+ *
+ **/
+static void lFactoryReset(void)
+{
+  static const uint8_t aRevision[C_EMU_WORD_SIZE] = {0x00, 0x00, 0x60, 0x02};
+  uint8_t   aPublicKey[C_SAL_EMU_ECC_PUBLIC_KEY_SIZE];
+  uint16_t  keyConfig = 0;
+  uint32_t  slot = 0;
+  uint32_t  attempt = 0;
+
+  (void)memset(&gpEmu->device.nvm, 0, sizeof(gpEmu->device.nvm));
+
+  /* SN[0:1] = 0x01 0x23 and SN[8] = 0xEE as on production parts. */
+  gpEmu->device.nvm.aConfig[0] = 0x01;
+  gpEmu->device.nvm.aConfig[1] = 0x23;
+  lRandom(&gpEmu->device.nvm.aConfig[2], 2);
+  (void)memcpy(&gpEmu->device.nvm.aConfig[C_EMU_CFG_REVISION], aRevision, sizeof(aRevision));
+  lRandom(&gpEmu->device.nvm.aConfig[C_EMU_CFG_SN_HIGH], 4);
+  gpEmu->device.nvm.aConfig[C_EMU_CFG_SN_HIGH + 4u] = 0xEE;
+  gpEmu->device.nvm.aConfig[C_EMU_CFG_AES_ENABLE] = 0x01;
+  gpEmu->device.nvm.aConfig[C_EMU_CFG_I2C_ENABLE] = 0x01;
+  gpEmu->device.nvm.aConfig[C_EMU_CFG_I2C_ADDRESS] = 0xC0;
+
+  for (slot = 0; slot < C_EMU_SLOT_COUNT; slot++)
+  {
+    /* Slots 0 to 3 hold the P-256 keys used by KTA (device, attestation, chip). */
+    keyConfig = (slot < 4u) ? C_EMU_KEY_CONFIG_P256_PRIVATE : C_EMU_KEY_CONFIG_DATA;
+    gpEmu->device.nvm.aConfig[C_EMU_CFG_KEY_CONFIG + (slot * 2u)] = (uint8_t)keyConfig;
+    gpEmu->device.nvm.aConfig[C_EMU_CFG_KEY_CONFIG + (slot * 2u) + 1u] = (uint8_t)(keyConfig >> 8);
+
+    if (0u != (keyConfig & C_EMU_KEY_CONFIG_PRIVATE))
+    {
+      for (attempt = 0; attempt < C_EMU_ECC_RETRIES; attempt++)
+      {
+        lRandom(gpEmu->device.nvm.aPrivateKey[slot], C_EMU_KEY_SIZE);
+        if (E_K_STATUS_OK == salEmuEccPublicKey(gpEmu->device.nvm.aPrivateKey[slot], aPublicKey))
+        {
+          gpEmu->device.nvm.aKeyValid[slot] = 1;
+          break;
+        }
+      }
+    }
+  }
+
+  /* Config and data zones locked, individual slots unlocked. */
+  gpEmu->device.nvm.aConfig[C_EMU_CFG_LOCK_VALUE] = ATCA_LOCKED;
+  gpEmu->device.nvm.aConfig[C_EMU_CFG_LOCK_CONFIG] = ATCA_LOCKED;
+  gpEmu->device.nvm.aConfig[C_EMU_CFG_SLOT_LOCKED] = 0xFF;
+  gpEmu->device.nvm.aConfig[C_EMU_CFG_SLOT_LOCKED + 1u] = 0xFF;
+}
+
+/**
+ * @implements lLoad
+ *
+ **/
+static TKStatus lLoad(void)
+{
+  TKStatus  status = E_K_STATUS_MISSING;
+  FILE*     pFile = NULL;
+  char      aMagic[C_EMU_FILE_MAGIC_SIZE] = {0};
+  uint8_t   version = 0;
+
+  if ((NULL != gpEmu->config.pStoragePath) && gpEmu->config.isMappedStorage)
+  {
+    return lMap();
+  }
+
+  if (NULL != gpEmu->config.pStoragePath)
+  {
+    pFile = fopen(gpEmu->config.pStoragePath, "rb");
+  }
+
+  if (NULL != pFile)
+  {
+    status = E_K_STATUS_DATA;
+
+    if ((fread(aMagic, 1, sizeof(aMagic), pFile) == sizeof(aMagic)) &&
+        (0 == memcmp(aMagic, C_EMU_FILE_MAGIC, sizeof(aMagic))) &&
+        (fread(&version, 1, 1, pFile) == 1u) &&
+        (C_EMU_FILE_VERSION == version) &&
+        (fread(&gpEmu->device.nvm, 1, sizeof(gpEmu->device.nvm), pFile) == sizeof(gpEmu->device.nvm)))
+    {
+      *gpEmu->device.pImage = gpEmu->device.nvm;
+      status = E_K_STATUS_OK;
+    }
+    else
+    {
+      M_KTALOG__ERR("Invalid device image %s", gpEmu->config.pStoragePath);
+    }
+
+    (void)fclose(pFile);
+  }
+
+  return status;
+}
+
+/**
+ * @implements lSave
+ *
+ **/
+static TKStatus lSave(void)
+{
+  TKStatus  status = E_K_STATUS_OK;
+  FILE*     pFile = NULL;
+  uint8_t   version = C_EMU_FILE_VERSION;
+
+  /* A mapped file is updated in place, the page cache writes it back. */
+  *gpEmu->device.pImage = gpEmu->device.nvm;
+
+  if ((NULL != gpEmu->config.pStoragePath) && (NULL == gpEmu->pMap))
+  {
+    status = E_K_STATUS_ERROR;
+    pFile = fopen(gpEmu->config.pStoragePath, "wb");
+
+    if (NULL != pFile)
+    {
+      if ((fwrite(C_EMU_FILE_MAGIC, 1, C_EMU_FILE_MAGIC_SIZE, pFile) == C_EMU_FILE_MAGIC_SIZE) &&
+          (fwrite(&version, 1, 1, pFile) == 1u) &&
+          (fwrite(&gpEmu->device.nvm, 1, sizeof(gpEmu->device.nvm), pFile) == sizeof(gpEmu->device.nvm)))
+      {
+        status = E_K_STATUS_OK;
+      }
+
+      if (0 != fclose(pFile))
+      {
+        status = E_K_STATUS_ERROR;
+      }
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @implements lMap
+ *
+ **/
+static TKStatus lMap(void)
+{
+  TKStatus     status = E_K_STATUS_ERROR;
+  struct stat  fileStat;
+  int          fd = -1;
+  bool         isNew = false;
+
+  fd = open(gpEmu->config.pStoragePath, O_RDWR | O_CREAT, 0600);
+  if (fd < 0)
+  {
+    M_KTALOG__ERR("Cannot open %s", gpEmu->config.pStoragePath);
+    return E_K_STATUS_ERROR;
+  }
+
+  if (0 == fstat(fd, &fileStat))
+  {
+    isNew = (0 == fileStat.st_size);
+    if ((!isNew) && ((size_t)fileStat.st_size != C_EMU_FILE_SIZE))
+    {
+      status = E_K_STATUS_DATA;
+    }
+    else if ((!isNew) || (0 == ftruncate(fd, (off_t)C_EMU_FILE_SIZE)))
+    {
+      gpEmu->pMap = mmap(NULL, C_EMU_FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (MAP_FAILED == gpEmu->pMap)
+      {
+        gpEmu->pMap = NULL;
+      }
+    }
+    else
+    {
+      /* ftruncate() failed. */
+    }
+  }
+  (void)close(fd);
+
+  if (NULL != gpEmu->pMap)
+  {
+    gpEmu->device.pImage = (TEmuNvm*)(void*)&gpEmu->pMap[C_EMU_FILE_HEADER_SIZE];
+    if (isNew)
+    {
+      (void)memcpy(gpEmu->pMap, C_EMU_FILE_MAGIC, C_EMU_FILE_MAGIC_SIZE);
+      gpEmu->pMap[C_EMU_FILE_MAGIC_SIZE] = C_EMU_FILE_VERSION;
+      status = E_K_STATUS_MISSING;
+    }
+    else if ((0 == memcmp(gpEmu->pMap, C_EMU_FILE_MAGIC, C_EMU_FILE_MAGIC_SIZE)) &&
+             (C_EMU_FILE_VERSION == gpEmu->pMap[C_EMU_FILE_MAGIC_SIZE]))
+    {
+      gpEmu->device.nvm = *gpEmu->device.pImage;
+      status = E_K_STATUS_OK;
+    }
+    else
+    {
+      status = E_K_STATUS_DATA;
+    }
+  }
+
+  if (E_K_STATUS_DATA == status)
+  {
+    M_KTALOG__ERR("Invalid device image %s", gpEmu->config.pStoragePath);
+    lUnmap();
+    gpEmu->device.pImage = &gpEmu->image;
+  }
+
+  return status;
+}
+
+/**
+ * @implements lUnmap
+ *
+ **/
+static void lUnmap(void)
+{
+  if (NULL != gpEmu->pMap)
+  {
+    (void)msync(gpEmu->pMap, C_EMU_FILE_SIZE, MS_SYNC);
+    (void)munmap(gpEmu->pMap, C_EMU_FILE_SIZE);
+    gpEmu->pMap = NULL;
+  }
+}
+
+/**
+ * @implements lPowerCut
+ *
+ **/
+static void lPowerCut(void)
+{
+  uint8_t*        pNew = (uint8_t*)&gpEmu->device.nvm;
+  const uint8_t*  pOld = (const uint8_t*)gpEmu->device.pImage;
+  size_t          first = 0;
+  size_t          last = sizeof(TEmuNvm);
+  size_t          half = 0;
+
+  while ((first < last) && (pNew[first] == pOld[first]))
+  {
+    first++;
+  }
+  while ((last > first) && (pNew[last - 1u] == pOld[last - 1u]))
+  {
+    last--;
+  }
+
+  /* The EEPROM is written in address order, the second half never makes it. */
+  half = (last - first) / 2u;
+  (void)memcpy(&pNew[first + half], &pOld[first + half], (last - first) - half);
+  if (E_K_STATUS_OK != lSave())
+  {
+    M_KTALOG__ERR("Device image not saved");
+  }
+
+  M_KTALOG__INFO("Power cut, %u of %u modified bytes stored", (unsigned int)half,
+                 (unsigned int)(last - first));
+  (void)memset(&gpEmu->device.tempKey, 0, sizeof(gpEmu->device.tempKey));
+  gpEmu->device.shaState = E_EMU_SHA_NONE;
+  gpEmu->device.powerState = E_EMU_POWER_OFF;
+  gpEmu->device.responseLength = 0;
+  gpEmu->device.powerCutCountdown = 0;
+  gpEmu->stats.powerCutCount++;
+}
+
+/**
+ * @implements lCountBlockWrite
+ *
+ **/
+static void lCountBlockWrite(uint32_t xSlot, size_t xBlock)
+{
+  if ((xSlot < C_SAL_EMU_SLOT_COUNT) && (xBlock < C_SAL_EMU_SLOT_BLOCK_MAX))
+  {
+    gpEmu->stats.aBlockWriteCount[xSlot][xBlock]++;
+  }
+}
+
+/**
+ * @implements lSlotOffset
+ *
+ **/
+static size_t lSlotOffset(uint32_t xSlot)
+{
+  size_t offset = 0;
+
+  if (xSlot < 8u)
+  {
+    offset = xSlot * 36u;
+  }
+  else if (8u == xSlot)
+  {
+    offset = 288u;
+  }
+  else
+  {
+    offset = 704u + ((xSlot - 9u) * 72u);
+  }
+
+  return offset;
+}
+
+/**
+ * @implements lSlotSize
+ *
+ **/
+static size_t lSlotSize(uint32_t xSlot)
+{
+  size_t size = 72u;
+
+  if (xSlot < 8u)
+  {
+    size = 36u;
+  }
+  else if (8u == xSlot)
+  {
+    size = 416u;
+  }
+  else
+  {
+    /* Slots 9 to 15 use the default. */
+  }
+
+  return size;
+}
+
+/**
+ * @implements lSlotConfig
+ *
+ **/
+static uint16_t lSlotConfig(uint32_t xSlot)
+{
+  const uint8_t* pValue = &gpEmu->device.nvm.aConfig[C_EMU_CFG_SLOT_CONFIG + ((xSlot & 0x0Fu) * 2u)];
+
+  return (uint16_t)((uint16_t)pValue[0] | ((uint16_t)pValue[1] << 8));
+}
+
+/**
+ * @implements lKeyConfig
+ *
+ **/
+static uint16_t lKeyConfig(uint32_t xSlot)
+{
+  const uint8_t* pValue = &gpEmu->device.nvm.aConfig[C_EMU_CFG_KEY_CONFIG + ((xSlot & 0x0Fu) * 2u)];
+
+  return (uint16_t)((uint16_t)pValue[0] | ((uint16_t)pValue[1] << 8));
+}
+
+/**
+ * @implements lIsSlotLocked
+ *
+ **/
+static bool lIsSlotLocked(uint32_t xSlot)
+{
+  uint16_t slotLocked = (uint16_t)((uint16_t)gpEmu->device.nvm.aConfig[C_EMU_CFG_SLOT_LOCKED] |
+                                   ((uint16_t)gpEmu->device.nvm.aConfig[C_EMU_CFG_SLOT_LOCKED + 1u] << 8));
+
+  /* A cleared bit means locked. */
+  return (0u == (slotLocked & (1u << (xSlot & 0x0Fu))));
+}
+
+/**
+ * @implements lSerialNumber
+ *
+ **/
+static void lSerialNumber(uint8_t* xpSn)
+{
+  (void)memcpy(xpSn, gpEmu->device.nvm.aConfig, 4);
+  (void)memcpy(&xpSn[4], &gpEmu->device.nvm.aConfig[C_EMU_CFG_SN_HIGH], 5);
+}
+
+/**
+ * @implements lZoneAddress
+ *
+ **/
+static uint8_t* lZoneAddress(uint8_t xZone, uint16_t xAddress, size_t xLength)
+{
+  uint8_t*  pBase = NULL;
+  size_t    size = 0;
+  size_t    block = 0;
+  size_t    offset = 0;
+  uint32_t  slot = 0;
+
+  switch (xZone & ATCA_ZONE_MASK)
+  {
+    case ATCA_ZONE_CONFIG:
+      pBase = gpEmu->device.nvm.aConfig;
+      size = C_EMU_CONFIG_SIZE;
+      block = ((size_t)xAddress >> 3) & 0x03u;
+      break;
+
+    case ATCA_ZONE_OTP:
+      pBase = gpEmu->device.nvm.aOtp;
+      size = C_EMU_OTP_SIZE;
+      block = ((size_t)xAddress >> 3) & 0x01u;
+      break;
+
+    case ATCA_ZONE_DATA:
+      slot = ((uint32_t)xAddress >> 3) & 0x0Fu;
+      pBase = &gpEmu->device.nvm.aData[lSlotOffset(slot)];
+      size = lSlotSize(slot);
+      block = (size_t)xAddress >> 8;
+      break;
+
+    default:
+      /* Invalid zone. */
+      break;
+  }
+
+  /* The word offset is ignored for 32 byte accesses. */
+  offset = block * C_EMU_BLOCK_SIZE;
+  if (C_EMU_WORD_SIZE == xLength)
+  {
+    offset += ((size_t)xAddress & 0x07u) * C_EMU_WORD_SIZE;
+  }
+
+  if ((NULL == pBase) || ((offset + xLength) > size))
+  {
+    return NULL;
+  }
+
+  return &pBase[offset];
+}
+
+/**
+ * @implements lKeyAddress
+ *
+ **/
+static const uint8_t* lKeyAddress(uint16_t xKeyId, size_t xOffset, size_t xLength)
+{
+  const uint8_t* pKey = NULL;
+
+  if (ATCA_TEMPKEY_KEYID == xKeyId)
+  {
+    if ((1u == gpEmu->device.tempKey.valid) && ((xOffset + xLength) <= sizeof(gpEmu->device.tempKey.value)))
+    {
+      pKey = &gpEmu->device.tempKey.value[xOffset];
+    }
+  }
+  else if ((xKeyId < C_EMU_SLOT_COUNT) && ((xOffset + xLength) <= lSlotSize(xKeyId)))
+  {
+    pKey = &gpEmu->device.nvm.aData[lSlotOffset(xKeyId) + xOffset];
+  }
+  else
+  {
+    /* Unknown key. */
+  }
+
+  return pKey;
+}
+
+/**
+ * @implements lSetTempKey
+ *
+ **/
+static void lSetTempKey(const uint8_t* xpValue)
+{
+  (void)memcpy(gpEmu->device.tempKey.value, xpValue, C_EMU_KEY_SIZE);
+  gpEmu->device.tempKey.key_id = 0;
+  gpEmu->device.tempKey.source_flag = 1;
+  gpEmu->device.tempKey.gen_dig_data = 0;
+  gpEmu->device.tempKey.gen_key_data = 0;
+  gpEmu->device.tempKey.no_mac_flag = 0;
+  gpEmu->device.tempKey.valid = 1;
+  gpEmu->device.tempKey.is_64 = 0;
+}
+
+/**
+ * @implements lHmac
+ *
+ **/
+static void lHmac(const uint8_t* xpKey, const uint8_t* xpMsg, size_t xMsgLen, uint8_t* xpMac)
+{
+  atcac_hmac_ctx_t      ctx;
+  atcac_sha2_256_ctx_t  shaCtx;
+  size_t                macLen = C_EMU_KEY_SIZE;
+
+  (void)atcac_sha256_hmac_init(&ctx, &shaCtx, xpKey, C_EMU_KEY_SIZE);
+  (void)atcac_sha256_hmac_update(&ctx, xpMsg, xMsgLen);
+  (void)atcac_sha256_hmac_finish(&ctx, xpMac, &macLen);
+}
+
+/**
+ * @implements lCmdRead
+ *
+ **/
+static uint8_t lCmdRead(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                        size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  size_t          length = (0u != (xParam1 & ATCA_ZONE_READWRITE_32)) ? C_EMU_BLOCK_SIZE : C_EMU_WORD_SIZE;
+  const uint8_t*  pZone = lZoneAddress(xParam1, xParam2, length);
+
+  M_UNUSED(xpData);
+
+  if ((NULL == pZone) || (0u != xDataLen))
+  {
+    return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  (void)memcpy(xpOut, pZone, length);
+  *xpOutLen = length;
+
+  return C_EMU_STATUS_SUCCESS;
+}
+
+/**
+ * @implements lCmdWrite
+ *
+ **/
+static uint8_t lCmdWrite(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                         size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  uint8_t                  aPlain[C_EMU_BLOCK_SIZE];
+  uint8_t                  aCipher[C_EMU_BLOCK_SIZE];
+  uint8_t                  aMac[C_EMU_KEY_SIZE];
+  uint8_t                  aSn[ATCA_SERIAL_NUM_SIZE];
+  atca_temp_key_t          tempKey;
+  atca_write_mac_in_out_t  macParams;
+  bool                     isEncrypted = (0u != (xParam1 & ATCA_ZONE_ENCRYPTED));
+  size_t                   length = (0u != (xParam1 & ATCA_ZONE_READWRITE_32)) ? C_EMU_BLOCK_SIZE : C_EMU_WORD_SIZE;
+  uint8_t*                 pZone = lZoneAddress(xParam1, xParam2, length);
+  uint8_t                  zone = xParam1 & ATCA_ZONE_MASK;
+  size_t                   i = 0;
+
+  M_UNUSED(xpOut);
+  M_UNUSED(xpOutLen);
+
+  if ((NULL == pZone) || (xDataLen != (length + (isEncrypted ? WRITE_MAC_SIZE : 0u))) ||
+      (isEncrypted && (C_EMU_BLOCK_SIZE != length)))
+  {
+    return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  if ((ATCA_ZONE_CONFIG == zone) &&
+      ((ATCA_UNLOCKED != gpEmu->device.nvm.aConfig[C_EMU_CFG_LOCK_CONFIG]) ||
+       ((size_t)(pZone - gpEmu->device.nvm.aConfig) < C_EMU_CFG_READ_ONLY_SIZE)))
+  {
+    return C_EMU_STATUS_EXECUTION_ERROR;
+  }
+
+  if ((ATCA_ZONE_DATA == zone) && lIsSlotLocked(((uint32_t)xParam2 >> 3) & 0x0Fu))
+  {
+    return C_EMU_STATUS_EXECUTION_ERROR;
+  }
+
+  (void)memcpy(aPlain, xpData, length);
+
+  if (isEncrypted)
+  {
+    /* Data is XORed with TempKey and authenticated with the Write MAC. */
+    if ((1u != gpEmu->device.tempKey.valid) || (1u != gpEmu->device.tempKey.gen_dig_data))
+    {
+      return C_EMU_STATUS_EXECUTION_ERROR;
+    }
+
+    for (i = 0; i < C_EMU_BLOCK_SIZE; i++)
+    {
+      aPlain[i] = xpData[i] ^ gpEmu->device.tempKey.value[i];
+    }
+
+    lSerialNumber(aSn);
+    tempKey = gpEmu->device.tempKey;
+    (void)memset(&macParams, 0, sizeof(macParams));
+    macParams.zone = xParam1;
+    macParams.key_id = xParam2;
+    macParams.sn = aSn;
+    macParams.input_data = aPlain;
+    macParams.encrypted_data = aCipher;
+    macParams.auth_mac = aMac;
+    macParams.temp_key = &tempKey;
+    gpEmu->device.tempKey.valid = 0;
+
+    if ((ATCA_SUCCESS != atcah_write_auth_mac(&macParams)) ||
+        (0 != memcmp(aMac, &xpData[C_EMU_BLOCK_SIZE], WRITE_MAC_SIZE)))
+    {
+      M_KTALOG__ERR("Write MAC mismatch for address 0x%04X", xParam2);
+      return C_EMU_STATUS_MISCOMPARE;
+    }
+  }
+
+  (void)memcpy(pZone, aPlain, length);
+  gpEmu->device.isNvmDirty = true;
+  if (ATCA_ZONE_DATA == zone)
+  {
+    lCountBlockWrite(((uint32_t)xParam2 >> 3) & 0x0Fu, (size_t)xParam2 >> 8);
+  }
+
+  return C_EMU_STATUS_SUCCESS;
+}
+
+/**
+ * @implements lCmdNonce
+ *
+ **/
+static uint8_t lCmdNonce(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                         size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  uint8_t              aRandOut[RANDOM_NUM_SIZE];
+  atca_nonce_in_out_t  nonceParams;
+  uint8_t              calcMode = xParam1 & NONCE_MODE_MASK;
+  uint8_t              target = xParam1 & NONCE_MODE_TARGET_MASK;
+  size_t               inputLen = ((xParam1 & NONCE_MODE_INPUT_LEN_MASK) == NONCE_MODE_INPUT_LEN_64) ?
+                                  (C_EMU_KEY_SIZE * 2u) : C_EMU_KEY_SIZE;
+
+  (void)memset(&nonceParams, 0, sizeof(nonceParams));
+  nonceParams.mode = xParam1;
+  nonceParams.zero = xParam2;
+  nonceParams.num_in = xpData;
+  nonceParams.temp_key = &gpEmu->device.tempKey;
+
+  if ((NONCE_MODE_SEED_UPDATE == calcMode) || (NONCE_MODE_NO_SEED_UPDATE == calcMode))
+  {
+    if ((size_t)NONCE_NUMIN_SIZE != xDataLen)
+    {
+      return C_EMU_STATUS_PARSE_ERROR;
+    }
+
+    lRandom(aRandOut, sizeof(aRandOut));
+    nonceParams.rand_out = aRandOut;
+    (void)atcah_nonce(&nonceParams);
+
+    (void)memcpy(xpOut, aRandOut, sizeof(aRandOut));
+    *xpOutLen = sizeof(aRandOut);
+  }
+  else if (NONCE_MODE_PASSTHROUGH == calcMode)
+  {
+    if (inputLen != xDataLen)
+    {
+      return C_EMU_STATUS_PARSE_ERROR;
+    }
+
+    if (NONCE_MODE_TARGET_TEMPKEY == target)
+    {
+      (void)atcah_nonce(&nonceParams);
+    }
+    else if (NONCE_MODE_TARGET_MSGDIGBUF == target)
+    {
+      (void)memcpy(gpEmu->device.aMsgDigestBuffer, xpData, inputLen);
+    }
+    else if (NONCE_MODE_TARGET_ALTKEYBUF == target)
+    {
+      (void)memcpy(gpEmu->device.aAltKeyBuffer, xpData, C_EMU_KEY_SIZE);
+    }
+    else
+    {
+      return C_EMU_STATUS_PARSE_ERROR;
+    }
+  }
+  else
+  {
+    return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  return C_EMU_STATUS_SUCCESS;
+}
+
+/**
+ * @implements lCmdRandom
+ *
+ **/
+static uint8_t lCmdRandom(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                          size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  M_UNUSED(xParam1);
+  M_UNUSED(xParam2);
+  M_UNUSED(xpData);
+  M_UNUSED(xDataLen);
+
+  lRandom(xpOut, RANDOM_NUM_SIZE);
+  *xpOutLen = RANDOM_NUM_SIZE;
+
+  return C_EMU_STATUS_SUCCESS;
+}
+
+/**
+ * @implements lCmdGenDig
+ *
+ **/
+static uint8_t lCmdGenDig(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                          size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  uint8_t                aSn[ATCA_SERIAL_NUM_SIZE];
+  atca_gen_dig_in_out_t  genDigParams;
+  const uint8_t*         pStored = NULL;
+
+  M_UNUSED(xpOut);
+  M_UNUSED(xpOutLen);
+
+  if (1u != gpEmu->device.tempKey.valid)
+  {
+    return C_EMU_STATUS_EXECUTION_ERROR;
+  }
+
+  switch (xParam1)
+  {
+    case GENDIG_ZONE_CONFIG:
+      pStored = (xParam2 < 4u) ? &gpEmu->device.nvm.aConfig[xParam2 * C_EMU_BLOCK_SIZE] : NULL;
+      break;
+
+    case GENDIG_ZONE_OTP:
+      pStored = (xParam2 < 2u) ? &gpEmu->device.nvm.aOtp[xParam2 * C_EMU_BLOCK_SIZE] : NULL;
+      break;
+
+    case GENDIG_ZONE_DATA:
+      pStored = lKeyAddress(xParam2, 0, C_EMU_KEY_SIZE);
+      break;
+
+    default:
+      /* Shared nonce, counter and key config zones are not emulated. */
+      break;
+  }
+
+  if (NULL == pStored)
+  {
+    return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  lSerialNumber(aSn);
+  (void)memset(&genDigParams, 0, sizeof(genDigParams));
+  genDigParams.zone = xParam1;
+  genDigParams.key_id = xParam2;
+  genDigParams.sn = aSn;
+  genDigParams.stored_value = pStored;
+  genDigParams.temp_key = &gpEmu->device.tempKey;
+
+  /* OtherData only replaces the opcode and parameters for NoMac keys. */
+  if ((GENDIG_ZONE_DATA == xParam1) && (C_EMU_WORD_SIZE == xDataLen) &&
+      (0u != (lSlotConfig(xParam2) & C_EMU_SLOT_CONFIG_NO_MAC)))
+  {
+    genDigParams.is_key_nomac = true;
+    genDigParams.other_data = xpData;
+  }
+
+  return (ATCA_SUCCESS == atcah_gen_dig(&genDigParams)) ?
+         C_EMU_STATUS_SUCCESS : C_EMU_STATUS_EXECUTION_ERROR;
+}
+
+/**
+ * @implements lCmdGenKey
+ *
+ **/
+static uint8_t lCmdGenKey(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                          size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  uint8_t                aSn[ATCA_SERIAL_NUM_SIZE];
+  uint8_t                aPublicKey[C_SAL_EMU_ECC_PUBLIC_KEY_SIZE];
+  atca_gen_key_in_out_t  genKeyParams;
+  const uint8_t*         pSlot = NULL;
+  uint32_t               attempt = 0;
+
+  if (xParam2 >= C_EMU_SLOT_COUNT)
+  {
+    return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  lSerialNumber(aSn);
+  (void)memset(&genKeyParams, 0, sizeof(genKeyParams));
+  genKeyParams.mode = xParam1;
+  genKeyParams.key_id = xParam2;
+  genKeyParams.public_key = aPublicKey;
+  genKeyParams.public_key_size = sizeof(aPublicKey);
+  genKeyParams.sn = aSn;
+  genKeyParams.temp_key = &gpEmu->device.tempKey;
+
+  if (GENKEY_MODE_PUBKEY_DIGEST == (xParam1 & GENKEY_MODE_PUBKEY_DIGEST))
+  {
+    /* Digest of a public key stored in a slot: pad(4) X pad(4) Y. */
+    pSlot = lKeyAddress(xParam2, 0, 72u);
+    if ((NULL == pSlot) || (3u != xDataLen) || (1u != gpEmu->device.tempKey.valid))
+    {
+      return C_EMU_STATUS_EXECUTION_ERROR;
+    }
+
+    (void)memcpy(aPublicKey, &pSlot[4], C_SAL_EMU_ECC_SCALAR_SIZE);
+    (void)memcpy(&aPublicKey[C_SAL_EMU_ECC_SCALAR_SIZE], &pSlot[40], C_SAL_EMU_ECC_SCALAR_SIZE);
+    genKeyParams.other_data = xpData;
+
+    return (ATCA_SUCCESS == atcah_gen_key_msg(&genKeyParams)) ?
+           C_EMU_STATUS_SUCCESS : C_EMU_STATUS_EXECUTION_ERROR;
+  }
+
+  if (GENKEY_MODE_PRIVATE == (xParam1 & GENKEY_MODE_PRIVATE))
+  {
+    gpEmu->device.nvm.aKeyValid[xParam2] = 0;
+    for (attempt = 0; attempt < C_EMU_ECC_RETRIES; attempt++)
+    {
+      lRandom(gpEmu->device.nvm.aPrivateKey[xParam2], C_EMU_KEY_SIZE);
+      if (E_K_STATUS_OK == salEmuEccPublicKey(gpEmu->device.nvm.aPrivateKey[xParam2], aPublicKey))
+      {
+        gpEmu->device.nvm.aKeyValid[xParam2] = 1;
+        break;
+      }
+    }
+    gpEmu->device.isNvmDirty = true;
+    lCountBlockWrite(xParam2, 0);
+  }
+  else if ((1u != gpEmu->device.nvm.aKeyValid[xParam2]) ||
+           (E_K_STATUS_OK != salEmuEccPublicKey(gpEmu->device.nvm.aPrivateKey[xParam2], aPublicKey)))
+  {
+    return C_EMU_STATUS_EXECUTION_ERROR;
+  }
+  else
+  {
+    /* Public key computed from the stored private key. */
+  }
+
+  if (1u != gpEmu->device.nvm.aKeyValid[xParam2])
+  {
+    return C_EMU_STATUS_ECC_FAULT;
+  }
+
+  if (GENKEY_MODE_DIGEST == (xParam1 & GENKEY_MODE_DIGEST))
+  {
+    if ((1u != gpEmu->device.tempKey.valid) || (ATCA_SUCCESS != atcah_gen_key_msg(&genKeyParams)))
+    {
+      return C_EMU_STATUS_EXECUTION_ERROR;
+    }
+  }
+
+  (void)memcpy(xpOut, aPublicKey, sizeof(aPublicKey));
+  *xpOutLen = sizeof(aPublicKey);
+
+  return C_EMU_STATUS_SUCCESS;
+}
+
+/**
+ * @implements lCmdSign
+ *
+ **/
+static uint8_t lCmdSign(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                        size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  uint8_t                      aSn[ATCA_SERIAL_NUM_SIZE];
+  uint8_t                      aDigest[C_EMU_KEY_SIZE];
+  uint8_t                      aNonce[C_SAL_EMU_ECC_SCALAR_SIZE];
+  atca_sign_internal_in_out_t  signParams;
+  uint32_t                     attempt = 0;
+
+  M_UNUSED(xpData);
+  M_UNUSED(xDataLen);
+
+  if ((xParam2 >= C_EMU_SLOT_COUNT) || (1u != gpEmu->device.nvm.aKeyValid[xParam2]))
+  {
+    return C_EMU_STATUS_EXECUTION_ERROR;
+  }
+
+  if (SIGN_MODE_EXTERNAL == (xParam1 & SIGN_MODE_EXTERNAL))
+  {
+    if (SIGN_MODE_SOURCE_MSGDIGBUF == (xParam1 & SIGN_MODE_SOURCE_MASK))
+    {
+      (void)memcpy(aDigest, gpEmu->device.aMsgDigestBuffer, sizeof(aDigest));
+    }
+    else if (1u == gpEmu->device.tempKey.valid)
+    {
+      (void)memcpy(aDigest, gpEmu->device.tempKey.value, sizeof(aDigest));
+    }
+    else
+    {
+      return C_EMU_STATUS_EXECUTION_ERROR;
+    }
+  }
+  else
+  {
+    /* Internal message built from TempKey and the TempKey source slot. */
+    if ((1u != gpEmu->device.tempKey.valid) ||
+        ((1u != gpEmu->device.tempKey.gen_dig_data) && (1u != gpEmu->device.tempKey.gen_key_data)))
+    {
+      return C_EMU_STATUS_EXECUTION_ERROR;
+    }
+
+    lSerialNumber(aSn);
+    (void)memset(&signParams, 0, sizeof(signParams));
+    signParams.mode = xParam1;
+    signParams.key_id = xParam2;
+    signParams.slot_config = lSlotConfig(gpEmu->device.tempKey.key_id);
+    signParams.key_config = lKeyConfig(gpEmu->device.tempKey.key_id);
+    signParams.is_slot_locked = lIsSlotLocked(gpEmu->device.tempKey.key_id);
+    signParams.for_invalidate = (SIGN_MODE_INVALIDATE == (xParam1 & SIGN_MODE_INVALIDATE));
+    signParams.sn = aSn;
+    signParams.temp_key = &gpEmu->device.tempKey;
+    signParams.digest = aDigest;
+
+    if (ATCA_SUCCESS != atcah_sign_internal_msg(ATECC608, &signParams))
+    {
+      return C_EMU_STATUS_EXECUTION_ERROR;
+    }
+  }
+
+  for (attempt = 0; attempt < C_EMU_ECC_RETRIES; attempt++)
+  {
+    lRandom(aNonce, sizeof(aNonce));
+    if (E_K_STATUS_OK == salEmuEccSign(gpEmu->device.nvm.aPrivateKey[xParam2], aDigest, aNonce, xpOut))
+    {
+      *xpOutLen = C_SAL_EMU_ECC_SIGNATURE_SIZE;
+      return C_EMU_STATUS_SUCCESS;
+    }
+  }
+
+  return C_EMU_STATUS_ECC_FAULT;
+}
+
+/**
+ * @implements lCmdEcdh
+ *
+ **/
+static uint8_t lCmdEcdh(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                        size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  uint8_t   aSecret[C_EMU_KEY_SIZE];
+  uint8_t*  pTarget = NULL;
+  uint8_t   statusByte = C_EMU_STATUS_SUCCESS;
+
+  if ((C_SAL_EMU_ECC_PUBLIC_KEY_SIZE != xDataLen) ||
+      (ECDH_MODE_SOURCE_EEPROM_SLOT != (xParam1 & ECDH_MODE_SOURCE_MASK)) ||
+      (ECDH_MODE_OUTPUT_CLEAR != (xParam1 & ECDH_MODE_OUTPUT_MASK)) ||
+      (xParam2 >= C_EMU_SLOT_COUNT))
+  {
+    return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  if (1u != gpEmu->device.nvm.aKeyValid[xParam2])
+  {
+    return C_EMU_STATUS_EXECUTION_ERROR;
+  }
+
+  if (E_K_STATUS_OK != salEmuEccSharedSecret(gpEmu->device.nvm.aPrivateKey[xParam2], xpData, aSecret))
+  {
+    return C_EMU_STATUS_ECC_FAULT;
+  }
+
+  switch (xParam1 & ECDH_MODE_COPY_MASK)
+  {
+    case ECDH_MODE_COPY_TEMP_KEY:
+      lSetTempKey(aSecret);
+      break;
+
+    case ECDH_MODE_COPY_EEPROM_SLOT:
+      pTarget = &gpEmu->device.nvm.aData[lSlotOffset(xParam2 | 1u)];
+      if (lIsSlotLocked(xParam2 | 1u))
+      {
+        statusByte = C_EMU_STATUS_EXECUTION_ERROR;
+      }
+      else
+      {
+        (void)memcpy(pTarget, aSecret, sizeof(aSecret));
+        gpEmu->device.isNvmDirty = true;
+      }
+      break;
+
+    default:
+      (void)memcpy(xpOut, aSecret, sizeof(aSecret));
+      *xpOutLen = sizeof(aSecret);
+      break;
+  }
+
+  (void)memset(aSecret, 0, sizeof(aSecret));
+  return statusByte;
+}
+
+/**
+ * @implements lCmdKdf
+ *
+ **/
+static uint8_t lCmdKdf(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                       size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  static const uint8_t aZeroKey[C_EMU_KEY_SIZE] = {0};
+  uint8_t         aResult[C_EMU_KEY_SIZE];
+  const uint8_t*  pKey = NULL;
+  const uint8_t*  pMessage = NULL;
+  uint32_t        details = 0;
+  size_t          messageLen = 0;
+  uint32_t        targetSlot = ((uint32_t)xParam2 >> 8) & 0x0Fu;
+
+  if ((xDataLen < KDF_DETAILS_SIZE) || (KDF_MODE_ALG_HKDF != (xParam1 & KDF_MODE_ALG_MASK)))
+  {
+    /* Only HKDF is used by KTA, PRF and AES are not emulated. */
+    return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  details = (uint32_t)xpData[0] | ((uint32_t)xpData[1] << 8) |
+            ((uint32_t)xpData[2] << 16) | ((uint32_t)xpData[3] << 24);
+  messageLen = details >> 24;
+
+  switch (details & KDF_DETAILS_HKDF_MSG_LOC_MASK)
+  {
+    case KDF_DETAILS_HKDF_MSG_LOC_INPUT:
+      pMessage = (xDataLen == (KDF_DETAILS_SIZE + messageLen)) ? &xpData[KDF_DETAILS_SIZE] : NULL;
+      break;
+
+    case KDF_DETAILS_HKDF_MSG_LOC_TEMPKEY:
+      pMessage = (messageLen <= sizeof(gpEmu->device.tempKey.value)) ? lKeyAddress(ATCA_TEMPKEY_KEYID, 0, messageLen) : NULL;
+      break;
+
+    default:
+      /* Slot and IV message locations are not emulated. */
+      break;
+  }
+
+  if (0u != (details & KDF_DETAILS_HKDF_ZERO_KEY))
+  {
+    pKey = aZeroKey;
+  }
+  else
+  {
+    switch (xParam1 & KDF_MODE_SOURCE_MASK)
+    {
+      case KDF_MODE_SOURCE_TEMPKEY:
+        pKey = lKeyAddress(ATCA_TEMPKEY_KEYID, 0, C_EMU_KEY_SIZE);
+        break;
+
+      case KDF_MODE_SOURCE_TEMPKEY_UP:
+        pKey = lKeyAddress(ATCA_TEMPKEY_KEYID, C_EMU_KEY_SIZE, C_EMU_KEY_SIZE);
+        break;
+
+      case KDF_MODE_SOURCE_SLOT:
+        pKey = lKeyAddress(xParam2 & 0x0Fu, 0, C_EMU_KEY_SIZE);
+        break;
+
+      default:
+        pKey = gpEmu->device.aAltKeyBuffer;
+        break;
+    }
+  }
+
+  if ((NULL == pMessage) || (NULL == pKey))
+  {
+    return C_EMU_STATUS_EXECUTION_ERROR;
+  }
+
+  /* HKDF step: HMAC-SHA256 of the message keyed with the source key. */
+  lHmac(pKey, pMessage, messageLen, aResult);
+
+  switch (xParam1 & KDF_MODE_TARGET_MASK)
+  {
+    case KDF_MODE_TARGET_TEMPKEY:
+      lSetTempKey(aResult);
+      break;
+
+    case KDF_MODE_TARGET_TEMPKEY_UP:
+      (void)memcpy(&gpEmu->device.tempKey.value[C_EMU_KEY_SIZE], aResult, sizeof(aResult));
+      break;
+
+    case KDF_MODE_TARGET_SLOT:
+      if (lIsSlotLocked(targetSlot))
+      {
+        return C_EMU_STATUS_EXECUTION_ERROR;
+      }
+      (void)memcpy(&gpEmu->device.nvm.aData[lSlotOffset(targetSlot)], aResult, sizeof(aResult));
+      gpEmu->device.isNvmDirty = true;
+      break;
+
+    case KDF_MODE_TARGET_ALTKEYBUF:
+      (void)memcpy(gpEmu->device.aAltKeyBuffer, aResult, sizeof(aResult));
+      break;
+
+    case KDF_MODE_TARGET_OUTPUT:
+      (void)memcpy(xpOut, aResult, sizeof(aResult));
+      *xpOutLen = sizeof(aResult);
+      break;
+
+    default:
+      /* Encrypted output is not emulated. */
+      return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  (void)memset(aResult, 0, sizeof(aResult));
+  return C_EMU_STATUS_SUCCESS;
+}
+
+/**
+ * @implements lCmdSha
+ *
+ **/
+static uint8_t lCmdSha(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                       size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  uint8_t         aDigest[C_EMU_KEY_SIZE];
+  size_t          digestLen = sizeof(aDigest);
+  const uint8_t*  pKey = NULL;
+  uint8_t         target = xParam1 & SHA_MODE_TARGET_MASK;
+
+  switch (xParam1 & SHA_MODE_MASK)
+  {
+    case SHA_MODE_SHA256_START:
+      (void)atcac_sw_sha2_256_init(&gpEmu->device.shaCtx);
+      gpEmu->device.shaState = E_EMU_SHA_PLAIN;
+      break;
+
+    case SHA_MODE_HMAC_START:
+      /* Param2 is the key: a slot or TempKey. */
+      pKey = lKeyAddress(xParam2, 0, C_EMU_KEY_SIZE);
+      if (NULL == pKey)
+      {
+        return C_EMU_STATUS_EXECUTION_ERROR;
+      }
+      (void)atcac_sha256_hmac_init(&gpEmu->device.hmacCtx, &gpEmu->device.shaCtx, pKey, C_EMU_KEY_SIZE);
+      gpEmu->device.shaState = E_EMU_SHA_HMAC;
+      break;
+
+    case SHA_MODE_SHA256_UPDATE:
+    case SHA_MODE_608_HMAC_END:
+      if (E_EMU_SHA_PLAIN == gpEmu->device.shaState)
+      {
+        (void)atcac_sw_sha2_256_update(&gpEmu->device.shaCtx, xpData, xDataLen);
+      }
+      else if (E_EMU_SHA_HMAC == gpEmu->device.shaState)
+      {
+        (void)atcac_sha256_hmac_update(&gpEmu->device.hmacCtx, xpData, xDataLen);
+      }
+      else
+      {
+        return C_EMU_STATUS_EXECUTION_ERROR;
+      }
+
+      if (SHA_MODE_608_HMAC_END == (xParam1 & SHA_MODE_MASK))
+      {
+        if (E_EMU_SHA_PLAIN == gpEmu->device.shaState)
+        {
+          (void)atcac_sw_sha2_256_finish(&gpEmu->device.shaCtx, aDigest);
+        }
+        else
+        {
+          (void)atcac_sha256_hmac_finish(&gpEmu->device.hmacCtx, aDigest, &digestLen);
+        }
+        gpEmu->device.shaState = E_EMU_SHA_NONE;
+
+        if (C_EMU_SHA_TARGET_TEMPKEY == target)
+        {
+          lSetTempKey(aDigest);
+        }
+        else if (C_EMU_SHA_TARGET_MSGDIGBUF == target)
+        {
+          (void)memcpy(gpEmu->device.aMsgDigestBuffer, aDigest, sizeof(aDigest));
+        }
+        else
+        {
+          /* Output buffer only. */
+        }
+
+        (void)memcpy(xpOut, aDigest, sizeof(aDigest));
+        *xpOutLen = sizeof(aDigest);
+      }
+      break;
+
+    default:
+      /* Public key and context save / restore modes are not emulated. */
+      return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  return C_EMU_STATUS_SUCCESS;
+}
+
+/**
+ * @implements lCmdAes
+ *
+ **/
+static uint8_t lCmdAes(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                       size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  size_t          keyOffset = (size_t)((xParam1 & AES_MODE_KEY_BLOCK_MASK) >> AES_MODE_KEY_BLOCK_POS) *
+                              C_SAL_EMU_AES_BLOCK_SIZE;
+  const uint8_t*  pKey = lKeyAddress(xParam2, keyOffset, C_SAL_EMU_AES_BLOCK_SIZE);
+
+  if ((C_SAL_EMU_AES_BLOCK_SIZE != xDataLen) || (NULL == pKey))
+  {
+    return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  switch (xParam1 & AES_MODE_OP_MASK)
+  {
+    case AES_MODE_ENCRYPT:
+      salEmuAesEncrypt(pKey, xpData, xpOut);
+      break;
+
+    case AES_MODE_DECRYPT:
+      salEmuAesDecrypt(pKey, xpData, xpOut);
+      break;
+
+    default:
+      /* GFM is not emulated. */
+      return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  *xpOutLen = C_SAL_EMU_AES_BLOCK_SIZE;
+  return C_EMU_STATUS_SUCCESS;
+}
+
+/**
+ * @implements lCmdInfo
+ *
+ **/
+static uint8_t lCmdInfo(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                        size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  M_UNUSED(xpData);
+  M_UNUSED(xDataLen);
+
+  (void)memset(xpOut, 0, C_EMU_WORD_SIZE);
+
+  switch (xParam1)
+  {
+    case INFO_MODE_REVISION:
+      (void)memcpy(xpOut, &gpEmu->device.nvm.aConfig[C_EMU_CFG_REVISION], C_EMU_WORD_SIZE);
+      break;
+
+    case INFO_MODE_KEY_VALID:
+      xpOut[0] = (xParam2 < C_EMU_SLOT_COUNT) ? gpEmu->device.nvm.aKeyValid[xParam2] : 0u;
+      break;
+
+    case INFO_MODE_STATE:
+      xpOut[0] = (uint8_t)((gpEmu->device.tempKey.key_id & 0x0Fu) |
+                           ((gpEmu->device.tempKey.source_flag & 0x01u) << 4) |
+                           ((gpEmu->device.tempKey.gen_dig_data & 0x01u) << 5) |
+                           ((gpEmu->device.tempKey.gen_key_data & 0x01u) << 6) |
+                           ((gpEmu->device.tempKey.no_mac_flag & 0x01u) << 7));
+      xpOut[1] = (uint8_t)(gpEmu->device.tempKey.valid & 0x01u);
+      break;
+
+    default:
+      return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  *xpOutLen = C_EMU_WORD_SIZE;
+  return C_EMU_STATUS_SUCCESS;
+}
+
+/**
+ * @implements lCmdLock
+ *
+ **/
+static uint8_t lCmdLock(uint8_t xParam1, uint16_t xParam2, const uint8_t* xpData,
+                        size_t xDataLen, uint8_t* xpOut, size_t* xpOutLen)
+{
+  uint32_t  slot = ((uint32_t)xParam1 >> 2) & 0x0Fu;
+  uint8_t*  pLock = NULL;
+
+  /* The zone summary CRC in Param2 is not checked. */
+  M_UNUSED(xParam2);
+  M_UNUSED(xpData);
+  M_UNUSED(xDataLen);
+  M_UNUSED(xpOut);
+  M_UNUSED(xpOutLen);
+
+  switch (xParam1 & 0x03u)
+  {
+    case LOCK_ZONE_CONFIG:
+      pLock = &gpEmu->device.nvm.aConfig[C_EMU_CFG_LOCK_CONFIG];
+      break;
+
+    case LOCK_ZONE_DATA:
+      pLock = &gpEmu->device.nvm.aConfig[C_EMU_CFG_LOCK_VALUE];
+      break;
+
+    case LOCK_ZONE_DATA_SLOT:
+      if (lIsSlotLocked(slot))
+      {
+        return C_EMU_STATUS_EXECUTION_ERROR;
+      }
+      gpEmu->device.nvm.aConfig[C_EMU_CFG_SLOT_LOCKED + (slot / 8u)] &= (uint8_t)~(1u << (slot % 8u));
+      gpEmu->device.isNvmDirty = true;
+      return C_EMU_STATUS_SUCCESS;
+
+    default:
+      return C_EMU_STATUS_PARSE_ERROR;
+  }
+
+  if (ATCA_LOCKED == *pLock)
+  {
+    return C_EMU_STATUS_EXECUTION_ERROR;
+  }
+
+  *pLock = ATCA_LOCKED;
+  gpEmu->device.isNvmDirty = true;
+
+  return C_EMU_STATUS_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,1110 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  Software crypto primitives for the ATECC608 emulator.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file k_sal_emu_crypto.c
+ ******************************************************************************/
+
+/**
+ * @brief Software crypto primitives for the ATECC608 emulator.
+ *
+ * Host only, not constant time: the implementation favours size and
+ * readability as it only stands in for the secure element during host
+ * testing.
+ */
+
+#include "k_sal_emu_crypto.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include <string.h>
+#include <pthread.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Number of 32 bit words of a P-256 big number. */
+#define C_EMU_BN_WORDS                             (8u)
+
+/** @brief Number of bits of a P-256 big number. */
+#define C_EMU_BN_BITS                              (256u)
+
+/** @brief Number of AES-128 rounds. */
+#define C_EMU_AES_ROUNDS                           (10u)
+
+/** @brief Size of the expanded AES-128 key. */
+#define C_EMU_AES_EXPANDED_KEY_SIZE                (176u)
+
+/** @brief Little endian 256 bit number. */
+typedef uint32_t TBigNum[C_EMU_BN_WORDS];
+
+/** @brief Montgomery modulus context. */
+typedef struct
+{
+  TBigNum   m;
+  /* R^2 mod m, R = 2^256. */
+  TBigNum   rr;
+  /* R mod m, i.e. 1 in the Montgomery domain. */
+  TBigNum   one;
+  /* -m^-1 mod 2^32. */
+  uint32_t  m0inv;
+} TModulus;
+
+/** @brief Jacobian point, coordinates in the Montgomery domain of p. */
+typedef struct
+{
+  TBigNum  x;
+  TBigNum  y;
+  /* z == 0 is the point at infinity. */
+  TBigNum  z;
+} TPoint;
+
+/** @brief P-256 field prime. */
+static const uint8_t gaCurveP[C_SAL_EMU_ECC_SCALAR_SIZE] =
+{
+  0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+/** @brief P-256 group order. */
+static const uint8_t gaCurveN[C_SAL_EMU_ECC_SCALAR_SIZE] =
+{
+  0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51
+};
+
+/** @brief P-256 curve coefficient b. */
+static const uint8_t gaCurveB[C_SAL_EMU_ECC_SCALAR_SIZE] =
+{
+  0x5A, 0xC6, 0x35, 0xD8, 0xAA, 0x3A, 0x93, 0xE7, 0xB3, 0xEB, 0xBD, 0x55, 0x76, 0x98, 0x86, 0xBC,
+  0x65, 0x1D, 0x06, 0xB0, 0xCC, 0x53, 0xB0, 0xF6, 0x3B, 0xCE, 0x3C, 0x3E, 0x27, 0xD2, 0x60, 0x4B
+};
+
+/** @brief P-256 base point. */
+static const uint8_t gaCurveG[C_SAL_EMU_ECC_PUBLIC_KEY_SIZE] =
+{
+  0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2,
+  0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96,
+  0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16,
+  0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5
+};
+
+/** @brief AES forward S-box. */
+static const uint8_t gaAesSbox[256] =
+{
+  0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+  0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+  0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+  0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+  0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+  0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+  0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+  0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+  0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+  0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+  0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+  0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+  0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+  0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+  0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+  0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+/** @brief AES round constants. */
+static const uint8_t gaAesRcon[C_EMU_AES_ROUNDS] =
+{
+  0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36
+};
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Field modulus context. */
+static TModulus gFieldP;
+
+/** @brief Group order modulus context. */
+static TModulus gOrderN;
+
+/** @brief Curve coefficient b in the Montgomery domain. */
+static TBigNum gCurveBMont;
+
+/** @brief Base point. */
+static TPoint gBasePoint;
+
+/** @brief AES inverse S-box, derived from the forward table. */
+static uint8_t gaAesInvSbox[256];
+
+/** @brief Curve constants set up, once for all the threads. */
+static pthread_once_t gCurveOnce = PTHREAD_ONCE_INIT;
+
+/** @brief AES tables set up, once for all the threads. */
+static pthread_once_t gAesOnce = PTHREAD_ONCE_INIT;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Load a big endian 32 byte number. */
+static void lBnFromBytes(uint32_t* xpR, const uint8_t* xpBytes);
+
+/** @brief Store a number as 32 big endian bytes. */
+static void lBnToBytes(uint8_t* xpBytes, const uint32_t* xpA);
+
+/** @brief Return 1 if the number is zero. */
+static int lBnIsZero(const uint32_t* xpA);
+
+/** @brief Compare two numbers, returns -1, 0 or 1. */
+static int lBnCmp(const uint32_t* xpA, const uint32_t* xpB);
+
+/** @brief r = a + b, returns the carry. */
+static uint32_t lBnAdd(uint32_t* xpR, const uint32_t* xpA, const uint32_t* xpB);
+
+/** @brief r = a - b, returns the borrow. */
+static uint32_t lBnSub(uint32_t* xpR, const uint32_t* xpA, const uint32_t* xpB);
+
+/** @brief r = a + b mod m, a and b reduced. */
+static void lModAdd(uint32_t* xpR, const uint32_t* xpA, const uint32_t* xpB, const TModulus* xpMod);
+
+/** @brief r = a - b mod m, a and b reduced. */
+static void lModSub(uint32_t* xpR, const uint32_t* xpA, const uint32_t* xpB, const TModulus* xpMod);
+
+/** @brief Montgomery product r = a.b.R^-1 mod m. */
+static void lMontMul(uint32_t* xpR, const uint32_t* xpA, const uint32_t* xpB, const TModulus* xpMod);
+
+/** @brief Montgomery inversion r = a^(m-2), m prime. */
+static void lMontInv(uint32_t* xpR, const uint32_t* xpA, const TModulus* xpMod);
+
+/** @brief Set up a modulus context. */
+static void lModInit(TModulus* xpMod, const uint8_t* xpModulus);
+
+/** @brief Set up the curve constants once. */
+static void lCurveInit(void);
+
+/** @brief Set up the curve constants, run by lCurveInit(). */
+static void lCurveSetup(void);
+
+/** @brief Load an affine point, returns 0 if it is not on the curve. */
+static int lPointFromBytes(TPoint* xpP, const uint8_t* xpBytes);
+
+/** @brief Store the affine X||Y of a point, returns 0 for infinity. */
+static int lPointToBytes(uint8_t* xpBytes, const TPoint* xpP);
+
+/** @brief R = 2P. */
+static void lPointDouble(TPoint* xpR, const TPoint* xpP);
+
+/** @brief R = P + Q. */
+static void lPointAdd(TPoint* xpR, const TPoint* xpP, const TPoint* xpQ);
+
+/** @brief R = k.P, k is a plain (non Montgomery) scalar. */
+static void lPointMul(TPoint* xpR, const uint32_t* xpK, const TPoint* xpP);
+
+/** @brief Load a scalar, returns 0 if it is not in [1, n-1]. */
+static int lScalarFromBytes(uint32_t* xpK, const uint8_t* xpBytes);
+
+/** @brief Set up the AES tables once. */
+static void lAesInit(void);
+
+/** @brief Set up the AES tables, run by lAesInit(). */
+static void lAesSetup(void);
+
+/** @brief AES-128 key expansion. */
+static void lAesExpandKey(uint8_t* xpRoundKeys, const uint8_t* xpKey);
+
+/** @brief GF(2^8) multiplication. */
+static uint8_t lAesMul(uint8_t xA, uint8_t xB);
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  implement salEmuEccPublicKey
+ *
+ */
+TKStatus salEmuEccPublicKey
+(
+  const uint8_t*  xpPrivateKey,
+  uint8_t*        xpPublicKey
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+  TBigNum   d;
+  TPoint    q;
+
+  lCurveInit();
+
+  if ((NULL != xpPrivateKey) && (NULL != xpPublicKey) &&
+      (0 != lScalarFromBytes(d, xpPrivateKey)))
+  {
+    lPointMul(&q, d, &gBasePoint);
+
+    if (0 != lPointToBytes(xpPublicKey, &q))
+    {
+      status = E_K_STATUS_OK;
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement salEmuEccSign
+ *
+ */
+TKStatus salEmuEccSign
+(
+  const uint8_t*  xpPrivateKey,
+  const uint8_t*  xpDigest,
+  const uint8_t*  xpNonce,
+  uint8_t*        xpSignature
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+  TBigNum   d;
+  TBigNum   k;
+  TBigNum   r;
+  TBigNum   e;
+  TBigNum   s;
+  TBigNum   t;
+  TPoint    kG;
+  uint8_t   aPoint[C_SAL_EMU_ECC_PUBLIC_KEY_SIZE];
+
+  lCurveInit();
+
+  if ((NULL == xpPrivateKey) || (NULL == xpDigest) ||
+      (NULL == xpNonce) || (NULL == xpSignature) ||
+      (0 == lScalarFromBytes(d, xpPrivateKey)) ||
+      (0 == lScalarFromBytes(k, xpNonce)))
+  {
+    return status;
+  }
+
+  lPointMul(&kG, k, &gBasePoint);
+
+  if (0 != lPointToBytes(aPoint, &kG))
+  {
+    /* r = x(kG) mod n, x < p < 2n so one subtraction is enough. */
+    lBnFromBytes(r, aPoint);
+    if (lBnCmp(r, gOrderN.m) >= 0)
+    {
+      (void)lBnSub(r, r, gOrderN.m);
+    }
+
+    lBnFromBytes(e, xpDigest);
+    if (lBnCmp(e, gOrderN.m) >= 0)
+    {
+      (void)lBnSub(e, e, gOrderN.m);
+    }
+
+    if (0 == lBnIsZero(r))
+    {
+      /* s = k^-1 (e + r.d) mod n, computed in the Montgomery domain. */
+      lMontMul(r, r, gOrderN.rr, &gOrderN);
+      lMontMul(d, d, gOrderN.rr, &gOrderN);
+      lMontMul(e, e, gOrderN.rr, &gOrderN);
+      lMontMul(k, k, gOrderN.rr, &gOrderN);
+      lMontMul(t, r, d, &gOrderN);
+      lModAdd(t, t, e, &gOrderN);
+      lMontInv(s, k, &gOrderN);
+      lMontMul(s, s, t, &gOrderN);
+      (void)memset(t, 0, sizeof(t));
+      t[0] = 1;
+      lMontMul(s, s, t, &gOrderN);
+      lMontMul(r, r, t, &gOrderN);
+
+      if (0 == lBnIsZero(s))
+      {
+        lBnToBytes(xpSignature, r);
+        lBnToBytes(&xpSignature[C_SAL_EMU_ECC_SCALAR_SIZE], s);
+        status = E_K_STATUS_OK;
+      }
+    }
+  }
+
+  (void)memset(d, 0, sizeof(d));
+  (void)memset(k, 0, sizeof(k));
+  return status;
+}
+
+/**
+ * @brief  implement salEmuEccSharedSecret
+ *
+ */
+TKStatus salEmuEccSharedSecret
+(
+  const uint8_t*  xpPrivateKey,
+  const uint8_t*  xpPeerPublicKey,
+  uint8_t*        xpSecret
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+  TBigNum   d;
+  TPoint    peer;
+  TPoint    shared;
+  uint8_t   aPoint[C_SAL_EMU_ECC_PUBLIC_KEY_SIZE];
+
+  lCurveInit();
+
+  if ((NULL != xpPrivateKey) && (NULL != xpPeerPublicKey) && (NULL != xpSecret) &&
+      (0 != lScalarFromBytes(d, xpPrivateKey)) &&
+      (0 != lPointFromBytes(&peer, xpPeerPublicKey)))
+  {
+    lPointMul(&shared, d, &peer);
+
+    if (0 != lPointToBytes(aPoint, &shared))
+    {
+      (void)memcpy(xpSecret, aPoint, C_SAL_EMU_ECC_SCALAR_SIZE);
+      status = E_K_STATUS_OK;
+    }
+
+    (void)memset(aPoint, 0, sizeof(aPoint));
+  }
+
+  (void)memset(d, 0, sizeof(d));
+  return status;
+}
+
+/**
+ * @brief  implement salEmuAesEncrypt
+ *
+ */
+void salEmuAesEncrypt
+(
+  const uint8_t*  xpKey,
+  const uint8_t*  xpInput,
+  uint8_t*        xpOutput
+)
+{
+  uint8_t   aRoundKeys[C_EMU_AES_EXPANDED_KEY_SIZE];
+  uint8_t   aState[C_SAL_EMU_AES_BLOCK_SIZE];
+  uint8_t   aTmp[C_SAL_EMU_AES_BLOCK_SIZE];
+  uint32_t  round = 0;
+  uint32_t  i = 0;
+  uint32_t  c = 0;
+
+  lAesInit();
+  lAesExpandKey(aRoundKeys, xpKey);
+
+  for (i = 0; i < C_SAL_EMU_AES_BLOCK_SIZE; i++)
+  {
+    aState[i] = xpInput[i] ^ aRoundKeys[i];
+  }
+
+  for (round = 1; round <= C_EMU_AES_ROUNDS; round++)
+  {
+    /* SubBytes and ShiftRows: row r of column c comes from column c + r. */
+    for (i = 0; i < C_SAL_EMU_AES_BLOCK_SIZE; i++)
+    {
+      aTmp[i] = gaAesSbox[aState[(i + ((i % 4u) * 4u)) % C_SAL_EMU_AES_BLOCK_SIZE]];
+    }
+
+    if (round != C_EMU_AES_ROUNDS)
+    {
+      for (c = 0; c < 4u; c++)
+      {
+        uint8_t* pCol = &aTmp[c * 4u];
+        uint8_t  a0 = pCol[0];
+        uint8_t  a1 = pCol[1];
+        uint8_t  a2 = pCol[2];
+        uint8_t  a3 = pCol[3];
+
+        pCol[0] = (uint8_t)(lAesMul(a0, 2) ^ lAesMul(a1, 3) ^ a2 ^ a3);
+        pCol[1] = (uint8_t)(a0 ^ lAesMul(a1, 2) ^ lAesMul(a2, 3) ^ a3);
+        pCol[2] = (uint8_t)(a0 ^ a1 ^ lAesMul(a2, 2) ^ lAesMul(a3, 3));
+        pCol[3] = (uint8_t)(lAesMul(a0, 3) ^ a1 ^ a2 ^ lAesMul(a3, 2));
+      }
+    }
+
+    for (i = 0; i < C_SAL_EMU_AES_BLOCK_SIZE; i++)
+    {
+      aState[i] = aTmp[i] ^ aRoundKeys[(round * C_SAL_EMU_AES_BLOCK_SIZE) + i];
+    }
+  }
+
+  (void)memcpy(xpOutput, aState, C_SAL_EMU_AES_BLOCK_SIZE);
+  (void)memset(aRoundKeys, 0, sizeof(aRoundKeys));
+}
+
+/**
+ * @brief  implement salEmuAesDecrypt
+ *
+ */
+void salEmuAesDecrypt
+(
+  const uint8_t*  xpKey,
+  const uint8_t*  xpInput,
+  uint8_t*        xpOutput
+)
+{
+  uint8_t   aRoundKeys[C_EMU_AES_EXPANDED_KEY_SIZE];
+  uint8_t   aState[C_SAL_EMU_AES_BLOCK_SIZE];
+  uint8_t   aTmp[C_SAL_EMU_AES_BLOCK_SIZE];
+  uint32_t  round = 0;
+  uint32_t  i = 0;
+  uint32_t  c = 0;
+
+  lAesInit();
+  lAesExpandKey(aRoundKeys, xpKey);
+
+  for (i = 0; i < C_SAL_EMU_AES_BLOCK_SIZE; i++)
+  {
+    aState[i] = xpInput[i] ^ aRoundKeys[(C_EMU_AES_ROUNDS * C_SAL_EMU_AES_BLOCK_SIZE) + i];
+  }
+
+  for (round = C_EMU_AES_ROUNDS; round > 0u; round--)
+  {
+    /* InvShiftRows and InvSubBytes: row r of column c goes to column c + r. */
+    for (i = 0; i < C_SAL_EMU_AES_BLOCK_SIZE; i++)
+    {
+      aTmp[(i + ((i % 4u) * 4u)) % C_SAL_EMU_AES_BLOCK_SIZE] = gaAesInvSbox[aState[i]];
+    }
+
+    for (i = 0; i < C_SAL_EMU_AES_BLOCK_SIZE; i++)
+    {
+      aTmp[i] ^= aRoundKeys[((round - 1u) * C_SAL_EMU_AES_BLOCK_SIZE) + i];
+    }
+
+    if (round != 1u)
+    {
+      for (c = 0; c < 4u; c++)
+      {
+        uint8_t* pCol = &aTmp[c * 4u];
+        uint8_t  a0 = pCol[0];
+        uint8_t  a1 = pCol[1];
+        uint8_t  a2 = pCol[2];
+        uint8_t  a3 = pCol[3];
+
+        pCol[0] = (uint8_t)(lAesMul(a0, 14) ^ lAesMul(a1, 11) ^ lAesMul(a2, 13) ^ lAesMul(a3, 9));
+        pCol[1] = (uint8_t)(lAesMul(a0, 9) ^ lAesMul(a1, 14) ^ lAesMul(a2, 11) ^ lAesMul(a3, 13));
+        pCol[2] = (uint8_t)(lAesMul(a0, 13) ^ lAesMul(a1, 9) ^ lAesMul(a2, 14) ^ lAesMul(a3, 11));
+        pCol[3] = (uint8_t)(lAesMul(a0, 11) ^ lAesMul(a1, 13) ^ lAesMul(a2, 9) ^ lAesMul(a3, 14));
+      }
+    }
+
+    (void)memcpy(aState, aTmp, C_SAL_EMU_AES_BLOCK_SIZE);
+  }
+
+  (void)memcpy(xpOutput, aState, C_SAL_EMU_AES_BLOCK_SIZE);
+  (void)memset(aRoundKeys, 0, sizeof(aRoundKeys));
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @implements lBnFromBytes
+ *
+ **/
+static void lBnFromBytes(uint32_t* xpR, const uint8_t* xpBytes)
+{
+  uint32_t i = 0;
+
+  for (i = 0; i < C_EMU_BN_WORDS; i++)
+  {
+    const uint8_t* pWord = &xpBytes[(C_EMU_BN_WORDS - 1u - i) * 4u];
+
+    xpR[i] = ((uint32_t)pWord[0] << 24) | ((uint32_t)pWord[1] << 16) |
+             ((uint32_t)pWord[2] << 8) | (uint32_t)pWord[3];
+  }
+}
+
+/**
+ * @implements lBnToBytes
+ *
+ **/
+static void lBnToBytes(uint8_t* xpBytes, const uint32_t* xpA)
+{
+  uint32_t i = 0;
+
+  for (i = 0; i < C_EMU_BN_WORDS; i++)
+  {
+    uint8_t* pWord = &xpBytes[(C_EMU_BN_WORDS - 1u - i) * 4u];
+
+    pWord[0] = (uint8_t)(xpA[i] >> 24);
+    pWord[1] = (uint8_t)(xpA[i] >> 16);
+    pWord[2] = (uint8_t)(xpA[i] >> 8);
+    pWord[3] = (uint8_t)xpA[i];
+  }
+}
+
+/**
+ * @implements lBnIsZero
+ *
+ **/
+static int lBnIsZero(const uint32_t* xpA)
+{
+  uint32_t acc = 0;
+  uint32_t i = 0;
+
+  for (i = 0; i < C_EMU_BN_WORDS; i++)
+  {
+    acc |= xpA[i];
+  }
+
+  return (0u == acc) ? 1 : 0;
+}
+
+/**
+ * @implements lBnCmp
+ *
+ **/
+static int lBnCmp(const uint32_t* xpA, const uint32_t* xpB)
+{
+  uint32_t i = C_EMU_BN_WORDS;
+
+  while (i > 0u)
+  {
+    i--;
+    if (xpA[i] != xpB[i])
+    {
+      return (xpA[i] > xpB[i]) ? 1 : -1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @implements lBnAdd
+ *
+ **/
+static uint32_t lBnAdd(uint32_t* xpR, const uint32_t* xpA, const uint32_t* xpB)
+{
+  uint64_t acc = 0;
+  uint32_t i = 0;
+
+  for (i = 0; i < C_EMU_BN_WORDS; i++)
+  {
+    acc += (uint64_t)xpA[i] + xpB[i];
+    xpR[i] = (uint32_t)acc;
+    acc >>= 32;
+  }
+
+  return (uint32_t)acc;
+}
+
+/**
+ * @implements lBnSub
+ *
+ **/
+static uint32_t lBnSub(uint32_t* xpR, const uint32_t* xpA, const uint32_t* xpB)
+{
+  uint64_t diff = 0;
+  uint32_t borrow = 0;
+  uint32_t i = 0;
+
+  for (i = 0; i < C_EMU_BN_WORDS; i++)
+  {
+    diff = (uint64_t)xpA[i] - xpB[i] - borrow;
+    xpR[i] = (uint32_t)diff;
+    borrow = (uint32_t)(diff >> 63);
+  }
+
+  return borrow;
+}
+
+/**
+ * @implements lModAdd
+ *
+ **/
+static void lModAdd(uint32_t* xpR, const uint32_t* xpA, const uint32_t* xpB, const TModulus* xpMod)
+{
+  if ((0u != lBnAdd(xpR, xpA, xpB)) || (lBnCmp(xpR, xpMod->m) >= 0))
+  {
+    (void)lBnSub(xpR, xpR, xpMod->m);
+  }
+}
+
+/**
+ * @implements lModSub
+ *
+ **/
+static void lModSub(uint32_t* xpR, const uint32_t* xpA, const uint32_t* xpB, const TModulus* xpMod)
+{
+  if (0u != lBnSub(xpR, xpA, xpB))
+  {
+    (void)lBnAdd(xpR, xpR, xpMod->m);
+  }
+}
+
+/**
+ * @implements lMontMul
+ *
+ **/
+static void lMontMul(uint32_t* xpR, const uint32_t* xpA, const uint32_t* xpB, const TModulus* xpMod)
+{
+  uint32_t t[C_EMU_BN_WORDS + 2u] = {0};
+  uint64_t acc = 0;
+  uint32_t q = 0;
+  uint32_t i = 0;
+  uint32_t j = 0;
+
+  /* Coarsely integrated operand scanning. */
+  for (i = 0; i < C_EMU_BN_WORDS; i++)
+  {
+    acc = 0;
+    for (j = 0; j < C_EMU_BN_WORDS; j++)
+    {
+      acc = (uint64_t)t[j] + ((uint64_t)xpA[j] * xpB[i]) + (acc >> 32);
+      t[j] = (uint32_t)acc;
+    }
+    acc = (uint64_t)t[C_EMU_BN_WORDS] + (acc >> 32);
+    t[C_EMU_BN_WORDS] = (uint32_t)acc;
+    t[C_EMU_BN_WORDS + 1u] = (uint32_t)(acc >> 32);
+
+    q = t[0] * xpMod->m0inv;
+    acc = (uint64_t)t[0] + ((uint64_t)q * xpMod->m[0]);
+    for (j = 1; j < C_EMU_BN_WORDS; j++)
+    {
+      acc = (uint64_t)t[j] + ((uint64_t)q * xpMod->m[j]) + (acc >> 32);
+      t[j - 1u] = (uint32_t)acc;
+    }
+    acc = (uint64_t)t[C_EMU_BN_WORDS] + (acc >> 32);
+    t[C_EMU_BN_WORDS - 1u] = (uint32_t)acc;
+    t[C_EMU_BN_WORDS] = t[C_EMU_BN_WORDS + 1u] + (uint32_t)(acc >> 32);
+  }
+
+  if ((0u != t[C_EMU_BN_WORDS]) || (lBnCmp(t, xpMod->m) >= 0))
+  {
+    (void)lBnSub(t, t, xpMod->m);
+  }
+
+  (void)memcpy(xpR, t, sizeof(TBigNum));
+}
+
+/**
+ * @implements lMontInv
+ *
+ **/
+static void lMontInv(uint32_t* xpR, const uint32_t* xpA, const TModulus* xpMod)
+{
+  TBigNum   exponent;
+  TBigNum   two = {2u};
+  TBigNum   result;
+  TBigNum   base;
+  uint32_t  bit = C_EMU_BN_BITS;
+
+  (void)lBnSub(exponent, xpMod->m, two);
+  (void)memcpy(result, xpMod->one, sizeof(TBigNum));
+  (void)memcpy(base, xpA, sizeof(TBigNum));
+
+  while (bit > 0u)
+  {
+    bit--;
+    lMontMul(result, result, result, xpMod);
+    if (0u != ((exponent[bit / 32u] >> (bit % 32u)) & 1u))
+    {
+      lMontMul(result, result, base, xpMod);
+    }
+  }
+
+  (void)memcpy(xpR, result, sizeof(TBigNum));
+}
+
+/**
+ * @implements lModInit
+ *
+ **/
+static void lModInit(TModulus* xpMod, const uint8_t* xpModulus)
+{
+  uint32_t inv = 1;
+  uint32_t i = 0;
+
+  lBnFromBytes(xpMod->m, xpModulus);
+
+  /* Newton iteration, each step doubles the number of correct low bits. */
+  for (i = 0; i < 5u; i++)
+  {
+    inv *= 2u - (xpMod->m[0] * inv);
+  }
+  xpMod->m0inv = 0u - inv;
+
+  (void)memset(xpMod->one, 0, sizeof(TBigNum));
+  xpMod->one[0] = 1;
+  for (i = 0; i < C_EMU_BN_BITS; i++)
+  {
+    lModAdd(xpMod->one, xpMod->one, xpMod->one, xpMod);
+  }
+
+  (void)memcpy(xpMod->rr, xpMod->one, sizeof(TBigNum));
+  for (i = 0; i < C_EMU_BN_BITS; i++)
+  {
+    lModAdd(xpMod->rr, xpMod->rr, xpMod->rr, xpMod);
+  }
+}
+
+/**
+ * @implements lCurveInit
+ *
+ **/
+static void lCurveInit(void)
+{
+  (void)pthread_once(&gCurveOnce, lCurveSetup);
+}
+
+/**
+ * @implements lCurveSetup
+ *
+ **/
+static void lCurveSetup(void)
+{
+  lModInit(&gFieldP, gaCurveP);
+  lModInit(&gOrderN, gaCurveN);
+  lBnFromBytes(gCurveBMont, gaCurveB);
+  lMontMul(gCurveBMont, gCurveBMont, gFieldP.rr, &gFieldP);
+  (void)lPointFromBytes(&gBasePoint, gaCurveG);
+}
+
+/**
+ * @implements lPointFromBytes
+ *
+ **/
+static int lPointFromBytes(TPoint* xpP, const uint8_t* xpBytes)
+{
+  TBigNum lhs;
+  TBigNum rhs;
+  TBigNum t;
+
+  lBnFromBytes(xpP->x, xpBytes);
+  lBnFromBytes(xpP->y, &xpBytes[C_SAL_EMU_ECC_SCALAR_SIZE]);
+
+  if ((lBnCmp(xpP->x, gFieldP.m) >= 0) || (lBnCmp(xpP->y, gFieldP.m) >= 0))
+  {
+    return 0;
+  }
+
+  lMontMul(xpP->x, xpP->x, gFieldP.rr, &gFieldP);
+  lMontMul(xpP->y, xpP->y, gFieldP.rr, &gFieldP);
+  (void)memcpy(xpP->z, gFieldP.one, sizeof(TBigNum));
+
+  /* y^2 == x^3 - 3x + b */
+  lMontMul(lhs, xpP->y, xpP->y, &gFieldP);
+  lMontMul(rhs, xpP->x, xpP->x, &gFieldP);
+  lMontMul(rhs, rhs, xpP->x, &gFieldP);
+  lModAdd(t, xpP->x, xpP->x, &gFieldP);
+  lModAdd(t, t, xpP->x, &gFieldP);
+  lModSub(rhs, rhs, t, &gFieldP);
+  lModAdd(rhs, rhs, gCurveBMont, &gFieldP);
+
+  return (0 == lBnCmp(lhs, rhs)) ? 1 : 0;
+}
+
+/**
+ * @implements lPointToBytes
+ *
+ **/
+static int lPointToBytes(uint8_t* xpBytes, const TPoint* xpP)
+{
+  TBigNum zInv;
+  TBigNum zInv2;
+  TBigNum coord;
+  TBigNum one = {1u};
+
+  if (0 != lBnIsZero(xpP->z))
+  {
+    return 0;
+  }
+
+  lMontInv(zInv, xpP->z, &gFieldP);
+  lMontMul(zInv2, zInv, zInv, &gFieldP);
+
+  lMontMul(coord, xpP->x, zInv2, &gFieldP);
+  lMontMul(coord, coord, one, &gFieldP);
+  lBnToBytes(xpBytes, coord);
+
+  lMontMul(zInv2, zInv2, zInv, &gFieldP);
+  lMontMul(coord, xpP->y, zInv2, &gFieldP);
+  lMontMul(coord, coord, one, &gFieldP);
+  lBnToBytes(&xpBytes[C_SAL_EMU_ECC_SCALAR_SIZE], coord);
+
+  return 1;
+}
+
+/**
+ * @implements lPointDouble
+ *
+ **/
+static void lPointDouble(TPoint* xpR, const TPoint* xpP)
+{
+  TBigNum delta;
+  TBigNum gamma;
+  TBigNum beta;
+  TBigNum alpha;
+  TBigNum t1;
+  TBigNum t2;
+  TPoint  r;
+
+  if ((0 != lBnIsZero(xpP->z)) || (0 != lBnIsZero(xpP->y)))
+  {
+    (void)memset(xpR, 0, sizeof(TPoint));
+    return;
+  }
+
+  /* dbl-2001-b, a = -3. */
+  lMontMul(delta, xpP->z, xpP->z, &gFieldP);
+  lMontMul(gamma, xpP->y, xpP->y, &gFieldP);
+  lMontMul(beta, xpP->x, gamma, &gFieldP);
+
+  lModSub(t1, xpP->x, delta, &gFieldP);
+  lModAdd(t2, xpP->x, delta, &gFieldP);
+  lMontMul(t1, t1, t2, &gFieldP);
+  lModAdd(alpha, t1, t1, &gFieldP);
+  lModAdd(alpha, alpha, t1, &gFieldP);
+
+  /* X3 = alpha^2 - 8.beta */
+  lModAdd(t1, beta, beta, &gFieldP);
+  lModAdd(t1, t1, t1, &gFieldP);
+  lModAdd(t2, t1, t1, &gFieldP);
+  lMontMul(r.x, alpha, alpha, &gFieldP);
+  lModSub(r.x, r.x, t2, &gFieldP);
+
+  /* Z3 = (Y + Z)^2 - gamma - delta */
+  lModAdd(r.z, xpP->y, xpP->z, &gFieldP);
+  lMontMul(r.z, r.z, r.z, &gFieldP);
+  lModSub(r.z, r.z, gamma, &gFieldP);
+  lModSub(r.z, r.z, delta, &gFieldP);
+
+  /* Y3 = alpha.(4.beta - X3) - 8.gamma^2 */
+  lModSub(t1, t1, r.x, &gFieldP);
+  lMontMul(r.y, alpha, t1, &gFieldP);
+  lMontMul(t2, gamma, gamma, &gFieldP);
+  lModAdd(t2, t2, t2, &gFieldP);
+  lModAdd(t2, t2, t2, &gFieldP);
+  lModAdd(t2, t2, t2, &gFieldP);
+  lModSub(r.y, r.y, t2, &gFieldP);
+
+  (void)memcpy(xpR, &r, sizeof(TPoint));
+}
+
+/**
+ * @implements lPointAdd
+ *
+ **/
+static void lPointAdd(TPoint* xpR, const TPoint* xpP, const TPoint* xpQ)
+{
+  TBigNum z1z1;
+  TBigNum z2z2;
+  TBigNum u1;
+  TBigNum u2;
+  TBigNum s1;
+  TBigNum s2;
+  TBigNum h;
+  TBigNum hh;
+  TBigNum hhh;
+  TBigNum rr;
+  TBigNum v;
+  TPoint  r;
+
+  if (0 != lBnIsZero(xpP->z))
+  {
+    (void)memcpy(xpR, xpQ, sizeof(TPoint));
+    return;
+  }
+
+  if (0 != lBnIsZero(xpQ->z))
+  {
+    (void)memcpy(xpR, xpP, sizeof(TPoint));
+    return;
+  }
+
+  /* add-2007-bl without the 2x factors. */
+  lMontMul(z1z1, xpP->z, xpP->z, &gFieldP);
+  lMontMul(z2z2, xpQ->z, xpQ->z, &gFieldP);
+  lMontMul(u1, xpP->x, z2z2, &gFieldP);
+  lMontMul(u2, xpQ->x, z1z1, &gFieldP);
+  lMontMul(s1, xpP->y, xpQ->z, &gFieldP);
+  lMontMul(s1, s1, z2z2, &gFieldP);
+  lMontMul(s2, xpQ->y, xpP->z, &gFieldP);
+  lMontMul(s2, s2, z1z1, &gFieldP);
+  lModSub(h, u2, u1, &gFieldP);
+  lModSub(rr, s2, s1, &gFieldP);
+
+  if (0 != lBnIsZero(h))
+  {
+    if (0 != lBnIsZero(rr))
+    {
+      lPointDouble(xpR, xpP);
+    }
+    else
+    {
+      (void)memset(xpR, 0, sizeof(TPoint));
+    }
+    return;
+  }
+
+  lMontMul(hh, h, h, &gFieldP);
+  lMontMul(hhh, h, hh, &gFieldP);
+  lMontMul(v, u1, hh, &gFieldP);
+
+  /* X3 = r^2 - H^3 - 2.V */
+  lMontMul(r.x, rr, rr, &gFieldP);
+  lModSub(r.x, r.x, hhh, &gFieldP);
+  lModSub(r.x, r.x, v, &gFieldP);
+  lModSub(r.x, r.x, v, &gFieldP);
+
+  /* Y3 = r.(V - X3) - S1.H^3 */
+  lModSub(v, v, r.x, &gFieldP);
+  lMontMul(r.y, rr, v, &gFieldP);
+  lMontMul(s1, s1, hhh, &gFieldP);
+  lModSub(r.y, r.y, s1, &gFieldP);
+
+  /* Z3 = Z1.Z2.H */
+  lMontMul(r.z, xpP->z, xpQ->z, &gFieldP);
+  lMontMul(r.z, r.z, h, &gFieldP);
+
+  (void)memcpy(xpR, &r, sizeof(TPoint));
+}
+
+/**
+ * @implements lPointMul
+ *
+ **/
+static void lPointMul(TPoint* xpR, const uint32_t* xpK, const TPoint* xpP)
+{
+  TPoint    acc;
+  uint32_t  bit = C_EMU_BN_BITS;
+
+  (void)memset(&acc, 0, sizeof(acc));
+
+  while (bit > 0u)
+  {
+    bit--;
+    lPointDouble(&acc, &acc);
+    if (0u != ((xpK[bit / 32u] >> (bit % 32u)) & 1u))
+    {
+      lPointAdd(&acc, &acc, xpP);
+    }
+  }
+
+  (void)memcpy(xpR, &acc, sizeof(TPoint));
+}
+
+/**
+ * @implements lScalarFromBytes
+ *
+ **/
+static int lScalarFromBytes(uint32_t* xpK, const uint8_t* xpBytes)
+{
+  lBnFromBytes(xpK, xpBytes);
+
+  return ((0 == lBnIsZero(xpK)) && (lBnCmp(xpK, gOrderN.m) < 0)) ? 1 : 0;
+}
+
+/**
+ * @implements lAesInit
+ *
+ **/
+static void lAesInit(void)
+{
+  (void)pthread_once(&gAesOnce, lAesSetup);
+}
+
+/**
+ * @implements lAesSetup
+ *
+ **/
+static void lAesSetup(void)
+{
+  uint32_t i = 0;
+
+  for (i = 0; i < 256u; i++)
+  {
+    gaAesInvSbox[gaAesSbox[i]] = (uint8_t)i;
+  }
+}
+
+/**
+ * @implements lAesExpandKey
+ *
+ **/
+static void lAesExpandKey(uint8_t* xpRoundKeys, const uint8_t* xpKey)
+{
+  uint8_t   aWord[4];
+  uint8_t   first = 0;
+  uint32_t  i = 0;
+  uint32_t  j = 0;
+
+  (void)memcpy(xpRoundKeys, xpKey, C_SAL_EMU_AES_BLOCK_SIZE);
+
+  for (i = 4; i < (4u * (C_EMU_AES_ROUNDS + 1u)); i++)
+  {
+    (void)memcpy(aWord, &xpRoundKeys[(i - 1u) * 4u], sizeof(aWord));
+
+    if (0u == (i % 4u))
+    {
+      /* RotWord, SubWord and Rcon. */
+      first = aWord[0];
+      aWord[0] = (uint8_t)(gaAesSbox[aWord[1]] ^ gaAesRcon[(i / 4u) - 1u]);
+      aWord[1] = gaAesSbox[aWord[2]];
+      aWord[2] = gaAesSbox[aWord[3]];
+      aWord[3] = gaAesSbox[first];
+    }
+
+    for (j = 0; j < 4u; j++)
+    {
+      xpRoundKeys[(i * 4u) + j] = xpRoundKeys[((i - 4u) * 4u) + j] ^ aWord[j];
+    }
+  }
+}
+
+/**
+ * @implements lAesMul
+ *
+ **/
+static uint8_t lAesMul(uint8_t xA, uint8_t xB)
+{
+  uint8_t result = 0;
+  uint8_t a = xA;
+  uint8_t b = xB;
+
+  while (0u != b)
+  {
+    if (0u != (b & 1u))
+    {
+      result ^= a;
+    }
+    a = (uint8_t)((a << 1) ^ ((0u != (a & 0x80u)) ? 0x1Bu : 0x00u));
+    b >>= 1;
+  }
+
+  return result;
+}
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
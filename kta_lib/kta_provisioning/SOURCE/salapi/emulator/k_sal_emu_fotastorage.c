@@ -0,0 +1,578 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  Emulated FOTA store for host builds.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file k_sal_emu_fotastorage.c
+ ******************************************************************************/
+
+/**
+ * @brief Emulated FOTA store for host builds.
+ */
+
+#include "k_sal_emu_fotastorage.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "KTALog.h"
+
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Number of component records. */
+#define C_EMU_FOTA_COMPONENT_COUNT                 (8u)
+
+/** @brief Number of records: name, metadata, commit, components and journal. */
+#define C_EMU_FOTA_RECORD_COUNT                    (3u + C_EMU_FOTA_COMPONENT_COUNT + FOTA_JOURNAL_ENTRY_COUNT)
+
+/** @brief Record header: length and its complement, little endian. */
+#define C_EMU_FOTA_HEADER_SIZE                     (4u)
+
+/** @brief Smallest page size in bytes. */
+#define C_EMU_FOTA_PAGE_SIZE_MIN                   (16u)
+
+/** @brief Value of an erased byte. */
+#define C_EMU_FOTA_ERASED                          (0xFFu)
+
+/** @brief Record area of the store. */
+typedef struct
+{
+  uint32_t  id;
+  /* Largest record size, without the header. */
+  size_t    capacity;
+} TEmuFotaRecord;
+
+/** @brief Emulated store. */
+typedef struct
+{
+  TKSalEmuFotaConfig  config;
+  /* Flash image: the file mapping or gaEmuFotaRam. */
+  uint8_t*            pImage;
+  size_t              size;
+  bool                isMapped;
+  bool                isPowerOff;
+  uint32_t            powerCutCountdown;
+  /* Offset of each record area in the image. */
+  size_t              aOffset[C_EMU_FOTA_RECORD_COUNT];
+} TEmuFotaStore;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_009 : misra_c2012_rule_5.9_violation
+ * The identifier gpModuleName is intentionally defined as a common global for logging purposes
+ */
+#if LOG_KTA_ENABLE != C_KTA_LOG_LEVEL_NONE
+static const char* gpModuleName = "SALEMUFOTA";
+#endif
+
+/** @brief Record areas, in image order. */
+static const TEmuFotaRecord gaEmuFotaRecord[C_EMU_FOTA_RECORD_COUNT] =
+{
+  {FOTA_STORAGE_NAME_ID,          sizeof(TFotaNameRecord)},
+  {FOTA_STORAGE_METADATA_ID,      sizeof(TFotaMetadataRecord)},
+  {FOTA_STORAGE_COMMIT_ID,        sizeof(TFotaCommitRecord)},
+  {FOTA_STORAGE_COMPONENT_ID(0),  sizeof(TFotaComponentRecord)},
+  {FOTA_STORAGE_COMPONENT_ID(1),  sizeof(TFotaComponentRecord)},
+  {FOTA_STORAGE_COMPONENT_ID(2),  sizeof(TFotaComponentRecord)},
+  {FOTA_STORAGE_COMPONENT_ID(3),  sizeof(TFotaComponentRecord)},
+  {FOTA_STORAGE_COMPONENT_ID(4),  sizeof(TFotaComponentRecord)},
+  {FOTA_STORAGE_COMPONENT_ID(5),  sizeof(TFotaComponentRecord)},
+  {FOTA_STORAGE_COMPONENT_ID(6),  sizeof(TFotaComponentRecord)},
+  {FOTA_STORAGE_COMPONENT_ID(7),  sizeof(TFotaComponentRecord)},
+  {FOTA_STORAGE_JOURNAL_ID(0),    sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(1),    sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(2),    sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(3),    sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(4),    sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(5),    sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(6),    sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(7),    sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(8),    sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(9),    sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(10),   sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(11),   sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(12),   sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(13),   sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(14),   sizeof(TFotaJournalEntry)},
+  {FOTA_STORAGE_JOURNAL_ID(15),   sizeof(TFotaJournalEntry)}
+};
+
+/** @brief Emulated store. */
+static TEmuFotaStore gEmuFota;
+
+/** @brief Emulated store statistics. */
+static TKSalEmuFotaStats gEmuFotaStats;
+
+/** @brief Flash image of a store kept in RAM only. */
+static uint8_t gaEmuFotaRam[C_SAL_EMU_FOTA_STORE_MAX_SIZE];
+
+/** @brief Page being programmed. */
+static uint8_t gaEmuFotaPage[C_SAL_EMU_FOTA_PAGE_SIZE_MAX];
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Index of the record area of an ID, C_EMU_FOTA_RECORD_COUNT if none. */
+static size_t lRecordIndex(uint32_t xStorageDataId);
+
+/** @brief Map the storage file, create an erased image when missing. */
+static TKStatus lMap(void);
+
+/** @brief Copy the part of [xAt, xAt + xLength) falling in the page being programmed. */
+static void lOverlay(size_t xPageStart, size_t xAt, const uint8_t* xpSrc, size_t xLength);
+
+/** @brief Erase and program a page from gaEmuFotaPage, false on power cut. */
+static bool lProgramPage(size_t xPage, size_t xFrom, size_t xTo);
+
+/** @brief Account the read of the pages covering [xAt, xAt + xLength). */
+static void lReadPages(size_t xAt, size_t xLength);
+
+/** @brief Account modeled time, optionally spending it for real. */
+static void lSpendTime(uint64_t xTimeUs);
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  implement salEmuFotaInit
+ *
+ */
+K_SAL_API TKStatus salEmuFotaInit
+(
+  const TKSalEmuFotaConfig*  xpConfig
+)
+{
+  TKStatus  status = E_K_STATUS_OK;
+  size_t    pageSize = 0;
+  size_t    offset = 0;
+  size_t    i = 0;
+
+  M_KTALOG__START("Start");
+
+  (void)salEmuFotaTerm();
+  (void)memset(&gEmuFota, 0, sizeof(gEmuFota));
+  (void)memset(&gEmuFotaStats, 0, sizeof(gEmuFotaStats));
+
+  if (NULL != xpConfig)
+  {
+    gEmuFota.config = *xpConfig;
+  }
+  if (0u == gEmuFota.config.pageSize)
+  {
+    gEmuFota.config.pageSize = C_SAL_EMU_FOTA_PAGE_SIZE_DEFAULT;
+  }
+  pageSize = gEmuFota.config.pageSize;
+
+  for (i = 0; i < C_EMU_FOTA_RECORD_COUNT; i++)
+  {
+    if (gEmuFota.config.isPageAligned)
+    {
+      offset = ((offset + pageSize - 1u) / pageSize) * pageSize;
+    }
+    gEmuFota.aOffset[i] = offset;
+    offset += C_EMU_FOTA_HEADER_SIZE + gaEmuFotaRecord[i].capacity;
+  }
+  gEmuFota.size = ((offset + pageSize - 1u) / pageSize) * pageSize;
+  gEmuFotaStats.pageCount = (uint32_t)(gEmuFota.size / pageSize);
+
+  if ((pageSize < C_EMU_FOTA_PAGE_SIZE_MIN) || (pageSize > C_SAL_EMU_FOTA_PAGE_SIZE_MAX) ||
+      (gEmuFotaStats.pageCount > C_SAL_EMU_FOTA_PAGE_MAX) ||
+      (gEmuFota.size > C_SAL_EMU_FOTA_STORE_MAX_SIZE))
+  {
+    M_KTALOG__ERR("Layout of %u bytes does not fit pages of %u bytes",
+                  (unsigned int)offset, (unsigned int)pageSize);
+    status = E_K_STATUS_PARAMETER;
+  }
+  else if (NULL != gEmuFota.config.pStoragePath)
+  {
+    status = lMap();
+  }
+  else
+  {
+    (void)memset(gaEmuFotaRam, C_EMU_FOTA_ERASED, gEmuFota.size);
+    gEmuFota.pImage = gaEmuFotaRam;
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief  implement salEmuFotaSetPowerCut
+ *
+ */
+K_SAL_API void salEmuFotaSetPowerCut
+(
+  uint32_t  xPageWriteCount
+)
+{
+  gEmuFota.powerCutCountdown = xPageWriteCount;
+}
+
+/**
+ * @brief  implement salEmuFotaGetStats
+ *
+ */
+K_SAL_API TKStatus salEmuFotaGetStats
+(
+  TKSalEmuFotaStats*  xpStats
+)
+{
+  TKStatus status = E_K_STATUS_PARAMETER;
+
+  if (NULL != xpStats)
+  {
+    *xpStats = gEmuFotaStats;
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement salEmuFotaResetStats
+ *
+ */
+K_SAL_API void salEmuFotaResetStats
+(
+  void
+)
+{
+  uint32_t pageCount = gEmuFotaStats.pageCount;
+
+  (void)memset(&gEmuFotaStats, 0, sizeof(gEmuFotaStats));
+  gEmuFotaStats.pageCount = pageCount;
+}
+
+/**
+ * @brief  implement salEmuFotaTerm
+ *
+ */
+K_SAL_API TKStatus salEmuFotaTerm
+(
+  void
+)
+{
+  TKStatus status = E_K_STATUS_OK;
+
+  if (gEmuFota.isMapped)
+  {
+    if (0 != msync(gEmuFota.pImage, gEmuFota.size, MS_SYNC))
+    {
+      status = E_K_STATUS_ERROR;
+    }
+    (void)munmap(gEmuFota.pImage, gEmuFota.size);
+    gEmuFota.isMapped = false;
+  }
+  gEmuFota.pImage = NULL;
+
+  return status;
+}
+
+/**
+ * @brief  implement salFotaStorageWrite
+ *
+ */
+bool salFotaStorageWrite
+(
+  uint32_t        xStorageDataId,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+)
+{
+  bool     isWritten = false;
+  size_t   index = lRecordIndex(xStorageDataId);
+  size_t   pageSize = gEmuFota.config.pageSize;
+  uint8_t  aHeader[C_EMU_FOTA_HEADER_SIZE] = {0};
+  size_t   start = 0;
+  size_t   end = 0;
+  size_t   page = 0;
+  size_t   pageStart = 0;
+  size_t   from = 0;
+  size_t   to = 0;
+
+  gEmuFotaStats.writeCount++;
+
+  if ((NULL != gEmuFota.pImage) && (!gEmuFota.isPowerOff) &&
+      (C_EMU_FOTA_RECORD_COUNT != index) && (NULL != xpData) &&
+      (xDataLen <= gaEmuFotaRecord[index].capacity))
+  {
+    aHeader[0] = (uint8_t)xDataLen;
+    aHeader[1] = (uint8_t)(xDataLen >> 8);
+    aHeader[2] = (uint8_t)~aHeader[0];
+    aHeader[3] = (uint8_t)~aHeader[1];
+    start = gEmuFota.aOffset[index];
+    end = start + C_EMU_FOTA_HEADER_SIZE + xDataLen;
+    isWritten = true;
+
+    /* Read, erase and program every page of the record, neighbours included. */
+    for (page = start / pageSize; isWritten && (page <= ((end - 1u) / pageSize)); page++)
+    {
+      pageStart = page * pageSize;
+      from = ((start > pageStart) ? start : pageStart) - pageStart;
+      to = ((end < (pageStart + pageSize)) ? end : (pageStart + pageSize)) - pageStart;
+      (void)memcpy(gaEmuFotaPage, &gEmuFota.pImage[pageStart], pageSize);
+      lOverlay(pageStart, start, aHeader, C_EMU_FOTA_HEADER_SIZE);
+      lOverlay(pageStart, start + C_EMU_FOTA_HEADER_SIZE, xpData, xDataLen);
+      isWritten = lProgramPage(page, from, to);
+    }
+  }
+
+  if (!isWritten)
+  {
+    M_KTALOG__ERR("Record 0x%04X not written", (unsigned int)xStorageDataId);
+    gEmuFotaStats.errorCount++;
+  }
+
+  return isWritten;
+}
+
+/**
+ * @brief  implement salFotaStorageRead
+ *
+ */
+bool salFotaStorageRead
+(
+  uint32_t  xStorageDataId,
+  uint8_t*  xpData,
+  size_t*   xpDataLen
+)
+{
+  bool            isRead = false;
+  size_t          index = lRecordIndex(xStorageDataId);
+  const uint8_t*  pArea = NULL;
+  size_t          length = 0;
+
+  gEmuFotaStats.readCount++;
+
+  if ((NULL != gEmuFota.pImage) && (!gEmuFota.isPowerOff) &&
+      (C_EMU_FOTA_RECORD_COUNT != index) && (NULL != xpData) && (NULL != xpDataLen))
+  {
+    pArea = &gEmuFota.pImage[gEmuFota.aOffset[index]];
+    length = (size_t)pArea[0] | ((size_t)pArea[1] << 8);
+
+    /* An erased or torn header reads as a missing record. */
+    if ((0xFFu == (uint8_t)(pArea[0] ^ pArea[2])) && (0xFFu == (uint8_t)(pArea[1] ^ pArea[3])) &&
+        (length <= gaEmuFotaRecord[index].capacity) && (length <= *xpDataLen))
+    {
+      lReadPages(gEmuFota.aOffset[index], C_EMU_FOTA_HEADER_SIZE + length);
+      (void)memcpy(xpData, &pArea[C_EMU_FOTA_HEADER_SIZE], length);
+      *xpDataLen = length;
+      isRead = true;
+    }
+    else
+    {
+      lReadPages(gEmuFota.aOffset[index], C_EMU_FOTA_HEADER_SIZE);
+    }
+  }
+
+  if (!isRead)
+  {
+    gEmuFotaStats.errorCount++;
+  }
+
+  return isRead;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @implements lRecordIndex
+ *
+ **/
+static size_t lRecordIndex(uint32_t xStorageDataId)
+{
+  size_t index = 0;
+
+  while ((index < C_EMU_FOTA_RECORD_COUNT) && (gaEmuFotaRecord[index].id != xStorageDataId))
+  {
+    index++;
+  }
+
+  return index;
+}
+
+/**
+ * @implements lMap
+ *
+ **/
+static TKStatus lMap(void)
+{
+  TKStatus     status = E_K_STATUS_ERROR;
+  struct stat  fileStat;
+  int          fd = -1;
+  bool         isNew = false;
+  void*        pMap = MAP_FAILED;
+
+  fd = open(gEmuFota.config.pStoragePath, O_RDWR | O_CREAT, 0600);
+  if (fd < 0)
+  {
+    M_KTALOG__ERR("Cannot open %s", gEmuFota.config.pStoragePath);
+    return E_K_STATUS_ERROR;
+  }
+
+  if (0 == fstat(fd, &fileStat))
+  {
+    isNew = (0 == fileStat.st_size);
+    if ((!isNew) && ((size_t)fileStat.st_size != gEmuFota.size))
+    {
+      M_KTALOG__ERR("Image %s does not match the layout", gEmuFota.config.pStoragePath);
+      status = E_K_STATUS_DATA;
+    }
+    else if ((!isNew) || (0 == ftruncate(fd, (off_t)gEmuFota.size)))
+    {
+      pMap = mmap(NULL, gEmuFota.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    else
+    {
+      /* ftruncate() failed. */
+    }
+  }
+  (void)close(fd);
+
+  if (MAP_FAILED != pMap)
+  {
+    gEmuFota.pImage = (uint8_t*)pMap;
+    gEmuFota.isMapped = true;
+    if (isNew)
+    {
+      (void)memset(gEmuFota.pImage, C_EMU_FOTA_ERASED, gEmuFota.size);
+    }
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @implements lOverlay
+ *
+ **/
+static void lOverlay(size_t xPageStart, size_t xAt, const uint8_t* xpSrc, size_t xLength)
+{
+  size_t pageEnd = xPageStart + gEmuFota.config.pageSize;
+  size_t from = (xAt > xPageStart) ? xAt : xPageStart;
+  size_t to = ((xAt + xLength) < pageEnd) ? (xAt + xLength) : pageEnd;
+
+  if (from < to)
+  {
+    (void)memcpy(&gaEmuFotaPage[from - xPageStart], &xpSrc[from - xAt], to - from);
+  }
+}
+
+/**
+ * @implements lProgramPage
+ *
+ **/
+static bool lProgramPage(size_t xPage, size_t xFrom, size_t xTo)
+{
+  size_t    pageSize = gEmuFota.config.pageSize;
+  uint8_t*  pPage = &gEmuFota.pImage[xPage * pageSize];
+  bool      isProgrammed = true;
+
+  gEmuFotaStats.pageWriteCount++;
+  gEmuFotaStats.aPageWriteCount[xPage]++;
+  lSpendTime(gEmuFota.config.pageWriteTimeUs);
+
+  (void)memset(pPage, C_EMU_FOTA_ERASED, pageSize);
+  if (0u != gEmuFota.powerCutCountdown)
+  {
+    gEmuFota.powerCutCountdown--;
+    if (0u == gEmuFota.powerCutCountdown)
+    {
+      /* Power lost half way through the record bytes [xFrom, xTo) of the page. */
+      (void)memcpy(pPage, gaEmuFotaPage, xFrom + ((xTo - xFrom) / 2u));
+      M_KTALOG__INFO("Power cut while programming page %u", (unsigned int)xPage);
+      gEmuFota.isPowerOff = true;
+      gEmuFotaStats.powerCutCount++;
+      isProgrammed = false;
+    }
+  }
+
+  if (isProgrammed)
+  {
+    (void)memcpy(pPage, gaEmuFotaPage, pageSize);
+  }
+
+  return isProgrammed;
+}
+
+/**
+ * @implements lReadPages
+ *
+ **/
+static void lReadPages(size_t xAt, size_t xLength)
+{
+  size_t pageSize = gEmuFota.config.pageSize;
+  size_t pageCount = (((xAt + xLength) - 1u) / pageSize) - (xAt / pageSize) + 1u;
+
+  gEmuFotaStats.pageReadCount += (uint32_t)pageCount;
+  lSpendTime((uint64_t)pageCount * gEmuFota.config.pageReadTimeUs);
+}
+
+/**
+ * @implements lSpendTime
+ *
+ **/
+static void lSpendTime(uint64_t xTimeUs)
+{
+  struct timespec delay;
+
+  gEmuFotaStats.emulatedTimeUs += xTimeUs;
+
+  if (gEmuFota.config.isRealTimeDelay && (0u != xTimeUs))
+  {
+    delay.tv_sec = (time_t)(xTimeUs / 1000000u);
+    delay.tv_nsec = (long)((xTimeUs % 1000000u) * 1000u);
+    (void)nanosleep(&delay, NULL);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
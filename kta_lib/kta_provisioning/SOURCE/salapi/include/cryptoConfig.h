@@ -183,9 +183,13 @@
 #ifdef FOTA_ENABLE
 /** @brief Vendor specific maximum buffer size for ICPP messages when FOTA is enabled. */
 #define C_K__ICPP_MSG_MAX_SIZE    (2000u)
+/** @brief Vendor specific ktaExchangeMessageEx() workspace size when FOTA is enabled. */
+#define C_K__KTA_WORKSPACE_SIZE   (10240u)
 #else
 /** @brief Vendor specific maximum buffer size for ICPP messages when FOTA is disabled. */
 #define C_K__ICPP_MSG_MAX_SIZE    (1400u)
+/** @brief Vendor specific ktaExchangeMessageEx() workspace size when FOTA is disabled. */
+#define C_K__KTA_WORKSPACE_SIZE   (5632u)
 #endif
 
 /** @brief Vendor specific chip certificate size. */
@@ -0,0 +1,168 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  Interface for SAL context operation.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file k_sal_context.h
+ ******************************************************************************/
+
+/**
+ * @brief Interface for SAL context operation.
+ */
+
+#ifndef K_SAL_CONTEXT_H
+#define K_SAL_CONTEXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/** @defgroup g_sal_api SAL Interface */
+
+/** @addtogroup g_sal_api
+ * @{
+*/
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "k_defs.h"
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                     */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Storage reserved for the state of the storage SAL, in bytes. */
+#define C_K_SAL__CONTEXT_STORAGE_SIZE  (640u)
+
+/** @brief Storage reserved for the state of the RoT SAL, in bytes. */
+#define C_K_SAL__CONTEXT_ROT_SIZE      (384u)
+
+/** @brief Storage reserved for the state of the object SAL, in bytes. */
+#define C_K_SAL__CONTEXT_OBJECT_SIZE   (8u)
+
+/**
+ * @brief
+ *   SAL state of one secure element, provided by the application.
+ *   Its content is private to the SAL.
+ */
+typedef struct
+{
+  void*     pDevice;
+  /* Secure element of the context, NULL for the device selected by the application. */
+  uint64_t  aStorage[(C_K_SAL__CONTEXT_STORAGE_SIZE + 7u) / 8u];
+  /* State of the storage SAL. */
+  uint64_t  aRot[(C_K_SAL__CONTEXT_ROT_SIZE + 7u) / 8u];
+  /* State of the RoT SAL. */
+  uint64_t  aObject[(C_K_SAL__CONTEXT_OBJECT_SIZE + 7u) / 8u];
+  /* State of the object SAL. */
+} TKSalContext;
+
+/* -------------------------------------------------------------------------- */
+/* VARIABLES                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief
+ *   Reset a SAL context to its power-on state: empty storage shadow, no open
+ *   storage transaction and no cached chip identity.
+ *
+ * @param[out] xpContext
+ *   Context storage. Should not be NULL.
+ * @param[in] xpDevice
+ *   Platform device handle (ATCADevice), as created by the application.
+ *   NULL serves the device selected by the application (atcab_init()).
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ */
+K_SAL_API TKStatus salContextInit
+(
+  TKSalContext*  xpContext,
+  void*          xpDevice
+);
+
+/**
+ * @brief
+ *   Select the context served by the next SAL calls of the calling thread.
+ *   Each thread starts on the built-in context. A context must not be bound
+ *   by two threads at the same time.
+ *
+ * @param[in] xpContext
+ *   Context initialized with salContextInit(), NULL for the built-in one.
+ */
+K_SAL_API void salContextBind
+(
+  TKSalContext*  xpContext
+);
+
+/**
+ * @brief
+ *   Get the context bound by the calling thread.
+ *
+ * @return
+ *   Bound context, never NULL.
+ */
+K_SAL_API TKSalContext* salContextGet
+(
+  void
+);
+
+/**
+ * @brief
+ *   Get the secure element of the context bound by the calling thread.
+ *
+ * @return
+ *   Device handle (ATCADevice) of the context, else the device selected by
+ *   the application.
+ */
+K_SAL_API void* salContextGetDevice
+(
+  void
+);
+
+/** @} g_sal_api */
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+#endif // K_SAL_CONTEXT_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -160,6 +160,44 @@ K_SAL_API TKStatus salCryptoAesEnc
   size_t*         xpOutputDataLen
 );
 
+/**
+ * @brief
+ *   Encrypt data in place based on AES-128 CBC and compute HMAC SHA256 of the header followed
+ *   by the encrypted data, in a single pass: each encrypted block is fed to the HMAC as soon
+ *   as it is ready. The whole run is done in one Root of Trust session.
+ *   The keys are always located inside the secure platform and addressed by an identifier.
+ *
+ * @param[in] xEncKeyId
+ *   Encryption key identifier.
+ * @param[in] xMacKeyId
+ *   MAC key identifier.
+ * @param[in,out] xpData
+ *   [in] Header followed by the plain data. Should not be NULL.
+ *   [out] Header followed by the encrypted data.
+ * @param[in] xHeaderLen
+ *   Length of the header, authenticated but not encrypted.
+ * @param[in] xDataLen
+ *   Length of the data to encrypt, multiple of the AES block size.
+ * @param[out] xpMac
+ *   Computed MAC: pointer to buffer. Should not be NULL.
+ *   Length is fixed to 16-Bytes(C_K_KTA__HMAC_MAX_SIZE),
+ *   truncated to keep the 16 most significant bytes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salCryptoAesEncHmac
+(
+  uint32_t        xEncKeyId,
+  uint32_t        xMacKeyId,
+  uint8_t*        xpData,
+  size_t          xHeaderLen,
+  size_t          xDataLen,
+  uint8_t*        xpMac
+);
+
 /**
  * @brief
  *   Generic function to decrypt data based on AES-128 CBC.
@@ -67,7 +67,7 @@ extern "C" {
 /** @brief FOTA metadata ID. */
 #define FOTA_STORAGE_METADATA_ID                                                   (0x2003u)
 
-/** @brief FOTA commit flag ID - used to validate campaign completion */
+/** @brief FOTA commit flag ID - campaigns recorded before the journal, read only */
 #define FOTA_STORAGE_COMMIT_ID                                                     (0x2005u)
 
 /** @brief Magic number for validating FOTA component records */
@@ -107,7 +107,7 @@ typedef struct {
     uint32_t crc32;            // CRC32 checksum of record (magic through metadata)
 } TFotaMetadataRecord;
 
-/** @brief FOTA commit record - written LAST to indicate campaign completion */
+/** @brief FOTA commit record - campaign completion before the journal, read only */
 typedef struct {
     uint32_t magic;            // Magic number for validity check (0xF07AC0DE)
     uint8_t  commitFlag;       // 0xAA = valid/complete, 0xFF = invalid/incomplete
@@ -135,6 +135,47 @@ typedef struct {
 #define FOTA_STORAGE_COMPONENT_ID_BASE                                             (0x2010u)
 #define FOTA_STORAGE_COMPONENT_ID(index)                                           (FOTA_STORAGE_COMPONENT_ID_BASE + (index))
 
+/**
+ * @brief FOTA journal IDs (indexed 0-15) - ring of small state change entries.
+ *
+ * The component records are written once per campaign; the state changes that
+ * follow are appended to the journal, entry n going to
+ * FOTA_STORAGE_JOURNAL_ID(n % FOTA_JOURNAL_ENTRY_COUNT). Each ID is written
+ * once per lap of the ring, which spreads the wear over the whole region.
+ */
+#define FOTA_STORAGE_JOURNAL_ID_BASE                                               (0x2020u)
+#define FOTA_STORAGE_JOURNAL_ID(index)                                             (FOTA_STORAGE_JOURNAL_ID_BASE + (index))
+
+/**
+ * @brief Number of entries of the FOTA journal ring.
+ *
+ * Trade-off: the journal saves the per-change record rewrites only. The
+ * campaign start still writes the name, metadata and component records, so a
+ * whole campaign takes about 30% fewer page writes, not an order of magnitude
+ * fewer. In exchange, boot reads all FOTA_JOURNAL_ENTRY_COUNT slots where it
+ * used to read one commit record. A larger ring spreads the wear further and
+ * copies live entries less often, but makes boot read more slots.
+ */
+#define FOTA_JOURNAL_ENTRY_COUNT                                                   (16u)
+
+/** @brief Journal entry types */
+#define FOTA_JOURNAL_BASE                                                          (0x01u)  // Campaign start, or the copy of the campaign state moved by compaction
+#define FOTA_JOURNAL_CAMPAIGN                                                      (0x02u)  // Campaign state change
+#define FOTA_JOURNAL_COMPONENT                                                     (0x03u)  // Component state and version change
+
+/** @brief FOTA journal entry with CRC protection */
+typedef struct {
+    uint32_t sequence;         // Append order, starts at 1; the highest valid one is the journal head
+    uint32_t campaign;         // Sequence of the BASE entry that started the campaign
+    uint32_t baseCrc;          // CRC32 of the campaign name, component names and URLs
+    uint8_t  type;             // FOTA_JOURNAL_BASE, FOTA_JOURNAL_CAMPAIGN or FOTA_JOURNAL_COMPONENT
+    uint8_t  index;            // Component index, or mask of the campaign components for BASE and CAMPAIGN
+    uint8_t  state;            // Component TFotaState, or campaign state for BASE and CAMPAIGN
+    uint8_t  componentVersionLen;
+    uint8_t  componentVersion[16];
+    uint32_t crc32;            // CRC32 checksum of entry (sequence through componentVersion)
+} TFotaJournalEntry;
+
 
 
 /* -------------------------------------------------------------------------- */
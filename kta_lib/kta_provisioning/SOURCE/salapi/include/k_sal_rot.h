@@ -62,6 +62,57 @@ extern "C" {
 /* -------------------------------------------------------------------------- */
 /* CONSTANTS, TYPES, ENUM                                                     */
 /* -------------------------------------------------------------------------- */
+/**
+ * @brief Default time a session keeps the secure element awake before it is
+ * put to idle, in milliseconds.
+ *
+ * The ATECC608 watchdog puts the device to sleep, losing TempKey, 1.3 s
+ * (tWATCHDOG, -10 % worst case) after it woke up; idle stops it. A session only
+ * skips the idle and wake of a command while the device has been awake for
+ * less than this timeout on the host clock, so the command must end before
+ * the watchdog: 500 ms leaves more than 600 ms for the longest command
+ * (GenKey and Sign, 115 ms) plus its polling and the host delays.
+ */
+#ifndef C_K_KTA__ROT_SESSION_IDLE_TIMEOUT_MS
+#define C_K_KTA__ROT_SESSION_IDLE_TIMEOUT_MS  (500u)
+#endif
+
+/** @brief Size of the storage of a secure element session, in bytes. */
+#define C_K_KTA__ROT_SESSION_SIZE             (256u)
+
+/**
+ * @brief Host clock of a secure element session: milliseconds elapsed since an
+ * arbitrary origin, monotonic, wrapping around at 2^32.
+ */
+typedef uint32_t (*TKSalRotClock)(void);
+
+/** @brief Counters of the secure element sessions. */
+typedef struct
+{
+  uint32_t  sessionCount;
+  /* Outermost sessions ended. */
+  uint32_t  commandCount;
+  /* Commands sent to the device. */
+  uint32_t  wakeCount;
+  /* Wake requests sent to the device. */
+  uint32_t  wakeSkippedCount;
+  /* Wake requests answered without a pulse, the device being awake. */
+  uint32_t  idleCount;
+  /* Idle requests sent to the device. */
+  uint32_t  idleSkippedCount;
+  /* Idle requests dropped to keep the device awake. */
+  uint32_t  idleTimeoutCount;
+  /* Idle requests sent before a command, the idle timeout being reached. */
+} TKSalRotSessionStats;
+
+/**
+ * @brief Storage of a secure element session, opaque to the caller.
+ * Initialized by salRotSessionInit(), must outlive the device using it.
+ */
+typedef struct
+{
+  uint64_t  aOpaque[(C_K_KTA__ROT_SESSION_SIZE + 7u) / 8u];
+} TKSalRotSession;
 
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
@@ -223,6 +274,139 @@ K_SAL_API TKStatus salRotGetChipUID
   size_t*   xpChipUidLen
 );
 
+/**
+ * @brief
+ *   Initialize a secure element session on the interface of a device.
+ *   Sessions plug into cryptoauthlib through its public HAL hooks: the
+ *   application calls this function before atcab_init(), then initializes the
+ *   device with the interface configuration of the session:
+ *
+ *     salRotSessionInit(&session, &ifaceCfg, C_K_KTA__ROT_SESSION_IDLE_TIMEOUT_MS, clock);
+ *     atcab_init(salRotSessionGetIfaceCfg(&session));
+ *
+ *   A device served through a SAL context (salContextInit()) is created with
+ *   newATCADevice(salRotSessionGetIfaceCfg(&session)) instead. Sessions are
+ *   registered for the whole program: initialize them before the threads
+ *   serving the devices start.
+ *
+ *   An I2C interface gets a HAL registered with hal_iface_register_hal() in
+ *   front of the I2C HAL, a custom interface (ATCA_CUSTOM_IFACE) gets its
+ *   callbacks wrapped in the session configuration. A device initialized
+ *   otherwise runs every command as outside a session.
+ *
+ * @param[out] xpSession
+ *   Session to initialize. Should not be NULL.
+ * @param[in] xpIfaceCfg
+ *   Interface configuration of the device (ATCAIfaceCfg), copied into the
+ *   session. Should not be NULL.
+ * @param[in] xIdleTimeoutMs
+ *   How long the session keeps the device awake before putting it to idle, in
+ *   milliseconds. Must leave the longest command room before the watchdog of
+ *   the device. Usually C_K_KTA__ROT_SESSION_IDLE_TIMEOUT_MS.
+ * @param[in] xpClock
+ *   Host clock. Without one (NULL) or with a 0 timeout, every idle request
+ *   goes through, as outside a session.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_K_STATUS_NOT_SUPPORTED if the interface is neither I2C nor custom.
+ * - E_K_STATUS_ERROR if the session HAL could not be registered.
+ */
+K_SAL_API TKStatus salRotSessionInit
+(
+  TKSalRotSession*  xpSession,
+  void*             xpIfaceCfg,
+  uint32_t          xIdleTimeoutMs,
+  TKSalRotClock     xpClock
+);
+
+/**
+ * @brief
+ *   Get the interface configuration to initialize the device of a session with.
+ *
+ * @param[in] xpSession
+ *   Session initialized by salRotSessionInit().
+ *
+ * @return
+ * - Interface configuration (ATCAIfaceCfg) for atcab_init(), NULL if
+ *   xpSession is NULL.
+ */
+K_SAL_API void* salRotSessionGetIfaceCfg
+(
+  TKSalRotSession*  xpSession
+);
+
+/**
+ * @brief
+ *   Begin a burst of Root of Trust calls on the bound device.
+ *   Until the matching salRotSessionEnd(), the secure element stays awake between
+ *   commands, keeping TempKey. Once it has been awake for the idle timeout, it
+ *   is put to idle, which keeps TempKey and stops the watchdog, before the next
+ *   command wakes it again. Sessions nest; only the outermost one takes effect.
+ *   The multi-block AES and HMAC calls of the crypto SAL open their own session.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_NOT_SUPPORTED if the bound device was not initialized with the
+ *   interface of a session, commands then run as outside a session.
+ */
+K_SAL_API TKStatus salRotSessionBegin
+(
+  void
+);
+
+/**
+ * @brief
+ *   End a burst of Root of Trust calls started by salRotSessionBegin().
+ *   The outermost end puts the device to idle and traces its wake counters.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_NOT_SUPPORTED if the bound device was not initialized with the
+ *   interface of a session.
+ * - E_K_STATUS_STATE if no session is open on the bound device.
+ * - E_K_STATUS_ERROR if the device could not be put to idle.
+ */
+K_SAL_API TKStatus salRotSessionEnd
+(
+  void
+);
+
+/**
+ * @brief
+ *   Get the counters of a secure element session.
+ *
+ * @param[in] xpSession
+ *   Session initialized by salRotSessionInit(). Should not be NULL.
+ * @param[out] xpStats
+ *   Counters since salRotSessionInit(). Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ */
+K_SAL_API TKStatus salRotSessionGetStats
+(
+  const TKSalRotSession*  xpSession,
+  TKSalRotSessionStats*   xpStats
+);
+
+/**
+ * @brief
+ *   Forget the chip UID and chip certificate kept in RAM. The next
+ *   salRotGetChipUID() and salRotGetChipCertificate() read them from the device.
+ *   Called on refurbish; a change of selected device invalidates them as well.
+ *   Applies to the SAL context bound by the calling thread.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ */
+K_SAL_API TKStatus salRotInvalidateIdentity
+(
+  void
+);
+
 /**
  * @brief
  *   Get chip UID. Chip Platform writes chip_uid which can have a chip specific format and length.
@@ -230,6 +414,7 @@ K_SAL_API TKStatus salRotGetChipUID
  * @param[out] xpChipCert
  *   Address of buffer where the device platform will write the chip certificate.
  *   MAX = 256 Bytes(C_K_KTA__CHIP_CERT_MAX_SIZE). Should not be NULL.
+ *   Built once, then copied from RAM until salRotInvalidateIdentity().
  * @param[in,out] xpChipCertLen
  *   [in] Length of xpChipCert buffer.
  *   [out] Length of filled output data.
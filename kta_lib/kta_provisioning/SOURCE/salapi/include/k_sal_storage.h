@@ -64,6 +64,20 @@ extern "C" {
 /* -------------------------------------------------------------------------- */
 /* CONSTANTS, TYPES, ENUM                                                     */
 /* -------------------------------------------------------------------------- */
+/** @brief Counters of the storage record shadow. */
+typedef struct
+{
+  uint32_t  hitCount;
+  /* Record reads served from RAM. */
+  uint32_t  missCount;
+  /* Record reads that went to the secure element. */
+  uint32_t  deferredWriteCount;
+  /* Record writes kept in RAM until the next flush. */
+  uint32_t  flushWriteCount;
+  /* Records written to the secure element by flushes. */
+  uint32_t  blockWriteCount;
+  /* Block writes merging the pending records of a block. */
+} TKSalStorageCacheStats;
 
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
@@ -147,6 +161,104 @@ K_SAL_API TKStatus salStorageGetValue
   size_t*   xpDataLen
 );
 
+/**
+ * @brief
+ *   Write the pending record updates to the secure element.
+ *   Commit point of the writes deferred by salStorageSetValue(). Inside a
+ *   transaction the updates stay staged until the outermost salStorageCommit().
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors, the failed records stay pending.
+ */
+K_SAL_API TKStatus salStorageFlush
+(
+  void
+);
+
+/**
+ * @brief
+ *   Open a storage transaction: the following salStorageSetValue() and
+ *   salStorageFlush() calls only stage the record updates. Transactions nest.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ */
+K_SAL_API TKStatus salStorageBegin
+(
+  void
+);
+
+/**
+ * @brief
+ *   Close a storage transaction. The outermost one writes the staged updates,
+ *   merged block by block; the block holding the lifecycle state is written
+ *   last, in one write, together with the commit marker. When other blocks
+ *   are written, the commit marker first announces their records.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors, the failed records stay pending.
+ */
+K_SAL_API TKStatus salStorageCommit
+(
+  void
+);
+
+/**
+ * @brief
+ *   Boot time recovery check: verify the commit marker against the lifecycle
+ *   state, ROT public UID and key set ID it covers. The block read also fills
+ *   the RAM copies of these records.
+ *   A commit interrupted before that block was written is rolled back: the
+ *   block still holds the last committed state, and the records the commit
+ *   announced are cleared. A blank or legacy RFU word in place of the marker
+ *   means no commit pending.
+ *
+ * @param[out] xpIsCommitComplete
+ *   1 if the last commit completed or none was recorded, 0 if it was
+ *   interrupted. Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salStorageCheck
+(
+  uint8_t*  xpIsCommitComplete
+);
+
+/**
+ * @brief
+ *   Flush, then drop the RAM copies of the records so that the next reads
+ *   come from the secure element, e.g. after a refurbish or a tamper check.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR if the flush failed, the pending records are kept.
+ */
+K_SAL_API TKStatus salStorageInvalidate
+(
+  void
+);
+
+/**
+ * @brief
+ *   Get the counters of the storage record shadow.
+ *
+ * @param[out] xpStats
+ *   Counters since power-on. Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ */
+K_SAL_API TKStatus salStorageGetCacheStats
+(
+  TKSalStorageCacheStats*  xpStats
+);
+
 /** @} g_sal_api */
 
 #ifdef __cplusplus
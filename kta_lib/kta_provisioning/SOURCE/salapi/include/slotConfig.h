@@ -124,7 +124,9 @@
  * | (write granularity  |          |
  * |  is 4-Bytes)  1||3  |          |
  * +---------------------+----------+
- * |  RFU 16             |          |
+ * | commit marker       |  4       |
+ * +---------------------+----------+
+ * |  RFU 12             |          |
  * +---------------------+----------+
  * | Signer id ||padding | 4 || 28   |
  * | (write granularity  |          |
@@ -163,6 +165,19 @@
 /** @brief L1 Key Material data storage offset. */
 #define C_KTA__L1_KEY_DATA_STORAGE_OFFSET          (C_KTA__BLOCK_OFFSET_3)
 
+/**
+ * @brief
+ * Commit marker - digest of the words before it in the block, written
+ * together with them by each storage commit. While a commit writes other
+ * blocks of the slot, it holds the mask of the records being written.
+ */
+/** @brief Commit marker storage slot. */
+#define C_KTA__COMMIT_MARKER_STORAGE_SLOT          (0x08u)
+/** @brief Commit marker storage block. */
+#define C_KTA__COMMIT_MARKER_STORAGE_BLOCK         (C_KTA__SLOT_BLOCK_0)
+/** @brief Commit marker storage offset. */
+#define C_KTA__COMMIT_MARKER_STORAGE_OFFSET        (C_KTA__BLOCK_OFFSET_4)
+
 /** @brief KTA Version storage slot. */
 #define C_KTA__VERSION_STORAGE_SLOT                (0x08u)
 /** @brief KTA Version storage block. */
@@ -0,0 +1,146 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  SAL context for microchip.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file k_sal_context.c
+ ******************************************************************************/
+
+/**
+ * @brief SAL context for microchip.
+ */
+
+#include "k_sal_context.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+
+#include "atca_basic.h"
+
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+/* Context of the application device, served until a thread binds another one. */
+static TKSalContext gSalContext;
+
+/* Context bound by the calling thread. */
+static K_THREAD_LOCAL TKSalContext* gpSalContext = &gSalContext;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief implement salContextInit
+ *
+ */
+K_SAL_API TKStatus salContextInit
+(
+  TKSalContext*  xpContext,
+  void*          xpDevice
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+
+  if (NULL != xpContext)
+  {
+    /* All the module states start zeroed. */
+    (void)memset(xpContext, 0, sizeof(TKSalContext));
+    xpContext->pDevice = xpDevice;
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @brief implement salContextBind
+ *
+ */
+K_SAL_API void salContextBind
+(
+  TKSalContext*  xpContext
+)
+{
+  gpSalContext = (NULL == xpContext) ? &gSalContext : xpContext;
+}
+
+/**
+ * @brief implement salContextGet
+ *
+ */
+K_SAL_API TKSalContext* salContextGet
+(
+  void
+)
+{
+  return gpSalContext;
+}
+
+/**
+ * @brief implement salContextGetDevice
+ *
+ */
+K_SAL_API void* salContextGetDevice
+(
+  void
+)
+{
+  void*  pDevice = gpSalContext->pDevice;
+
+  if (NULL == pDevice)
+  {
+    pDevice = atcab_get_device();
+  }
+
+  return pDevice;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
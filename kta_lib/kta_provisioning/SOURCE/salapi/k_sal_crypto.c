@@ -44,6 +44,8 @@
 
 #include "k_defs.h"
 #include "k_sal.h"
+#include "k_sal_rot.h"
+#include "k_sal_context.h"
 #include "k_sal_storage.h"
 #include "slotConfig.h"
 #include "KTALog.h"
@@ -113,6 +115,10 @@
 #define C_SAL_CRYPTO_RANDOM_VALUE_OFFSET              (C_SAL_CRYPTO_CHIP_CERT_SIGN_OFFSET \
                                                        + C_SAL_CRYPTO_SIGNATURE_KEY_LENGTH)
 
+/** @brief Chip certificate length. */
+#define C_SAL_CRYPTO_CHIP_CERT_LENGTH                 (C_SAL_CRYPTO_RANDOM_VALUE_OFFSET \
+                                                       + C_SAL_CRYPTO_KEY_SIZE_32_BYTE)
+
 /** @brief IV to perform encryption. */
 #define C_SAL_CRYPTO_IV                               {0xA9, 0x32, 0x30, 0x31, \
     0x38, 0x4E, 0x61, 0x67, \
@@ -141,6 +147,92 @@ typedef struct
   /* Data mapped to object ID */
 } TKSalObjectIdMap;
 
+/** @brief Word address of an idle request. */
+#define C_SAL_CRYPTO_WORD_ADDRESS_IDLE                (0x02u)
+
+/** @brief Word address of a sleep request. */
+#define C_SAL_CRYPTO_WORD_ADDRESS_SLEEP               (0x01u)
+
+/** @brief Word address of a command packet. */
+#define C_SAL_CRYPTO_WORD_ADDRESS_COMMAND             (0x03u)
+
+/** @brief Answer of the device to a wake pulse. */
+#define C_SAL_CRYPTO_WAKE_ANSWER                      {0x04u, 0x11u, 0x33u, 0x43u}
+
+/**
+ * @brief Secure element session, stored in a TKSalRotSession. The device is
+ * initialized with the session configuration, so that its HAL calls go
+ * through the session: while the device has been awake for less than the idle
+ * timeout, the idle request cryptoauthlib sends after each command is dropped
+ * and the wake pulse of the next command is answered without waking the device.
+ */
+typedef struct SKSalRotSessionInfo
+{
+  ATCAIfaceCfg          cfg;
+  /* Configuration served to cryptoauthlib, a copy of the one of the application
+     with the session callbacks for a custom interface. */
+  ATCAIfaceCfg*         pIfaceCfg;
+  /* Configuration of the application, holding the custom callbacks. */
+  TKSalRotClock         pClock;
+  /* Host clock, NULL if none. */
+  uint32_t              idleTimeoutMs;
+  /* Awake time before an idle request goes through, 0 disables the session. */
+  uint32_t              wakeTimeMs;
+  /* Host time of the last wake of the device. */
+  uint32_t              depth;
+  /* Nesting level of salRotSessionBegin(). */
+  bool                  isAwake;
+  /* Device believed to be awake. */
+  bool                  isWakeAnswerPending;
+  /* Next receive returns the wake answer of a dropped wake pulse. */
+  bool                  isWakeForwarded;
+  /* Next receive reads the answer of the device to a wake pulse. */
+  TKSalRotSessionStats  stats;
+  /* Counters since salRotSessionInit(). */
+  struct SKSalRotSessionInfo*  pNext;
+  /* Next initialized session. */
+} TKSalRotSessionInfo;
+
+/** @brief Does not compile if C_K_KTA__ROT_SESSION_SIZE cannot hold a session. */
+typedef uint8_t TKSalRotSessionSizeCheck
+[(C_K_KTA__ROT_SESSION_SIZE >= sizeof(TKSalRotSessionInfo)) ? 1 : -1];
+
+/**
+ * @brief Chip identity read from the secure element, served from RAM until
+ * invalidated or until another device is selected.
+ */
+typedef struct
+{
+  ATCADevice  device;
+  /* Device the identity was read from, NULL if none. */
+  uint8_t     aChipUid[ATCA_SERIAL_NUM_SIZE];
+  /* Serial number of the device. */
+  bool        isChipUidValid;
+  /* aChipUid holds the serial number of device. */
+  uint8_t     aChipCert[C_SAL_CRYPTO_CHIP_CERT_LENGTH];
+  /* Chip certificate attesting the key of the chip SK slot. */
+  bool        isChipCertValid;
+  /* aChipCert holds the certificate of device. */
+} TKSalRotIdentity;
+
+/** @brief Number of entries of the object Id map. */
+#define C_SAL_CRYPTO_OBJECT_ID_MAP_COUNT              (4u)
+
+/** @brief RoT state of a SAL context, zeroed at power-on. */
+typedef struct
+{
+  TKSalRotIdentity  identity;
+  /* Chip identity of the device of the context. */
+  uint8_t           aaObjectIdData[C_SAL_CRYPTO_OBJECT_ID_MAP_COUNT][C_SAL_CRYPTO_KEY_SIZE_32_BYTE];
+  /* Data set for each entry of gaSalObjectIdMapTable. */
+  uint8_t           objectIdSetMask;
+  /* Entries of gaSalObjectIdMapTable set so far, one bit each. */
+} TKSalRotState;
+
+/** @brief Does not compile if C_K_SAL__CONTEXT_ROT_SIZE cannot hold the state. */
+typedef uint8_t TKSalRotStateSizeCheck
+[(C_K_SAL__CONTEXT_ROT_SIZE >= sizeof(TKSalRotState)) ? 1 : -1];
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
@@ -153,7 +245,8 @@ typedef struct
 static const char* gpModuleName = "SALCRYPTO";
 #endif
 
-static TKSalObjectIdMap gaSalObjectIdMapTable[] =
+/* Object Id map at power-on, the data set later is kept per SAL context. */
+static const TKSalObjectIdMap gaSalObjectIdMapTable[C_SAL_CRYPTO_OBJECT_ID_MAP_COUNT] =
 {
   {
     C_K_KTA__CHIP_SK_ID, {
@@ -169,6 +262,15 @@ static TKSalObjectIdMap gaSalObjectIdMapTable[] =
   {C_K_KTA__VOLATILE_3_ID, {0}},
 };
 
+/** @brief Sessions initialized by salRotSessionInit(). */
+static TKSalRotSessionInfo* gpSalRotSessionList = NULL;
+
+/** @brief HAL registered for the I2C interface before the first I2C session. */
+static ATCAHAL_t* gpSalRotNativeHal = NULL;
+
+/** @brief HAL registered for the I2C interface by the first I2C session. */
+static ATCAHAL_t gSalRotSessionHal;
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
@@ -216,6 +318,295 @@ static TKStatus lGetValueById
   size_t    xValueLen
 );
 
+/**
+ * @brief
+ *   Get the session of an interface.
+ *
+ * @param[in] xIface
+ *   Interface of a device.
+ *
+ * @return
+ * - Session whose configuration the device was initialized with, NULL if none.
+ */
+static TKSalRotSessionInfo* lSessionGet
+(
+  ATCAIface  xIface
+);
+
+/**
+ * @brief
+ *   Check whether the device of a session is kept awake: a session is open,
+ *   the device is awake and the idle timeout is not reached on the host clock.
+ *
+ * @param[in] xpInfo
+ *   Session of the device.
+ *
+ * @return
+ * - true if the idle and wake requests of the device can be skipped.
+ */
+static bool lSessionIsKeptAwake
+(
+  const TKSalRotSessionInfo*  xpInfo
+);
+
+/**
+ * @brief
+ *   Record whether the device of the session is awake.
+ *   While it is, a wake pulse costs neither a pulse nor the wake delay.
+ *
+ * @param[in,out] xpInfo
+ *   Session of the device.
+ * @param[in] xIsAwake
+ *   true if the device is awake.
+ */
+static void lSessionSetAwake
+(
+  TKSalRotSessionInfo*  xpInfo,
+  bool                  xIsAwake
+);
+
+/**
+ * @brief
+ *   Put the device of a session to idle before waking it again, the idle
+ *   timeout being reached. TempKey is kept and the watchdog restarts on wake.
+ *
+ * @param[in,out] xpInfo
+ *   Session of the device.
+ * @param[in] xIface
+ *   Interface of the device.
+ */
+static void lSessionIdleOnTimeout
+(
+  TKSalRotSessionInfo*  xpInfo,
+  ATCAIface             xIface
+);
+
+/**
+ * @brief
+ *   Send through the HAL the session wraps.
+ *
+ * @param[in] xpInfo
+ *   Session of the device, NULL for a device without session.
+ * @param[in] xIface
+ *   Interface of the device.
+ * @param[in] xWordAddress
+ *   Word address of the transfer.
+ * @param[in] xpTxData
+ *   Data to send, NULL for a bare word address.
+ * @param[in] xTxLength
+ *   Length of xpTxData.
+ *
+ * @return
+ * - ATCA_SUCCESS in case of success, otherwise an error code.
+ */
+static ATCA_STATUS lSessionNativeSend
+(
+  const TKSalRotSessionInfo*  xpInfo,
+  ATCAIface                   xIface,
+  uint8_t                     xWordAddress,
+  uint8_t*                    xpTxData,
+  int                         xTxLength
+);
+
+/**
+ * @brief
+ *   Send a wake, idle or sleep control through the HAL the session wraps.
+ *
+ * @param[in] xpInfo
+ *   Session of the device, NULL for a device without session.
+ * @param[in] xIface
+ *   Interface of the device.
+ * @param[in] xOption
+ *   ATCA_HAL_CONTROL_WAKE, ATCA_HAL_CONTROL_IDLE or ATCA_HAL_CONTROL_SLEEP.
+ *
+ * @return
+ * - ATCA_SUCCESS in case of success, otherwise an error code.
+ */
+static ATCA_STATUS lSessionNativeControl
+(
+  const TKSalRotSessionInfo*  xpInfo,
+  ATCAIface                   xIface,
+  uint8_t                     xOption
+);
+
+/**
+ * @brief
+ *   HAL send of a device initialized with a session configuration.
+ *
+ * @param[in] xIface
+ *   Interface of the device.
+ * @param[in] xWordAddress
+ *   Word address of the transfer.
+ * @param[in] xpTxData
+ *   Data to send, NULL for a bare word address.
+ * @param[in] xTxLength
+ *   Length of xpTxData.
+ *
+ * @return
+ * - ATCA_SUCCESS in case of success, otherwise an error code.
+ */
+static ATCA_STATUS lSessionSend
+(
+  ATCAIface  xIface,
+  uint8_t    xWordAddress,
+  uint8_t*   xpTxData,
+  int        xTxLength
+);
+
+/**
+ * @brief
+ *   HAL receive of a device initialized with a session configuration.
+ *
+ * @param[in] xIface
+ *   Interface of the device.
+ * @param[in] xWordAddress
+ *   Word address of the transfer.
+ * @param[out] xpRxData
+ *   Received data.
+ * @param[in,out] xpRxLength
+ *   [in] Size of xpRxData.
+ *   [out] Received length.
+ *
+ * @return
+ * - ATCA_SUCCESS in case of success, otherwise an error code.
+ */
+static ATCA_STATUS lSessionReceive
+(
+  ATCAIface  xIface,
+  uint8_t    xWordAddress,
+  uint8_t*   xpRxData,
+  uint16_t*  xpRxLength
+);
+
+/**
+ * @brief
+ *   HAL wake, idle and sleep controls of a device initialized with a session
+ *   configuration, other controls go through.
+ *
+ * @param[in] xIface
+ *   Interface of the device.
+ * @param[in] xOption
+ *   Control option.
+ * @param[in,out] xpParam
+ *   Parameter of the control.
+ * @param[in] xParamLen
+ *   Length of xpParam.
+ *
+ * @return
+ * - ATCA_SUCCESS in case of success, otherwise an error code.
+ */
+static ATCA_STATUS lSessionControl
+(
+  ATCAIface  xIface,
+  uint8_t    xOption,
+  void*      xpParam,
+  size_t     xParamLen
+);
+
+/**
+ * @brief
+ *   Session HAL init, post init and release for the I2C interface: they go
+ *   through to the registered I2C HAL.
+ */
+static ATCA_STATUS lSessionHalInit
+(
+  ATCAIface      xIface,
+  ATCAIfaceCfg*  xpCfg
+);
+
+static ATCA_STATUS lSessionHalPostInit
+(
+  ATCAIface  xIface
+);
+
+static ATCA_STATUS lSessionHalRelease
+(
+  void*  xpHalData
+);
+
+/**
+ * @brief
+ *   Custom interface callbacks of a session configuration, see lSessionSend(),
+ *   lSessionReceive() and lSessionControl().
+ */
+static ATCA_STATUS lSessionCustomSend
+(
+  void*     xpIface,
+  uint8_t   xWordAddress,
+  uint8_t*  xpTxData,
+  int       xTxLength
+);
+
+static ATCA_STATUS lSessionCustomReceive
+(
+  void*      xpIface,
+  uint8_t    xWordAddress,
+  uint8_t*   xpRxData,
+  uint16_t*  xpRxLength
+);
+
+static ATCA_STATUS lSessionCustomWake
+(
+  void*  xpIface
+);
+
+static ATCA_STATUS lSessionCustomIdle
+(
+  void*  xpIface
+);
+
+static ATCA_STATUS lSessionCustomSleep
+(
+  void*  xpIface
+);
+
+/**
+ * @brief
+ *   Drop the cached chip identity if it was read from another device than the
+ *   one currently selected.
+ */
+static void lIdentityCheckDevice
+(
+  void
+);
+
+/**
+ * @brief
+ *   Get the RoT state of the SAL context bound by the calling thread.
+ * @return
+ * - RoT state, never NULL.
+ */
+static TKSalRotState* lRotState
+(
+  void
+);
+
+/**
+ * @brief
+ *   Open a RoT session around a run of commands, so that the device stays
+ *   awake from one block to the next.
+ *
+ * @return
+ * - true if a session was opened and must be closed with lRunEnd().
+ * - false if the device has no session, the run then idles after each command.
+ */
+static bool lRunBegin
+(
+  void
+);
+
+/**
+ * @brief
+ *   Close the RoT session opened by lRunBegin().
+ *
+ * @param[in] xIsSession
+ *   Value returned by lRunBegin().
+ */
+static void lRunEnd
+(
+  bool  xIsSession
+);
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
 /* -------------------------------------------------------------------------- */
@@ -234,10 +625,13 @@ K_SAL_API TKStatus salRotGetChipUID
   size_t*   xpChipUidLen
 )
 {
-  TKStatus  status = E_K_STATUS_ERROR;
-  ATCA_STATUS atcaStatus = ATCA_SUCCESS;
+  TKSalRotState*  pState = lRotState();
+  ATCADevice      device = salContextGetDevice();
+  TKStatus        status = E_K_STATUS_ERROR;
+  ATCA_STATUS     atcaStatus = ATCA_SUCCESS;
 
   M_KTALOG__START("Start");
+  lIdentityCheckDevice();
 
   if ((NULL == xpChipUid) ||
       (NULL == xpChipUidLen) ||
@@ -249,12 +643,25 @@ K_SAL_API TKStatus salRotGetChipUID
   }
   else
   {
-    /* Reading serial number into the buffer */
-    atcaStatus = atcab_read_serial_number(xpChipUid);
+    if (pState->identity.isChipUidValid)
+    {
+      (void)memcpy(xpChipUid, pState->identity.aChipUid, ATCA_SERIAL_NUM_SIZE);
+    }
+    else
+    {
+      /* Reading serial number into the buffer */
+      atcaStatus = calib_read_serial_number(device, xpChipUid);
+
+      if (ATCA_SUCCESS == atcaStatus)
+      {
+        (void)memcpy(pState->identity.aChipUid, xpChipUid, ATCA_SERIAL_NUM_SIZE);
+        pState->identity.isChipUidValid = true;
+      }
+    }
 
     if (ATCA_SUCCESS != atcaStatus)
     {
-      M_KTALOG__ERR("atcab_read_serial_number Failed[%d]", atcaStatus);
+      M_KTALOG__ERR("calib_read_serial_number Failed[%d]", atcaStatus);
     }
     else
     {
@@ -269,151 +676,398 @@ K_SAL_API TKStatus salRotGetChipUID
 }
 
 /**
- * @brief implement salRotGetChipCertificate
+ * @brief implement salRotSessionInit
  *
  */
 /**
- * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
  * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
  * Using goto for breaking during the error and return cases.
  **/
-K_SAL_API TKStatus salRotGetChipCertificate
+K_SAL_API TKStatus salRotSessionInit
 (
-  uint8_t*  xpChipCert,
-  size_t*   xpChipCertLen
+  TKSalRotSession*  xpSession,
+  void*             xpIfaceCfg,
+  uint32_t          xIdleTimeoutMs,
+  TKSalRotClock     xpClock
 )
 {
-  TKStatus            status = E_K_STATUS_ERROR;
-  ATCA_STATUS         cryptoStatus = ATCA_STATUS_UNKNOWN;
-  uint16_t            slotSign = C_SAL__CRYPTO_SLOT_FOR_ATTESTAION;
-  uint16_t            slotChipSK = C_KTA__CHIP_SK_STORAGE_SLOT;
-  uint8_t             aSignature[C_SAL_CRYPTO_KEY_SIZE_64_BYTE];
-  uint8_t             aPublicKey[C_SAL_CRYPTO_KEY_SIZE_64_BYTE];
-  uint8_t             aNumIn[C_SAL_CRYPTO_RANDOM_NUM_IN_SIZE];
-  uint8_t             aRandOut[C_SAL_CRYPTO_KEY_SIZE_32_BYTE];
-  size_t              tmpLen = 0;
-  atca_temp_key_t     tempKey;
-  atca_nonce_in_out_t nonceParams;
-
-  M_KTALOG__START("Start");
-
-  if ((NULL == xpChipCert) ||
-      (NULL == xpChipCertLen) ||
-      (0u == *xpChipCertLen) ||
-      (C_K_KTA__CHIP_CERT_MAX_SIZE > *xpChipCertLen))
+  TKStatus              status = E_K_STATUS_OK;
+  ATCA_STATUS           atcaStatus = ATCA_SUCCESS;
+  TKSalRotSessionInfo*  pInfo = NULL;
+  TKSalRotSessionInfo** ppLink = &gpSalRotSessionList;
+  ATCAIfaceCfg*         pCfg = (ATCAIfaceCfg*)xpIfaceCfg;
+  ATCAHAL_t*            pPhy = NULL;
+
+  if ((NULL == xpSession) || (NULL == pCfg))
   {
-    M_KTALOG__ERR("Invalid parameter");
     status = E_K_STATUS_PARAMETER;
+    goto end;
   }
-  else
-  {
-    xpChipCert[0] = 0xF6;
-    xpChipCert[1] = 0x00;
-    xpChipCert[2] = 0xA0;
-    (void)memset(aNumIn, 0x00, C_SAL_CRYPTO_RANDOM_NUM_IN_SIZE);
-
-    cryptoStatus = atcab_nonce_rand(aNumIn, aRandOut);
-
-    if (cryptoStatus != ATCA_SUCCESS)
-    {
-      M_KTALOG__ERR("atcab_nonce_rand() failed with ret=0x%08X", cryptoStatus);
-      goto end;
-    }
-
-    cryptoStatus = atcab_genkey(slotChipSK, aPublicKey);
-
-    if (cryptoStatus != ATCA_SUCCESS)
-    {
-      M_KTALOG__ERR("atcab_genkey() failed with ret=0x%08X", cryptoStatus);
-      goto end;
-    }
 
-    cryptoStatus = atcab_genkey_base(GENKEY_MODE_DIGEST, slotChipSK, NULL, NULL);
+  if ((ATCA_I2C_IFACE != pCfg->iface_type) && (ATCA_CUSTOM_IFACE != pCfg->iface_type))
+  {
+    M_KTALOG__ERR("Interface %d not supported", pCfg->iface_type);
+    status = E_K_STATUS_NOT_SUPPORTED;
+    goto end;
+  }
 
-    if (cryptoStatus != ATCA_SUCCESS)
+  if ((ATCA_I2C_IFACE == pCfg->iface_type) && (NULL == gpSalRotNativeHal))
+  {
+    gSalRotSessionHal.halinit = lSessionHalInit;
+    gSalRotSessionHal.halpostinit = lSessionHalPostInit;
+    gSalRotSessionHal.halsend = lSessionSend;
+    gSalRotSessionHal.halreceive = lSessionReceive;
+    gSalRotSessionHal.halcontrol = lSessionControl;
+    gSalRotSessionHal.halrelease = lSessionHalRelease;
+    atcaStatus = hal_iface_register_hal(ATCA_I2C_IFACE, &gSalRotSessionHal,
+                                        &gpSalRotNativeHal, NULL, &pPhy);
+
+    if ((ATCA_SUCCESS == atcaStatus) && (NULL != pPhy))
     {
-      M_KTALOG__ERR("atcab_genkey_base() failed with ret=0x%08X", cryptoStatus);
-      goto end;
+      /* Keep the physical layer of the I2C HAL. */
+      atcaStatus = hal_iface_register_hal(ATCA_I2C_IFACE, &gSalRotSessionHal, NULL, pPhy, NULL);
     }
 
-    cryptoStatus = atcab_sign_internal(slotSign, false, false, aSignature);
-
-    if (cryptoStatus != ATCA_SUCCESS)
+    if ((ATCA_SUCCESS != atcaStatus) || (NULL == gpSalRotNativeHal))
     {
-      M_KTALOG__ERR("atcab_sign_internal() failed with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("hal_iface_register_hal Failed[%d]", atcaStatus);
+      gpSalRotNativeHal = NULL;
+      status = E_K_STATUS_ERROR;
       goto end;
     }
+  }
 
-    (void)memcpy(&xpChipCert[C_SAL_CRYPTO_CHIP_CERT_TAG_AND_VAL_LENGTH], aPublicKey,
-                 C_SAL_CRYPTO_KEY_SIZE_64_BYTE);
-    (void)memcpy(&xpChipCert[C_SAL_CRYPTO_CHIP_CERT_SIGN_OFFSET], aSignature,
-                 C_SAL_CRYPTO_KEY_SIZE_64_BYTE);
-
-    (void)memset(&tempKey, 0, sizeof(tempKey));
-    (void)memset(&nonceParams, 0, sizeof(nonceParams));
-    nonceParams.mode = NONCE_MODE_SEED_UPDATE;
-    nonceParams.zero = 0;
-    nonceParams.num_in = aNumIn;
-    nonceParams.rand_out = aRandOut;
-    nonceParams.temp_key = &tempKey;
-    cryptoStatus = atcah_nonce(&nonceParams);
-
-    if (cryptoStatus != ATCA_SUCCESS)
-    {
-      M_KTALOG__ERR("atcah_nonce() failed with ret=0x%08X", cryptoStatus);
-      goto end;
-    }
+  pInfo = (TKSalRotSessionInfo*)(void*)xpSession->aOpaque;
 
-    (void)memcpy(&xpChipCert[C_SAL_CRYPTO_RANDOM_VALUE_OFFSET], nonceParams.temp_key->value,
-                 C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
+  /* A session initialized again leaves the list first. */
+  while ((NULL != *ppLink) && (pInfo != *ppLink))
+  {
+    ppLink = &(*ppLink)->pNext;
+  }
+  if (NULL != *ppLink)
+  {
+    *ppLink = pInfo->pNext;
+  }
 
-    tmpLen = C_SAL_CRYPTO_CHIP_CERT_TAG_AND_VAL_LENGTH + sizeof(aPublicKey) + sizeof(aSignature) +
-             C_SAL_CRYPTO_KEY_SIZE_32_BYTE;
+  (void)memset(xpSession, 0, sizeof(TKSalRotSession));
+  pInfo->cfg = *pCfg;
+  pInfo->pIfaceCfg = pCfg;
+  pInfo->pClock = xpClock;
+  pInfo->idleTimeoutMs = xIdleTimeoutMs;
 
-    status = E_K_STATUS_OK;
+  if (ATCA_CUSTOM_IFACE == pCfg->iface_type)
+  {
+    ATCA_IFACECFG_VALUE(&pInfo->cfg, atcacustom.halsend) = lSessionCustomSend;
+    ATCA_IFACECFG_VALUE(&pInfo->cfg, atcacustom.halreceive) = lSessionCustomReceive;
+    ATCA_IFACECFG_VALUE(&pInfo->cfg, atcacustom.halwake) = lSessionCustomWake;
+    ATCA_IFACECFG_VALUE(&pInfo->cfg, atcacustom.halidle) = lSessionCustomIdle;
+    ATCA_IFACECFG_VALUE(&pInfo->cfg, atcacustom.halsleep) = lSessionCustomSleep;
   }
 
-end:
-  *xpChipCertLen = tmpLen;
-
-  M_KTALOG__END("End, status : %d", status);
+  pInfo->pNext = gpSalRotSessionList;
+  gpSalRotSessionList = pInfo;
 
+end:
   return status;
 }
 
 /**
- * @brief implement salRotKeyPairGeneration
+ * @brief implement salRotSessionGetIfaceCfg
  *
  */
-/**
- * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
- * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
- * Using goto for breaking during the error and return cases.
- **/
-K_SAL_API TKStatus salRotKeyPairGeneration
+K_SAL_API void* salRotSessionGetIfaceCfg
 (
-  uint8_t*  xpPublicKey
+  TKSalRotSession*  xpSession
 )
 {
-  TKStatus              status = E_K_STATUS_ERROR;
-  ATCA_STATUS           cryptoStatus = ATCA_STATUS_UNKNOWN;
-  uint8_t               aPublicKey[C_K_KTA__PUBLIC_KEY_MAX_SIZE] = {0};
-  uint8_t               privateKeyId = C_KTA__GEN_KEY_PAIR_SLOT;
-
-  M_KTALOG__START("Start");
+  void* pCfg = NULL;
 
-  if (NULL == xpPublicKey)
+  if (NULL != xpSession)
   {
-    M_KTALOG__ERR("Invalid parameter");
-    status = E_K_STATUS_PARAMETER;
+    pCfg = &((TKSalRotSessionInfo*)(void*)xpSession->aOpaque)->cfg;
   }
-  else
-  {
-    cryptoStatus = atcab_genkey(privateKeyId, aPublicKey);
+
+  return pCfg;
+}
+
+/**
+ * @brief implement salRotSessionBegin
+ *
+ */
+K_SAL_API TKStatus salRotSessionBegin
+(
+  void
+)
+{
+  TKStatus              status = E_K_STATUS_NOT_SUPPORTED;
+  ATCADevice            device = salContextGetDevice();
+  TKSalRotSessionInfo*  pInfo = NULL;
+
+  if (NULL != device)
+  {
+    pInfo = lSessionGet(atGetIFace(device));
+  }
+
+  if (NULL != pInfo)
+  {
+    pInfo->depth++;
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @brief implement salRotSessionEnd
+ *
+ */
+K_SAL_API TKStatus salRotSessionEnd
+(
+  void
+)
+{
+  TKStatus              status = E_K_STATUS_NOT_SUPPORTED;
+  ATCADevice            device = salContextGetDevice();
+  TKSalRotSessionInfo*  pInfo = NULL;
+
+  if (NULL != device)
+  {
+    pInfo = lSessionGet(atGetIFace(device));
+  }
+
+  if (NULL == pInfo)
+  {
+    /* No session on this device. */
+  }
+  else if (0u == pInfo->depth)
+  {
+    M_KTALOG__ERR("No session open");
+    status = E_K_STATUS_STATE;
+  }
+  else
+  {
+    status = E_K_STATUS_OK;
+    pInfo->depth--;
+
+    if (0u == pInfo->depth)
+    {
+      pInfo->stats.sessionCount++;
+
+      /* The idle request of the last command was dropped. */
+      if (pInfo->isAwake && (ATCA_SUCCESS != calib_idle(device)))
+      {
+        M_KTALOG__ERR("calib_idle failed");
+        status = E_K_STATUS_ERROR;
+      }
+
+      M_KTALOG__INFO("Session %u: %u commands, %u wakes, %u wakes skipped, %u idles on timeout",
+                     pInfo->stats.sessionCount, pInfo->stats.commandCount,
+                     pInfo->stats.wakeCount, pInfo->stats.wakeSkippedCount,
+                     pInfo->stats.idleTimeoutCount);
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @brief implement salRotSessionGetStats
+ *
+ */
+K_SAL_API TKStatus salRotSessionGetStats
+(
+  const TKSalRotSession*  xpSession,
+  TKSalRotSessionStats*   xpStats
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+
+  if ((NULL != xpSession) && (NULL != xpStats))
+  {
+    *xpStats = ((const TKSalRotSessionInfo*)(const void*)xpSession->aOpaque)->stats;
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @brief implement salRotInvalidateIdentity
+ *
+ */
+K_SAL_API TKStatus salRotInvalidateIdentity
+(
+  void
+)
+{
+  TKSalRotState*  pState = lRotState();
+
+  pState->identity.isChipUidValid = false;
+  pState->identity.isChipCertValid = false;
+  (void)memset(pState->identity.aChipCert, 0, sizeof(pState->identity.aChipCert));
+
+  return E_K_STATUS_OK;
+}
+
+/**
+ * @brief implement salRotGetChipCertificate
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+K_SAL_API TKStatus salRotGetChipCertificate
+(
+  uint8_t*  xpChipCert,
+  size_t*   xpChipCertLen
+)
+{
+  TKSalRotState*       pState = lRotState();
+  ATCADevice           device = salContextGetDevice();
+  TKStatus             status = E_K_STATUS_ERROR;
+  ATCA_STATUS          cryptoStatus = ATCA_STATUS_UNKNOWN;
+  uint16_t             slotSign = C_SAL__CRYPTO_SLOT_FOR_ATTESTAION;
+  uint16_t             slotChipSK = C_KTA__CHIP_SK_STORAGE_SLOT;
+  uint8_t              aSignature[C_SAL_CRYPTO_KEY_SIZE_64_BYTE];
+  uint8_t              aPublicKey[C_SAL_CRYPTO_KEY_SIZE_64_BYTE];
+  uint8_t              aNumIn[C_SAL_CRYPTO_RANDOM_NUM_IN_SIZE];
+  uint8_t              aRandOut[C_SAL_CRYPTO_KEY_SIZE_32_BYTE];
+  size_t               tmpLen = 0;
+  atca_temp_key_t      tempKey;
+  atca_nonce_in_out_t  nonceParams;
+
+  M_KTALOG__START("Start");
+  lIdentityCheckDevice();
+
+  if ((NULL == xpChipCert) ||
+      (NULL == xpChipCertLen) ||
+      (0u == *xpChipCertLen) ||
+      (C_K_KTA__CHIP_CERT_MAX_SIZE > *xpChipCertLen))
+  {
+    M_KTALOG__ERR("Invalid parameter");
+    status = E_K_STATUS_PARAMETER;
+  }
+  else if (pState->identity.isChipCertValid)
+  {
+    (void)memcpy(xpChipCert, pState->identity.aChipCert, C_SAL_CRYPTO_CHIP_CERT_LENGTH);
+    tmpLen = C_SAL_CRYPTO_CHIP_CERT_LENGTH;
+    status = E_K_STATUS_OK;
+  }
+  else
+  {
+    xpChipCert[0] = 0xF6;
+    xpChipCert[1] = 0x00;
+    xpChipCert[2] = 0xA0;
+    (void)memset(aNumIn, 0x00, C_SAL_CRYPTO_RANDOM_NUM_IN_SIZE);
+
+    cryptoStatus = calib_nonce_rand(device, aNumIn, aRandOut);
+
+    if (cryptoStatus != ATCA_SUCCESS)
+    {
+      M_KTALOG__ERR("calib_nonce_rand() failed with ret=0x%08X", cryptoStatus);
+      goto end;
+    }
+
+    cryptoStatus = calib_genkey(device, slotChipSK, aPublicKey);
+
+    if (cryptoStatus != ATCA_SUCCESS)
+    {
+      M_KTALOG__ERR("calib_genkey() failed with ret=0x%08X", cryptoStatus);
+      goto end;
+    }
+
+    cryptoStatus = calib_genkey_base(device, GENKEY_MODE_DIGEST, slotChipSK, NULL, NULL);
+
+    if (cryptoStatus != ATCA_SUCCESS)
+    {
+      M_KTALOG__ERR("calib_genkey_base() failed with ret=0x%08X", cryptoStatus);
+      goto end;
+    }
+
+    cryptoStatus = calib_sign_internal(device, slotSign, false, false, aSignature);
 
     if (cryptoStatus != ATCA_SUCCESS)
     {
-      M_KTALOG__ERR("atcab_genkey() failed with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("calib_sign_internal() failed with ret=0x%08X", cryptoStatus);
+      goto end;
+    }
+
+    (void)memcpy(&xpChipCert[C_SAL_CRYPTO_CHIP_CERT_TAG_AND_VAL_LENGTH], aPublicKey,
+                 C_SAL_CRYPTO_KEY_SIZE_64_BYTE);
+    (void)memcpy(&xpChipCert[C_SAL_CRYPTO_CHIP_CERT_SIGN_OFFSET], aSignature,
+                 C_SAL_CRYPTO_KEY_SIZE_64_BYTE);
+
+    (void)memset(&tempKey, 0, sizeof(tempKey));
+    (void)memset(&nonceParams, 0, sizeof(nonceParams));
+    nonceParams.mode = NONCE_MODE_SEED_UPDATE;
+    nonceParams.zero = 0;
+    nonceParams.num_in = aNumIn;
+    nonceParams.rand_out = aRandOut;
+    nonceParams.temp_key = &tempKey;
+    cryptoStatus = atcah_nonce(&nonceParams);
+
+    if (cryptoStatus != ATCA_SUCCESS)
+    {
+      M_KTALOG__ERR("atcah_nonce() failed with ret=0x%08X", cryptoStatus);
+      goto end;
+    }
+
+    (void)memcpy(&xpChipCert[C_SAL_CRYPTO_RANDOM_VALUE_OFFSET], nonceParams.temp_key->value,
+                 C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
+
+    tmpLen = C_SAL_CRYPTO_CHIP_CERT_TAG_AND_VAL_LENGTH + sizeof(aPublicKey) + sizeof(aSignature) +
+             C_SAL_CRYPTO_KEY_SIZE_32_BYTE;
+
+    /* The key of the chip SK slot is only regenerated here: the certificate stays valid. */
+    (void)memcpy(pState->identity.aChipCert, xpChipCert, C_SAL_CRYPTO_CHIP_CERT_LENGTH);
+    pState->identity.isChipCertValid = true;
+    status = E_K_STATUS_OK;
+  }
+
+end:
+  *xpChipCertLen = tmpLen;
+
+  M_KTALOG__END("End, status : %d", status);
+
+  return status;
+}
+
+/**
+ * @brief implement salRotKeyPairGeneration
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+K_SAL_API TKStatus salRotKeyPairGeneration
+(
+  uint8_t*  xpPublicKey
+)
+{
+  ATCADevice            device = salContextGetDevice();
+  TKStatus              status = E_K_STATUS_ERROR;
+  ATCA_STATUS           cryptoStatus = ATCA_STATUS_UNKNOWN;
+  uint8_t               aPublicKey[C_K_KTA__PUBLIC_KEY_MAX_SIZE] = {0};
+  uint8_t               privateKeyId = C_KTA__GEN_KEY_PAIR_SLOT;
+
+  M_KTALOG__START("Start");
+
+  if (NULL == xpPublicKey)
+  {
+    M_KTALOG__ERR("Invalid parameter");
+    status = E_K_STATUS_PARAMETER;
+  }
+  else
+  {
+    cryptoStatus = calib_genkey(device, privateKeyId, aPublicKey);
+
+    if (cryptoStatus != ATCA_SUCCESS)
+    {
+      M_KTALOG__ERR("calib_genkey() failed with ret=0x%08X", cryptoStatus);
       goto end;
     }
 
@@ -452,6 +1106,7 @@ K_SAL_API TKStatus salRotKeyAgreement
   uint8_t*        xpSharedSecret
 )
 {
+  ATCADevice        device = salContextGetDevice();
   TKStatus          status = E_K_STATUS_ERROR;
   ATCA_STATUS       cryptoStatus = ATCA_STATUS_UNKNOWN;
   uint32_t          exposeSecret = (uint32_t)(M_SAL_CRYPTO_GET_BIT31(xSharedSecretTarget));
@@ -484,12 +1139,12 @@ K_SAL_API TKStatus salRotKeyAgreement
        *  ECDH Key Agreement is the first phase of a common operation with HKDF Key Derivation
        *  initialize operation.
        */
-      cryptoStatus = atcab_ecdh_base(ECDH_MODE_COPY_OUTPUT_BUFFER,
+      cryptoStatus = calib_ecdh_base(device, ECDH_MODE_COPY_OUTPUT_BUFFER,
                                      keyID, xpPeerPublicKey, aSecret, NULL);
 
       if (cryptoStatus != ATCA_SUCCESS)
       {
-        M_KTALOG__ERR("atcab_ecdh_base() failed with ret=0x%08X", cryptoStatus);
+        M_KTALOG__ERR("calib_ecdh_base() failed with ret=0x%08X", cryptoStatus);
         goto end;
       }
 
@@ -505,12 +1160,12 @@ K_SAL_API TKStatus salRotKeyAgreement
     }
     else  /* Export to buffer */
     {
-      cryptoStatus = atcab_ecdh_base(ECDH_MODE_COPY_OUTPUT_BUFFER,
+      cryptoStatus = calib_ecdh_base(device, ECDH_MODE_COPY_OUTPUT_BUFFER,
                                      (uint16_t)keyID, xpPeerPublicKey, xpSharedSecret, NULL);
 
       if (cryptoStatus != ATCA_SUCCESS)
       {
-        M_KTALOG__ERR("atcab_ecdh_base() failed with ret=0x%08X", cryptoStatus);
+        M_KTALOG__ERR("calib_ecdh_base() failed with ret=0x%08X", cryptoStatus);
         goto end;
       }
 
@@ -539,6 +1194,7 @@ K_SAL_API TKStatus salRotHkdfExtractAndExpand
   size_t          xInfoLen
 )
 {
+  ATCADevice            device = salContextGetDevice();
   TKStatus              status = E_K_STATUS_ERROR;
   ATCA_STATUS           cryptoStatus = ATCA_STATUS_UNKNOWN;
   uint8_t               aSecret[C_SAL_CRYPTO_KEY_SIZE_32_BYTE];
@@ -616,18 +1272,18 @@ K_SAL_API TKStatus salRotHkdfExtractAndExpand
           break;
         }
 
-        cryptoStatus = atcab_nonce_load(NONCE_MODE_TARGET_TEMPKEY, aL1Key, (uint16_t)l1KeySize);
+        cryptoStatus = calib_nonce_load(device, NONCE_MODE_TARGET_TEMPKEY, aL1Key, (uint16_t)l1KeySize);
 
         if (cryptoStatus != ATCA_SUCCESS)
         {
-          M_KTALOG__ERR("atcab_nonce_load()  failed with ret=0x%08X", cryptoStatus);
+          M_KTALOG__ERR("calib_nonce_load()  failed with ret=0x%08X", cryptoStatus);
           break;
         }
 
         M_KTALOG__INFO("l1 key in expand for activation request:");
         M_KTALOG__HEX("L1 Key:", aL1Key, l1KeySize);
         /* HKDF Expand */
-        cryptoStatus = atcab_kdf(
+        cryptoStatus = calib_kdf(device,
                          KDF_MODE_ALG_HKDF | KDF_MODE_SOURCE_TEMPKEY | KDF_MODE_TARGET_OUTPUT,
                          0x0000,
                          KDF_DETAILS_HKDF_MSG_LOC_INPUT | (infoLen << 24),
@@ -637,7 +1293,7 @@ K_SAL_API TKStatus salRotHkdfExtractAndExpand
 
         if (cryptoStatus != ATCA_SUCCESS)
         {
-          M_KTALOG__ERR("atcab_kdf() for expand failed with ret=0x%08X", cryptoStatus);
+          M_KTALOG__ERR("calib_kdf() for expand failed with ret=0x%08X", cryptoStatus);
           break;
         }
 
@@ -661,17 +1317,17 @@ K_SAL_API TKStatus salRotHkdfExtractAndExpand
         M_KTALOG__HEX("Salt:", xpSalt, C_K_KTA__HKDF_GEN_SALT_MAX_SIZE);
         (void)memset(aSalt, 0x00, 32);
         (void)memcpy(aSalt, xpSalt, 16);
-        cryptoStatus = atcab_nonce_load(NONCE_MODE_TARGET_TEMPKEY,
+        cryptoStatus = calib_nonce_load(device, NONCE_MODE_TARGET_TEMPKEY,
                                         aSalt, C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
 
         if (cryptoStatus != ATCA_SUCCESS)
         {
-          M_KTALOG__ERR("atcab_nonce_load()  failed with ret=0x%08X", cryptoStatus);
+          M_KTALOG__ERR("calib_nonce_load()  failed with ret=0x%08X", cryptoStatus);
           break;
         }
 
         /* HKDF Extract */
-        cryptoStatus = atcab_kdf(
+        cryptoStatus = calib_kdf(device,
                          KDF_MODE_ALG_HKDF | KDF_MODE_SOURCE_TEMPKEY | KDF_MODE_TARGET_TEMPKEY,
                          0x0000,
                          KDF_DETAILS_HKDF_MSG_LOC_INPUT | (genMsgLen << 24),
@@ -681,12 +1337,12 @@ K_SAL_API TKStatus salRotHkdfExtractAndExpand
 
         if (cryptoStatus != ATCA_SUCCESS)
         {
-          M_KTALOG__ERR("atcab_kdf() for extract failed with ret=0x%08X", cryptoStatus);
+          M_KTALOG__ERR("calib_kdf() for extract failed with ret=0x%08X", cryptoStatus);
           break;
         }
 
         /* HKDF Expand */
-        cryptoStatus = atcab_kdf(
+        cryptoStatus = calib_kdf(device,
                          KDF_MODE_ALG_HKDF | KDF_MODE_SOURCE_TEMPKEY | KDF_MODE_TARGET_SLOT,
                          C_KTA__KDF_KEY_ID,
                          KDF_DETAILS_HKDF_MSG_LOC_INPUT | (infoLen << 24),
@@ -696,7 +1352,7 @@ K_SAL_API TKStatus salRotHkdfExtractAndExpand
 
         if (cryptoStatus != ATCA_SUCCESS)
         {
-          M_KTALOG__ERR("atcab_kdf() for expand failed with ret=0x%08X", cryptoStatus);
+          M_KTALOG__ERR("calib_kdf() for expand failed with ret=0x%08X", cryptoStatus);
           break;
         }
 
@@ -735,6 +1391,7 @@ K_SAL_API TKStatus salRotKeyDerivation
   uint32_t        xDerivedKeyId
 )
 {
+  ATCADevice    device = salContextGetDevice();
   TKStatus      status = E_K_STATUS_ERROR;
   ATCA_STATUS   cryptoStatus = ATCA_STATUS_UNKNOWN;
   uint8_t       aKeyBuff[C_SAL_CRYPTO_KEY_SIZE_32_BYTE] = { 0 };
@@ -764,22 +1421,22 @@ K_SAL_API TKStatus salRotKeyDerivation
 
       M_KTALOG__INFO("l1 key in key derivation for activation request:");
       M_KTALOG__HEX("L1 Key:", aKeyBuff, C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
-      cryptoStatus = atcab_nonce_load(NONCE_MODE_TARGET_TEMPKEY, aKeyBuff,
+      cryptoStatus = calib_nonce_load(device, NONCE_MODE_TARGET_TEMPKEY, aKeyBuff,
                                       C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
 
       if (cryptoStatus != ATCA_SUCCESS)
       {
-        M_KTALOG__ERR("atcab_nonce_load()  failed with ret=0x%08X", cryptoStatus);
+        M_KTALOG__ERR("calib_nonce_load()  failed with ret=0x%08X", cryptoStatus);
         goto end;
       }
 
       (void)memset(aKeyBuff, 0x00, C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
-      cryptoStatus = atcab_sha_hmac(xpInputData, xInputDataLen,
+      cryptoStatus = calib_sha_hmac(device, xpInputData, xInputDataLen,
                                     ATCA_TEMPKEY_KEYID, aKeyBuff, SHA_MODE_TARGET_OUT_ONLY);
 
       if (cryptoStatus != ATCA_SUCCESS)
       {
-        M_KTALOG__ERR("atcab_sha_hmac() failed with ret=0x%08X", cryptoStatus);
+        M_KTALOG__ERR("calib_sha_hmac() failed with ret=0x%08X", cryptoStatus);
         goto end;
       }
 
@@ -789,14 +1446,14 @@ K_SAL_API TKStatus salRotKeyDerivation
       if (C_K_KTA__VOLATILE_2_ID == xDerivedKeyId)
       {
         (void)memset(&aKeyBuff[C_SAL_CRYPTO_KEY_SIZE_16_BYTE], 0x00, C_SAL_CRYPTO_KEY_SIZE_16_BYTE);
-        cryptoStatus = atcab_write_zone(ATCA_ZONE_DATA,
+        cryptoStatus = calib_write_zone(device, ATCA_ZONE_DATA,
                                         SLOT_9, SLOT_9_BLOCK_0, 0,
                                         aKeyBuff,
                                         C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
       }
       else if (C_K_KTA__VOLATILE_3_ID == xDerivedKeyId)
       {
-        cryptoStatus = atcab_write_zone(ATCA_ZONE_DATA,
+        cryptoStatus = calib_write_zone(device, ATCA_ZONE_DATA,
                                         SLOT_9, SLOT_9_BLOCK_1, 0,
                                         aKeyBuff,
                                         C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
@@ -817,12 +1474,12 @@ K_SAL_API TKStatus salRotKeyDerivation
     }
     else if (xKeyId == C_K_KTA__L1_FIELD_KEY_ID)
     {
-      cryptoStatus = atcab_sha_hmac(xpInputData, xInputDataLen, C_KTA__L1_FIELD_KEY_STORAGE_SLOT,
+      cryptoStatus = calib_sha_hmac(device, xpInputData, xInputDataLen, C_KTA__L1_FIELD_KEY_STORAGE_SLOT,
                                     aKeyBuff, SHA_MODE_TARGET_OUT_ONLY);
 
       if (cryptoStatus != ATCA_SUCCESS)
       {
-        M_KTALOG__ERR("atcab_sha_hmac() failed with ret=0x%08X", cryptoStatus);
+        M_KTALOG__ERR("calib_sha_hmac() failed with ret=0x%08X", cryptoStatus);
         goto end;
       }
 
@@ -832,14 +1489,14 @@ K_SAL_API TKStatus salRotKeyDerivation
       if (C_K_KTA__VOLATILE_2_ID == xDerivedKeyId)
       {
         (void)memset(&aKeyBuff[C_SAL_CRYPTO_KEY_SIZE_16_BYTE], 0x00, C_SAL_CRYPTO_KEY_SIZE_16_BYTE);
-        cryptoStatus = atcab_write_zone(ATCA_ZONE_DATA,
+        cryptoStatus = calib_write_zone(device, ATCA_ZONE_DATA,
                                         SLOT_9, SLOT_9_BLOCK_0, 0,
                                         aKeyBuff,
                                         C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
       }
       else if (C_K_KTA__VOLATILE_3_ID == xDerivedKeyId)
       {
-        cryptoStatus = atcab_write_zone(ATCA_ZONE_DATA,
+        cryptoStatus = calib_write_zone(device, ATCA_ZONE_DATA,
                                         SLOT_9, SLOT_9_BLOCK_1, 0,
                                         aKeyBuff,
                                         C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
@@ -888,9 +1545,11 @@ K_SAL_API TKStatus salCryptoHmac
   uint8_t*        xpMac
 )
 {
+  ATCADevice        device = salContextGetDevice();
   TKStatus          status = E_K_STATUS_ERROR;
   ATCA_STATUS       cryptoStatus = ATCA_STATUS_UNKNOWN;
   uint8_t           aMac[C_SAL_CRYPTO_KEY_SIZE_32_BYTE] = { 0 };
+  bool              isSession = false;
 
   M_KTALOG__START("Start");
 
@@ -906,12 +1565,13 @@ K_SAL_API TKStatus salCryptoHmac
   {
     M_KTALOG__HEX("InputData:", xpInputData, xInputDataLen);
 
-    cryptoStatus = atcab_sha_hmac(xpInputData, xInputDataLen,
+    isSession = lRunBegin();
+    cryptoStatus = calib_sha_hmac(device, xpInputData, xInputDataLen,
                                   SLOT_9, aMac, SHA_MODE_TARGET_OUT_ONLY);
 
     if (cryptoStatus != ATCA_SUCCESS)
     {
-      M_KTALOG__ERR("atcab_sha_hmac() with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("calib_sha_hmac() with ret=0x%08X", cryptoStatus);
       goto end;
     }
 
@@ -922,6 +1582,7 @@ K_SAL_API TKStatus salCryptoHmac
   }
 
 end:
+  lRunEnd(isSession);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -943,9 +1604,11 @@ K_SAL_API TKStatus salCryptoHmacVerify
   const uint8_t*    xpMac
 )
 {
+  ATCADevice        device = salContextGetDevice();
   TKStatus          status = E_K_STATUS_ERROR;
   ATCA_STATUS       cryptoStatus = ATCA_STATUS_UNKNOWN;
   uint8_t           aMac[C_SAL_CRYPTO_KEY_SIZE_32_BYTE] = { 0 };
+  bool              isSession = false;
 
   M_KTALOG__START("Start");
 
@@ -962,12 +1625,13 @@ K_SAL_API TKStatus salCryptoHmacVerify
     M_KTALOG__INFO("Input data for hmac verify ");
     M_KTALOG__HEX("Input Data:", xpInputData, xInputDataLen);
 
-    cryptoStatus = atcab_sha_hmac(xpInputData, xInputDataLen,
+    isSession = lRunBegin();
+    cryptoStatus = calib_sha_hmac(device, xpInputData, xInputDataLen,
                                   SLOT_9, aMac, SHA_MODE_TARGET_OUT_ONLY);
 
     if (cryptoStatus != ATCA_SUCCESS)
     {
-      M_KTALOG__ERR("atcab_sha_hmac() with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("calib_sha_hmac() with ret=0x%08X", cryptoStatus);
       goto end;
     }
 
@@ -984,6 +1648,7 @@ K_SAL_API TKStatus salCryptoHmacVerify
   }
 
 end:
+  lRunEnd(isSession);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -1006,11 +1671,13 @@ K_SAL_API TKStatus salCryptoAesEnc
   size_t*         xpOutputDataLen
 )
 {
+  ATCADevice          device = salContextGetDevice();
   TKStatus            status = E_K_STATUS_ERROR;
   ATCA_STATUS         cryptoStatus = ATCA_STATUS_UNKNOWN;
   uint16_t            dataBlock;
   atca_aes_cbc_ctx_t  ctx;
   uint8_t             aIV[] = C_SAL_CRYPTO_IV;
+  bool                isSession = false;
 
   M_KTALOG__START("Start");
 
@@ -1027,10 +1694,11 @@ K_SAL_API TKStatus salCryptoAesEnc
   {
     M_KTALOG__HEX("Input Data for encryption :", xpInputData, xInputDataLen);
 
-    cryptoStatus = atcab_aes_cbc_init(&ctx, SLOT_9, SLOT_9_BLOCK_2, aIV);
+    isSession = lRunBegin();
+    cryptoStatus = atcab_aes_cbc_init_ext(device, &ctx, SLOT_9, SLOT_9_BLOCK_2, aIV, 0u);
     if (cryptoStatus != ATCA_SUCCESS)
     {
-      M_KTALOG__ERR("atcab_aes_cbc_init() with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("atcab_aes_cbc_init_ext() with ret=0x%08X", cryptoStatus);
       goto end;
     }
 
@@ -1056,12 +1724,117 @@ K_SAL_API TKStatus salCryptoAesEnc
   }
 
 end:
+  lRunEnd(isSession);
   M_KTALOG__HEX("Output Data:", xpOutputData, *xpOutputDataLen);
 
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
 
+/**
+ * @brief implement salCryptoAesEncHmac
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+K_SAL_API TKStatus salCryptoAesEncHmac
+(
+  uint32_t        xEncKeyId,
+  uint32_t        xMacKeyId,
+  uint8_t*        xpData,
+  size_t          xHeaderLen,
+  size_t          xDataLen,
+  uint8_t*        xpMac
+)
+{
+  ATCADevice              device = salContextGetDevice();
+  TKStatus                status = E_K_STATUS_ERROR;
+  ATCA_STATUS             cryptoStatus = ATCA_STATUS_UNKNOWN;
+  size_t                  offset;
+  atca_aes_cbc_ctx_t      ctx;
+  atca_hmac_sha256_ctx_t  hmacCtx;
+  uint8_t                 aIV[] = C_SAL_CRYPTO_IV;
+  uint8_t                 aMac[C_SAL_CRYPTO_KEY_SIZE_32_BYTE] = { 0 };
+  bool                    isSession = false;
+
+  M_KTALOG__START("Start");
+
+  if ((C_K_KTA__VOLATILE_3_ID != xEncKeyId) ||
+      (C_K_KTA__VOLATILE_2_ID != xMacKeyId) ||
+      (NULL == xpData) ||
+      (0u == xDataLen) ||
+      (0u != (xDataLen % ATCA_AES128_BLOCK_SIZE)) ||
+      (NULL == xpMac))
+  {
+    M_KTALOG__ERR("Invalid parameter");
+    status = E_K_STATUS_PARAMETER;
+    goto end;
+  }
+
+  M_KTALOG__HEX("Input Data for encryption :", &xpData[xHeaderLen], xDataLen);
+
+  /* One session for the whole run, AES and SHA commands alternate on an awake device. */
+  isSession = lRunBegin();
+  cryptoStatus = atcab_aes_cbc_init_ext(device, &ctx, SLOT_9, SLOT_9_BLOCK_2, aIV, 0u);
+  if (cryptoStatus != ATCA_SUCCESS)
+  {
+    M_KTALOG__ERR("atcab_aes_cbc_init_ext() with ret=0x%08X", cryptoStatus);
+    goto end;
+  }
+
+  cryptoStatus = calib_sha_hmac_init(device, &hmacCtx, SLOT_9);
+  if (cryptoStatus != ATCA_SUCCESS)
+  {
+    M_KTALOG__ERR("calib_sha_hmac_init() with ret=0x%08X", cryptoStatus);
+    goto end;
+  }
+
+  if (0u != xHeaderLen)
+  {
+    cryptoStatus = calib_sha_hmac_update(device, &hmacCtx, xpData, xHeaderLen);
+  }
+
+  /* Encrypt blocks, each cipher block goes to the HMAC while it is still hot. */
+  for (offset = xHeaderLen;
+       (cryptoStatus == ATCA_SUCCESS) && (offset < (xHeaderLen + xDataLen));
+       offset += ATCA_AES128_BLOCK_SIZE)
+  {
+    cryptoStatus = atcab_aes_cbc_encrypt_block(&ctx, &xpData[offset], &xpData[offset]);
+    if (cryptoStatus != ATCA_SUCCESS)
+    {
+      M_KTALOG__ERR("atcab_aes_cbc_encrypt_block() with ret=0x%08X", cryptoStatus);
+      break;
+    }
+
+    cryptoStatus = calib_sha_hmac_update(device, &hmacCtx, &xpData[offset], ATCA_AES128_BLOCK_SIZE);
+  }
+
+  if (cryptoStatus != ATCA_SUCCESS)
+  {
+    M_KTALOG__ERR("Encryption or calib_sha_hmac_update() failed with ret=0x%08X", cryptoStatus);
+    goto end;
+  }
+
+  cryptoStatus = calib_sha_hmac_finish(device, &hmacCtx, aMac, SHA_MODE_TARGET_OUT_ONLY);
+  if (cryptoStatus != ATCA_SUCCESS)
+  {
+    M_KTALOG__ERR("calib_sha_hmac_finish() with ret=0x%08X", cryptoStatus);
+    goto end;
+  }
+
+  (void)memcpy(xpMac, aMac, C_K_KTA__HMAC_MAX_SIZE);
+  M_KTALOG__HEX("MAC:", xpMac, C_K_KTA__HMAC_MAX_SIZE);
+  status = E_K_STATUS_OK;
+
+end:
+  lRunEnd(isSession);
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
 /**
  * @brief implement salCryptoAesDec
  *
@@ -1075,11 +1848,14 @@ K_SAL_API TKStatus salCryptoAesDec
   size_t*         xpOutputDataLen
 )
 {
+  ATCADevice          device = salContextGetDevice();
   TKStatus            status = E_K_STATUS_ERROR;
   ATCA_STATUS         cryptoStatus = ATCA_STATUS_UNKNOWN;
   uint16_t            dataBlock;
   atca_aes_cbc_ctx_t  ctx;
   uint8_t             aIV[] = C_SAL_CRYPTO_IV;
+  uint8_t             aCipher[ATCA_AES128_BLOCK_SIZE];
+  bool                isSession = false;
 
   M_KTALOG__START("Start");
 
@@ -1099,19 +1875,20 @@ K_SAL_API TKStatus salCryptoAesDec
     }
 
     M_KTALOG__HEX("Input Data:", xpInputData, xInputDataLen);
-    cryptoStatus = atcab_aes_cbc_init(&ctx, SLOT_9, SLOT_9_BLOCK_2, aIV);
+    isSession = lRunBegin();
+    cryptoStatus = atcab_aes_cbc_init_ext(device, &ctx, SLOT_9, SLOT_9_BLOCK_2, aIV, 0u);
 
     if (cryptoStatus != ATCA_SUCCESS)
     {
-      M_KTALOG__ERR("atcab_aes_cbc_init() with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("atcab_aes_cbc_init_ext() with ret=0x%08X", cryptoStatus);
       break;
     }
 
-    /* Decrypt blocks */
+    /* Decrypt blocks, from a copy so that the output may be the input. */
     for (dataBlock = 0; dataBlock < (xInputDataLen / ATCA_AES128_BLOCK_SIZE); dataBlock++)
     {
-      cryptoStatus = atcab_aes_cbc_decrypt_block(&ctx,
-                                                 &xpInputData[dataBlock * ATCA_AES128_BLOCK_SIZE],
+      (void)memcpy(aCipher, &xpInputData[dataBlock * ATCA_AES128_BLOCK_SIZE], ATCA_AES128_BLOCK_SIZE);
+      cryptoStatus = atcab_aes_cbc_decrypt_block(&ctx, aCipher,
                                                  &xpOutputData[dataBlock * ATCA_AES128_BLOCK_SIZE]);
 
       if (cryptoStatus != ATCA_SUCCESS)
@@ -1131,11 +1908,13 @@ K_SAL_API TKStatus salCryptoAesDec
     break;
   }
 
+  lRunEnd(isSession);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
 
 /**
+
  * @brief implement salCryptoGetRandom
  *
  */
@@ -1150,6 +1929,7 @@ K_SAL_API TKStatus salCryptoGetRandom
   size_t*  xpRandomDataLen
 )
 {
+  ATCADevice    device = salContextGetDevice();
   TKStatus      status = E_K_STATUS_ERROR;
   ATCA_STATUS   randomStatus = ATCA_SUCCESS;
   uint8_t       aTmpRandom[C_SAL_CRYPTO_MAX_RANDOM_GEN_SIZE_BYTES] = { 0 };
@@ -1174,11 +1954,11 @@ K_SAL_API TKStatus salCryptoGetRandom
 
     while (loopCount > 0u)
     {
-      randomStatus = atcab_random(pRandomData);
+      randomStatus = calib_random(device, pRandomData);
 
       if (randomStatus != ATCA_SUCCESS)
       {
-        M_KTALOG__ERR("atcab_random() with ret=0x%08X", randomStatus);
+        M_KTALOG__ERR("calib_random() with ret=0x%08X", randomStatus);
         goto end;
       }
 
@@ -1195,11 +1975,11 @@ K_SAL_API TKStatus salCryptoGetRandom
 
     if (tmpRandomLen > 0u)
     {
-      randomStatus = atcab_random(aTmpRandom);
+      randomStatus = calib_random(device, aTmpRandom);
 
       if (randomStatus != ATCA_SUCCESS)
       {
-        M_KTALOG__ERR("atcab_random() with ret=0x%08X", randomStatus);
+        M_KTALOG__ERR("calib_random() with ret=0x%08X", randomStatus);
         *xpRandomDataLen = 0;
         goto end;
       }
@@ -1230,9 +2010,10 @@ static TKStatus lSetValueById
   size_t    xValueLen
 )
 {
-  TKStatus  status = E_K_STATUS_ERROR;
-  uint32_t  loopCount = 0;
-  uint32_t  noOfItems = sizeof(gaSalObjectIdMapTable) / sizeof(gaSalObjectIdMapTable[0]);
+  TKSalRotState*  pState = lRotState();
+  TKStatus        status = E_K_STATUS_ERROR;
+  uint32_t        loopCount = 0;
+  uint32_t        noOfItems = C_SAL_CRYPTO_OBJECT_ID_MAP_COUNT;
 
   M_KTALOG__START("Start");
 
@@ -1240,10 +2021,11 @@ static TKStatus lSetValueById
   {
     if (gaSalObjectIdMapTable[loopCount].virtualObjId == xObjectId)
     {
-      (void)memset(gaSalObjectIdMapTable[loopCount].aObjectIdData,
+      (void)memset(pState->aaObjectIdData[loopCount],
                    0,
                    C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
-      (void)memcpy(gaSalObjectIdMapTable[loopCount].aObjectIdData, xpValue, xValueLen);
+      (void)memcpy(pState->aaObjectIdData[loopCount], xpValue, xValueLen);
+      pState->objectIdSetMask |= (uint8_t)(1u << loopCount);
       status = E_K_STATUS_OK;
       break;
     }
@@ -1264,9 +2046,10 @@ static TKStatus lGetValueById
   size_t    xValueLen
 )
 {
-  TKStatus  status = E_K_STATUS_ERROR;
-  uint32_t  loopCount = 0;
-  uint32_t  noOfItems = sizeof(gaSalObjectIdMapTable) / sizeof(gaSalObjectIdMapTable[0]);
+  TKSalRotState*  pState = lRotState();
+  TKStatus        status = E_K_STATUS_ERROR;
+  uint32_t        loopCount = 0;
+  uint32_t        noOfItems = C_SAL_CRYPTO_OBJECT_ID_MAP_COUNT;
 
   M_KTALOG__START("Start");
 
@@ -1275,11 +2058,18 @@ static TKStatus lGetValueById
     if (gaSalObjectIdMapTable[loopCount].virtualObjId == xObjectId)
     {
       M_KTALOG__INFO("Found the ID %x", xObjectId);
-      (void)memcpy(xpValue, gaSalObjectIdMapTable[loopCount].aObjectIdData, xValueLen);
-      status = E_K_STATUS_OK;
-      break;
-    }
-  }
+      if (0u != (pState->objectIdSetMask & (1u << loopCount)))
+      {
+        (void)memcpy(xpValue, pState->aaObjectIdData[loopCount], xValueLen);
+      }
+      else
+      {
+        (void)memcpy(xpValue, gaSalObjectIdMapTable[loopCount].aObjectIdData, xValueLen);
+      }
+      status = E_K_STATUS_OK;
+      break;
+    }
+  }
 
   M_KTALOG__END("End, status : %d", status);
   return status;
@@ -1308,6 +2098,574 @@ TKStatus salSignHash
   return E_K_STATUS_OK;
 }
 
+/**
+ * @implements lSessionGet
+ *
+ */
+static TKSalRotSessionInfo* lSessionGet
+(
+  ATCAIface  xIface
+)
+{
+  TKSalRotSessionInfo*  pInfo = gpSalRotSessionList;
+  const ATCAIfaceCfg*   pCfg = atgetifacecfg(xIface);
+
+  while ((NULL != pInfo) && (&pInfo->cfg != pCfg))
+  {
+    pInfo = pInfo->pNext;
+  }
+
+  return pInfo;
+}
+
+/**
+ * @implements lSessionIsKeptAwake
+ *
+ */
+static bool lSessionIsKeptAwake
+(
+  const TKSalRotSessionInfo*  xpInfo
+)
+{
+  bool isKeptAwake = false;
+
+  if ((0u != xpInfo->depth) && xpInfo->isAwake &&
+      (NULL != xpInfo->pClock) && (0u != xpInfo->idleTimeoutMs))
+  {
+    /* Unsigned difference, right across the wrap around of the clock. */
+    isKeptAwake = ((uint32_t)(xpInfo->pClock() - xpInfo->wakeTimeMs) < xpInfo->idleTimeoutMs);
+  }
+
+  return isKeptAwake;
+}
+
+/**
+ * @implements lSessionSetAwake
+ *
+ */
+static void lSessionSetAwake
+(
+  TKSalRotSessionInfo*  xpInfo,
+  bool                  xIsAwake
+)
+{
+  if (xIsAwake && !xpInfo->isAwake && (NULL != xpInfo->pClock))
+  {
+    xpInfo->wakeTimeMs = xpInfo->pClock();
+  }
+
+  xpInfo->isAwake = xIsAwake;
+  xpInfo->cfg.wake_delay = xIsAwake ? 0u : xpInfo->pIfaceCfg->wake_delay;
+}
+
+/**
+ * @implements lSessionIdleOnTimeout
+ *
+ */
+static void lSessionIdleOnTimeout
+(
+  TKSalRotSessionInfo*  xpInfo,
+  ATCAIface             xIface
+)
+{
+  uint8_t address = 0u;
+
+  if ((0u != xpInfo->depth) && xpInfo->isAwake && !lSessionIsKeptAwake(xpInfo))
+  {
+    xpInfo->stats.idleCount++;
+    xpInfo->stats.idleTimeoutCount++;
+
+    if (ATCA_I2C_IFACE == xpInfo->cfg.iface_type)
+    {
+      /* Called for the wake pulse, sent to the general call address. */
+      address = ATCA_IFACECFG_I2C_ADDRESS(&xpInfo->cfg);
+      ATCA_IFACECFG_I2C_ADDRESS(&xpInfo->cfg) = ATCA_IFACECFG_I2C_ADDRESS(xpInfo->pIfaceCfg);
+      (void)lSessionNativeSend(xpInfo, xIface, C_SAL_CRYPTO_WORD_ADDRESS_IDLE, NULL, 0);
+      ATCA_IFACECFG_I2C_ADDRESS(&xpInfo->cfg) = address;
+    }
+    else
+    {
+      (void)lSessionNativeSend(xpInfo, xIface, C_SAL_CRYPTO_WORD_ADDRESS_IDLE, NULL, 0);
+    }
+
+    lSessionSetAwake(xpInfo, false);
+  }
+}
+
+/**
+ * @implements lSessionNativeSend
+ *
+ */
+static ATCA_STATUS lSessionNativeSend
+(
+  const TKSalRotSessionInfo*  xpInfo,
+  ATCAIface                   xIface,
+  uint8_t                     xWordAddress,
+  uint8_t*                    xpTxData,
+  int                         xTxLength
+)
+{
+  ATCA_STATUS status = ATCA_SUCCESS;
+
+  if ((NULL != xpInfo) && (ATCA_CUSTOM_IFACE == xpInfo->cfg.iface_type))
+  {
+    status = ATCA_IFACECFG_VALUE(xpInfo->pIfaceCfg, atcacustom.halsend)(xIface, xWordAddress,
+                                                                          xpTxData, xTxLength);
+  }
+  else
+  {
+    status = gpSalRotNativeHal->halsend(xIface, xWordAddress, xpTxData, xTxLength);
+  }
+
+  return status;
+}
+
+/**
+ * @implements lSessionNativeControl
+ *
+ */
+static ATCA_STATUS lSessionNativeControl
+(
+  const TKSalRotSessionInfo*  xpInfo,
+  ATCAIface                   xIface,
+  uint8_t                     xOption
+)
+{
+  ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+  ATCA_STATUS (*pControl)(void* xpIface) = NULL;
+
+  if ((NULL != xpInfo) && (ATCA_CUSTOM_IFACE == xpInfo->cfg.iface_type))
+  {
+    if ((uint8_t)ATCA_HAL_CONTROL_WAKE == xOption)
+    {
+      pControl = ATCA_IFACECFG_VALUE(xpInfo->pIfaceCfg, atcacustom.halwake);
+    }
+    else if ((uint8_t)ATCA_HAL_CONTROL_IDLE == xOption)
+    {
+      pControl = ATCA_IFACECFG_VALUE(xpInfo->pIfaceCfg, atcacustom.halidle);
+    }
+    else
+    {
+      pControl = ATCA_IFACECFG_VALUE(xpInfo->pIfaceCfg, atcacustom.halsleep);
+    }
+
+    if (NULL != pControl)
+    {
+      status = pControl(xIface);
+    }
+  }
+  else if (NULL != gpSalRotNativeHal->halcontrol)
+  {
+    status = gpSalRotNativeHal->halcontrol(xIface, xOption, NULL, 0u);
+  }
+  else
+  {
+    /* No control in the I2C HAL. */
+  }
+
+  return status;
+}
+
+/**
+ * @implements lSessionSend
+ *
+ */
+static ATCA_STATUS lSessionSend
+(
+  ATCAIface  xIface,
+  uint8_t    xWordAddress,
+  uint8_t*   xpTxData,
+  int        xTxLength
+)
+{
+  ATCA_STATUS           status = ATCA_SUCCESS;
+  TKSalRotSessionInfo*  pInfo = lSessionGet(xIface);
+  bool                  isBare = (NULL == xpTxData) || (0 == xTxLength);
+  bool                  isForwarded = true;
+
+  if (NULL == pInfo)
+  {
+    /* Device initialized without a session configuration. */
+  }
+  else if ((ATCA_I2C_IFACE == pInfo->cfg.iface_type) && isBare &&
+           (0u == ATCA_IFACECFG_I2C_ADDRESS(&pInfo->cfg)))
+  {
+    /* The I2C wake pulse is a transfer to the general call address. */
+    if (lSessionIsKeptAwake(pInfo))
+    {
+      pInfo->stats.wakeSkippedCount++;
+      pInfo->isWakeAnswerPending = true;
+      isForwarded = false;
+    }
+    else
+    {
+      lSessionIdleOnTimeout(pInfo, xIface);
+      pInfo->stats.wakeCount++;
+      pInfo->isWakeForwarded = true;
+    }
+  }
+  else if (isBare && (C_SAL_CRYPTO_WORD_ADDRESS_IDLE == xWordAddress))
+  {
+    if (lSessionIsKeptAwake(pInfo))
+    {
+      pInfo->stats.idleSkippedCount++;
+      isForwarded = false;
+    }
+    else
+    {
+      pInfo->stats.idleCount++;
+      lSessionSetAwake(pInfo, false);
+    }
+  }
+  else if (isBare && (C_SAL_CRYPTO_WORD_ADDRESS_SLEEP == xWordAddress))
+  {
+    lSessionSetAwake(pInfo, false);
+  }
+  else if (C_SAL_CRYPTO_WORD_ADDRESS_COMMAND == xWordAddress)
+  {
+    pInfo->stats.commandCount++;
+
+    /* A custom interface has no wake pulse, the device wakes on the command. */
+    if (ATCA_CUSTOM_IFACE == pInfo->cfg.iface_type)
+    {
+      lSessionIdleOnTimeout(pInfo, xIface);
+
+      if (!pInfo->isAwake)
+      {
+        pInfo->stats.wakeCount++;
+      }
+      else
+      {
+        pInfo->stats.wakeSkippedCount++;
+      }
+    }
+  }
+  else
+  {
+    /* Response reads and other requests. */
+  }
+
+  if (isForwarded)
+  {
+    status = lSessionNativeSend(pInfo, xIface, xWordAddress, xpTxData, xTxLength);
+  }
+
+  if ((NULL != pInfo) && isForwarded && (C_SAL_CRYPTO_WORD_ADDRESS_COMMAND == xWordAddress))
+  {
+    /* The state of a device missing a command is not known, wake it again. */
+    lSessionSetAwake(pInfo, ATCA_SUCCESS == status);
+  }
+
+  return status;
+}
+
+/**
+ * @implements lSessionReceive
+ *
+ */
+static ATCA_STATUS lSessionReceive
+(
+  ATCAIface  xIface,
+  uint8_t    xWordAddress,
+  uint8_t*   xpRxData,
+  uint16_t*  xpRxLength
+)
+{
+  ATCA_STATUS           status = ATCA_SUCCESS;
+  TKSalRotSessionInfo*  pInfo = lSessionGet(xIface);
+  uint8_t               aWakeAnswer[] = C_SAL_CRYPTO_WAKE_ANSWER;
+
+  if ((NULL != pInfo) && pInfo->isWakeAnswerPending)
+  {
+    pInfo->isWakeAnswerPending = false;
+
+    if (*xpRxLength > sizeof(aWakeAnswer))
+    {
+      *xpRxLength = (uint16_t)sizeof(aWakeAnswer);
+    }
+
+    (void)memcpy(xpRxData, aWakeAnswer, *xpRxLength);
+  }
+  else if ((NULL != pInfo) && (ATCA_CUSTOM_IFACE == pInfo->cfg.iface_type))
+  {
+    status = ATCA_IFACECFG_VALUE(pInfo->pIfaceCfg, atcacustom.halreceive)(xIface, xWordAddress,
+                                                                           xpRxData, xpRxLength);
+  }
+  else
+  {
+    status = gpSalRotNativeHal->halreceive(xIface, xWordAddress, xpRxData, xpRxLength);
+  }
+
+  if ((NULL != pInfo) && pInfo->isWakeForwarded)
+  {
+    /* The device is awake once it answered the wake pulse. */
+    pInfo->isWakeForwarded = false;
+    lSessionSetAwake(pInfo, (ATCA_SUCCESS == status) &&
+                     (sizeof(aWakeAnswer) == *xpRxLength) &&
+                     (0 == memcmp(xpRxData, aWakeAnswer, sizeof(aWakeAnswer))));
+  }
+
+  return status;
+}
+
+/**
+ * @implements lSessionControl
+ *
+ */
+static ATCA_STATUS lSessionControl
+(
+  ATCAIface  xIface,
+  uint8_t    xOption,
+  void*      xpParam,
+  size_t     xParamLen
+)
+{
+  ATCA_STATUS           status = ATCA_SUCCESS;
+  TKSalRotSessionInfo*  pInfo = lSessionGet(xIface);
+  bool                  isForwarded = true;
+
+  if (((uint8_t)ATCA_HAL_CONTROL_WAKE != xOption) &&
+      ((uint8_t)ATCA_HAL_CONTROL_IDLE != xOption) &&
+      ((uint8_t)ATCA_HAL_CONTROL_SLEEP != xOption))
+  {
+    /* Bus controls go through the I2C HAL. */
+    status = ATCA_UNIMPLEMENTED;
+
+    if (NULL != gpSalRotNativeHal->halcontrol)
+    {
+      status = gpSalRotNativeHal->halcontrol(xIface, xOption, xpParam, xParamLen);
+    }
+
+    isForwarded = false;
+  }
+  else if (NULL == pInfo)
+  {
+    /* Device initialized without a session configuration. */
+  }
+  else if ((uint8_t)ATCA_HAL_CONTROL_WAKE == xOption)
+  {
+    if (lSessionIsKeptAwake(pInfo))
+    {
+      pInfo->stats.wakeSkippedCount++;
+      isForwarded = false;
+    }
+    else
+    {
+      lSessionIdleOnTimeout(pInfo, xIface);
+      pInfo->stats.wakeCount++;
+    }
+  }
+  else if ((uint8_t)ATCA_HAL_CONTROL_IDLE == xOption)
+  {
+    if (lSessionIsKeptAwake(pInfo))
+    {
+      pInfo->stats.idleSkippedCount++;
+      isForwarded = false;
+    }
+    else
+    {
+      pInfo->stats.idleCount++;
+    }
+  }
+  else
+  {
+    /* Sleep. */
+  }
+
+  if (isForwarded)
+  {
+    status = lSessionNativeControl(pInfo, xIface, xOption);
+
+    if (NULL != pInfo)
+    {
+      lSessionSetAwake(pInfo, ((uint8_t)ATCA_HAL_CONTROL_WAKE == xOption) && (ATCA_SUCCESS == status));
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @implements lSessionHalInit
+ *
+ */
+static ATCA_STATUS lSessionHalInit
+(
+  ATCAIface      xIface,
+  ATCAIfaceCfg*  xpCfg
+)
+{
+  return gpSalRotNativeHal->halinit(xIface, xpCfg);
+}
+
+/**
+ * @implements lSessionHalPostInit
+ *
+ */
+static ATCA_STATUS lSessionHalPostInit
+(
+  ATCAIface  xIface
+)
+{
+  return gpSalRotNativeHal->halpostinit(xIface);
+}
+
+/**
+ * @implements lSessionHalRelease
+ *
+ */
+static ATCA_STATUS lSessionHalRelease
+(
+  void*  xpHalData
+)
+{
+  ATCA_STATUS status = ATCA_SUCCESS;
+
+  if (NULL != gpSalRotNativeHal->halrelease)
+  {
+    status = gpSalRotNativeHal->halrelease(xpHalData);
+  }
+
+  return status;
+}
+
+/**
+ * @implements lSessionCustomSend
+ *
+ */
+static ATCA_STATUS lSessionCustomSend
+(
+  void*     xpIface,
+  uint8_t   xWordAddress,
+  uint8_t*  xpTxData,
+  int       xTxLength
+)
+{
+  return lSessionSend((ATCAIface)xpIface, xWordAddress, xpTxData, xTxLength);
+}
+
+/**
+ * @implements lSessionCustomReceive
+ *
+ */
+static ATCA_STATUS lSessionCustomReceive
+(
+  void*      xpIface,
+  uint8_t    xWordAddress,
+  uint8_t*   xpRxData,
+  uint16_t*  xpRxLength
+)
+{
+  return lSessionReceive((ATCAIface)xpIface, xWordAddress, xpRxData, xpRxLength);
+}
+
+/**
+ * @implements lSessionCustomWake
+ *
+ */
+static ATCA_STATUS lSessionCustomWake
+(
+  void*  xpIface
+)
+{
+  return lSessionControl((ATCAIface)xpIface, (uint8_t)ATCA_HAL_CONTROL_WAKE, NULL, 0u);
+}
+
+/**
+ * @implements lSessionCustomIdle
+ *
+ */
+static ATCA_STATUS lSessionCustomIdle
+(
+  void*  xpIface
+)
+{
+  return lSessionControl((ATCAIface)xpIface, (uint8_t)ATCA_HAL_CONTROL_IDLE, NULL, 0u);
+}
+
+/**
+ * @implements lSessionCustomSleep
+ *
+ */
+static ATCA_STATUS lSessionCustomSleep
+(
+  void*  xpIface
+)
+{
+  return lSessionControl((ATCAIface)xpIface, (uint8_t)ATCA_HAL_CONTROL_SLEEP, NULL, 0u);
+}
+
+/**
+ * @implements lIdentityCheckDevice
+ *
+ */
+static void lIdentityCheckDevice
+(
+  void
+)
+{
+  ATCADevice      device = salContextGetDevice();
+  TKSalRotState*  pState = lRotState();
+
+  if (pState->identity.device != device)
+  {
+    (void)salRotInvalidateIdentity();
+    pState->identity.device = device;
+  }
+}
+
+/**
+ * @implements lRotState
+ *
+ */
+static TKSalRotState* lRotState
+(
+  void
+)
+{
+  return (TKSalRotState*)(void*)salContextGet()->aRot;
+}
+
+/**
+ * @implements lRunBegin
+ *
+ */
+static bool lRunBegin
+(
+  void
+)
+{
+  TKStatus  status = salRotSessionBegin();
+
+  if ((E_K_STATUS_OK != status) && (E_K_STATUS_NOT_SUPPORTED != status))
+  {
+    M_KTALOG__WARN("salRotSessionBegin() failed, status : %d", status);
+  }
+
+  return (E_K_STATUS_OK == status);
+}
+
+/**
+ * @implements lRunEnd
+ *
+ */
+static void lRunEnd
+(
+  bool  xIsSession
+)
+{
+  TKStatus  status = E_K_STATUS_OK;
+
+  if (xIsSession)
+  {
+    status = salRotSessionEnd();
+    if (E_K_STATUS_OK != status)
+    {
+      M_KTALOG__ERR("salRotSessionEnd() failed, status : %d", status);
+    }
+  }
+}
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
@@ -43,6 +43,7 @@
 /* -------------------------------------------------------------------------- */
 #include "k_defs.h"
 #include "k_sal.h"
+#include "k_sal_context.h"
 #include "slotConfig.h"
 #include "KTALog.h"
 #include "k_sal_storage.h"
@@ -147,6 +148,10 @@
 /** @brief Zone for doing an Encrypt Write */
 #define C_SAL_ENCRYPT_WRITE_ZONE (ATCA_ZONE_DATA|ATCA_ZONE_READWRITE_32|ATCA_ZONE_ENCRYPTED)
 
+/** @brief Encrypted write input: 32 bytes of cipher data followed by their 32-byte MAC. */
+#define C_SAL_ENCRYPT_WRITE_BLOCK_SIZE                (C_SAL_MAX_MANAGED_SLOT_DATA_SIZE + \
+                                                       C_SAL_MAX_MANAGED_SLOT_MAC_SIZE)
+
 /******************************************************************************/
 /** \brief  Set an argument/return value as unused.
 *
@@ -156,19 +161,49 @@
 #define M_UNUSED(xArg)            (void)(xArg)
 /* Sal ID Map Object. */
 
+/** @brief Object state of a SAL context, zeroed at power-on. */
+typedef struct
+{
+  bool  isEncWriteBlock1;
+  /* The next encrypted write of slot 14 goes to block 1, else block 0. */
+} TKSalObjectState;
+
+/** @brief Does not compile if C_K_SAL__CONTEXT_OBJECT_SIZE cannot hold the state. */
+typedef uint8_t TKSalObjectStateSizeCheck
+[(C_K_SAL__CONTEXT_OBJECT_SIZE >= sizeof(TKSalObjectState)) ? 1 : -1];
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
 #if LOG_KTA_ENABLE != C_KTA_LOG_LEVEL_NONE
 static const char* gpModuleName = "SALOBJECT";
 #endif
-static atca_temp_key_t gTempKey;
-static bool globalEncWriteFlag = 0;
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
 TKStatus lsalEncryptWrite(uint16_t xSlot, uint8_t* xpData, size_t xDataLen, uint8_t xblock);
+
+/**
+ * @brief
+ *   Write one encrypted 32-byte block: GenDig on the challenge TempKey, then Write.
+ *
+ * @param[in] xSlot
+ *   Slot written.
+ * @param[in] xBlock
+ *   Block of the slot written.
+ * @param[in] xpBlock
+ *   Cipher data and MAC, C_SAL_ENCRYPT_WRITE_BLOCK_SIZE bytes.
+ *
+ * @return
+ * - ATCA_SUCCESS in case of success, otherwise an error code.
+ */
+static ATCA_STATUS lsalEncryptWriteBlock
+(
+  uint16_t        xSlot,
+  uint8_t         xBlock,
+  const uint8_t*  xpBlock
+);
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
 /* -------------------------------------------------------------------------- */
@@ -196,6 +231,7 @@ K_SAL_API TKStatus salObjectKeyGen
   uint8_t*        xpPlatformStatus
 )
 {
+  ATCADevice           device = salContextGetDevice();
   TKStatus             status = E_K_STATUS_ERROR;
   ATCA_STATUS          cryptoStatus = ATCA_STATUS_UNKNOWN;
   uint8_t              aPublicKey[C_SAL_OBJ_64_BYTE_KEY_SIZE];
@@ -222,35 +258,35 @@ K_SAL_API TKStatus salObjectKeyGen
   else
   {
     (void)memset(aNumIn, 0x00, C_SAL_OBJ_RANDOM_NUM_IN_SIZE);
-    cryptoStatus = atcab_nonce_rand(aNumIn, aRandOut);
+    cryptoStatus = calib_nonce_rand(device, aNumIn, aRandOut);
 
     if (cryptoStatus != ATCA_SUCCESS)
     {
-      M_KTALOG__ERR("atcab_nonce_rand() failed with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("calib_nonce_rand() failed with ret=0x%08X", cryptoStatus);
       goto end;
     }
 
-    cryptoStatus = atcab_genkey((uint16_t)xKeyId, aPublicKey);
+    cryptoStatus = calib_genkey(device, (uint16_t)xKeyId, aPublicKey);
 
     if (cryptoStatus != ATCA_SUCCESS)
     {
-      M_KTALOG__ERR("atcab_genkey() failed with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("calib_genkey() failed with ret=0x%08X", cryptoStatus);
       goto end;
     }
 
-    cryptoStatus = atcab_genkey_base(GENKEY_MODE_DIGEST, (uint16_t)xKeyId, NULL, NULL);
+    cryptoStatus = calib_genkey_base(device, GENKEY_MODE_DIGEST, (uint16_t)xKeyId, NULL, NULL);
 
     if (cryptoStatus != ATCA_SUCCESS)
     {
-      M_KTALOG__ERR("atcab_genkey_base() failed with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("calib_genkey_base() failed with ret=0x%08X", cryptoStatus);
       goto end;
     }
 
-    cryptoStatus = atcab_sign_internal(slotSign, false, false, aSignature);
+    cryptoStatus = calib_sign_internal(device, slotSign, false, false, aSignature);
 
     if (cryptoStatus != ATCA_SUCCESS)
     {
-      M_KTALOG__ERR("atcab_sign_internal() failed with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("calib_sign_internal() failed with ret=0x%08X", cryptoStatus);
       goto end;
     }
 
@@ -469,12 +505,13 @@ K_SAL_API TKStatus salObjectDelete
   uint8_t*        xpPlatformStatus
 )
 {
-  TKStatus    status = E_K_STATUS_ERROR;
-  ATCA_STATUS cryptoStatus = ATCA_STATUS_UNKNOWN;
-  uint8_t     aTempBufZero[C_SAL_MAX_LOCAL_BUFZERO_SIZE] = {0};
-  uint8_t     aTemplifecycle[C_SAL_LIFE_CYCLE_STATE_STORAGE_ID_LENGTH] = {0x53, 0x45, 0x41, 0x4C};
-  uint8_t     aFixedInfo[] = C_KTA__FIELD_KEY_FIXED_INFO;
-  size_t      xFixedInfoLen = C_KTA__FIELD_KEY_FIXED_INFO_SIZE;
+  ATCADevice   device = salContextGetDevice();
+  TKStatus     status = E_K_STATUS_ERROR;
+  ATCA_STATUS  cryptoStatus = ATCA_STATUS_UNKNOWN;
+  uint8_t      aTempBufZero[C_SAL_MAX_LOCAL_BUFZERO_SIZE] = {0};
+  uint8_t      aTemplifecycle[C_SAL_LIFE_CYCLE_STATE_STORAGE_ID_LENGTH] = {0x53, 0x45, 0x41, 0x4C};
+  uint8_t      aFixedInfo[] = C_KTA__FIELD_KEY_FIXED_INFO;
+  size_t       xFixedInfoLen = C_KTA__FIELD_KEY_FIXED_INFO_SIZE;
   uint8_t     aSalt[] = { 0xEE, 0xA7, 0x24, 0xE1, 0xA6, 0x22, 0x3D, 0x48,
                            0xD3, 0x0D, 0x86, 0xFF, 0x4E, 0xC5, 0xBE, 0x53,
                            0x81, 0xA1, 0x81, 0xE0, 0x6D, 0x98, 0x8D, 0x72,
@@ -497,11 +534,11 @@ K_SAL_API TKStatus salObjectDelete
       if (xObjectId == C_SAL_SECRET_KEY_OBJECT_ID)
       {
         M_KTALOG__INFO("Reset device secret key");
-        cryptoStatus = atcab_genkey(C_KTA__DEVICE_PRIVATE_STORAGE_SLOT, NULL);
+        cryptoStatus = calib_genkey(device, C_KTA__DEVICE_PRIVATE_STORAGE_SLOT, NULL);
 
         if (cryptoStatus != ATCA_SUCCESS)
         {
-          M_KTALOG__ERR("atcab_genkey failed, 0x%2x", status);
+          M_KTALOG__ERR("calib_genkey failed, 0x%2x", status);
           goto end;
         }
       }
@@ -509,18 +546,18 @@ K_SAL_API TKStatus salObjectDelete
       else if (xObjectId == C_SAL_L1_FIELD_KEY_OBJECT_ID)
       {
         M_KTALOG__INFO("Reset L1 Field key");
-        cryptoStatus = atcab_nonce_load(NONCE_MODE_TARGET_TEMPKEY,
+        cryptoStatus = calib_nonce_load(device, NONCE_MODE_TARGET_TEMPKEY,
                                         aSalt,
                                         C_SAL_CRYPTO_KEY_SIZE_32_BYTE);
 
         if (cryptoStatus != ATCA_SUCCESS)
         {
-          M_KTALOG__ERR("atcab_nonce_load()  failed with ret=0x%08X", cryptoStatus);
+          M_KTALOG__ERR("calib_nonce_load()  failed with ret=0x%08X", cryptoStatus);
           goto end;
         }
 
         /* HKDF Expand. */
-        cryptoStatus = atcab_kdf(
+        cryptoStatus = calib_kdf(device,
                          KDF_MODE_ALG_HKDF | KDF_MODE_SOURCE_TEMPKEY | KDF_MODE_TARGET_SLOT,
                          C_KTA__KDF_KEY_ID,
                          KDF_DETAILS_HKDF_MSG_LOC_INPUT | (xFixedInfoLen << 24),
@@ -530,7 +567,7 @@ K_SAL_API TKStatus salObjectDelete
 
         if (cryptoStatus != ATCA_SUCCESS)
         {
-          M_KTALOG__ERR("atcab_kdf() for expand failed with ret=0x%08X", cryptoStatus);
+          M_KTALOG__ERR("calib_kdf() for expand failed with ret=0x%08X", cryptoStatus);
           goto end;
         }
       }
@@ -670,11 +707,13 @@ K_SAL_API TKStatus salGetChallenge
   uint8_t* xpPlatformStatus
 )
 {
-  ATCA_STATUS cryptoStatus = ATCA_STATUS_UNKNOWN;
-  TKStatus    status = E_K_STATUS_ERROR;
-  uint8_t     aNumIn[C_SAL_OBJ_RANDOM_NUM_IN_SIZE] = {0};
-  uint8_t     aRandOut[C_SAL_OBJ_32_BYTE_KEY_SIZE] = {0};
-  atca_nonce_in_out_t nonce_params;
+  ATCADevice           device = salContextGetDevice();
+  ATCA_STATUS          cryptoStatus = ATCA_STATUS_UNKNOWN;
+  TKStatus             status = E_K_STATUS_ERROR;
+  uint8_t              aNumIn[C_SAL_OBJ_RANDOM_NUM_IN_SIZE] = {0};
+  uint8_t              aRandOut[C_SAL_OBJ_32_BYTE_KEY_SIZE] = {0};
+  atca_temp_key_t      tempKey;
+  atca_nonce_in_out_t  nonce_params;
 
   M_KTALOG__START("Start");
   if ((NULL == xpChallengeKey) ||
@@ -685,19 +724,20 @@ K_SAL_API TKStatus salGetChallenge
   }
   else
   {
-    cryptoStatus = atcab_nonce_rand(aNumIn, aRandOut);
+    cryptoStatus = calib_nonce_rand(device, aNumIn, aRandOut);
     if (cryptoStatus != ATCA_SUCCESS)
     {
-      M_KTALOG__ERR("atcab_nonce_rand() failed with ret=0x%08X", cryptoStatus);
+      M_KTALOG__ERR("calib_nonce_rand() failed with ret=0x%08X", cryptoStatus);
       goto end;
     }
 
+    (void)memset(&tempKey, 0, sizeof(tempKey));
     (void)memset(&nonce_params, 0, sizeof(nonce_params));
     nonce_params.mode = NONCE_MODE_SEED_UPDATE;
     nonce_params.zero = 0;
     nonce_params.num_in = aNumIn;
     nonce_params.rand_out = aRandOut;
-    nonce_params.temp_key = &gTempKey;
+    nonce_params.temp_key = &tempKey;
     cryptoStatus = atcah_nonce(&nonce_params);
     if (cryptoStatus != ATCA_SUCCESS)
     {
@@ -937,121 +977,93 @@ TKStatus lsalEncryptWrite
   uint8_t  xblock
 )
 {
-  uint16_t     slot_addr      = 0;
-  TKStatus     status         = E_K_STATUS_ERROR;
-  ATCA_STATUS  cryptoStatus   = ATCA_STATUS_UNKNOWN;
-  uint8_t      other_data[4]  = {0};
-  uint8_t      writeBuffData[C_SAL_MAX_MANAGED_SLOT_DATA_SIZE] = {0};
-  uint8_t      writeBuffMac[C_SAL_MAX_MANAGED_SLOT_DATA_SIZE] = {0};
-  uint8_t      slot_14_block = 0;
-  uint8_t      aRandOut[32];
-  uint8_t      aNumIn[20] = {0};
+  TKSalObjectState*  pState         = (TKSalObjectState*)(void*)salContextGet()->aObject;
+  TKStatus           status         = E_K_STATUS_ERROR;
+  ATCA_STATUS        cryptoStatus   = ATCA_STATUS_UNKNOWN;
+  uint8_t            block          = 0;
 
+  M_UNUSED(xblock);
   M_KTALOG__START("Start");
 
-  other_data[0] = ATCA_GENDIG;
-  other_data[1] = GENDIG_ZONE_DATA;
-  other_data[2] = (uint8_t)(6 & 0xFFu);
-  other_data[3] = (uint8_t)(6 >> 8u);
+  if ((NULL == xpData) || (xDataLen < C_SAL_ENCRYPT_WRITE_BLOCK_SIZE))
+  {
+    M_KTALOG__ERR("Encrypt write needs %u bytes of data and MAC", C_SAL_ENCRYPT_WRITE_BLOCK_SIZE);
+    status = E_K_STATUS_PARAMETER;
+    goto end;
+  }
 
-  // Send the GenDig command
-  status = atcab_gendig(GENDIG_ZONE_DATA, 6, other_data, (uint8_t)sizeof(other_data));
-  if (status != ATCA_SUCCESS)
+  if (C_SAL_OBJECT_TYPE_MANAGED_SLOT_14 == xSlot)
   {
-      M_KTALOG__ERR("encrWrite: GenDig failed");
-      goto end;
+    /* Slot 14 is written one block per object, alternating between block 0 and 1. */
+    block = (!pState->isEncWriteBlock1) ? C_SAL_OBJECT_MANAGED_SLOT_14_BLOCK_0 :
+                                          C_SAL_OBJECT_MANAGED_SLOT_14_BLOCK_1;
   }
-  M_KTALOG__ERR("%d", xSlot);
-  if (C_SAL_OBJECT_TYPE_MANAGED_SLOT_5 == xSlot)
+  else if (C_SAL_OBJECT_TYPE_MANAGED_SLOT_5 != xSlot)
   {
-    cryptoStatus = atcab_get_addr(ATCA_ZONE_DATA, C_SAL_OBJECT_TYPE_MANAGED_SLOT_5, 0, 0, &slot_addr);
-    if (ATCA_SUCCESS != cryptoStatus)
-    {
-      M_KTALOG__ERR("Encrypt write failed to get addr for xSlot %d", xSlot);
-      goto end;
-    }
-
-    memcpy(writeBuffData, xpData, C_SAL_MAX_MANAGED_SLOT_DATA_SIZE);
-    memcpy(writeBuffMac, xpData+C_SAL_MAX_MANAGED_SLOT_DATA_SIZE, C_SAL_MAX_MANAGED_SLOT_DATA_SIZE);
-
-    cryptoStatus = atcab_write(C_SAL_ENCRYPT_WRITE_ZONE,
-                             slot_addr,
-                             writeBuffData,
-                             writeBuffMac);
-    if (ATCA_SUCCESS != cryptoStatus)
-    {
-      M_KTALOG__ERR("Encrypt write failed for xSlot %d : %d", xSlot, cryptoStatus);
-      status = cryptoStatus;
-      goto end;
-    }
-
-    cryptoStatus = atcab_nonce_rand(aNumIn, aRandOut);
+    M_KTALOG__ERR("No encrypt write for xSlot %d", xSlot);
+    status = E_K_STATUS_PARAMETER;
+    goto end;
+  }
 
-    if (ATCA_SUCCESS != cryptoStatus)
-    {
-      M_KTALOG__ERR("Atcab Nonce Rand Failed for xSlot %d : %d", xSlot, cryptoStatus);
-      status = cryptoStatus;
-      goto end;
-    }
+  cryptoStatus = lsalEncryptWriteBlock(xSlot, block, xpData);
+  if (ATCA_SUCCESS != cryptoStatus)
+  {
+    M_KTALOG__ERR("Encrypt write failed for xSlot %d : %d", xSlot, cryptoStatus);
+    status = (TKStatus)cryptoStatus;
+    goto end;
   }
-  else if (C_SAL_OBJECT_TYPE_MANAGED_SLOT_14 == xSlot)
+
+  if (C_SAL_OBJECT_TYPE_MANAGED_SLOT_14 == xSlot)
   {
-    M_KTALOG__INFO("Processing Slot 14 with xIdentifier: %d", xSlot);
-    if (globalEncWriteFlag == 0)
-    {
-      slot_14_block = C_SAL_OBJECT_MANAGED_SLOT_14_BLOCK_0;
-      M_KTALOG__INFO("globalEncWriteFlag is 0, setting slot_14_block to 0");
-    }
-    else
-    {
-      slot_14_block = C_SAL_OBJECT_MANAGED_SLOT_14_BLOCK_1;
-      M_KTALOG__INFO("globalEncWriteFlag is 1, setting slot_14_block to 1");
-    }
-    M_KTALOG__INFO("Current globalEncWriteFlag value: %d", globalEncWriteFlag);
-    cryptoStatus = atcab_get_addr(ATCA_ZONE_DATA, xSlot, slot_14_block, 0, &slot_addr);
-    M_KTALOG__INFO("Obtained slot address: %d", slot_addr);
-    if (ATCA_SUCCESS != cryptoStatus)
-    {
-      M_KTALOG__ERR("Failed to get address for xSlot %d, cryptoStatus: %d", xSlot, cryptoStatus);
-      goto end;
-    }
+    pState->isEncWriteBlock1 = !pState->isEncWriteBlock1;
+  }
 
-    memcpy(writeBuffData, xpData, C_SAL_MAX_MANAGED_SLOT_DATA_SIZE);
-    memcpy(writeBuffMac, xpData+C_SAL_MAX_MANAGED_SLOT_DATA_SIZE, C_SAL_MAX_MANAGED_SLOT_DATA_SIZE);
+  status = E_K_STATUS_OK;
 
-    M_KTALOG__INFO("Attempting to write to slot %d with data and MAC\r\n", slot_addr);
+end:
+  M_KTALOG__INFO("End, status : %d", status);
+  return status;
+}
 
-    cryptoStatus = atcab_write(C_SAL_ENCRYPT_WRITE_ZONE,
-                               slot_addr,
-                               writeBuffData,
-                               writeBuffMac);
-    if (ATCA_SUCCESS != cryptoStatus)
-    {
-      M_KTALOG__ERR("Encrypt write failed for xSlot %d\r\n, cryptoStatus: %d\r\n", xSlot, cryptoStatus);
-      status = cryptoStatus;
-      goto end;
-    }
-    else
-    {
-      M_KTALOG__INFO("Encrypt write successful for xSlot %d", xSlot);
-      if (globalEncWriteFlag == 0)
-      {
-        globalEncWriteFlag = 1;
-        M_KTALOG__INFO("Setting globalEncWriteFlag to 1");
-      }
-      else
-      {
-        globalEncWriteFlag = 0;
-        M_KTALOG__INFO("Setting globalEncWriteFlag to 0");
-      }
-    }
+/**
+ * @implements lsalEncryptWriteBlock
+ *
+ */
+static ATCA_STATUS lsalEncryptWriteBlock
+(
+  uint16_t        xSlot,
+  uint8_t         xBlock,
+  const uint8_t*  xpBlock
+)
+{
+  ATCADevice   device = salContextGetDevice();
+  ATCA_STATUS  cryptoStatus   = ATCA_STATUS_UNKNOWN;
+  uint16_t     slotAddr       = 0;
+  uint8_t      aOtherData[4]  = {ATCA_GENDIG, GENDIG_ZONE_DATA, C_SAL_SLOT_6_KEY_ID, 0u};
+  uint8_t      aData[C_SAL_MAX_MANAGED_SLOT_DATA_SIZE];
+  uint8_t      aMac[C_SAL_MAX_MANAGED_SLOT_MAC_SIZE];
+
+  (void)memcpy(aData, xpBlock, sizeof(aData));
+  (void)memcpy(aMac, &xpBlock[C_SAL_MAX_MANAGED_SLOT_DATA_SIZE], sizeof(aMac));
+
+  /*
+   * The write key is the challenge TempKey digested with the slot 6 key. The
+   * Write consumes TempKey, so the next block needs a new challenge; no nonce
+   * is spent here to refresh it.
+   */
+  cryptoStatus = calib_gendig(device, GENDIG_ZONE_DATA, C_SAL_SLOT_6_KEY_ID, aOtherData, (uint8_t)sizeof(aOtherData));
+
+  if (ATCA_SUCCESS == cryptoStatus)
+  {
+    cryptoStatus = calib_get_addr(ATCA_ZONE_DATA, xSlot, xBlock, 0, &slotAddr);
+  }
 
-    status = E_K_STATUS_OK;
+  if (ATCA_SUCCESS == cryptoStatus)
+  {
+    cryptoStatus = calib_write(device, C_SAL_ENCRYPT_WRITE_ZONE, slotAddr, aData, aMac);
   }
 
-end:
-  M_KTALOG__INFO("End, status : %d", status);
-  return status;
+  return cryptoStatus;
 }
 
 /* -------------------------------------------------------------------------- */
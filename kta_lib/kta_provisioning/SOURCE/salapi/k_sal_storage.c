@@ -41,6 +41,7 @@
 /* -------------------------------------------------------------------------- */
 /* IMPORTS                                                                    */
 /* -------------------------------------------------------------------------- */
+#include "k_sal_context.h"
 #include "atca_basic.h"
 #include "slotConfig.h"
 #include "cryptoConfig.h"
@@ -99,6 +100,9 @@
 /** @brief Max bytes can be written at a time to the storage. */
 #define C_SAL_MCHP_MAX_DATA_SIZE                        (4u)
 
+/** @brief Microchip block size, largest single data zone transfer. */
+#define C_SAL_MCHP_BLOCK_SIZE                           (32u)
+
 /** @brief L1 seg seed length. */
 #define C_SAL_L1_SEG_SEED_LENGTH                        (16u)
 
@@ -330,6 +334,87 @@ typedef enum
   E_WRITE
 } TOperation;
 
+/** @brief Number of storage records. */
+#define C_SAL_STORAGE_RECORD_COUNT \
+  (sizeof(gaSalStorageRecord) / sizeof(gaSalStorageRecord[0]))
+
+/**
+ * @brief Slot whose records are shadowed in RAM. Only this module accesses it
+ * and the secure element never uses it as a key, so its writes can be deferred.
+ */
+#define C_SAL_SHADOW_SLOT                               (C_KTA__STORAGE_SLOT_LIFE_CYCLE_STATE)
+
+/** @brief RAM reserved for the record shadow, the records of C_SAL_SHADOW_SLOT take 232 bytes. */
+#define C_SAL_SHADOW_POOL_SIZE                          (256u)
+
+/** @brief Shadow flag: the record has room in the pool. */
+#define C_SAL_SHADOW_FLAG_RESERVED                      (0x01u)
+
+/** @brief Shadow flag: the pool holds the record content. */
+#define C_SAL_SHADOW_FLAG_VALID                         (0x02u)
+
+/** @brief Shadow flag: the record content is not written to the secure element yet. */
+#define C_SAL_SHADOW_FLAG_DIRTY                         (0x04u)
+
+/** @brief Blocks of C_SAL_SHADOW_SLOT, a 416-byte slot. */
+#define C_SAL_SHADOW_SLOT_BLOCK_COUNT                   (13u)
+
+/** @brief Words in a block. */
+#define C_SAL_MCHP_WORDS_IN_BLOCK                       (C_SAL_MCHP_BLOCK_SIZE / C_SAL_MCHP_MAX_DATA_SIZE)
+
+/** @brief Byte of the commit marker in its block. */
+#define C_SAL_COMMIT_MARKER_POSITION \
+  ((size_t)C_KTA__COMMIT_MARKER_STORAGE_OFFSET * C_SAL_MCHP_MAX_DATA_SIZE)
+
+/** @brief First byte of a commit marker, anything else means no commit recorded. */
+#define C_SAL_COMMIT_MARKER_MAGIC                       (0xC3u)
+
+/**
+ * @brief Commit marker bytes before its CRC: the magic and its complement, or
+ * for a pending marker, its magic and the record mask.
+ */
+#define C_SAL_COMMIT_MARKER_HEADER_SIZE                 (2u)
+
+/**
+ * @brief First byte of a marker announcing a commit in progress. Then come
+ * the mask of the records it writes, see lCommitMarkerBit(), and the CRC of
+ * the words before the marker when it was written.
+ */
+#define C_SAL_COMMIT_MARKER_PENDING_MAGIC               (0x5Au)
+
+/** @brief Records a pending marker can announce, one per bit of its mask. */
+#define C_SAL_COMMIT_MARKER_RECORD_MAX                  (8u)
+
+/** @brief Shadow state of one storage record. */
+typedef struct
+{
+  size_t   poolOffset;
+  /* Offset of the record content in aShadowPool. */
+  uint8_t  flags;
+  /* C_SAL_SHADOW_FLAG_* */
+} TKSalShadowRecord;
+
+/** @brief Storage state of a SAL context, zeroed at power-on. */
+typedef struct
+{
+  TKSalShadowRecord       aShadowRecord[C_SAL_STORAGE_RECORD_COUNT];
+  /* Shadow state of each record of gaSalStorageRecord. */
+  uint8_t                 aShadowPool[C_SAL_SHADOW_POOL_SIZE];
+  /* Content of the shadowed records. */
+  size_t                  shadowPoolUsed;
+  /* Bytes of aShadowPool reserved so far. */
+  TKSalStorageCacheStats  cacheStats;
+  /* Shadow counters. */
+  uint32_t                transactionDepth;
+  /* Open salStorageBegin() calls. */
+  uint8_t                 pendingMask;
+  /* Records announced as being written by the commit marker in the secure element. */
+} TKSalStorageState;
+
+/** @brief Does not compile if C_K_SAL__CONTEXT_STORAGE_SIZE cannot hold the state. */
+typedef uint8_t TKSalStorageStateSizeCheck
+[(C_K_SAL__CONTEXT_STORAGE_SIZE >= sizeof(TKSalStorageState)) ? 1 : -1];
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
@@ -341,13 +426,14 @@ typedef enum
 static const char* gpModuleName = "SALSTORAGE";
 #endif
 
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
 
 /**
  * @brief
- *   Function to operate on storage.
+ *   Function to operate on storage, through the RAM shadow when the record has one.
  * @param[in] xLoopindex
  *   Record index.
  * @param[in] xOpt
@@ -366,6 +452,71 @@ static TKStatus lstorageOperation
   uint8_t*    xpBuff
 );
 
+/**
+ * @brief
+ *   Function to operate on the secure element storage.
+ * @param[in] xLoopindex
+ *   Record index.
+ * @param[in] xOpt
+ *   Operation to perform.
+ * @param[in] xpBuff
+ *   Buffer to store.
+ * @return
+ * - E_K_STATUS_OK for success:
+ * - E_K_STATUS_PARAMETER for wrong input values.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lstorageDeviceOperation
+(
+  uint32_t    xLoopIndex,
+  TOperation  xOpt,
+  uint8_t*    xpBuff
+);
+
+/**
+ * @brief
+ *   Get the shadow of a record, reserving its room in the pool on first use.
+ * @param[in] xLoopIndex
+ *   Record index.
+ * @return
+ * - Record content in the pool, NULL if the record is not shadowed.
+ */
+static uint8_t* lShadowGet
+(
+  uint32_t  xLoopIndex
+);
+
+/**
+ * @brief
+ *   Get the storage state of the SAL context bound by the calling thread.
+ * @return
+ * - Storage state, never NULL.
+ */
+static TKSalStorageState* lStorageState
+(
+  void
+);
+
+/**
+ * @brief
+ *   Write the pending records sharing bytes with a record, and drop their
+ *   shadow if the record is about to be written. The pending records go
+ *   through the block write of their block, so that the commit marker block
+ *   is only ever written whole, marker included.
+ * @param[in] xLoopIndex
+ *   Record index.
+ * @param[in] xOpt
+ *   Operation about to be done on the record.
+ * @return
+ * - E_K_STATUS_OK for success:
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lShadowSettleOverlaps
+(
+  uint32_t    xLoopIndex,
+  TOperation  xOpt
+);
+
 /**
  * @brief
  *   Search the index for given storage ID.
@@ -384,6 +535,113 @@ static TKStatus lSearchIndex
   uint32_t*  xpLoopcount
 );
 
+/**
+ * @brief
+ *   Plan the next transfer of a record: a full block when the record covers
+ *   it from its start, a single word otherwise.
+ * @param[in] xOffset
+ *   Word offset in the current block.
+ * @param[in] xRemaining
+ *   Bytes of the record left to transfer.
+ * @return
+ * - Transfer size in bytes, C_SAL_MCHP_BLOCK_SIZE or C_SAL_MCHP_MAX_DATA_SIZE.
+ */
+static size_t lstoragePlanAccess
+(
+  uint8_t  xOffset,
+  size_t   xRemaining
+);
+
+/**
+ * @brief
+ *   Write the pending record updates, block by block.
+ * @return
+ * - E_K_STATUS_OK for success:
+ * - E_K_STATUS_ERROR for other errors, the failed records stay pending.
+ */
+static TKStatus lShadowFlush
+(
+  void
+);
+
+/**
+ * @brief
+ *   Write the pending records of one block of C_SAL_SHADOW_SLOT in a single
+ *   block write, with the commit marker when the block holds it.
+ * @param[in] xBlock
+ *   Block of C_SAL_SHADOW_SLOT.
+ * @return
+ * - E_K_STATUS_OK for success:
+ * - E_K_STATUS_ERROR for other errors, the records stay pending.
+ */
+static TKStatus lShadowFlushBlock
+(
+  uint8_t  xBlock
+);
+
+/**
+ * @brief
+ *   Copy a block image into the shadow of the records it holds that are
+ *   neither pending nor overlapped by a pending record.
+ * @param[in] xBlock
+ *   Block of C_SAL_SHADOW_SLOT.
+ * @param[in] xpBlock
+ *   Content of the block in the secure element.
+ */
+static void lShadowFillBlock
+(
+  uint8_t         xBlock,
+  const uint8_t*  xpBlock
+);
+
+/**
+ * @brief
+ *   Compute the commit marker of the commit marker block.
+ * @param[in] xpBlock
+ *   Block content, the marker excluded.
+ * @param[in] xPendingMask
+ *   Records of the commit in progress, 0 for a completed commit.
+ * @param[out] xpMarker
+ *   C_SAL_MCHP_MAX_DATA_SIZE bytes of marker.
+ */
+static void lCommitMarker
+(
+  const uint8_t*  xpBlock,
+  uint8_t         xPendingMask,
+  uint8_t*        xpMarker
+);
+
+/**
+ * @brief
+ *   Bit of a record in the mask of a pending commit marker. Only the records
+ *   of C_SAL_SHADOW_SLOT outside the commit marker block have one, in table
+ *   order; that block is written last, clearing the pending marker.
+ * @param[in] xLoopIndex
+ *   Record index.
+ * @return
+ * - Bit of the record, 0 if the record has none.
+ */
+static uint8_t lCommitMarkerBit
+(
+  uint32_t  xLoopIndex
+);
+
+/**
+ * @brief
+ *   Announce in the commit marker, before they are written, the records of a
+ *   mask. A power cut before the commit marker block is written then leaves
+ *   a pending marker, that salStorageCheck() rolls back.
+ * @param[in] xMask
+ *   Records about to be written, see lCommitMarkerBit().
+ * @return
+ * - E_K_STATUS_OK for success:
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lCommitMarkerPending
+(
+  uint8_t  xMask
+);
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
 /* -------------------------------------------------------------------------- */
@@ -433,6 +691,14 @@ K_SAL_API TKStatus salStorageSetAndLockValue
 
     status = salStorageSetValue(xStorageDataId, xpData, xDataLen);
 
+#ifdef PRODUCTION
+    if (E_K_STATUS_OK == status)
+    {
+      /* The value must reach the secure element before the slot is locked. */
+      status = lShadowFlush();
+    }
+#endif
+
     if (E_K_STATUS_OK != status)
     {
       M_KTALOG__ERR("set value ", status);
@@ -442,7 +708,7 @@ K_SAL_API TKStatus salStorageSetAndLockValue
 
 #ifdef PRODUCTION
     /* Lock the slot in production mode */
-    device = atcab_get_device();
+    device = salContextGetDevice();
 
     if (NULL != device)
     {
@@ -747,6 +1013,212 @@ end:
   return status;
 }
 
+/**
+ * @brief  implement salStorageFlush
+ *
+ */
+K_SAL_API TKStatus salStorageFlush
+(
+  void
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+  TKStatus            status = E_K_STATUS_OK;
+
+  if (0u == pState->transactionDepth)
+  {
+    status = lShadowFlush();
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement salStorageBegin
+ *
+ */
+K_SAL_API TKStatus salStorageBegin
+(
+  void
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+
+  pState->transactionDepth++;
+
+  return E_K_STATUS_OK;
+}
+
+/**
+ * @brief  implement salStorageCommit
+ *
+ */
+K_SAL_API TKStatus salStorageCommit
+(
+  void
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+
+  if (0u != pState->transactionDepth)
+  {
+    pState->transactionDepth--;
+  }
+
+  return salStorageFlush();
+}
+
+/**
+ * @brief  implement salStorageCheck
+ *
+ */
+K_SAL_API TKStatus salStorageCheck
+(
+  uint8_t*  xpIsCommitComplete
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+  TKStatus            status = E_K_STATUS_PARAMETER;
+  ATCA_STATUS         readStatus = ATCA_STATUS_UNKNOWN;
+  ATCADevice          device = salContextGetDevice();
+  uint8_t             aBlock[C_SAL_MCHP_BLOCK_SIZE] = {0};
+  uint8_t             aMarker[C_SAL_MCHP_MAX_DATA_SIZE] = {0};
+  uint8_t*            pMarker = NULL;
+  uint8_t*            pShadow = NULL;
+  uint8_t             recordMask = 0;
+  uint8_t             pendingMask = 0;
+
+  if (NULL != xpIsCommitComplete)
+  {
+    status = E_K_STATUS_ERROR;
+    readStatus = calib_read_zone(device, ATCA_ZONE_DATA, C_KTA__COMMIT_MARKER_STORAGE_SLOT,
+                                 C_KTA__COMMIT_MARKER_STORAGE_BLOCK, 0,
+                                 aBlock, C_SAL_MCHP_BLOCK_SIZE);
+
+    if (ATCA_SUCCESS != readStatus)
+    {
+      M_KTALOG__ERR("Commit marker block not read %d", readStatus);
+    }
+    else
+    {
+      /* The same read serves the records of the block. */
+      lShadowFillBlock(C_KTA__COMMIT_MARKER_STORAGE_BLOCK, aBlock);
+      pMarker = &aBlock[C_SAL_COMMIT_MARKER_POSITION];
+      *xpIsCommitComplete = 1u;
+      status = E_K_STATUS_OK;
+
+      for (uint32_t i = 0; i < C_SAL_STORAGE_RECORD_COUNT; i++)
+      {
+        recordMask |= lCommitMarkerBit(i);
+      }
+
+      if ((C_SAL_COMMIT_MARKER_PENDING_MAGIC == pMarker[0]) && (0u != pMarker[1]) &&
+          (0u == (pMarker[1] & (uint8_t)~recordMask)))
+      {
+        pendingMask = pMarker[1];
+      }
+
+      lCommitMarker(aBlock, pendingMask, aMarker);
+
+      /*
+       * Anything but a marker, e.g. a blank or legacy RFU word, means no
+       * commit pending.
+       */
+      if (0 != memcmp(aMarker, pMarker, C_SAL_COMMIT_MARKER_HEADER_SIZE))
+      {
+        /* No commit recorded. */
+      }
+      else if (0 != memcmp(aMarker, pMarker, C_SAL_MCHP_MAX_DATA_SIZE))
+      {
+        /*
+         * The last write of a commit was torn, or the block was written
+         * without its marker. The other records were in before: keep them,
+         * the caller checks the state read from this block.
+         */
+        M_KTALOG__WARN("Commit marker block written without its marker");
+        *xpIsCommitComplete = 0u;
+      }
+      else if (0u != pendingMask)
+      {
+        /*
+         * The commit marker block, with the lifecycle state, still holds the
+         * last commit. Clear the records the interrupted one may have torn.
+         */
+        M_KTALOG__WARN("Last storage commit interrupted, records 0x%x cleared",
+                       (unsigned int)pendingMask);
+        *xpIsCommitComplete = 0u;
+        pState->pendingMask = pendingMask;
+
+        for (uint32_t i = 0; i < C_SAL_STORAGE_RECORD_COUNT; i++)
+        {
+          pShadow = (0u != (lCommitMarkerBit(i) & pendingMask)) ? lShadowGet(i) : NULL;
+
+          if (NULL != pShadow)
+          {
+            (void)memset(pShadow, 0, gaSalStorageRecord[i].storageLength);
+            pState->aShadowRecord[i].flags |=
+              (uint8_t)(C_SAL_SHADOW_FLAG_VALID | C_SAL_SHADOW_FLAG_DIRTY);
+          }
+        }
+
+        status = salStorageFlush();
+      }
+      else
+      {
+        /* Last commit completed. */
+      }
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement salStorageInvalidate
+ *
+ */
+K_SAL_API TKStatus salStorageInvalidate
+(
+  void
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+  TKStatus            status = E_K_STATUS_ERROR;
+
+  status = salStorageFlush();
+
+  for (uint32_t i = 0; i < C_SAL_STORAGE_RECORD_COUNT; i++)
+  {
+    if (0u == (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_DIRTY))
+    {
+      pState->aShadowRecord[i].flags &= (uint8_t)~C_SAL_SHADOW_FLAG_VALID;
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement salStorageGetCacheStats
+ *
+ */
+K_SAL_API TKStatus salStorageGetCacheStats
+(
+  TKSalStorageCacheStats*  xpStats
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+  TKStatus            status = E_K_STATUS_PARAMETER;
+
+  if (NULL != xpStats)
+  {
+    *xpStats = pState->cacheStats;
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
 /* -------------------------------------------------------------------------- */
@@ -801,14 +1273,93 @@ static TKStatus lstorageOperation
   TOperation  xOpt,
   uint8_t*    xpBuff
 )
+{
+  TKSalStorageState*  pState = lStorageState();
+  TKStatus            status = E_K_STATUS_ERROR;
+  uint8_t*            pShadow = NULL;
+  size_t              storageLength = 0;
+
+  if ((xLoopIndex >= C_SAL_STORAGE_RECORD_COUNT) || (NULL == xpBuff))
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("bad parameter", status);
+  }
+  else
+  {
+    storageLength = gaSalStorageRecord[xLoopIndex].storageLength;
+    pShadow = lShadowGet(xLoopIndex);
+
+    if (E_READ == xOpt)
+    {
+      if ((NULL != pShadow) &&
+          (0u != (pState->aShadowRecord[xLoopIndex].flags & C_SAL_SHADOW_FLAG_VALID)))
+      {
+        (void)memcpy(xpBuff, pShadow, storageLength);
+        pState->cacheStats.hitCount++;
+        status = E_K_STATUS_OK;
+      }
+      else
+      {
+        pState->cacheStats.missCount++;
+        status = lShadowSettleOverlaps(xLoopIndex, E_READ);
+
+        if (E_K_STATUS_OK == status)
+        {
+          status = lstorageDeviceOperation(xLoopIndex, E_READ, xpBuff);
+        }
+
+        if ((E_K_STATUS_OK == status) && (NULL != pShadow))
+        {
+          (void)memcpy(pShadow, xpBuff, storageLength);
+          pState->aShadowRecord[xLoopIndex].flags |= C_SAL_SHADOW_FLAG_VALID;
+        }
+      }
+    }
+    else
+    {
+      status = lShadowSettleOverlaps(xLoopIndex, xOpt);
+
+      if (E_K_STATUS_OK != status)
+      {
+        M_KTALOG__ERR("Overlapping records not written", status);
+      }
+      else if (NULL != pShadow)
+      {
+        (void)memcpy(pShadow, xpBuff, storageLength);
+        pState->aShadowRecord[xLoopIndex].flags |=
+          (uint8_t)(C_SAL_SHADOW_FLAG_VALID | C_SAL_SHADOW_FLAG_DIRTY);
+        pState->cacheStats.deferredWriteCount++;
+      }
+      else
+      {
+        status = lstorageDeviceOperation(xLoopIndex, xOpt, xpBuff);
+      }
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @implements lstorageDeviceOperation
+ *
+ **/
+static TKStatus lstorageDeviceOperation
+(
+  uint32_t    xLoopIndex,
+  TOperation  xOpt,
+  uint8_t*    xpBuff
+)
 {
   TKStatus     status = E_K_STATUS_ERROR;
   ATCA_STATUS  storageStatus = ATCA_STATUS_UNKNOWN;
   ATCADevice   device = NULL;
-  uint32_t     iteration = 0;
+  size_t       storageLength = 0;
+  size_t       accessSize = 0;
   uint8_t      block = 0;
   uint8_t      offset = 0;
-  uint32_t     count = 0;
+  size_t       count = 0;
+  uint32_t     transactions = 0;
 
   M_KTALOG__START("Start");
 
@@ -821,15 +1372,17 @@ static TKStatus lstorageOperation
   }
   else
   {
-    iteration = gaSalStorageRecord[xLoopIndex].storageLength / C_SAL_MCHP_MAX_DATA_SIZE;
+    storageLength = gaSalStorageRecord[xLoopIndex].storageLength;
     block = gaSalStorageRecord[xLoopIndex].block;
     offset = gaSalStorageRecord[xLoopIndex].offset;
-    device = atcab_get_device();
+    device = salContextGetDevice();
 
     if (NULL != device)
     {
-      for (uint32_t i = 0 ; i < iteration; i++)
+      while ((storageLength - count) >= C_SAL_MCHP_MAX_DATA_SIZE)
       {
+        accessSize = lstoragePlanAccess(offset, storageLength - count);
+
         if (E_READ == xOpt)
         {
           storageStatus = calib_read_zone(device,
@@ -838,7 +1391,7 @@ static TKStatus lstorageOperation
                                           block,
                                           offset,
                                           &xpBuff[count],
-                                          C_SAL_MCHP_MAX_DATA_SIZE);
+                                          (uint8_t)accessSize);
         }
         else
         {
@@ -848,7 +1401,7 @@ static TKStatus lstorageOperation
                                           block,
                                           offset,
                                           &xpBuff[count],
-                                          C_SAL_MCHP_MAX_DATA_SIZE);
+                                          (uint8_t)accessSize);
         }
 
         if (ATCA_SUCCESS != storageStatus)
@@ -857,7 +1410,10 @@ static TKStatus lstorageOperation
           break;
         }
 
-        if (offset >= C_SAL_MCHP_MAX_OFFSET_IN_BLOCK)
+        transactions++;
+
+        if ((C_SAL_MCHP_BLOCK_SIZE == accessSize) ||
+            (offset >= C_SAL_MCHP_MAX_OFFSET_IN_BLOCK))
         {
           block++;
           offset = 0;
@@ -867,8 +1423,12 @@ static TKStatus lstorageOperation
           offset++;
         }
 
-        count += C_SAL_MCHP_MAX_DATA_SIZE;
+        count += accessSize;
       }
+
+      M_KTALOG__DEBUG("Record 0x%x: %u bytes in %u transactions",
+                      (unsigned int)gaSalStorageRecord[xLoopIndex].storageID,
+                      (unsigned int)count, (unsigned int)transactions);
     }
 
     if (ATCA_SUCCESS == storageStatus)
@@ -881,6 +1441,474 @@ static TKStatus lstorageOperation
   return status;
 }
 
+/**
+ * @implements lstoragePlanAccess
+ *
+ **/
+static size_t lstoragePlanAccess
+(
+  uint8_t  xOffset,
+  size_t   xRemaining
+)
+{
+  size_t accessSize = C_SAL_MCHP_MAX_DATA_SIZE;
+
+  if ((0u == xOffset) && (xRemaining >= C_SAL_MCHP_BLOCK_SIZE))
+  {
+    accessSize = C_SAL_MCHP_BLOCK_SIZE;
+  }
+
+  return accessSize;
+}
+
+/**
+ * @implements lShadowGet
+ *
+ **/
+static uint8_t* lShadowGet
+(
+  uint32_t  xLoopIndex
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+  uint8_t*            pShadow = NULL;
+  TKSalShadowRecord*  pRecord = &pState->aShadowRecord[xLoopIndex];
+  size_t              storageLength = gaSalStorageRecord[xLoopIndex].storageLength;
+
+  if ((0u == (pRecord->flags & C_SAL_SHADOW_FLAG_RESERVED)) &&
+      (C_SAL_SHADOW_SLOT == gaSalStorageRecord[xLoopIndex].slot) &&
+      ((C_SAL_SHADOW_POOL_SIZE - pState->shadowPoolUsed) >= storageLength))
+  {
+    pRecord->poolOffset = pState->shadowPoolUsed;
+    pRecord->flags = C_SAL_SHADOW_FLAG_RESERVED;
+    pState->shadowPoolUsed += storageLength;
+  }
+
+  if (0u != (pRecord->flags & C_SAL_SHADOW_FLAG_RESERVED))
+  {
+    pShadow = &pState->aShadowPool[pRecord->poolOffset];
+  }
+
+  return pShadow;
+}
+
+/**
+ * @implements lStorageState
+ *
+ **/
+static TKSalStorageState* lStorageState
+(
+  void
+)
+{
+  return (TKSalStorageState*)(void*)salContextGet()->aStorage;
+}
+
+/**
+ * @implements lShadowSettleOverlaps
+ *
+ **/
+static TKStatus lShadowSettleOverlaps
+(
+  uint32_t    xLoopIndex,
+  TOperation  xOpt
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+  TKStatus            status = E_K_STATUS_OK;
+  size_t              start = 0;
+  size_t              end = 0;
+  size_t              otherStart = 0;
+  size_t              otherEnd = 0;
+
+  start = ((size_t)gaSalStorageRecord[xLoopIndex].block * C_SAL_MCHP_BLOCK_SIZE) +
+          ((size_t)gaSalStorageRecord[xLoopIndex].offset * C_SAL_MCHP_MAX_DATA_SIZE);
+  end = start + gaSalStorageRecord[xLoopIndex].storageLength;
+
+  for (uint32_t i = 0; (i < C_SAL_STORAGE_RECORD_COUNT) && (E_K_STATUS_OK == status); i++)
+  {
+    otherStart = ((size_t)gaSalStorageRecord[i].block * C_SAL_MCHP_BLOCK_SIZE) +
+                 ((size_t)gaSalStorageRecord[i].offset * C_SAL_MCHP_MAX_DATA_SIZE);
+    otherEnd = otherStart + gaSalStorageRecord[i].storageLength;
+
+    if ((i != xLoopIndex) &&
+        (gaSalStorageRecord[i].slot == gaSalStorageRecord[xLoopIndex].slot) &&
+        (0u != (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_VALID)) &&
+        (otherStart < end) && (start < otherEnd))
+    {
+      /* A word write would leave the commit marker stale. */
+      if (0u != (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_DIRTY))
+      {
+        status = lShadowFlushBlock(gaSalStorageRecord[i].block);
+      }
+
+      if ((E_K_STATUS_OK == status) && (E_WRITE == xOpt))
+      {
+        pState->aShadowRecord[i].flags &= (uint8_t)~C_SAL_SHADOW_FLAG_VALID;
+      }
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @implements lShadowFlush
+ *
+ **/
+static TKStatus lShadowFlush
+(
+  void
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+  TKStatus            status = E_K_STATUS_OK;
+  TKStatus            writeStatus = E_K_STATUS_OK;
+  uint32_t            aDirtyWords[C_SAL_SHADOW_SLOT_BLOCK_COUNT] = {0};
+  uint8_t             block = 0;
+  uint8_t             dirtyMask = 0;
+
+  /* Words pending per block; only C_SAL_SHADOW_SLOT has pending records. */
+  for (uint32_t i = 0; i < C_SAL_STORAGE_RECORD_COUNT; i++)
+  {
+    block = gaSalStorageRecord[i].block;
+
+    if ((0u != (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_DIRTY)) &&
+        (block < C_SAL_SHADOW_SLOT_BLOCK_COUNT))
+    {
+      aDirtyWords[block] += (uint32_t)(gaSalStorageRecord[i].storageLength / C_SAL_MCHP_MAX_DATA_SIZE);
+      dirtyMask |= lCommitMarkerBit(i);
+    }
+  }
+
+  /* One marker write announces all the records written before the marker block. */
+  status = lCommitMarkerPending(dirtyMask);
+
+  /* One block write replaces several word writes. */
+  for (uint32_t i = 0; i < C_SAL_SHADOW_SLOT_BLOCK_COUNT; i++)
+  {
+    if ((C_KTA__COMMIT_MARKER_STORAGE_BLOCK != i) && (1u < aDirtyWords[i]) &&
+        (E_K_STATUS_OK == status) &&
+        (E_K_STATUS_OK != lShadowFlushBlock((uint8_t)i)))
+    {
+      status = E_K_STATUS_ERROR;
+    }
+  }
+
+  for (uint32_t i = 0; (i < C_SAL_STORAGE_RECORD_COUNT) && (E_K_STATUS_OK == status); i++)
+  {
+    if ((C_KTA__COMMIT_MARKER_STORAGE_BLOCK != gaSalStorageRecord[i].block) &&
+        (0u != (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_DIRTY)))
+    {
+      writeStatus = lstorageDeviceOperation(i, E_WRITE,
+                                            &pState->aShadowPool[pState->aShadowRecord[i].poolOffset]);
+
+      if (E_K_STATUS_OK != writeStatus)
+      {
+        M_KTALOG__ERR("Record 0x%x not written", (unsigned int)gaSalStorageRecord[i].storageID);
+        status = E_K_STATUS_ERROR;
+      }
+      else
+      {
+        pState->aShadowRecord[i].flags &= (uint8_t)~C_SAL_SHADOW_FLAG_DIRTY;
+        pState->cacheStats.flushWriteCount++;
+      }
+    }
+  }
+
+  /*
+   * Last, once the other records are in: the commit marker block. If one of
+   * them failed, the pending marker stays until the next flush.
+   */
+  if ((E_K_STATUS_OK == status) &&
+      ((0u != aDirtyWords[C_KTA__COMMIT_MARKER_STORAGE_BLOCK]) || (0u != pState->pendingMask)) &&
+      (E_K_STATUS_OK != lShadowFlushBlock(C_KTA__COMMIT_MARKER_STORAGE_BLOCK)))
+  {
+    status = E_K_STATUS_ERROR;
+  }
+
+  return status;
+}
+
+/**
+ * @implements lShadowFlushBlock
+ *
+ **/
+static TKStatus lShadowFlushBlock
+(
+  uint8_t  xBlock
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+  TKStatus            status = E_K_STATUS_ERROR;
+  ATCA_STATUS         storageStatus = ATCA_SUCCESS;
+  ATCADevice          device = salContextGetDevice();
+  uint8_t             aBlock[C_SAL_MCHP_BLOCK_SIZE] = {0};
+  uint32_t            knownWords = 0;
+  uint32_t            recordWords = 0;
+  size_t              position = 0;
+  uint8_t             dirtyMask = 0;
+  uint8_t*            pMarker = NULL;
+
+  /* Words known from the shadow, pending or not. */
+  for (uint32_t i = 0; i < C_SAL_STORAGE_RECORD_COUNT; i++)
+  {
+    if ((C_SAL_SHADOW_SLOT == gaSalStorageRecord[i].slot) &&
+        (xBlock == gaSalStorageRecord[i].block) &&
+        (0u != (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_VALID)))
+    {
+      recordWords = (uint32_t)(gaSalStorageRecord[i].storageLength / C_SAL_MCHP_MAX_DATA_SIZE);
+      knownWords |= ((1u << recordWords) - 1u) << gaSalStorageRecord[i].offset;
+
+      if (0u != (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_DIRTY))
+      {
+        dirtyMask |= lCommitMarkerBit(i);
+      }
+    }
+  }
+
+  if (E_K_STATUS_OK != lCommitMarkerPending(dirtyMask))
+  {
+    storageStatus = ATCA_GEN_FAIL;
+  }
+
+  if (C_KTA__COMMIT_MARKER_STORAGE_BLOCK == xBlock)
+  {
+    knownWords |= 1u << C_KTA__COMMIT_MARKER_STORAGE_OFFSET;
+  }
+
+  if ((ATCA_SUCCESS == storageStatus) &&
+      (((1u << C_SAL_MCHP_WORDS_IN_BLOCK) - 1u) != (knownWords & ((1u << C_SAL_MCHP_WORDS_IN_BLOCK) - 1u))))
+  {
+    storageStatus = calib_read_zone(device, ATCA_ZONE_DATA, C_SAL_SHADOW_SLOT, xBlock, 0,
+                                    aBlock, C_SAL_MCHP_BLOCK_SIZE);
+  }
+
+  if (ATCA_SUCCESS == storageStatus)
+  {
+    /* Clean records first, so that the pending ones overwrite what they overlap. */
+    for (uint32_t pass = 0; pass < 2u; pass++)
+    {
+      for (uint32_t i = 0; i < C_SAL_STORAGE_RECORD_COUNT; i++)
+      {
+        if ((C_SAL_SHADOW_SLOT == gaSalStorageRecord[i].slot) &&
+            (xBlock == gaSalStorageRecord[i].block) &&
+            (0u != (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_VALID)) &&
+            ((0u == pass) == (0u == (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_DIRTY))))
+        {
+          position = (size_t)gaSalStorageRecord[i].offset * C_SAL_MCHP_MAX_DATA_SIZE;
+          (void)memcpy(&aBlock[position], &pState->aShadowPool[pState->aShadowRecord[i].poolOffset],
+                       gaSalStorageRecord[i].storageLength);
+        }
+      }
+    }
+
+    pMarker = &aBlock[C_SAL_COMMIT_MARKER_POSITION];
+
+    /* Inside a transaction, the records announced so far are not committed yet. */
+    if (C_KTA__COMMIT_MARKER_STORAGE_BLOCK == xBlock)
+    {
+      lCommitMarker(aBlock, (0u != pState->transactionDepth) ? pState->pendingMask : 0u,
+                    pMarker);
+    }
+
+    storageStatus = calib_write_zone(device, ATCA_ZONE_DATA, C_SAL_SHADOW_SLOT, xBlock, 0,
+                                     aBlock, C_SAL_MCHP_BLOCK_SIZE);
+  }
+
+  if (ATCA_SUCCESS != storageStatus)
+  {
+    M_KTALOG__ERR("Block %u not written %d", (unsigned int)xBlock, storageStatus);
+  }
+  else
+  {
+    for (uint32_t i = 0; i < C_SAL_STORAGE_RECORD_COUNT; i++)
+    {
+      if ((C_SAL_SHADOW_SLOT == gaSalStorageRecord[i].slot) &&
+          (xBlock == gaSalStorageRecord[i].block) &&
+          (0u != (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_DIRTY)))
+      {
+        pState->aShadowRecord[i].flags &= (uint8_t)~C_SAL_SHADOW_FLAG_DIRTY;
+        pState->cacheStats.flushWriteCount++;
+      }
+    }
+
+    if ((C_KTA__COMMIT_MARKER_STORAGE_BLOCK == xBlock) &&
+        (C_SAL_COMMIT_MARKER_PENDING_MAGIC != pMarker[0]))
+    {
+      pState->pendingMask = 0u;
+    }
+
+    lShadowFillBlock(xBlock, aBlock);
+    pState->cacheStats.blockWriteCount++;
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @implements lShadowFillBlock
+ *
+ **/
+static void lShadowFillBlock
+(
+  uint8_t         xBlock,
+  const uint8_t*  xpBlock
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+  uint8_t*            pShadow = NULL;
+  size_t              position = 0;
+  size_t              end = 0;
+  size_t              otherPosition = 0;
+  uint8_t             isStale = 0;
+
+  for (uint32_t i = 0; i < C_SAL_STORAGE_RECORD_COUNT; i++)
+  {
+    position = (size_t)gaSalStorageRecord[i].offset * C_SAL_MCHP_MAX_DATA_SIZE;
+    end = position + gaSalStorageRecord[i].storageLength;
+    isStale = 0u;
+
+    /* A pending overlapping record makes the block image stale for this one. */
+    for (uint32_t j = 0; j < C_SAL_STORAGE_RECORD_COUNT; j++)
+    {
+      otherPosition = (size_t)gaSalStorageRecord[j].offset * C_SAL_MCHP_MAX_DATA_SIZE;
+
+      if ((gaSalStorageRecord[j].slot == gaSalStorageRecord[i].slot) &&
+          (gaSalStorageRecord[j].block == gaSalStorageRecord[i].block) &&
+          (0u != (pState->aShadowRecord[j].flags & C_SAL_SHADOW_FLAG_DIRTY)) &&
+          (otherPosition < end) && (position < (otherPosition + gaSalStorageRecord[j].storageLength)))
+      {
+        isStale = 1u;
+      }
+    }
+
+    if ((C_SAL_SHADOW_SLOT == gaSalStorageRecord[i].slot) &&
+        (xBlock == gaSalStorageRecord[i].block) &&
+        (end <= C_SAL_MCHP_BLOCK_SIZE) && (0u == isStale) &&
+        (0u == (pState->aShadowRecord[i].flags & C_SAL_SHADOW_FLAG_VALID)))
+    {
+      pShadow = lShadowGet(i);
+
+      if (NULL != pShadow)
+      {
+        (void)memcpy(pShadow, &xpBlock[position], gaSalStorageRecord[i].storageLength);
+        pState->aShadowRecord[i].flags |= C_SAL_SHADOW_FLAG_VALID;
+      }
+    }
+  }
+}
+
+/**
+ * @implements lCommitMarker
+ *
+ **/
+static void lCommitMarker
+(
+  const uint8_t*  xpBlock,
+  uint8_t         xPendingMask,
+  uint8_t*        xpMarker
+)
+{
+  uint8_t  aCovered[C_SAL_COMMIT_MARKER_POSITION + C_SAL_COMMIT_MARKER_HEADER_SIZE] = {0};
+
+  (void)memcpy(aCovered, xpBlock, C_SAL_COMMIT_MARKER_POSITION);
+
+  if (0u != xPendingMask)
+  {
+    aCovered[C_SAL_COMMIT_MARKER_POSITION] = C_SAL_COMMIT_MARKER_PENDING_MAGIC;
+    aCovered[C_SAL_COMMIT_MARKER_POSITION + 1u] = xPendingMask;
+  }
+  else
+  {
+    aCovered[C_SAL_COMMIT_MARKER_POSITION] = C_SAL_COMMIT_MARKER_MAGIC;
+    aCovered[C_SAL_COMMIT_MARKER_POSITION + 1u] = (uint8_t)~C_SAL_COMMIT_MARKER_MAGIC;
+  }
+
+  (void)memcpy(xpMarker, &aCovered[C_SAL_COMMIT_MARKER_POSITION], C_SAL_COMMIT_MARKER_HEADER_SIZE);
+  atCRC(sizeof(aCovered), aCovered, &xpMarker[C_SAL_COMMIT_MARKER_HEADER_SIZE]);
+}
+
+/**
+ * @implements lCommitMarkerBit
+ *
+ **/
+static uint8_t lCommitMarkerBit
+(
+  uint32_t  xLoopIndex
+)
+{
+  uint8_t   bit = 0;
+  uint32_t  rank = 0;
+
+  for (uint32_t i = 0; i < xLoopIndex; i++)
+  {
+    if ((C_SAL_SHADOW_SLOT == gaSalStorageRecord[i].slot) &&
+        (C_KTA__COMMIT_MARKER_STORAGE_BLOCK != gaSalStorageRecord[i].block))
+    {
+      rank++;
+    }
+  }
+
+  if ((C_SAL_SHADOW_SLOT == gaSalStorageRecord[xLoopIndex].slot) &&
+      (C_KTA__COMMIT_MARKER_STORAGE_BLOCK != gaSalStorageRecord[xLoopIndex].block) &&
+      (rank < C_SAL_COMMIT_MARKER_RECORD_MAX))
+  {
+    bit = (uint8_t)(1u << rank);
+  }
+
+  return bit;
+}
+
+/**
+ * @implements lCommitMarkerPending
+ *
+ **/
+static TKStatus lCommitMarkerPending
+(
+  uint8_t  xMask
+)
+{
+  TKSalStorageState*  pState = lStorageState();
+  TKStatus            status = E_K_STATUS_OK;
+  ATCA_STATUS         storageStatus = ATCA_SUCCESS;
+  ATCADevice          device = salContextGetDevice();
+  uint8_t             mask = (uint8_t)(pState->pendingMask | xMask);
+  uint8_t             aBlock[C_SAL_MCHP_BLOCK_SIZE] = {0};
+  uint8_t             aMarker[C_SAL_MCHP_MAX_DATA_SIZE] = {0};
+
+  /* Once per commit in general, more only when records are written early. */
+  if (mask != pState->pendingMask)
+  {
+    /* The CRC covers the block as in the secure element, not as staged. */
+    storageStatus = calib_read_zone(device, ATCA_ZONE_DATA, C_SAL_SHADOW_SLOT,
+                                    C_KTA__COMMIT_MARKER_STORAGE_BLOCK, 0,
+                                    aBlock, C_SAL_MCHP_BLOCK_SIZE);
+
+    if (ATCA_SUCCESS == storageStatus)
+    {
+      lCommitMarker(aBlock, mask, aMarker);
+      storageStatus = calib_write_zone(device, ATCA_ZONE_DATA, C_SAL_SHADOW_SLOT,
+                                       C_KTA__COMMIT_MARKER_STORAGE_BLOCK,
+                                       C_KTA__COMMIT_MARKER_STORAGE_OFFSET,
+                                       aMarker, C_SAL_MCHP_MAX_DATA_SIZE);
+    }
+
+    if (ATCA_SUCCESS != storageStatus)
+    {
+      M_KTALOG__ERR("Commit marker not written %d", storageStatus);
+      status = E_K_STATUS_ERROR;
+    }
+    else
+    {
+      pState->pendingMask = mask;
+    }
+  }
+
+  return status;
+}
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
@@ -0,0 +1,290 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  Power-cut sweep of the FOTA journal on the emulated FOTA store.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file fota_powercut_test.c
+ ******************************************************************************/
+
+/**
+ * @brief Power-cut sweep of the FOTA journal on the emulated FOTA store.
+ *
+ * A reference run starts a campaign, then appends enough component updates
+ * to wrap the journal several times, so that compaction copies live entries.
+ * The run is then repeated once per page write, with a power cut on that
+ * write. After the reboot, the state must be the one before or after the
+ * interrupted operation, and must survive more updates and another reboot.
+ *
+ * Build and run: make SAL_EMULATOR=1 test
+ */
+
+#include "fotaprocess.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "k_sal_emu_fotastorage.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Component updates after the campaign start. */
+#define C_TEST_UPDATE_COUNT                        (60u)
+
+/** @brief Updates run after the reboot that follows a power cut. */
+#define C_TEST_RESUME_UPDATE_COUNT                 (40u)
+
+/** @brief Flash image of the test. */
+#define C_TEST_STORAGE_PATH                        "fota_powercut_test.bin"
+
+/** @brief State and version of each component at one point of the run. */
+typedef struct
+{
+  uint8_t  aState[COMPONENTS_MAX];
+  uint8_t  aVersionLen[COMPONENTS_MAX];
+  uint8_t  aVersion[COMPONENTS_MAX][CURRENT_MAX_LENGTH];
+} TTestSnapshot;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+
+static const TKSalEmuFotaConfig gTestConfig =
+{
+  C_TEST_STORAGE_PATH, C_SAL_EMU_FOTA_PAGE_SIZE_DEFAULT, true, 0u, 0u, false
+};
+
+static TFotaProcessState gTestState;
+
+/** @brief Snapshot after each operation, index 0 before the campaign start. */
+static TTestSnapshot gaSnapshot[C_TEST_UPDATE_COUNT + 2u];
+
+/** @brief Page writes at the end of each operation. */
+static uint32_t gaPageWrites[C_TEST_UPDATE_COUNT + 2u];
+
+/** @brief Journal entries written by each operation. */
+static uint32_t gaEntries[C_TEST_UPDATE_COUNT + 2u];
+
+static char gaName[COMPONENTS_MAX][16];
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+static void lTakeSnapshot
+(
+  TTestSnapshot*  xpSnapshot
+)
+{
+  memset(xpSnapshot, 0, sizeof(TTestSnapshot));
+  for (size_t i = 0; i < COMPONENTS_MAX; i++)
+  {
+    const TComponent* pComponent = &gTestState.componentStatus.components[i];
+
+    xpSnapshot->aState[i] = (uint8_t)gTestState.componentStatus.state[i];
+    xpSnapshot->aVersionLen[i] = (uint8_t)pComponent->componentVersionLen;
+    memcpy(xpSnapshot->aVersion[i], pComponent->componentVersion, pComponent->componentVersionLen);
+  }
+}
+
+static uint32_t lPageWrites
+(
+  void
+)
+{
+  TKSalEmuFotaStats stats;
+
+  (void)salEmuFotaGetStats(&stats);
+  return stats.pageWriteCount;
+}
+
+static void lBoot
+(
+  void
+)
+{
+  salEmuFotaTerm();
+  (void)salEmuFotaInit(&gTestConfig);
+  memset(&gTestState, 0, sizeof(gTestState));
+  fotaProcessBindState(&gTestState);
+  initializefotaState();
+}
+
+static void lUpdate
+(
+  uint32_t  xRound,
+  uint32_t  xUpdate
+)
+{
+  size_t index = (size_t)((xUpdate * 7u) % COMPONENTS_MAX);
+  char version[16];
+  int versionLen = snprintf(version, sizeof(version), "%u.%u", (unsigned int)xRound, (unsigned int)xUpdate);
+
+  (void)fotaUpdateComponent((const uint8_t*)gaName[index], strlen(gaName[index]),
+                            (const uint8_t*)version, (size_t)versionLen,
+                            (0u == (xUpdate % 3u)) ? E_FOTA_STATE_ERROR : E_FOTA_STATE_SUCCESS);
+}
+
+/**
+ * Start a campaign then run the updates, with a power cut on the
+ * xPowerCut-th page write, 0 for none. The reference run records the
+ * snapshots.
+ */
+static void lRun
+(
+  uint32_t  xPowerCut,
+  bool      xIsReference
+)
+{
+  static char aaVersion[COMPONENTS_MAX][16];
+  static char aaUrl[COMPONENTS_MAX][64];
+  TTargetComponent aTarget[COMPONENTS_MAX];
+  TComponent aComponent[COMPONENTS_MAX];
+
+  (void)remove(C_TEST_STORAGE_PATH);
+  lBoot();
+  salEmuFotaResetStats();
+  if (xIsReference)
+  {
+    lTakeSnapshot(&gaSnapshot[0]);
+  }
+
+  memset(aTarget, 0, sizeof(aTarget));
+  for (size_t i = 0; i < COMPONENTS_MAX; i++)
+  {
+    aTarget[i].componentTargetName = (uint8_t*)gaName[i];
+    aTarget[i].componentTargetNameLen = strlen(gaName[i]);
+    aTarget[i].componentTargetVersionLen = (size_t)snprintf(aaVersion[i], sizeof(aaVersion[i]), "2.0.%u", (unsigned int)i);
+    aTarget[i].componentTargetVersion = (uint8_t*)aaVersion[i];
+    aTarget[i].componentUrlLen = (size_t)snprintf(aaUrl[i], sizeof(aaUrl[i]), "https://fw.example.com/%u.bin", (unsigned int)i);
+    aTarget[i].componentUrl = (uint8_t*)aaUrl[i];
+  }
+
+  salEmuFotaSetPowerCut(xPowerCut);
+  (void)fotaDownloadAndInstall((const uint8_t*)"campaign", 8u, (const uint8_t*)"meta", 4u, aTarget, aComponent);
+  for (uint32_t op = 1u; op <= (C_TEST_UPDATE_COUNT + 1u); op++)
+  {
+    uint32_t head = gTestState.journal.headSequence;
+
+    if (op > 1u)
+    {
+      lUpdate(0u, op - 2u);
+    }
+    if (xIsReference)
+    {
+      lTakeSnapshot(&gaSnapshot[op]);
+      gaPageWrites[op] = lPageWrites();
+      gaEntries[op] = gTestState.journal.headSequence - head;
+    }
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+int main
+(
+  void
+)
+{
+  uint32_t cutCount = 0;
+  uint32_t compactionCutCount = 0;
+  uint32_t failCount = 0;
+
+  for (size_t i = 0; i < COMPONENTS_MAX; i++)
+  {
+    (void)snprintf(gaName[i], sizeof(gaName[i]), "comp%u", (unsigned int)i);
+  }
+
+  lRun(0u, true);
+  salEmuFotaTerm();
+
+  // Every page write after the campaign start
+  for (uint32_t cut = gaPageWrites[1] + 1u; cut <= gaPageWrites[C_TEST_UPDATE_COUNT + 1u]; cut++)
+  {
+    TTestSnapshot snapshot;
+    TTestSnapshot resumed;
+    uint32_t op = 2u;
+
+    while (gaPageWrites[op] < cut)
+    {
+      op++;
+    }
+    cutCount++;
+    if (gaEntries[op] > 1u)
+    {
+      // The update moved live entries before its own
+      compactionCutCount++;
+    }
+
+    lRun(cut, false);
+    lBoot();
+    lTakeSnapshot(&snapshot);
+    if ((0 != memcmp(&snapshot, &gaSnapshot[op - 1u], sizeof(snapshot))) &&
+        (0 != memcmp(&snapshot, &gaSnapshot[op], sizeof(snapshot))))
+    {
+      printf("FAIL: power cut %u during update %u left another state\n", (unsigned int)cut, (unsigned int)(op - 1u));
+      failCount++;
+    }
+
+    for (uint32_t update = 0; update < C_TEST_RESUME_UPDATE_COUNT; update++)
+    {
+      lUpdate(1u, update);
+    }
+    lTakeSnapshot(&snapshot);
+    lBoot();
+    lTakeSnapshot(&resumed);
+    if (0 != memcmp(&snapshot, &resumed, sizeof(snapshot)))
+    {
+      printf("FAIL: power cut %u, state lost after resuming\n", (unsigned int)cut);
+      failCount++;
+    }
+  }
+  salEmuFotaTerm();
+  (void)remove(C_TEST_STORAGE_PATH);
+
+  if (0u == compactionCutCount)
+  {
+    printf("FAIL: no power cut during a compaction\n");
+    failCount++;
+  }
+  printf("%u power cuts, %u during a compaction, %u failures\n",
+         (unsigned int)cutCount, (unsigned int)compactionCutCount, (unsigned int)failCount);
+
+  return (0u == failCount) ? 0 : 1;
+}
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,531 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  HTTP response parsing with the response split across reads.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file http_split_test.c
+ ******************************************************************************/
+
+/**
+ * @brief HTTP response parsing with the response split across reads.
+ *
+ * httpMsgExchange() runs over a scripted SAL com that delivers a response in
+ * given read sizes. Each response is split in two reads at every offset, then
+ * delivered one byte per read: the body must always come out whole. A
+ * response cut at any offset, or with a body larger than the buffer, must
+ * fail.
+ *
+ * The same source is built against the kta_lib copy of http.c and, with
+ * HTTP_TEST_GATEWAY, against the gateway copy. The kta_lib copy also hands
+ * the body over to a receive handler: the parts must make up the body
+ * whatever the reads, and a handler rejecting the body must stop the
+ * exchange before the rest of the response is read.
+ *
+ * Build and run: make SAL_EMULATOR=1 test
+ */
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "http_if.h"
+#include "k_sal_com.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Largest response of the test. */
+#define C_TEST_RESPONSE_MAX_SIZE                   (2200u)
+
+/** @brief Largest body of the test. */
+#define C_TEST_BODY_MAX_SIZE                       (1900u)
+
+/** @brief Response to parse and the body it carries. */
+typedef struct
+{
+  const char*  pName;
+  uint8_t      aData[C_TEST_RESPONSE_MAX_SIZE];
+  size_t       dataLen;
+  size_t       bodyLen;
+} TTestResponse;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+
+static uint8_t gaBody[C_TEST_BODY_MAX_SIZE];
+
+static TTestResponse gaResponse[3];
+
+/** @brief Response served by salComRead(). */
+static const TTestResponse* gpServed;
+
+/** @brief Read sizes, the response ends after the last one. */
+static const size_t* gpSegment;
+
+static size_t gSegmentCount;
+
+static size_t gSegmentIndex;
+
+static size_t gSegmentLeft;
+
+static size_t gServedLen;
+
+static int gComInfo;
+
+#ifndef HTTP_TEST_GATEWAY
+/** @brief Body parts handed over to the receive handler, put back together. */
+static uint8_t gaHandled[C_TEST_BODY_MAX_SIZE];
+
+static size_t gHandledLen;
+
+/** @brief Body size from which the receive handler rejects the body, 0 for never. */
+static size_t gRejectFrom;
+#endif /* HTTP_TEST_GATEWAY */
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+static size_t lAppend
+(
+  TTestResponse*  xpResponse,
+  const void*     xpData,
+  size_t          xDataLen
+)
+{
+  memcpy(&xpResponse->aData[xpResponse->dataLen], xpData, xDataLen);
+  xpResponse->dataLen += xDataLen;
+  return xDataLen;
+}
+
+static void lAppendText
+(
+  TTestResponse*  xpResponse,
+  const char*     xpText
+)
+{
+  (void)lAppend(xpResponse, xpText, strlen(xpText));
+}
+
+/** Responses shaped like keySTREAM answers, the body has CR, LF and NUL bytes. */
+static void lBuildResponses
+(
+  void
+)
+{
+  TTestResponse* pResponse = NULL;
+
+  for (size_t i = 0; i < sizeof(gaBody); i++)
+  {
+    gaBody[i] = (uint8_t)((i * 131u + 7u) ^ (i >> 3));
+  }
+  gaBody[5] = '\r';
+  gaBody[6] = '\n';
+  gaBody[7] = 0u;
+
+  pResponse = &gaResponse[0];
+  pResponse->pName = "content-length";
+  pResponse->bodyLen = 412u;
+  lAppendText(pResponse, "HTTP/1.1 200 OK\r\n"
+                         "Date: Sat, 17 Oct 2026 10:00:00 GMT\r\n"
+                         "Content-Type: application/octet-stream\r\n"
+                         "Content-Length: 412\r\n"
+                         "Connection: keep-alive\r\n"
+                         "Set-Cookie: AWSALB=abcdef0123456789; Path=/\r\n"
+                         "Strict-Transport-Security: max-age=31536000\r\n"
+                         "\r\n");
+  (void)lAppend(pResponse, gaBody, pResponse->bodyLen);
+
+  pResponse = &gaResponse[1];
+  pResponse->pName = "chunked";
+  pResponse->bodyLen = 412u;
+  lAppendText(pResponse, "HTTP/1.1 200 OK\r\n"
+                         "Content-Type: application/octet-stream\r\n"
+                         "Transfer-Encoding: chunked\r\n"
+                         "Connection: keep-alive\r\n"
+                         "\r\n"
+                         "100\r\n");
+  (void)lAppend(pResponse, gaBody, 256u);
+  lAppendText(pResponse, "\r\n80;ext=1\r\n");
+  (void)lAppend(pResponse, &gaBody[256], 128u);
+  lAppendText(pResponse, "\r\n1c\r\n");
+  (void)lAppend(pResponse, &gaBody[384], 28u);
+  lAppendText(pResponse, "\r\n0\r\nX-Trailer: 1\r\n\r\n");
+
+  pResponse = &gaResponse[2];
+  pResponse->pName = "large content-length";
+  pResponse->bodyLen = 1900u;
+  lAppendText(pResponse, "HTTP/1.1 200 OK\r\n"
+                         "Content-Type: application/octet-stream\r\n"
+                         "Content-Length: 1900\r\n"
+                         "Connection: keep-alive\r\n"
+                         "\r\n");
+  (void)lAppend(pResponse, gaBody, pResponse->bodyLen);
+}
+
+#ifndef HTTP_TEST_GATEWAY
+static TCommIfStatus lOnBody
+(
+  void*           xpContext,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+)
+{
+  (void)xpContext;
+  if ((gHandledLen + xDataLen) <= sizeof(gaHandled))
+  {
+    memcpy(&gaHandled[gHandledLen], xpData, xDataLen);
+  }
+  gHandledLen += xDataLen;
+
+  return ((0u != gRejectFrom) && (gHandledLen >= gRejectFrom)) ?
+         E_COMM_IF_STATUS_DATA : E_COMM_IF_STATUS_OK;
+}
+#endif /* HTTP_TEST_GATEWAY */
+
+/**
+ * Exchange a message while xpResponse is served in xSegmentCount reads of
+ * the given sizes. Return true if the exchange succeeded with the whole body.
+ */
+static bool lExchange
+(
+  const TTestResponse*  xpResponse,
+  const size_t*         xpSegment,
+  size_t                xSegmentCount,
+  size_t                xBufferSize
+)
+{
+  static uint8_t aBuffer[C_TEST_BODY_MAX_SIZE];
+  size_t bufferLen = xBufferSize;
+  TCommIfStatus status = E_COMM_IF_STATUS_ERROR;
+
+  gpServed = xpResponse;
+  gpSegment = xpSegment;
+  gSegmentCount = xSegmentCount;
+  gSegmentIndex = 0;
+  gSegmentLeft = 0;
+  gServedLen = 0;
+  memset(aBuffer, 0xEE, sizeof(aBuffer));
+#ifndef HTTP_TEST_GATEWAY
+  gHandledLen = 0;
+#endif /* HTTP_TEST_GATEWAY */
+
+  status = httpMsgExchange((const uint8_t*)"request", 7u, aBuffer, &bufferLen);
+
+  return (E_COMM_IF_STATUS_OK == status) &&
+#ifndef HTTP_TEST_GATEWAY
+         (gHandledLen == xpResponse->bodyLen) &&
+         (0 == memcmp(gaHandled, gaBody, gHandledLen)) &&
+#endif /* HTTP_TEST_GATEWAY */
+         (bufferLen == xpResponse->bodyLen) &&
+         (0 == memcmp(aBuffer, gaBody, bufferLen));
+}
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+/* Scripted SAL com: the request is dropped, the response comes in segments. */
+
+TKCommStatus salComInit
+(
+  uint32_t  xConnectTimeoutInMs,
+  uint32_t  xReadTimeoutInMs,
+  void**    xppComInfo
+)
+{
+  (void)xConnectTimeoutInMs;
+  (void)xReadTimeoutInMs;
+  *xppComInfo = &gComInfo;
+  return E_K_COMM_STATUS_OK;
+}
+
+TKCommStatus salComConnect
+(
+  void*           xpComInfo,
+  const uint8_t*  xpHost,
+  const uint8_t*  xpPort
+)
+{
+  (void)xpComInfo;
+  (void)xpHost;
+  (void)xpPort;
+  return E_K_COMM_STATUS_OK;
+}
+
+TKCommStatus salComWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount
+)
+{
+  (void)xpComInfo;
+  (void)xpVec;
+  (void)xVecCount;
+  return E_K_COMM_STATUS_OK;
+}
+
+TKCommStatus salComRead
+(
+  void*     xpComInfo,
+  uint8_t*  xpBuffer,
+  size_t*   xpBufferLen
+)
+{
+  size_t readLen = 0;
+
+  (void)xpComInfo;
+  if (0u == gSegmentLeft)
+  {
+    if (gSegmentIndex >= gSegmentCount)
+    {
+      // The server has nothing more to send
+      *xpBufferLen = 0;
+      return E_K_COMM_STATUS_TIMEOUT;
+    }
+    gSegmentLeft = gpSegment[gSegmentIndex];
+    gSegmentIndex++;
+  }
+
+  readLen = (gSegmentLeft < *xpBufferLen) ? gSegmentLeft : *xpBufferLen;
+  memcpy(xpBuffer, &gpServed->aData[gServedLen], readLen);
+  gServedLen += readLen;
+  gSegmentLeft -= readLen;
+  *xpBufferLen = readLen;
+  return E_K_COMM_STATUS_OK;
+}
+
+TKCommStatus salComTerm
+(
+  void*  xpComInfo
+)
+{
+  (void)xpComInfo;
+  return E_K_COMM_STATUS_OK;
+}
+
+#ifdef HTTP_TEST_GATEWAY
+/* The gateway copy also holds the idle check and the asynchronous API. */
+
+TKCommStatus salComCheck
+(
+  void*  xpComInfo
+)
+{
+  (void)xpComInfo;
+  return E_K_COMM_STATUS_OK;
+}
+
+#if defined(__linux__)
+TKCommStatus salComAsyncConnect
+(
+  uint32_t               xConnectTimeoutInMs,
+  uint32_t               xReadTimeoutInMs,
+  const uint8_t*         xpHost,
+  const uint8_t*         xpPort,
+  TKSalComEventCallback  xpCallback,
+  void*                  xpContext,
+  void**                 xppComInfo
+)
+{
+  (void)xConnectTimeoutInMs;
+  (void)xReadTimeoutInMs;
+  (void)xpHost;
+  (void)xpPort;
+  (void)xpCallback;
+  (void)xpContext;
+  (void)xppComInfo;
+  return E_K_COMM_STATUS_NOT_SUPPORTED;
+}
+
+TKCommStatus salComAsyncWatch
+(
+  void*     xpComInfo,
+  uint32_t  xEvents
+)
+{
+  (void)xpComInfo;
+  (void)xEvents;
+  return E_K_COMM_STATUS_NOT_SUPPORTED;
+}
+
+TKCommStatus salComAsyncWritev
+(
+  void*                 xpComInfo,
+  const TKSalComIoVec*  xpVec,
+  size_t                xVecCount,
+  size_t*               xpSentLen
+)
+{
+  (void)xpComInfo;
+  (void)xpVec;
+  (void)xVecCount;
+  (void)xpSentLen;
+  return E_K_COMM_STATUS_NOT_SUPPORTED;
+}
+
+TKCommStatus salComAsyncRead
+(
+  void*     xpComInfo,
+  uint8_t*  xpBuffer,
+  size_t*   xpBufferLen
+)
+{
+  (void)xpComInfo;
+  (void)xpBuffer;
+  (void)xpBufferLen;
+  return E_K_COMM_STATUS_NOT_SUPPORTED;
+}
+
+TKCommStatus salComAsyncWait
+(
+  uint32_t  xTimeoutInMs
+)
+{
+  (void)xTimeoutInMs;
+  return E_K_COMM_STATUS_NOT_SUPPORTED;
+}
+
+TKCommStatus salComAsyncTerm
+(
+  void*  xpComInfo
+)
+{
+  (void)xpComInfo;
+  return E_K_COMM_STATUS_NOT_SUPPORTED;
+}
+#endif /* __linux__ */
+#endif /* HTTP_TEST_GATEWAY */
+
+int main
+(
+  void
+)
+{
+  static size_t aSegment[C_TEST_RESPONSE_MAX_SIZE];
+  uint32_t checkCount = 0;
+  uint32_t failCount = 0;
+
+  lBuildResponses();
+  if (E_COMM_IF_STATUS_OK != httpInit(E_COMM_IF_IP_PROTOCOL_V4, (const uint8_t*)"/icpp",
+                                      (const uint8_t*)"http://keystream.example.com", 80u))
+  {
+    printf("FAIL: httpInit\n");
+    return 1;
+  }
+#ifndef HTTP_TEST_GATEWAY
+  httpSetRecvHandler(lOnBody, NULL);
+#endif /* HTTP_TEST_GATEWAY */
+
+  for (size_t r = 0; r < (sizeof(gaResponse) / sizeof(gaResponse[0])); r++)
+  {
+    const TTestResponse* pResponse = &gaResponse[r];
+    size_t length = pResponse->dataLen;
+
+    // Two reads, split at every offset
+    for (size_t split = 1u; split < length; split++)
+    {
+      aSegment[0] = split;
+      aSegment[1] = length - split;
+      checkCount++;
+      if (!lExchange(pResponse, aSegment, 2u, sizeof(gaBody)))
+      {
+        printf("FAIL: %s split at %u\n", pResponse->pName, (unsigned int)split);
+        failCount++;
+      }
+    }
+
+    // One byte per read
+    for (size_t i = 0; i < length; i++)
+    {
+      aSegment[i] = 1u;
+    }
+    checkCount++;
+    if (!lExchange(pResponse, aSegment, length, sizeof(gaBody)))
+    {
+      printf("FAIL: %s one byte per read\n", pResponse->pName);
+      failCount++;
+    }
+
+    // Cut at every offset, in two reads so that the cut may follow a split
+    for (size_t cut = 1u; cut < length; cut++)
+    {
+      aSegment[0] = (cut + 1u) / 2u;
+      aSegment[1] = cut - aSegment[0];
+      checkCount++;
+      if (lExchange(pResponse, aSegment, (0u == aSegment[1]) ? 1u : 2u, sizeof(gaBody)))
+      {
+        printf("FAIL: %s cut at %u accepted\n", pResponse->pName, (unsigned int)cut);
+        failCount++;
+      }
+    }
+
+    // Body larger than the buffer
+    aSegment[0] = length;
+    checkCount++;
+    if (lExchange(pResponse, aSegment, 1u, pResponse->bodyLen - 1u))
+    {
+      printf("FAIL: %s body larger than the buffer accepted\n", pResponse->pName);
+      failCount++;
+    }
+
+#ifndef HTTP_TEST_GATEWAY
+    // Body rejected by the handler after its first bytes, one byte per read
+    for (size_t i = 0; i < length; i++)
+    {
+      aSegment[i] = 1u;
+    }
+    gRejectFrom = 21u;
+    checkCount++;
+    if (lExchange(pResponse, aSegment, length, sizeof(gaBody)) ||
+        (gHandledLen != gRejectFrom) ||
+        (gServedLen >= length))
+    {
+      printf("FAIL: %s body rejected by the handler not stopped early\n", pResponse->pName);
+      failCount++;
+    }
+    gRejectFrom = 0;
+#endif /* HTTP_TEST_GATEWAY */
+  }
+  (void)httpTerm();
+
+  printf("%u exchanges, %u failures\n", (unsigned int)checkCount, (unsigned int)failCount);
+
+  return (0u == failCount) ? 0 : 1;
+}
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
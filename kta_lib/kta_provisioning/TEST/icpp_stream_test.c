@@ -0,0 +1,439 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  Streaming ICPP deserializer fed with split messages.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file icpp_stream_test.c
+ ******************************************************************************/
+
+/**
+ * @brief Streaming ICPP deserializer fed with split messages.
+ *
+ * A message with commands with and without fields, a 2-byte field length and
+ * an empty command is built together with the events it must raise. It is
+ * fed whole, in two chunks split at every offset, then one byte per chunk:
+ * the events, with the value parts put back together, must always be the
+ * expected ones. A message cut at any offset must not complete, and an
+ * invalid header or command length must be rejected as soon as the bytes
+ * that make it invalid are fed.
+ *
+ * Build and run: make SAL_EMULATOR=1 test
+ */
+
+#include "icpp_parser.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Largest message of the test. */
+#define C_TEST_MESSAGE_MAX_SIZE                    (1024u)
+
+/** @brief Largest event trace of the test. */
+#define C_TEST_TRACE_MAX_SIZE                      (2048u)
+
+/** @brief Events raised by a message, values put back together. */
+typedef struct
+{
+  uint8_t  aData[C_TEST_TRACE_MAX_SIZE];
+  size_t   dataLen;
+  size_t   valueOffset;
+  bool     isValueGap;
+} TTestTrace;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+
+static uint8_t gaMessage[C_TEST_MESSAGE_MAX_SIZE];
+static size_t gMessageLen;
+
+/** @brief Events the message must raise. */
+static TTestTrace gExpected;
+
+/** @brief Events raised by the current feed. */
+static TTestTrace gTrace;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+static void lTraceAppend
+(
+  TTestTrace*     xpTrace,
+  const void*     xpData,
+  size_t          xDataLen
+)
+{
+  if ((xpTrace->dataLen + xDataLen) <= sizeof(xpTrace->aData))
+  {
+    memcpy(&xpTrace->aData[xpTrace->dataLen], xpData, xDataLen);
+  }
+  xpTrace->dataLen += xDataLen;
+}
+
+static void lTraceEvent
+(
+  TTestTrace*            xpTrace,
+  TKIcppParserEventType  xEventType,
+  uint32_t               xTag,
+  size_t                 xLength
+)
+{
+  uint32_t aRecord[3] = { (uint32_t)xEventType, xTag, (uint32_t)xLength };
+
+  lTraceAppend(xpTrace, aRecord, sizeof(aRecord));
+  xpTrace->valueOffset = 0;
+}
+
+static TKParserStatus lOnEvent
+(
+  void*                     xpContext,
+  const TKIcppParserEvent*  xpEvent
+)
+{
+  TTestTrace* pTrace = (TTestTrace*)xpContext;
+
+  if (E_K_ICPP_PARSER_EVENT_VALUE == xpEvent->eventType)
+  {
+    // Parts must follow each other, whatever the chunks
+    if ((xpEvent->offset != pTrace->valueOffset) || (0u == xpEvent->length))
+    {
+      pTrace->isValueGap = true;
+    }
+    lTraceAppend(pTrace, xpEvent->pValue, xpEvent->length);
+    pTrace->valueOffset += xpEvent->length;
+  }
+  else
+  {
+    lTraceEvent(pTrace, xpEvent->eventType, xpEvent->tag, xpEvent->length);
+  }
+
+  return E_K_ICPP_PARSER_STATUS_OK;
+}
+
+static uint32_t lLengthSize
+(
+  uint8_t  xTag,
+  bool     xIsField
+)
+{
+  uint8_t twoBytes = xIsField ? C_K_ICPP_PARSER__TAG_INFO_FIELD_LEN_2BYTE :
+                                C_K_ICPP_PARSER__TAG_INFO_CMD_LEN_2BYTE;
+
+  return ((gaIcppParserTagInfo[xTag] & twoBytes) != 0u) ? 2u : 1u;
+}
+
+static void lAppendItemHeader
+(
+  uint8_t  xTag,
+  bool     xIsField,
+  size_t   xLength
+)
+{
+  gaMessage[gMessageLen++] = xTag;
+  if (2u == lLengthSize(xTag, xIsField))
+  {
+    gaMessage[gMessageLen++] = (uint8_t)(xLength >> 8);
+  }
+  gaMessage[gMessageLen++] = (uint8_t)xLength;
+  lTraceEvent(&gExpected,
+              xIsField ? E_K_ICPP_PARSER_EVENT_FIELD : E_K_ICPP_PARSER_EVENT_COMMAND,
+              xTag, xLength);
+}
+
+static void lAppendValue
+(
+  size_t   xLength,
+  uint8_t  xSeed
+)
+{
+  for (size_t i = 0; i < xLength; i++)
+  {
+    gaMessage[gMessageLen] = (uint8_t)(xSeed + (i * 7u));
+    lTraceAppend(&gExpected, &gaMessage[gMessageLen], 1u);
+    gMessageLen++;
+  }
+}
+
+static size_t lFieldSize
+(
+  uint8_t  xTag,
+  size_t   xLength
+)
+{
+  return 1u + lLengthSize(xTag, true) + xLength;
+}
+
+static void lBuildMessage
+(
+  void
+)
+{
+  static const uint8_t aHeader[C_K_ICPP_PARSER__HEADER_SIZE] =
+  {
+    0x30u, E_K_ICPP_PARSER_MESSAGE_TYPE_COMMAND,
+    1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u,
+    0x11u, 0x12u, 0x13u, 0x14u, 0x15u, 0x16u, 0x17u, 0x18u,
+    0x01u, 0u, 0u
+  };
+  const uint8_t setObject = E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT;
+  const uint8_t identifier = E_K_ICPP_PARSER_FLD_TAG_CMD_IDENTIFIER;
+  const uint8_t data = E_K_ICPP_PARSER_FLD_TAG_CMD_DATA;
+  const uint8_t attributes = E_K_ICPP_PARSER_FIELD_TAG_CMD_ATTRIBUTES;
+  const uint8_t status = E_K_ICPP_PARSER_COMMAND_TAG_PROCESSING_STATUS;
+  const uint8_t challenge = E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE;
+  size_t setObjectLen = lFieldSize(identifier, 4u) + lFieldSize(data, 300u) +
+                        lFieldSize(attributes, 0u);
+  uint32_t payloadLen;
+
+  memset(&gExpected, 0, sizeof(gExpected));
+  memcpy(gaMessage, aHeader, sizeof(aHeader));
+  gMessageLen = sizeof(aHeader);
+  lTraceEvent(&gExpected, E_K_ICPP_PARSER_EVENT_HEADER, 0, 0);
+
+  // Command with fields, one of them larger than 255 bytes, one empty
+  lAppendItemHeader(setObject, false, setObjectLen);
+  lAppendItemHeader(identifier, true, 4u);
+  lAppendValue(4u, 0x21u);
+  lAppendItemHeader(data, true, 300u);
+  lAppendValue(300u, 0x42u);
+  lAppendItemHeader(attributes, true, 0u);
+  lTraceEvent(&gExpected, E_K_ICPP_PARSER_EVENT_COMMAND_END, setObject, 0);
+
+  // Command without fields
+  lAppendItemHeader(status, false, 5u);
+  lAppendValue(5u, 0x63u);
+  lTraceEvent(&gExpected, E_K_ICPP_PARSER_EVENT_COMMAND_END, status, 0);
+
+  // Empty command
+  lAppendItemHeader(challenge, false, 0u);
+  lTraceEvent(&gExpected, E_K_ICPP_PARSER_EVENT_COMMAND_END, challenge, 0);
+  lTraceEvent(&gExpected, E_K_ICPP_PARSER_EVENT_MESSAGE_END, 0, 0);
+
+  // Payload length in the header and in the header event
+  payloadLen = (uint32_t)(gMessageLen - sizeof(aHeader));
+  gaMessage[C_K_ICPP_PARSER__HEADER_SIZE - 2u] = (uint8_t)(payloadLen >> 8);
+  gaMessage[C_K_ICPP_PARSER__HEADER_SIZE - 1u] = (uint8_t)payloadLen;
+  memcpy(&gExpected.aData[2u * sizeof(uint32_t)], &payloadLen, sizeof(payloadLen));
+}
+
+/**
+ * Feed xpMessage in chunks of the given sizes, the last one taking the rest.
+ * Return the status of the first failing feed, or of the end of message.
+ * xpFailOffset is set to the number of bytes fed when the feeds stopped.
+ */
+static TKParserStatus lFeed
+(
+  const uint8_t*  xpMessage,
+  size_t          xMessageLen,
+  const size_t*   xpChunk,
+  size_t          xChunkCount,
+  size_t*         xpFailOffset
+)
+{
+  TKIcppParserStream stream;
+  TKParserStatus status;
+  size_t offset = 0;
+  size_t len;
+
+  memset(&gTrace, 0, sizeof(gTrace));
+  status = ktaIcppParserStreamInit(&stream, lOnEvent, &gTrace);
+  for (size_t i = 0; (i < xChunkCount) && (E_K_ICPP_PARSER_STATUS_OK == status); i++)
+  {
+    len = (i == (xChunkCount - 1u)) ? (xMessageLen - offset) : xpChunk[i];
+    status = ktaIcppParserStreamFeed(&stream, &xpMessage[offset], len);
+    offset += len;
+  }
+  *xpFailOffset = offset;
+  if (E_K_ICPP_PARSER_STATUS_OK == status)
+  {
+    status = ktaIcppParserStreamEnd(&stream);
+  }
+
+  return status;
+}
+
+static bool lIsExpectedTrace
+(
+  void
+)
+{
+  return (!gTrace.isValueGap) &&
+         (gTrace.dataLen == gExpected.dataLen) &&
+         (0 == memcmp(gTrace.aData, gExpected.aData, gExpected.dataLen));
+}
+
+int main
+(
+  void
+)
+{
+  static size_t aChunk[C_TEST_MESSAGE_MAX_SIZE];
+  static uint8_t aMessage[C_TEST_MESSAGE_MAX_SIZE];
+  uint32_t checkCount = 0;
+  uint32_t failCount = 0;
+  size_t failOffset;
+  size_t commandLenOffset;
+
+  lBuildMessage();
+
+  // Whole message
+  checkCount++;
+  if ((E_K_ICPP_PARSER_STATUS_OK != lFeed(gaMessage, gMessageLen, aChunk, 1u, &failOffset)) ||
+      !lIsExpectedTrace())
+  {
+    printf("FAIL: whole message\n");
+    failCount++;
+  }
+
+  // Two chunks, split at every offset
+  for (size_t split = 1u; split < gMessageLen; split++)
+  {
+    aChunk[0] = split;
+    checkCount++;
+    if ((E_K_ICPP_PARSER_STATUS_OK != lFeed(gaMessage, gMessageLen, aChunk, 2u, &failOffset)) ||
+        !lIsExpectedTrace())
+    {
+      printf("FAIL: split at %u\n", (unsigned int)split);
+      failCount++;
+    }
+  }
+
+  // One byte per chunk
+  for (size_t i = 0; i < gMessageLen; i++)
+  {
+    aChunk[i] = 1u;
+  }
+  checkCount++;
+  if ((E_K_ICPP_PARSER_STATUS_OK != lFeed(gaMessage, gMessageLen, aChunk, gMessageLen, &failOffset)) ||
+      !lIsExpectedTrace())
+  {
+    printf("FAIL: one byte per chunk\n");
+    failCount++;
+  }
+
+  // Cut at every offset, the message does not complete
+  for (size_t cut = 1u; cut < gMessageLen; cut++)
+  {
+    aChunk[0] = cut / 2u;
+    checkCount++;
+    if (E_K_ICPP_PARSER_STATUS_OK == lFeed(gaMessage, cut, aChunk, 2u, &failOffset))
+    {
+      printf("FAIL: cut at %u accepted\n", (unsigned int)cut);
+      failCount++;
+    }
+  }
+
+  // Data after the end of message
+  memcpy(aMessage, gaMessage, gMessageLen);
+  aMessage[gMessageLen] = 0u;
+  checkCount++;
+  if (E_K_ICPP_PARSER_STATUS_ERROR != lFeed(aMessage, gMessageLen + 1u, aChunk, 1u, &failOffset))
+  {
+    printf("FAIL: data after the end of message accepted\n");
+    failCount++;
+  }
+
+  // Invalid protocol version, message type and encryption mode: rejected with the
+  // last header byte, before any event and whatever the rest of the message
+  for (size_t bad = 0; bad < 3u; bad++)
+  {
+    memcpy(aMessage, gaMessage, gMessageLen);
+    if (0u == bad)
+    {
+      aMessage[0] = 0x20u;
+    }
+    else if (1u == bad)
+    {
+      aMessage[1] = E_K_ICPP_PARSER_MSG_TYPE_RESERVED;
+    }
+    else
+    {
+      aMessage[1] |= 0x08u;
+    }
+    for (size_t split = 1u; split < C_K_ICPP_PARSER__HEADER_SIZE; split++)
+    {
+      aChunk[0] = split;
+      aChunk[1] = C_K_ICPP_PARSER__HEADER_SIZE - split;
+      checkCount++;
+      if ((E_K_ICPP_PARSER_STATUS_ERROR != lFeed(aMessage, gMessageLen, aChunk, 3u, &failOffset)) ||
+          (C_K_ICPP_PARSER__HEADER_SIZE != failOffset) ||
+          (0u != gTrace.dataLen))
+      {
+        printf("FAIL: invalid header %u split at %u not rejected with the header\n",
+               (unsigned int)bad, (unsigned int)split);
+        failCount++;
+      }
+    }
+  }
+
+  // Command length larger than the message, rejected with its last length byte
+  memcpy(aMessage, gaMessage, gMessageLen);
+  commandLenOffset = C_K_ICPP_PARSER__HEADER_SIZE + lLengthSize(aMessage[C_K_ICPP_PARSER__HEADER_SIZE], false);
+  aMessage[commandLenOffset] = 0xFFu;
+  for (size_t i = 0; i < gMessageLen; i++)
+  {
+    aChunk[i] = 1u;
+  }
+  checkCount++;
+  if ((E_K_ICPP_PARSER_STATUS_ERROR != lFeed(aMessage, gMessageLen, aChunk, gMessageLen, &failOffset)) ||
+      ((commandLenOffset + 1u) != failOffset))
+  {
+    printf("FAIL: command length larger than the message not rejected early\n");
+    failCount++;
+  }
+
+  // No operation message
+  memcpy(aMessage, gaMessage, C_K_ICPP_PARSER__HEADER_SIZE);
+  aMessage[C_K_ICPP_PARSER__HEADER_SIZE - 2u] = 0u;
+  aMessage[C_K_ICPP_PARSER__HEADER_SIZE - 1u] = 0u;
+  aChunk[0] = 7u;
+  checkCount++;
+  if (E_K_ICPP_PARSER_STATUS_NO_OPERATION != lFeed(aMessage, C_K_ICPP_PARSER__HEADER_SIZE, aChunk, 2u, &failOffset))
+  {
+    printf("FAIL: no operation message\n");
+    failCount++;
+  }
+
+  printf("%u feeds, %u failures\n", (unsigned int)checkCount, (unsigned int)failCount);
+
+  return (0u == failCount) ? 0 : 1;
+}
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
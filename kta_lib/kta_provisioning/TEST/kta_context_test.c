@@ -0,0 +1,291 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  keySTREAM Trusted Agent instances served by parallel threads.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file kta_context_test.c
+ ******************************************************************************/
+
+/**
+ * @brief keySTREAM Trusted Agent instances served by parallel threads.
+ *
+ * Each thread creates its own emulated ATECC608 and serves one KTA context on
+ * it: initialization, startup, device information, then the activation
+ * request. The instances must not see each other: every device keeps its own
+ * identity and every context its own life cycle and workspace. The built-in
+ * instance must then still work through the API without a context.
+ *
+ * Build and run: make SAL_EMULATOR=1 CAL_DIR=<host cryptoauthlib> test
+ */
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "k_kta.h"
+#include "k_sal_emu.h"
+#include "cryptoConfig.h"
+#include "atca_basic.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Virtual devices, one thread each. */
+#define C_TEST_DEVICE_COUNT                        (32u)
+
+/** @brief Device served by one thread. */
+typedef struct
+{
+  /* Instance of the device. */
+  TKtaContext  context;
+  /* Serial number read from its secure element. */
+  uint8_t      aSerialNumber[ATCA_SERIAL_NUM_SIZE];
+  /* Activation request sent to keySTREAM. */
+  uint8_t      aRequest[C_K__ICPP_MSG_MAX_SIZE];
+  size_t       requestLen;
+  /* Connection request of ktaSetDeviceInformation(). */
+  uint8_t      connectionRequest;
+  /* Failed checks of the thread. */
+  uint32_t     failCount;
+  /* Checks of the thread. */
+  uint32_t     checkCount;
+} TTestDevice;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+
+static const uint8_t gaTestSegSeed[C_K__L1_SEGMENTATION_SEED_SIZE] =
+{
+  0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu, 0x0Fu, 0x10u, 0x11u,
+  0x12u, 0x13u, 0x14u, 0x15u, 0x16u, 0x17u, 0x18u, 0x19u
+};
+
+static const uint8_t gaTestContextProfileUid[] = "ctxtest";
+
+static const uint8_t gaTestContextSerialNumber[] = { 0x01u, 0x02u, 0x03u, 0x04u };
+
+static const uint8_t gaTestContextVersion[] = { 0x01u, 0x00u };
+
+static const uint8_t gaTestDeviceProfileUid[] = "devprofile";
+
+static const uint8_t gaTestDeviceSerialNumber[] = { 0x05u, 0x06u, 0x07u, 0x08u };
+
+/** @brief No keySTREAM message yet: the exchange starts with the activation request. */
+static const uint8_t gaTestNoMessage[1] = { 0u };
+
+static TTestDevice gaTestDevice[C_TEST_DEVICE_COUNT];
+
+static TTestDevice gTestBuiltIn;
+
+static uint32_t gCheckCount;
+
+static uint32_t gFailCount;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+static void lCheck
+(
+  TTestDevice*  xpDevice,
+  bool          xIsOk,
+  const char*   xpWhat
+)
+{
+  xpDevice->checkCount++;
+  if (!xIsOk)
+  {
+    if (&gTestBuiltIn == xpDevice)
+    {
+      printf("FAIL: built-in instance, %s\n", xpWhat);
+    }
+    else
+    {
+      printf("FAIL: device %u, %s\n", (unsigned int)(xpDevice - gaTestDevice), xpWhat);
+    }
+    xpDevice->failCount++;
+  }
+}
+
+/** Run the onboarding of a device up to its activation request, xpContext NULL for the built-in instance. */
+static void lOnboard
+(
+  TTestDevice*  xpDevice,
+  TKtaContext*  xpContext
+)
+{
+  xpDevice->requestLen = sizeof(xpDevice->aRequest);
+  lCheck(xpDevice, E_K_STATUS_OK == ktaInitializeCtx(xpContext), "initialized");
+  lCheck(xpDevice, E_K_STATUS_OK == ktaStartupCtx(xpContext, gaTestSegSeed,
+                                                  gaTestContextProfileUid,
+                                                  sizeof(gaTestContextProfileUid) - 1u,
+                                                  gaTestContextSerialNumber,
+                                                  sizeof(gaTestContextSerialNumber),
+                                                  gaTestContextVersion,
+                                                  sizeof(gaTestContextVersion)),
+         "started");
+  lCheck(xpDevice, E_K_STATUS_OK == ktaSetDeviceInformationCtx(xpContext, gaTestDeviceProfileUid,
+                                                               sizeof(gaTestDeviceProfileUid) - 1u,
+                                                               gaTestDeviceSerialNumber,
+                                                               sizeof(gaTestDeviceSerialNumber),
+                                                               &xpDevice->connectionRequest),
+         "device information set");
+  lCheck(xpDevice, 1u == xpDevice->connectionRequest, "onboarding requested");
+
+  if (NULL == xpContext)
+  {
+    lCheck(xpDevice, E_K_STATUS_OK == ktaExchangeMessage(gaTestNoMessage, 0u, xpDevice->aRequest,
+                                                         &xpDevice->requestLen),
+           "activation request built");
+  }
+  else
+  {
+    lCheck(xpDevice, E_K_STATUS_OK == ktaExchangeMessageCtx(xpContext, gaTestNoMessage, 0u,
+                                                            xpDevice->aRequest,
+                                                            &xpDevice->requestLen),
+           "activation request built");
+  }
+  lCheck(xpDevice, 0u != xpDevice->requestLen, "activation request not empty");
+}
+
+/** Thread serving one device on its own emulator instance. */
+static void* lServeDevice
+(
+  void*  xpArg
+)
+{
+  TTestDevice*       pDevice = (TTestDevice*)xpArg;
+  TKSalEmuInstance*  pEmu = salEmuCreate();
+  ATCADevice         pSe = NULL;
+
+  lCheck(pDevice, NULL != pEmu, "emulator created");
+  if (NULL == pEmu)
+  {
+    return NULL;
+  }
+
+  salEmuSelect(pEmu);
+  lCheck(pDevice, E_K_STATUS_OK == salEmuInit(NULL), "emulator initialized");
+  pSe = newATCADevice(salEmuGetIfaceCfg());
+  lCheck(pDevice, NULL != pSe, "device created");
+  if (NULL != pSe)
+  {
+    lCheck(pDevice, ATCA_SUCCESS == calib_read_serial_number(pSe, pDevice->aSerialNumber),
+           "serial number read");
+    lCheck(pDevice, E_K_STATUS_OK == ktaContextInit(&pDevice->context, pSe), "context initialized");
+    lOnboard(pDevice, &pDevice->context);
+    deleteATCADevice(&pSe);
+  }
+
+  (void)salEmuTerm();
+  salEmuDestroy(pEmu);
+
+  return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+int main
+(
+  void
+)
+{
+  pthread_t aThread[C_TEST_DEVICE_COUNT];
+  bool      aIsStarted[C_TEST_DEVICE_COUNT];
+  size_t    peakSize = 0u;
+  size_t    builtInPeakSize = 1u;
+  size_t    sameSerialCount = 0u;
+
+  // Every device onboarded by its own thread, all at the same time
+  for (size_t i = 0; i < C_TEST_DEVICE_COUNT; i++)
+  {
+    aIsStarted[i] = (0 == pthread_create(&aThread[i], NULL, lServeDevice, &gaTestDevice[i]));
+  }
+  for (size_t i = 0; i < C_TEST_DEVICE_COUNT; i++)
+  {
+    if (aIsStarted[i])
+    {
+      (void)pthread_join(aThread[i], NULL);
+    }
+    lCheck(&gaTestDevice[i], aIsStarted[i], "thread created");
+  }
+
+  // Each instance kept its own device and workspace
+  for (size_t i = 0; i < C_TEST_DEVICE_COUNT; i++)
+  {
+    TTestDevice* pDevice = &gaTestDevice[i];
+
+    lCheck(pDevice, E_K_STATUS_OK == ktaGetWorkspacePeakCtx(&pDevice->context, &peakSize),
+           "workspace peak read");
+    lCheck(pDevice, 0u != peakSize, "workspace of the instance used");
+    for (size_t j = i + 1u; j < C_TEST_DEVICE_COUNT; j++)
+    {
+      if (0 == memcmp(pDevice->aSerialNumber, gaTestDevice[j].aSerialNumber,
+                      sizeof(pDevice->aSerialNumber)))
+      {
+        sameSerialCount++;
+      }
+    }
+  }
+  lCheck(&gTestBuiltIn, 0u == sameSerialCount, "one identity per device");
+  lCheck(&gTestBuiltIn, E_K_STATUS_OK == ktaGetWorkspacePeak(&builtInPeakSize),
+         "built-in workspace peak read");
+  lCheck(&gTestBuiltIn, 0u == builtInPeakSize, "built-in workspace untouched");
+
+  // The API without a context still serves the device initialized by the application
+  salEmuSelect(NULL);
+  lCheck(&gTestBuiltIn, E_K_STATUS_OK == salEmuInit(NULL), "emulator initialized");
+  lCheck(&gTestBuiltIn, ATCA_SUCCESS == atcab_init(salEmuGetIfaceCfg()), "device initialized");
+  lOnboard(&gTestBuiltIn, NULL);
+  lCheck(&gTestBuiltIn, E_K_STATUS_OK == ktaGetWorkspacePeak(&builtInPeakSize),
+         "built-in workspace peak read");
+  lCheck(&gTestBuiltIn, 0u != builtInPeakSize, "built-in workspace used");
+  (void)atcab_release();
+  (void)salEmuTerm();
+
+  for (size_t i = 0; i < C_TEST_DEVICE_COUNT; i++)
+  {
+    gCheckCount += gaTestDevice[i].checkCount;
+    gFailCount += gaTestDevice[i].failCount;
+  }
+  gCheckCount += gTestBuiltIn.checkCount;
+  gFailCount += gTestBuiltIn.failCount;
+  printf("%u devices, %u checks, %u failures\n", (unsigned int)C_TEST_DEVICE_COUNT,
+         (unsigned int)gCheckCount, (unsigned int)gFailCount);
+
+  return (0u == gFailCount) ? 0 : 1;
+}
@@ -0,0 +1,462 @@
+﻿/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2026 Nagravision SÃ rl
+
+* Subject to your compliance with these terms, you may use the Nagravision SÃ rl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  Secure element sessions on the emulated ATECC608.
+ *
+ *  \author Kudelski Labs
+ *
+ *  \date 2026/10/17
+ *
+ *  \file rot_session_test.c
+ ******************************************************************************/
+
+/**
+ * @brief Secure element sessions on the emulated ATECC608.
+ *
+ * The emulator is initialized through the interface of a session driven by a
+ * test clock. Inside a session, the idle requests after each command must be
+ * dropped while the idle timeout is not reached; once it is, the device must
+ * be put to idle before the next command, keeping TempKey. Without a clock, or
+ * on a device initialized without the session interface, every idle request
+ * goes through.
+ *
+ * The multi-block AES-CBC and HMAC calls of the crypto SAL must run in one
+ * wake period and give the same results as outside a session; their modeled
+ * latency per KB is reported.
+ *
+ * Build and run: make SAL_EMULATOR=1 CAL_DIR=<host cryptoauthlib> test
+ */
+
+#include "k_sal_rot.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "k_sal_crypto.h"
+#include "k_sal_emu.h"
+#include "atca_basic.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Commands of each burst. */
+#define C_TEST_COMMAND_COUNT                       (5u)
+
+/** @brief Host time spent per command by the test clock, in milliseconds. */
+#define C_TEST_COMMAND_TIME_MS                     (40u)
+
+/** @brief Slot holding the HMAC key (block 0) and the AES key (block 2). */
+#define C_TEST_KEY_SLOT                            (9u)
+
+/** @brief Header authenticated but not encrypted, as an ICPP header. */
+#define C_TEST_HEADER_SIZE                         (16u)
+
+/** @brief Data encrypted per call, a 2 KB ICPP message. */
+#define C_TEST_DATA_SIZE                           (2048u)
+
+/** @brief I2C transfer time per byte at 400 kHz, in microseconds. */
+#define C_TEST_BUS_BYTE_TIME_US                    (23u)
+
+/** @brief Result of a multi-block run. */
+typedef struct
+{
+  /* Header followed by the encrypted data. */
+  uint8_t   aData[C_TEST_HEADER_SIZE + C_TEST_DATA_SIZE];
+  /* MAC of the header and encrypted data. */
+  uint8_t   aMac[C_K_KTA__HMAC_MAX_SIZE];
+  /* Modeled device time of the encryption, in microseconds. */
+  uint64_t  encryptTimeUs;
+  /* Modeled device time of the decryption, in microseconds. */
+  uint64_t  decryptTimeUs;
+  /* Wakes of the encryption and decryption. */
+  uint32_t  wakeCount;
+} TTestCryptoRun;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+
+static TKSalRotSession gTestSession;
+
+static uint32_t gTestClockMs;
+
+static uint32_t gCheckCount;
+
+static uint32_t gFailCount;
+
+static TTestCryptoRun gTestRun;
+
+static TTestCryptoRun gTestReference;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+static void lCheck
+(
+  bool         xIsOk,
+  const char*  xpWhat
+)
+{
+  gCheckCount++;
+  if (!xIsOk)
+  {
+    printf("FAIL: %s\n", xpWhat);
+    gFailCount++;
+  }
+}
+
+static uint32_t lClock
+(
+  void
+)
+{
+  return gTestClockMs;
+}
+
+static uint32_t lEmuIdleCount
+(
+  void
+)
+{
+  TKSalEmuStats stats;
+
+  (void)salEmuGetStats(&stats);
+  return stats.idleCount;
+}
+
+static TKSalRotSessionStats lSessionStats
+(
+  void
+)
+{
+  TKSalRotSessionStats stats;
+
+  (void)salRotSessionGetStats(&gTestSession, &stats);
+  return stats;
+}
+
+/** Initialize the emulator through a session, xpClock NULL for none. */
+static void lInit
+(
+  TKSalRotClock  xpClock
+)
+{
+  (void)salEmuInit(NULL);
+  lCheck(E_K_STATUS_OK == salRotSessionInit(&gTestSession, salEmuGetIfaceCfg(),
+                                            C_K_KTA__ROT_SESSION_IDLE_TIMEOUT_MS, xpClock),
+         "session initialized");
+  lCheck(ATCA_SUCCESS == atcab_init((ATCAIfaceCfg*)salRotSessionGetIfaceCfg(&gTestSession)),
+         "device initialized with the session interface");
+  gTestClockMs = 0xFFFFFF00u;
+}
+
+static void lTerm
+(
+  void
+)
+{
+  (void)atcab_release();
+  (void)salEmuTerm();
+}
+
+/** Run a burst of commands, the test clock moving on with each. */
+static void lRunBurst
+(
+  void
+)
+{
+  uint8_t aRandom[32];
+
+  for (uint32_t i = 0; i < C_TEST_COMMAND_COUNT; i++)
+  {
+    lCheck(ATCA_SUCCESS == atcab_random(aRandom), "random");
+    gTestClockMs += C_TEST_COMMAND_TIME_MS;
+  }
+}
+
+/** Encrypt with TempKey loaded by an earlier command, xDelayMs later. */
+static void lEncryptWithTempKey
+(
+  uint32_t  xDelayMs,
+  uint8_t*  xpCipher
+)
+{
+  uint8_t aKey[32];
+  uint8_t aPlain[16];
+
+  for (size_t i = 0; i < sizeof(aKey); i++)
+  {
+    aKey[i] = (uint8_t)(0xA5u ^ i);
+  }
+  (void)memset(aPlain, 0x3C, sizeof(aPlain));
+
+  lCheck(ATCA_SUCCESS == atcab_nonce_load(NONCE_MODE_TARGET_TEMPKEY, aKey, sizeof(aKey)),
+         "TempKey loaded");
+  gTestClockMs += xDelayMs;
+  lCheck(ATCA_SUCCESS == atcab_aes_encrypt(ATCA_TEMPKEY_KEYID, 0u, aPlain, xpCipher),
+         "encrypted with TempKey");
+}
+
+/** Initialize the emulator with its latency model, through a session if asked. */
+static void lInitCrypto
+(
+  bool  xIsSession
+)
+{
+  TKSalEmuConfig  config;
+  uint8_t         aKeys[64];
+  ATCAIfaceCfg*   pCfg = NULL;
+
+  (void)memset(&config, 0, sizeof(config));
+  config.latencyScale = 100u;
+  config.busByteTimeUs = C_TEST_BUS_BYTE_TIME_US;
+  (void)salEmuInit(&config);
+
+  pCfg = salEmuGetIfaceCfg();
+  if (xIsSession)
+  {
+    lCheck(E_K_STATUS_OK == salRotSessionInit(&gTestSession, pCfg,
+                                              C_K_KTA__ROT_SESSION_IDLE_TIMEOUT_MS, lClock),
+           "session initialized");
+    pCfg = (ATCAIfaceCfg*)salRotSessionGetIfaceCfg(&gTestSession);
+  }
+
+  lCheck(ATCA_SUCCESS == atcab_init(pCfg), "device initialized");
+  gTestClockMs = 0u;
+
+  for (size_t i = 0; i < sizeof(aKeys); i++)
+  {
+    aKeys[i] = (uint8_t)(0x5Au + (i * 7u));
+  }
+  lCheck(ATCA_SUCCESS == atcab_write_bytes_zone(ATCA_ZONE_DATA, C_TEST_KEY_SLOT, 0u,
+                                                aKeys, sizeof(aKeys)),
+         "keys written");
+}
+
+/** Encrypt and sign the test message in place, then decrypt it back. */
+static void lRunCrypto
+(
+  TTestCryptoRun*  xpRun
+)
+{
+  TKSalEmuStats  before;
+  TKSalEmuStats  middle;
+  TKSalEmuStats  after;
+  uint8_t        aPlain[C_TEST_DATA_SIZE];
+  size_t         plainLen = sizeof(aPlain);
+
+  for (size_t i = 0; i < sizeof(xpRun->aData); i++)
+  {
+    xpRun->aData[i] = (uint8_t)(i ^ (i >> 8));
+  }
+
+  (void)salEmuGetStats(&before);
+  lCheck(E_K_STATUS_OK == salCryptoAesEncHmac(C_K_KTA__VOLATILE_3_ID, C_K_KTA__VOLATILE_2_ID,
+                                              xpRun->aData, C_TEST_HEADER_SIZE,
+                                              C_TEST_DATA_SIZE, xpRun->aMac),
+         "encrypted and signed");
+  (void)salEmuGetStats(&middle);
+  lCheck(E_K_STATUS_OK == salCryptoHmacVerify(C_K_KTA__VOLATILE_2_ID, xpRun->aData,
+                                              sizeof(xpRun->aData), xpRun->aMac),
+         "MAC verified");
+  lCheck(E_K_STATUS_OK == salCryptoAesDec(C_K_KTA__VOLATILE_3_ID,
+                                          &xpRun->aData[C_TEST_HEADER_SIZE], C_TEST_DATA_SIZE,
+                                          aPlain, &plainLen),
+         "decrypted");
+  (void)salEmuGetStats(&after);
+
+  lCheck(plainLen == C_TEST_DATA_SIZE, "decrypted length");
+  for (size_t i = 0; i < C_TEST_DATA_SIZE; i++)
+  {
+    if (aPlain[i] != (uint8_t)((i + C_TEST_HEADER_SIZE) ^ ((i + C_TEST_HEADER_SIZE) >> 8)))
+    {
+      lCheck(false, "decrypted data");
+      break;
+    }
+  }
+
+  xpRun->encryptTimeUs = middle.emulatedTimeUs - before.emulatedTimeUs;
+  xpRun->decryptTimeUs = after.emulatedTimeUs - middle.emulatedTimeUs;
+  xpRun->wakeCount = after.wakeCount - before.wakeCount;
+}
+
+/** Print the modeled latency per KB of a run. */
+static void lReportCrypto
+(
+  const char*            xpWhat,
+  const TTestCryptoRun*  xpRun
+)
+{
+  printf("%s: encrypt and sign %u us/KB, verify and decrypt %u us/KB, %u wakes\n",
+         xpWhat,
+         (unsigned int)((xpRun->encryptTimeUs * 1024u) / C_TEST_DATA_SIZE),
+         (unsigned int)((xpRun->decryptTimeUs * 1024u) / C_TEST_DATA_SIZE),
+         (unsigned int)xpRun->wakeCount);
+}
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+int main
+(
+  void
+)
+{
+  TKSalRotSessionStats before;
+  TKSalRotSessionStats after;
+  uint32_t idleCount;
+  uint8_t aReference[16];
+  uint8_t aCipher[16];
+
+  // Outside a session, every command is followed by an idle
+  lInit(lClock);
+  idleCount = lEmuIdleCount();
+  lRunBurst();
+  lCheck((lEmuIdleCount() - idleCount) == C_TEST_COMMAND_COUNT, "one idle per command outside a session");
+  lCheck(E_K_STATUS_STATE == salRotSessionEnd(), "end without a session");
+
+  // Inside a session, the idles are dropped until its end
+  before = lSessionStats();
+  idleCount = lEmuIdleCount();
+  lCheck(E_K_STATUS_OK == salRotSessionBegin(), "session begins");
+  lCheck(E_K_STATUS_OK == salRotSessionBegin(), "nested session begins");
+  lRunBurst();
+  lCheck(E_K_STATUS_OK == salRotSessionEnd(), "nested session ends");
+  lCheck(lEmuIdleCount() == idleCount, "device kept awake by the outer session");
+  lCheck(E_K_STATUS_OK == salRotSessionEnd(), "session ends");
+  after = lSessionStats();
+  lCheck((lEmuIdleCount() - idleCount) == 1u, "one idle at the end of the session");
+  lCheck((after.idleSkippedCount - before.idleSkippedCount) == C_TEST_COMMAND_COUNT,
+         "idle of each command dropped");
+  lCheck((after.wakeCount - before.wakeCount) == 1u, "one wake per session");
+  lCheck((after.sessionCount - before.sessionCount) == 1u, "one session counted");
+
+  // The idle timeout puts the device to idle between two commands, TempKey kept
+  lEncryptWithTempKey(0u, aReference);
+  before = lSessionStats();
+  lCheck(E_K_STATUS_OK == salRotSessionBegin(), "session begins");
+  lEncryptWithTempKey(C_K_KTA__ROT_SESSION_IDLE_TIMEOUT_MS, aCipher);
+  lCheck(E_K_STATUS_OK == salRotSessionEnd(), "session ends");
+  after = lSessionStats();
+  lCheck((after.idleTimeoutCount - before.idleTimeoutCount) == 1u, "idle on timeout");
+  lCheck((after.wakeCount - before.wakeCount) == 2u, "wake after the idle on timeout");
+  lCheck(0 == memcmp(aReference, aCipher, sizeof(aCipher)), "TempKey kept across the idle");
+
+  // Commands spread over several timeouts
+  before = lSessionStats();
+  lCheck(E_K_STATUS_OK == salRotSessionBegin(), "session begins");
+  for (uint32_t i = 0; i < 4u; i++)
+  {
+    lRunBurst();
+    gTestClockMs += C_K_KTA__ROT_SESSION_IDLE_TIMEOUT_MS;
+  }
+  lCheck(E_K_STATUS_OK == salRotSessionEnd(), "session ends");
+  after = lSessionStats();
+  lCheck((after.idleTimeoutCount - before.idleTimeoutCount) == 3u, "idle once per timeout");
+  lTerm();
+
+  // Without a clock, the device is never kept awake
+  lInit(NULL);
+  idleCount = lEmuIdleCount();
+  lCheck(E_K_STATUS_OK == salRotSessionBegin(), "session begins");
+  lRunBurst();
+  lCheck(E_K_STATUS_OK == salRotSessionEnd(), "session ends");
+  lCheck((lEmuIdleCount() - idleCount) == C_TEST_COMMAND_COUNT, "one idle per command without a clock");
+  lTerm();
+
+  // A device initialized without the session interface has no session
+  (void)salEmuInit(NULL);
+  (void)atcab_init(salEmuGetIfaceCfg());
+  lCheck(E_K_STATUS_NOT_SUPPORTED == salRotSessionBegin(), "no session without its interface");
+  lCheck(E_K_STATUS_NOT_SUPPORTED == salRotSessionEnd(), "no session to end");
+  lTerm();
+
+  // Multi-block runs without a session: the reference, one wake per command
+  lInitCrypto(false);
+  lRunCrypto(&gTestReference);
+  lCheck(gTestReference.wakeCount > (C_TEST_DATA_SIZE / ATCA_AES128_BLOCK_SIZE),
+         "one wake per command without a session");
+  lReportCrypto("Without a session", &gTestReference);
+  lTerm();
+
+  // Each multi-block call runs in its own session: one wake per call
+  lInitCrypto(true);
+  before = lSessionStats();
+  lRunCrypto(&gTestRun);
+  after = lSessionStats();
+  lCheck(gTestRun.wakeCount == 3u, "one wake per multi-block call");
+  lCheck((after.sessionCount - before.sessionCount) == 3u, "one session per multi-block call");
+  lCheck(0 == memcmp(gTestRun.aData, gTestReference.aData, sizeof(gTestRun.aData)),
+         "same cipher in a session");
+  lCheck(0 == memcmp(gTestRun.aMac, gTestReference.aMac, sizeof(gTestRun.aMac)),
+         "same MAC in a session");
+  lCheck(gTestRun.encryptTimeUs < gTestReference.encryptTimeUs, "encryption faster in a session");
+  lCheck(gTestRun.decryptTimeUs < gTestReference.decryptTimeUs, "decryption faster in a session");
+  lReportCrypto("In a session", &gTestRun);
+
+  // Inside an outer session, as opened around each KTA call: a single wake
+  lCheck(E_K_STATUS_OK == salRotSessionBegin(), "session begins");
+  lRunCrypto(&gTestRun);
+  lCheck(E_K_STATUS_OK == salRotSessionEnd(), "session ends");
+  lCheck(gTestRun.wakeCount == 1u, "one wake for the whole exchange");
+  lCheck(0 == memcmp(gTestRun.aMac, gTestReference.aMac, sizeof(gTestRun.aMac)),
+         "same MAC in an outer session");
+
+  // The interleaved encryption equals an encryption followed by an HMAC
+  {
+    uint8_t aCipher[C_TEST_DATA_SIZE];
+    uint8_t aMac[C_K_KTA__HMAC_MAX_SIZE];
+    size_t  cipherLen = sizeof(aCipher);
+
+    lRunCrypto(&gTestRun);
+    for (size_t i = 0; i < sizeof(gTestRun.aData); i++)
+    {
+      gTestRun.aData[i] = (uint8_t)(i ^ (i >> 8));
+    }
+    lCheck(E_K_STATUS_OK == salCryptoAesEnc(C_K_KTA__VOLATILE_3_ID,
+                                            &gTestRun.aData[C_TEST_HEADER_SIZE], C_TEST_DATA_SIZE,
+                                            aCipher, &cipherLen),
+           "encrypted");
+    (void)memcpy(&gTestRun.aData[C_TEST_HEADER_SIZE], aCipher, sizeof(aCipher));
+    lCheck(E_K_STATUS_OK == salCryptoHmac(C_K_KTA__VOLATILE_2_ID, gTestRun.aData,
+                                          sizeof(gTestRun.aData), aMac),
+           "signed");
+    lCheck(0 == memcmp(gTestRun.aData, gTestReference.aData, sizeof(gTestRun.aData)),
+           "interleaved cipher");
+    lCheck(0 == memcmp(aMac, gTestReference.aMac, sizeof(aMac)), "interleaved MAC");
+  }
+  lTerm();
+
+  printf("%u checks, %u failures\n", (unsigned int)gCheckCount, (unsigned int)gFailCount);
+
+  return (0u == gFailCount) ? 0 : 1;
+}
@@ -46,6 +46,7 @@
 #include "comm_if.h"
 #include "cryptoConfig.h"
 #include "k_sal_os.h"
+#include "icpp_parser.h"
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
@@ -74,6 +75,20 @@
 /** @brief Delay between retry attempts in milliseconds */
 #define C_KTA_COMM_RETRY_DELAY_MS      (500u)  /* Reduced from 2000ms for faster retries */
 
+#ifdef NETWORK_STACK_AVAILABLE
+/**
+ * @brief Check of a keySTREAM message while it is received. Only the header is
+ *        in clear, the rest is checked by ktaExchangeMessage() once decrypted.
+ */
+typedef struct
+{
+  TKIcppParserStream  stream;
+  /* Streaming deserializer, fed with the header only. */
+  size_t              headerSize;
+  /* Number of header bytes fed so far. */
+} TKtaAppRecvCheck;
+#endif /* NETWORK_STACK_AVAILABLE */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
@@ -82,6 +97,11 @@ static uint8_t gConnectionReq = 0u;
 
 /** @brief  KTA Initialized state */
 static uint8_t gKtaInitialized = 0u;
+
+#ifdef NETWORK_STACK_AVAILABLE
+/** @brief  Check of the message being received from keySTREAM */
+static TKtaAppRecvCheck gKtaRecvCheck;
+#endif /* NETWORK_STACK_AVAILABLE */
 uint8_t         gaSegSeed[C_K__L1_SEGMENTATION_SEED_SIZE] = C_KTA_APP__L1_SEG_SEED;
 uint8_t*        gpDeviceProfPubUid                        = (uint8_t*)C_KTA_APP__DEVICE_PUBLIC_UID;
 const uint8_t*  gpHost                                    = C_K_COMM__SERVER_HOST;
@@ -192,6 +212,46 @@ static const char* lCommStatusToString
 (
   TCommIfStatus xStatus
 );
+
+/**
+ * @brief
+ *   Feed the header of the keySTREAM message to the streaming deserializer as
+ *   it is received, so that a wrong message is rejected before its end.
+ *
+ * @param[in] xpContext
+ *   Message check, TKtaAppRecvCheck.
+ * @param[in] xpData
+ *   Next part of the message.
+ * @param[in] xDataLen
+ *   Size of xpData in bytes.
+ * @return
+ * - E_COMM_IF_STATUS_OK to continue receiving.
+ * - E_COMM_IF_STATUS_DATA if the header is invalid.
+ */
+static TCommIfStatus lRecvCheckMessage
+(
+  void*           xpContext,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+);
+
+/**
+ * @brief
+ *   Streaming deserializer event handler, the header is checked by the
+ *   deserializer itself so there is nothing more to do.
+ *
+ * @param[in] xpContext
+ *   Not used.
+ * @param[in] xpEvent
+ *   Event to process.
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK.
+ */
+static TKParserStatus lRecvCheckEvent
+(
+  void*                     xpContext,
+  const TKIcppParserEvent*  xpEvent
+);
 #endif /* NETWORK_STACK_AVAILABLE */
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
@@ -554,6 +614,9 @@ static TKStatus lPollKeyStream
       }
       
       ks2rotMsgSize = C_K__ICPP_MSG_MAX_SIZE;
+      (void)ktaIcppParserStreamInit(&gKtaRecvCheck.stream, lRecvCheckEvent, NULL);
+      gKtaRecvCheck.headerSize = 0;
+      commSetRecvHandler(lRecvCheckMessage, &gKtaRecvCheck);
       commStatus = commMsgExchange(aRot2KsMsg, rot2ksMsgSize, pKs2RotMsg, &ks2rotMsgSize);
 
       /* Always terminate connection after exchange (success or failure) */
@@ -688,6 +751,58 @@ static const char* lCommStatusToString
     default:                             return "UNKNOWN_STATUS";
   }
 }
+
+/**
+ * @implements lRecvCheckMessage
+ *
+ */
+static TCommIfStatus lRecvCheckMessage
+(
+  void*           xpContext,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+)
+{
+  TKtaAppRecvCheck*  pCheck = (TKtaAppRecvCheck*)xpContext;
+  TCommIfStatus      status = E_COMM_IF_STATUS_OK;
+  TKParserStatus     parserStatus;
+  size_t             len = C_K_ICPP_PARSER__HEADER_SIZE - pCheck->headerSize;
+
+  if (len > xDataLen)
+  {
+    len = xDataLen;
+  }
+
+  if (0u != len)
+  {
+    /* The stream checks the header as soon as it is complete. */
+    parserStatus = ktaIcppParserStreamFeed(&pCheck->stream, xpData, len);
+    pCheck->headerSize += len;
+    if ((E_K_ICPP_PARSER_STATUS_OK != parserStatus) &&
+        (E_K_ICPP_PARSER_STATUS_NO_OPERATION != parserStatus))
+    {
+      C_KTA_APP__LOG("[ERROR] Invalid keySTREAM message header, status[%d]\r\n", parserStatus);
+      status = E_COMM_IF_STATUS_DATA;
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @implements lRecvCheckEvent
+ *
+ */
+static TKParserStatus lRecvCheckEvent
+(
+  void*                     xpContext,
+  const TKIcppParserEvent*  xpEvent
+)
+{
+  (void)xpContext;
+  (void)xpEvent;
+  return E_K_ICPP_PARSER_STATUS_OK;
+}
 #endif /* NETWORK_STACK_AVAILABLE */
 
 